@@ -0,0 +1,225 @@
+function [numeratorAry denominatorAry] = loadBinaryResult(fileName, deviceConstants)
+
+%   loadBinaryResult() - Load the transfer functions of a result from a binary data file.
+%                   linNet writes the binary data file besides the M script of the result
+%                   if it is run with option -b. The file holds the numerator and
+%                   denominator expressions of all transfer functions of the result. They
+%                   are evaluated for the given values of the device constants. Reading the
+%                   binary data is much faster than parsing the literal expressions of an
+%                   M script for large results.
+%
+%   Input argument(s):
+%       fileName    The name of the binary data file, normally *.lnb
+%       deviceConstants
+%                   A struct with the values of the device constants as fields. A device
+%                   constant, which is not a field of the struct, gets its nominal value
+%                   as specified in the circuit file. The argument is optional
+%
+%   Return argument(s):
+%       numeratorAry
+%                   A cell array of the numerators of all transfer functions. Row i and
+%                   column j hold the numerator of dependent i and independent j as row
+%                   vector of coefficients, the coefficient of the highest power of s first
+%       denominatorAry
+%                   The cell array of the denominators of all transfer functions. The
+%                   organization is the same as for numeratorAry
+%
+%   Example(s):
+%       [sysDesc.numeratorAry sysDesc.denominatorAry] = loadBinaryResult('myResult.lnb');
+%
+%   Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+%
+%   This program is free software: you can redistribute it and/or modify it
+%   under the terms of the GNU General Public License as published by the
+%   Free Software Foundation, either version 3 of the License, or (at your
+%   option) any later version.
+%
+%   This program is distributed in the hope that it will be useful, but
+%   WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+%   General Public License for more details.
+%
+%   You should have received a copy of the GNU General Public License along
+%   with this program. If not, see <http://www.gnu.org/licenses/>.
+
+    % Number of mandatory parameters.
+    noPar = 1;
+
+    % Number of optional parameters.
+    noOptPar = 1;
+
+    error(nargchk(noPar, noPar+noOptPar, nargin));
+
+    % Set the optional parameter values.
+    noPar = noPar + 1;
+    if nargin < noPar
+        deviceConstants = struct;
+    end
+
+    % The file is written in the byte order of the machine, which has run linNet. The magic
+    % number tells, which one it is.
+    magic = hex2dec('42434E4C');
+    [hFile msg] = fopen(fileName, 'r', 'ieee-le');
+    if hFile < 0
+        error(['Can''t open binary data file ' fileName ': ' msg])
+    end
+    if fread(hFile, 1, 'uint32') ~= magic
+        fclose(hFile);
+        hFile = fopen(fileName, 'r', 'ieee-be');
+        if fread(hFile, 1, 'uint32') ~= magic
+            fclose(hFile);
+            error(['File ' fileName ' is not a binary data file of linNet'])
+        end
+    end
+    if fread(hFile, 1, 'uint32') ~= 1
+        fclose(hFile);
+        error(['The format of binary data file ' fileName ' is not supported'])
+    end
+    dimAry = fread(hFile, 6, 'uint32');
+    noConst = dimAry(1);
+    noDependents = dimAry(2);
+    noIndependents = dimAry(3);
+    noExpr = dimAry(4);
+    noAddends = dimAry(5);
+    noFactors = dimAry(6);
+
+    % The name tables. The name of the result is not used.
+    readString(hFile);
+    constNameAry = cell(noConst, 1);
+    for idxConst = 1:noConst
+        constNameAry{idxConst} = readString(hFile);
+    end
+    dependentNameAry = cell(noDependents, 1);
+    for idxDep = 1:noDependents
+        dependentNameAry{idxDep} = readString(hFile);
+    end
+    independentNameAry = cell(noIndependents, 1);
+    for idxIndep = 1:noIndependents
+        independentNameAry{idxIndep} = readString(hFile);
+    end
+
+    % The nominal values of the device constants are overridden by the function argument.
+    valueAry = fread(hFile, noConst, 'double');
+    for idxConst = 1:noConst
+        if isfield(deviceConstants, constNameAry{idxConst})
+            valueAry(idxConst) = deviceConstants.(constNameAry{idxConst});
+        end
+    end
+
+    % The expressions and the transfer functions. Each field of all addends and factors is
+    % read in a single operation.
+    idxFirstAddendAry = fread(hFile, noExpr+1, 'uint32');
+    powerOfSAry = fread(hFile, noAddends, 'int32');
+    numFactorAry = fread(hFile, noAddends, 'int64');
+    denomFactorAry = fread(hFile, noAddends, 'int64');
+    idxFirstFactorAry = fread(hFile, noAddends+1, 'uint32');
+    idxConstAry = fread(hFile, noFactors, 'uint32');
+    powerAry = fread(hFile, noFactors, 'int32');
+    sizeOfTable = [noIndependents noDependents];
+    [idxNumeratorAry noNumerators] = fread(hFile, sizeOfTable, 'uint32');
+    [idxDenominatorAry noDenominators] = fread(hFile, sizeOfTable, 'uint32');
+    fclose(hFile);
+    if noNumerators ~= noDependents*noIndependents  ||  noDenominators ~= noNumerators
+        error(['Binary data file ' fileName ' is corrupt'])
+    end
+
+    % The value of the product of device constants of each addend. The product is computed
+    % as sum of logarithms, which is supported by the fast built-in operation of
+    % accumarray. The sign is considered separately.
+    monomialAry = ones(noAddends, 1);
+    if noFactors > 0
+        addendOfFactorAry = getIndexOfGroup(idxFirstFactorAry, noFactors);
+        factorValueAry = valueAry(idxConstAry+1);
+        logAry = accumarray( addendOfFactorAry                          ...
+                           , powerAry .* log(abs(factorValueAry))       ...
+                           , [noAddends 1]                              ...
+                           );
+        noNegFactorsAry = accumarray( addendOfFactorAry                 ...
+                                    , powerAry .* (factorValueAry < 0)  ...
+                                    , [noAddends 1]                     ...
+                                    );
+        monomialAry = exp(logAry) .* (1 - 2*mod(noNegFactorsAry, 2));
+    end
+    termAry = numFactorAry ./ denomFactorAry .* monomialAry;
+
+    % The coefficients of all expressions. Row i holds the coefficients of expression i,
+    % the coefficient of s^0 first. The null expression has no addends.
+    if noAddends > 0
+        exprOfAddendAry = getIndexOfGroup(idxFirstAddendAry, noAddends);
+        coefMatrix = accumarray( [exprOfAddendAry powerOfSAry+1]    ...
+                               , termAry                            ...
+                               , [noExpr max(powerOfSAry)+1]        ...
+                               );
+        degreeAry = accumarray(exprOfAddendAry, powerOfSAry, [noExpr 1], @max);
+    else
+        coefMatrix = zeros(noExpr, 1);
+        degreeAry = zeros(noExpr, 1);
+    end
+    coefAry = cell(noExpr, 1);
+    for idxExpr = 1:noExpr
+        coefAry{idxExpr} = coefMatrix(idxExpr, degreeAry(idxExpr)+1:-1:1);
+    end
+
+    % The transfer functions reference the expressions. The most significant bit of the
+    % reference is set if the expression needs to be negated.
+    numeratorAry = cell(noDependents, noIndependents);
+    denominatorAry = cell(noDependents, noIndependents);
+    for idxDep = 1:noDependents
+        for idxIndep = 1:noIndependents
+            numeratorAry{idxDep, idxIndep} = ...
+                                getExpression(coefAry, idxNumeratorAry(idxIndep, idxDep));
+            denominatorAry{idxDep, idxIndep} = ...
+                                getExpression(coefAry, idxDenominatorAry(idxIndep, idxDep));
+
+            % The Octave functions don't respond with useful error feedback in case of a
+            % null denominator.
+            if all(denominatorAry{idxDep, idxIndep} == 0)
+                error(['Denominator expression D_' dependentNameAry{idxDep} '_' ...
+                       independentNameAry{idxIndep} ' is null. The transfer function is' ...
+                       ' undefined and no plots can be generated. Please check your' ...
+                       ' circuit'] ...
+                     );
+            end
+        end
+    end
+end % of function loadBinaryResult.
+
+
+
+function [str] = readString(hFile)
+
+%   readString() - Read a string from a binary data file. The string is stored as length
+%                   and characters.
+
+    len = fread(hFile, 1, 'uint32');
+    str = fread(hFile, [1 len], 'char=>char');
+end % of function readString.
+
+
+
+function [groupAry] = getIndexOfGroup(idxFirstAry, noElements)
+
+%   getIndexOfGroup() - Get the group index of all elements of a sequence of groups. Group
+%                   i begins with element idxFirstAry(i), counting from null. The returned
+%                   column vector holds the group index, counting from one, of each
+%                   element.
+
+    markAry = zeros(noElements, 1);
+    idxGroupAry = find(diff(idxFirstAry) > 0);
+    markAry(idxFirstAry(idxGroupAry)+1) = diff([0; idxGroupAry]);
+    groupAry = cumsum(markAry);
+end % of function getIndexOfGroup.
+
+
+
+function [coef] = getExpression(coefAry, ref)
+
+%   getExpression() - Resolve a reference to an expression. The reference is the null based
+%                   index of the expression with the sign in the most significant bit.
+
+    if ref >= 2^31
+        coef = -coefAry{ref-2^31+1};
+    else
+        coef = coefAry{ref+1};
+    end
+end % of function getExpression.
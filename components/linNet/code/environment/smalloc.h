@@ -21,6 +21,7 @@
  */
 /* Module interface
  *   smalloc
+ *   srealloc
  *   stralloccpy
  * Local functions
  */
@@ -88,6 +89,46 @@ static inline void *smalloc(size_t noBytes, const char * const fileName, unsigne
 
 
 
+/**
+ * Safe realloc: The same as realloc but the unavailability of memory is handled by error
+ * message and application abort, see void *smalloc(size_t, const char * const, unsigned
+ * long) for details.
+ *   @return
+ * The pointer to the reallocated memory is returned. It may differ from \a pMem.
+ *   @param pMem
+ * The pointer to the memory chunk to resize or NULL for a new one.
+ *   @param noBytes
+ * The number of requested bytes
+ *   @param fileName
+ * The name of the source file, where the function is used. Simply pass the macro __FILE__.
+ *   @param line
+ * The source code line number, where srealloc is called. Simply pass the macro __LINE__.
+ */ 
+
+static inline void *srealloc( void * const pMem
+                            , size_t noBytes
+                            , const char * const fileName
+                            , unsigned long line
+                            )
+{
+    void *pNewMem = realloc(pMem, noBytes);    
+    if(pNewMem == NULL  &&  noBytes > 0)
+    {
+        fprintf( stderr
+               , "realloc: Out of memory in %s, line %lu. Application is aborted\n"
+               , fileName
+               , line
+               );
+        exit(-1);
+    }    
+    
+    return pNewMem;
+
+} /* End of srealloc */
+
+
+
+
 /**
  * Copy a string into a newly allocated chunk of memory. Unavailability of memory is
  * handled by error message and application abort, see void *smalloc(size_t, const char *
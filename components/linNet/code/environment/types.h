@@ -29,6 +29,10 @@
  * Defines
  */
  
+/** The storage class of thread-local data. C99 doesn't know thread-local data; the GCC
+    extension is used. */
+#define THREAD_LOCAL    __thread
+
 
 /*
  * Global type definitions
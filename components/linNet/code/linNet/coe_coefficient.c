@@ -21,7 +21,13 @@
 /* Module interface
  *   coe_initModule
  *   coe_shutdownModule
+ *   coe_setNoConstants
+ *   coe_createHeapForThread
+ *   coe_setHeapOfThread
+ *   coe_deleteHeapForThread
  *   coe_cloneByDeepCopy
+ *   coe_isEqualCoef
+ *   coe_getHashOfCoef
  *   coe_createMatrix
  *   coe_deleteMatrix
  *   coe_checkOrderOfAddends
@@ -29,9 +35,27 @@
  *   coe_logCoefficient
  *   coe_logMatrix
  *   coe_mulConst
+ *   coe_mul
  *   coe_diff
+ *   coe_initPackedCoef
+ *   coe_freePackedCoef
+ *   coe_reservePackedCoef
+ *   coe_packCoef
+ *   coe_unpackCoef
+ *   coe_filterProductsScalar
+ *   coe_filterProductsMultiWord
+ *   coe_createAccumulator
+ *   coe_deleteAccumulator
+ *   coe_growAccumulator
+ *   coe_setNoWordsOfAccumulator
+ *   coe_accumulateAddendMultiWord
+ *   coe_fetchMaxAddendMultiWord
  * Local functions
  *   addAddendToExpr
+ *   selectNoWordsOfProduct
+ *   filterProductsAvx2
+ *   filterProductsAvx512
+ *   selectFilterKernel
  */
 
 /*
@@ -39,7 +63,9 @@
  */
 
 #include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 #include <assert.h>
 
 #include "smalloc.h"
@@ -49,11 +75,27 @@
 #include "coe_coefficient.h"
 #include "coe_coefficient.inlineInterface.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# include <immintrin.h>
+#endif
+
 
 /*
  * Defines
  */
 
+/** Vectorized implementations of the inner loop of the solver are available for GCC
+    compatible compilers on x86 targets. They are selected at run-time if the CPU supports
+    them. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define USE_X86_SIMD_KERNELS   1
+#else
+# define USE_X86_SIMD_KERNELS   0
+#endif
+
+/** The initial size of the hash table of an accumulator as power of two. */
+#define LOG2_INITIAL_NO_ACCUMULATOR_SLOTS   10
+
 
 
 /*
@@ -70,16 +112,50 @@
  * Data definitions
  */
 
-/** A global logger object is referenced from anywhere for writing progress messages. */
-static log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+/** A global logger object is referenced from anywhere for writing progress messages.
+      @remark All data of the module, which relates to the circuit under progress, is
+    thread-local; the jobs of a parallel batch run have their own instances. */
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
 
 /** The module globally accessible heap for both the coefficients of the LES and the
     addends of a coefficient.
       @remark Although defined globally, nobody should ever use this variable directly.
     Instead, use the functional interface declared in coe_coefficient.inlineInterface.h to
     do so. The inline implementation of this function set demands to declare the memory
-    manager as a global. */
-mem_hHeap_t coe_hHeapOfCoefAddend = MEM_HANDLE_INVALID_HEAP;
+    manager as a global.
+      @remark The variable is thread-local. In the main thread it holds the module's heap
+    for the number of words of a product of constants of the circuit under progress. Other
+    threads use their own heaps, which are linked to the module's heap. */
+THREAD_LOCAL mem_hHeap_t coe_hHeapOfCoefAddend = MEM_HANDLE_INVALID_HEAP;
+
+/** The number of words of all products of constants of the circuit under progress.
+      @remark Although defined globally, nobody should ever use this variable directly.
+    Use the inline function coe_getNoWordsOfProduct instead.
+      @remark The variable is thread-local. It changes together with the heap \a
+    coe_hHeapOfCoefAddend. */
+THREAD_LOCAL unsigned int coe_noWordsOfProduct = 1;
+
+/** The heaps of the module, one for each number of words of a product of constants. The
+    size of a coefficient addend depends on this number. Element \a i is the heap for
+    products of \a i+1 words; it is created on first use. New heaps for other threads are
+    always linked to one of these heaps. */
+static THREAD_LOCAL mem_hHeap_t _hHeapOfCoefAddendAry[COE_MAX_NO_WORDS_OF_PRODUCT];
+
+/** The names of the heaps of the module. */
+static THREAD_LOCAL char _nameOfHeapAry[COE_MAX_NO_WORDS_OF_PRODUCT][40];
+
+/** The implementation of the filter and combine kernel, which is used by the solver.
+      @remark Although defined globally, nobody should ever use this variable directly.
+    Use the inline function coe_filterProducts instead.
+      @remark The variable is shared by all threads. It is set only once, see \a
+    _onceSelectFilterKernel. */
+coe_fctFilterProducts_t coe_fctFilterProducts = coe_filterProductsScalar;
+
+/** The name of the selected implementation of the filter and combine kernel. */
+static const char *_nameOfFilterKernel = "scalar";
+
+/** The kernel is selected once, regardless how many threads initialize the module. */
+static pthread_once_t _onceSelectFilterKernel = PTHREAD_ONCE_INIT;
 
 
 /*
@@ -102,19 +178,27 @@ static void addAddendToExpr(coe_coef_t ** const ppCoef, coe_coefAddend_t * const
 {
     assert(!coe_isCoefAddendNull(pNewAddend));
 
+    const unsigned int noWords = coe_getNoWordsOfProduct();
     coe_coefAddend_t *pAddend = *ppCoef
                    , **ppAddend = ppCoef;
-    const coe_productOfConst_t productOfConsts = pNewAddend->productOfConst;
+    const coe_productOfConstWord_t * const productOfConsts = pNewAddend->productOfConst;
 
     /* The addends of a coefficient are sorted. Look for the position where to combine with
        an existing addend or where to insert a new one. */
-    while(!coe_isCoefAddendNull(pAddend) &&  pAddend->productOfConst > productOfConsts)
+    signed int cmp = 0;
+    while(!coe_isCoefAddendNull(pAddend)
+          &&  (cmp = coe_compareProductOfConst( pAddend->productOfConst
+                                              , productOfConsts
+                                              , noWords
+                                              )
+              ) > 0
+         )
     {
         ppAddend = &pAddend->pNext;
         pAddend = pAddend->pNext;
     }
 
-    if(coe_isCoefAddendNull(pAddend) ||  pAddend->productOfConst < productOfConsts)
+    if(coe_isCoefAddendNull(pAddend) ||  cmp < 0)
     {
         /* The coefficient doesn't contain an addend with identical combination of
            constants. We insert the passed addend as a new one. */
@@ -141,9 +225,403 @@ static void addAddendToExpr(coe_coef_t ** const ppCoef, coe_coefAddend_t * const
 
 
 
+/**
+ * Select the heap of coefficients of the main thread, which suits a given number of words
+ * of a product of constants. The heap is created on first use.
+ *   @param noWords
+ * The number of words of a product of constants, 1..#COE_MAX_NO_WORDS_OF_PRODUCT.
+ */
+
+static void selectNoWordsOfProduct(unsigned int noWords)
+{
+    assert(noWords >= 1  &&  noWords <= COE_MAX_NO_WORDS_OF_PRODUCT);
+    mem_hHeap_t * const phHeap = &_hHeapOfCoefAddendAry[noWords-1];
+    if(*phHeap == MEM_HANDLE_INVALID_HEAP)
+    {
+        char * const name = _nameOfHeapAry[noWords-1];
+        if(noWords == 1)
+            snprintf(name, sizeof(_nameOfHeapAry[0]), "Coefficient of LES");
+        else
+        {
+            snprintf( name
+                    , sizeof(_nameOfHeapAry[0])
+                    , "Coefficient of LES, %u Bit"
+                    , (unsigned)(noWords*COE_NO_CONST_PER_WORD)
+                    );
+        }
+        *phHeap = mem_createHeap( _log
+                                , name
+                                , sizeof(coe_coefAddend_t)
+                                  + noWords*sizeof(coe_productOfConstWord_t)
+                                , /* initialHeapSize */     1000
+                                , /* allocationBlockSize */ 100000
+                                );
+    }
+
+    coe_hHeapOfCoefAddend = *phHeap;
+    coe_noWordsOfProduct = noWords;
+
+} /* End of selectNoWordsOfProduct */
+
+
+
+
+/**
+ * Combine a single addend with all addends of another, packed coefficient and keep only
+ * those products, which are relevant for the elementary step of the Gauss elimination.
+ * This is the scalar reference implementation of the inner loop of the solver. It is used
+ * if the CPU doesn't support one of the vectorized implementations.\n
+ *   A product of the two addends with products of constants \a p1 and \a p2 is relevant
+ * only if it can be divided by the first addend of the known divisor, with product of
+ * constants \a pDiv, and if the quotient still has powers of null or one for all constants:
+ * ((~p1 & ~p2 & pDiv) | (p1 & p2 & ~pDiv)) == 0. The products of constants of the
+ * relevant products are returned already divided by the first addend of the divisor; this
+ * is p1 ^ p2 ^ pDiv. See the solver for details.\n
+ *   The relevant products are returned in the order of the addends of the second operand.
+ *   @return
+ * Get the number of relevant products.
+ *   @param prodOfConstResAry
+ * The products of constants of the relevant products, already divided by the first
+ * addend of the divisor. The array needs to have room for \a noAddends2 elements.
+ *   @param factorResAry
+ * The numeric factors of the relevant products. The array needs to have room for \a
+ * noAddends2 elements.
+ *   @param prodOfConst1
+ * The product of constants of the single addend.
+ *   @param factor1
+ * The numeric factor of the single addend.
+ *   @param prodOfConst2Ary
+ * The products of constants of the addends of the other coefficient.
+ *   @param factor2Ary
+ * The numeric factors of the addends of the other coefficient.
+ *   @param noAddends2
+ * The number of addends of the other coefficient.
+ *   @param prodOfConstDiv
+ * The product of constants of the first addend of the known divisor.
+ */
+
+unsigned int coe_filterProductsScalar( coe_productOfConstWord_t * const prodOfConstResAry
+                                     , coe_numericFactor_t * const factorResAry
+                                     , coe_productOfConstWord_t prodOfConst1
+                                     , coe_numericFactor_t factor1
+                                     , const coe_productOfConstWord_t * const prodOfConst2Ary
+                                     , const coe_numericFactor_t * const factor2Ary
+                                     , unsigned int noAddends2
+                                     , coe_productOfConstWord_t prodOfConstDiv
+                                     )
+{
+    /* The parts of the condition, which depend only on the single addend, are computed
+       once. */
+    const coe_productOfConstWord_t maskNotIn1 = ~prodOfConst1 & prodOfConstDiv
+                                 , maskIn1 = prodOfConst1 & ~prodOfConstDiv
+                                 , prodOfConst1DivDiv = prodOfConst1 ^ prodOfConstDiv;
+    unsigned int noRes = 0, idxAddend2;
+    for(idxAddend2=0; idxAddend2<noAddends2; ++idxAddend2)
+    {
+        const coe_productOfConstWord_t prodOfConst2 = prodOfConst2Ary[idxAddend2];
+        if(((~prodOfConst2 & maskNotIn1) | (prodOfConst2 & maskIn1)) == 0)
+        {
+            prodOfConstResAry[noRes] = prodOfConst2 ^ prodOfConst1DivDiv;
+            factorResAry[noRes] = factor1 * factor2Ary[idxAddend2];
+            ++ noRes;
+        }
+    }
+
+    return noRes;
+
+} /* End of coe_filterProductsScalar */
+
+
+
+
+/**
+ * Combine a single addend with all addends of another, packed coefficient and keep only
+ * those products, which are relevant for the elementary step of the Gauss elimination.
+ * This is the implementation of the inner loop of the solver for products of constants of
+ * more than one word. The relevance condition and the computed products are the same as
+ * for coe_filterProductsScalar but they are evaluated word by word.
+ *   @return
+ * Get the number of relevant products.
+ *   @param prodOfConstResAry
+ * The products of constants of the relevant products, already divided by the first
+ * addend of the divisor. The array needs to have room for \a noAddends2 products.
+ *   @param factorResAry
+ * The numeric factors of the relevant products. The array needs to have room for \a
+ * noAddends2 elements.
+ *   @param prodOfConst1
+ * The product of constants of the single addend.
+ *   @param factor1
+ * The numeric factor of the single addend.
+ *   @param prodOfConst2Ary
+ * The products of constants of the addends of the other coefficient.
+ *   @param factor2Ary
+ * The numeric factors of the addends of the other coefficient.
+ *   @param noAddends2
+ * The number of addends of the other coefficient.
+ *   @param prodOfConstDiv
+ * The product of constants of the first addend of the known divisor.
+ *   @param noWords
+ * The number of words of a product of constants, 2..#COE_MAX_NO_WORDS_OF_PRODUCT.
+ */
+
+unsigned int coe_filterProductsMultiWord
+                                ( coe_productOfConstWord_t * const prodOfConstResAry
+                                , coe_numericFactor_t * const factorResAry
+                                , const coe_productOfConstWord_t * const prodOfConst1
+                                , coe_numericFactor_t factor1
+                                , const coe_productOfConstWord_t * const prodOfConst2Ary
+                                , const coe_numericFactor_t * const factor2Ary
+                                , unsigned int noAddends2
+                                , const coe_productOfConstWord_t * const prodOfConstDiv
+                                , unsigned int noWords
+                                )
+{
+    assert(noWords >= 1  &&  noWords <= COE_MAX_NO_WORDS_OF_PRODUCT);
+
+    /* The parts of the condition, which depend only on the single addend, are computed
+       once. */
+    coe_productOfConstWord_t maskNotIn1[COE_MAX_NO_WORDS_OF_PRODUCT]
+                           , maskIn1[COE_MAX_NO_WORDS_OF_PRODUCT]
+                           , prodOfConst1DivDiv[COE_MAX_NO_WORDS_OF_PRODUCT];
+    unsigned int idxWord;
+    for(idxWord=0; idxWord<noWords; ++idxWord)
+    {
+        maskNotIn1[idxWord] = ~prodOfConst1[idxWord] & prodOfConstDiv[idxWord];
+        maskIn1[idxWord] = prodOfConst1[idxWord] & ~prodOfConstDiv[idxWord];
+        prodOfConst1DivDiv[idxWord] = prodOfConst1[idxWord] ^ prodOfConstDiv[idxWord];
+    }
+
+    unsigned int noRes = 0, idxAddend2;
+    for(idxAddend2=0; idxAddend2<noAddends2; ++idxAddend2)
+    {
+        const coe_productOfConstWord_t * const prodOfConst2 =
+                                                    &prodOfConst2Ary[idxAddend2*noWords];
+        coe_productOfConstWord_t test = 0;
+        for(idxWord=0; idxWord<noWords; ++idxWord)
+        {
+            test |= (~prodOfConst2[idxWord] & maskNotIn1[idxWord])
+                    | (prodOfConst2[idxWord] & maskIn1[idxWord]);
+        }
+        if(test == 0)
+        {
+            coe_productOfConstWord_t * const prodOfConstRes =
+                                                    &prodOfConstResAry[noRes*noWords];
+            for(idxWord=0; idxWord<noWords; ++idxWord)
+                prodOfConstRes[idxWord] = prodOfConst2[idxWord] ^ prodOfConst1DivDiv[idxWord];
+            factorResAry[noRes] = factor1 * factor2Ary[idxAddend2];
+            ++ noRes;
+        }
+    }
+
+    return noRes;
+
+} /* End of coe_filterProductsMultiWord */
+
+
+
+#if USE_X86_SIMD_KERNELS
+/**
+ * AVX2 implementation of the filter and combine kernel. Four products of constants are
+ * tested at once. See coe_filterProductsScalar for the specification of the function.
+ *   @return
+ * Get the number of relevant products.
+ *   @param prodOfConstResAry
+ * The products of constants of the relevant products.
+ *   @param factorResAry
+ * The numeric factors of the relevant products.
+ *   @param prodOfConst1
+ * The product of constants of the single addend.
+ *   @param factor1
+ * The numeric factor of the single addend.
+ *   @param prodOfConst2Ary
+ * The products of constants of the addends of the other coefficient.
+ *   @param factor2Ary
+ * The numeric factors of the addends of the other coefficient.
+ *   @param noAddends2
+ * The number of addends of the other coefficient.
+ *   @param prodOfConstDiv
+ * The product of constants of the first addend of the known divisor.
+ */
+
+__attribute__((target("avx2")))
+static unsigned int filterProductsAvx2( coe_productOfConstWord_t * const prodOfConstResAry
+                                      , coe_numericFactor_t * const factorResAry
+                                      , coe_productOfConstWord_t prodOfConst1
+                                      , coe_numericFactor_t factor1
+                                      , const coe_productOfConstWord_t * const prodOfConst2Ary
+                                      , const coe_numericFactor_t * const factor2Ary
+                                      , unsigned int noAddends2
+                                      , coe_productOfConstWord_t prodOfConstDiv
+                                      )
+{
+    const coe_productOfConstWord_t maskNotIn1 = ~prodOfConst1 & prodOfConstDiv
+                                 , maskIn1 = prodOfConst1 & ~prodOfConstDiv
+                                 , prodOfConst1DivDiv = prodOfConst1 ^ prodOfConstDiv;
+    const __m256i vMaskNotIn1 = _mm256_set1_epi64x((long long)maskNotIn1)
+                , vMaskIn1 = _mm256_set1_epi64x((long long)maskIn1)
+                , vZero = _mm256_setzero_si256();
+
+    unsigned int noRes = 0, idxAddend2;
+    for(idxAddend2=0; idxAddend2+4<=noAddends2; idxAddend2+=4)
+    {
+        const __m256i vProdOfConst2 =
+                        _mm256_loadu_si256((const __m256i*)&prodOfConst2Ary[idxAddend2]);
+        const __m256i vTest = _mm256_or_si256( _mm256_andnot_si256(vProdOfConst2, vMaskNotIn1)
+                                             , _mm256_and_si256(vProdOfConst2, vMaskIn1)
+                                             );
+
+        /* Most of the products are irrelevant. Only the few relevant ones are compacted
+           one by one. */
+        unsigned int mask = (unsigned int)_mm256_movemask_pd
+                                (_mm256_castsi256_pd(_mm256_cmpeq_epi64(vTest, vZero)));
+        while(mask != 0)
+        {
+            const unsigned int idx = idxAddend2 + (unsigned int)__builtin_ctz(mask);
+            prodOfConstResAry[noRes] = prodOfConst2Ary[idx] ^ prodOfConst1DivDiv;
+            factorResAry[noRes] = factor1 * factor2Ary[idx];
+            ++ noRes;
+            mask &= mask - 1;
+        }
+    }
+
+    /* The remaining addends are handled by the scalar implementation. */
+    return noRes + coe_filterProductsScalar( &prodOfConstResAry[noRes]
+                                           , &factorResAry[noRes]
+                                           , prodOfConst1
+                                           , factor1
+                                           , &prodOfConst2Ary[idxAddend2]
+                                           , &factor2Ary[idxAddend2]
+                                           , noAddends2 - idxAddend2
+                                           , prodOfConstDiv
+                                           );
+} /* End of filterProductsAvx2 */
+
+
+
+
+/**
+ * AVX-512 implementation of the filter and combine kernel. Eight products of constants
+ * are tested at once and the relevant ones are compacted by a compress store. See
+ * coe_filterProductsScalar for the specification of the function.
+ *   @return
+ * Get the number of relevant products.
+ *   @param prodOfConstResAry
+ * The products of constants of the relevant products.
+ *   @param factorResAry
+ * The numeric factors of the relevant products.
+ *   @param prodOfConst1
+ * The product of constants of the single addend.
+ *   @param factor1
+ * The numeric factor of the single addend.
+ *   @param prodOfConst2Ary
+ * The products of constants of the addends of the other coefficient.
+ *   @param factor2Ary
+ * The numeric factors of the addends of the other coefficient.
+ *   @param noAddends2
+ * The number of addends of the other coefficient.
+ *   @param prodOfConstDiv
+ * The product of constants of the first addend of the known divisor.
+ */
+
+__attribute__((target("avx512f")))
+static unsigned int filterProductsAvx512
+                                    ( coe_productOfConstWord_t * const prodOfConstResAry
+                                    , coe_numericFactor_t * const factorResAry
+                                    , coe_productOfConstWord_t prodOfConst1
+                                    , coe_numericFactor_t factor1
+                                    , const coe_productOfConstWord_t * const prodOfConst2Ary
+                                    , const coe_numericFactor_t * const factor2Ary
+                                    , unsigned int noAddends2
+                                    , coe_productOfConstWord_t prodOfConstDiv
+                                    )
+{
+    const coe_productOfConstWord_t maskNotIn1 = ~prodOfConst1 & prodOfConstDiv
+                                 , maskIn1 = prodOfConst1 & ~prodOfConstDiv
+                                 , prodOfConst1DivDiv = prodOfConst1 ^ prodOfConstDiv;
+    const __m512i vMaskNotIn1 = _mm512_set1_epi64((long long)maskNotIn1)
+                , vMaskIn1 = _mm512_set1_epi64((long long)maskIn1)
+                , vProdOfConst1DivDiv = _mm512_set1_epi64((long long)prodOfConst1DivDiv)
+                , vZero = _mm512_setzero_si512();
+
+    unsigned int noRes = 0, idxAddend2;
+    for(idxAddend2=0; idxAddend2+8<=noAddends2; idxAddend2+=8)
+    {
+        const __m512i vProdOfConst2 = _mm512_loadu_si512(&prodOfConst2Ary[idxAddend2]);
+        const __m512i vTest = _mm512_or_si512( _mm512_andnot_si512(vProdOfConst2, vMaskNotIn1)
+                                             , _mm512_and_si512(vProdOfConst2, vMaskIn1)
+                                             );
+        __mmask8 mask = _mm512_cmpeq_epi64_mask(vTest, vZero);
+        if(mask != 0)
+        {
+            /* The products of constants of the relevant products are compacted in a
+               single operation. The numeric factors are copied one by one; their type
+               doesn't necessarily have 64 Bit. */
+            _mm512_mask_compressstoreu_epi64
+                                    ( &prodOfConstResAry[noRes]
+                                    , mask
+                                    , _mm512_xor_si512(vProdOfConst2, vProdOfConst1DivDiv)
+                                    );
+            unsigned int m = mask;
+            while(m != 0)
+            {
+                factorResAry[noRes++] = factor1
+                                        * factor2Ary[idxAddend2 + (unsigned)__builtin_ctz(m)];
+                m &= m - 1;
+            }
+        }
+    }
+
+    /* The remaining addends are handled by the scalar implementation. */
+    return noRes + coe_filterProductsScalar( &prodOfConstResAry[noRes]
+                                           , &factorResAry[noRes]
+                                           , prodOfConst1
+                                           , factor1
+                                           , &prodOfConst2Ary[idxAddend2]
+                                           , &factor2Ary[idxAddend2]
+                                           , noAddends2 - idxAddend2
+                                           , prodOfConstDiv
+                                           );
+} /* End of filterProductsAvx512 */
+#endif /* USE_X86_SIMD_KERNELS */
+
+
+
+
+/**
+ * Select the best implementation of the inner loop of the solver for the CPU we are
+ * running on.
+ *   @remark
+ * The function is run only once; see pthread_once.
+ */
+
+static void selectFilterKernel()
+{
+    _nameOfFilterKernel = "scalar";
+    coe_fctFilterProducts = coe_filterProductsScalar;
+#if USE_X86_SIMD_KERNELS
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+    {
+        coe_fctFilterProducts = filterProductsAvx512;
+        _nameOfFilterKernel = "AVX-512";
+    }
+    else if(__builtin_cpu_supports("avx2"))
+    {
+        coe_fctFilterProducts = filterProductsAvx2;
+        _nameOfFilterKernel = "AVX2";
+    }
+#endif
+} /* End of selectFilterKernel */
+
+
+
+
 /**
  * Initialize the module at application startup.\n
- *   Mainly used to initialize golbally accessible heap for LES coefficient objects.
+ *   Mainly used to initialize golbally accessible heap for LES coefficient objects.\n
+ *   The module's data is thread-local. The jobs of a parallel batch run initialize the
+ * module each in their own thread. The thread, which has initialized the module, is
+ * called the main thread in the documentation of this module.
  *   @param hGlobalLogger
  * This module will use the passed logger object for all reporting during application life
  * time.
@@ -157,13 +635,22 @@ void coe_initModule(log_hLogger_t hGlobalLogger)
     /* Use the passed logger during the module life time. */
     _log = log_cloneByReference(hGlobalLogger);
 
-    /* Initialize the global heap of coefficients. */
-    coe_hHeapOfCoefAddend = mem_createHeap( hGlobalLogger
-                                          , /* Name */ "Coefficient of LES"
-                                          , sizeof(coe_coefAddend_t)
-                                          , /* initialHeapSize */     1000
-                                          , /* allocationBlockSize */ 10000
-                                          );
+    /* Initialize the global heap of coefficients. Until the first circuit is known, the
+       products of constants have a single word. The heaps for more words are created on
+       demand. */
+    unsigned int idxHeap;
+    for(idxHeap=0; idxHeap<COE_MAX_NO_WORDS_OF_PRODUCT; ++idxHeap)
+        _hHeapOfCoefAddendAry[idxHeap] = MEM_HANDLE_INVALID_HEAP;
+    selectNoWordsOfProduct(/* noWords */ 1);
+
+    /* Select the best implementation of the inner loop of the solver for the CPU we are
+       running on. */
+    pthread_once(&_onceSelectFilterKernel, selectFilterKernel);
+    LOG_DEBUG( _log
+             , "The %s implementation of the solver's inner loop is used"
+             , _nameOfFilterKernel
+             )
+
 #ifdef DEBUG
    coe_coefAddend_t dummyObj;
    assert((char*)&dummyObj.pNext == (char*)&dummyObj + MEM_OFFSET_OF_LINK_POINTER
@@ -184,12 +671,24 @@ void coe_shutdownModule()
 {
     /* The DEBUG compilation looks for still allocated objects in order to detect memory
        leaks. */
+    assert(coe_noWordsOfProduct >= 1  &&  coe_noWordsOfProduct <= COE_MAX_NO_WORDS_OF_PRODUCT
+           &&  coe_hHeapOfCoefAddend == _hHeapOfCoefAddendAry[coe_noWordsOfProduct-1]
+          );
+    unsigned int idxHeap;
+    for(idxHeap=0; idxHeap<COE_MAX_NO_WORDS_OF_PRODUCT; ++idxHeap)
+    {
+        if(_hHeapOfCoefAddendAry[idxHeap] != MEM_HANDLE_INVALID_HEAP)
+        {
 #ifdef DEBUG
-    mem_deleteHeap(coe_hHeapOfCoefAddend, /* warnIfUnfreedMem */ true);
+            mem_deleteHeap(_hHeapOfCoefAddendAry[idxHeap], /* warnIfUnfreedMem */ true);
 #else
-    mem_deleteHeap(coe_hHeapOfCoefAddend, /* warnIfUnfreedMem */ false);
+            mem_deleteHeap(_hHeapOfCoefAddendAry[idxHeap], /* warnIfUnfreedMem */ false);
 #endif
+            _hHeapOfCoefAddendAry[idxHeap] = MEM_HANDLE_INVALID_HEAP;
+        }
+    }
     coe_hHeapOfCoefAddend = MEM_HANDLE_INVALID_HEAP;
+    coe_noWordsOfProduct = 1;
 
     /* Invalidate the reference to the passed logger. It must no longer be used. */
     log_deleteLogger(_log);
@@ -201,6 +700,136 @@ void coe_shutdownModule()
 
 
 
+/**
+ * Choose the representation of the products of constants for the next circuit. The
+ * products get the least number of words, which can hold all constants of the circuit.
+ * Circuits with up to 64 constants use a single word, which is the fastest
+ * representation.\n
+ *   The size of the coefficient addends depends on the number of words; the heap of
+ * coefficients of the module is exchanged accordingly.
+ *   @param noConstants
+ * The number of constants of the circuit, 0..#COE_MAX_NO_CONST.
+ *   @remark
+ * The function must be called from the main thread only. Coefficients of the previous
+ * circuit can't be used or freed any more after the number of words has changed. They may
+ * still exist only if the number of constants is the same, e.g. if a solution is kept for
+ * reuse in incremental mode.
+ */
+
+void coe_setNoConstants(unsigned int noConstants)
+{
+    assert(noConstants <= COE_MAX_NO_CONST);
+    unsigned int noWords = (noConstants + COE_NO_CONST_PER_WORD - 1) / COE_NO_CONST_PER_WORD;
+    if(noWords == 0)
+        noWords = 1;
+
+    LOG_DEBUG( _log
+             , "The products of %u constants are represented by %u Bit"
+             , noConstants
+             , (unsigned)(noWords*COE_NO_CONST_PER_WORD)
+             )
+    if(noWords != coe_noWordsOfProduct)
+        selectNoWordsOfProduct(noWords);
+
+    /* If there are no coefficient objects at this time then the heap is reset so that the
+       coefficients of the new circuit are allocated in the order of memory addresses
+       rather than in the random order, in which the previous circuit has left the free
+       list. This is not possible if the solver uses other threads, which have linked
+       heaps. */
+    if(!mem_isLinkedHeap(coe_hHeapOfCoefAddend))
+    {
+        mem_heapStatistics_t statistics;
+        mem_getStatistics(&statistics, coe_hHeapOfCoefAddend);
+        if(statistics.noUsedObjs == 0)
+        {
+            const unsigned long noCoefAddends = mem_resetHeap(coe_hHeapOfCoefAddend);
+            assert(noCoefAddends == 0);
+            (void)noCoefAddends;
+        }
+    }
+
+} /* End of coe_setNoConstants */
+
+
+
+
+/**
+ * Create a heap for coefficients, which is used by another thread than the main thread.
+ * The heap is linked to the heap of the module; coefficients can be freed by any thread,
+ * regardless of the thread which had allocated them.\n
+ *   The heap is created in the main thread. It holds coefficients with the number of words
+ * of a product of constants, which is currently set in the main thread. Pass it to the
+ * other thread, which calls coe_setHeapOfThread with it before it makes use of this
+ * module.
+ *   @return
+ * Get the handle of the new heap.
+ *   @remark
+ * This function must be called only while no other thread is using coefficients.
+ *   @see void coe_deleteHeapForThread(mem_hHeap_t)
+ */
+
+mem_hHeap_t coe_createHeapForThread()
+{
+    assert(coe_hHeapOfCoefAddend != MEM_HANDLE_INVALID_HEAP
+           &&  coe_hHeapOfCoefAddend == _hHeapOfCoefAddendAry[coe_noWordsOfProduct-1]
+          );
+    return mem_createLinkedHeap( coe_hHeapOfCoefAddend
+                               , /* name */ "Coefficient of LES, thread"
+                               );
+} /* End of coe_createHeapForThread */
+
+
+
+
+/**
+ * Select the heap of coefficients for the calling thread. A thread other than the main
+ * thread must call this function before it uses any other function of this module. It
+ * needs to call it again whenever the main thread has changed the number of words of a
+ * product of constants.
+ *   @param hHeap
+ * The heap as got from coe_createHeapForThread. A heap must not be used by more than one
+ * thread.
+ *   @param noWordsOfProduct
+ * The number of words of a product of constants, which had been set in the main thread
+ * when \a hHeap was created.
+ */
+
+void coe_setHeapOfThread(mem_hHeap_t hHeap, unsigned int noWordsOfProduct)
+{
+    assert(noWordsOfProduct >= 1  &&  noWordsOfProduct <= COE_MAX_NO_WORDS_OF_PRODUCT);
+    coe_hHeapOfCoefAddend = hHeap;
+    coe_noWordsOfProduct = noWordsOfProduct;
+
+} /* End of coe_setHeapOfThread */
+
+
+
+
+/**
+ * Delete a heap of coefficients as got from coe_createHeapForThread. The heap is merged
+ * into the heap of the module; coefficients, which had been allocated from the deleted
+ * heap remain valid.
+ *   @param hHeap
+ * The handle of the heap. It must no longer be used by any thread.
+ *   @remark
+ * This function must be called only while no other thread is using coefficients.
+ */
+
+void coe_deleteHeapForThread(mem_hHeap_t hHeap)
+{
+#ifdef DEBUG
+    unsigned int idxHeap;
+    for(idxHeap=0; idxHeap<COE_MAX_NO_WORDS_OF_PRODUCT; ++idxHeap)
+        assert(hHeap != _hHeapOfCoefAddendAry[idxHeap]);
+#endif
+    mem_mergeLinkedHeap(hHeap);
+
+} /* End of coe_deleteHeapForThread */
+
+
+
+
+
 /**
  * A coefficient object is entirely copied, i.e. a single addend must not be passed.
  *   @return
@@ -216,6 +845,7 @@ coe_coef_t *coe_cloneByDeepCopy(const coe_coef_t *pCoef)
        head element, whose only quality of interest is that it has a next pointer. */
     coe_coef_t *pHeadOfCopy = coe_newCoefAddend();
     
+    const unsigned int noWords = coe_getNoWordsOfProduct();
     coe_coefAddend_t **ppNext = &pHeadOfCopy->pNext;
 
     while(!coe_isCoefAddendNull(pCoef))
@@ -223,7 +853,7 @@ coe_coef_t *coe_cloneByDeepCopy(const coe_coef_t *pCoef)
         coe_coefAddend_t *pNewAddend = coe_newCoefAddend();
         /* pNewAddend->pNext is set in either the next loop or behind it. */
         pNewAddend->factor = pCoef->factor;
-        pNewAddend->productOfConst = pCoef->productOfConst;
+        coe_copyProductOfConst(pNewAddend->productOfConst, pCoef->productOfConst, noWords);
         
         *ppNext = pNewAddend;
         
@@ -244,6 +874,71 @@ coe_coef_t *coe_cloneByDeepCopy(const coe_coef_t *pCoef)
 
 
 
+
+/**
+ * Compare two coefficients.
+ *   @return
+ * \a true if both coefficients have the same addends, \a false otherwise.
+ *   @param pCoef1
+ * The first operand.
+ *   @param pCoef2
+ * The second operand.
+ *   @remark
+ * The addends of both coefficients need to be sorted.
+ */
+
+boolean coe_isEqualCoef(const coe_coef_t *pCoef1, const coe_coef_t *pCoef2)
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    while(!coe_isCoefAddendNull(pCoef1)  &&  !coe_isCoefAddendNull(pCoef2))
+    {
+        if(pCoef1->factor != pCoef2->factor
+           ||  coe_compareProductOfConst( pCoef1->productOfConst
+                                        , pCoef2->productOfConst
+                                        , noWords
+                                        ) != 0
+          )
+        {
+            return false;
+        }
+        pCoef1 = pCoef1->pNext;
+        pCoef2 = pCoef2->pNext;
+    }
+    return coe_isCoefAddendNull(pCoef1)  &&  coe_isCoefAddendNull(pCoef2);
+
+} /* End of coe_isEqualCoef */
+
+
+
+
+/**
+ * Compute a hash code of a coefficient. Equal coefficients have the same hash code.
+ *   @return
+ * Get the hash code.
+ *   @param pCoef
+ * The coefficient. Its addends need to be sorted.
+ */
+
+unsigned long long coe_getHashOfCoef(const coe_coef_t *pCoef)
+{
+    /* Fibonacci hashing of the sequence of all factors and words of products, like the
+       hash of the accumulator. */
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    unsigned long long hash = 0;
+    while(!coe_isCoefAddendNull(pCoef))
+    {
+        hash = (hash ^ (unsigned long long)pCoef->factor) * 0x9E3779B97F4A7C15ull;
+        unsigned int idxWord;
+        for(idxWord=0; idxWord<noWords; ++idxWord)
+            hash = (hash ^ pCoef->productOfConst[idxWord]) * 0x9E3779B97F4A7C15ull;
+        pCoef = pCoef->pNext;
+    }
+    return hash;
+
+} /* End of coe_getHashOfCoef */
+
+
+
 /* Generate code for a pair of functions to create and delete a matrix of coefficients. */
 CRM_CREATE_MATRIX( /* modulePrefix */        coe
                  , /* elementType_t */       coe_coef_t*
@@ -268,13 +963,14 @@ boolean coe_checkOrderOfAddends(coe_coef_t *pCoef)
 {
     if(!coe_isCoefAddendNull(pCoef))
     {
-        assert(pCoef->factor == 1  ||  pCoef->factor == -1);
-        coe_productOfConst_t productBefore = pCoef->productOfConst;
+        const unsigned int noWords = coe_getNoWordsOfProduct();
+        assert(pCoef->factor != 0);
+        const coe_productOfConstWord_t *productBefore = pCoef->productOfConst;
         pCoef = pCoef->pNext;
         while(!coe_isCoefAddendNull(pCoef))
         {
-            assert(pCoef->factor == 1  ||  pCoef->factor == -1);
-            if(productBefore <= pCoef->productOfConst)
+            assert(pCoef->factor != 0);
+            if(coe_compareProductOfConst(productBefore, pCoef->productOfConst, noWords) <= 0)
                 return false;
                 
             productBefore = pCoef->productOfConst;
@@ -298,7 +994,7 @@ boolean coe_checkOrderOfAddends(coe_coef_t *pCoef)
  *   The sorting algorithm is very simple and of order O(n^2). The use of this function can
  * be avoided in most use cases by creating a new coefficient object as a null object and
  * then adding its terms with function void coe_addAddend(coe_coef_t **, const
- * coe_numericFactor_t, coe_productOfConst_t). This is more elegant but doesn't perform
+ * coe_numericFactor_t, const coe_productOfConst_t). This is more elegant but doesn't perform
  * better (also O(n^2)).
  *   @param ppCoef
  * The function operates in place. The pointer to the head of the list of addends is passed
@@ -377,26 +1073,28 @@ void coe_logCoefficient( const coe_coef_t * const pCoef
             memset(tabStr, /* value */ ' ', /* noBytes */ tabPos);
             tabStr[tabPos] = '\0';
 
-            /* Write the numerical constant (1 or -1) but force having a sign. */
+            /* Write the numerical constant but force having a sign. */
             i = pAddend->factor;
             log_log(_log, log_continueLine, "%c", i<0? '-': '+');
-            if((i != 1 && i != -1) ||  pAddend->productOfConst == 0)
+            if((i != 1 && i != -1)
+               ||  coe_isProductOfNoConst(pAddend->productOfConst, coe_getNoWordsOfProduct())
+              )
             {
                 log_log(_log, log_continueLine, "%ld", i<0? -i: i);
                 firstTerm = false;
             }
 
             signed int idxVar = pTableOfVars->noConstants - 1;
-            const coe_productOfConst_t prodOfConst = pAddend->productOfConst;
+            const coe_productOfConstWord_t * const prodOfConst = pAddend->productOfConst;
 
 #if 1 // Set to 0 in order to get a concise binary representation of the product of constants
 
-            coe_productOfConst_t mask = idxVar >= 0? ((coe_productOfConst_t)0x1 << idxVar)
-                                                   : (coe_productOfConst_t)0x1;
-            assert(mask != 0);
+            assert(pTableOfVars->noConstants
+                   <= coe_getNoWordsOfProduct()*COE_NO_CONST_PER_WORD
+                  );
             while(idxVar >= 0)
             {
-                if((mask & prodOfConst) != 0)
+                if(coe_isConstInProductOfConst(prodOfConst, (unsigned)idxVar))
                 {
                     if(!firstTerm)
                         log_log(_log, log_continueLine, "*");
@@ -410,7 +1108,6 @@ void coe_logCoefficient( const coe_coef_t * const pCoef
                 }
                 
                 -- idxVar;
-                mask >>= 1;            
             }
 #else
             if(!firstTerm)
@@ -419,7 +1116,7 @@ void coe_logCoefficient( const coe_coef_t * const pCoef
             
             /* The product of constants is not shown as such but its binary representation
                is printed instead. */
-            log_log(_log, log_continueLine, "0x%x", prodOfConst);
+            log_log(_log, log_continueLine, "0x%llx", prodOfConst[0]);
 #endif
             pAddend = pAddend->pNext;
 
@@ -506,7 +1203,7 @@ void coe_logMatrix( log_logLevel_t logLevel
  * A constant integer not equal to null.
  */
 
-coe_coef_t *coe_mulConst(coe_coef_t * const pCoef, signed int constant)
+coe_coef_t *coe_mulConst(coe_coef_t * const pCoef, coe_numericFactor_t constant)
 {
     assert(constant != 0);
     coe_coef_t *pC = pCoef;
@@ -528,6 +1225,64 @@ coe_coef_t *coe_mulConst(coe_coef_t * const pCoef, signed int constant)
 
 
 
+/**
+ * The product of two coefficients.
+ *   @return
+ * The product is returned as a new coefficient object.
+ *   @param pOperand1
+ * First operand by reference. It is not changed.
+ *   @param pOperand2
+ * Second operand by reference. It is not changed.
+ *   @remark
+ * The operands must not have any constant in common. The representation of a coefficient
+ * doesn't support powers of constants other than zero and one. This is e.g. the case for
+ * coefficients, which belong to independent parts of a circuit.
+ */
+
+coe_coef_t *coe_mul(const coe_coef_t * const pOperand1, const coe_coef_t * const pOperand2)
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    coe_coef_t *pResult = coe_coefAddendNull();
+    const coe_coefAddend_t *pAddend1;
+    for(pAddend1=pOperand1; !coe_isCoefAddendNull(pAddend1); pAddend1=pAddend1->pNext)
+    {
+        /* The products of an addend of the first operand with all addends of the second
+           operand have the order of the addends of the second operand as they don't share
+           any constant. The partial product is built up in the required order and it is
+           then added - as subtraction of its negation. */
+        coe_coef_t *pNegProduct = coe_coefAddendNull();
+        coe_coefAddend_t **ppTail = &pNegProduct;
+        const coe_coefAddend_t *pAddend2;
+        for(pAddend2=pOperand2; !coe_isCoefAddendNull(pAddend2); pAddend2=pAddend2->pNext)
+        {
+            coe_coefAddend_t * const pNewAddend = coe_newCoefAddend();
+            pNewAddend->factor = - pAddend1->factor * pAddend2->factor;
+            unsigned int idxWord;
+            for(idxWord=0; idxWord<noWords; ++idxWord)
+            {
+                assert((pAddend1->productOfConst[idxWord] & pAddend2->productOfConst[idxWord])
+                       == 0
+                      );
+                pNewAddend->productOfConst[idxWord] = pAddend1->productOfConst[idxWord]
+                                                      | pAddend2->productOfConst[idxWord];
+            }
+            *ppTail = pNewAddend;
+            ppTail = &pNewAddend->pNext;
+        }
+        *ppTail = coe_coefAddendNull();
+        assert(coe_checkOrderOfAddends(pNegProduct));
+
+        pResult = coe_diff(pResult, pNegProduct);
+        coe_freeCoef(pNegProduct);
+    }
+
+    return pResult;
+
+} /* End of coe_mul */
+
+
+
+
 /**
  * The difference of two coefficients. The second operand is subtracted in place from the
  * first operand.
@@ -546,38 +1301,54 @@ coe_coef_t *coe_diff(coe_coef_t *pResOperand1, const coe_coef_t * const pOperand
 {
     /* Each addend of the second operand is either subtracted from an equivalent term in the
        first operand or copied with inverse sign into the first operands list of addends.
-       (An equivalent term has the identical product of constants.) */
+       (An equivalent term has the identical product of constants.)
+         Both lists are sorted in the same order, so a single linear pass through both
+       lists suffices: The search for the position of the next addend of the second operand
+       continues where the previous search had ended. */
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    coe_coefAddend_t **ppOp1 = &pResOperand1;
     const coe_coef_t *pOp2 = pOperand2;
     while(!coe_isCoefAddendNull(pOp2))
     {
-        coe_coefAddend_t *pOp1 = pResOperand1
-                       , **ppOp1 = &pResOperand1;
-        const coe_productOfConst_t prodOfConstOp2 = pOp2->productOfConst;
+        coe_coefAddend_t *pOp1 = *ppOp1;
+        const coe_productOfConstWord_t * const prodOfConstOp2 = pOp2->productOfConst;
 
         /* The addends of a coefficient are ordered by falling value of the bit vector
            "product of constants", where this bitvector is read as an unsigned integer. We
            iterate along the result list until we find the location, where the current
            addend of the second operand belongs. This can be the head or the tail of the
            list or an existing element with identical product of constants. */
-        while(!coe_isCoefAddendNull(pOp1) &&  pOp1->productOfConst > prodOfConstOp2)
+        signed int cmp = 0;
+        while(!coe_isCoefAddendNull(pOp1)
+              &&  (cmp = coe_compareProductOfConst( pOp1->productOfConst
+                                                  , prodOfConstOp2
+                                                  , noWords
+                                                  )
+                  ) > 0
+             )
         {
             ppOp1 = &pOp1->pNext;
             pOp1  = pOp1->pNext;
         }
             
-        if(coe_isCoefAddendNull(pOp1) ||  pOp1->productOfConst < prodOfConstOp2)
+        if(coe_isCoefAddendNull(pOp1) ||  cmp < 0)
         {
             /* There's no equivalent addend in the result list. Copy the addend with
                inverse sign from Op2 to the result. */
             *ppOp1 = coe_newCoefAddend();
             (*ppOp1)->pNext = pOp1;
             (*ppOp1)->factor = - pOp2->factor;
-            (*ppOp1)->productOfConst = prodOfConstOp2;
+            coe_copyProductOfConst((*ppOp1)->productOfConst, prodOfConstOp2, noWords);
+
+            /* The next addend of Op2 belongs behind the inserted one. */
+            ppOp1 = &(*ppOp1)->pNext;
         }
         else
         {
             /* An equivalent addent is present in op1, simply add the factors. */
-            assert(pOp1->productOfConst == prodOfConstOp2);
+            assert(coe_compareProductOfConst(pOp1->productOfConst, prodOfConstOp2, noWords)
+                   == 0
+                  );
             pOp1->factor -= pOp2->factor;
 
             /* If the difference of factor is null we need to remove the addend from the
@@ -588,6 +1359,8 @@ coe_coef_t *coe_diff(coe_coef_t *pResOperand1, const coe_coef_t * const pOperand
                 *ppOp1 = pOp1->pNext;
                 coe_freeCoefAddend(pOp1);
             }
+            else
+                ppOp1 = &pOp1->pNext;
         }
 
         pOp2 = pOp2->pNext;
@@ -602,4 +1375,470 @@ coe_coef_t *coe_diff(coe_coef_t *pResOperand1, const coe_coef_t * const pOperand
 
 
 
+/**
+ * Initialize a packed coefficient object prior to its first use. It represents null
+ * after initialization.
+ *   @param pPackedCoef
+ * The object to initialize.
+ *   @see void coe_freePackedCoef(coe_packedCoef_t * const)
+ */
+
+void coe_initPackedCoef(coe_packedCoef_t * const pPackedCoef)
+{
+    pPackedCoef->noAddends = 0;
+    pPackedCoef->maxNoAddends = 0;
+    pPackedCoef->noWordsOfProduct = 1;
+    pPackedCoef->productOfConstAry = NULL;
+    pPackedCoef->factorAry = NULL;
+
+} /* End of coe_initPackedCoef */
+
+
+
+
+/**
+ * Release the memory of a packed coefficient object after use. The object may be
+ * initialized again and reused afterwards.
+ *   @param pPackedCoef
+ * The object to free.
+ */
+
+void coe_freePackedCoef(coe_packedCoef_t * const pPackedCoef)
+{
+    free(pPackedCoef->productOfConstAry);
+    free(pPackedCoef->factorAry);
+    coe_initPackedCoef(pPackedCoef);
+
+} /* End of coe_freePackedCoef */
+
+
+
+
+/**
+ * Ensure that a packed coefficient object has the capacity to store a given number of
+ * addends of the circuit under progress. The current contents are kept - unless the
+ * number of words of a product of constants has changed since the object was used
+ * before.
+ *   @param pPackedCoef
+ * The object to operate on.
+ *   @param noAddends
+ * The required capacity.
+ */
+
+void coe_reservePackedCoef(coe_packedCoef_t * const pPackedCoef, unsigned int noAddends)
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    if(noAddends > pPackedCoef->maxNoAddends  ||  noWords != pPackedCoef->noWordsOfProduct)
+    {
+        /* Grow exponentially to avoid frequent reallocation. */
+        unsigned int maxNoAddends = 2*pPackedCoef->maxNoAddends;
+        if(maxNoAddends < noAddends)
+            maxNoAddends = noAddends;
+        if(maxNoAddends < 16)
+            maxNoAddends = 16;
+
+        pPackedCoef->productOfConstAry =
+                        srealloc( pPackedCoef->productOfConstAry
+                                , maxNoAddends * noWords
+                                  * sizeof(pPackedCoef->productOfConstAry[0])
+                                , __FILE__
+                                , __LINE__
+                                );
+        pPackedCoef->factorAry = srealloc( pPackedCoef->factorAry
+                                         , maxNoAddends * sizeof(pPackedCoef->factorAry[0])
+                                         , __FILE__
+                                         , __LINE__
+                                         );
+        pPackedCoef->maxNoAddends = maxNoAddends;
+        pPackedCoef->noWordsOfProduct = noWords;
+    }
+} /* End of coe_reservePackedCoef */
+
+
+
+
+/**
+ * Convert a coefficient into packed representation. The list of addends is not changed.
+ *   @param pPackedCoef
+ * The result. The previous contents of the object are overwritten.
+ *   @param pCoef
+ * The coefficient to pack.
+ */
+
+void coe_packCoef(coe_packedCoef_t * const pPackedCoef, const coe_coef_t *pCoef)
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    if(noWords != pPackedCoef->noWordsOfProduct)
+        coe_reservePackedCoef(pPackedCoef, /* noAddends */ 0);
+
+    unsigned int noAddends = 0;
+    while(!coe_isCoefAddendNull(pCoef))
+    {
+        if(noAddends >= pPackedCoef->maxNoAddends)
+            coe_reservePackedCoef(pPackedCoef, noAddends+1);
+
+        coe_copyProductOfConst( &pPackedCoef->productOfConstAry[noAddends*noWords]
+                              , pCoef->productOfConst
+                              , noWords
+                              );
+        pPackedCoef->factorAry[noAddends] = pCoef->factor;
+        ++ noAddends;
+
+        pCoef = pCoef->pNext;
+    }
+    pPackedCoef->noAddends = noAddends;
+
+} /* End of coe_packCoef */
+
+
+
+
+/**
+ * Make a coefficient in list representation from a packed coefficient.
+ *   @return
+ * The new coefficient is returned. It needs to be freed after use with coe_freeCoef.
+ *   @param pPackedCoef
+ * The packed coefficient. It is not changed.
+ */
+
+coe_coef_t *coe_unpackCoef(const coe_packedCoef_t * const pPackedCoef)
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    assert(pPackedCoef->noAddends == 0  ||  pPackedCoef->noWordsOfProduct == noWords);
+    coe_coef_t *pCoef = coe_coefAddendNull()
+             , **ppCoefEnd = &pCoef;
+    unsigned int u;
+    for(u=0; u<pPackedCoef->noAddends; ++u)
+    {
+        coe_coefAddend_t * const pAddend = coe_newCoefAddend();
+        pAddend->factor = pPackedCoef->factorAry[u];
+        coe_copyProductOfConst( pAddend->productOfConst
+                              , &pPackedCoef->productOfConstAry[u*noWords]
+                              , noWords
+                              );
+        *ppCoefEnd = pAddend;
+        ppCoefEnd = &pAddend->pNext;
+    }
+    *ppCoefEnd = NULL;
+
+    assert(coe_checkOrderOfAddends(pCoef));
+    return pCoef;
+
+} /* End of coe_unpackCoef */
+
+
+
+
+
+/**
+ * Create a new accumulator of coefficient addends. The accumulator is initially empty.
+ *   @return
+ * Get the pointer to the new object. Delete it after use with coe_deleteAccumulator.
+ *   @see void coe_deleteAccumulator(coe_accumulator_t * const)
+ */
+
+coe_accumulator_t *coe_createAccumulator()
+{
+    coe_accumulator_t * const pAcc = smalloc(sizeof(coe_accumulator_t), __FILE__, __LINE__);
+
+    pAcc->noWordsOfProduct = coe_getNoWordsOfProduct();
+    pAcc->sizeOfSlot = sizeof(coe_accumulatorSlot_t)
+                       + pAcc->noWordsOfProduct*sizeof(coe_productOfConstWord_t);
+    pAcc->log2NoSlots = LOG2_INITIAL_NO_ACCUMULATOR_SLOTS;
+    const unsigned int noSlots = 1u << pAcc->log2NoSlots;
+    pAcc->slotAry = smalloc(noSlots*pAcc->sizeOfSlot, __FILE__, __LINE__);
+    unsigned int u;
+    for(u=0; u<noSlots; ++u)
+        coe_getAccumulatorSlot(pAcc, u)->cycle = 0;
+    pAcc->cycle = 1;
+    pAcc->noSlotsInUse = 0;
+
+    pAcc->maxNoHeapElements = noSlots/2;
+    pAcc->heapAry = smalloc( pAcc->maxNoHeapElements * pAcc->noWordsOfProduct
+                             * sizeof(pAcc->heapAry[0])
+                           , __FILE__
+                           , __LINE__
+                           );
+    pAcc->noHeapElements = 0;
+
+    return pAcc;
+
+} /* End of coe_createAccumulator */
+
+
+
+
+/**
+ * Delete an accumulator after use.
+ *   @param pAcc
+ * The pointer to the object to delete, as got from coe_createAccumulator.
+ */
+
+void coe_deleteAccumulator(coe_accumulator_t * const pAcc)
+{
+    free(pAcc->slotAry);
+    free(pAcc->heapAry);
+    free(pAcc);
+
+} /* End of coe_deleteAccumulator */
+
+
+
+
+/**
+ * Double the size of the hash table of an accumulator. All entries of the current cycle
+ * are kept. The heap of products of constants is not affected.\n
+ *   This function is used by the inline interface only.
+ *   @param pAcc
+ * The accumulator.
+ */
+
+void coe_growAccumulator(coe_accumulator_t * const pAcc)
+{
+    coe_accumulator_t oldAcc = *pAcc;
+    const unsigned int oldNoSlots = 1u << pAcc->log2NoSlots;
+
+    ++ pAcc->log2NoSlots;
+    const unsigned int noSlots = 1u << pAcc->log2NoSlots
+                     , mask = noSlots - 1;
+    assert(pAcc->log2NoSlots < 32);
+    pAcc->slotAry = smalloc(noSlots*pAcc->sizeOfSlot, __FILE__, __LINE__);
+    unsigned int u;
+    for(u=0; u<noSlots; ++u)
+        coe_getAccumulatorSlot(pAcc, u)->cycle = 0;
+
+    /* Re-enter all entries of the current cycle. */
+    for(u=0; u<oldNoSlots; ++u)
+    {
+        const coe_accumulatorSlot_t * const pOldSlot = coe_getAccumulatorSlot(&oldAcc, u);
+        if(pOldSlot->cycle == pAcc->cycle)
+        {
+            unsigned int idxSlot = coe_getAccumulatorSlotIdx(pAcc, pOldSlot->productOfConst);
+            while(coe_getAccumulatorSlot(pAcc, idxSlot)->cycle == pAcc->cycle)
+                idxSlot = (idxSlot+1) & mask;
+            memcpy(coe_getAccumulatorSlot(pAcc, idxSlot), pOldSlot, pAcc->sizeOfSlot);
+        }
+    }
+    free(oldAcc.slotAry);
+
+} /* End of coe_growAccumulator */
+
+
+
+
+/**
+ * Adapt an accumulator to another number of words of a product of constants. The
+ * accumulator needs to be reset after this operation; its contents are lost.\n
+ *   This function is used by the inline interface only.
+ *   @param pAcc
+ * The accumulator.
+ *   @param noWords
+ * The new number of words of a product of constants.
+ */
+
+void coe_setNoWordsOfAccumulator(coe_accumulator_t * const pAcc, unsigned int noWords)
+{
+    assert(noWords >= 1  &&  noWords <= COE_MAX_NO_WORDS_OF_PRODUCT);
+    pAcc->noWordsOfProduct = noWords;
+    pAcc->sizeOfSlot = sizeof(coe_accumulatorSlot_t)
+                       + noWords*sizeof(coe_productOfConstWord_t);
+
+    /* The size of the hash table is kept. */
+    const unsigned int noSlots = 1u << pAcc->log2NoSlots;
+    free(pAcc->slotAry);
+    pAcc->slotAry = smalloc(noSlots*pAcc->sizeOfSlot, __FILE__, __LINE__);
+    unsigned int u;
+    for(u=0; u<noSlots; ++u)
+        coe_getAccumulatorSlot(pAcc, u)->cycle = 0;
+    pAcc->cycle = 1;
+    pAcc->noSlotsInUse = 0;
+
+    pAcc->heapAry = srealloc( pAcc->heapAry
+                            , pAcc->maxNoHeapElements * noWords * sizeof(pAcc->heapAry[0])
+                            , __FILE__
+                            , __LINE__
+                            );
+    pAcc->noHeapElements = 0;
+
+} /* End of coe_setNoWordsOfAccumulator */
+
+
+
+
+/**
+ * Add a single addend (i.e. a product of constants and a numeric factor) to an
+ * accumulator, whose products of constants have more than one word. See
+ * coe_accumulateAddend for details.\n
+ *   This function is used by the inline interface only.
+ *   @param pAcc
+ * The accumulator.
+ *   @param factor
+ * The new addend is passed as pair of primitive data types. Here the numeric factor, which
+ * must not be null.
+ *   @param productOfConst
+ * The new addend is passed as pair of primitive data types. Here the product of constants.
+ */
+
+void coe_accumulateAddendMultiWord
+                                    ( coe_accumulator_t * const pAcc
+                                    , const coe_numericFactor_t factor
+                                    , const coe_productOfConstWord_t * const productOfConst
+                                    )
+{
+    assert(factor != 0  &&  pAcc->noWordsOfProduct > 1);
+    const unsigned int noWords = pAcc->noWordsOfProduct;
+
+    /* Look for the entry of the hash table, using linear probing. */
+    const unsigned int mask = (1u<<pAcc->log2NoSlots) - 1;
+    unsigned int idxSlot = coe_getAccumulatorSlotIdx(pAcc, productOfConst);
+    coe_accumulatorSlot_t *pSlot = coe_getAccumulatorSlot(pAcc, idxSlot);
+    while(pSlot->cycle == pAcc->cycle)
+    {
+        if(coe_compareProductOfConst(pSlot->productOfConst, productOfConst, noWords) == 0)
+        {
+            /* Combine with the existing addend. A null sum is kept as such; it's skipped
+               when fetching the addends. */
+            pSlot->factor += factor;
+            return;
+        }
+        idxSlot = (idxSlot+1) & mask;
+        pSlot = coe_getAccumulatorSlot(pAcc, idxSlot);
+    }
+
+    /* Product of constants not found: Occupy the empty entry. */
+    coe_copyProductOfConst(pSlot->productOfConst, productOfConst, noWords);
+    pSlot->factor = factor;
+    pSlot->cycle = pAcc->cycle;
+
+    /* Put the new product of constants into the heap. */
+    if(pAcc->noHeapElements >= pAcc->maxNoHeapElements)
+    {
+        pAcc->maxNoHeapElements *= 2;
+        pAcc->heapAry = srealloc( pAcc->heapAry
+                                , pAcc->maxNoHeapElements * noWords * sizeof(pAcc->heapAry[0])
+                                , __FILE__
+                                , __LINE__
+                                );
+    }
+    unsigned int idxHeap = pAcc->noHeapElements++;
+    while(idxHeap > 0)
+    {
+        const unsigned int idxParent = (idxHeap-1) / 2;
+        if(coe_compareProductOfConst( &pAcc->heapAry[idxParent*noWords]
+                                    , productOfConst
+                                    , noWords
+                                    ) >= 0
+          )
+        {
+            break;
+        }
+        coe_copyProductOfConst( &pAcc->heapAry[idxHeap*noWords]
+                              , &pAcc->heapAry[idxParent*noWords]
+                              , noWords
+                              );
+        idxHeap = idxParent;
+    }
+    coe_copyProductOfConst(&pAcc->heapAry[idxHeap*noWords], productOfConst, noWords);
+
+    /* Keep the load factor of the hash table below one half. */
+    if(++pAcc->noSlotsInUse > mask/2)
+        coe_growAccumulator(pAcc);
+
+} /* End of coe_accumulateAddendMultiWord */
+
+
+
+/**
+ * Fetch the accumulated addend with the greatest product of constants from an
+ * accumulator, whose products of constants have more than one word. See
+ * coe_fetchMaxAddend for details.\n
+ *   This function is used by the inline interface only.
+ *   @return
+ * \a true if an addend is returned, \a false if the accumulator doesn't contain any non
+ * null addend any more.
+ *   @param pAcc
+ * The accumulator.
+ *   @param productOfConst
+ * The product of constants of the fetched addend is returned in \a productOfConst. The
+ * array has room for a product of constants of the number of words of the accumulator.
+ *   @param pFactor
+ * The numeric factor of the fetched addend is returned in * \a pFactor.
+ *   @remark
+ * A fetched product of constants must not be accumulated again in the same cycle.
+ */
+
+boolean coe_fetchMaxAddendMultiWord( coe_accumulator_t * const pAcc
+                                   , coe_productOfConstWord_t * const productOfConst
+                                   , coe_numericFactor_t * const pFactor
+                                   )
+{
+    const unsigned int noWords = pAcc->noWordsOfProduct
+                     , mask = (1u<<pAcc->log2NoSlots) - 1;
+    coe_productOfConstWord_t * const heapAry = pAcc->heapAry;
+    while(pAcc->noHeapElements > 0)
+    {
+        /* Take the root of the heap and restore the heap property. The last element is not
+           overwritten while it is moved to its new position. */
+        coe_copyProductOfConst(productOfConst, &heapAry[0], noWords);
+        const unsigned int noHeapElements = --pAcc->noHeapElements;
+        const coe_productOfConstWord_t * const productOfConstLast =
+                                                        &heapAry[noHeapElements*noWords];
+        unsigned int idxHeap = 0, idxChild;
+        while((idxChild = 2*idxHeap+1) < noHeapElements)
+        {
+            if(idxChild+1 < noHeapElements
+               &&  coe_compareProductOfConst( &heapAry[(idxChild+1)*noWords]
+                                            , &heapAry[idxChild*noWords]
+                                            , noWords
+                                            ) > 0
+              )
+            {
+                ++ idxChild;
+            }
+            if(coe_compareProductOfConst( &heapAry[idxChild*noWords]
+                                        , productOfConstLast
+                                        , noWords
+                                        ) <= 0
+              )
+            {
+                break;
+            }
+            coe_copyProductOfConst( &heapAry[idxHeap*noWords]
+                                  , &heapAry[idxChild*noWords]
+                                  , noWords
+                                  );
+            idxHeap = idxChild;
+        }
+        if(idxHeap != noHeapElements)
+            coe_copyProductOfConst(&heapAry[idxHeap*noWords], productOfConstLast, noWords);
+
+        /* Look for the factor in the hash table. The entry is not removed from the table;
+           the constraint that the same product of constants is not accumulated again makes
+           this unnecessary. */
+        unsigned int idxSlot = coe_getAccumulatorSlotIdx(pAcc, productOfConst);
+        const coe_accumulatorSlot_t *pSlot = coe_getAccumulatorSlot(pAcc, idxSlot);
+        while(coe_compareProductOfConst(pSlot->productOfConst, productOfConst, noWords) != 0
+              ||  pSlot->cycle != pAcc->cycle
+             )
+        {
+            assert(pSlot->cycle == pAcc->cycle);
+            idxSlot = (idxSlot+1) & mask;
+            pSlot = coe_getAccumulatorSlot(pAcc, idxSlot);
+        }
+
+        if(pSlot->factor != 0)
+        {
+            *pFactor = pSlot->factor;
+            return true;
+        }
+    } /* End while(Heap not empty but all fetched addends have been null) */
+
+    return false;
+
+} /* End of coe_fetchMaxAddendMultiWord */
+
+
+
+
+
 
@@ -35,9 +35,21 @@
  * Defines
  */
 
+/** The number of symbolic constants, which are represented by one word of a product of
+    constants. */
+#define COE_NO_CONST_PER_WORD   (sizeof(coe_productOfConstWord_t)*8)
+
+/** The maximum number of words of a product of constants. The number of words actually in
+    use is chosen per circuit, see coe_setNoConstants. */
+#define COE_MAX_NO_WORDS_OF_PRODUCT 4
+
 /** The maximum number of symbolic constants, which is about the maximum number of connected
     devices. */
-#define COE_MAX_NO_CONST  (sizeof(coe_productOfConst_t)*8)
+#define COE_MAX_NO_CONST  (COE_MAX_NO_WORDS_OF_PRODUCT*COE_NO_CONST_PER_WORD)
+
+/** The product of constants, which doesn't contain any constant, i.e. the product
+    representing one. */
+#define COE_PRODUCT_OF_NO_CONST ((coe_productOfConst_t){.wordAry = {0}})
 
 
 /*
@@ -46,7 +58,10 @@
 
 /** Part of the coefficient or an addend of a coefficient: The product of constants. As all
     constants occur either with power 0 or 1, the product is represented by a bit vector,
-    where each bit means another constant.\n
+    where each bit means another constant. The bit vector is made of one or more words of
+    this type; constant \a i is bit \a i%#COE_NO_CONST_PER_WORD of word \a
+    i/#COE_NO_CONST_PER_WORD. The product is compared as a binary number, where the last
+    word is the most significant one.\n
       Any one out of the four unsigned integer types char, short, long and long long can be
     used. The performance differences are however minor so that there's no good raeson not
     to always use the 64 Bit type. Here's a performance measurement of a quite complex
@@ -56,12 +71,29 @@
       win32, long long: 5755 ms\n 
       win64, short:     6187 ms\n
       win64, long:      6273 ms\n
-      win64, long long: 6646 ms */ 
-typedef unsigned long long coe_productOfConst_t;
+      win64, long long: 6646 ms\n
+      The number of words matters however much more. It is chosen per circuit as the least
+    number of words, which can hold all of its constants, see coe_setNoConstants. All
+    circuits with up to 64 constants use a single word; the solver has a dedicated, fast
+    path for them. */ 
+typedef unsigned long long coe_productOfConstWord_t;
+
+
+/** A product of constants as a self-contained value. It has room for the maximum number of
+    constants but only the first coe_getNoWordsOfProduct() words are significant. The
+    type is used to pass products of constants, which are not yet stored in a
+    coefficient. */
+typedef struct coe_productOfConst_t
+{
+    /** The words of the bit vector. */
+    coe_productOfConstWord_t wordAry[COE_MAX_NO_WORDS_OF_PRODUCT];
+
+} coe_productOfConst_t;
 
 
 /** Part of the coefficient or an addend of a coefficient: The numeric constant, usually
-    only 1 or -1. */
+    only 1 or -1. Other values result from devices with numeric value, which are
+    substituted into the LES. */
 typedef signed long coe_numericFactor_t;
 
 
@@ -74,11 +106,15 @@ typedef struct coe_coefAddend_t
         needs to be identical to the address of the entire struct. */ 
     struct coe_coefAddend_t *pNext;
     
-    /** The numeric factor of the product of constants. Normally either 1 or -1. */
+    /** The numeric factor of the product of constants. Normally either 1 or -1 unless
+        devices with numeric value have been substituted. */
     coe_numericFactor_t factor;
     
-    /** A product of constants. Each set bit is related to one multiplied constant. */
-    coe_productOfConst_t productOfConst;
+    /** A product of constants. Each set bit is related to one multiplied constant. The
+        array has coe_getNoWordsOfProduct() elements; the size of the addend objects
+        depends on the circuit under progress.
+          @remark This member needs to be the last one. */
+    coe_productOfConstWord_t productOfConst[];
    
 } coe_coefAddend_t;
 
@@ -100,6 +136,120 @@ typedef signed long coe_integerFactor_t;
 typedef coe_coef_t ***coe_coefMatrix_t;
 
 
+/** The type of the kernel, which combines an addend with all addends of a packed
+    coefficient and filters the relevant products for the elementary step of the solver.
+    See coe_filterProductsScalar for the specification. The kernel is used for products
+    of constants of a single word. */
+typedef unsigned int (*coe_fctFilterProducts_t)
+                                    ( coe_productOfConstWord_t * const prodOfConstResAry
+                                    , coe_numericFactor_t * const factorResAry
+                                    , coe_productOfConstWord_t prodOfConst1
+                                    , coe_numericFactor_t factor1
+                                    , const coe_productOfConstWord_t * const prodOfConst2Ary
+                                    , const coe_numericFactor_t * const factor2Ary
+                                    , unsigned int noAddends2
+                                    , coe_productOfConstWord_t prodOfConstDiv
+                                    );
+
+
+/** A coefficient in packed representation. Other than the normal representation as
+    linked list of addends, the addends are stored in two parallel arrays, one for the
+    products of constants and one for the numeric factors. The addends have the same order
+    as in the list, i.e. they are sorted in falling binary value of the product of
+    constants.\n
+      The packed representation is used for the operands of the inner loops of the solver,
+    which are iterated many times: Contiguous arrays avoid the cache misses of chasing the
+    pointers of the linked list through scattered chunks of the heap. Otherwise the list
+    representation is still used throughout the application; conversion in both
+    directions is offered.\n
+      A packed coefficient is a reusable object. Its arrays grow on demand and keep their
+    size until it is freed. */
+typedef struct coe_packedCoef_t
+{
+    /** The number of addends of the coefficient. Zero means a null coefficient. */
+    unsigned int noAddends;
+
+    /** The allocated size of the two arrays as number of addends. */
+    unsigned int maxNoAddends;
+
+    /** The number of words of a product of constants, which the arrays have been allocated
+        for. */
+    unsigned int noWordsOfProduct;
+
+    /** The products of constants of all addends. Each product has \a noWordsOfProduct
+        words; the product of addend \a i begins at index \a i*noWordsOfProduct. */
+    coe_productOfConstWord_t *productOfConstAry;
+
+    /** The numeric factors of all addends. */
+    coe_numericFactor_t *factorAry;
+
+} coe_packedCoef_t;
+
+
+/** One entry of the hash table of an accumulator of coefficient addends. The size of an
+    entry depends on the number of words of a product of constants. */
+typedef struct coe_accumulatorSlot_t
+{
+    /** The sum of the factors of all accumulated addends with this product of constants. */
+    coe_numericFactor_t factor;
+
+    /** The entry is in use only if this counter matches the current cycle of the
+        accumulator. This way, the complete table can be cleared in no time. */
+    unsigned int cycle;
+
+    /** The product of constants of the accumulated addends; it is the key of the entry.
+          @remark This member needs to be the last one. */
+    coe_productOfConstWord_t productOfConst[];
+
+} coe_accumulatorSlot_t;
+
+
+/** An accumulator collects an arbitrary sequence of addends and combines all of those
+    with identical product of constants. Other than a coefficient, a sorted linked list of
+    addends, it doesn't need a linear search to find the position of a new addend: The
+    addends are found by a hash table, which is keyed by the product of constants. A
+    binary heap of the products of constants permits to fetch the addends ordered by
+    falling binary value of their product of constants, i.e. in the order of the addends of
+    a coefficient.\n
+      The accumulator is a reusable object. It is cleared for the next use in constant
+    time and its storage grows on demand. */
+typedef struct coe_accumulator_t
+{
+    /** The number of words of a product of constants, which the accumulator has been
+        set up for. */
+    unsigned int noWordsOfProduct;
+
+    /** The size in Byte of an entry of the hash table. */
+    unsigned int sizeOfSlot;
+
+    /** The hash table. The number of its entries is a power of two. Use
+        coe_getAccumulatorSlot to access an entry. */
+    coe_accumulatorSlot_t *slotAry;
+
+    /** The hash table has \a 2^log2NoSlots entries. */
+    unsigned int log2NoSlots;
+
+    /** The number of used entries of the hash table in the current cycle. */
+    unsigned int noSlotsInUse;
+
+    /** The current cycle of use. Only those table entries are in use, which have the same
+        value. */
+    unsigned int cycle;
+
+    /** The binary max-heap of all products of constants, which have been accumulated in
+        the current cycle and which have not been fetched yet. Each element of the heap has
+        \a noWordsOfProduct words. */
+    coe_productOfConstWord_t *heapAry;
+
+    /** The number of elements of the heap. */
+    unsigned int noHeapElements;
+
+    /** The allocated size of \a heapAry. */
+    unsigned int maxNoHeapElements;
+
+} coe_accumulator_t;
+
+
 /** A forward declaration to an external type in order to avoid crosswise includes. Never
     use this type. */
 struct tbv_tableOfVariables_t;
@@ -122,9 +272,27 @@ void coe_initModule(log_hLogger_t hGlobalLogger);
     orphaned handles, etc. */
 void coe_shutdownModule(void);
 
+/** Choose the representation of products of constants for the next circuit. */
+void coe_setNoConstants(unsigned int noConstants);
+
+/** Create a heap for coefficients, which is used by another thread. */
+mem_hHeap_t coe_createHeapForThread(void);
+
+/** Select the heap for coefficients of the calling thread. */
+void coe_setHeapOfThread(mem_hHeap_t hHeap, unsigned int noWordsOfProduct);
+
+/** Delete a heap for coefficients, which had been used by another thread. */
+void coe_deleteHeapForThread(mem_hHeap_t hHeap);
+
 /** Make a complete copy of all the addends of a coefficient. */
 coe_coef_t *coe_cloneByDeepCopy(const coe_coef_t *pCoef);
 
+/** Compare two coefficients. */
+boolean coe_isEqualCoef(const coe_coef_t *pCoef1, const coe_coef_t *pCoef2);
+
+/** Compute a hash code of a coefficient. */
+unsigned long long coe_getHashOfCoef(const coe_coef_t *pCoef);
+
 #if 1
 CRM_DECLARE_CREATE_MATRIX(/* modulePrefix */  coe, /* elementType_t */ coe_coef_t*)
 #else // For documentation purpose:
@@ -156,9 +324,78 @@ void coe_logMatrix( log_logLevel_t logLevel
                   );
 
 /** Multiply a coefficient with an integer constant. */
-coe_coef_t *coe_mulConst(coe_coef_t * const pCoef, signed int constant);
+coe_coef_t *coe_mulConst(coe_coef_t * const pCoef, coe_numericFactor_t constant);
+
+/** Multiply two coefficients, which don't have any constant in common. */
+coe_coef_t *coe_mul(const coe_coef_t * const pOperand1, const coe_coef_t * const pOperand2);
 
 /** SUbtract two coefficients. */
 coe_coef_t *coe_diff(coe_coef_t *pResOp1, const coe_coef_t * const pOp2);
 
+/** Initialize a packed coefficient object prior to its first use. */
+void coe_initPackedCoef(coe_packedCoef_t * const pPackedCoef);
+
+/** Release the memory of a packed coefficient object after use. */
+void coe_freePackedCoef(coe_packedCoef_t * const pPackedCoef);
+
+/** Ensure the capacity of a packed coefficient object. */
+void coe_reservePackedCoef(coe_packedCoef_t * const pPackedCoef, unsigned int noAddends);
+
+/** Convert a coefficient into packed representation. */
+void coe_packCoef(coe_packedCoef_t * const pPackedCoef, const coe_coef_t *pCoef);
+
+/** Make a coefficient in list representation from a packed coefficient. */
+coe_coef_t *coe_unpackCoef(const coe_packedCoef_t * const pPackedCoef);
+
+/** The filter and combine kernel: scalar implementation. */
+unsigned int coe_filterProductsScalar( coe_productOfConstWord_t * const prodOfConstResAry
+                                     , coe_numericFactor_t * const factorResAry
+                                     , coe_productOfConstWord_t prodOfConst1
+                                     , coe_numericFactor_t factor1
+                                     , const coe_productOfConstWord_t * const prodOfConst2Ary
+                                     , const coe_numericFactor_t * const factor2Ary
+                                     , unsigned int noAddends2
+                                     , coe_productOfConstWord_t prodOfConstDiv
+                                     );
+
+/** The filter and combine kernel for products of constants of more than one word. */
+unsigned int coe_filterProductsMultiWord
+                                ( coe_productOfConstWord_t * const prodOfConstResAry
+                                , coe_numericFactor_t * const factorResAry
+                                , const coe_productOfConstWord_t * const prodOfConst1
+                                , coe_numericFactor_t factor1
+                                , const coe_productOfConstWord_t * const prodOfConst2Ary
+                                , const coe_numericFactor_t * const factor2Ary
+                                , unsigned int noAddends2
+                                , const coe_productOfConstWord_t * const prodOfConstDiv
+                                , unsigned int noWords
+                                );
+
+/** Create a new, empty accumulator of coefficient addends. */
+coe_accumulator_t *coe_createAccumulator(void);
+
+/** Delete an accumulator of coefficient addends after use. */
+void coe_deleteAccumulator(coe_accumulator_t * const pAcc);
+
+/** Double the size of the hash table of an accumulator. Used by the inline interface. */
+void coe_growAccumulator(coe_accumulator_t * const pAcc);
+
+/** Adapt an accumulator to another number of words of a product of constants. Used by the
+    inline interface. */
+void coe_setNoWordsOfAccumulator(coe_accumulator_t * const pAcc, unsigned int noWords);
+
+/** Add an addend to an accumulator for products of more than one word. Used by the inline
+    interface. */
+void coe_accumulateAddendMultiWord( coe_accumulator_t * const pAcc
+                                  , const coe_numericFactor_t factor
+                                  , const coe_productOfConstWord_t * const productOfConst
+                                  );
+
+/** Fetch the greatest addend from an accumulator for products of more than one word. Used
+    by the inline interface. */
+boolean coe_fetchMaxAddendMultiWord( coe_accumulator_t * const pAcc
+                                   , coe_productOfConstWord_t * const productOfConst
+                                   , coe_numericFactor_t * const pFactor
+                                   );
+
 #endif  /* COE_COEFFICIENT_INCLUDED */
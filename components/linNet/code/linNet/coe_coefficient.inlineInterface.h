@@ -30,7 +30,11 @@
  * Include files
  */
 
+#include <limits.h>
+#include <assert.h>
+
 #include "types.h"
+#include "smalloc.h"
 #include "log_logger.h"
 #include "mem_memoryManager.h"
 #include "coe_coefficient.h"
@@ -40,6 +44,11 @@
  * Defines
  */
 
+/** The size in Byte of an entry of the hash table of an accumulator for products of
+    constants of a single word. */
+#define COE_SIZE_OF_SLOT_OF_SINGLE_WORD   \
+                (sizeof(coe_accumulatorSlot_t) + sizeof(coe_productOfConstWord_t))
+
 
 /*
  * Global type definitions
@@ -55,14 +64,228 @@
       @remark In DEBUG compilation and when the heap is destroyed at application
     termination time the heap is checked for still allocated objects. The client of the
     heap should return all requested objects in order to have a memory leak detection in
-    DEBUG compilation. */
-extern mem_hHeap_t coe_hHeapOfCoefAddend;
+    DEBUG compilation.
+      @remark The variable is thread-local. All threads but the main thread need to set
+    their own heap using coe_setHeapOfThread before making use of this module. */
+extern THREAD_LOCAL mem_hHeap_t coe_hHeapOfCoefAddend;
+
+/** The number of words of all products of constants of the circuit under progress.
+      @remark Although defined globally, nobody should ever use this variable directly.
+    Use the inline function coe_getNoWordsOfProduct instead.
+      @remark The variable is thread-local. It is set together with the heap of the
+    thread, see coe_setNoConstants and coe_setHeapOfThread. */
+extern THREAD_LOCAL unsigned int coe_noWordsOfProduct;
+
+/** The implementation of the filter and combine kernel, which is best suited for the CPU
+    the application is running on. It is selected at module initialization time.
+      @remark Although defined globally, nobody should ever use this variable directly.
+    Use the inline function coe_filterProducts instead. */
+extern coe_fctFilterProducts_t coe_fctFilterProducts;
 
 
 /*
  * Global inline functions
  */
 
+/**
+ * Get the number of words of a product of constants of the circuit under progress.
+ *   @return
+ * Get the number in the range 1..#COE_MAX_NO_WORDS_OF_PRODUCT.
+ */
+
+static inline unsigned int coe_getNoWordsOfProduct()
+{
+    return coe_noWordsOfProduct;
+
+} /* End of coe_getNoWordsOfProduct */
+
+
+
+
+/**
+ * Copy a product of constants.
+ *   @param productOfConstDest
+ * The destination of the copy operation.
+ *   @param productOfConstSrc
+ * The copied product of constants.
+ *   @param noWords
+ * The number of words of a product of constants.
+ */
+
+static inline void coe_copyProductOfConst
+                                ( coe_productOfConstWord_t * const productOfConstDest
+                                , const coe_productOfConstWord_t * const productOfConstSrc
+                                , unsigned int noWords
+                                )
+{
+    /* The single word is the most frequent case by far. */
+    if(noWords == 1)
+        productOfConstDest[0] = productOfConstSrc[0];
+    else
+    {
+        unsigned int idxWord;
+        for(idxWord=0; idxWord<noWords; ++idxWord)
+            productOfConstDest[idxWord] = productOfConstSrc[idxWord];
+    }
+} /* End of coe_copyProductOfConst */
+
+
+
+
+/**
+ * Compare two products of constants. The products are interpreted as unsigned binary
+ * numbers; this comparison defines the order of the addends of a coefficient.
+ *   @return
+ * Get a positive value if \a productOfConst1 is greater than \a productOfConst2, a
+ * negative value if it is less and null if both are identical.
+ *   @param productOfConst1
+ * The first product of constants.
+ *   @param productOfConst2
+ * The second product of constants.
+ *   @param noWords
+ * The number of words of a product of constants.
+ */
+
+static inline signed int coe_compareProductOfConst
+                                    ( const coe_productOfConstWord_t * const productOfConst1
+                                    , const coe_productOfConstWord_t * const productOfConst2
+                                    , unsigned int noWords
+                                    )
+{
+    /* The single word is the most frequent case by far. */
+    if(noWords == 1)
+        return (productOfConst1[0] > productOfConst2[0]) - (productOfConst1[0] < productOfConst2[0]);
+
+    /* The last word is the most significant one. */
+    unsigned int idxWord = noWords;
+    while(idxWord-- > 0)
+    {
+        if(productOfConst1[idxWord] != productOfConst2[idxWord])
+            return productOfConst1[idxWord] > productOfConst2[idxWord]? 1: -1;
+    }
+    return 0;
+
+} /* End of coe_compareProductOfConst */
+
+
+
+
+/**
+ * Check if a product of constants doesn't contain any constant, i.e. if it represents
+ * one.
+ *   @return
+ * Get the Boolean answer.
+ *   @param productOfConst
+ * The tested product of constants.
+ *   @param noWords
+ * The number of words of a product of constants.
+ */
+
+static inline boolean coe_isProductOfNoConst
+                                    ( const coe_productOfConstWord_t * const productOfConst
+                                    , unsigned int noWords
+                                    )
+{
+    unsigned int idxWord;
+    for(idxWord=0; idxWord<noWords; ++idxWord)
+    {
+        if(productOfConst[idxWord] != 0)
+            return false;
+    }
+    return true;
+
+} /* End of coe_isProductOfNoConst */
+
+
+
+
+/**
+ * Check if a given constant is contained in a product of constants.
+ *   @return
+ * Get the Boolean answer.
+ *   @param productOfConst
+ * The tested product of constants.
+ *   @param idxConst
+ * The index of the constant, i.e. the index of the bit, which represents the constant.
+ */
+
+static inline boolean coe_isConstInProductOfConst
+                                    ( const coe_productOfConstWord_t * const productOfConst
+                                    , unsigned int idxConst
+                                    )
+{
+    assert(idxConst < COE_MAX_NO_CONST);
+    return (productOfConst[idxConst/COE_NO_CONST_PER_WORD]
+            & ((coe_productOfConstWord_t)0x1 << (idxConst%COE_NO_CONST_PER_WORD))
+           ) != 0;
+
+} /* End of coe_isConstInProductOfConst */
+
+
+
+
+/**
+ * Find the next constant, which is contained in a product of constants.
+ *   @return
+ * Get the least index of a contained constant, which is not less than \a idxConst. Or get
+ * UINT_MAX if there's no such constant.
+ *   @param productOfConst
+ * The product of constants.
+ *   @param idxConst
+ * The index of the constant, where the search begins.
+ *   @param noWords
+ * The number of words of a product of constants.
+ */
+
+static inline unsigned int coe_findConstInProductOfConst
+                                    ( const coe_productOfConstWord_t * const productOfConst
+                                    , unsigned int idxConst
+                                    , unsigned int noWords
+                                    )
+{
+    unsigned int idxWord = idxConst / COE_NO_CONST_PER_WORD;
+    if(idxWord >= noWords)
+        return UINT_MAX;
+
+    /* Mask the constants below the starting point in the first inspected word. */
+    coe_productOfConstWord_t word = productOfConst[idxWord]
+                                    & (~(coe_productOfConstWord_t)0
+                                       << (idxConst%COE_NO_CONST_PER_WORD)
+                                      );
+    while(word == 0)
+    {
+        if(++idxWord >= noWords)
+            return UINT_MAX;
+        word = productOfConst[idxWord];
+    }
+    return idxWord*COE_NO_CONST_PER_WORD + (unsigned int)__builtin_ctzll(word);
+
+} /* End of coe_findConstInProductOfConst */
+
+
+
+
+/**
+ * Get the product of constants, which consists of a single constant.
+ *   @return
+ * Get the product of constants by value.
+ *   @param idxConst
+ * The index of the constant, i.e. the index of the bit, which represents the constant.
+ */
+
+static inline coe_productOfConst_t coe_getProductOfSingleConst(unsigned int idxConst)
+{
+    assert(idxConst < COE_MAX_NO_CONST);
+    coe_productOfConst_t productOfConst = COE_PRODUCT_OF_NO_CONST;
+    productOfConst.wordAry[idxConst/COE_NO_CONST_PER_WORD] =
+                    (coe_productOfConstWord_t)0x1 << (idxConst%COE_NO_CONST_PER_WORD);
+    return productOfConst;
+
+} /* End of coe_getProductOfSingleConst */
+
+
+
+
 /**
  * Return an uninitialized coefficient object. It has been allocated using the
  * global heap mem_hHeap_t coe_hHeapOfCoefAddend and needs to be freed after use with void
@@ -110,7 +333,10 @@ static inline coe_coefAddend_t *coe_coefAddendOne()
     coe_coefAddend_t *pOne = coe_newCoefAddend();
     pOne->pNext = NULL;
     pOne->factor = 1;
-    pOne->productOfConst = 0;
+    coe_copyProductOfConst( pOne->productOfConst
+                          , COE_PRODUCT_OF_NO_CONST.wordAry
+                          , coe_getNoWordsOfProduct()
+                          );
     return pOne;
 
 } /* End of coe_coefAddendOne */
@@ -165,6 +391,32 @@ static inline void coe_freeCoef(coe_coef_t *pCoef)
 
 
 
+/**
+ * Free a complete coefficient, whose last addend and number of addends are known. The
+ * operation takes constant time, while coe_freeCoef needs to iterate along the addends.
+ *   @param pCoef
+ * The pointer to the freed coefficient or the pointer to the head of the linked list of
+ * addends of those.
+ *   @param pTailAddend
+ * The last addend of the coefficient. Don't care if \a pCoef is the null coefficient.
+ *   @param noAddends
+ * The number of addends of the coefficient. Null if \a pCoef is the null coefficient.
+ */
+
+static inline void coe_freeCoefWithTail( coe_coef_t *pCoef
+                                       , coe_coefAddend_t *pTailAddend
+                                       , unsigned int noAddends
+                                       )
+{
+    if(!coe_isCoefAddendNull(pCoef))
+        mem_freeListWithTail(coe_hHeapOfCoefAddend, pCoef, pTailAddend, noAddends);
+    else
+        assert(noAddends == 0);
+
+} /* End of coe_freeCoefWithTail */
+
+
+
 /**
  * Compute the sum of a coefficient and a single addend (i.e. a product of constants and a
  * numeric factor). The operation is done in place.
@@ -176,34 +428,43 @@ static inline void coe_freeCoef(coe_coef_t *pCoef)
  * must not be null.
  *   @param productOfConsts
  * The new addend is passed as pair of primitive data types. Here the product of constants.
+ * Only the first coe_getNoWordsOfProduct() words are significant.
  */
 
 static inline void coe_addAddend( coe_coef_t ** const ppCoef
                                 , const coe_numericFactor_t factor
-                                , coe_productOfConst_t productOfConsts
+                                , const coe_productOfConst_t productOfConsts
                                 )
 {
     assert(factor != 0);
     
+    const unsigned int noWords = coe_getNoWordsOfProduct();
     coe_coefAddend_t *pAddend = *ppCoef
                    , **ppAddend = ppCoef;
 
     /* The addends of a coefficient are sorted. Look for the position where to combine with an
        existing addend or where to insert a new one. */
-    while(!coe_isCoefAddendNull(pAddend) &&  pAddend->productOfConst > productOfConsts)
+    signed int cmp = 0;
+    while(!coe_isCoefAddendNull(pAddend)
+          &&  (cmp = coe_compareProductOfConst( pAddend->productOfConst
+                                              , productOfConsts.wordAry
+                                              , noWords
+                                              )
+              ) > 0
+         )
     {
         ppAddend = &pAddend->pNext;
         pAddend = pAddend->pNext;
     }
 
-    if(coe_isCoefAddendNull(pAddend) ||  pAddend->productOfConst < productOfConsts)
+    if(coe_isCoefAddendNull(pAddend) ||  cmp < 0)
     {
         /* The coefficient doesn't contain an addend with identical combination of
            constants. We insert a new addend. */
         *ppAddend = coe_newCoefAddend();
         (*ppAddend)->pNext = pAddend;
         (*ppAddend)->factor = factor;
-        (*ppAddend)->productOfConst = productOfConsts;
+        coe_copyProductOfConst((*ppAddend)->productOfConst, productOfConsts.wordAry, noWords);
     }
     else
     {
@@ -222,6 +483,328 @@ static inline void coe_addAddend( coe_coef_t ** const ppCoef
 
 
 
+
+/**
+ * Combine a single addend with all addends of another, packed coefficient and keep only
+ * those products, which are relevant for the elementary step of the Gauss elimination.
+ * This is the inner loop of the solver. For products of constants of a single word, the
+ * kernel is vectorized if the CPU permits; see coe_filterProductsScalar for the
+ * specification of the function.
+ *   @return
+ * Get the number of relevant products.
+ *   @param prodOfConstResAry
+ * The products of constants of the relevant products, already divided by the first
+ * addend of the divisor.
+ *   @param factorResAry
+ * The numeric factors of the relevant products.
+ *   @param prodOfConst1
+ * The product of constants of the single addend.
+ *   @param factor1
+ * The numeric factor of the single addend.
+ *   @param prodOfConst2Ary
+ * The products of constants of the addends of the other coefficient.
+ *   @param factor2Ary
+ * The numeric factors of the addends of the other coefficient.
+ *   @param noAddends2
+ * The number of addends of the other coefficient.
+ *   @param prodOfConstDiv
+ * The product of constants of the first addend of the known divisor.
+ *   @param noWords
+ * The number of words of a product of constants.
+ */
+
+static inline unsigned int coe_filterProducts
+                                ( coe_productOfConstWord_t * const prodOfConstResAry
+                                , coe_numericFactor_t * const factorResAry
+                                , const coe_productOfConstWord_t * const prodOfConst1
+                                , coe_numericFactor_t factor1
+                                , const coe_productOfConstWord_t * const prodOfConst2Ary
+                                , const coe_numericFactor_t * const factor2Ary
+                                , unsigned int noAddends2
+                                , const coe_productOfConstWord_t * const prodOfConstDiv
+                                , unsigned int noWords
+                                )
+{
+    if(noWords == 1)
+    {
+        return coe_fctFilterProducts( prodOfConstResAry
+                                    , factorResAry
+                                    , prodOfConst1[0]
+                                    , factor1
+                                    , prodOfConst2Ary
+                                    , factor2Ary
+                                    , noAddends2
+                                    , prodOfConstDiv[0]
+                                    );
+    }
+    else
+    {
+        return coe_filterProductsMultiWord( prodOfConstResAry
+                                          , factorResAry
+                                          , prodOfConst1
+                                          , factor1
+                                          , prodOfConst2Ary
+                                          , factor2Ary
+                                          , noAddends2
+                                          , prodOfConstDiv
+                                          , noWords
+                                          );
+    }
+} /* End of coe_filterProducts */
+
+
+
+
+/**
+ * Compute the index of the hash table entry of an accumulator, where the search for a
+ * given product of constants begins. Fibonacci hashing is applied, which distributes the
+ * typical products of constants, i.e. bit patterns with a few set bits, well. The words of
+ * a product of more than one word are combined first.
+ *   @return
+ * Get the index into the hash table.
+ *   @param pAcc
+ * The accumulator.
+ *   @param productOfConst
+ * The key of the hash table entry.
+ */
+
+static inline unsigned int coe_getAccumulatorSlotIdx
+                                    ( const coe_accumulator_t * const pAcc
+                                    , const coe_productOfConstWord_t * const productOfConst
+                                    )
+{
+    unsigned long long hash = productOfConst[0];
+    unsigned int idxWord;
+    for(idxWord=1; idxWord<pAcc->noWordsOfProduct; ++idxWord)
+        hash = (hash * 0x9E3779B97F4A7C15ull) ^ productOfConst[idxWord];
+
+    return (unsigned int)((hash * 0x9E3779B97F4A7C15ull) >> (64 - pAcc->log2NoSlots));
+
+} /* End of coe_getAccumulatorSlotIdx */
+
+
+
+
+/**
+ * Get an entry of the hash table of an accumulator.
+ *   @return
+ * Get the pointer to the entry.
+ *   @param pAcc
+ * The accumulator.
+ *   @param idxSlot
+ * The index of the entry.
+ */
+
+static inline coe_accumulatorSlot_t *coe_getAccumulatorSlot
+                                                    ( const coe_accumulator_t * const pAcc
+                                                    , unsigned int idxSlot
+                                                    )
+{
+    return (coe_accumulatorSlot_t*)((char*)pAcc->slotAry
+                                    + (size_t)idxSlot*pAcc->sizeOfSlot
+                                   );
+} /* End of coe_getAccumulatorSlot */
+
+
+
+
+/**
+ * Reset an accumulator of addends for its next use. The operation has a constant cost
+ * regardless of the number of addends, which had been accumulated so far.\n
+ *   The accumulator is adapted to the number of words of a product of constants of the
+ * circuit under progress if this number has changed.
+ *   @param pAcc
+ * The accumulator.
+ */
+
+static inline void coe_resetAccumulator(coe_accumulator_t * const pAcc)
+{
+    if(pAcc->noWordsOfProduct != coe_getNoWordsOfProduct())
+        coe_setNoWordsOfAccumulator(pAcc, coe_getNoWordsOfProduct());
+
+    /* All entries of other cycles are considered empty. Only on wrap around of the cycle
+       counter the table needs to be actually cleared. */
+    if(++pAcc->cycle == 0)
+    {
+        unsigned int u;
+        for(u=0; u<(1u<<pAcc->log2NoSlots); ++u)
+            coe_getAccumulatorSlot(pAcc, u)->cycle = 0;
+        pAcc->cycle = 1;
+    }
+    pAcc->noSlotsInUse = 0;
+    pAcc->noHeapElements = 0;
+
+} /* End of coe_resetAccumulator */
+
+
+
+/**
+ * Add a single addend (i.e. a product of constants and a numeric factor) to an
+ * accumulator. The addend is combined with an already accumulated addend with identical
+ * product of constants. The operation has a constant cost, which doesn't depend on the
+ * number of accumulated addends (apart from the heap operation when a new product of
+ * constants is seen, which is in the order of the logarithm of this number).\n
+ *   The code is optimized for the most common case of a product of constants, which fits
+ * into a single word. Other products are handled by an external function.
+ *   @param pAcc
+ * The accumulator.
+ *   @param factor
+ * The new addend is passed as pair of primitive data types. Here the numeric factor, which
+ * must not be null.
+ *   @param productOfConst
+ * The new addend is passed as pair of primitive data types. Here the product of constants.
+ */
+
+static inline void coe_accumulateAddend
+                                    ( coe_accumulator_t * const pAcc
+                                    , const coe_numericFactor_t factor
+                                    , const coe_productOfConstWord_t * const productOfConst
+                                    )
+{
+    assert(factor != 0);
+    if(pAcc->noWordsOfProduct != 1)
+    {
+        coe_accumulateAddendMultiWord(pAcc, factor, productOfConst);
+        return;
+    }
+
+    /* Look for the entry of the hash table, using linear probing. The entries have a size
+       known at compile time. */
+    char * const slotAry = (char*)pAcc->slotAry;
+    const coe_productOfConstWord_t prodOfConst = productOfConst[0];
+    const unsigned int cycle = pAcc->cycle
+                     , mask = (1u<<pAcc->log2NoSlots) - 1;
+    unsigned int idxSlot = coe_getAccumulatorSlotIdx(pAcc, productOfConst);
+    coe_accumulatorSlot_t *pSlot;
+    while((pSlot = (coe_accumulatorSlot_t*)(slotAry + (size_t)idxSlot
+                                                      * COE_SIZE_OF_SLOT_OF_SINGLE_WORD
+                                           )
+          )->cycle == cycle
+         )
+    {
+        if(pSlot->productOfConst[0] == prodOfConst)
+        {
+            /* Combine with the existing addend. A null sum is kept as such; it's skipped
+               when fetching the addends. */
+            pSlot->factor += factor;
+            return;
+        }
+        idxSlot = (idxSlot+1) & mask;
+    }
+
+    /* Product of constants not found: Occupy the empty entry. */
+    pSlot->productOfConst[0] = prodOfConst;
+    pSlot->factor = factor;
+    pSlot->cycle = cycle;
+
+    /* Put the new product of constants into the heap. */
+    if(pAcc->noHeapElements >= pAcc->maxNoHeapElements)
+    {
+        pAcc->maxNoHeapElements *= 2;
+        pAcc->heapAry = srealloc( pAcc->heapAry
+                                , pAcc->maxNoHeapElements * sizeof(pAcc->heapAry[0])
+                                , __FILE__
+                                , __LINE__
+                                );
+    }
+    coe_productOfConstWord_t * const heapAry = pAcc->heapAry;
+    unsigned int idxHeap = pAcc->noHeapElements++;
+    while(idxHeap > 0)
+    {
+        const unsigned int idxParent = (idxHeap-1) / 2;
+        if(heapAry[idxParent] >= prodOfConst)
+            break;
+        heapAry[idxHeap] = heapAry[idxParent];
+        idxHeap = idxParent;
+    }
+    heapAry[idxHeap] = prodOfConst;
+
+    /* Keep the load factor of the hash table below one half. */
+    if(++pAcc->noSlotsInUse > mask/2)
+        coe_growAccumulator(pAcc);
+
+} /* End of coe_accumulateAddend */
+
+
+
+/**
+ * Fetch the accumulated addend with the greatest product of constants, where "greatest"
+ * refers to the binary value of the bit vector. The addend is removed from the
+ * accumulator. Addends, whose factors had summed up to null, are skipped.\n
+ *   The code is optimized for the most common case of a product of constants, which fits
+ * into a single word. Other products are handled by an external function.
+ *   @return
+ * \a true if an addend is returned, \a false if the accumulator doesn't contain any non
+ * null addend any more.
+ *   @param pAcc
+ * The accumulator.
+ *   @param productOfConst
+ * The product of constants of the fetched addend is returned in \a productOfConst. The
+ * array has room for a product of constants of the number of words of the accumulator.
+ *   @param pFactor
+ * The numeric factor of the fetched addend is returned in * \a pFactor.
+ *   @remark
+ * A fetched product of constants must not be accumulated again in the same cycle.
+ */
+
+static inline boolean coe_fetchMaxAddend( coe_accumulator_t * const pAcc
+                                        , coe_productOfConstWord_t * const productOfConst
+                                        , coe_numericFactor_t * const pFactor
+                                        )
+{
+    if(pAcc->noWordsOfProduct != 1)
+        return coe_fetchMaxAddendMultiWord(pAcc, productOfConst, pFactor);
+
+    const unsigned int mask = (1u<<pAcc->log2NoSlots) - 1;
+    const char * const slotAry = (const char*)pAcc->slotAry;
+    coe_productOfConstWord_t * const heapAry = pAcc->heapAry;
+    while(pAcc->noHeapElements > 0)
+    {
+        /* Take the root of the heap and restore the heap property. */
+        const coe_productOfConstWord_t prodOfConst = heapAry[0];
+        const unsigned int noHeapElements = --pAcc->noHeapElements;
+        const coe_productOfConstWord_t prodOfConstLast = heapAry[noHeapElements];
+        unsigned int idxHeap = 0, idxChild;
+        while((idxChild = 2*idxHeap+1) < noHeapElements)
+        {
+            if(idxChild+1 < noHeapElements  &&  heapAry[idxChild+1] > heapAry[idxChild])
+                ++ idxChild;
+            if(heapAry[idxChild] <= prodOfConstLast)
+                break;
+            heapAry[idxHeap] = heapAry[idxChild];
+            idxHeap = idxChild;
+        }
+        heapAry[idxHeap] = prodOfConstLast;
+
+        /* Look for the factor in the hash table. The entry is not removed from the table;
+           the constraint that the same product of constants is not accumulated again makes
+           this unnecessary. */
+        unsigned int idxSlot = coe_getAccumulatorSlotIdx(pAcc, &prodOfConst);
+        const coe_accumulatorSlot_t *pSlot;
+        while((pSlot = (const coe_accumulatorSlot_t*)
+                       (slotAry + (size_t)idxSlot*COE_SIZE_OF_SLOT_OF_SINGLE_WORD)
+              )->productOfConst[0] != prodOfConst
+              ||  pSlot->cycle != pAcc->cycle
+             )
+        {
+            assert(pSlot->cycle == pAcc->cycle);
+            idxSlot = (idxSlot+1) & mask;
+        }
+
+        if(pSlot->factor != 0)
+        {
+            productOfConst[0] = prodOfConst;
+            *pFactor = pSlot->factor;
+            return true;
+        }
+    } /* End while(Heap not empty but all fetched addends have been null) */
+
+    return false;
+
+} /* End of coe_fetchMaxAddend */
+
+
+
 /*
  * Global prototypes
  */
@@ -114,6 +114,8 @@
 /* Module interface
  *   frq_initModule
  *   frq_shutdownModule
+ *   frq_createExpressionCache
+ *   frq_deleteExpressionCache
  *   frq_createFreqDomainSolution
  *   frq_cloneByReference
  *   frq_cloneByConstReference
@@ -122,6 +124,7 @@
  *   frq_getNameOfDependent
  *   frq_logFreqDomainSolution
  *   frq_exportAsMCode
+ *   frq_exportAsBinaryData
  * Local functions
  *   newExpressionAddend
  *   expressionAddendNull
@@ -133,12 +136,15 @@
  *   normalizedExpressionOne
  *   isNormalizedExpressionNull
  *   freeNormalizedExpression
+ *   cloneNormalizedExpression
  *   freeConstString
+ *   selectNoConstants
  *   cmpExprAddendPower
  *   getNoAddendsOfSamePowerOfS
  *   estimateSignOfExpression
  *   isEqualExpressions
  *   isAbsEqualExpressions
+ *   hashAbsExpression
  *   mulByAddend
  *   mulByAddendAndCpy
  *   divByAddend
@@ -147,11 +153,17 @@
  *   transformAddend
  *   getNormalizationFactor
  *   createNormalizedExpression
+ *   cmpMagnitudeOfAddends
+ *   getLogOfNominalValues
+ *   approximateExpression
  *   transformExpression
+ *   getTransformedExpression
  *   getBlankTabString
- *   print
  *   printExpression
  *   printCoefInSAsMCode
+ *   printFactoredTermAsMCode
+ *   printFactoredSumAsMCode
+ *   printNamedSumsAsMCode
  *   isExpressionSimple
  *   printNamedExpression
  *   printNamedExpressionAsMCode
@@ -159,11 +171,20 @@
  *   moveExprIntoMap
  *   createExpressionMap
  *   deleteExpressionMap
+ *   newFactoredTermAry
+ *   copyFactoredTerm
+ *   hashFactoredTerms
+ *   moveTermsIntoSumTable
+ *   divideContent
+ *   appendFactoredTerms
+ *   factorSum
+ *   factorExpressionMap
  *   setExpressionNames
  *   determineOrderOfRendering
  *   setNameOfExpression
  *   getExpression
  *   printSolution
+ *   writeBinaryString
  */
 
 /*
@@ -173,7 +194,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include <stdarg.h>
+#include <math.h>
 #include <assert.h>
 
 #include "smalloc.h"
@@ -183,7 +204,9 @@
 #include "sol_solver.h"
 #include "crm_createMatrix.h"
 #include "frq_freqDomainSolution.h"
+#include "ost_outputStream.h"
 #include "msc_mScript.h"
+#include "prf_performanceReport.h"
 #include "frq_freqDomainSolution.inlineInterface.h"
 
 
@@ -191,6 +214,19 @@
  * Defines
  */
 
+/** The value of an unused slot of the hash table of an expression map. */
+#define RESULT_EXPR_EMPTY_SLOT  (UINT_MAX)
+
+/** The magic number at the beginning of a binary data file of a result. The characters
+    "LNCB" if read as bytes on a little endian machine. */
+#define BINARY_FILE_MAGIC       0x42434e4cu
+
+/** The version of the format of binary data files of results. */
+#define BINARY_FILE_VERSION     1u
+
+/** The index of the factored sum of a term, which is a mere product of constants. */
+#define FACTORED_SUM_NONE       (UINT_MAX)
+
 
 /*
  * Local type definitions
@@ -217,6 +253,82 @@ typedef struct resultExpressionOrigin_t
 } resultExpressionOrigin_t;
 
 
+/** A term of an expression in factored form. It is the product of a signed integer, of
+    the device constants to their individual, not negative powers and optionally of a sum
+    of further terms. A single term is also used to represent a monomial, which is a term
+    without sum. */
+typedef struct factoredTerm_t
+{
+    /** The signed integer factor of the term. */
+    rat_signed_int factor;
+
+    /** The powers of the device constants. The array has as many elements as the circuit
+        has constants. */
+    signed short *powerOfConstAry;
+
+    /** The sum, which the product of constants is multiplied with, as index into the table
+        of factored sums or #FACTORED_SUM_NONE if the term is a mere product. */
+    unsigned int idxSum;
+
+} factoredTerm_t;
+
+
+/** A sum of terms of an expression in factored form. The sums are shared: All occurrences
+    of the same sum in the expressions of a result refer to the same object. */
+typedef struct factoredSum_t
+{
+    /** The number of terms, at least two. */
+    unsigned int noTerms;
+
+    /** The terms of the sum. The array and the powers of constants of its terms are a
+        single malloc allocated block of memory, see newFactoredTermAry(). */
+    factoredTerm_t *termAry;
+
+    /** The hash code of the sum, see hashFactoredTerms(). */
+    unsigned int hash;
+
+    /** The number of distinct terms and coefficients of expressions, which refer to this
+        sum. */
+    unsigned int noReferences;
+
+    /** A sum, which is referenced more than once, is rendered as intermediate variable
+        S_n. This is the number n or null if the sum is rendered in place. */
+    unsigned int idxName;
+
+} factoredSum_t;
+
+
+/** The table of the shared sums of the factored expressions of a result. */
+typedef struct factoredSumTable_t
+{
+    /** The number of device constants of the circuit. */
+    unsigned int noConst;
+
+    /** The number of stored sums. */
+    unsigned int noSums;
+
+#ifdef DEBUG
+    /** The size of the table. */
+    unsigned int maxNoSums;
+#endif
+
+    /** The stored sums in the order of their creation. A sum refers only to sums of lower
+        index. */
+    factoredSum_t *sumAry;
+
+    /** The number of slots of the hash table \a idxSumByHashAry. A power of two. */
+    unsigned int noHashSlots;
+
+    /** A hash table with open addressing, which speeds up the search for shared sums. A
+        slot holds an index into \a sumAry or #RESULT_EXPR_EMPTY_SLOT. */
+    unsigned int *idxSumByHashAry;
+
+    /** The number of sums, which are rendered as intermediate variables. */
+    unsigned int noNames;
+
+} factoredSumTable_t;
+
+
 /** The result representation uses a map of (reusable) expressions, the solution is
     composed from. */
 typedef struct resultExpression_t
@@ -227,6 +339,14 @@ typedef struct resultExpression_t
     /** The expression as an ordinary, not normalized list of addends. */
     const frq_frqDomExpression_t *pExpr;
 
+    /** The sign-insensitive hash code of \a pExpr, see hashAbsExpression(). */
+    unsigned int hash;
+
+    /** The expression in factored form or NULL if the map has not been factored. An
+        array of terms, one for each non null coefficient of \a pExpr in falling powers of
+        s. */
+    factoredTerm_t *factoredCoefAry;
+
     /** Boolean flag, if the expression is used at least once as denominator. */
     boolean isUsedAsDenom;
 
@@ -256,6 +376,14 @@ typedef struct resultExpressionMap_t
     /** The map of (occasionally) reusable expressions is a simple linear array of those. */
     resultExpression_t *resExprAry;
 
+    /** The number of slots of the hash table \a idxResExprByHashAry. A power of two. */
+    unsigned int noHashSlots;
+
+    /** A hash table with open addressing, which speeds up the search for reusable
+        expressions. A slot holds an index into \a resExprAry or #RESULT_EXPR_EMPTY_SLOT.
+        The slot of an expression is found by its hash code, see hashAbsExpression(). */
+    unsigned int *idxResExprByHashAry;
+
     /** The \a noDependents times \a noIndependents terms of a solution have each a
         numerator and a denominator. Each of these is represented here as an index into \a
         pExprAry. Here the array for the numerators. */
@@ -266,6 +394,13 @@ typedef struct resultExpressionMap_t
         pExprAry. Here the array for the denominators. */
     unsigned int **idxDenomExprAry;
 
+    /** The stored expressions can have a factored form in addition, see
+        factorExpressionMap(). This flag indicates whether they have. */
+    boolean isFactored;
+
+    /** The shared sums of the factored expressions. Valid only if \a isFactored is set. */
+    factoredSumTable_t factoredSumTable;
+
     /** The index into the linear array of stored, reusable expressions can be tagged with
         a set MSB. This bit indicates that the stored expression is the negated, actual
         expression. */
@@ -274,6 +409,20 @@ typedef struct resultExpressionMap_t
 } resultExpressionMap_t;
 
 
+/** The magnitude of an addend of an expression, which is considered for the approximation
+    of the expression. */
+typedef struct magnitudeOfAddend_t
+{
+    /** The magnitude of the addend for the nominal values of the device constants,
+        relative to the dominant addend of the same power of s. */
+    double magnitude;
+
+    /** The index of the addend in the list of addends of the expression. */
+    unsigned int idxAddend;
+
+} magnitudeOfAddend_t;
+
+
 /*
  * Local prototypes
  */
@@ -294,27 +443,71 @@ CRM_DECLARE_CREATE_MATRIX( /* context */       string
                          , /* elementType_t */ const char *
                          )
 
+/** Prototype of a pair of functions to create and delete a matrix of Boolean flags. */
+CRM_DECLARE_CREATE_MATRIX( /* context */       boolean
+                         , /* elementType_t */ boolean
+                         )
+
+/** The sums of factored expressions are created recursively. */
+static unsigned int factorSum( factoredSumTable_t * const pTable
+                             , factoredTerm_t monomialAry[]
+                             , factoredTerm_t scratchAry[]
+                             , factoredTerm_t termStack[]
+                             , unsigned int noMonomials
+                             );
+
+/** The terms and the sums of factored expressions are printed mutually recursive. */
+static void printFactoredSumAsMCode( ost_outputStream_t * const stream
+                                   , const factoredSum_t * const pSum
+                                   , const factoredSumTable_t * const pSumTable
+                                   , const tbv_tableOfVariables_t * const pTableOfVars
+                                   , unsigned int * const pCol
+                                   , const unsigned int printMargin
+                                   , const char * const tabString
+                                   );
+
 
 /*
  * Data definitions
  */
 
 /** A global logger object is referenced from anywhere for writing progress messages. */
-static log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+
+/** The module wide accessible heap for addends of a frequency domain expression. It is
+    one out of \a _hHeapOfAddendsAry, which suits the number of constants of the circuit
+    under progress. */
+static THREAD_LOCAL mem_hHeap_t _hHeapOfAddends = MEM_HANDLE_INVALID_HEAP;
 
+/** The number of elements of the array of powers of constants of all addends, which are
+    allocated by \a _hHeapOfAddends. */
+static THREAD_LOCAL unsigned int _noPowersOfConstOfAddend = 0;
 
-/** The module wide accessible heap for addends of a frequency domain expression. */
-static mem_hHeap_t _hHeapOfAddends = MEM_HANDLE_INVALID_HEAP;
+/** The heaps of the module, one for each size class of addends. Element \a i is the heap
+    for addends with (i+1)*#FRQ_NO_CONST_PER_SIZE_CLASS powers of constants; it is created
+    on first use. */
+static THREAD_LOCAL mem_hHeap_t _hHeapOfAddendsAry[FRQ_NO_SIZE_CLASSES];
+
+/** The names of the heaps of the module. */
+static THREAD_LOCAL char _nameOfHeapAry[FRQ_NO_SIZE_CLASSES][56];
+
+/** The relative error bound of the approximation of the transformed expressions or null
+    if the expressions are not approximated. */
+static THREAD_LOCAL double _approximationErrorBound = 0.0;
 
 
 #ifdef DEBUG
 /** A global counter of all references to any created solution object. Used to detect
     memory leaks. */
-static unsigned int _noRefsToSolutionObjects = 0;
+static THREAD_LOCAL unsigned int _noRefsToSolutionObjects = 0;
 
 /** A global counter of all references to any created normalized expression object. Used to
     detect memory leaks. */
-static unsigned int _noRefsToExprObjects = 0;
+static THREAD_LOCAL unsigned int _noRefsToExprObjects = 0;
+
+/** A global counter of all created expression cache objects. Used to detect memory leaks. */
+static THREAD_LOCAL unsigned int _noRefsToCacheObjects = 0;
 #endif
 
 
@@ -369,7 +562,10 @@ static inline frq_frqDomExpressionAddend_t *expressionAddendOne()
     frq_frqDomExpressionAddend_t *pOne = newExpressionAddend();
     pOne->pNext = NULL;
     pOne->factor = RAT_ONE;
-    memset(pOne->powerOfConstAry, /* value */ 0, /* num */ sizeof(pOne->powerOfConstAry));
+    memset( pOne->powerOfConstAry
+          , /* value */ 0
+          , /* num */ _noPowersOfConstOfAddend*sizeof(pOne->powerOfConstAry[0])
+          );
     pOne->powerOfS = 0;
     return pOne;
 
@@ -460,6 +656,7 @@ static inline frq_normalizedFrqDomExpression_t *normalizedExpressionOne()
                                                , __FILE__
                                                , __LINE__
                                                );
+    pNewObj->noReferencesToThis = 1;
     pNewObj->pFactor = expressionAddendOne();
     pNewObj->pExpr   = expressionAddendOne();
 
@@ -491,7 +688,9 @@ static inline boolean isNormalizedExpressionNull
 /**
  * Free a complete, normalized frequency domain expression, which has a factor addend and
  * the remaining expression, which is a linked list of addends that had all been allocated
- * with frq_frqDomExpressionAddend_t *newExpressionAddend().
+ * with frq_frqDomExpressionAddend_t *newExpressionAddend(). If the expression is shared
+ * then only the reference to it is discarded; the object is freed with the last
+ * reference.
  *   @param pExpression
  * The pointer to the freed normalized expression.
  */
@@ -501,13 +700,21 @@ static inline void freeNormalizedExpression
 {
     if(!isNormalizedExpressionNull(pExpression))
     {
-        assert(!isExpressionAddendNull(pExpression->pFactor)
-               &&  !isExpressionAddendNull(pExpression->pExpr)
-              );
-        mem_free(_hHeapOfAddends, (void*)pExpression->pFactor);
-        mem_freeList(_hHeapOfAddends, (void*)pExpression->pExpr);
+        /* The reference counter is the only element of the immutable object, which is
+           modified. */
+        frq_normalizedFrqDomExpression_t * const pObj =
+                                            (frq_normalizedFrqDomExpression_t*)pExpression;
+        assert(pObj->noReferencesToThis >= 1);
+        if(--pObj->noReferencesToThis == 0)
+        {
+            assert(!isExpressionAddendNull(pObj->pFactor)
+                   &&  !isExpressionAddendNull(pObj->pExpr)
+                  );
+            mem_free(_hHeapOfAddends, (void*)pObj->pFactor);
+            mem_freeList(_hHeapOfAddends, (void*)pObj->pExpr);
 
-        free((frq_normalizedFrqDomExpression_t*)pExpression);
+            free(pObj);
+        }
 
 #ifdef DEBUG
         -- _noRefsToExprObjects;
@@ -518,6 +725,35 @@ static inline void freeNormalizedExpression
 
 
 
+/**
+ * Get another reference to an existing normalized frequency domain expression.
+ *   @return
+ * Get a copy of the passed pointer. The new reference needs to be freed with \a
+ * freeNormalizedExpression after use.
+ *   @param pExpression
+ * The pointer to the shared expression. May be the null expression.
+ */
+
+static inline frq_normalizedFrqDomExpression_t *cloneNormalizedExpression
+                                    (frq_normalizedFrqDomExpression_t * const pExpression)
+{
+    if(!isNormalizedExpressionNull(pExpression))
+    {
+        assert(pExpression->noReferencesToThis >= 1);
+        ++ pExpression->noReferencesToThis;
+
+#ifdef DEBUG
+        ++ _noRefsToExprObjects;
+#endif
+    }
+
+    return pExpression;
+
+} /* End of cloneNormalizedExpression */
+
+
+
+
 /**
  * Free a string as generated by e.g. stralloccpy. Actually a free of the stdlib but the
  * function argument permits to pass a const char* without a compiler warning complaining
@@ -537,6 +773,66 @@ static inline void freeConstString(const char * const string)
  * Function implementation
  */
 
+/**
+ * Choose the size of the addends of frequency domain expressions for the next circuit. The
+ * addends get the least array of powers of constants, which can hold all constants of the
+ * circuit. The heap of addends of the module is exchanged accordingly.
+ *   @param noConstants
+ * The number of constants of the circuit, 0..#COE_MAX_NO_CONST.
+ *   @remark
+ * The function must be called only while there are no addend objects. Addends of the
+ * previous circuit can't be used or freed any more after the size has changed.
+ */
+
+static void selectNoConstants(unsigned int noConstants)
+{
+    assert(noConstants <= COE_MAX_NO_CONST);
+    unsigned int idxSizeClass = noConstants / FRQ_NO_CONST_PER_SIZE_CLASS;
+    if(idxSizeClass > 0  &&  noConstants % FRQ_NO_CONST_PER_SIZE_CLASS == 0)
+        -- idxSizeClass;
+    assert(idxSizeClass < FRQ_NO_SIZE_CLASSES);
+
+    mem_hHeap_t * const phHeap = &_hHeapOfAddendsAry[idxSizeClass];
+    if(*phHeap != MEM_HANDLE_INVALID_HEAP  &&  *phHeap == _hHeapOfAddends)
+        return;
+
+#ifdef DEBUG
+    /* All addends are owned by solution objects. Exchanging the heap while addends of the
+       previous circuit are still in use would corrupt the heaps. */
+    assert(_noRefsToSolutionObjects == 0  &&  _noRefsToExprObjects == 0);
+#endif
+
+    const unsigned int noPowersOfConst = (idxSizeClass+1) * FRQ_NO_CONST_PER_SIZE_CLASS;
+    if(*phHeap == MEM_HANDLE_INVALID_HEAP)
+    {
+        char * const name = _nameOfHeapAry[idxSizeClass];
+        snprintf( name
+                , sizeof(_nameOfHeapAry[0])
+                , "Addend of frequency domain expression, %u constants"
+                , noPowersOfConst
+                );
+        *phHeap = mem_createHeap( _log
+                                , name
+                                , sizeof(frq_frqDomExpressionAddend_t)
+                                  + noPowersOfConst*sizeof(signed short)
+                                , /* initialHeapSize */     100
+                                , /* allocationBlockSize */ 500
+                                );
+    }
+
+    LOG_DEBUG( _log
+             , "The addends of frequency domain expressions hold the powers of up to %u"
+               " constants"
+             , noPowersOfConst
+             )
+    _hHeapOfAddends = *phHeap;
+    _noPowersOfConstOfAddend = noPowersOfConst;
+
+} /* End of selectNoConstants */
+
+
+
+
 
 /** Generate code for a pair of functions to create and delete a matrix of array indexes. */
 CRM_CREATE_MATRIX( /* context */             unsignedInt
@@ -560,6 +856,13 @@ CRM_CREATE_MATRIX( /* context */             string
                  , /* fctFreeElement */      freeConstString
                  )
 
+/** Generate code for a pair of functions to create and delete a matrix of Boolean flags. */
+CRM_CREATE_MATRIX( /* context */             boolean
+                 , /* elementType_t */       boolean
+                 , /* initialElementValue */ false
+                 , /* fctFreeElement */      void
+                 )
+
 /**
  * The terms in an expression are sorted to simplify list operations like inserting terms
  * and to unify the look of the terms in the user output. This method is the basis of
@@ -600,9 +903,15 @@ static signed int cmpExprAddendPower( const frq_frqDomExpressionAddend_t * const
         else
             res = 0;
 
-        signed int idxConst = (signed int)noConst;
-        while(res == 0  &&  --idxConst >= 0)
+        /* The index is unsigned and tested before decrementing it. A signed index, which
+           is compared against zero after the decrement, is rewritten by the compiler under
+           the assumption that signed overflow doesn't occur. */
+        unsigned int idxConst = noConst;
+        while(res == 0  &&  idxConst > 0)
+        {
+            -- idxConst;
             res = pOp1->powerOfConstAry[idxConst] - pOp2->powerOfConstAry[idxConst];
+        }
 
         return res;
     }
@@ -817,6 +1126,54 @@ static boolean isAbsEqualExpressions( boolean * const pHaveSameSign
 
 
 
+
+/**
+ * Compute a hash code of a frequency domain expression, which is consistent with
+ * isAbsEqualExpressions: Two expressions, which are identical or which differ only in the
+ * sign, get the same hash code. The operand expression is a list of addends, not a
+ * normalized expression object.\n
+ *   The numeric factors of the addends are not canonically represented and only their
+ * signs relative to the heading addend go into the hash code. The structure, i.e. the
+ * powers of all addends, is considered completely.
+ *   @return
+ * Get the hash code.
+ *   @param pExpr
+ * The expression or the pointer to its heading addend.
+ *   @param noConst
+ * The total number of device constants, which are in use in the given system.
+ */
+
+static unsigned int hashAbsExpression( const frq_frqDomExpression_t *pExpr
+                                     , const unsigned int noConst
+                                     )
+{
+    /* FNV-1a over all powers and relative signs. */
+    unsigned int hash = 2166136261u;
+    if(isExpressionAddendNull(pExpr))
+        return hash;
+
+    const signed int signOfHead = (signed int)rat_sign(pExpr->factor);
+    while(!isExpressionAddendNull(pExpr))
+    {
+        const boolean isNegatedRelToHead = (signed int)rat_sign(pExpr->factor) != signOfHead;
+        hash = (hash ^ (isNegatedRelToHead? 1u: 0u)) * 16777619u;
+        hash = (hash ^ (unsigned int)pExpr->powerOfS) * 16777619u;
+        unsigned int idxConst;
+        for(idxConst=0; idxConst<noConst; ++idxConst)
+        {
+            hash = (hash ^ (unsigned int)(signed int)pExpr->powerOfConstAry[idxConst])
+                   * 16777619u;
+        }
+
+        pExpr = pExpr->pNext;
+    }
+
+    return hash;
+
+} /* End of hashAbsExpression */
+
+
+
 #if 0 // Double-check if this should be kept; is currently not used
 /**
  * Multiply a frequency domain expression by a constant addend. The operand is a list of
@@ -849,7 +1206,10 @@ static void mulByAddend( frq_frqDomExpression_t * const pExpression
 
         unsigned int idxConst;
         for(idxConst=0; idxConst<noConst; ++idxConst)
+        {
             pAddend->powerOfConstAry[idxConst] += pFactor->powerOfConstAry[idxConst];
+            assert(abs(pAddend->powerOfConstAry[idxConst]) < SHRT_MAX);
+        }
 
         pAddend = pAddend->pNext;
 
@@ -901,6 +1261,7 @@ static frq_frqDomExpression_t *mulByAddendAndCpy
         {
             pAddendCpy->powerOfConstAry[idxConst] = pAddend->powerOfConstAry[idxConst]
                                                     + pFactor->powerOfConstAry[idxConst];
+            assert(abs(pAddendCpy->powerOfConstAry[idxConst]) < SHRT_MAX);
         }
 
         /* pAddendCpy->pNext is not written here but via ppNext in the next loop cycle. */
@@ -962,7 +1323,10 @@ static frq_frqDomExpression_t *divByAddend( frq_frqDomExpression_t * const pExpr
 
         unsigned int idxConst;
         for(idxConst=0; idxConst<noConst; ++idxConst)
+        {
             pAddend->powerOfConstAry[idxConst] -= pDivisor->powerOfConstAry[idxConst];
+            assert(abs(pAddend->powerOfConstAry[idxConst]) < SHRT_MAX);
+        }
 
         pAddend = pAddend->pNext;
 
@@ -1213,26 +1577,19 @@ static boolean transformAddend( frq_frqDomExpressionAddend_t ** const ppFrqDomEx
 
     /* The addend is a product of a numeric factor and a set of device constants. The
        factor remains unchanged and all devices are transformed in a loop. */
-    assert(pAlgebraicAddend->factor == 1  ||  pAlgebraicAddend->factor == -1);
-    pNewAddend->factor.n = pAlgebraicAddend->factor;
+    assert(pAlgebraicAddend->factor != 0);
+    pNewAddend->factor.n = (rat_signed_int)pAlgebraicAddend->factor;
     pNewAddend->factor.d = 1;
 
-    const coe_productOfConst_t productOfDevConst = pAlgebraicAddend->productOfConst;
-    coe_productOfConst_t maskDev = 0x1;
-    unsigned int idxBit = 0;
+    const coe_productOfConstWord_t * const productOfDevConst =
+                                                        pAlgebraicAddend->productOfConst;
+    const unsigned int noWords = coe_getNoWordsOfProduct();
 
-    /* The loop termination depends on the definition of the type coe_productOfConst_t as
-       an unsigned integer. The last term ensures that the loop ends if the left most
-       device bit is in use. */
-    while(success &&  productOfDevConst >= maskDev  &&  maskDev != 0)
+    /* Look for the first device in the product. The loop ends if no further constant is
+       found in any of the words of the product. */
+    unsigned int idxBit = coe_findConstInProductOfConst(productOfDevConst, 0, noWords);
+    while(success &&  idxBit != UINT_MAX)
     {
-        /* Look for the next device in the product. */
-        while((productOfDevConst & maskDev) == 0)
-        {
-            maskDev <<= 1;
-            ++ idxBit;
-        }
-
         /* We access the device description of the device under progress. */
         rat_num_t refFactor;
         unsigned int idxBitRefDev;
@@ -1287,11 +1644,10 @@ static boolean transformAddend( frq_frqDomExpressionAddend_t ** const ppFrqDomEx
         else
             success = false;
 
-        /* Test next bit/device. */
-        maskDev <<= 1;
-        ++ idxBit;
+        /* Look for the next device in the product. */
+        idxBit = coe_findConstInProductOfConst(productOfDevConst, idxBit+1, noWords);
 
-    } /* End while(Test of all possible device bits) */
+    } /* End while(All devices of the product) */
 
     if(success)
         *ppFrqDomExpressionAddend = pNewAddend;
@@ -1339,10 +1695,10 @@ static void getNormalizationFactor( frq_frqDomExpressionAddend_t ** const ppNorm
     frq_frqDomExpressionAddend_t *pNormAddend = newExpressionAddend();
     pNormAddend->pNext = expressionAddendNull();
     pNormAddend->powerOfS = INT_MAX;
-    assert(noConst <= COE_MAX_NO_CONST);
+    assert(noConst <= _noPowersOfConstOfAddend);
     unsigned int idxConst;
     for(idxConst=0; idxConst<noConst; ++idxConst)
-        pNormAddend->powerOfConstAry[idxConst] = INT_MAX;
+        pNormAddend->powerOfConstAry[idxConst] = SHRT_MAX;
     rat_signed_int lcmOfD = 1
                  , gcdOfN = pAddend->factor.n;
 
@@ -1395,14 +1751,11 @@ static frq_normalizedFrqDomExpression_t *createNormalizedExpression
                                                 , const unsigned int noConst
                                                 )
 {
-    frq_normalizedFrqDomExpression_t *pNewObj =
-                                            smalloc( sizeof(frq_normalizedFrqDomExpression_t)
-                                                   , __FILE__
-                                                   , __LINE__
-                                                   );
+    frq_normalizedFrqDomExpression_t *pNewObj;
     if(!isExpressionAddendNull(pExpression))
     {
         pNewObj = smalloc(sizeof(frq_normalizedFrqDomExpression_t), __FILE__, __LINE__);
+        pNewObj->noReferencesToThis = 1;
 
         /* Find the common elements in the addends of the expression. */
         getNormalizationFactor(&pNewObj->pFactor, pExpression, noConst);
@@ -1426,6 +1779,222 @@ static frq_normalizedFrqDomExpression_t *createNormalizedExpression
 
 
 
+/**
+ * Compare two addends by magnitude. This is the comparison function for sorting the
+ * addends of an expression in rising order of their magnitude.
+ *   @return
+ * The result is greater than null if op1 is greater than op2, null if they are equal and
+ * less than null otherwise. Equal magnitudes are ordered by the position of the addends in
+ * the expression so that the sort order is fully defined.
+ *   @param pOp1
+ * First operand of comparison, an object of type magnitudeOfAddend_t.
+ *   @param pOp2
+ * Second operand of comparison, an object of type magnitudeOfAddend_t.
+ */
+
+static signed int cmpMagnitudeOfAddends(const void *pOp1, const void *pOp2)
+{
+    const magnitudeOfAddend_t * const pMag1 = (const magnitudeOfAddend_t*)pOp1
+                            , * const pMag2 = (const magnitudeOfAddend_t*)pOp2;
+    if(pMag1->magnitude < pMag2->magnitude)
+        return -1;
+    else if(pMag1->magnitude > pMag2->magnitude)
+        return 1;
+    else
+        return (signed int)pMag2->idxAddend - (signed int)pMag1->idxAddend;
+
+} /* End of cmpMagnitudeOfAddends */
+
+
+
+
+/**
+ * Get the natural logarithm of the magnitude of the nominal values of all device constants
+ * of a circuit.
+ *   @param logOfValueAry
+ * The logarithms are placed into this array, element \a i for constant \a i, which is
+ * referenced as \a powerOfConstAry[i] in the addends of the frequency domain expressions.
+ * Devices, which are related to another device, have been substituted by the referenced
+ * device in the expressions. Their power is always null and they get the value null.
+ *   @param pTableOfVars
+ * The table of variables, which relates the constants to the devices of the circuit.
+ */
+
+static void getLogOfNominalValues( double logOfValueAry[]
+                                 , const tbv_tableOfVariables_t * const pTableOfVars
+                                 )
+{
+    unsigned int idxConst;
+    for(idxConst=0; idxConst<pTableOfVars->noConstants; ++idxConst)
+    {
+        const unsigned int idxDev = pTableOfVars->constantIdxToDevIdxAry[idxConst];
+        assert(idxDev < pTableOfVars->pCircuitNetList->noDevices);
+        const pci_device_t * const pDev = pTableOfVars->pCircuitNetList->pDeviceAry[idxDev];
+        if(pDev->devRelation.idxDeviceRef == PCI_NULL_DEVICE)
+        {
+            boolean isDefaultValue;
+            const double value = tbv_getValueOfDevice(pDev, &isDefaultValue);
+            logOfValueAry[idxConst] = log(fabs(value));
+        }
+        else
+            logOfValueAry[idxConst] = 0.0;
+    }
+} /* End of getLogOfNominalValues */
+
+
+
+
+/**
+ * Approximate an expression by dropping numerically insignificant addends. All addends
+ * with the same power of s form the coefficient of this power. The addends of a
+ * coefficient are evaluated for the nominal values of the device constants. The smallest
+ * of them are dropped as long as the sum of the magnitudes of all dropped addends doesn't
+ * exceed a given fraction of the sum of the magnitudes of all addends of the coefficient.
+ * The dominant addend of a coefficient is never dropped; an expression doesn't become
+ * null.
+ *   @return
+ * Get the number of dropped addends.
+ *   @param ppExpression
+ * The pointer to the expression, which is approximated in place. The dropped addends are
+ * freed.
+ *   @param logOfValueAry
+ * The natural logarithm of the magnitude of the nominal value of all constants, see
+ * getLogOfNominalValues().
+ *   @param noConst
+ * The total number of device constants, which are in use in the given system.
+ *   @param errorBound
+ * The relative error bound of each coefficient in the range ]0, 1[.
+ */
+
+static unsigned int approximateExpression( frq_frqDomExpression_t * * const ppExpression
+                                         , const double logOfValueAry[]
+                                         , const unsigned int noConst
+                                         , double errorBound
+                                         )
+{
+    assert(errorBound > 0.0  &&  errorBound < 1.0);
+
+    unsigned int noAddends = 0;
+    const frq_frqDomExpressionAddend_t *pAddend = *ppExpression;
+    while(!isExpressionAddendNull(pAddend))
+    {
+        ++ noAddends;
+        pAddend = pAddend->pNext;
+    }
+    if(noAddends <= 1)
+        return 0;
+
+    magnitudeOfAddend_t * const magnitudeAry = smalloc( sizeof(magnitudeOfAddend_t)
+                                                        * noAddends
+                                                      , __FILE__
+                                                      , __LINE__
+                                                      );
+    boolean * const isDroppedAry = smalloc(sizeof(boolean)*noAddends, __FILE__, __LINE__);
+    unsigned int noDroppedAddends = 0;
+
+    /* Loop over all coefficients. The addends are sorted in falling power of s, the
+       addends of a coefficient form a contiguous sub-sequence. */
+    unsigned int idxFirstAddend = 0;
+    pAddend = *ppExpression;
+    while(!isExpressionAddendNull(pAddend))
+    {
+        /* Compute the logarithm of the magnitude of all addends of the coefficient. The
+           logarithm avoids the overflow or underflow of products of many constants. */
+        magnitudeOfAddend_t * const magnitudeOfCoefAry = &magnitudeAry[idxFirstAddend];
+        const signed int powerOfS = pAddend->powerOfS;
+        unsigned int noAddendsOfCoef = 0;
+        double maxLogOfMagnitude = -HUGE_VAL;
+        do
+        {
+            double logOfMagnitude = log(fabs((double)pAddend->factor.n
+                                             / (double)pAddend->factor.d
+                                            )
+                                       );
+            unsigned int idxConst;
+            for(idxConst=0; idxConst<noConst; ++idxConst)
+            {
+                if(pAddend->powerOfConstAry[idxConst] != 0)
+                {
+                    logOfMagnitude += pAddend->powerOfConstAry[idxConst]
+                                      * logOfValueAry[idxConst];
+                }
+            }
+            if(logOfMagnitude > maxLogOfMagnitude)
+                maxLogOfMagnitude = logOfMagnitude;
+
+            const unsigned int idxAddend = idxFirstAddend + noAddendsOfCoef;
+            magnitudeOfCoefAry[noAddendsOfCoef].magnitude = logOfMagnitude;
+            magnitudeOfCoefAry[noAddendsOfCoef].idxAddend = idxAddend;
+            isDroppedAry[idxAddend] = false;
+            ++ noAddendsOfCoef;
+            pAddend = pAddend->pNext;
+        }
+        while(!isExpressionAddendNull(pAddend) &&  pAddend->powerOfS == powerOfS);
+
+        /* The magnitudes are taken relative to the dominant addend. A coefficient is left
+           as it is if the magnitudes can't be compared, e.g. because a device has the
+           value null. */
+        double sumOfMagnitudes = 0.0;
+        unsigned int u;
+        for(u=0; u<noAddendsOfCoef; ++u)
+        {
+            magnitudeOfCoefAry[u].magnitude = exp(magnitudeOfCoefAry[u].magnitude
+                                                  - maxLogOfMagnitude
+                                                 );
+            sumOfMagnitudes += magnitudeOfCoefAry[u].magnitude;
+        }
+        if(noAddendsOfCoef > 1  &&  isfinite(sumOfMagnitudes))
+        {
+            /* Drop the smallest addends until the error bound is reached. */
+            qsort( magnitudeOfCoefAry
+                 , noAddendsOfCoef
+                 , sizeof(magnitudeOfAddend_t)
+                 , cmpMagnitudeOfAddends
+                 );
+            const double maxError = errorBound * sumOfMagnitudes;
+            double error = 0.0;
+            for(u=0; u<noAddendsOfCoef; ++u)
+            {
+                error += magnitudeOfCoefAry[u].magnitude;
+                if(error > maxError)
+                    break;
+
+                isDroppedAry[magnitudeOfCoefAry[u].idxAddend] = true;
+                ++ noDroppedAddends;
+            }
+        }
+
+        idxFirstAddend += noAddendsOfCoef;
+
+    } /* End while(All coefficients of the expression) */
+
+    /* Unlink and free the dropped addends. The order of the remaining addends is not
+       affected. */
+    frq_frqDomExpressionAddend_t * *ppLink = ppExpression;
+    unsigned int idxAddend = 0;
+    while(!isExpressionAddendNull(*ppLink))
+    {
+        frq_frqDomExpressionAddend_t * const pCurAddend = *ppLink;
+        if(isDroppedAry[idxAddend++])
+        {
+            *ppLink = pCurAddend->pNext;
+            freeExpressionAddend(pCurAddend);
+        }
+        else
+            ppLink = &pCurAddend->pNext;
+    }
+    assert(idxAddend == noAddends  &&  !isExpressionAddendNull(*ppExpression));
+
+    free(isDroppedAry);
+    free(magnitudeAry);
+
+    return noDroppedAddends;
+
+} /* End of approximateExpression */
+
+
+
+
 /**
  * Transform an algebraic expression into an expression in the frequency domain. The
  * algebraic expressions are elements got from the symbolic solver of the LES and the
@@ -1475,6 +2044,24 @@ static boolean transformExpression
 
     } /* End while(All addends of the expressions) */
 
+    /* In approximation mode the numerically insignificant addends are dropped before
+       normalization; the common factor is taken from the remaining addends. */
+    if(success  &&  _approximationErrorBound > 0.0)
+    {
+        double logOfValueAry[noConst > 0? noConst: 1];
+        getLogOfNominalValues(logOfValueAry, pTableOfVars);
+        const unsigned int noDroppedAddends =
+                                approximateExpression( &pNewFreqDomainExpr
+                                                     , logOfValueAry
+                                                     , noConst
+                                                     , _approximationErrorBound
+                                                     );
+        LOG_DEBUG( _log
+                 , "Approximation of expression: %u addends have been dropped"
+                 , noDroppedAddends
+                 )
+    }
+
     *ppFrqDomExpression = createNormalizedExpression( pNewFreqDomainExpr
                                                     , noConst
                                                     );
@@ -1485,80 +2072,121 @@ static boolean transformExpression
 
 
 
-
 /**
- * Generate a blank tabulator string of given length. Consider a previously existing
- * tabualtor string in case of recusively deepend indentation.
- *   @param extendedTabString
- * Result of operation: the new combined tabulator string.
- *   @param sizeOfExtendedTabString
- * Size of result char array. No warning if it doesn't fit: The generated tabulator string
- * will silently be truncated.
- *   @param existingTabString
- * A possibly existing tabulator string. It'll prepend the new, blank part of the tabulator
- * string.
- *   @param additionalIndentation
- * Number of blanks in the new, blank part of the generated tabulator string.
+ * Get the frequency domain expression of a numerator of an algebraic solution or of its
+ * determinant. The expression is taken from the cache if it has been transformed before.
+ * Otherwise it is transformed and, on success, put into the cache.
+ *   @return
+ * \a true if the transformation could be done, \a false otherwise. An error report has
+ * been written to the global application log if \a false should be returned.
+ *   @param ppFrqDomExpression
+ * The pointer to the transformed expression is returned in * \a ppFrqDomExpression. It
+ * needs to be freed with \a freeNormalizedExpression after use. An invalid, half-way
+ * completed expression is returned in case of errors.
+ *   @param pCache
+ * The cache of expressions of the algebraic solution or NULL if no caching is desired.
+ *   @param pAlgebraicSolution
+ * The algebraic solution.
+ *   @param idxDependent
+ * The index of the dependent of the requested numerator in \a pAlgebraicSolution or -1
+ * to request the system determinant.
+ *   @param idxIndependent
+ * The index of the independent of the requested numerator. Ignored if \a idxDependent is
+ * -1.
  */
 
-static void getBlankTabString( char * const extendedTabString
-                             , unsigned int sizeOfExtendedTabString
-                             , const char * const existingTabString
-                             , unsigned int additionalIndentation
-                             )
+static boolean getTransformedExpression
+                        ( frq_normalizedFrqDomExpression_t * * const ppFrqDomExpression
+                        , frq_expressionCache_t * const pCache
+                        , const sol_solution_t * const pAlgebraicSolution
+                        , signed int idxDependent
+                        , unsigned int idxIndependent
+                        )
 {
-    snprintf( extendedTabString
-            , sizeOfExtendedTabString
-            , "%s%*s"
-            , existingTabString
-            , additionalIndentation
-            , ""
-            );
-} /* End of getBlankTabString */
+    assert(pCache == NULL  ||  pCache->pAlgebraicSolution == pAlgebraicSolution);
 
+    frq_normalizedFrqDomExpression_t * *ppCachedExpr = NULL;
+    boolean *pIsCached = NULL;
+    const coe_coef_t *pAlgebraicExpr;
+    if(idxDependent < 0)
+    {
+        pAlgebraicExpr = pAlgebraicSolution->pDeterminant;
+        if(pCache != NULL)
+        {
+            ppCachedExpr = &pCache->pDenominator;
+            pIsCached = &pCache->isDenominatorAvailable;
+        }
+    }
+    else
+    {
+        assert((unsigned)idxDependent < sol_getNoDependents(pAlgebraicSolution)
+               &&  idxIndependent < sol_getNoIndependents(pAlgebraicSolution)
+               &&  pAlgebraicSolution->pIsDependentAvailableAry[idxDependent]
+              );
+        pAlgebraicExpr = pAlgebraicSolution->numeratorAry[idxDependent][idxIndependent];
+        if(pCache != NULL)
+        {
+            ppCachedExpr = &pCache->numeratorAry[idxDependent][idxIndependent];
+            pIsCached = &pCache->isNumeratorAvailableAry[idxDependent][idxIndependent];
+        }
+    }
 
+    if(pIsCached != NULL  &&  *pIsCached)
+    {
+        *ppFrqDomExpression = cloneNormalizedExpression(*ppCachedExpr);
+        return true;
+    }
 
+    boolean success = transformExpression( ppFrqDomExpression
+                                         , pAlgebraicExpr
+                                         , pAlgebraicSolution->pTableOfVars
+                                         );
 
-/**
- * Print formatted to a stream. A wrapper around stdio's printf, which suppresses the
- * stream error messages.
- *   @return
- * The number of printed characters as an unsigned number. If the output yields a stream
- * error message the function returns null.
- *   @param stream
- * The output stream to write to.
- *   @param formatString
- * A printf like format string.
- *   @param ...
- * The arguments of the format string.
- */
+    /* Only a valid expression must be reused. An arithmetic error is recognized only
+       later by the caller, the global error flag is not reset here. */
+    if(success  &&  pIsCached != NULL  &&  !rat_getError())
+    {
+        *ppCachedExpr = cloneNormalizedExpression(*ppFrqDomExpression);
+        *pIsCached = true;
+    }
 
-static unsigned int print(FILE *stream, const char * const formatString, ...)
-{
-    va_list argptr;
+    return success;
 
-    va_start(argptr, formatString);
-    signed int noChars = vfprintf(stream, formatString, argptr);
-    va_end(argptr);
+} /* End of getTransformedExpression */
 
-    /* Count the printed characters. Make the distinction between true numbers and
-       (negative) error information. */
-    unsigned int retVal;
-    if(noChars >= 0)
-        retVal = noChars;
-    else
-    {
-        /* It might seem that now writing an error message into the application log would
-           be an option, but it isn't. This function is only used on the streams of the
-           application logger. If we get an error, we can't log the problem into the
-           identical erroneous stream. The probablity of an error is close to null and the
-           problem will be apparent by getting no ouput. No action is taken. */
-        retVal = 0;
-    }
 
-    return retVal;
 
-} /* End of print */
+
+
+/**
+ * Generate a blank tabulator string of given length. Consider a previously existing
+ * tabualtor string in case of recusively deepend indentation.
+ *   @param extendedTabString
+ * Result of operation: the new combined tabulator string.
+ *   @param sizeOfExtendedTabString
+ * Size of result char array. No warning if it doesn't fit: The generated tabulator string
+ * will silently be truncated.
+ *   @param existingTabString
+ * A possibly existing tabulator string. It'll prepend the new, blank part of the tabulator
+ * string.
+ *   @param additionalIndentation
+ * Number of blanks in the new, blank part of the generated tabulator string.
+ */
+
+static void getBlankTabString( char * const extendedTabString
+                             , unsigned int sizeOfExtendedTabString
+                             , const char * const existingTabString
+                             , unsigned int additionalIndentation
+                             )
+{
+    snprintf( extendedTabString
+            , sizeOfExtendedTabString
+            , "%s%*s"
+            , existingTabString
+            , additionalIndentation
+            , ""
+            );
+} /* End of getBlankTabString */
 
 
 
@@ -1567,7 +2195,7 @@ static unsigned int print(FILE *stream, const char * const formatString, ...)
  * Print a frequency domain expression. The printed output is not terminated by a final
  * newline. The operand is a list of addends, not a normalized expression object.
  *   @param stream
- * The stream (as provided by the stdio lib) to write to.
+ * The buffered output stream to write to.
  *   @param pExpr
  * Pointer to the expression. It's a list of addends.
  *   @param pTableOfVars
@@ -1583,7 +2211,7 @@ static unsigned int print(FILE *stream, const char * const formatString, ...)
  * blank string, but could also contain some comment characters, etc.
  */
 
-static void printExpression( FILE * const stream
+static void printExpression( ost_outputStream_t * const stream
                            , const frq_frqDomExpression_t * const pExpr
                            , const tbv_tableOfVariables_t * const pTableOfVars
                            , const unsigned int printMargin
@@ -1602,7 +2230,7 @@ static void printExpression( FILE * const stream
         /* The format of the ouput in case of a null expression needs to be done in sync
            with the general output code in the else clause. We could also decide to have a
            +0. */
-        col += print(stream, "0");
+        col += ost_putChar(stream, '0');
     }
     else
     {
@@ -1637,7 +2265,7 @@ static void printExpression( FILE * const stream
                the opening bracket. */
             if(!isFirstGroup || signOfGroup < 0)
             {
-                col += print(stream, "%c", signOfGroup<0? '-': '+');
+                col += ost_putChar(stream, signOfGroup<0? '-': '+');
                 groupIndention = 1;
             }
             else
@@ -1646,7 +2274,7 @@ static void printExpression( FILE * const stream
             if(sizeOfGroup > 1)
             {
                 /* The opening bracket. */
-                col += print(stream, "(");
+                col += ost_putChar(stream, '(');
             }
 
             /* Loop over all addends in the group. */
@@ -1666,7 +2294,7 @@ static void printExpression( FILE * const stream
                 //frq_coefAddendFactor_t i = signOfGroup * pAddend->factor;
                 signed long i = signOfGroup * pAddend->factor.n;
                 if(!isFirstGroupAddend)
-                    col += print(stream, " %c ", i<0? '-': '+');
+                    col += ost_putString(stream, i<0? " - ": " + ");
                 /* Write the number without sign but in case of a one only if it would be
                    the only element of the product. ignoreFreqVar: If the term s^n is taken
                    out of the parenthesis, then we need the explicit 1 even for n!=0. */
@@ -1679,7 +2307,7 @@ static void printExpression( FILE * const stream
                        == 0
                   )
                 {
-                    col += print(stream, "%ld", i<0? -i: i);
+                    col += ost_putMagnitude(stream, i);
                     firstFactor = false;
                 }
 
@@ -1689,23 +2317,23 @@ static void printExpression( FILE * const stream
                     if(pAddend->powerOfConstAry[idxConst] != 0)
                     {
                         if(!firstFactor)
-                            col += print(stream, "*");
+                            col += ost_putChar(stream, '*');
                         firstFactor = false;
 
                         const pci_device_t *const pDev = tbv_getDeviceByBitIndex( pTableOfVars
                                                                                 , idxConst
                                                                                 );
-                        col += print(stream, "%s", pDev->name);
+                        col += ost_putString(stream, pDev->name);
                         if(pAddend->powerOfConstAry[idxConst] != 1)
                         {
                             /* Due to expression normalization all powers are positive. Yet
                                we don't need an assertion to check: if it would be negative
                                the output is still widely okay, we'd only set the power
                                into brackets then. */
-                            col += print( stream
-                                        , "^%d"
-                                        , pAddend->powerOfConstAry[idxConst]
-                                        );
+                            col += ost_putChar(stream, '^');
+                            col += ost_putSigned( stream
+                                                , pAddend->powerOfConstAry[idxConst]
+                                                );
                         }
                     } /* End if(Tested constant is part of this term?) */
                 } /* For(All defined physical constants) */
@@ -1718,14 +2346,13 @@ static void printExpression( FILE * const stream
                 {
                     if(col >= printMargin)
                     {
-                        print(stream, "\n%s", tabString);
+                        ost_putChar(stream, '\n');
+                        ost_putString(stream, tabString);
 
                         /* Actually, we need to indent two additional blanks to compensate
                            for sign and bracket, but one blank will be written as
                            separation character for the next, wrapped addend. */
-                        unsigned u;
-                        for(u=0; u<groupIndention; ++u)
-                            print(stream, " ");
+                        ost_putBlanks(stream, groupIndention);
                         col = tabPos+groupIndention;
                         wrappedGroup = true;
                     }
@@ -1741,33 +2368,36 @@ static void printExpression( FILE * const stream
                    opening counterpart. Maybe we need another line break. */
                 if(wrappedGroup)
                 {
-                    print(stream, "\n%s", tabString);
-                    unsigned u;
-                    for(u=0; u<groupIndention; ++u)
-                        print(stream, " ");
+                    ost_putChar(stream, '\n');
+                    ost_putString(stream, tabString);
+                    ost_putBlanks(stream, groupIndention);
                     col = tabPos+groupIndention;
                 }
 
-                col += print(stream, ")");
+                col += ost_putChar(stream, ')');
             }
 
             /* The group's term s^n is printed only if relevant. */
             if(groupPowerOfS != 0)
             {
                 if(!firstFactor)
-                    col += print(stream, " *");
+                    col += ost_putString(stream, " *");
                 firstFactor = false;
 
-                col += print(stream, " s");
+                col += ost_putString(stream, " s");
                 if(groupPowerOfS != 1)
-                    col += print(stream, "^%d", groupPowerOfS);
+                {
+                    col += ost_putChar(stream, '^');
+                    col += ost_putSigned(stream, groupPowerOfS);
+                }
 
             } /* End if(Frequency variable s is relevant of this group?) */
 
             /* Add a line feed and indentation white space after each group. */
             if(!isExpressionAddendNull(pAddend))
             {
-                print(stream, "\n%s", tabString);
+                ost_putChar(stream, '\n');
+                ost_putString(stream, tabString);
                 col = tabPos;
             }
 
@@ -1794,7 +2424,7 @@ static void printExpression( FILE * const stream
  * addend of another (i.e. lower) power of s or the end of the list. The advanced pointer
  * to the visited list element is returned. This may be the list terminating NULL pointer.
  *   @param stream
- * The stream (as provided by the stdio lib) to write to.
+ * The buffered output stream to write to.
  *   @param pHeadOfGroup
  * Pointer to the first exported addend of the expression. It should be the first addend
  * out of a group of those having the same power of s.
@@ -1812,7 +2442,7 @@ static void printExpression( FILE * const stream
  */
 
 static const frq_frqDomExpressionAddend_t *
-                 printCoefInSAsMCode( FILE * const stream
+                 printCoefInSAsMCode( ost_outputStream_t * const stream
                                     , const frq_frqDomExpressionAddend_t * const pHeadOfGroup
                                     , const tbv_tableOfVariables_t * const pTableOfVars
                                     , const unsigned int printMargin
@@ -1851,7 +2481,7 @@ static const frq_frqDomExpressionAddend_t *
     unsigned int groupIndention = 0;
     if(signOfGroup < 0)
     {
-        col += print(stream, "-");
+        col += ost_putChar(stream, '-');
         if(sizeOfGroup > 1)
             ++ groupIndention;
         // else: The - belongs to the only addend and doesn't move the tabulator.
@@ -1861,7 +2491,7 @@ static const frq_frqDomExpressionAddend_t *
     if(sizeOfGroup > 1)
     {
         /* The opening bracket. */
-        col += print(stream, "(");
+        col += ost_putChar(stream, '(');
         
         /* The just printed parenthesis is not counted for the indentation since the next
            addend on the new line will start with the pattern " + ", which includes the
@@ -1899,7 +2529,7 @@ static const frq_frqDomExpressionAddend_t *
            of the first addend: this sign has already been written as sign of the group. */
         rat_signed_int i = signOfGroup * pAddend->factor.n;
         if(!isFirstAddend)
-            col += print(stream, " %c ", i<0? '-': '+');
+            col += ost_putString(stream, i<0? " - ": " + ");
         /* Write the number without sign but in case of a one only if it would be
            the only element of the product. */
         if((i != 1 && i != -1)
@@ -1911,7 +2541,7 @@ static const frq_frqDomExpressionAddend_t *
                == 0
           )
         {
-            col += print(stream, "%ld", (signed long)(i<0? -i: i));
+            col += ost_putMagnitude(stream, (signed long)i);
             firstFactor = false;
         }
 
@@ -1923,22 +2553,20 @@ static const frq_frqDomExpressionAddend_t *
                 if(firstFactor)
                     firstFactor = false;
                 else
-                    col += print(stream, "*");
+                    col += ost_putChar(stream, '*');
 
                 const pci_device_t * const pDev = tbv_getDeviceByBitIndex( pTableOfVars
                                                                          , idxConst
                                                                          );
-                col += print(stream, "%s", pDev->name);
+                col += ost_putString(stream, pDev->name);
                 if(pAddend->powerOfConstAry[idxConst] != 1)
                 {
                     /* Due to expression normalization all powers are positive. Yet
                        we don't need an assertion to check: if it would be negative
                        the output is still widely okay, we'd only set the power
                        into brackets then. */
-                    col += print( stream
-                                , "^%d"
-                                , pAddend->powerOfConstAry[idxConst]
-                                );
+                    col += ost_putChar(stream, '^');
+                    col += ost_putSigned(stream, pAddend->powerOfConstAry[idxConst]);
                 }
             } /* End if(Tested constant is part of this term?) */
         } /* For(All defined physical constants) */
@@ -1951,7 +2579,8 @@ static const frq_frqDomExpressionAddend_t *
         {
             if(col >= printMargin)
             {
-                print(stream, " ...\n%s", extendedTabString);
+                ost_putString(stream, " ...\n");
+                ost_putString(stream, extendedTabString);
                 col = tabPos+groupIndention;
                 wrappedGroup = true;
             }
@@ -1970,14 +2599,16 @@ static const frq_frqDomExpressionAddend_t *
     {
         if(wrappedGroup)
         {
-            print(stream, " ...\n%s", extendedTabString);
+            ost_putString(stream, " ...\n");
+            ost_putString(stream, extendedTabString);
             col = tabPos+groupIndention;
         }
-        col += print(stream, ")");
+        col += ost_putChar(stream, ')');
     }
 
     /* The group's term s^n is printed as comment. */
-    col += print(stream, "\t %% s^%d", groupPowerOfS);
+    col += ost_putString(stream, "\t % s^");
+    col += ost_putSigned(stream, groupPowerOfS);
 
     return pAddend;
 
@@ -1986,6 +2617,233 @@ static const frq_frqDomExpressionAddend_t *
 
 
 
+/**
+ * Write a term of a factored expression as Octave M script code into a text stream. The
+ * term is the product of an integer, constants and optionally a sum; the sum is either
+ * referenced by the name of its intermediate variable or it is printed in place, in
+ * parenthesis.
+ *   @param stream
+ * The buffered output stream to write to.
+ *   @param pTerm
+ * The printed term.
+ *   @param isFirstTerm
+ * The first term of a sum is printed with a leading minus sign if it is negative and
+ * without a sign otherwise. All other terms are preceded by the operator + or -.
+ *   @param pSumTable
+ * The table of shared sums, which the term refers to.
+ *   @param pTableOfVars
+ * The data structure holding all information about the symbolic elements of the system's
+ * equations.
+ *   @param pCol
+ * The current column of the printed line on entry and on exit.
+ *   @param printMargin
+ * Line wrapping takes place between the terms of a sum when the margin is exceeded.
+ *   @param tabString
+ * This string is written at the beginning of any wrapped line.
+ */
+
+static void printFactoredTermAsMCode( ost_outputStream_t * const stream
+                                    , const factoredTerm_t * const pTerm
+                                    , boolean isFirstTerm
+                                    , const factoredSumTable_t * const pSumTable
+                                    , const tbv_tableOfVariables_t * const pTableOfVars
+                                    , unsigned int * const pCol
+                                    , const unsigned int printMargin
+                                    , const char * const tabString
+                                    )
+{
+    const unsigned int noConst = pTableOfVars->noConstants;
+    unsigned int col = *pCol;
+
+    assert(pTerm->factor != 0);
+    if(!isFirstTerm)
+        col += ost_putString(stream, pTerm->factor<0? " - ": " + ");
+    else if(pTerm->factor < 0)
+        col += ost_putChar(stream, '-');
+
+    /* The magnitude of the integer factor is omitted if it is one and if it is not the
+       only element of the product. */
+    boolean firstFactor = true
+          , hasConst = false;
+    unsigned int idxConst;
+    for(idxConst=0; idxConst<noConst; ++idxConst)
+    {
+        if(pTerm->powerOfConstAry[idxConst] != 0)
+        {
+            hasConst = true;
+            break;
+        }
+    }
+    const rat_signed_int i = pTerm->factor;
+    if((i != 1 && i != -1)  ||  (!hasConst  &&  pTerm->idxSum == FACTORED_SUM_NONE))
+    {
+        col += ost_putMagnitude(stream, (signed long)i);
+        firstFactor = false;
+    }
+
+    /* The constants are printed in the same order as in the expanded expressions. */
+    signed int idxConstDown;
+    for(idxConstDown=noConst-1; idxConstDown>=0; --idxConstDown)
+    {
+        const signed int power = pTerm->powerOfConstAry[idxConstDown];
+        if(power != 0)
+        {
+            if(firstFactor)
+                firstFactor = false;
+            else
+                col += ost_putChar(stream, '*');
+
+            col += ost_putString( stream
+                                , tbv_getDeviceByBitIndex(pTableOfVars, idxConstDown)->name
+                                );
+            if(power != 1)
+            {
+                col += ost_putChar(stream, '^');
+                col += ost_putSigned(stream, power);
+            }
+        }
+    } /* For(All defined physical constants) */
+
+    if(pTerm->idxSum != FACTORED_SUM_NONE)
+    {
+        if(!firstFactor)
+            col += ost_putChar(stream, '*');
+
+        const factoredSum_t * const pSum = &pSumTable->sumAry[pTerm->idxSum];
+        if(pSum->idxName > 0)
+        {
+            col += ost_putString(stream, "S_");
+            col += ost_putUnsigned(stream, pSum->idxName);
+        }
+        else
+        {
+            /* A sum, which is used only once, is printed in place. */
+            col += ost_putChar(stream, '(');
+            printFactoredSumAsMCode( stream
+                                   , pSum
+                                   , pSumTable
+                                   , pTableOfVars
+                                   , &col
+                                   , printMargin
+                                   , tabString
+                                   );
+            col += ost_putChar(stream, ')');
+        }
+    } /* End if(Term is multiplied with a sum?) */
+
+    *pCol = col;
+
+} /* End of printFactoredTermAsMCode */
+
+
+
+
+/**
+ * Write a sum of factored terms as Octave M script code into a text stream. The sum is
+ * printed without enclosing parenthesis.
+ *   @param stream
+ * The buffered output stream to write to.
+ *   @param pSum
+ * The printed sum.
+ *   @param pSumTable
+ * The table of shared sums, which the terms of the printed sum refer to.
+ *   @param pTableOfVars
+ * The data structure holding all information about the symbolic elements of the system's
+ * equations.
+ *   @param pCol
+ * The current column of the printed line on entry and on exit.
+ *   @param printMargin
+ * Line wrapping takes place between the terms of a sum when the margin is exceeded.
+ *   @param tabString
+ * This string is written at the beginning of any wrapped line.
+ */
+
+static void printFactoredSumAsMCode( ost_outputStream_t * const stream
+                                   , const factoredSum_t * const pSum
+                                   , const factoredSumTable_t * const pSumTable
+                                   , const tbv_tableOfVariables_t * const pTableOfVars
+                                   , unsigned int * const pCol
+                                   , const unsigned int printMargin
+                                   , const char * const tabString
+                                   )
+{
+    assert(pSum->noTerms >= 2);
+    unsigned int idxTerm;
+    for(idxTerm=0; idxTerm<pSum->noTerms; ++idxTerm)
+    {
+        /* Add a line feed and indentation white space if print margin is exceeded. */
+        if(idxTerm > 0  &&  *pCol >= printMargin)
+        {
+            ost_putString(stream, " ...\n");
+            *pCol = ost_putString(stream, tabString);
+        }
+
+        printFactoredTermAsMCode( stream
+                                , &pSum->termAry[idxTerm]
+                                , /* isFirstTerm */ idxTerm == 0
+                                , pSumTable
+                                , pTableOfVars
+                                , pCol
+                                , printMargin
+                                , tabString
+                                );
+    }
+} /* End of printFactoredSumAsMCode */
+
+
+
+
+/**
+ * Write the shared sums of factored expressions as assignments of intermediate variables
+ * S_n in Octave M script code into a text stream. A sum refers only to sums of lower
+ * index, the assignments are made in the order of the table and there are no forward
+ * references.
+ *   @param stream
+ * The buffered output stream to write to.
+ *   @param pSumTable
+ * The table of shared sums.
+ *   @param pTableOfVars
+ * The data structure holding all information about the symbolic elements of the system's
+ * equations.
+ *   @param printMargin
+ * Line wrapping takes place between the terms of a sum when the margin is exceeded.
+ */
+
+static void printNamedSumsAsMCode( ost_outputStream_t * const stream
+                                 , const factoredSumTable_t * const pSumTable
+                                 , const tbv_tableOfVariables_t * const pTableOfVars
+                                 , const unsigned int printMargin
+                                 )
+{
+    unsigned int idxSum;
+    for(idxSum=0; idxSum<pSumTable->noSums; ++idxSum)
+    {
+        const factoredSum_t * const pSum = &pSumTable->sumAry[idxSum];
+        if(pSum->idxName == 0)
+            continue;
+
+        unsigned int col = ost_printf(stream, "S_%u = ", pSum->idxName);
+        char tabString[128];
+        getBlankTabString( tabString
+                         , sizeof(tabString)
+                         , /* existingTabString */ ""
+                         , /* additionalIndentation */ col
+                         );
+        printFactoredSumAsMCode( stream
+                               , pSum
+                               , pSumTable
+                               , pTableOfVars
+                               , &col
+                               , printMargin
+                               , tabString
+                               );
+        ost_putString(stream, ";\n");
+    }
+} /* End of printNamedSumsAsMCode */
+
+
+
+
 /**
  * Decide if an expression is simple. This function is used for rendering of the results.
  * If an expression has already benn rendered then normally it won't be rendered again.
@@ -2050,7 +2908,7 @@ static boolean isExpressionSimple( const frq_frqDomExpression_t * const pExpr
  * expression is represented as a polynomial in s. The operand is a list of addends, not a
  * normalized expression object.
  *   @param stream
- * The stream (as provided by the stdio lib) to write to.
+ * The buffered output stream to write to.
  *   @param name
  * This string holds the name of the expression. The output is an assignment like: \a
  * name = expression;
@@ -2078,7 +2936,7 @@ static boolean isExpressionSimple( const frq_frqDomExpression_t * const pExpr
  * blank string, but could also contain some comment characters, etc.
  */
 
-static void printNamedExpression( FILE * const stream
+static void printNamedExpression( ost_outputStream_t * const stream
                                 , const char * const name
                                 , const char * const nameRHS
                                 , const frq_frqDomExpression_t * const pExpr
@@ -2089,13 +2947,13 @@ static void printNamedExpression( FILE * const stream
                                 )
 {
     const unsigned int noConst = pTableOfVars->noConstants;
-    print(stream, "%s%s(s) = ", tabString, name);
+    ost_printf(stream, "%s%s(s) = ", tabString, name);
 
     if(nameRHS != NULL  &&  !isExpressionSimple(pExpr, noConst))
     {
         /* Simple: The assigned value is a known, named expression. We just assign the variable
            of that name. */
-        print(stream, "%s%s(s)", invertSign? "-": "", nameRHS);
+        ost_printf(stream, "%s%s(s)", invertSign? "-": "", nameRHS);
     }
     else
     {
@@ -2133,7 +2991,7 @@ static void printNamedExpression( FILE * const stream
             freeExpression(pPrintedExpr);
     }
 
-    print(stream, "\n");
+    ost_putString(stream, "\n");
 
 } /* End of printNamedExpression */
 
@@ -2146,7 +3004,7 @@ static void printNamedExpression( FILE * const stream
  * expected by Octave functions like tf. The operand is a list of addends, not a normalized
  * expression object.
  *   @param stream
- * The stream (as provided by the stdio lib) to write to.
+ * The buffered output stream to write to.
  *   @param name
  * This string is holds the name of the expression. The output is an assignment like: \a
  * name = expression;
@@ -2167,32 +3025,42 @@ static void printNamedExpression( FILE * const stream
  * of the expression is still not completed. Checking the margin only after completing an
  * addend means that the printed lines can become significantly longer than the margin
  * says. So take a rather small value for the margin. Ignored if \a nameRHS is not NULL.
+ *   @param factoredCoefAry
+ * NULL or the factored form of * \a pExpr, one term for each of its non null
+ * coefficients in falling powers of s. If not NULL then the coefficients are printed in
+ * factored form instead of the expanded sums of addends. Ignored if \a nameRHS is not
+ * NULL.
+ *   @param pSumTable
+ * The table of shared sums, which the terms of \a factoredCoefAry refer to. Ignored if \a
+ * factoredCoefAry is NULL.
  */
 
-static void printNamedExpressionAsMCode( FILE * const stream
+static void printNamedExpressionAsMCode( ost_outputStream_t * const stream
                                        , const char * const name
                                        , const char * const nameRHS
                                        , const frq_frqDomExpression_t * const pExpr
                                        , boolean invertSign
                                        , const tbv_tableOfVariables_t * const pTableOfVars
                                        , const unsigned int printMargin
+                                       , const factoredTerm_t * const factoredCoefAry
+                                       , const factoredSumTable_t * const pSumTable
                                        )
 {
     const unsigned int noConst = pTableOfVars->noConstants;
 
-    print(stream, "%s = ", name);
+    ost_printf(stream, "%s = ", name);
 
     if(nameRHS != NULL  &&  !isExpressionSimple(pExpr, noConst))
     {
         /* Simple: The assigned value is a known, named expression. We just assign the
            variable of that name. */
-        print(stream, "%s%s", invertSign? "-": "", nameRHS);
+        ost_printf(stream, "%s%s", invertSign? "-": "", nameRHS);
     }
     else
     {
         /* Usual complex case: Print the RHS as an expression in all details. In Octave
            this is a row vector of coefficients in falling power of s. */
-        print(stream, "%s[ ",  invertSign? "-": "");
+        ost_printf(stream, "%s[ ",  invertSign? "-": "");
 
         /* The printing sub-routine will use several lines. Each coefficient (or vector
            element) will begin with the string composed here. We want to see
@@ -2210,7 +3078,7 @@ static void printNamedExpressionAsMCode( FILE * const stream
             /* The format of the ouput in case of a null expression needs to be done in
                sync with the general output code in the else clause. We could also decide
                to have a +0. */
-            print(stream, "0\t %% s^0\n%s", tabStringVecElem);
+            ost_printf(stream, "0\t %% s^0\n%s", tabStringVecElem);
         }
         else
         {
@@ -2229,6 +3097,7 @@ static void printNamedExpressionAsMCode( FILE * const stream
                will be powers in s, which do not occur in the expression and thus in no
                group. Here we have to insert null coefficients into the Octave vector. */
             const frq_frqDomExpressionAddend_t *pAddend = pExpr;
+            const factoredTerm_t *pFactoredCoef = factoredCoefAry;
             signed int powerOfS;
             for(powerOfS=pAddend->powerOfS; powerOfS>=0; --powerOfS)
             {
@@ -2236,25 +3105,48 @@ static void printNamedExpressionAsMCode( FILE * const stream
                 {
                     /* Export the non null coefficient of the term of the next present
                        power in s. */
-                    pAddend = printCoefInSAsMCode( stream
-                                                 , pAddend
-                                                 , pTableOfVars
-                                                 , printMargin
-                                                 , tabStringAddend
-                                                 );
+                    if(pFactoredCoef != NULL)
+                    {
+                        /* The factored coefficient replaces the group of addends of same
+                           power of s. */
+                        unsigned int col = strlen(tabStringAddend)
+                                   , noAddends = getNoAddendsOfSamePowerOfS(pAddend);
+                        printFactoredTermAsMCode( stream
+                                                , pFactoredCoef++
+                                                , /* isFirstTerm */ true
+                                                , pSumTable
+                                                , pTableOfVars
+                                                , &col
+                                                , printMargin
+                                                , tabStringAddend
+                                                );
+                        ost_printf(stream, "\t %% s^%d", powerOfS);
+                        while(noAddends-- > 0)
+                            pAddend = pAddend->pNext;
+                    }
+                    else
+                    {
+                        pAddend = printCoefInSAsMCode( stream
+                                                     , pAddend
+                                                     , pTableOfVars
+                                                     , printMargin
+                                                     , tabStringAddend
+                                                     );
+                    }
                 }
                 else
                 {
                     /* The expression doesn't contain a term in the next power of s, so we need
                        to write a null value. */
-                    print(stream, "0\t %% s^%d", powerOfS);
+                    ost_printf(stream, "0\t %% s^%d", powerOfS);
 
                 } /* End if(Power of s contained in exported expression?) */
 
                 /* Add a line feed and indentation white space after each group. */
-                print(stream, "\n%s", tabStringVecElem);
+                ost_putChar(stream, '\n');
+                ost_putString(stream, tabStringVecElem);
                 if(powerOfS > 0)
-                    print(stream, "; ");
+                    ost_putString(stream, "; ");
 
             } /* End for(All powers of s) */
 
@@ -2263,10 +3155,10 @@ static void printNamedExpressionAsMCode( FILE * const stream
         } /* End if(Special case of a null expression?) */
 
         /* .': Octave doesn't care but MATLAB requires row vectors. */
-        print(stream, "].'");
+        ost_putString(stream, "].'");
     }
 
-    print(stream, ";\n");
+    ost_putString(stream, ";\n");
 
 } /* End of printNamedExpressionAsMCode */
 
@@ -2449,7 +3341,7 @@ static void cancelFraction( frq_frqDomExpression_t ** const ppCancelledExprNum
  *   @param pMap
  * The pointer to the map object. All needed storage is preallocated, no memory allocation
  * or free operations take place; the map needs to have enough storage space to complete
- * the operation.
+ * the operation. This includes the hash table, which must have at least one free slot.
  *   @param pExpr
  * The pointer to the expression or its heading addend.
  *   @param isUsedAsDenominator
@@ -2464,17 +3356,24 @@ static unsigned int moveExprIntoMap( resultExpressionMap_t * const pMap
     const unsigned int noConst = pMap->pSolution->pTableOfVars->noConstants;
     assert(pMap->noResExpr < pMap->maxNoResExpr);
 
-    /* The main purpose of the map is to allow reuse of common terms. We do a linear
-       iteration over all already stored expressions and look for identical ones. */
-    unsigned int idxExpr;
-    for(idxExpr=0; idxExpr<pMap->noResExpr; ++idxExpr)
+    /* The main purpose of the map is to allow reuse of common terms. We look for identical
+       ones among the already stored expressions. Only those with same hash code need to be
+       compared in full. They are found in the hash table by linear probing, starting at
+       the slot related to the hash code. */
+    const unsigned int hash = hashAbsExpression(pExpr, noConst)
+                     , mask = pMap->noHashSlots - 1;
+    assert((pMap->noHashSlots & mask) == 0);
+    unsigned int idxSlot = hash & mask
+               , idxExpr;
+    while((idxExpr=pMap->idxResExprByHashAry[idxSlot]) != RESULT_EXPR_EMPTY_SLOT)
     {
         boolean haveSameSign;
-        if(isAbsEqualExpressions( &haveSameSign
-                                , pMap->resExprAry[idxExpr].pExpr
-                                , pExpr
-                                , noConst
-                                )
+        if(pMap->resExprAry[idxExpr].hash == hash
+           &&  isAbsEqualExpressions( &haveSameSign
+                                    , pMap->resExprAry[idxExpr].pExpr
+                                    , pExpr
+                                    , noConst
+                                    )
           )
         {
             /* The passed expression is no longer used, destroy object. */
@@ -2489,14 +3388,20 @@ static unsigned int moveExprIntoMap( resultExpressionMap_t * const pMap
                 resultIdx |= RESULT_EXPR_REF_IS_NEGATED;
             return resultIdx;
         }
-    } /* End for(All already stored expressions) */
+
+        idxSlot = (idxSlot+1) & mask;
+
+    } /* End while(All stored expressions with possibly matching hash code) */
 
     /* We got a new expression, put it at the end. Its name and the origina of this name
        are still unknown. */
-    ++ pMap->noResExpr;
+    idxExpr = pMap->noResExpr++;
+    pMap->idxResExprByHashAry[idxSlot] = idxExpr;
     pMap->resExprAry[idxExpr] = (resultExpression_t)
                                 { .name = NULL
                                 , .pExpr = pExpr
+                                , .hash = hash
+                                , .factoredCoefAry = NULL
                                 , .isUsedAsDenom = isUsedAsDenominator
                                 , .origin = (resultExpressionOrigin_t)
                                             { .idxDependent = UINT_MAX
@@ -2547,6 +3452,19 @@ static resultExpressionMap_t *createExpressionMap
                                   );
     pExprMap->idxNumExprAry = unsignedInt_createMatrix(noDependents, noIndependents);
     pExprMap->idxDenomExprAry = unsignedInt_createMatrix(noDependents, noIndependents);
+    pExprMap->isFactored = false;
+
+    /* The hash table is dimensioned for a load of at most 50%. */
+    pExprMap->noHashSlots = 4;
+    while(pExprMap->noHashSlots < 4*noDependents*noIndependents)
+        pExprMap->noHashSlots *= 2;
+    pExprMap->idxResExprByHashAry = smalloc( pExprMap->noHashSlots*sizeof(unsigned int)
+                                           , __FILE__
+                                           , __LINE__
+                                           );
+    unsigned int idxSlot;
+    for(idxSlot=0; idxSlot<pExprMap->noHashSlots; ++idxSlot)
+        pExprMap->idxResExprByHashAry[idxSlot] = RESULT_EXPR_EMPTY_SLOT;
 
     /* Loop over all fractions: Cancel them and put cancelled numerator and denominator
        expression into the map. */
@@ -2557,12 +3475,14 @@ static resultExpressionMap_t *createExpressionMap
         {
             frq_frqDomExpression_t *pCancelledExprNum
                                  , *pCancelledExprDenom;
+            prf_startPhase(prf_phaseCancellation);
             cancelFraction( &pCancelledExprNum
                           , &pCancelledExprDenom
                           , pSolution->numeratorAry[idxDependent][idxIndependent]
                           , pSolution->pDenominator
                           , pTabOfVars->noConstants
                           );
+            prf_stopPhase(prf_phaseCancellation);
             pExprMap->idxNumExprAry[idxDependent][idxIndependent] =
                                             moveExprIntoMap( pExprMap
                                                            , pCancelledExprNum
@@ -2584,41 +3504,608 @@ static resultExpressionMap_t *createExpressionMap
              , 2*noDependents*noIndependents - pExprMap->noResExpr
              )
 
-    return pExprMap;
+    return pExprMap;
+
+} /* End of createExpressionMap */
+
+
+
+
+/**
+ * Destroy a result expression map after use. Counterpart of \a createExpressionMap.
+ *   @param pExprMap
+ * Pointer to the object to be destroyed.
+ */
+
+static void deleteExpressionMap(resultExpressionMap_t * const pExprMap)
+{
+    const frq_freqDomainSolution_t * const pSolution = pExprMap->pSolution;
+    const unsigned int noDependents = frq_getNoDependents(pSolution)
+                     , noIndependents = frq_getNoIndependents(pSolution);
+
+    unsigned int idxExpr;
+    for(idxExpr=0; idxExpr<pExprMap->noResExpr; ++idxExpr)
+    {
+        const resultExpression_t * const pResultExpr = &pExprMap->resExprAry[idxExpr];
+        freeExpression(pResultExpr->pExpr);
+        free(pResultExpr->factoredCoefAry);
+    }
+
+    if(pExprMap->isFactored)
+    {
+        const factoredSumTable_t * const pTable = &pExprMap->factoredSumTable;
+        unsigned int idxSum;
+        for(idxSum=0; idxSum<pTable->noSums; ++idxSum)
+            free(pTable->sumAry[idxSum].termAry);
+        free(pTable->sumAry);
+        free(pTable->idxSumByHashAry);
+    }
+
+    free(pExprMap->resExprAry);
+    free(pExprMap->idxResExprByHashAry);
+    unsignedInt_deleteMatrix(pExprMap->idxNumExprAry, noDependents, noIndependents);
+    unsignedInt_deleteMatrix(pExprMap->idxDenomExprAry, noDependents, noIndependents);
+
+    frq_deleteFreqDomainSolution(pSolution);
+
+    free(pExprMap);
+
+} /* End of deleteExpressionMap */
+
+
+
+
+/**
+ * Allocate an array of terms of factored expressions together with the powers of
+ * constants of the terms.
+ *   @return
+ * Get the array. Its elements are uninitialized but for their pointers to the arrays of
+ * powers of constants. The array and the powers are a single block of memory; free it with
+ * a single call of free().
+ *   @param noTerms
+ * The number of elements, at least one.
+ *   @param noConst
+ * The total number of device constants, which are in use in the given system.
+ */
+
+static factoredTerm_t *newFactoredTermAry(unsigned int noTerms, unsigned int noConst)
+{
+    assert(noTerms >= 1);
+    factoredTerm_t * const termAry = smalloc( noTerms*(sizeof(factoredTerm_t)
+                                                       + noConst*sizeof(signed short)
+                                                      )
+                                            , __FILE__
+                                            , __LINE__
+                                            );
+    signed short *pPowerOfConst = (signed short*)(termAry + noTerms);
+    unsigned int idxTerm;
+    for(idxTerm=0; idxTerm<noTerms; ++idxTerm)
+    {
+        termAry[idxTerm].powerOfConstAry = pPowerOfConst;
+        pPowerOfConst += noConst;
+    }
+
+    return termAry;
+
+} /* End of newFactoredTermAry */
+
+
+
+
+/**
+ * Copy a term of a factored expression. The powers of constants are copied, too.
+ *   @param pDest
+ * The term to overwrite. Its array of powers of constants needs to be allocated.
+ *   @param pSrc
+ * The copied term.
+ *   @param noConst
+ * The total number of device constants, which are in use in the given system.
+ */
+
+static inline void copyFactoredTerm( factoredTerm_t * const pDest
+                                   , const factoredTerm_t * const pSrc
+                                   , unsigned int noConst
+                                   )
+{
+    pDest->factor = pSrc->factor;
+    pDest->idxSum = pSrc->idxSum;
+    memcpy(pDest->powerOfConstAry, pSrc->powerOfConstAry, noConst*sizeof(signed short));
+
+} /* End of copyFactoredTerm */
+
+
+
+
+/**
+ * Compute a hash code of a sum of factored terms. Two sums have the same code if they
+ * have the same terms in the same order.
+ *   @return
+ * Get the hash code.
+ *   @param termAry
+ * The terms of the sum.
+ *   @param noTerms
+ * The number of terms.
+ *   @param noConst
+ * The total number of device constants, which are in use in the given system.
+ */
+
+static unsigned int hashFactoredTerms( const factoredTerm_t termAry[]
+                                     , unsigned int noTerms
+                                     , unsigned int noConst
+                                     )
+{
+    /* FNV-1a over the factors, the powers and the referenced sums of all terms. The
+       referenced sums are shared and their indexes are canonical. */
+    unsigned int hash = 2166136261u;
+    unsigned int idxTerm;
+    for(idxTerm=0; idxTerm<noTerms; ++idxTerm)
+    {
+        const factoredTerm_t * const pTerm = &termAry[idxTerm];
+        hash = (hash ^ (unsigned int)pTerm->factor) * 16777619u;
+        hash = (hash ^ pTerm->idxSum) * 16777619u;
+        unsigned int idxConst;
+        for(idxConst=0; idxConst<noConst; ++idxConst)
+        {
+            hash = (hash ^ (unsigned int)(signed int)pTerm->powerOfConstAry[idxConst])
+                   * 16777619u;
+        }
+    }
+
+    return hash;
+
+} /* End of hashFactoredTerms */
+
+
+
+
+/**
+ * Move the terms of a sum into the table of shared sums. "Move" means, that the table
+ * takes the ownership of the passed array of terms. If the same sum is already stored
+ * then the passed array is freed and the stored sum is returned.
+ *   @return
+ * Get the index of the sum in the table.
+ *   @param pTable
+ * The table of shared sums. All needed storage is preallocated; the table needs to have
+ * enough storage space to complete the operation.
+ *   @param termAry
+ * The terms of the sum as got from newFactoredTermAry().
+ *   @param noTerms
+ * The number of terms, at least two.
+ */
+
+static unsigned int moveTermsIntoSumTable( factoredSumTable_t * const pTable
+                                         , factoredTerm_t * const termAry
+                                         , unsigned int noTerms
+                                         )
+{
+    assert(noTerms >= 2);
+    const unsigned int noConst = pTable->noConst
+                     , hash = hashFactoredTerms(termAry, noTerms, noConst)
+                     , mask = pTable->noHashSlots - 1;
+    assert((pTable->noHashSlots & mask) == 0);
+    unsigned int idxSlot = hash & mask
+               , idxSum;
+    while((idxSum=pTable->idxSumByHashAry[idxSlot]) != RESULT_EXPR_EMPTY_SLOT)
+    {
+        const factoredSum_t * const pSum = &pTable->sumAry[idxSum];
+        if(pSum->hash == hash  &&  pSum->noTerms == noTerms)
+        {
+            /* The referenced sums are shared, a shallow comparison of the terms is
+               sufficient. */
+            unsigned int idxTerm;
+            for(idxTerm=0; idxTerm<noTerms; ++idxTerm)
+            {
+                const factoredTerm_t * const pT1 = &pSum->termAry[idxTerm]
+                                   , * const pT2 = &termAry[idxTerm];
+                if(pT1->factor != pT2->factor  ||  pT1->idxSum != pT2->idxSum
+                   ||  memcmp( pT1->powerOfConstAry
+                             , pT2->powerOfConstAry
+                             , noConst*sizeof(signed short)
+                             ) != 0
+                  )
+                {
+                    break;
+                }
+            }
+            if(idxTerm == noTerms)
+            {
+                free(termAry);
+                return idxSum;
+            }
+        }
+
+        idxSlot = (idxSlot+1) & mask;
+
+    } /* End while(All stored sums with possibly matching hash code) */
+
+    /* We got a new sum, put it at the end. The sums it refers to get another reference. */
+    assert(pTable->noSums < pTable->maxNoSums);
+    idxSum = pTable->noSums++;
+    pTable->idxSumByHashAry[idxSlot] = idxSum;
+    pTable->sumAry[idxSum] = (factoredSum_t){ .noTerms = noTerms
+                                            , .termAry = termAry
+                                            , .hash = hash
+                                            , .noReferences = 0
+                                            , .idxName = 0
+                                            };
+    unsigned int idxTerm;
+    for(idxTerm=0; idxTerm<noTerms; ++idxTerm)
+    {
+        if(termAry[idxTerm].idxSum != FACTORED_SUM_NONE)
+            ++ pTable->sumAry[termAry[idxTerm].idxSum].noReferences;
+    }
+
+    return idxSum;
+
+} /* End of moveTermsIntoSumTable */
+
+
+
+
+/**
+ * Divide the content out of a polynomial in the device constants. The content is the
+ * greatest common divisor of the integer factors of all monomials times the lowest power
+ * of each device constant found in all monomials. Its sign is the sign of the first
+ * monomial, such that the remaining polynomial begins with a positive monomial.
+ *   @return
+ * Get \a true if the content is not trivial, i.e. if it is not the number one.
+ *   @param pContent
+ * The factor and the powers of constants of * \a pContent are set to the content. The
+ * referenced sum is not touched.
+ *   @param monomialAry
+ * The monomials of the polynomial. They are divided by the content in place.
+ *   @param noMonomials
+ * The number of monomials, at least one.
+ *   @param noConst
+ * The total number of device constants, which are in use in the given system.
+ */
+
+static boolean divideContent( factoredTerm_t * const pContent
+                            , factoredTerm_t monomialAry[]
+                            , unsigned int noMonomials
+                            , unsigned int noConst
+                            )
+{
+    assert(noMonomials >= 1);
+    rat_signed_int gcd = monomialAry[0].factor;
+    memcpy( pContent->powerOfConstAry
+          , monomialAry[0].powerOfConstAry
+          , noConst*sizeof(signed short)
+          );
+    unsigned int idxMonomial, idxConst;
+    for(idxMonomial=1; idxMonomial<noMonomials; ++idxMonomial)
+    {
+        const factoredTerm_t * const pMonomial = &monomialAry[idxMonomial];
+        gcd = rat_gcd(gcd, pMonomial->factor);
+        for(idxConst=0; idxConst<noConst; ++idxConst)
+        {
+            if(pMonomial->powerOfConstAry[idxConst] < pContent->powerOfConstAry[idxConst])
+                pContent->powerOfConstAry[idxConst] = pMonomial->powerOfConstAry[idxConst];
+        }
+    }
+    if(gcd < 0)
+        gcd = -gcd;
+    if(monomialAry[0].factor < 0)
+        gcd = -gcd;
+    pContent->factor = gcd;
+
+    boolean isTrivial = gcd == 1;
+    for(idxConst=0; isTrivial && idxConst<noConst; ++idxConst)
+        isTrivial = pContent->powerOfConstAry[idxConst] == 0;
+    if(isTrivial)
+        return false;
+
+    for(idxMonomial=0; idxMonomial<noMonomials; ++idxMonomial)
+    {
+        factoredTerm_t * const pMonomial = &monomialAry[idxMonomial];
+        assert(pMonomial->factor % gcd == 0);
+        pMonomial->factor /= gcd;
+        for(idxConst=0; idxConst<noConst; ++idxConst)
+            pMonomial->powerOfConstAry[idxConst] -= pContent->powerOfConstAry[idxConst];
+    }
+
+    return true;
+
+} /* End of divideContent */
+
+
+
+
+/**
+ * Factor a polynomial in the device constants and append the resulting terms to the terms
+ * of a sum under construction. A polynomial with non trivial content becomes a single
+ * term, the content times the factored remainder. Otherwise, multivariate Horner's scheme
+ * is applied: The monomials are split into those, which contain the constant found in
+ * most monomials, and the rest. Both parts are factored recursively; the first part will
+ * have this constant as content, the terms of the second part are appended if it has no
+ * content.
+ *   @param pTable
+ * The table of shared sums, which takes all created sums.
+ *   @param termStack
+ * The terms of the sum under construction. The next term is appended at index * \a
+ * pNoTerms and the elements behind are used as stack for the construction of nested sums.
+ * It needs to have twice the number of elements of \a monomialAry.
+ *   @param pNoTerms
+ * The number of terms of the sum under construction. Incremented by the number of
+ * appended terms.
+ *   @param monomialAry
+ * The monomials of the polynomial. The array is reordered and modified in place.
+ *   @param scratchAry
+ * An array of the same size as \a monomialAry, which is used for reordering.
+ *   @param noMonomials
+ * The number of monomials, at least one.
+ */
+
+static void appendFactoredTerms( factoredSumTable_t * const pTable
+                               , factoredTerm_t termStack[]
+                               , unsigned int * const pNoTerms
+                               , factoredTerm_t monomialAry[]
+                               , factoredTerm_t scratchAry[]
+                               , unsigned int noMonomials
+                               )
+{
+    const unsigned int noConst = pTable->noConst;
+    factoredTerm_t * const pTerm = &termStack[*pNoTerms];
+
+    if(noMonomials == 1)
+    {
+        copyFactoredTerm(pTerm, &monomialAry[0], noConst);
+        ++ *pNoTerms;
+        return;
+    }
+
+    if(divideContent(pTerm, monomialAry, noMonomials, noConst))
+    {
+        pTerm->idxSum = factorSum( pTable
+                                 , monomialAry
+                                 , scratchAry
+                                 , /* termStack */ pTerm + 1
+                                 , noMonomials
+                                 );
+        ++ *pNoTerms;
+        return;
+    }
+
+    /* Find the constant, which is contained in most monomials. On equal count the
+       constant of higher index is taken, which is printed first. */
+    unsigned int maxCount = 0
+               , idxBestConst = 0;
+    signed int idxConst;
+    for(idxConst=noConst-1; idxConst>=0; --idxConst)
+    {
+        unsigned int count = 0
+                   , idxMonomial;
+        for(idxMonomial=0; idxMonomial<noMonomials; ++idxMonomial)
+        {
+            if(monomialAry[idxMonomial].powerOfConstAry[idxConst] > 0)
+                ++ count;
+        }
+        if(count > maxCount)
+        {
+            maxCount = count;
+            idxBestConst = (unsigned)idxConst;
+        }
+    }
+
+    unsigned int idxMonomial;
+    if(maxCount < 2)
+    {
+        /* Nothing can be factored out, the monomials are the terms. */
+        for(idxMonomial=0; idxMonomial<noMonomials; ++idxMonomial)
+            copyFactoredTerm(&termStack[(*pNoTerms)++], &monomialAry[idxMonomial], noConst);
+        return;
+    }
+
+    /* The monomials are split in a stable way: The order of the monomials is kept in both
+       parts. All polynomials, which are derived from equal coefficients, will have their
+       monomials in the same order and lead to identical, shareable sums. The polynomial is
+       primitive, not all monomials contain the constant. */
+    unsigned int noWith = 0
+               , noWithout = 0;
+    for(idxMonomial=0; idxMonomial<noMonomials; ++idxMonomial)
+    {
+        if(monomialAry[idxMonomial].powerOfConstAry[idxBestConst] > 0)
+            monomialAry[noWith++] = monomialAry[idxMonomial];
+        else
+            scratchAry[noWithout++] = monomialAry[idxMonomial];
+    }
+    assert(noWith == maxCount  &&  noWithout > 0);
+    memcpy(&monomialAry[noWith], scratchAry, noWithout*sizeof(factoredTerm_t));
+
+    appendFactoredTerms(pTable, termStack, pNoTerms, monomialAry, scratchAry, noWith);
+    appendFactoredTerms( pTable
+                       , termStack
+                       , pNoTerms
+                       , &monomialAry[noWith]
+                       , &scratchAry[noWith]
+                       , noWithout
+                       );
+} /* End of appendFactoredTerms */
+
+
+
+
+/**
+ * Factor a primitive polynomial in the device constants into a shared sum of terms.
+ *   @return
+ * Get the index of the sum in the table of shared sums.
+ *   @param pTable
+ * The table of shared sums, which takes all created sums.
+ *   @param monomialAry
+ * The monomials of the polynomial. The array is reordered and modified in place. The
+ * polynomial has no content, see divideContent().
+ *   @param scratchAry
+ * An array of the same size as \a monomialAry, which is used for reordering.
+ *   @param termStack
+ * An array of twice the size of \a monomialAry, which is used to construct the sum and
+ * its nested sums.
+ *   @param noMonomials
+ * The number of monomials, at least two.
+ */
+
+static unsigned int factorSum( factoredSumTable_t * const pTable
+                             , factoredTerm_t monomialAry[]
+                             , factoredTerm_t scratchAry[]
+                             , factoredTerm_t termStack[]
+                             , unsigned int noMonomials
+                             )
+{
+    assert(noMonomials >= 2);
+    const unsigned int noConst = pTable->noConst;
+    unsigned int noTerms = 0;
+    appendFactoredTerms(pTable, termStack, &noTerms, monomialAry, scratchAry, noMonomials);
+    assert(noTerms >= 2  &&  noTerms <= noMonomials);
+
+    /* The sum is stored with an array of the final size. */
+    factoredTerm_t * const termAry = newFactoredTermAry(noTerms, noConst);
+    unsigned int idxTerm;
+    for(idxTerm=0; idxTerm<noTerms; ++idxTerm)
+        copyFactoredTerm(&termAry[idxTerm], &termStack[idxTerm], noConst);
+
+    return moveTermsIntoSumTable(pTable, termAry, noTerms);
+
+} /* End of factorSum */
+
+
+
+
+/**
+ * Add the factored form to all expressions of an expression map. Each coefficient of an
+ * expression is factored independently but all sums, which are found in the factored
+ * coefficients, are shared between all expressions. Sums, which are referenced more than
+ * once, are given a name; they are rendered as intermediate variables.
+ *   @param pExprMap
+ * The expression map object to be manipulated.
+ */
+
+static void factorExpressionMap(resultExpressionMap_t * const pExprMap)
+{
+    assert(!pExprMap->isFactored);
+    const unsigned int noConst = pExprMap->pSolution->pTableOfVars->noConstants;
+    factoredSumTable_t * const pTable = &pExprMap->factoredSumTable;
+
+    /* Each sum splits the monomials of a coefficient into at least two parts and the
+       parts of all sums of a coefficient are nested. There are less sums than addends. */
+    unsigned int noAddends = 0
+               , idxExpr;
+    for(idxExpr=0; idxExpr<pExprMap->noResExpr; ++idxExpr)
+    {
+        const frq_frqDomExpressionAddend_t *pAddend = pExprMap->resExprAry[idxExpr].pExpr;
+        while(!isExpressionAddendNull(pAddend))
+        {
+            ++ noAddends;
+            pAddend = pAddend->pNext;
+        }
+    }
+    const unsigned int maxNoSums = noAddends > 0? noAddends: 1;
+    pTable->noConst = noConst;
+    pTable->noSums = 0;
+#ifdef DEBUG
+    pTable->maxNoSums = maxNoSums;
+#endif
+    pTable->sumAry = smalloc(maxNoSums*sizeof(factoredSum_t), __FILE__, __LINE__);
+
+    /* The hash table is dimensioned for a load of at most 50%. */
+    pTable->noHashSlots = 4;
+    while(pTable->noHashSlots < 2*maxNoSums)
+        pTable->noHashSlots *= 2;
+    pTable->idxSumByHashAry = smalloc( pTable->noHashSlots*sizeof(unsigned int)
+                                     , __FILE__
+                                     , __LINE__
+                                     );
+    unsigned int idxSlot;
+    for(idxSlot=0; idxSlot<pTable->noHashSlots; ++idxSlot)
+        pTable->idxSumByHashAry[idxSlot] = RESULT_EXPR_EMPTY_SLOT;
+
+    for(idxExpr=0; idxExpr<pExprMap->noResExpr; ++idxExpr)
+    {
+        resultExpression_t * const pResExpr = &pExprMap->resExprAry[idxExpr];
+        assert(pResExpr->factoredCoefAry == NULL);
 
-} /* End of createExpressionMap */
+        /* Count the coefficients, the groups of addends of same power of s. */
+        const frq_frqDomExpressionAddend_t *pAddend = pResExpr->pExpr;
+        unsigned int noCoefs = 0;
+        while(!isExpressionAddendNull(pAddend))
+        {
+            unsigned int noAddendsOfCoef = getNoAddendsOfSamePowerOfS(pAddend);
+            while(noAddendsOfCoef-- > 0)
+                pAddend = pAddend->pNext;
+            ++ noCoefs;
+        }
+        if(noCoefs == 0)
+            continue;
 
+        pResExpr->factoredCoefAry = newFactoredTermAry(noCoefs, noConst);
+        pAddend = pResExpr->pExpr;
+        unsigned int idxCoef;
+        for(idxCoef=0; idxCoef<noCoefs; ++idxCoef)
+        {
+            const unsigned int noMonomials = getNoAddendsOfSamePowerOfS(pAddend);
+            factoredTerm_t * const monomialAry = newFactoredTermAry(noMonomials, noConst)
+                         , * const scratchAry = smalloc( noMonomials*sizeof(factoredTerm_t)
+                                                       , __FILE__
+                                                       , __LINE__
+                                                       )
+                         , * const termStack = newFactoredTermAry(2*noMonomials, noConst);
+            unsigned int idxMonomial;
+            for(idxMonomial=0; idxMonomial<noMonomials; ++idxMonomial)
+            {
+                /* Due to expression normalization all powers are positive and all numeric
+                   factors are integers. */
+                assert(pAddend->factor.d == 1);
+                factoredTerm_t * const pMonomial = &monomialAry[idxMonomial];
+                pMonomial->factor = pAddend->factor.n;
+                pMonomial->idxSum = FACTORED_SUM_NONE;
+                memcpy( pMonomial->powerOfConstAry
+                      , pAddend->powerOfConstAry
+                      , noConst*sizeof(signed short)
+                      );
+                pAddend = pAddend->pNext;
+            }
+
+            factoredTerm_t * const pCoef = &pResExpr->factoredCoefAry[idxCoef];
+            if(noMonomials == 1)
+                copyFactoredTerm(pCoef, &monomialAry[0], noConst);
+            else
+            {
+                divideContent(pCoef, monomialAry, noMonomials, noConst);
+                pCoef->idxSum = factorSum( pTable
+                                         , monomialAry
+                                         , scratchAry
+                                         , termStack
+                                         , noMonomials
+                                         );
+                ++ pTable->sumAry[pCoef->idxSum].noReferences;
+            }
 
+            free(monomialAry);
+            free(scratchAry);
+            free(termStack);
 
+        } /* End for(All coefficients of the expression) */
 
-/**
- * Destroy a result expression map after use. Counterpart of \a createExpressionMap.
- *   @param pExprMap
- * Pointer to the object to be destroyed.
- */
+        assert(isExpressionAddendNull(pAddend));
 
-static void deleteExpressionMap(resultExpressionMap_t * const pExprMap)
-{
-    const frq_freqDomainSolution_t * const pSolution = pExprMap->pSolution;
-    const unsigned int noDependents = frq_getNoDependents(pSolution)
-                     , noIndependents = frq_getNoIndependents(pSolution);
+    } /* End for(All expressions of the map) */
 
-    unsigned int idxExpr;
-    for(idxExpr=0; idxExpr<pExprMap->noResExpr; ++idxExpr)
+    /* The shared sums get their names in the order of creation. */
+    pTable->noNames = 0;
+    unsigned int idxSum;
+    for(idxSum=0; idxSum<pTable->noSums; ++idxSum)
     {
-        const resultExpression_t * const pResultExpr = &pExprMap->resExprAry[idxExpr];
-        freeExpression(pResultExpr->pExpr);
+        if(pTable->sumAry[idxSum].noReferences >= 2)
+            pTable->sumAry[idxSum].idxName = ++ pTable->noNames;
     }
+    pExprMap->isFactored = true;
 
-    free(pExprMap->resExprAry);
-    unsignedInt_deleteMatrix(pExprMap->idxNumExprAry, noDependents, noIndependents);
-    unsignedInt_deleteMatrix(pExprMap->idxDenomExprAry, noDependents, noIndependents);
-
-    frq_deleteFreqDomainSolution(pSolution);
-
-    free(pExprMap);
-
-} /* End of deleteExpressionMap */
+    LOG_DEBUG( _log
+             , "factorExpressionMap: %u addends have been factored into %u sums. %u sums"
+               " are shared"
+             , noAddends
+             , pTable->noSums
+             , pTable->noNames
+             )
+} /* End of factorExpressionMap */
 
 
 
@@ -2893,6 +4380,11 @@ static void determineOrderOfRendering( resultExpressionMap_t * const pExprMap
  * The index of the dependent quantity.
  *   @param idxIndependent
  * The index of the independent quantity.
+ *   @param ppFactoredCoefAry
+ * NULL or the pointer to the factored form of the expression is placed in * \a
+ * ppFactoredCoefAry. This is NULL if the map has not been factored, see
+ * factorExpressionMap(). The factored form has the same, normalized sign as the
+ * expression.
  *   @param isNumerator
  * Pass \a true if the numerator expression is requested and \a false if the denominator is
  * requested.
@@ -2902,6 +4394,7 @@ static void getExpression( const resultExpressionMap_t * const pExprMap
                          , const char ** const pName
                          , boolean * const pIsExpressionNegated
                          , const frq_frqDomExpression_t ** const ppExpression
+                         , const factoredTerm_t ** const ppFactoredCoefAry
                          , unsigned int idxDependent
                          , unsigned int idxIndependent
                          , boolean isNumerator
@@ -2941,6 +4434,8 @@ static void getExpression( const resultExpressionMap_t * const pExprMap
        trivial expressions like 1 or 0 it might be more convenient to present them as such
        rather then to reference another location, where it had already appeared. */
     *ppExpression = pExprMap->resExprAry[idxExprInMap].pExpr;
+    if(ppFactoredCoefAry != NULL)
+        *ppFactoredCoefAry = pExprMap->resExprAry[idxExprInMap].factoredCoefAry;
 
 } /* End of getExpression */
 
@@ -2957,9 +4452,14 @@ static void getExpression( const resultExpressionMap_t * const pExprMap
  * of a successful call of frq_freqDomainSolution_t *frq_createFreqDomainSolution(const
  * sol_solution_t * const, unsigned int idxResult).
  *   @param stream
- * The stream (as provided by the stdio lib) to write to.
+ * The buffered output stream to write to.
  *   @param asOctaveCode
  * The solution is printed either in human readable or as Octave script code.
+ *   @param factored
+ * If \a true then the coefficients of the Octave script code are printed in factored
+ * form: Common sums are assigned to intermediate variables and the coefficients are
+ * nested according to Horner's scheme. The human readable comments don't repeat the
+ * expressions in expanded form in this case. Requires \a asOctaveCode.
  *   @param printMargin
  * Line wrapping takes place when the margin is exceeded but the currently printed addend
  * of the expression is still not completed. Checking the margin only after completing an
@@ -2968,11 +4468,14 @@ static void getExpression( const resultExpressionMap_t * const pExprMap
  */
 
 static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
-                            , FILE * const stream
+                            , ost_outputStream_t * const stream
                             , boolean asOctaveCode
+                            , boolean factored
                             , const unsigned int printMargin
                             )
 {
+    assert(asOctaveCode || !factored);
+
     /* Safe error recognition and location requires that the global error flag is reset on
        function entry. */
     assert(!rat_getError());
@@ -2986,13 +4489,34 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
              , * const strFormat = pSolution->idxResult >= 0
                                    ? "%sUser-defined result %s%s:\n"
                                    : "%sResult %s%s in the frequency domain:\n";
-    print(stream, strFormat, tabStringText, frq_getResultName(pSolution), strIsBodePlot);
+    ost_printf( stream
+              , strFormat
+              , tabStringText
+              , frq_getResultName(pSolution)
+              , strIsBodePlot
+              );
 
     const tbv_tableOfVariables_t * const pTabOfVars = pSolution->pTableOfVars;
     const unsigned int noDependents = frq_getNoDependents(pSolution)
                      , noIndependents = frq_getNoIndependents(pSolution);
 
     resultExpressionMap_t * const pExprMap = createExpressionMap(pSolution);
+    if(factored)
+    {
+        factorExpressionMap(pExprMap);
+        if(pExprMap->factoredSumTable.noNames > 0)
+        {
+            ost_printf( stream
+                      , "\n%sCommon sums of numerators and denominators:\n"
+                      , tabStringText
+                      );
+            printNamedSumsAsMCode( stream
+                                 , &pExprMap->factoredSumTable
+                                 , pTabOfVars
+                                 , printMargin
+                                 );
+        }
+    }
 
     /* Figure out in which order to print the results for the dependents so that we safely
        avoid forward references to repeatedly used expressions. */
@@ -3025,15 +4549,15 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
                                          : "%sThe solution for unknown %s%s:"
                                            "\n%s  %s(s) = ";
         if(asOctaveCode)
-            print(stream, "\n");
-        print( stream
-             , titleString
-             , tabStringText
-             , nameDependent
-             , nameIndependent
-             , tabStringText
-             , nameDependent
-             );
+            ost_putString(stream, "\n");
+        ost_printf( stream
+                  , titleString
+                  , tabStringText
+                  , nameDependent
+                  , nameIndependent
+                  , tabStringText
+                  , nameDependent
+                  );
 
         /* In case of a full result the independents are the knowns of the LES. */
         const signed int indentDepth = strlen(tabStringText) + strlen(nameDependent)
@@ -3042,21 +4566,23 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
         for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
         {
             nameIndependent = frq_getNameOfIndependent(pSolution, idxIndependent);
-            print( stream
-                 , "%s%s(s)/%s(s) * %s(s)"
-                 , idxIndependent > 0? "+ ": ""
-                 , getNameOfNumerator(pSolution, idxDependent, idxIndependent)
-                 , getNameOfDenominator(pSolution, idxDependent, idxIndependent)
-                 , nameIndependent
-                 );
+            ost_printf( stream
+                      , "%s%s(s)/%s(s) * %s(s)"
+                      , idxIndependent > 0? "+ ": ""
+                      , getNameOfNumerator(pSolution, idxDependent, idxIndependent)
+                      , getNameOfDenominator(pSolution, idxDependent, idxIndependent)
+                      , nameIndependent
+                      );
 
             /* For more than one independent: Break line after each term. */
             if(idxIndependent+1 < noIndependents)
-                print(stream, "\n%-*s", indentDepth, tabStringText);
+                ost_printf(stream, "\n%-*s", indentDepth, tabStringText);
         }
-        print(stream, ", with\n");
+        ost_putString(stream, factored? "\n": ", with\n");
 
-        for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
+        /* The factored form is meant for large results; repeating the expanded
+           expressions in the comments would spoil its benefit. */
+        for(idxIndependent=0; !factored && idxIndependent<noIndependents; ++idxIndependent)
         {
             /* The human readable output uses the natural order numerator before
                denominator, although this can lead to forward references. These forward
@@ -3071,6 +4597,7 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
                          , &nameOfExpr
                          , &isExpressionNegated
                          , &pExpr
+                         , /* ppFactoredCoefAry */ NULL
                          , idxDependent
                          , idxIndependent
                          , /* isNumerator */ true
@@ -3094,6 +4621,7 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
                          , &nameOfExpr
                          , &isExpressionNegated
                          , &pExpr
+                         , /* ppFactoredCoefAry */ NULL
                          , idxDependent
                          , idxIndependent
                          , /* isNumerator */ false
@@ -3124,10 +4652,12 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
                 const char *nameOfExpr;
                 boolean isExpressionNegated;
                 const frq_frqDomExpression_t *pExpr;
+                const factoredTerm_t *factoredCoefAry;
                 getExpression( pExprMap
                              , &nameOfExpr
                              , &isExpressionNegated
                              , &pExpr
+                             , &factoredCoefAry
                              , idxDependent
                              , idxIndependent
                              , /* isNumerator */ false
@@ -3145,20 +4675,22 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
                                            , isExpressionNegated
                                            , pTabOfVars
                                            , printMargin
+                                           , factoredCoefAry
+                                           , &pExprMap->factoredSumTable
                                            );
 
                 /* Write an error statement if the denominator is null: The Octave
                    functions don't respond with useful error feedback in this case. */
                 if(isExpressionAddendNull(pExpr))
                 {
-                    print( stream
-                         , "error(['Denominator expression %s is null. The transfer"
-                           " function is' ...\n"
-                           "       ' undefined and no plots can be generated. Please"
-                           " check your circuit'] ...\n"
-                           "     );\n"
-                         , LHS
-                         );
+                    ost_printf( stream
+                              , "error(['Denominator expression %s is null. The transfer"
+                                " function is' ...\n"
+                                "       ' undefined and no plots can be generated. Please"
+                                " check your circuit'] ...\n"
+                                "     );\n"
+                              , LHS
+                              );
                 }
             } /* End for(All of the dependent's denominators related to the knowns) */
 
@@ -3169,10 +4701,12 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
                 const char *nameOfExpr;
                 boolean isExpressionNegated;
                 const frq_frqDomExpression_t *pExpr;
+                const factoredTerm_t *factoredCoefAry;
                 getExpression( pExprMap
                              , &nameOfExpr
                              , &isExpressionNegated
                              , &pExpr
+                             , &factoredCoefAry
                              , idxDependent
                              , idxIndependent
                              , /* isNumerator */ true
@@ -3190,6 +4724,8 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
                                            , isExpressionNegated
                                            , pTabOfVars
                                            , printMargin
+                                           , factoredCoefAry
+                                           , &pExprMap->factoredSumTable
                                            );
             } /* End for(All of the dependent's numerators related to the knowns) */
 
@@ -3200,7 +4736,7 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
     /* Free memory of data structures used temporary to order the result terms. */
     deleteExpressionMap(pExprMap);
 
-    fflush(stream);
+    ost_flush(stream);
 
     /* Check global arithmetic error flag. An error message has already been printed to the
        log in case. */
@@ -3214,11 +4750,35 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
 
 
 
+/**
+ * Write a character string into a binary data file. The string is stored as its length
+ * and the characters without terminating zero.
+ *   @param pStream
+ * The output stream of the binary data file.
+ *   @param str
+ * The zero terminated string.
+ */
+
+static void writeBinaryString(ost_outputStream_t * const pStream, const char * const str)
+{
+    const unsigned int len = (unsigned int)strlen(str);
+    ost_putBytes(pStream, &len, sizeof(len));
+    ost_putBytes(pStream, str, len);
+
+} /* End of writeBinaryString */
+
+
+
+
 /**
  * Initialize the module at application startup.
  *   @param hLogger
  * This module will use the passed logger object for all reporting during application life
  * time. It must be a real object, LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT is not permitted.
+ *   @param approximationErrorBound
+ * The relative error bound of the coefficients of the frequency domain expressions in the
+ * range ]0, 1[. Numerically insignificant addends of the coefficients are dropped at the
+ * nominal values of the device constants. Pass null to get the exact expressions.
  *   @remark
  * Do not forget to call the counterpart at application end.
  *   @remark
@@ -3230,18 +4790,20 @@ static boolean printSolution( const frq_freqDomainSolution_t * const pSolution
  *   @see void frq_shutdownModule()
  */
 
-void frq_initModule(log_hLogger_t hLogger)
+void frq_initModule(log_hLogger_t hLogger, double approximationErrorBound)
 {
     assert(hLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+    assert(approximationErrorBound >= 0.0  &&  approximationErrorBound < 1.0);
     _log = log_cloneByReference(hLogger);
+    _approximationErrorBound = approximationErrorBound;
 
-    /* Initialize the global heap of addends. */
-    _hHeapOfAddends = mem_createHeap( _log
-                                    , /* Name */ "Addend of frequency domain expression"
-                                    , sizeof(frq_frqDomExpressionAddend_t)
-                                    , /* initialHeapSize */     100
-                                    , /* allocationBlockSize */ 500
-                                    );
+    /* Initialize the global heap of addends. The heaps for other sizes of addends are
+       created on demand. */
+    unsigned int idxHeap;
+    for(idxHeap=0; idxHeap<FRQ_NO_SIZE_CLASSES; ++idxHeap)
+        _hHeapOfAddendsAry[idxHeap] = MEM_HANDLE_INVALID_HEAP;
+    _hHeapOfAddends = MEM_HANDLE_INVALID_HEAP;
+    _noPowersOfConstOfAddend = 0;
 #ifdef DEBUG
    frq_frqDomExpressionAddend_t dummyObj;
    assert((char*)&dummyObj.pNext == (char*)&dummyObj + MEM_OFFSET_OF_LINK_POINTER
@@ -3252,7 +4814,9 @@ void frq_initModule(log_hLogger_t hLogger)
     /* The DEBUG compilation counts all references to all created objects. */
     _noRefsToSolutionObjects = 0;
     _noRefsToExprObjects = 0;
+    _noRefsToCacheObjects = 0;
 #endif
+    selectNoConstants(/* noConstants */ 0);
 #ifdef  DEBUG
     /* Check if patch of snprintf is either not required or properly installed. */
     char buf[3] = {[2] = '\0'};
@@ -3292,16 +4856,33 @@ void frq_shutdownModule()
                , _noRefsToExprObjects
                );
     }
+    if(_noRefsToCacheObjects != 0)
+    {
+        fprintf( stderr
+               , "frq_shutdownModule: %u objects of type frq_expressionCache_t have not"
+                 " been deleted at application shutdown. There are probable memory leaks\n"
+               , _noRefsToCacheObjects
+               );
+    }
 #endif
 
     /* The DEBUG compilation looks for still allocated objects in order to detect memory
        leaks. */
+    unsigned int idxHeap;
+    for(idxHeap=0; idxHeap<FRQ_NO_SIZE_CLASSES; ++idxHeap)
+    {
+        if(_hHeapOfAddendsAry[idxHeap] != MEM_HANDLE_INVALID_HEAP)
+        {
 #ifdef DEBUG
-    mem_deleteHeap(_hHeapOfAddends, /* warnIfUnfreedMem */ true);
+            mem_deleteHeap(_hHeapOfAddendsAry[idxHeap], /* warnIfUnfreedMem */ true);
 #else
-    mem_deleteHeap(_hHeapOfAddends, /* warnIfUnfreedMem */ false);
+            mem_deleteHeap(_hHeapOfAddendsAry[idxHeap], /* warnIfUnfreedMem */ false);
 #endif
+            _hHeapOfAddendsAry[idxHeap] = MEM_HANDLE_INVALID_HEAP;
+        }
+    }
     _hHeapOfAddends = MEM_HANDLE_INVALID_HEAP;
+    _noPowersOfConstOfAddend = 0;
 
     /* Discard reference to the logger object. */
     log_deleteLogger(_log);
@@ -3312,6 +4893,85 @@ void frq_shutdownModule()
 
 
 
+/**
+ * Create an empty cache for the frequency domain expressions, which are derived from an
+ * algebraic solution. The cache is passed to all calls of boolean
+ * frq_createFreqDomainSolution(const frq_freqDomainSolution_t * * const, const
+ * sol_solution_t * const, signed int, frq_expressionCache_t * const), which refer to the
+ * same algebraic solution. Each numerator and the determinant of the algebraic solution is
+ * then transformed only once, regardless of how many results make use of it. The solution
+ * objects share the cached expressions by reference.
+ *   @return
+ * Get the pointer to the new cache object. It needs to be deleted with void
+ * frq_deleteExpressionCache(frq_expressionCache_t * const) after use, at latest before
+ * the next circuit is processed.
+ *   @param pAlgebraicSolution
+ * The algebraic solution. The cache holds a reference to it.
+ */
+
+frq_expressionCache_t *frq_createExpressionCache
+                                    (const sol_solution_t * const pAlgebraicSolution)
+{
+    /* The cached expressions live in the heap of addends which fits to the circuit. */
+    selectNoConstants(pAlgebraicSolution->pTableOfVars->noConstants);
+
+    const unsigned int noDependents = sol_getNoDependents(pAlgebraicSolution)
+                     , noIndependents = sol_getNoIndependents(pAlgebraicSolution);
+    frq_expressionCache_t * const pCache = smalloc( sizeof(frq_expressionCache_t)
+                                                  , __FILE__
+                                                  , __LINE__
+                                                  );
+    pCache->pAlgebraicSolution = sol_cloneByConstReference(pAlgebraicSolution);
+    pCache->pDenominator = normalizedExpressionNull();
+    pCache->isDenominatorAvailable = false;
+    pCache->numeratorAry = normalizedFrqDomExpression_createMatrix( noDependents
+                                                                  , noIndependents
+                                                                  );
+    pCache->isNumeratorAvailableAry = boolean_createMatrix(noDependents, noIndependents);
+
+#ifdef DEBUG
+    ++ _noRefsToCacheObjects;
+#endif
+    return pCache;
+
+} /* End of frq_createExpressionCache */
+
+
+
+
+/**
+ * Delete a cache of frequency domain expressions after use. The references to the cached
+ * expressions are discarded; solution objects, which share some of the expressions, stay
+ * valid.
+ *   @param pCache
+ * The cache object to delete. No action if this is the NULL pointer.
+ */
+
+void frq_deleteExpressionCache(frq_expressionCache_t * const pCache)
+{
+    if(pCache == NULL)
+        return;
+
+    const unsigned int noDependents = sol_getNoDependents(pCache->pAlgebraicSolution)
+                     , noIndependents = sol_getNoIndependents(pCache->pAlgebraicSolution);
+    normalizedFrqDomExpression_deleteMatrix( pCache->numeratorAry
+                                           , noDependents
+                                           , noIndependents
+                                           );
+    boolean_deleteMatrix(pCache->isNumeratorAvailableAry, noDependents, noIndependents);
+    freeNormalizedExpression(pCache->pDenominator);
+    sol_deleteSolution(pCache->pAlgebraicSolution);
+    free(pCache);
+
+#ifdef DEBUG
+    assert(_noRefsToCacheObjects > 0);
+    -- _noRefsToCacheObjects;
+#endif
+} /* End of frq_deleteExpressionCache */
+
+
+
+
 /**
  * Create an object that a user defined result. The user defined result is a set of complex
  * expressions, that describe the solution for a sub-set of unknowns of the LES and/or
@@ -3332,12 +4992,19 @@ void frq_shutdownModule()
  * The index of the user defined result, the solution is requested for. If a negative value
  * is passed then a full result for all unknowns of the LES and all user defined voltages
  * is returned.
+ *   @param pCache
+ * The numerators and the denominator of the solution are taken from this cache if they
+ * have already been transformed for another result of the same algebraic solution. Newly
+ * transformed expressions are added to the cache. See frq_expressionCache_t
+ * *frq_createExpressionCache(const sol_solution_t * const).\n
+ *   NULL may be passed if the solution is created without a cache.
  *   @see void frq_deleteFreqDomainSolution(frq_freqDomainSolution_t * const)
  */
 
 boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const ppFrqDomSolution
                                     , const sol_solution_t * const pAlgebraicSolution
                                     , signed int idxResult
+                                    , frq_expressionCache_t * const pCache
                                     )
 {
     assert(_log != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
@@ -3347,6 +5014,10 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
     boolean success = !rat_getError();
     assert(success);
 
+    /* The size of the addends of all expressions depends on the number of constants of the
+       circuit. */
+    selectNoConstants(pAlgebraicSolution->pTableOfVars->noConstants);
+
     frq_freqDomainSolution_t *pRes = smalloc( sizeof(frq_freqDomainSolution_t)
                                             , __FILE__
                                             , __LINE__
@@ -3430,10 +5101,12 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
                demanded, which depends on all knows of the system. */
             if(pResultDef->independentName == NULL)
             {
-                success = transformExpression( &pRes->pDenominator
-                                             , pAlgebraicSolution->pDeterminant
-                                             , pTableOfVars
-                                             );
+                success = getTransformedExpression( &pRes->pDenominator
+                                                  , pCache
+                                                  , pAlgebraicSolution
+                                                  , /* idxDependent */ -1
+                                                  , /* idxIndependent */ 0
+                                                  );
 
                 /* Loop over the set of dependents of this frq solution. */
                 unsigned int idxDependent;
@@ -3466,11 +5139,12 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
                         for(idxKnown=0; success && idxKnown<noIndependents; ++idxKnown)
                         {
                             /* Transform the numerator of the result term. */
-                            success = transformExpression
+                            success = getTransformedExpression
                                                 ( &pRes->numeratorAry[idxDependent][idxKnown]
+                                                , pCache
                                                 , pAlgebraicSolution
-                                                  ->numeratorAry[idxSolution][idxKnown]
-                                                , pTableOfVars
+                                                , idxSolution
+                                                , idxKnown
                                                 );
                         } /* End for(All terms of the solution for a single unknown) */
                     }
@@ -3528,8 +5202,13 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
                                           , /* doErrorReporting */ true
                                           ) == 1;
 
-                /* Figure out, which situation we have. */
-                const coe_coef_t *pAlgebraicNum, *pAlgebraicDenom;
+                /* Figure out, which situation we have. Numerator and denominator are
+                   addressed to by a pair of indexes into the algebraic solution; a
+                   dependent index of -1 designates the system determinant. */
+                signed int idxSolutionNum = -1
+                         , idxSolutionDenom = -1;
+                unsigned int idxKnownNum = 0
+                           , idxKnownDenom = 0;
 
                 if(success)
                 {
@@ -3541,22 +5220,18 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
                         assert(pAlgebraicSolution
                                ->pIsDependentAvailableAry[idxSolutionDependent]
                               );
-                        pAlgebraicNum =
-                                    pAlgebraicSolution
-                                    ->numeratorAry[idxSolutionDependent][idxKnownIndependent];
-                        pAlgebraicDenom = pAlgebraicSolution->pDeterminant;
+                        idxSolutionNum = idxSolutionDependent;
+                        idxKnownNum = (unsigned)idxKnownIndependent;
                     }
                     else if(idxKnownDependent >= 0  &&  idxSolutionIndependent >= 0)
                     {
                         /* The inverse situation: A system input is plotted as function of
                            an actual system output. We have the inverse transfer function. */
-                        pAlgebraicNum = pAlgebraicSolution->pDeterminant;
                         assert(pAlgebraicSolution
                                ->pIsDependentAvailableAry[idxSolutionIndependent]
                               );
-                        pAlgebraicDenom =
-                                    pAlgebraicSolution
-                                    ->numeratorAry[idxSolutionIndependent][idxKnownDependent];
+                        idxSolutionDenom = idxSolutionIndependent;
+                        idxKnownDenom = (unsigned)idxKnownDependent;
                     }
                     else if(idxSolutionDependent >= 0  &&  idxSolutionIndependent >= 0)
                     {
@@ -3570,10 +5245,8 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
                                    && pAlgebraicSolution
                                       ->pIsDependentAvailableAry[idxSolutionIndependent]
                                   );
-                            pAlgebraicNum = pAlgebraicSolution
-                                            ->numeratorAry[idxSolutionDependent][0];
-                            pAlgebraicDenom = pAlgebraicSolution
-                                              ->numeratorAry[idxSolutionIndependent][0];
+                            idxSolutionNum = idxSolutionDependent;
+                            idxSolutionDenom = idxSolutionIndependent;
                         }
                         else
                         {
@@ -3619,14 +5292,18 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
 
                 if(success)
                 {
-                    success = transformExpression( &pRes->pDenominator
-                                                 , pAlgebraicDenom
-                                                 , pTableOfVars
-                                                 )
-                              && transformExpression( &pRes->numeratorAry[0][0]
-                                                    , pAlgebraicNum
-                                                    , pTableOfVars
-                                                    );
+                    success = getTransformedExpression( &pRes->pDenominator
+                                                      , pCache
+                                                      , pAlgebraicSolution
+                                                      , idxSolutionDenom
+                                                      , idxKnownDenom
+                                                      )
+                              && getTransformedExpression( &pRes->numeratorAry[0][0]
+                                                         , pCache
+                                                         , pAlgebraicSolution
+                                                         , idxSolutionNum
+                                                         , idxKnownNum
+                                                         );
                 }
             } /* End if(Full result term or a dependency one on one?) */
         }
@@ -3636,10 +5313,12 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
                the unknowns of the LES plus the user-defined voltages. */
             assert(noDependents == sol_getNoDependents(pAlgebraicSolution));
 
-            success = transformExpression( &pRes->pDenominator
-                                         , pAlgebraicSolution->pDeterminant
-                                         , pTableOfVars
-                                         );
+            success = getTransformedExpression( &pRes->pDenominator
+                                              , pCache
+                                              , pAlgebraicSolution
+                                              , /* idxDependent */ -1
+                                              , /* idxIndependent */ 0
+                                              );
 
             /* Loop over all dependents, here all dependents of both, the algebraic
                solution and the frq object. */
@@ -3652,11 +5331,13 @@ boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const p
                 {
                     /* Transform the numerator of the result term. */
                     assert(pAlgebraicSolution->pIsDependentAvailableAry[idxDependent]);
-                    success = transformExpression( &pRes->numeratorAry[idxDependent][idxKnown]
-                                                 , pAlgebraicSolution
-                                                   ->numeratorAry[idxDependent][idxKnown]
-                                                 , pTableOfVars
-                                                 );
+                    success = getTransformedExpression
+                                                ( &pRes->numeratorAry[idxDependent][idxKnown]
+                                                , pCache
+                                                , pAlgebraicSolution
+                                                , (signed)idxDependent
+                                                , idxKnown
+                                                );
                 } /* End for(All terms of the solution of one dependent of the frq object) */
 
             } /* End for(All unknowns) */
@@ -4010,12 +5691,18 @@ void frq_logFreqDomainSolution( const frq_freqDomainSolution_t * const pSolution
     {
         if(hStream[idxStream] != NULL)
         {
-            if(!printSolution( pSolution
-                             , hStream[idxStream]
-                             , /* asOctaveCode */ false
-                             , /* printMargin */ 72
-                             )
-              )
+            /* The many small fragments of text are collected in a buffer before they are
+               passed to the stdio stream. */
+            ost_outputStream_t outputStream;
+            ost_initOutputStream(&outputStream, hStream[idxStream]);
+            const boolean success = printSolution( pSolution
+                                                 , &outputStream
+                                                 , /* asOctaveCode */ false
+                                                 , /* factored */ false
+                                                 , /* printMargin */ 72
+                                                 );
+            ost_closeOutputStream(&outputStream);
+            if(!success)
             {
                 LOG_ERROR( _log
                          , "An arithmic overflow occured during rendering of the solution."
@@ -4025,7 +5712,7 @@ void frq_logFreqDomainSolution( const frq_freqDomainSolution_t * const pSolution
         }
     } /* End for(All possible open logging streams) */
 
-    log_flush(hLog);
+    log_releaseStreams(hLog);
 
 } /* End of frq_logFreqDomainSolution */
 
@@ -4045,10 +5732,23 @@ void frq_logFreqDomainSolution( const frq_freqDomainSolution_t * const pSolution
  * The pointer to an M script object. The generated M code is written into this M script.
  * The object is the result of a successful call of boolean msc_createMScript(msc_mScript_t
  * ** const, const char * const, const char * const, const char * const).
+ *   @param useBinaryData
+ * If \a true then the generated M code doesn't contain the numerator and denominator
+ * expressions. They are read from the binary data file instead, which has the name of the
+ * M script with extension .lnb instead of .m and which is written by
+ * frq_exportAsBinaryData.
+ *   @param factored
+ * If \a true then the numerator and denominator expressions are written in factored
+ * form: Sums, which are common to several coefficients, are assigned to intermediate
+ * variables and the coefficients are nested according to Horner's scheme. This reduces
+ * size and evaluation cost of the M code of large results. Ignored if \a useBinaryData
+ * is \a true.
  */
 
 boolean frq_exportAsMCode( const frq_freqDomainSolution_t * const pSolution
                          , msc_mScript_t * const pMScript
+                         , boolean useBinaryData
+                         , boolean factored
                          )
 {
     assert(pSolution != FRQ_NULL_SOLUTION);
@@ -4065,22 +5765,42 @@ boolean frq_exportAsMCode( const frq_freqDomainSolution_t * const pSolution
        done such that interaction with the embedding M code is possible without a change of
        the generated script. */
     /* Write into the stream associated with the M script object. */
-    FILE *stream = msc_borrowStream(pMScript);
-    print(stream, "error(nargchk(0, 1, nargin))\nif nargin == 1\n");
+    ost_outputStream_t *stream = msc_borrowStream(pMScript);
+    ost_putString(stream, "error(nargchk(0, 1, nargin))\nif nargin == 1\n");
     msc_releaseStream(pMScript);
     tbv_exportAsMCode(pTableOfVars, pMScript, tbv_assignParameterStruct, "    ");
     stream = msc_borrowStream(pMScript);
-    print(stream, "else\n");
+    ost_putString(stream, "else\n");
     msc_releaseStream(pMScript);
     tbv_exportAsMCode(pTableOfVars, pMScript, tbv_assignDefaultValues,   "    ");
     stream = msc_borrowStream(pMScript);
-    print(stream, "end\nerror(nargchk(0, 4, nargout))\nif nargout >= 2\n");
-    msc_releaseStream(pMScript);
-    tbv_exportAsMCode(pTableOfVars, pMScript, tbv_copyToParameterStruct, "    ");
-    stream = msc_borrowStream(pMScript);
-    print(stream, "end\n\n");
+    if(useBinaryData)
+    {
+        /* The loader of the binary data file needs the values of the device constants as
+           struct. The struct is shaped unconditionally. */
+        ost_putString(stream, "end\nerror(nargchk(0, 4, nargout))\n");
+        msc_releaseStream(pMScript);
+        tbv_exportAsMCode(pTableOfVars, pMScript, tbv_copyToParameterStruct, "");
+        stream = msc_borrowStream(pMScript);
+        ost_putString(stream, "\n");
+    }
+    else
+    {
+        ost_putString(stream, "end\nerror(nargchk(0, 4, nargout))\nif nargout >= 2\n");
+        msc_releaseStream(pMScript);
+        tbv_exportAsMCode(pTableOfVars, pMScript, tbv_copyToParameterStruct, "    ");
+        stream = msc_borrowStream(pMScript);
+        ost_putString(stream, "end\n\n");
+    }
 
-    if(!printSolution(pSolution, stream, /* asOctaveCode */ true, /* printMargin */ 72))
+    if(!useBinaryData
+       &&  !printSolution( pSolution
+                         , stream
+                         , /* asOctaveCode */ true
+                         , factored
+                         , /* printMargin */ 72
+                         )
+      )
     {
         success = false;
         LOG_ERROR( _log
@@ -4089,61 +5809,82 @@ boolean frq_exportAsMCode( const frq_freqDomainSolution_t * const pSolution
                    " and should be discarded"
                  , getFileName(pMScript)
                  )
-        print(stream, "\nerror('Invalid script: Errors occured during script generation')\n");
+        ost_putString(stream, "\nerror('Invalid script: Errors occured during script generation')\n");
     }
 
     /* Let Octave create the LTI system object. First we create a descriptor object. */
-    print( stream
-         , "\n%% Create an Octave LTI system object from the data above. First shape a"
-           " descriptor object.\n"
-         );
-    print(stream, "systemDesc_%s.name = '%s';\n", systemName, systemName);
+    ost_printf( stream
+              , "\n%% Create an Octave LTI system object from the data above. First shape a"
+                " descriptor object.\n"
+              );
+    ost_printf(stream, "systemDesc_%s.name = '%s';\n", systemName, systemName);
 
-    /* Print the cell array of numerators like
-         systemDesc_myResult.numeratorAry = ...
-             { N_U_out_U1 N_U_out_U2
-               N_U_K_L_U1 N_U_K_L_U2
-             }; */
-    print(stream, "systemDesc_%s.numeratorAry = ...\n    {", systemName);
     unsigned int idxDependent,  idxIndependent;
-    for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
+    if(useBinaryData)
     {
-        for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
-            print(stream, " %s", getNameOfNumerator(pSolution, idxDependent, idxIndependent));
-
-        /* A new line (for the next dependent) differs after writing the last dependent; we
-           need to close the brace expression (i.e. the cell array). */
-        if(idxDependent+1 < noDependents)
-            print(stream, "\n     ");
-        else
-            print(stream, "\n    ");
+        /* The cell arrays of numerators and denominators are computed by the loader of
+           the binary data file. */
+        ost_printf( stream
+                  , "[systemDesc_%s.numeratorAry systemDesc_%s.denominatorAry] = ...\n"
+                    "    loadBinaryResult( [mfilename('fullpath') '.lnb'] ...\n"
+                    "                    , deviceConstants ...\n"
+                    "                    );\n"
+                  , systemName
+                  , systemName
+                  );
     }
-    print(stream, "};\n");
-
-    /* Print the cell array of denominators like
-         systemDesc_myResult.denominatorAry = ...
-             { D_U_out_U1 D_U_out_U2
-               D_U_K_L_U1 D_U_K_L_U2
-             }; */
-    print(stream, "systemDesc_%s.denominatorAry = ...\n    {", systemName);
-    for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
+    else
     {
-        for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
+        /* Print the cell array of numerators like
+             systemDesc_myResult.numeratorAry = ...
+                 { N_U_out_U1 N_U_out_U2
+                   N_U_K_L_U1 N_U_K_L_U2
+                 }; */
+        ost_printf(stream, "systemDesc_%s.numeratorAry = ...\n    {", systemName);
+        for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
         {
-            print( stream
-                 , " %s"
-                 , getNameOfDenominator(pSolution, idxDependent, idxIndependent)
-                 );
+            for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
+            {
+                ost_printf( stream
+                          , " %s"
+                          , getNameOfNumerator(pSolution, idxDependent, idxIndependent)
+                          );
+            }
+
+            /* A new line (for the next dependent) differs after writing the last dependent;
+               we need to close the brace expression (i.e. the cell array). */
+            if(idxDependent+1 < noDependents)
+                ost_putString(stream, "\n     ");
+            else
+                ost_putString(stream, "\n    ");
         }
+        ost_putString(stream, "};\n");
+
+        /* Print the cell array of denominators like
+             systemDesc_myResult.denominatorAry = ...
+                 { D_U_out_U1 D_U_out_U2
+                   D_U_K_L_U1 D_U_K_L_U2
+                 }; */
+        ost_printf(stream, "systemDesc_%s.denominatorAry = ...\n    {", systemName);
+        for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
+        {
+            for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
+            {
+                ost_printf( stream
+                          , " %s"
+                          , getNameOfDenominator(pSolution, idxDependent, idxIndependent)
+                          );
+            }
 
-        /* A new line (for the next dependent) differs after writing the last dependent; we
-           need to close the brace expression (i.e. the cell array). */
-        if(idxDependent+1 < noDependents)
-            print(stream, "\n     ");
-        else
-            print(stream, "\n    ");
-    }
-    print(stream, "};\n");
+            /* A new line (for the next dependent) differs after writing the last dependent;
+               we need to close the brace expression (i.e. the cell array). */
+            if(idxDependent+1 < noDependents)
+                ost_putString(stream, "\n     ");
+            else
+                ost_putString(stream, "\n    ");
+        }
+        ost_putString(stream, "};\n");
+    } /* End if(Numerators and denominators are read from binary data file?) */
 
     /* Put the list of names of system inputs into the descriptor object. These are the
        independents. The ouput looks like:
@@ -4151,34 +5892,34 @@ boolean frq_exportAsMCode( const frq_freqDomainSolution_t * const pSolution
              { 'U1'
                'U2'
              }; */
-    print(stream, "systemDesc_%s.inputNameAry = ...\n    {", systemName);
+    ost_printf(stream, "systemDesc_%s.inputNameAry = ...\n    {", systemName);
     for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
     {
-        print(stream, " '%s'", frq_getNameOfIndependent(pSolution, idxIndependent));
+        ost_printf(stream, " '%s'", frq_getNameOfIndependent(pSolution, idxIndependent));
 
         /* A new line (for the next name) differs after writing the last name; we
            need to close the brace expression (i.e. the cell array). */
         if(idxIndependent+1 < noIndependents)
-            print(stream, "\n     ");
+            ost_putString(stream, "\n     ");
         else
-            print(stream, "\n    ");
+            ost_putString(stream, "\n    ");
     }
-    print(stream, "};\n");
+    ost_putString(stream, "};\n");
 
     /* Now we need a similar list of names for the system output, which are our dependents. */
-    print(stream, "systemDesc_%s.outputNameAry = ...\n    {", systemName);
+    ost_printf(stream, "systemDesc_%s.outputNameAry = ...\n    {", systemName);
     for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
     {
-        print(stream, " '%s'", frq_getNameOfDependent(pSolution, idxDependent));
+        ost_printf(stream, " '%s'", frq_getNameOfDependent(pSolution, idxDependent));
 
         /* A new line (for the next name) differs after writing the last name; we
            need to close the brace expression (i.e. the cell array). */
         if(idxDependent+1 < noDependents)
-            print(stream, "\n     ");
+            ost_putString(stream, "\n     ");
         else
-            print(stream, "\n    ");
+            ost_putString(stream, "\n    ");
     }
-    print(stream, "};\n");
+    ost_putString(stream, "};\n");
 
     /* Render the associated plot information object as Octave script code. */
     const pci_plotInfo_t *pPlotInfo;
@@ -4193,111 +5934,114 @@ boolean frq_exportAsMCode( const frq_freqDomainSolution_t * const pSolution
     }
     else
         pPlotInfo = NULL;
-    print(stream, "systemDesc_%s.plotInfo = ...\n", systemName);
+    ost_printf(stream, "systemDesc_%s.plotInfo = ...\n", systemName);
     msc_releaseStream(pMScript);
     pci_exportPlotInfoAsMCode(pMScript, pPlotInfo, /* indentStr */ "    ");
     stream = msc_borrowStream(pMScript);
-    print(stream, ";\n\n");
+    ost_putString(stream, ";\n\n");
 
 #if 0 // No longer used for an M code function file.
 
     /* Remove the no longer used expressions from the (global) workspace, like
          clear N_U_out_U1 N_U_out_U2 D_U_out_U1 D_U_out_U2 */
-    print( stream
-         , "%% Delete no longer used temporary expressions. They should not spoil"
-           " the global workspace.\n"
-           "clear"
-         );
+    ost_printf( stream
+              , "%% Delete no longer used temporary expressions. They should not spoil"
+                " the global workspace.\n"
+                "clear"
+              );
     unsigned int noPairsSoFar = 0;
     for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
     {
         for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
         {
             ++ noPairsSoFar;
-            print( stream
-                 , " %s %s"
-                 , getNameOfNumerator(pSolution, idxDependent, idxIndependent)
-                 , getNameOfDenominator(pSolution, idxDependent, idxIndependent)
-                 );
+            ost_printf( stream
+                      , " %s %s"
+                      , getNameOfNumerator(pSolution, idxDependent, idxIndependent)
+                      , getNameOfDenominator(pSolution, idxDependent, idxIndependent)
+                      );
         }
 
         /* Break line after some output. */
         if(noPairsSoFar % 2 == 0  &&  noPairsSoFar < noDependents*noIndependents)
-            print(stream, " ...\n     "); /* strlen("clear") */
+            ost_putString(stream, " ...\n     "); /* strlen("clear") */
     }
-    print(stream, "\n\n");
+    ost_putString(stream, "\n\n");
 #endif
 
     /* Make Octave create the actual LTI system object by calling a creator function with
        the descriptor object shaped just before. */
-    print(stream, "%% Create the Octave LTI system object from the descriptor.\n");
-    print(stream, "tf_%s = createLtiSystem(systemDesc_%s);\n\n", systemName, systemName);
+    ost_putString(stream, "% Create the Octave LTI system object from the descriptor.\n");
+    ost_printf( stream
+              , "tf_%s = createLtiSystem(systemDesc_%s);\n\n"
+              , systemName
+              , systemName
+              );
 
     /* Offer to produce a returned vector of frequency and time points. These series are
        made according to the plotInfo object in the circuit file. They can be passed to the
        member function of the Octave's transfer function class, like bode or step. */
-    print( stream
-         , "%% Compute a suitable vector of frequency and time points.\n"
-           "wBode  = getFrequencyVector(systemDesc_%s);\n"
-           "tiStep = getSampleTimeVector(systemDesc_%s);\n\n"
-         , systemName
-         , systemName
-         );
+    ost_printf( stream
+              , "%% Compute a suitable vector of frequency and time points.\n"
+                "wBode  = getFrequencyVector(systemDesc_%s);\n"
+                "tiStep = getSampleTimeVector(systemDesc_%s);\n\n"
+              , systemName
+              , systemName
+              );
 
     /* Let the script execute the most common operation with the LTI object. This is done
        in an if: If the function arguments are consumed by the (user owned and designed)
        embedding code then the function keeps silent and and only returns the transfer
        function object and the realted things for further, whatever use. */
-    print(stream, "if nargout == 0\n");
+    ost_putString(stream, "if nargout == 0\n");
     if(frq_getIsBodePlot(pSolution))
     {
-        print(stream, "    %% Plot the transfer function of %s.\n", systemName);
-        print( stream
-             , "    figure\n"
-               "    bode(tf_%s, wBode)\n"
-             , systemName
-             );
+        ost_printf(stream, "    %% Plot the transfer function of %s.\n", systemName);
+        ost_printf( stream
+                  , "    figure\n"
+                    "    bode(tf_%s, wBode)\n"
+                  , systemName
+                  );
     }
     else
     {
         /* Octave refuses to print a Bode plot for MIMO systems. We print the step response
            as initial plot. */
-        print(stream, "    %% Plot the step response of %s.\n", systemName);
-        print( stream
-             , "    figure\n"
-               "    step(tf_%s, tiStep)\n"
-             , systemName
-             );
+        ost_printf(stream, "    %% Plot the step response of %s.\n", systemName);
+        ost_printf( stream
+                  , "    figure\n"
+                    "    step(tf_%s, tiStep)\n"
+                  , systemName
+                  );
     }
 
     /* Let the script give some feedback to the user what happened and what he can do now. */
 #define NL  " char(10) ...\n"
 #define IND "          "
-    print( stream
-         , "    disp(["
-           "'This function can create the LTI system object tf_%s for you; please, type'" NL
-           IND "'help %s for more.'" NL
-           IND "'  You can use this object with functions like bode to plot the transfer function'" NL
-           IND "'or step and impulse to plot the step or impulse response time functions or lsim'" NL
-           IND "'to compute or plot the system response to arbitrary input signals. A stability'" NL
-           IND "'analysis can be done using function nyquist. Please refer to the online help'" NL
-           IND "'for these commands' char(10)] ...\n" 
-           "        );\n"
-         , systemName
-         , systemName
-         );
+    ost_printf( stream
+              , "    disp(["
+                "'This function can create the LTI system object tf_%s for you; please, type'" NL
+                IND "'help %s for more.'" NL
+                IND "'  You can use this object with functions like bode to plot the transfer function'" NL
+                IND "'or step and impulse to plot the step or impulse response time functions or lsim'" NL
+                IND "'to compute or plot the system response to arbitrary input signals. A stability'" NL
+                IND "'analysis can be done using function nyquist. Please refer to the online help'" NL
+                IND "'for these commands' char(10)] ...\n" 
+                "        );\n"
+              , systemName
+              , systemName
+              );
 #undef NL
 #undef IND
 
     /* We are still in the if clause: no function results are consumed. Better to clear all
        output arguments; otherwise the user is enforced to use the line-closing semicolon
        when calling the function. */
-    print( stream
-         , "    clear tf_%s tiStep wBode\n"
-           "end\n"
-         , systemName
-         );
-    fflush(stream);
+    ost_printf( stream
+              , "    clear tf_%s tiStep wBode\n"
+                "end\n"
+              , systemName
+              );
 
     msc_releaseStream(pMScript);
 
@@ -4308,3 +6052,252 @@ boolean frq_exportAsMCode( const frq_freqDomainSolution_t * const pSolution
 
 
 
+/**
+ * Export the frequency domain solution as binary data file. The file holds the same
+ * numerators and denominators as the M code generated by frq_exportAsMCode but Octave
+ * reads it much faster than the large literal expressions of the M code. The Octave
+ * script loadBinaryResult reads the file and computes the coefficient vectors of all
+ * transfer functions for given values of the device constants.\n
+ *   The numbers are stored in the byte order of the writing machine; unsigned and signed
+ * integers have 32 Bit, the numeric factors of the addends 64 Bit. A string is stored as
+ * its length and the characters without terminating zero. The file consists of:\n
+ *   - the magic number #BINARY_FILE_MAGIC, the version #BINARY_FILE_VERSION and the
+ * numbers of device constants, dependents, independents, expressions, addends and factors
+ *   - the names of the result, the device constants, the dependents and the independents
+ *   - the nominal values of the device constants as double
+ *   - the index of the first addend of each expression and the total number of addends
+ *   - the power of s of all addends
+ *   - the numerators and the denominators of the numeric factors of all addends
+ *   - the index of the first factor of each addend and the total number of factors
+ *   - the index of the device constant and the power of all factors
+ *   - the indexes of the numerator and the denominator expressions of all transfer
+ * functions, dependent by dependent. The most significant bit of an index is set if the
+ * expression needs to be negated
+ *   @return
+ * \a true if the file has been written, \a false otherwise. An error message has been
+ * written to the log if \a false is returned.
+ *   @param pSolution
+ * The pointer to the object representing the solution to be exported. The object is the
+ * result of a successful call of frq_freqDomainSolution_t
+ * *frq_createFreqDomainSolution(const sol_solution_t * const, unsigned int idxResult).
+ *   @param fileName
+ * The name of the binary data file. An existing file is overwritten.
+ */
+
+boolean frq_exportAsBinaryData( const frq_freqDomainSolution_t * const pSolution
+                              , const char * const fileName
+                              )
+{
+    assert(pSolution != FRQ_NULL_SOLUTION);
+    assert(sizeof(unsigned int) == 4  &&  sizeof(signed long long) == 8);
+
+    /* Safe error recognition and location requires that the global error flag is reset on
+       function entry. */
+    assert(!rat_getError());
+
+    FILE * const hFile = fopen(fileName, "wb");
+    if(hFile == NULL)
+    {
+        LOG_ERROR(_log, "Can't open binary data file %s for writing", fileName)
+        return false;
+    }
+
+    const tbv_tableOfVariables_t * const pTableOfVars = pSolution->pTableOfVars;
+    const unsigned int noConst = pTableOfVars->noConstants
+                     , noDependents = frq_getNoDependents(pSolution)
+                     , noIndependents = frq_getNoIndependents(pSolution);
+
+    /* The exported expressions are the cancelled and shared expressions, which are
+       rendered as M code, too. */
+    resultExpressionMap_t * const pExprMap = createExpressionMap(pSolution);
+
+    unsigned int noAddends = 0
+               , noFactors = 0
+               , idxExpr
+               , idxConst;
+    const frq_frqDomExpressionAddend_t *pAddend;
+    for(idxExpr=0; idxExpr<pExprMap->noResExpr; ++idxExpr)
+    {
+        for( pAddend=pExprMap->resExprAry[idxExpr].pExpr
+           ; !isExpressionAddendNull(pAddend)
+           ; pAddend=pAddend->pNext
+           )
+        {
+            ++ noAddends;
+            for(idxConst=0; idxConst<noConst; ++idxConst)
+            {
+                if(pAddend->powerOfConstAry[idxConst] != 0)
+                    ++ noFactors;
+            }
+        }
+    }
+
+    /* The addends and factors are collected in one array per field. The loader reads each
+       array with a single operation. */
+    unsigned int * const idxFirstAddendAry = smalloc( (pExprMap->noResExpr+1)
+                                                      * sizeof(unsigned int)
+                                                    , __FILE__
+                                                    , __LINE__
+                                                    )
+               , * const idxFirstFactorAry = smalloc( (noAddends+1)*sizeof(unsigned int)
+                                                    , __FILE__
+                                                    , __LINE__
+                                                    )
+               , * const idxConstAry = smalloc( (noFactors+1)*sizeof(unsigned int)
+                                              , __FILE__
+                                              , __LINE__
+                                              );
+    signed int * const powerOfSAry = smalloc( (noAddends+1)*sizeof(signed int)
+                                            , __FILE__
+                                            , __LINE__
+                                            )
+               , * const powerAry = smalloc( (noFactors+1)*sizeof(signed int)
+                                           , __FILE__
+                                           , __LINE__
+                                           );
+    signed long long * const numeratorAry = smalloc( (noAddends+1)*sizeof(signed long long)
+                                                   , __FILE__
+                                                   , __LINE__
+                                                   )
+                     , * const denominatorAry = smalloc( (noAddends+1)
+                                                         * sizeof(signed long long)
+                                                       , __FILE__
+                                                       , __LINE__
+                                                       );
+    unsigned int idxAddend = 0
+               , idxFactor = 0;
+    for(idxExpr=0; idxExpr<pExprMap->noResExpr; ++idxExpr)
+    {
+        idxFirstAddendAry[idxExpr] = idxAddend;
+        for( pAddend=pExprMap->resExprAry[idxExpr].pExpr
+           ; !isExpressionAddendNull(pAddend)
+           ; pAddend=pAddend->pNext
+           )
+        {
+            powerOfSAry[idxAddend] = pAddend->powerOfS;
+            numeratorAry[idxAddend] = (signed long long)pAddend->factor.n;
+            denominatorAry[idxAddend] = (signed long long)pAddend->factor.d;
+            idxFirstFactorAry[idxAddend] = idxFactor;
+            for(idxConst=0; idxConst<noConst; ++idxConst)
+            {
+                if(pAddend->powerOfConstAry[idxConst] != 0)
+                {
+                    idxConstAry[idxFactor] = idxConst;
+                    powerAry[idxFactor] = pAddend->powerOfConstAry[idxConst];
+                    ++ idxFactor;
+                }
+            }
+            ++ idxAddend;
+        }
+    }
+    assert(idxAddend == noAddends  &&  idxFactor == noFactors);
+    idxFirstAddendAry[pExprMap->noResExpr] = noAddends;
+    idxFirstFactorAry[noAddends] = noFactors;
+
+    ost_outputStream_t stream;
+    ost_initOutputStream(&stream, hFile);
+
+    const unsigned int headerAry[] = { BINARY_FILE_MAGIC
+                                     , BINARY_FILE_VERSION
+                                     , noConst
+                                     , noDependents
+                                     , noIndependents
+                                     , pExprMap->noResExpr
+                                     , noAddends
+                                     , noFactors
+                                     };
+    ost_putBytes(&stream, headerAry, sizeof(headerAry));
+
+    /* The name tables. */
+    writeBinaryString(&stream, pSolution->name);
+    for(idxConst=0; idxConst<noConst; ++idxConst)
+        writeBinaryString(&stream, tbv_getDeviceByBitIndex(pTableOfVars, idxConst)->name);
+    unsigned int idxDependent, idxIndependent;
+    for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
+        writeBinaryString(&stream, frq_getNameOfDependent(pSolution, idxDependent));
+    for(idxIndependent=0; idxIndependent<noIndependents; ++idxIndependent)
+        writeBinaryString(&stream, frq_getNameOfIndependent(pSolution, idxIndependent));
+
+    /* The nominal values are the default values of the M code. Devices, which are related
+       to another device, have been substituted by the referenced device in the
+       expressions; their power is always null and the value doesn't matter. */
+    for(idxConst=0; idxConst<noConst; ++idxConst)
+    {
+        const pci_device_t * const pDev = tbv_getDeviceByBitIndex(pTableOfVars, idxConst);
+        double value = 1.0;
+        if(pDev->devRelation.idxDeviceRef == PCI_NULL_DEVICE)
+        {
+            boolean isDefaultValue;
+            value = tbv_getValueOfDevice(pDev, &isDefaultValue);
+        }
+        ost_putBytes(&stream, &value, sizeof(value));
+    }
+
+    /* The expressions. */
+    ost_putBytes(&stream, idxFirstAddendAry, (pExprMap->noResExpr+1)*sizeof(unsigned int));
+    ost_putBytes(&stream, powerOfSAry, noAddends*sizeof(signed int));
+    ost_putBytes(&stream, numeratorAry, noAddends*sizeof(signed long long));
+    ost_putBytes(&stream, denominatorAry, noAddends*sizeof(signed long long));
+    ost_putBytes(&stream, idxFirstFactorAry, (noAddends+1)*sizeof(unsigned int));
+    ost_putBytes(&stream, idxConstAry, noFactors*sizeof(unsigned int));
+    ost_putBytes(&stream, powerAry, noFactors*sizeof(signed int));
+
+    /* The transfer functions. The indexes into the map already have the sign bit in the
+       MSB. */
+    for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
+    {
+        ost_putBytes( &stream
+                    , pExprMap->idxNumExprAry[idxDependent]
+                    , noIndependents*sizeof(unsigned int)
+                    );
+    }
+    for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
+    {
+        ost_putBytes( &stream
+                    , pExprMap->idxDenomExprAry[idxDependent]
+                    , noIndependents*sizeof(unsigned int)
+                    );
+    }
+
+    boolean success = ost_closeOutputStream(&stream);
+    if(fclose(hFile) != 0)
+        success = false;
+
+    free(idxFirstAddendAry);
+    free(idxFirstFactorAry);
+    free(idxConstAry);
+    free(powerOfSAry);
+    free(powerAry);
+    free(numeratorAry);
+    free(denominatorAry);
+    deleteExpressionMap(pExprMap);
+
+    if(rat_getError())
+    {
+        success = false;
+        LOG_ERROR( _log
+                 , "An arithmic overflow occured during rendering of the solution. The"
+                   " result representation in the binary data file %s is invalid"
+                   " and should be discarded"
+                 , fileName
+                 )
+    }
+    else if(!success)
+    {
+        LOG_ERROR( _log
+                 , "Error while writing binary data file %s. The file contents are"
+                   " possibly corrupt"
+                 , fileName
+                 )
+    }
+    else
+        LOG_INFO(_log, "Binary data file %s successfully written", fileName)
+    rat_clearError();
+
+    return success;
+
+} /* End of frq_exportAsBinaryData */
+
+
+
+
@@ -35,6 +35,16 @@
  * Defines
  */
 
+/** The addends of frequency domain expressions have an array of powers of constants, which
+    is sized for the circuit under progress. The number of elements is rounded up to a
+    multiple of this number. Each multiple has its own heap of addends. */
+#define FRQ_NO_CONST_PER_SIZE_CLASS 16
+
+/** The number of different sizes of addends. */
+#define FRQ_NO_SIZE_CLASSES ((COE_MAX_NO_CONST + FRQ_NO_CONST_PER_SIZE_CLASS - 1)         \
+                             / FRQ_NO_CONST_PER_SIZE_CLASS                                 \
+                            )
+
 /** Indication, that this is not a valid object. Used instead of the pointer to a true
     object. */
 #define FRQ_NULL_SOLUTION   NULL
@@ -56,14 +66,20 @@ typedef struct frq_frqDomExpressionAddend_t
     /** The numeric factor of the product of powers of constants. */
     rat_num_t factor;
     
-    /** A product of powers of constants. Array element n is related to a particular
-        constant. This constant is taken to the power \a powerOfConstAry[n]. */
-    signed int powerOfConstAry[COE_MAX_NO_CONST];
-    
     /** The addend is the product of numeric factor and constants to the given power and
         the frequency variable s to a given power. The power of s is found here. */
     signed int powerOfS;
     
+    /** A product of powers of constants. Array element n is related to a particular
+        constant. This constant is taken to the power \a powerOfConstAry[n].
+          @remark The array has as many elements as the circuit under progress has
+        constants, rounded up to a multiple of #FRQ_NO_CONST_PER_SIZE_CLASS. The size of
+        the addend objects depends on the circuit; they are allocated only by the
+        module's heap, which is chosen accordingly. A (signed) short suffices for the
+        powers: They can't exceed the number of devices in magnitude, even if several
+        devices are related to a common constant. */
+    signed short powerOfConstAry[];
+    
 } frq_frqDomExpressionAddend_t;
 
 
@@ -81,9 +97,15 @@ typedef frq_frqDomExpressionAddend_t frq_frqDomExpression_t;
       Different to an ordinary, denormalized expression, see \a frq_frqDomExpression_t, the
     "actual expression" has a defined range of powers. The individual powers of s and of the
     device constants are all positive and they are guaranteed to begin with the lowest
-    power null. */
+    power null.\n
+      Normalized expressions are immutable after creation. They can be shared between
+    several solution objects; the life time of a shared object is controlled by a
+    reference counter. */
 typedef struct frqx_frqDomExpression_t
 {
+    /** A counter of references to this object. Used to control deletion of object. */
+    unsigned int noReferencesToThis;
+
     /** The common factor. All terms of * \a pExpr have to be multiplied with this factor. */
     frq_frqDomExpressionAddend_t *pFactor;
     
@@ -138,6 +160,33 @@ typedef struct frq_freqDomainSolution_t
 } frq_freqDomainSolution_t;
 
 
+/** A cache of the frequency domain expressions, which have been derived from an algebraic
+    solution. The user-defined results of a circuit are all derived from the same algebraic
+    solution; they share the common denominator and often many of the numerators. Having
+    the cache, all of these are transformed and normalized only once per circuit. */
+typedef struct frq_expressionCache_t
+{
+    /** The algebraic solution, which the cached expressions have been derived from. */
+    const sol_solution_t *pAlgebraicSolution;
+
+    /** The transformed system determinant. Valid only if \a isDenominatorAvailable is set. */
+    frq_normalizedFrqDomExpression_t *pDenominator;
+
+    /** Has the system determinant already been transformed? */
+    boolean isDenominatorAvailable;
+
+    /** An array [noDependents, noIndependents] of the transformed numerators of the
+        algebraic solution. An element is valid only if the related element of \a
+        isNumeratorAvailableAry is set. */
+    frq_normalizedFrqDomExpressionMatrix_t numeratorAry;
+
+    /** An array [noDependents, noIndependents] of flags, whether the related numerator has
+        already been transformed. */
+    boolean **isNumeratorAvailableAry;
+
+} frq_expressionCache_t;
+
+
 /*
  * Global data declarations
  */
@@ -148,15 +197,23 @@ typedef struct frq_freqDomainSolution_t
  */
 
 /** Initialize the module prior to first use of any of its methods or global data objects. */
-void frq_initModule(log_hLogger_t hGlobalLogger);
+void frq_initModule(log_hLogger_t hGlobalLogger, double approximationErrorBound);
 
 /** Shutdown of module after use. Release of memory, closing files, etc. */
 void frq_shutdownModule(void);
 
+/** Create a cache for the frequency domain expressions of all results of a circuit. */
+frq_expressionCache_t *frq_createExpressionCache
+                                    (const sol_solution_t * const pAlgebraicSolution);
+
+/** Delete a cache of frequency domain expressions after use. */
+void frq_deleteExpressionCache(frq_expressionCache_t * const pCache);
+
 /** Create a result representation in the frequency domain. */
 boolean frq_createFreqDomainSolution( const frq_freqDomainSolution_t * * const ppFrqDomSolution
                                     , const sol_solution_t * const pAlgebraicSolution
                                     , signed int idxResult
+                                    , frq_expressionCache_t * const pCache
                                     );
 
 /** Get another reference to the same object. */
@@ -190,6 +247,13 @@ void frq_logFreqDomainSolution( const frq_freqDomainSolution_t * const pSolution
 /** Export a complete solution in the frequency domain as Octave script code. */
 boolean frq_exportAsMCode( const frq_freqDomainSolution_t * const pSolution
                          , msc_mScript_t * const pMScript
+                         , boolean useBinaryData
+                         , boolean factored
                          );
 
+/** Export a complete solution in the frequency domain as binary data file for Octave. */
+boolean frq_exportAsBinaryData( const frq_freqDomainSolution_t * const pSolution
+                              , const char * const fileName
+                              );
+
 #endif  /* FRQ_FREQDOMAINSOLUTION_INCLUDED */
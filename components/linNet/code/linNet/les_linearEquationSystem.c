@@ -31,9 +31,14 @@
  *   logNetworkTopology
  *   analyseNetworkTopology
  *   deleteNetwork
+ *   selectPortModels
  *   findNodeGnd
  *   createNameOfUnknown
  *   determineReqVariables
+ *   addProductOfCoefs
+ *   createPortModelOfSubcircuit
+ *   mapCoefOntoInstance
+ *   createPortModels
  *   addSrcUConditions
  *   addSrcIConditions
  *   addPassiveDeviceConditions
@@ -44,6 +49,11 @@
  *   addSrcIByUConditions
  *   addSrcIByIConditions
  *   addDeviceConditions
+ *   addCoef
+ *   addPortModelConditions
+ *   findNumericConstants
+ *   getValueOfAddend
+ *   substituteNumericConstants
  */
 
 /*
@@ -52,6 +62,8 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <math.h>
 #include <assert.h>
 
 #include "smalloc.h"
@@ -61,6 +73,7 @@
 #include "tbv_tableOfVariables.h"
 #include "coe_coefficient.h"
 #include "coe_coefficient.inlineInterface.h"
+#include "rat_rationalNumber.h"
 #include "les_linearEquationSystem.h"
 
 
@@ -84,6 +97,11 @@
     than #MAX_SIZE_OF_SYMBOL_PREFIX-1. */
 #define SYMBOL_PREFIX_CURRENT   "I_"
 
+/** A subcircuit instance is represented by a port model only if its subcircuit doesn't
+    have more internal nodes than this. The computation of the port model has exponential
+    complexity in the number of internal nodes. */
+#define MAX_NO_INTERNAL_NODES_OF_PORT_MODEL     10
+
 
 /*
  * Local type definitions
@@ -103,6 +121,10 @@ typedef struct networkNodeRef_t
         the same node. This flags is used to recognize this problem. */
     boolean isOpampOutput;
 
+    /** An internal node of a subcircuit instance, which is represented by a port model,
+        doesn't have an unknown voltage in the LES. */
+    boolean isInternalNodeOfPortModel;
+
 #ifdef DEBUG
     /** Protection against misuse. */
     boolean isInUse;
@@ -150,6 +172,26 @@ typedef struct
 } network_t;
 
 
+/** The port model of a subcircuit instance. The instance is a two-terminal network of
+    passive devices and it is represented in the LES by a single unknown, the current I
+    through the instance, and a single equation, D*I = N*U, where U is the voltage between
+    the two ports and N/D is the admittance of the instance. */
+typedef struct les_portModel_s
+{
+    /** The represented instance by index into the array of instances of the circuit. */
+    unsigned int idxInstance;
+
+    /** The coefficient D of the current. It is the determinant of the admittance matrix of
+        the internal nodes of the instance. */
+    coe_coef_t *pCoefCurrent;
+
+    /** The coefficient N of the voltage between the ports. It is the determinant of the
+        admittance matrix of the first port and the internal nodes of the instance. */
+    coe_coef_t *pCoefVoltage;
+
+} portModel_t;
+
+
 /*
  * Local prototypes
  */
@@ -162,10 +204,10 @@ static void deleteNetwork(network_t * const pNetwork);
  */
 
 /** A global logger object is referenced from anywhere for writing progress messages. */
-static log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
 
 /** A heap specific for objects of type subNetwork_t. */
-mem_hHeap_t _hMemMgrSubNet = MEM_HANDLE_INVALID_HEAP;
+static THREAD_LOCAL mem_hHeap_t _hMemMgrSubNet = MEM_HANDLE_INVALID_HEAP;
 
 
 /*
@@ -447,6 +489,7 @@ static boolean analyseNetworkTopology( network_t * * const ppNetwork
                 pNodeRef->pNext = NULL;
                 pNodeRef->idxNode = nodeAry[u].idxNode;
                 pNodeRef->isOpampOutput = false;
+                pNodeRef->isInternalNodeOfPortModel = false;
                 pSubNet->pHeadOfNodeList = pNodeRef;
 
                 /* Now place the new sub-graph into the list of networks. */
@@ -724,6 +767,93 @@ static void deleteNetwork(network_t * const pNetwork)
 
 
 
+/**
+ * Decide, which subcircuit instances of the circuit are represented in the LES by a port
+ * model rather than by their devices and internal nodes. The parser has already found the
+ * instances, which permit this representation. Excluded are still the instances of
+ * subcircuits with many internal nodes; the computation of the port model grows
+ * exponentially with their number.\n
+ *   The port models are entered into the LES object with null coefficients; these are
+ * computed later by createPortModels, when the representation of the coefficients is
+ * known. The internal nodes of the selected instances are marked in the network.
+ *   @param pLES
+ * The LES object under construction. The port models are entered.
+ *   @param pNetwork
+ * The representation of the network as got from the network topology analysis.
+ */
+
+static void selectPortModels( les_linearEquationSystem_t * const pLES
+                            , network_t * const pNetwork
+                            )
+{
+    const pci_circuit_t * const pCircuitNetList = pNetwork->pCircuitNetList;
+    assert(pLES->noPortModels == 0  &&  pLES->portModelAry == NULL);
+
+    unsigned int idxInst;
+    for(idxInst=0; idxInst<pCircuitNetList->noSubcircuitInstances; ++idxInst)
+    {
+        const pci_subcircuitInstance_t * const pInst =
+                                            &pCircuitNetList->subcircuitInstanceAry[idxInst];
+        const pci_subcircuitDef_t * const pDef =
+                                    &pCircuitNetList->subcircuitDefAry[pInst->idxSubcircuitDef];
+        const unsigned int noInternalNodes = pDef->pCircuit->noNodes - pDef->noPorts;
+        if(!pInst->isReducible  ||  noInternalNodes > MAX_NO_INTERNAL_NODES_OF_PORT_MODEL)
+        {
+            LOG_DEBUG( _log
+                     , "Subcircuit instance %s of %s is represented by its devices"
+                     , pInst->name
+                     , pDef->name
+                     )
+            continue;
+        }
+
+        if(pLES->portModelAry == NULL)
+        {
+            pLES->portModelAry = smalloc( pCircuitNetList->noSubcircuitInstances
+                                          * sizeof(portModel_t)
+                                        , __FILE__
+                                        , __LINE__
+                                        );
+            pLES->idxPortModelOfDevAry = smalloc( pCircuitNetList->noDevices
+                                                  * sizeof(unsigned int)
+                                                , __FILE__
+                                                , __LINE__
+                                                );
+            unsigned int idxDev;
+            for(idxDev=0; idxDev<pCircuitNetList->noDevices; ++idxDev)
+                pLES->idxPortModelOfDevAry[idxDev] = UINT_MAX;
+        }
+
+        portModel_t * const pPortModel = &pLES->portModelAry[pLES->noPortModels];
+        pPortModel->idxInstance = idxInst;
+        pPortModel->pCoefCurrent = coe_coefAddendNull();
+        pPortModel->pCoefVoltage = coe_coefAddendNull();
+
+        unsigned int u;
+        for(u=0; u<pDef->pCircuit->noDevices; ++u)
+            pLES->idxPortModelOfDevAry[pInst->idxFirstDevice+u] = pLES->noPortModels;
+        for(u=pDef->noPorts; u<pDef->pCircuit->noNodes; ++u)
+        {
+            assert(pNetwork->nodeRefAry[pInst->idxNodeAry[u]].idxNode == pInst->idxNodeAry[u]);
+            pNetwork->nodeRefAry[pInst->idxNodeAry[u]].isInternalNodeOfPortModel = true;
+        }
+
+        ++ pLES->noPortModels;
+
+        LOG_INFO( _log
+                , "Subcircuit instance %s of %s is represented by a port model. Its %u"
+                  " internal nodes are not visible in the solution"
+                , pInst->name
+                , pDef->name
+                , noInternalNodes
+                )
+    } /* End for(All subcircuit instances) */
+
+} /* End of selectPortModels */
+
+
+
+
 /**
  * Select one node out of all nodes of a sub-grapgh, which shall have voltage null.
  * Basically any node can be defined to play this roll. However, typical use cases will
@@ -731,7 +861,8 @@ static void deleteNetwork(network_t * const pNetwork)
  * it otherwise we (arbitrarily) use the first node.\n
  *   There's one hard condition to be fulfillied: The ouput of the op-amp must not be
  * connected to the ground node; this is because of the way the op-amp is expressed as a
- * linear equation.
+ * linear equation. The internal nodes of subcircuit instances, which are represented by
+ * a port model, are not considered; they have no voltage in the LES.
  *   @return
  * \a true if a suitable ground node could be determined or \a false otherwise.
  *   @param pIdxGroundNode
@@ -767,10 +898,12 @@ static boolean findNodeGnd( unsigned int * const pIdxGroundNode
     {
         /* Check name to see if the user wants to use this node as a ground node. */
         const char *nodeName = pCircuitNetList->nodeNameAry[pNode->idxNode];
-        if(strstr(nodeName, "gnd") != NULL  ||  strstr(nodeName, "Gnd") != NULL
-           || strstr(nodeName, "GND") != NULL
-           || strstr(nodeName, "ground") != NULL  ||  strstr(nodeName, "Ground") != NULL
-           || strstr(nodeName, "GROUND") != NULL
+        if(!pNode->isInternalNodeOfPortModel
+           && (strstr(nodeName, "gnd") != NULL  ||  strstr(nodeName, "Gnd") != NULL
+               || strstr(nodeName, "GND") != NULL
+               || strstr(nodeName, "ground") != NULL  ||  strstr(nodeName, "Ground") != NULL
+               || strstr(nodeName, "GROUND") != NULL
+              )
           )
         {
             if(*pIdxGroundNode == PCI_NULL_NODE)
@@ -813,7 +946,17 @@ static boolean findNodeGnd( unsigned int * const pIdxGroundNode
     if(success &&  *pIdxGroundNode == PCI_NULL_NODE)
     {
         if(!opAmpInCircuit)
-            *pIdxGroundNode = pHeadOfNodeList->idxNode;
+        {
+            pNode = pHeadOfNodeList;
+            while(pNode->isInternalNodeOfPortModel)
+            {
+                /* The ports of an instance are in the same sub-graph as its internal
+                   nodes. */
+                pNode = pNode->pNext;
+                assert(pNode != NULL);
+            }
+            *pIdxGroundNode = pNode->idxNode;
+        }
         else
             success = false;
     }
@@ -893,6 +1036,8 @@ static void createNameOfUnknown( char name[]
  * The representation of the network as got from the network topology analysis. Contains
  * the net list representing the circuit and the list of sub-graphs that form the complete
  * network.
+ *   @param pLES
+ * The LES object under construction. Its port models have already been selected.
  *   @remark
  * The table of variables is allocated dynamically. The data structure needs to be freed
  * after use. Use destructor void tbv_deleteTableOfVariables(tbv_tableOfVariables_t * const)
@@ -901,6 +1046,7 @@ static void createNameOfUnknown( char name[]
 
 static boolean determineReqVariables( tbv_tableOfVariables_t * * const ppTableOfVars
                                     , const network_t * const pNetwork
+                                    , const les_linearEquationSystem_t * const pLES
                                     )
 {
     unsigned int noKnowns = 0
@@ -913,6 +1059,21 @@ static boolean determineReqVariables( tbv_tableOfVariables_t * * const ppTableOf
     assert(pCircuitNetList->noNodes >= pNetwork->noSubNets);
     noUnknowns = pCircuitNetList->noNodes - pNetwork->noSubNets;
 
+    /* A port model replaces the unknown voltages of the internal nodes of an instance by a
+       single unknown current. */
+    unsigned int idxPortModel;
+    for(idxPortModel=0; idxPortModel<pLES->noPortModels; ++idxPortModel)
+    {
+        const pci_subcircuitInstance_t * const pInst =
+                    &pCircuitNetList->subcircuitInstanceAry
+                                            [pLES->portModelAry[idxPortModel].idxInstance];
+        const pci_subcircuitDef_t * const pDef =
+                                    &pCircuitNetList->subcircuitDefAry[pInst->idxSubcircuitDef];
+        assert(noUnknowns >= pDef->pCircuit->noNodes - pDef->noPorts);
+        noUnknowns -= pDef->pCircuit->noNodes - pDef->noPorts;
+        ++ noUnknowns;
+    }
+
     /* Most devices are characterized (or quantified) by a constant. Some special devices
        introduce an additional unknown and constant sources are the knowns of the LES.
        Pass one: Inspect all devices and count. */
@@ -971,8 +1132,9 @@ static boolean determineReqVariables( tbv_tableOfVariables_t * * const ppTableOf
         {
             unsigned int idxNode = pNodeRef->idxNode;
 
-            /* The voltage of each non ground node is one unknown. */
-            if(idxNode == idxNodeGnd)
+            /* The voltage of each non ground node is one unknown - unless it is hidden in a
+               port model. */
+            if(idxNode == idxNodeGnd  ||  pNodeRef->isInternalNodeOfPortModel)
             {
                 pNodeRef = pNodeRef->pNext;
                 continue;
@@ -1123,6 +1285,32 @@ static boolean determineReqVariables( tbv_tableOfVariables_t * * const ppTableOf
 
     } /* End for(All devices) */
 
+    /* Each port model introduces an unknown current. It is named after the instance and
+       it is associated with the first device of the instance. */
+    for(idxPortModel=0; success && idxPortModel<pLES->noPortModels; ++idxPortModel)
+    {
+        const pci_subcircuitInstance_t * const pInst =
+                    &pCircuitNetList->subcircuitInstanceAry
+                                            [pLES->portModelAry[idxPortModel].idxInstance];
+        const unsigned int maxSizeOfName = MAX_SIZE_OF_SYMBOL_PREFIX + strlen(pInst->name);
+        char nameUnknown[maxSizeOfName];
+        createNameOfUnknown( nameUnknown
+                           , maxSizeOfName
+                           , /* isVoltage */ false
+                           , /* userObject */ pInst->name
+                           );
+        if(!tbv_addUnknown( pTabOfVars
+                          , nameUnknown
+                          , /* idxNode */ PCI_NULL_NODE
+                          , /* idSubNet */ UINT_MAX
+                          , /* idxDevice */ pInst->idxFirstDevice
+                          )
+          )
+        {
+            success = false;
+        }
+    } /* End for(All port models) */
+
     /* Now we have the list of all device constants in use. We can sort the internal order
        so that later result output will present them in the common order: R, L, C. */
     if(success)
@@ -1161,6 +1349,290 @@ static boolean determineReqVariables( tbv_tableOfVariables_t * * const ppTableOf
 
 
 
+/**
+ * Add the product of two coefficients to another coefficient. Addends of the product,
+ * which would contain a constant squared, are dropped.\n
+ *   Dropping these addends is not an approximation if the product is used to compute a
+ * determinant, which is known to contain each constant at most with power one. The
+ * squared constants cancel out in such a determinant and can be ignored throughout the
+ * computation.
+ *   @param ppCoef
+ * The pointer to the coefficient, which the product is added to.
+ *   @param factor
+ * A numeric factor of the product, usually 1 or -1.
+ *   @param pOperand1
+ * The first operand of the product.
+ *   @param pOperand2
+ * The second operand of the product.
+ */
+
+static void addProductOfCoefs( coe_coef_t * * const ppCoef
+                             , coe_numericFactor_t factor
+                             , const coe_coef_t * const pOperand1
+                             , const coe_coef_t * const pOperand2
+                             )
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    const coe_coefAddend_t *pAddend1;
+    for(pAddend1=pOperand1; !coe_isCoefAddendNull(pAddend1); pAddend1=pAddend1->pNext)
+    {
+        const coe_coefAddend_t *pAddend2;
+        for(pAddend2=pOperand2; !coe_isCoefAddendNull(pAddend2); pAddend2=pAddend2->pNext)
+        {
+            coe_productOfConst_t productOfConst = COE_PRODUCT_OF_NO_CONST;
+            boolean isSquare = false;
+            unsigned int idxWord;
+            for(idxWord=0; idxWord<noWords; ++idxWord)
+            {
+                if((pAddend1->productOfConst[idxWord] & pAddend2->productOfConst[idxWord]) != 0)
+                    isSquare = true;
+                productOfConst.wordAry[idxWord] = pAddend1->productOfConst[idxWord]
+                                                  | pAddend2->productOfConst[idxWord];
+            }
+            if(!isSquare)
+            {
+                coe_addAddend( ppCoef
+                             , factor * pAddend1->factor * pAddend2->factor
+                             , productOfConst
+                             );
+            }
+        }
+    }
+} /* End of addProductOfCoefs */
+
+
+
+
+/**
+ * Compute the port model of a subcircuit. The subcircuit is a two-terminal network of
+ * passive devices. Its behavior at the ports is described by its admittance Y between the
+ * ports. The fraction Y is represented by its numerator and denominator: The numerator is
+ * the determinant of the admittance matrix of the subcircuit, if the second port is
+ * considered the ground node. The denominator is the determinant of the same matrix
+ * without the row and column of the first port. (Y is the Schur complement of the latter
+ * in the former.)\n
+ *   Both determinants are computed in an own numbering of the constants: Constant \a i is
+ * the device \a i of the subcircuit. The numbers of the instances are got later by
+ * mapCoefOntoInstance.
+ *   @param ppCoefCurrent
+ * The denominator of the admittance is returned in * \a ppCoefCurrent. The caller needs
+ * to free the coefficient after use.
+ *   @param ppCoefVoltage
+ * The numerator of the admittance is returned in * \a ppCoefVoltage. The caller needs to
+ * free the coefficient after use.
+ *   @param pDef
+ * The definition of the subcircuit.
+ */
+
+static void createPortModelOfSubcircuit( coe_coef_t * * const ppCoefCurrent
+                                       , coe_coef_t * * const ppCoefVoltage
+                                       , const pci_subcircuitDef_t * const pDef
+                                       )
+{
+    const pci_circuit_t * const pSubcircuit = pDef->pCircuit;
+    assert(pDef->noPorts == 2  &&  pSubcircuit->noNodes >= 2
+           &&  pSubcircuit->noNodes-2 <= MAX_NO_INTERNAL_NODES_OF_PORT_MODEL
+           &&  pSubcircuit->noDevices <= coe_getNoWordsOfProduct()*COE_NO_CONST_PER_WORD
+          );
+
+    /* Set up the admittance matrix; row and column zero belong to the first port, the
+       others to the internal nodes. The second port is the ground node and doesn't have
+       a row. */
+    const unsigned int n = pSubcircuit->noNodes - 1;
+    coe_coef_t *G[n][n];
+    unsigned int r, c;
+    for(r=0; r<n; ++r)
+    {
+        for(c=0; c<n; ++c)
+            G[r][c] = coe_coefAddendNull();
+    }
+
+    unsigned int idxDev;
+    for(idxDev=0; idxDev<pSubcircuit->noDevices; ++idxDev)
+    {
+        const pci_device_t * const pDev = pSubcircuit->pDeviceAry[idxDev];
+        const coe_productOfConst_t k = coe_getProductOfSingleConst(idxDev);
+        const unsigned int idxNodeAry[2] = {pDev->idxNodeFrom, pDev->idxNodeTo};
+        unsigned int i, j;
+        for(i=0; i<2; ++i)
+        {
+            if(idxNodeAry[i] == 1)
+                continue;
+            r = idxNodeAry[i] == 0? 0: idxNodeAry[i]-1;
+            for(j=0; j<2; ++j)
+            {
+                if(idxNodeAry[j] == 1)
+                    continue;
+                c = idxNodeAry[j] == 0? 0: idxNodeAry[j]-1;
+                coe_addAddend(&G[r][c], /* factor */ i == j? 1: -1, k);
+            }
+        }
+    } /* End for(All devices of the subcircuit) */
+
+    /* Laplace expansion: The determinant of the square submatrix, which is made of the
+       rows in set S and of the last |S| columns, is expanded along its first column. Each
+       of these determinants is computed only once and stored by S, which is represented
+       as bit vector. Sets of less rows are processed first. */
+    const unsigned int noSets = 1u << n;
+    coe_coef_t * * const detAry = smalloc(noSets * sizeof(coe_coef_t*), __FILE__, __LINE__);
+    detAry[0] = coe_coefAddendOne();
+    unsigned int S;
+    for(S=1; S<noSets; ++S)
+    {
+        c = n - (unsigned int)__builtin_popcount(S);
+        detAry[S] = coe_coefAddendNull();
+        coe_numericFactor_t sign = 1;
+        for(r=0; r<n; ++r)
+        {
+            if((S & (1u<<r)) != 0)
+            {
+                addProductOfCoefs(&detAry[S], sign, G[r][c], detAry[S & ~(1u<<r)]);
+                sign = -sign;
+            }
+        }
+    }
+
+    /* The determinant of the complete matrix is the numerator, the determinant of the
+       internal nodes only the denominator. The latter is not null as each internal node
+       is connected to a port. */
+    const unsigned int setOfAllRows = noSets-1
+                     , setOfInternalRows = setOfAllRows & ~1u;
+    *ppCoefVoltage = detAry[setOfAllRows];
+    *ppCoefCurrent = detAry[setOfInternalRows];
+    assert(!coe_isCoefAddendNull(*ppCoefCurrent));
+    detAry[setOfAllRows] =
+    detAry[setOfInternalRows] = coe_coefAddendNull();
+
+    for(S=0; S<noSets; ++S)
+        coe_freeCoef(detAry[S]);
+    free(detAry);
+    for(r=0; r<n; ++r)
+    {
+        for(c=0; c<n; ++c)
+            coe_freeCoef(G[r][c]);
+    }
+} /* End of createPortModelOfSubcircuit */
+
+
+
+
+/**
+ * Map a coefficient of the port model of a subcircuit onto an instance of the subcircuit.
+ * The numbering of the constants is changed from the devices of the subcircuit to the
+ * constants of the devices of the instance in the LES.
+ *   @return
+ * Get the mapped coefficient. The caller needs to free it after use.
+ *   @param pCoef
+ * The coefficient as got from createPortModelOfSubcircuit.
+ *   @param pTableOfVars
+ * The table of variables of the LES.
+ *   @param idxFirstDevice
+ * The index of the first device of the instance in the net list of the circuit.
+ */
+
+static coe_coef_t *mapCoefOntoInstance( const coe_coef_t * const pCoef
+                                      , const tbv_tableOfVariables_t * const pTableOfVars
+                                      , unsigned int idxFirstDevice
+                                      )
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    coe_coef_t *pMappedCoef = coe_coefAddendNull();
+    const coe_coefAddend_t *pAddend;
+    for(pAddend=pCoef; !coe_isCoefAddendNull(pAddend); pAddend=pAddend->pNext)
+    {
+        coe_productOfConst_t productOfConst = COE_PRODUCT_OF_NO_CONST;
+        unsigned int idxConst = coe_findConstInProductOfConst( pAddend->productOfConst
+                                                             , /* idxConst */ 0
+                                                             , noWords
+                                                             );
+        while(idxConst != UINT_MAX)
+        {
+            const coe_productOfConst_t k = tbv_getConstantByDevice( pTableOfVars
+                                                                  , idxFirstDevice+idxConst
+                                                                  );
+            unsigned int idxWord;
+            for(idxWord=0; idxWord<noWords; ++idxWord)
+            {
+                assert((productOfConst.wordAry[idxWord] & k.wordAry[idxWord]) == 0);
+                productOfConst.wordAry[idxWord] |= k.wordAry[idxWord];
+            }
+            idxConst = coe_findConstInProductOfConst( pAddend->productOfConst
+                                                    , idxConst+1
+                                                    , noWords
+                                                    );
+        }
+
+        /* The order of the addends changes with the numbering; the mapped addends are
+           inserted at their new position. */
+        coe_addAddend(&pMappedCoef, pAddend->factor, productOfConst);
+    }
+
+    return pMappedCoef;
+
+} /* End of mapCoefOntoInstance */
+
+
+
+
+/**
+ * Compute the coefficients of all port models of the LES. The port model of a subcircuit
+ * is computed only once and then mapped onto all of its instances.
+ *   @param pLES
+ * The LES object under construction. The table of variables is complete and the
+ * representation of the coefficients has been set.
+ */
+
+static void createPortModels(les_linearEquationSystem_t * const pLES)
+{
+    const tbv_tableOfVariables_t * const pTableOfVars = pLES->pTableOfVars;
+    const pci_circuit_t * const pCircuitNetList = pTableOfVars->pCircuitNetList;
+
+    unsigned int idxDef;
+    for(idxDef=0; idxDef<pCircuitNetList->noSubcircuitDefs; ++idxDef)
+    {
+        const pci_subcircuitDef_t * const pDef = &pCircuitNetList->subcircuitDefAry[idxDef];
+        coe_coef_t *pCoefCurrentOfDef = coe_coefAddendNull()
+                 , *pCoefVoltageOfDef = coe_coefAddendNull();
+        boolean isModelOfDefAvailable = false;
+
+        unsigned int idxPortModel;
+        for(idxPortModel=0; idxPortModel<pLES->noPortModels; ++idxPortModel)
+        {
+            portModel_t * const pPortModel = &pLES->portModelAry[idxPortModel];
+            const pci_subcircuitInstance_t * const pInst =
+                                &pCircuitNetList->subcircuitInstanceAry[pPortModel->idxInstance];
+            if(pInst->idxSubcircuitDef != idxDef)
+                continue;
+
+            /* The port model of the subcircuit is computed, when it is needed the first
+               time. */
+            if(!isModelOfDefAvailable)
+            {
+                createPortModelOfSubcircuit(&pCoefCurrentOfDef, &pCoefVoltageOfDef, pDef);
+                isModelOfDefAvailable = true;
+                LOG_DEBUG(_log, "The port model of subcircuit %s has been computed", pDef->name)
+            }
+
+            pPortModel->pCoefCurrent = mapCoefOntoInstance( pCoefCurrentOfDef
+                                                          , pTableOfVars
+                                                          , pInst->idxFirstDevice
+                                                          );
+            pPortModel->pCoefVoltage = mapCoefOntoInstance( pCoefVoltageOfDef
+                                                          , pTableOfVars
+                                                          , pInst->idxFirstDevice
+                                                          );
+        } /* End for(All port models) */
+
+        coe_freeCoef(pCoefCurrentOfDef);
+        coe_freeCoef(pCoefVoltageOfDef);
+
+    } /* End for(All subcircuits) */
+
+} /* End of createPortModels */
+
+
+
+
 
 /**
  * Add those terms to the (half way completed) LES, that describe the conditions
@@ -1213,7 +1685,7 @@ static void addSrcUConditions( coe_coefMatrix_t const A
            connected to; this is by definition a positive current. */
         coe_addAddend( &A[pUnknownUFrom->idxRow][idxColUnknownI]
                      , /* factor */          +1 
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1227,7 +1699,7 @@ static void addSrcUConditions( coe_coefMatrix_t const A
            back into the voltage source; this is by definition a negative current. */
         coe_addAddend( &A[pUnknownUTo->idxRow][idxColUnknownI]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1244,7 +1716,7 @@ static void addSrcUConditions( coe_coefMatrix_t const A
     {
         coe_addAddend( &A[idxEqSuppl][pUnknownUFrom->idxCol]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "from" is a ground node. */
@@ -1253,7 +1725,7 @@ static void addSrcUConditions( coe_coefMatrix_t const A
     {
         coe_addAddend( &A[idxEqSuppl][pUnknownUTo->idxCol]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "to" is a ground node. */
@@ -1261,7 +1733,7 @@ static void addSrcUConditions( coe_coefMatrix_t const A
     const unsigned int idxColKnownU = tbv_getKnownByDevice(pTableOfVars, idxDevice)->idxCol;
     coe_addAddend( &A[idxEqSuppl][idxColKnownU]
                  , /* factor */          -1
-                 , /* productOfConsts */ 0
+                 , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                  );
 } /* End of addSrcUConditions */
 
@@ -1316,7 +1788,7 @@ static void addSrcIConditions( coe_coefMatrix_t const A
            connected to; this is by definition a positive current. */
         coe_addAddend( &A[pUnknownUFrom->idxRow][idxColKnownI]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1330,7 +1802,7 @@ static void addSrcIConditions( coe_coefMatrix_t const A
            to back into the current source; this is by definition a negative current. */
         coe_addAddend( &A[pUnknownUTo->idxRow][idxColKnownI]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1491,7 +1963,7 @@ static void addOpAmpConditions( coe_coefMatrix_t const A
        definition. */
     coe_addAddend( &A[pUnknownOpOut->idxRow][idxColUnknownI]
                  , /* factor */          +1
-                 , /* productOfConsts */ 0
+                 , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                  );
 
     /* The additional unknown requires an additional equation. This equation says,
@@ -1511,7 +1983,7 @@ static void addOpAmpConditions( coe_coefMatrix_t const A
     {
         coe_addAddend( &A[idxEqSuppl][pUnknownUFrom->idxCol]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "from" is a ground node. */
@@ -1520,7 +1992,7 @@ static void addOpAmpConditions( coe_coefMatrix_t const A
     {
         coe_addAddend( &A[idxEqSuppl][pUnknownUTo->idxCol]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "to" is a ground node. */
@@ -1579,7 +2051,7 @@ static void addCurrentProbeConditions( coe_coefMatrix_t const A
            negative contribution to the node's current balance. */
         coe_addAddend( &A[pUnknownUFrom->idxRow][idxColUnknownI]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1594,7 +2066,7 @@ static void addCurrentProbeConditions( coe_coefMatrix_t const A
            positive contribution to the node's current balance. */
         coe_addAddend( &A[pUnknownUTo->idxRow][idxColUnknownI]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1610,7 +2082,7 @@ static void addCurrentProbeConditions( coe_coefMatrix_t const A
     {
         coe_addAddend( &A[idxEqSuppl][pUnknownUFrom->idxCol]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "from" is a ground node. */
@@ -1619,7 +2091,7 @@ static void addCurrentProbeConditions( coe_coefMatrix_t const A
     {
         coe_addAddend( &A[idxEqSuppl][pUnknownUTo->idxCol]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "to" is a ground node. */
@@ -1681,7 +2153,7 @@ static void addSrcUByUConditions( coe_coefMatrix_t const A
            connected to; this is by definition a positive current. */
         coe_addAddend( &A[pUnknownUFrom->idxRow][idxColUnknownI]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1695,7 +2167,7 @@ static void addSrcUByUConditions( coe_coefMatrix_t const A
            to back into the voltage source; this is by definition a negative current. */
         coe_addAddend( &A[pUnknownUTo->idxRow][idxColUnknownI]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1715,7 +2187,7 @@ static void addSrcUByUConditions( coe_coefMatrix_t const A
         const unsigned int idxColNodeFrom = pUnknownUFrom->idxCol;
         coe_addAddend( &A[idxEqSuppl][idxColNodeFrom]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "from" is a ground node. */
@@ -1725,7 +2197,7 @@ static void addSrcUByUConditions( coe_coefMatrix_t const A
         const unsigned int idxColNodeTo = pUnknownUTo->idxCol;
         coe_addAddend( &A[idxEqSuppl][idxColNodeTo]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "to" is a ground node. */
@@ -1810,7 +2282,7 @@ static void addSrcUByIConditions( coe_coefMatrix_t const A
            connected to; this is by definition a positive current. */
         coe_addAddend( &A[pUnknownUFrom->idxRow][idxColUnknownI]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1824,7 +2296,7 @@ static void addSrcUByIConditions( coe_coefMatrix_t const A
            to back into the voltage source; this is by definition a negative current. */
         coe_addAddend( &A[pUnknownUTo->idxRow][idxColUnknownI]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Connected node is a ground node. */
@@ -1841,7 +2313,7 @@ static void addSrcUByIConditions( coe_coefMatrix_t const A
         const unsigned int idxColNodeFrom = pUnknownUFrom->idxCol;
         coe_addAddend( &A[idxEqSuppl][idxColNodeFrom]
                      , /* factor */          +1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "from" is a ground node. */
@@ -1851,7 +2323,7 @@ static void addSrcUByIConditions( coe_coefMatrix_t const A
         const unsigned int idxColNodeTo = pUnknownUTo->idxCol;
         coe_addAddend( &A[idxEqSuppl][idxColNodeTo]
                      , /* factor */          -1
-                     , /* productOfConsts */ 0
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
                      );
     }
     /* else: Node connected to "to" is a ground node. */
@@ -2134,6 +2606,364 @@ static void addDeviceConditions( coe_coefMatrix_t const A
 
 
 
+/**
+ * Add a coefficient, multiplied with a numeric factor, to a coefficient of the LES.
+ *   @param ppCoef
+ * The pointer to the coefficient of the LES.
+ *   @param factor
+ * The numeric factor, usually 1 or -1.
+ *   @param pCoef
+ * The added coefficient.
+ */
+
+static void addCoef( coe_coef_t * * const ppCoef
+                   , coe_numericFactor_t factor
+                   , const coe_coef_t * const pCoef
+                   )
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    const coe_coefAddend_t *pAddend;
+    for(pAddend=pCoef; !coe_isCoefAddendNull(pAddend); pAddend=pAddend->pNext)
+    {
+        coe_productOfConst_t productOfConst = COE_PRODUCT_OF_NO_CONST;
+        coe_copyProductOfConst(productOfConst.wordAry, pAddend->productOfConst, noWords);
+        coe_addAddend(ppCoef, factor * pAddend->factor, productOfConst);
+    }
+} /* End of addCoef */
+
+
+
+
+/**
+ * Add those terms to the (half way completed) LES, that describe the conditions
+ * superimposed by a subcircuit instance, which is represented by a port model.
+ *   @param A
+ * The matrix m*n of pointers to coefficients.
+ *   @param pTableOfVars
+ * The table of all constants, knowns and unknows, which are used in the LES by reference.
+ *   @param pPortModel
+ * The port model of the instance.
+ */
+
+static void addPortModelConditions( coe_coefMatrix_t const A
+                                  , const tbv_tableOfVariables_t * const pTableOfVars
+                                  , const portModel_t * const pPortModel
+                                  )
+{
+    const pci_circuit_t * const pCircuitNetList = pTableOfVars->pCircuitNetList;
+    assert(pPortModel->idxInstance < pCircuitNetList->noSubcircuitInstances);
+    const pci_subcircuitInstance_t * const pInst =
+                                &pCircuitNetList->subcircuitInstanceAry[pPortModel->idxInstance];
+
+    /* The instance is handled by an additional internal unknown, the current flowing into
+       its first port and out of its second port. */
+    const tbv_unknownVariable_t * const pUnknownI = tbv_getUnknownByDevice
+                                                                ( pTableOfVars
+                                                                , pInst->idxFirstDevice
+                                                                );
+    assert(pUnknownI != NULL);
+    const tbv_unknownVariable_t * const pUnknownUA = tbv_getUnknownByNode
+                                                                ( pTableOfVars
+                                                                , pInst->idxNodeAry[0]
+                                                                )
+                              , * const pUnknownUB = tbv_getUnknownByNode
+                                                                ( pTableOfVars
+                                                                , pInst->idxNodeAry[1]
+                                                                );
+
+    /* Extend the current balances of the two port nodes - if they are not ground nodes.
+       The current is effluent at the first port and influent at the second one. */
+    if(pUnknownUA != NULL)
+    {
+        coe_addAddend( &A[pUnknownUA->idxRow][pUnknownI->idxCol]
+                     , /* factor */          -1
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
+                     );
+    }
+    if(pUnknownUB != NULL)
+    {
+        coe_addAddend( &A[pUnknownUB->idxRow][pUnknownI->idxCol]
+                     , /* factor */          +1
+                     , /* productOfConsts */ COE_PRODUCT_OF_NO_CONST
+                     );
+    }
+
+    /* The additional equation is the port model. With the admittance Y = N/D of the
+       instance, it reads:
+         D*I - N*U(portA) + N*U(portB) = 0
+       The terms of the voltages disappear if the port is connected to a ground node. */
+    const unsigned int idxEqSuppl = pUnknownI->idxRow;
+    addCoef(&A[idxEqSuppl][pUnknownI->idxCol], /* factor */ +1, pPortModel->pCoefCurrent);
+    if(pUnknownUA != NULL)
+    {
+        addCoef( &A[idxEqSuppl][pUnknownUA->idxCol]
+               , /* factor */ -1
+               , pPortModel->pCoefVoltage
+               );
+    }
+    if(pUnknownUB != NULL)
+    {
+        addCoef( &A[idxEqSuppl][pUnknownUB->idxCol]
+               , /* factor */ +1
+               , pPortModel->pCoefVoltage
+               );
+    }
+} /* End of addPortModelConditions */
+
+
+
+
+/**
+ * Find the constants of those devices, whose value is annotated as numeric, and convert
+ * their admittance into a rational number. A resistor is represented by its conductance,
+ * all other permitted devices by their value.
+ *   @return
+ * \a true if all values could be represented, \a false otherwise. An error has been
+ * reported in this case.
+ *   @param pLES
+ * The LES object under construction. Its table of variables is complete. The members \a
+ * noNumericConstants and \a numericValueOfConstAry are set.
+ */
+
+static boolean findNumericConstants(les_linearEquationSystem_t * const pLES)
+{
+    const tbv_tableOfVariables_t * const pTableOfVars = pLES->pTableOfVars;
+    boolean success = true;
+
+    unsigned int idxConst;
+    for(idxConst=0; success && idxConst<pTableOfVars->noConstants; ++idxConst)
+    {
+        const pci_device_t * const pDev = tbv_getDeviceByBitIndex(pTableOfVars, idxConst);
+        if(!pDev->isNumeric)
+            continue;
+
+        assert(pDev->devRelation.idxDeviceRef == PCI_NULL_DEVICE  &&  pDev->numValue > 0.0
+               &&  pDev->type != pci_devType_capacitor
+               &&  pDev->type != pci_devType_inductivity
+              );
+        if(pLES->numericValueOfConstAry == NULL)
+        {
+            pLES->numericValueOfConstAry = smalloc( pTableOfVars->noConstants
+                                                    * sizeof(rat_num_t)
+                                                  , __FILE__
+                                                  , __LINE__
+                                                  );
+            unsigned int u;
+            for(u=0; u<pTableOfVars->noConstants; ++u)
+                pLES->numericValueOfConstAry[u] = RAT_NULL;
+        }
+
+        rat_clearError();
+        rat_num_t value = rat_fromDouble(pDev->numValue);
+        if(rat_getError()  ||  value.n == 0)
+        {
+            success = false;
+            LOG_ERROR( _log
+                     , "The numeric value %g of device %s (%s) can't be represented as"
+                       " rational number. Please use the symbolic value or a value with"
+                       " fewer significant digits"
+                     , pDev->numValue
+                     , pDev->name
+                     , pci_getNameOfDeviceType(pDev)
+                     )
+        }
+        else
+        {
+            /* The LES uses the conductance of a resistor. */
+            if(pDev->type == pci_devType_resistor)
+                value = (rat_num_t){.n = value.d, .d = value.n};
+
+            pLES->numericValueOfConstAry[idxConst] = value;
+            ++ pLES->noNumericConstants;
+
+            LOG_DEBUG( _log
+                     , "The value of device %s (%s) is substituted as %ld/%ld"
+                     , pDev->name
+                     , pci_getNameOfDeviceType(pDev)
+                     , (signed long)value.n
+                     , (signed long)value.d
+                     )
+        }
+    } /* End for(All constants) */
+
+    rat_clearError();
+    return success;
+
+} /* End of findNumericConstants */
+
+
+
+
+/**
+ * Get the value of the numeric part of an addend of a coefficient: Its factor times the
+ * admittances of all numeric constants, which it contains.
+ *   @return
+ * Get the value. The global error flag of module rat is set in case of an overflow.
+ *   @param pLES
+ * The LES object, which has numeric constants.
+ *   @param pAddend
+ * The addend.
+ *   @param noWords
+ * The number of words of a product of constants.
+ */
+
+static rat_num_t getValueOfAddend( const les_linearEquationSystem_t * const pLES
+                                 , const coe_coefAddend_t * const pAddend
+                                 , unsigned int noWords
+                                 )
+{
+    assert(pAddend->factor != 0);
+    rat_num_t value = {.n = (rat_signed_int)pAddend->factor, .d = 1};
+    const coe_productOfConstWord_t * const productOfConst = pAddend->productOfConst;
+    unsigned int idxConst = coe_findConstInProductOfConst(productOfConst, 0, noWords);
+    while(idxConst != UINT_MAX)
+    {
+        if(pLES->numericValueOfConstAry[idxConst].n != 0)
+            value = rat_mul(value, pLES->numericValueOfConstAry[idxConst]);
+        idxConst = coe_findConstInProductOfConst(productOfConst, idxConst+1, noWords);
+    }
+    return value;
+
+} /* End of getValueOfAddend */
+
+
+
+
+/**
+ * Substitute the numeric constants into the coefficients of the LES. The admittance of a
+ * numeric constant is a rational number. The products of the numeric constants and the
+ * factors of an addend are brought to integers by scaling each equation with the least
+ * common multiple of the denominators of its addends. Scaling an equation doesn't change
+ * the solution of the LES; the substitution is exact.\n
+ *   The constants keep their bit in the products of constants but the bit is no longer
+ * set in any addend.
+ *   @return
+ * \a true if the substituted LES could be represented, \a false in case of an overflow
+ * of the numeric factors. An error has been reported in this case.
+ *   @param pLES
+ * The LES object after setup of all coefficients.
+ */
+
+static boolean substituteNumericConstants(les_linearEquationSystem_t * const pLES)
+{
+    if(pLES->noNumericConstants == 0)
+        return true;
+
+    const tbv_tableOfVariables_t * const pTableOfVars = pLES->pTableOfVars;
+    const unsigned int noRows = pTableOfVars->noUnknowns
+                     , noCols = pTableOfVars->noKnowns + pTableOfVars->noUnknowns
+                     , noWords = coe_getNoWordsOfProduct();
+
+    /* The mask of all numeric constants. */
+    coe_productOfConst_t maskOfNumeric = COE_PRODUCT_OF_NO_CONST;
+    unsigned int idxConst;
+    for(idxConst=0; idxConst<pTableOfVars->noConstants; ++idxConst)
+    {
+        if(pLES->numericValueOfConstAry[idxConst].n != 0)
+        {
+            maskOfNumeric.wordAry[idxConst/COE_NO_CONST_PER_WORD] |=
+                        (coe_productOfConstWord_t)0x1 << (idxConst%COE_NO_CONST_PER_WORD);
+        }
+    }
+
+    boolean success = true;
+    rat_clearError();
+    unsigned int m, n;
+    for(m=0; success && m<noRows; ++m)
+    {
+        /* All addends of the row are scaled with the LCM of their denominators. */
+        rat_signed_int lcm = 1;
+        for(n=0; n<noCols; ++n)
+        {
+            const coe_coefAddend_t *pAddend;
+            for( pAddend=pLES->A[m][n]
+               ; !coe_isCoefAddendNull(pAddend)
+               ; pAddend=pAddend->pNext
+               )
+            {
+                lcm = rat_lcm(lcm, getValueOfAddend(pLES, pAddend, noWords).d);
+            }
+        }
+
+        /* Replace the coefficients of the row. The sum of the magnitudes of the factors
+           of a new coefficient is bounded: Merging addends must not overflow. */
+        boolean isOverflow = rat_getError();
+        coe_numericFactor_t gcd = 0;
+        for(n=0; !isOverflow && n<noCols; ++n)
+        {
+            coe_coef_t *pNewCoef = coe_coefAddendNull();
+            double sumOfAbsFactors = 0.0;
+            const coe_coefAddend_t *pAddend;
+            for( pAddend=pLES->A[m][n]
+               ; !coe_isCoefAddendNull(pAddend)
+               ; pAddend=pAddend->pNext
+               )
+            {
+                const rat_num_t value = rat_mul( getValueOfAddend(pLES, pAddend, noWords)
+                                               , (rat_num_t){.n = lcm, .d = 1}
+                                               );
+                sumOfAbsFactors += fabs((double)value.n);
+                if(rat_getError()  ||  sumOfAbsFactors > (double)(LONG_MAX/2))
+                {
+                    isOverflow = true;
+                    break;
+                }
+                assert(value.d == 1  &&  value.n != 0);
+
+                coe_productOfConst_t productOfConst;
+                unsigned int idxWord;
+                for(idxWord=0; idxWord<noWords; ++idxWord)
+                {
+                    productOfConst.wordAry[idxWord] =
+                        pAddend->productOfConst[idxWord] & ~maskOfNumeric.wordAry[idxWord];
+                }
+                coe_addAddend(&pNewCoef, (coe_numericFactor_t)value.n, productOfConst);
+            }
+
+            coe_freeCoef(pLES->A[m][n]);
+            pLES->A[m][n] = pNewCoef;
+
+            for(pAddend=pNewCoef; !coe_isCoefAddendNull(pAddend); pAddend=pAddend->pNext)
+                gcd = (coe_numericFactor_t)rat_gcd(gcd, pAddend->factor);
+        }
+
+        if(isOverflow)
+        {
+            success = false;
+            LOG_ERROR( _log
+                     , "Numeric overflow while substituting the values of the numeric"
+                       " devices into equation %u of the LES. Please use fewer numeric"
+                       " devices or values with fewer significant digits"
+                     , m
+                     )
+        }
+
+        /* The row is divided by the GCD of its factors to keep them small. */
+        if(success &&  gcd > 1)
+        {
+            for(n=0; n<noCols; ++n)
+            {
+                coe_coefAddend_t *pAddend;
+                for( pAddend=pLES->A[m][n]
+                   ; !coe_isCoefAddendNull(pAddend)
+                   ; pAddend=pAddend->pNext
+                   )
+                {
+                    assert(pAddend->factor % gcd == 0);
+                    pAddend->factor /= gcd;
+                }
+            }
+        }
+    } /* End for(All rows of the LES) */
+
+    rat_clearError();
+    return success;
+
+} /* End of substituteNumericConstants */
+
+
+
+
 /**
  * Initialize the module at application startup.\n
  *   Mainly used to initialize globally accessible heap for LES coefficient objects.
@@ -2233,6 +3063,11 @@ boolean les_createLES( les_linearEquationSystem_t * * const ppLES
 
     pLES->doWarn = true;
     pLES->A = NULL;
+    pLES->noPortModels = 0;
+    pLES->portModelAry = NULL;
+    pLES->idxPortModelOfDevAry = NULL;
+    pLES->noNumericConstants = 0;
+    pLES->numericValueOfConstAry = NULL;
 
     /* Analyse the network topology expressed in the net list representing the circuit and
        transform it into a more useful data structure. */
@@ -2261,23 +3096,37 @@ boolean les_createLES( les_linearEquationSystem_t * * const ppLES
 
     /* pNetwork may be NULL in case of errors. */
 
+    /* Subcircuit instances of passive devices are represented by a port model. */
+    if(success)
+        selectPortModels(pLES, pNetwork);
+
     /* Count the devices, inspect their type and the type of a resulting linear equation
        and determine the sets of knows, unknows and constants. */
     if(success)
-        success = determineReqVariables(&pLES->pTableOfVars, pNetwork);
+        success = determineReqVariables(&pLES->pTableOfVars, pNetwork, pLES);
     else
         pLES->pTableOfVars = NULL;
 
     deleteNetwork(pNetwork);
 
-    /* Allocate space for the coefficients and reset them to null. */
+    /* Allocate space for the coefficients and reset them to null. The representation of
+       the coefficients depends on the number of constants of the circuit. */
     if(success)
     {
+        coe_setNoConstants(pLES->pTableOfVars->noConstants);
+
         const unsigned int noRows = pLES->pTableOfVars->noUnknowns
                          , noCols = pLES->pTableOfVars->noKnowns
                                     + pLES->pTableOfVars->noUnknowns;
 
         pLES->A = coe_createMatrix(noRows, noCols);
+
+        /* The port models can be computed only now that the representation of the
+           coefficients is known. */
+        createPortModels(pLES);
+
+        /* The devices with numeric value are substituted into the LES. */
+        success = findNumericConstants(pLES);
     }
 
     if(!success)
@@ -2319,6 +3168,16 @@ void les_deleteLES(les_linearEquationSystem_t *pLES)
     else
         assert(pLES->A == NULL);
 
+    unsigned int idxPortModel;
+    for(idxPortModel=0; idxPortModel<pLES->noPortModels; ++idxPortModel)
+    {
+        coe_freeCoef(pLES->portModelAry[idxPortModel].pCoefCurrent);
+        coe_freeCoef(pLES->portModelAry[idxPortModel].pCoefVoltage);
+    }
+    free(pLES->portModelAry);
+    free(pLES->idxPortModelOfDevAry);
+    free(pLES->numericValueOfConstAry);
+
     free(pLES);
 
 } /* End of les_deleteLES */
@@ -2470,9 +3329,24 @@ boolean les_setupLES( les_linearEquationSystem_t * const pLES
            same object: It would always be the same, repeated information. */
         pLES->doWarn = false;
 
+        /* The devices of the subcircuit instances, which are represented by a port model,
+           are not added individually. */
         unsigned int idxDev;
         for(idxDev=0; success && idxDev<pCircuitNetList->noDevices; ++idxDev)
-            addDeviceConditions(pLES->A, pTableOfVars, idxDev);
+        {
+            if(pLES->idxPortModelOfDevAry == NULL
+               ||  pLES->idxPortModelOfDevAry[idxDev] == UINT_MAX
+              )
+            {
+                addDeviceConditions(pLES->A, pTableOfVars, idxDev);
+            }
+        }
+        unsigned int idxPortModel;
+        for(idxPortModel=0; idxPortModel<pLES->noPortModels; ++idxPortModel)
+            addPortModelConditions(pLES->A, pTableOfVars, &pLES->portModelAry[idxPortModel]);
+
+        /* The devices with numeric value are no longer represented by their constant. */
+        success = substituteNumericConstants(pLES);
 
         /* Double-check, that all coefficients are in the right order of their addends.
            The implementation of the solver depends on that. */
@@ -29,6 +29,7 @@
 #include "coe_coefficient.h"
 #include "pci_parserCircuit.h"
 #include "tbv_tableOfVariables.h"
+#include "rat_rationalNumber.h"
 
 
 /*
@@ -43,6 +44,9 @@
 /** Forward declaration of a hidden data type. */
 struct les_network_s;
 
+/** Forward declaration of a hidden data type, the port model of a subcircuit instance. */
+struct les_portModel_s;
+
 /** The data structure that holds the linear equations system that describes the ideal
     linear behavior of the electric circuit. */
 typedef struct
@@ -58,6 +62,27 @@ typedef struct
         informative and warning output should not be done repeatedly. The next (internal)
         flag indicates to the validation algorithms if output should take place. */
     boolean doWarn;
+
+    /** The number of subcircuit instances, which are represented in the LES by a port
+        model rather than by their devices and internal nodes. */
+    unsigned int noPortModels;
+
+    /** The port models of these instances or NULL if there are none. */
+    struct les_portModel_s *portModelAry;
+
+    /** A map from the devices of the circuit onto the port models, which represent them,
+        or UINT_MAX for a device, which is represented individually. NULL if there are no
+        port models. */
+    unsigned int *idxPortModelOfDevAry;
+
+    /** The number of constants of devices with numeric value. These constants are
+        substituted into the coefficients before the elimination. */
+    unsigned int noNumericConstants;
+
+    /** The admittance of each constant as rational number if it belongs to a device with
+        numeric value, RAT_NULL for all symbolic constants. NULL if there are no numeric
+        constants. */
+    rat_num_t *numericValueOfConstAry;
     
 } les_linearEquationSystem_t;
 
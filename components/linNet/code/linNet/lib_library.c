@@ -0,0 +1,723 @@
+/**
+ * @file lib_library.c
+ *   The programming interface of linNet as a library. An embedding application passes a
+ * netlist as text in memory and gets the symbolic results in the frequency domain and
+ * their numeric evaluation for chosen frequencies and device values. No files are read or
+ * written besides an optional log file.\n
+ *   All state of the computation is held in a context object. A context owns the logger
+ * and the initialized instances of the modules, which process a circuit. The data of these
+ * modules is thread-local, which is why a context belongs to the thread, which has
+ * created it: The thread can create only one context at a time and all calls of this
+ * interface, which refer to the context, need to be made by this thread. Different threads
+ * can create their own contexts and compute circuits in parallel without any
+ * synchronization, like the jobs of a parallel batch run of the linNet application do.\n
+ *   The library consists of all modules of linNet but the main module lin_linNet.c. The
+ * process needs to call lib_initModule once before the first context is created and
+ * lib_shutdownModule after the last context has been deleted.
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   lib_initModule
+ *   lib_shutdownModule
+ *   lib_createContext
+ *   lib_deleteContext
+ *   lib_computeCircuit
+ *   lib_deleteCircuit
+ *   lib_getDimensionsOfResult
+ *   lib_getNameOfConstant
+ *   lib_evaluateResult
+ * Local functions
+ *   initModules
+ *   shutdownModules
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "smalloc.h"
+#include "log_logger.h"
+#include "rat_rationalNumber.h"
+#include "pci_parserCircuit.h"
+#include "tbv_tableOfVariables.h"
+#include "coe_coefficient.h"
+#include "les_linearEquationSystem.h"
+#include "sol_solver.h"
+#include "frq_freqDomainSolution.h"
+#include "frq_freqDomainSolution.inlineInterface.h"
+#include "nsl_numericSolver.h"
+#include "nfr_numericFreqResponse.h"
+#include "msc_mScript.h"
+#include "prf_performanceReport.h"
+#include "lib_library.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Local type definitions
+ */
+
+/** A context: the logger, which is shared by all modules, which process a circuit. The
+    modules themselves keep their state in thread-local data. */
+typedef struct lib_context_t
+{
+    /** The logger of the context. */
+    log_hLogger_t hLog;
+
+    /** The context works in incremental mode. */
+    boolean incremental;
+
+    /** The circuits are solved by the numeric solver. */
+    boolean numeric;
+
+    /** In incremental mode: The hash code of the network of \a pPrevSolution, see
+        pci_getHashOfNetwork. */
+    unsigned long long hashOfNetwork;
+
+    /** In incremental mode: The solution of the most recently solved network or NULL. */
+    const sol_solution_t *pPrevSolution;
+
+} lib_context_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The context, which is owned by the calling thread, or NULL if it has none. */
+static THREAD_LOCAL lib_context_t *_pContextOfThread = NULL;
+
+#ifdef DEBUG
+/** A global counter of all references to any created objects. Used to detect memory leaks. */
+static THREAD_LOCAL unsigned int _noRefsToObjects = 0;
+#endif
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Initialize all the modules, which process a circuit. This is the same set of modules as
+ * used by the linNet application.
+ *   @param hLogger
+ * The modules write all their progress messages into this logger.
+ *   @param pOptions
+ * The options of the context. They hold the number of threads of the solver, its resource
+ * budget and the error bound of approximated frequency domain results.
+ */
+
+static void initModules(log_hLogger_t hLogger, const lib_options_t * const pOptions)
+{
+    const sol_resourceBudget_t budget =
+                                { .maxNoAddendsOfCoef = pOptions->maxNoAddendsOfCoef
+                                , .maxNoAddendsOfHeap = pOptions->maxNoAddendsOfHeap
+                                , .maxWallTime = pOptions->maxWallTime
+                                };
+    pci_initModule();
+    rat_initModule(hLogger);
+    coe_initModule(hLogger);
+    tbv_initModule(hLogger);
+    les_initModule(hLogger);
+    sol_initModule(hLogger, pOptions->noThreads, &budget);
+    nsl_initModule(hLogger, pOptions->noThreads);
+    frq_initModule(hLogger, pOptions->approximationErrorBound);
+    nfr_initModule(hLogger);
+    msc_initModule(hLogger);
+    prf_initModule(hLogger);
+
+} /* End of initModules */
+
+
+
+
+/**
+ * Final cleanup by the modules, which had been initialized by initModules.
+ */
+
+static void shutdownModules()
+{
+    prf_shutdownModule();
+    msc_shutdownModule();
+    nfr_shutdownModule();
+    frq_shutdownModule();
+    nsl_shutdownModule();
+    sol_shutdownModule();
+    les_shutdownModule();
+    tbv_shutdownModule();
+    coe_shutdownModule();
+    rat_shutdownModule();
+    pci_shutdownModule();
+
+} /* End of shutdownModules */
+
+
+
+
+/**
+ * Initialize the module at application startup. This needs to be done once per process,
+ * prior to the creation of the first context in any thread.
+ */
+
+void lib_initModule()
+{
+    log_initModule();
+
+} /* End of lib_initModule */
+
+
+
+
+/**
+ * Do all cleanup after use of the module, which is required to avoid memory leaks,
+ * orphaned handles, etc. Call it once per process after all contexts have been deleted.
+ */
+
+void lib_shutdownModule()
+{
+    log_shutdownModule();
+
+} /* End of lib_shutdownModule */
+
+
+
+
+/**
+ * Create a new context for the calling thread. The modules, which process a circuit, are
+ * initialized for this thread.
+ *   @return
+ * True if the context could be created. False if the log file couldn't be opened or if
+ * the calling thread already owns a context; no context is returned in this case.
+ *   @param phContext
+ * The handle of the new context is placed into * \a phContext. The context is owned by
+ * the calling thread and it must be deleted by this thread with lib_deleteContext.
+ *   @param pOptions
+ * The options of the context by reference or NULL to use #LIB_DEFAULT_OPTIONS. The
+ * object is no longer used after return.
+ *   @remark
+ * The calling thread must not already own a context. The attempt to create a second one
+ * is reported as error in the log of the existing context.
+ */
+
+boolean lib_createContext( lib_hContext_t * const phContext
+                         , const lib_options_t * const pOptions
+                         )
+{
+    /* The data of the modules is thread-local. A second context of the same thread would
+       share it with the first one. */
+    if(_pContextOfThread != NULL)
+    {
+        LOG_ERROR( _pContextOfThread->hLog
+                 , "A thread can't own more than one context of the linNet library. The"
+                   " existing context needs to be deleted before a new one is created"
+                 )
+        *phContext = NULL;
+        return false;
+    }
+
+    const lib_options_t defaultOptions = LIB_DEFAULT_OPTIONS;
+    const lib_options_t * const pOpt = pOptions != NULL? pOptions: &defaultOptions;
+
+    log_hLogger_t hLog = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+    if(!log_createLogger( &hLog
+                        , pOpt->logFileName
+                        , log_result
+                        , log_fmtLong
+                        , pOpt->echoToConsole
+                        , /* doAppend */ false
+                        )
+      )
+    {
+        log_deleteLogger(hLog);
+        *phContext = NULL;
+        return false;
+    }
+    if(pOpt->logLevel != NULL)
+        log_parseLogLevel(hLog, pOpt->logLevel);
+
+    lib_context_t * const pContext = smalloc(sizeof(lib_context_t), __FILE__, __LINE__);
+    pContext->hLog = hLog;
+    pContext->incremental = pOpt->incremental  &&  !pOpt->numeric;
+    pContext->numeric = pOpt->numeric;
+    pContext->hashOfNetwork = 0;
+    pContext->pPrevSolution = NULL;
+    initModules(hLog, pOpt);
+    _pContextOfThread = pContext;
+
+#ifdef DEBUG
+    ++ _noRefsToObjects;
+#endif
+
+    *phContext = pContext;
+    return true;
+
+} /* End of lib_createContext */
+
+
+
+
+/**
+ * Delete a context after use. The modules, which process a circuit, are shut down for the
+ * calling thread and the log file is closed.
+ *   @param hContext
+ * The context to delete. All circuits, which have been computed in this context, need to
+ * be deleted before. The call is ignored if NULL is passed.
+ *   @remark
+ * The function needs to be called by the thread, which has created the context.
+ */
+
+void lib_deleteContext(lib_hContext_t hContext)
+{
+    if(hContext == NULL)
+        return;
+
+    assert(hContext == _pContextOfThread);
+    sol_deleteSolution(hContext->pPrevSolution);
+    shutdownModules();
+    log_deleteLogger(hContext->hLog);
+    free(hContext);
+    _pContextOfThread = NULL;
+
+#ifdef DEBUG
+    /* The DEBUG compilation looks for still allocated objects in order to detect memory
+       leaks. */
+    assert(_noRefsToObjects > 0);
+    if(--_noRefsToObjects != 0)
+    {
+        fprintf( stderr
+               , "lib_deleteContext: %u references to objects of type"
+                 " lib_circuit_t have not been discarded before the context has been"
+                 " deleted. There are probable memory leaks\n"
+               , _noRefsToObjects
+               );
+    }
+#endif
+} /* End of lib_deleteContext */
+
+
+
+
+/**
+ * Parse and solve a circuit, which is held in memory as text. All results, which are
+ * defined in the netlist, are computed in the frequency domain and compiled for numeric
+ * evaluation. The processing is the same as of a circuit file by the linNet application;
+ * progress messages, warnings and errors are written into the log of the context.\n
+ *   In incremental mode, the solution of the LES is not computed if the circuit has the
+ * same network as the previously solved one. Only its user-defined voltages and results
+ * are computed.\n
+ *   In numeric mode, the LES is solved by the numeric solver for the nominal values of
+ * the device constants. No results in the frequency domain are returned, only the
+ * evaluation plans.
+ *   @return
+ * True if all results could be computed, false if the netlist contains errors or if the
+ * solver failed. Nothing is returned in this case; see the log for the reason.
+ *   @param hContext
+ * The context of the calling thread.
+ *   @param ppCircuit
+ * The pointer to the results is placed in * \a ppCircuit. The results need to be deleted
+ * with lib_deleteCircuit after use. The returned pointer is valid only if the function
+ * returns true.\n
+ *   The results in the frequency domain, which are found in the returned object, can be
+ * used with the global interface of module frq_freqDomainSolution.c.
+ *   @param circuitName
+ * The name of the circuit. It is used for logging and it decides about the format like
+ * the name of a circuit file does: A name with extension .ckt selects the elder, case
+ * insensitive format.
+ *   @param netlist
+ * The text of the circuit in the syntax of a circuit file. It doesn't need to be null
+ * terminated. The buffer is no longer used after return.
+ *   @param sizeOfNetlist
+ * The number of characters in \a netlist.
+ *   @remark
+ * The function needs to be called by the thread, which has created the context.
+ */
+
+boolean lib_computeCircuit( lib_hContext_t hContext
+                          , const lib_circuit_t * * const ppCircuit
+                          , const char * const circuitName
+                          , const char * const netlist
+                          , size_t sizeOfNetlist
+                          )
+{
+    assert(hContext != NULL  &&  hContext == _pContextOfThread  &&  circuitName != NULL);
+    log_hLogger_t hLog = hContext->hLog;
+
+    /* Parse the netlist and generate a net list object. */
+    const pci_circuit_t *pParseResult = NULL;
+    boolean success = pci_parseCircuitBuffer( hLog
+                                            , &pParseResult
+                                            , circuitName
+                                            , netlist
+                                            , sizeOfNetlist
+                                            );
+
+    /* In incremental mode, the kept solution is deleted if the network has changed. This
+       needs to be done prior to creating the new LES, which may change the
+       representation of coefficients. */
+    unsigned long long hashOfNetwork = 0;
+    if(success  &&  hContext->incremental)
+    {
+        hashOfNetwork = pci_getHashOfNetwork(pParseResult);
+        if(hContext->pPrevSolution != NULL  &&  hContext->hashOfNetwork != hashOfNetwork)
+        {
+            sol_deleteSolution(hContext->pPrevSolution);
+            hContext->pPrevSolution = NULL;
+        }
+    }
+
+    /* Create a linear equation system object from the parse result and solve it. In
+       incremental mode, the solution of the previous circuit is reused if possible. */
+    les_linearEquationSystem_t *pLES = NULL;
+    if(success)
+        success = les_createLES(&pLES, pParseResult);
+    const sol_solution_t *pSolution = NULL;
+    const nsl_numericSolution_t *pNumSolution = NULL;
+    if(success  &&  hContext->numeric)
+        success = nsl_createSolution(&pNumSolution, pLES);
+    else if(success)
+    {
+        boolean isReused = false;
+        if(hContext->incremental  &&  hContext->pPrevSolution != NULL)
+        {
+            isReused = sol_createSolutionFromPrevious( &pSolution
+                                                     , pLES
+                                                     , hContext->pPrevSolution
+                                                     );
+        }
+        if(!isReused)
+        {
+            success = sol_createSolution(&pSolution, pLES);
+            if(success  &&  hContext->incremental)
+            {
+                sol_deleteSolution(hContext->pPrevSolution);
+                hContext->pPrevSolution = sol_cloneByConstReference(pSolution);
+                hContext->hashOfNetwork = hashOfNetwork;
+            }
+        }
+    }
+    les_deleteLES(pLES);
+    pLES = NULL;
+
+    lib_circuit_t *pCircuit = NULL;
+    if(success)
+    {
+        if(!hContext->numeric)
+            sol_logSolution(pSolution, /* logLevel */ log_info);
+
+        /* Without user-defined results the generic result of all unknowns, index -1, is
+           the only one. */
+        const unsigned int noResultDefs = pParseResult->noResultDefs;
+        pCircuit = smalloc(sizeof(lib_circuit_t), __FILE__, __LINE__);
+        pCircuit->name = stralloccpy(circuitName);
+        pCircuit->noResults = noResultDefs > 0? noResultDefs: 1;
+        pCircuit->resultAry = smalloc( pCircuit->noResults * sizeof(pCircuit->resultAry[0])
+                                     , __FILE__
+                                     , __LINE__
+                                     );
+        pCircuit->planAry = smalloc( pCircuit->noResults * sizeof(pCircuit->planAry[0])
+                                   , __FILE__
+                                   , __LINE__
+                                   );
+        if(noResultDefs == 0)
+        {
+            LOG_WARN( hLog
+                    , "No user-defined result found in circuit %s. The solution for all"
+                      " dependent quantities is figured out instead. This generic result"
+                      " can become very bulky"
+                    , circuitName
+                    )
+        }
+
+        /* All results are derived from the same algebraic solution. They share the
+           transformed numerators and the common denominator through a cache. */
+        frq_expressionCache_t * const pExprCache = hContext->numeric
+                                                   ? NULL
+                                                   : frq_createExpressionCache(pSolution);
+        unsigned int u;
+        for(u=0; u<pCircuit->noResults; ++u)
+        {
+            const signed int idxResult = noResultDefs > 0? (signed int)u: -1;
+            pCircuit->planAry[u] = NULL;
+            if(hContext->numeric)
+            {
+                /* The numeric result is only needed to compile the evaluation plan. */
+                pCircuit->resultAry[u] = NULL;
+                const nsl_numericResult_t *pNumResult = NULL;
+                if(success)
+                    success = nsl_createResult(&pNumResult, pNumSolution, idxResult);
+                if(success)
+                {
+                    nsl_logResult(pNumResult, hLog, /* logLevel */ log_result);
+                    pCircuit->planAry[u] = nfr_createEvaluationPlanOfNumericResult
+                                                                            (pNumResult);
+                }
+                nsl_deleteResult(pNumResult);
+            }
+            else
+            {
+                if(success)
+                {
+                    success = frq_createFreqDomainSolution( &pCircuit->resultAry[u]
+                                                          , pSolution
+                                                          , idxResult
+                                                          , pExprCache
+                                                          );
+                }
+                else
+                    pCircuit->resultAry[u] = NULL;
+
+                if(success)
+                {
+                    frq_logFreqDomainSolution( pCircuit->resultAry[u]
+                                             , hLog
+                                             , /* logLevel */ log_result
+                                             );
+                    pCircuit->planAry[u] =
+                                        nfr_createEvaluationPlan(pCircuit->resultAry[u]);
+                }
+            }
+        }
+        frq_deleteExpressionCache(pExprCache);
+
+#ifdef DEBUG
+        ++ _noRefsToObjects;
+#endif
+    } /* End if(Algebraic solution is available?) */
+
+    pci_deleteParseResult(pParseResult);
+    sol_deleteSolution(pSolution);
+    nsl_deleteSolution(pNumSolution);
+
+    if(!success)
+    {
+        /* A partially computed set of results is discarded. */
+        lib_deleteCircuit(hContext, pCircuit);
+        pCircuit = NULL;
+    }
+
+    *ppCircuit = pCircuit;
+    return success;
+
+} /* End of lib_computeCircuit */
+
+
+
+
+/**
+ * Delete the results of a circuit after use.
+ *   @param hContext
+ * The context, in which the circuit had been computed.
+ *   @param pCircuit
+ * The results as got from lib_computeCircuit. The call is ignored if NULL is passed.
+ *   @remark
+ * The function needs to be called by the thread, which has created the context.
+ */
+
+void lib_deleteCircuit(lib_hContext_t hContext, const lib_circuit_t * const pCircuit)
+{
+    /* The context is checked only in DEBUG compilation. */
+    (void)hContext;
+    assert(hContext != NULL  &&  hContext == _pContextOfThread);
+    if(pCircuit == NULL)
+        return;
+
+    unsigned int u;
+    for(u=0; u<pCircuit->noResults; ++u)
+    {
+        /* Deletion of NULL objects is permitted for both kinds of objects. */
+        nfr_deleteEvaluationPlan(pCircuit->planAry[u]);
+        frq_deleteFreqDomainSolution(pCircuit->resultAry[u]);
+    }
+    free((void*)pCircuit->planAry);
+    free((void*)pCircuit->resultAry);
+    free((char*)pCircuit->name);
+    free((lib_circuit_t*)pCircuit);
+
+#ifdef DEBUG
+    assert(_noRefsToObjects > 0);
+    -- _noRefsToObjects;
+#endif
+} /* End of lib_deleteCircuit */
+
+
+
+
+/**
+ * Get the dimensions of a result, which determine the sizes of the arrays passed to
+ * lib_evaluateResult. The result objects themselves are opaque to the client.
+ *   @param hContext
+ * The context, in which the circuit had been computed.
+ *   @param pCircuit
+ * The results of the circuit as got from lib_computeCircuit.
+ *   @param idxResult
+ * The index of the result in * \a pCircuit.
+ *   @param pNoDependents
+ * The number of dependent quantities of the result is placed into * \a pNoDependents.
+ *   @param pNoIndependents
+ * The number of independent quantities of the result is placed into * \a
+ * pNoIndependents.
+ *   @param pNoConstants
+ * The number of device constants, which is the length of the vector of values passed to
+ * lib_evaluateResult, is placed into * \a pNoConstants.
+ *   @remark
+ * The function needs to be called by the thread, which has created the context.
+ */
+
+void lib_getDimensionsOfResult( lib_hContext_t hContext
+                              , const lib_circuit_t * const pCircuit
+                              , unsigned int idxResult
+                              , unsigned int * const pNoDependents
+                              , unsigned int * const pNoIndependents
+                              , unsigned int * const pNoConstants
+                              )
+{
+    (void)hContext;
+    assert(hContext != NULL  &&  hContext == _pContextOfThread);
+    assert(pCircuit != NULL  &&  idxResult < pCircuit->noResults);
+
+    const nfr_evaluationPlan_t * const pPlan = pCircuit->planAry[idxResult];
+    *pNoDependents = pPlan->noDependents;
+    *pNoIndependents = pPlan->noIndependents;
+    *pNoConstants = pPlan->noConst;
+
+} /* End of lib_getDimensionsOfResult */
+
+
+
+
+/**
+ * Get the name of a device constant of a result. The names tell the order of the values
+ * passed to lib_evaluateResult.
+ *   @return
+ * The name of the device, which the constant belongs to. The string is owned by the
+ * circuit and valid until lib_deleteCircuit.
+ *   @param hContext
+ * The context, in which the circuit had been computed.
+ *   @param pCircuit
+ * The results of the circuit as got from lib_computeCircuit.
+ *   @param idxResult
+ * The index of the result in * \a pCircuit.
+ *   @param idxConst
+ * The index of the constant, less than the number of constants got from
+ * lib_getDimensionsOfResult.
+ *   @remark
+ * The function needs to be called by the thread, which has created the context.
+ */
+
+const char *lib_getNameOfConstant( lib_hContext_t hContext
+                                 , const lib_circuit_t * const pCircuit
+                                 , unsigned int idxResult
+                                 , unsigned int idxConst
+                                 )
+{
+    (void)hContext;
+    assert(hContext != NULL  &&  hContext == _pContextOfThread);
+    assert(pCircuit != NULL  &&  idxResult < pCircuit->noResults);
+
+    const nfr_evaluationPlan_t * const pPlan = pCircuit->planAry[idxResult];
+    assert(idxConst < pPlan->noConst);
+    return tbv_getDeviceByBitIndex(pPlan->pTableOfVars, idxConst)->name;
+
+} /* End of lib_getNameOfConstant */
+
+
+
+
+/**
+ * Evaluate all transfer functions of a result numerically for a vector of frequencies and
+ * a set of values of the device constants.
+ *   @param hContext
+ * The context, in which the circuit had been computed.
+ *   @param pCircuit
+ * The results of the circuit as got from lib_computeCircuit.
+ *   @param idxResult
+ * The index of the evaluated result in * \a pCircuit.
+ *   @param valueOfConstAry
+ * The values of the device constants in the order of the table of variables of the
+ * result, see lib_getNameOfConstant. Pass NULL to use the nominal values from the
+ * netlist.
+ *   @param noPoints
+ * The number of frequencies.
+ *   @param omegaAry
+ * The \a noPoints circular frequencies in rad/s.
+ *   @param reAry
+ * The real parts of the results are written into this array. It has
+ * noDependents*noIndependents*\a noPoints elements; element (i*noIndependents+j)*noPoints+k
+ * is the transfer function from independent j to dependent i at frequency k.
+ *   @param imAry
+ * The imaginary parts of the results, laid out like \a reAry.
+ *   @remark
+ * The function needs to be called by the thread, which has created the context.
+ */
+
+void lib_evaluateResult( lib_hContext_t hContext
+                       , const lib_circuit_t * const pCircuit
+                       , unsigned int idxResult
+                       , const double valueOfConstAry[]
+                       , unsigned int noPoints
+                       , const double omegaAry[]
+                       , double reAry[]
+                       , double imAry[]
+                       )
+{
+    /* The context is checked only in DEBUG compilation; the evaluation plan doesn't
+       depend on the modules of the context. */
+    (void)hContext;
+    assert(hContext != NULL  &&  hContext == _pContextOfThread);
+    assert(pCircuit != NULL  &&  idxResult < pCircuit->noResults);
+
+    const nfr_evaluationPlan_t * const pPlan = pCircuit->planAry[idxResult];
+    if(valueOfConstAry == NULL)
+    {
+        double nominalValueAry[pPlan->noConst > 0? pPlan->noConst: 1];
+        nfr_getNominalValues(pPlan, nominalValueAry);
+        nfr_evaluatePlan( pPlan
+                        , /* noParamSets */ 1
+                        , nominalValueAry
+                        , noPoints
+                        , omegaAry
+                        , reAry
+                        , imAry
+                        );
+    }
+    else
+    {
+        nfr_evaluatePlan( pPlan
+                        , /* noParamSets */ 1
+                        , valueOfConstAry
+                        , noPoints
+                        , omegaAry
+                        , reAry
+                        , imAry
+                        );
+    }
+} /* End of lib_evaluateResult */
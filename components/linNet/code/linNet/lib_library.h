@@ -0,0 +1,196 @@
+#ifndef LIB_LIBRARY_INCLUDED
+#define LIB_LIBRARY_INCLUDED
+/**
+ * @file lib_library.h
+ * Definition of global interface of module lib_library.c
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stddef.h>
+
+#include "types.h"
+
+
+/*
+ * Defines
+ */
+
+/** The default options of a context. Use this expression to initialize an object of type
+    lib_options_t and modify the options of interest afterwards. */
+#define LIB_DEFAULT_OPTIONS                                                                 \
+            { .logFileName = NULL                                                           \
+            , .echoToConsole = false                                                        \
+            , .logLevel = NULL                                                              \
+            , .noThreads = 1                                                                \
+            , .approximationErrorBound = 0.0                                                \
+            , .maxNoAddendsOfCoef = 0                                                       \
+            , .maxNoAddendsOfHeap = 0                                                       \
+            , .maxWallTime = 0                                                              \
+            , .incremental = false                                                          \
+            , .numeric = false                                                              \
+            }
+
+
+/*
+ * Global type definitions
+ */
+
+/** The options of a context. They have the meaning of the command line options of the
+    linNet application of same name. */
+typedef struct lib_options_t
+{
+    /** The name of the log file or NULL if no log file is written. */
+    const char *logFileName;
+
+    /** Logging is done to the log file and to the console. */
+    boolean echoToConsole;
+
+    /** The verbosity level of logging as a name like "WARN" or NULL for the default
+        level RESULT. */
+    const char *logLevel;
+
+    /** The number of threads, which are used by the solver. */
+    unsigned int noThreads;
+
+    /** The relative error bound of the approximated results in the range ]0, 1[ or null
+        if the results are exact. */
+    double approximationErrorBound;
+
+    /** The maximum number of addends of a coefficient of the LES or null for no limit. */
+    unsigned int maxNoAddendsOfCoef;
+
+    /** The maximum number of addends of coefficients, which a thread of the solver may
+        hold, or null for no limit. */
+    unsigned long maxNoAddendsOfHeap;
+
+    /** The maximum wall-clock time in seconds of the solution of a circuit or null for no
+        limit. */
+    unsigned int maxWallTime;
+
+    /** The solution of a circuit is kept and reused for the next circuit, which is
+        computed in the context, if both have the same network. */
+    boolean incremental;
+
+    /** The circuits are solved by the numeric solver for the nominal values of the
+        device constants. The approximation, the resource limits and the incremental
+        mode have no effect in this mode. */
+    boolean numeric;
+
+} lib_options_t;
+
+
+/** The handle of a context. The type is opaque to the client. */
+typedef struct lib_context_t *lib_hContext_t;
+
+
+/* The results are objects of the modules frq_freqDomainSolution and
+   nfr_numericFreqResponse. They are opaque to the client; their headers are not part of
+   the public interface as they include the header of the linNet application with its
+   main function. */
+struct frq_freqDomainSolution_t;
+struct nfr_evaluationPlan_t;
+
+
+/** The computed results of a circuit. */
+typedef struct lib_circuit_t
+{
+    /** The name of the circuit as passed to lib_computeCircuit. */
+    const char *name;
+
+    /** The number of results. It is the number of result definitions in the netlist or
+        one if there are none; the only result is then the generic one of all unknowns. */
+    unsigned int noResults;
+
+    /** The results in the frequency domain, one for each result definition in order of
+        their appearance in the netlist. All entries are NULL if the circuit has been
+        computed by the numeric solver. */
+    const struct frq_freqDomainSolution_t * *resultAry;
+
+    /** For each result: The evaluation plan, which is used by lib_evaluateResult. The plan
+        of a numerically computed result has fixed coefficients; it ignores the values of
+        the device constants. */
+    const struct nfr_evaluationPlan_t * *planAry;
+
+} lib_circuit_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize the module prior to first use of any of its methods or global data objects. */
+void lib_initModule(void);
+
+/** Shutdown of module after use. Release of memory, closing files, etc. */
+void lib_shutdownModule(void);
+
+/** Create a new context for the calling thread. */
+boolean lib_createContext( lib_hContext_t * const phContext
+                         , const lib_options_t * const pOptions
+                         );
+
+/** Delete a context after use. */
+void lib_deleteContext(lib_hContext_t hContext);
+
+/** Parse and solve a circuit, which is held in memory as text. */
+boolean lib_computeCircuit( lib_hContext_t hContext
+                          , const lib_circuit_t * * const ppCircuit
+                          , const char * const circuitName
+                          , const char * const netlist
+                          , size_t sizeOfNetlist
+                          );
+
+/** Delete the results of a circuit after use. */
+void lib_deleteCircuit(lib_hContext_t hContext, const lib_circuit_t * const pCircuit);
+
+/** Get the dimensions of a result, which are needed to evaluate it. */
+void lib_getDimensionsOfResult( lib_hContext_t hContext
+                              , const lib_circuit_t * const pCircuit
+                              , unsigned int idxResult
+                              , unsigned int * const pNoDependents
+                              , unsigned int * const pNoIndependents
+                              , unsigned int * const pNoConstants
+                              );
+
+/** Get the name of a device constant of a result. */
+const char *lib_getNameOfConstant( lib_hContext_t hContext
+                                 , const lib_circuit_t * const pCircuit
+                                 , unsigned int idxResult
+                                 , unsigned int idxConst
+                                 );
+
+/** Evaluate the transfer functions of a result for a vector of frequencies. */
+void lib_evaluateResult( lib_hContext_t hContext
+                       , const lib_circuit_t * const pCircuit
+                       , unsigned int idxResult
+                       , const double valueOfConstAry[]
+                       , unsigned int noPoints
+                       , const double omegaAry[]
+                       , double reAry[]
+                       , double imAry[]
+                       );
+
+#endif  /* LIB_LIBRARY_INCLUDED */
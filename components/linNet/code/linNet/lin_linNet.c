@@ -21,15 +21,30 @@
  *   main
  * Local functions
  *   getTimeStr
+ *   composeLogFileName
  *   getLogFileName
+ *   configureLogger
+ *   initModules
+ *   shutdownModules
  *   makeOctaveOutputDir
+ *   solveNumerically
  *   processInputFile
+ *   processJob
+ *   processInputFilesInParallel
+ *   readLine
+ *   parseRequest
+ *   serveRequests
  */
 
 /*
  * Include files
  */
 
+/* The reentrant function ctime_r is a POSIX extension of the C library. */
+#ifdef __unix__
+# define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <sys/stat.h>
@@ -38,6 +53,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <time.h>
+#include <limits.h>
 #include <assert.h>
 
 #include "log_logger.h"
@@ -50,8 +66,13 @@
 #include "coe_coefficient.h"
 #include "les_linearEquationSystem.h"
 #include "frq_freqDomainSolution.h"
+#include "nfr_numericFreqResponse.h"
+#include "prf_performanceReport.h"
 #include "msc_mScript.h"
+#include "spt_spanningTreeSolver.h"
 #include "sol_solver.h"
+#include "nsl_numericSolver.h"
+#include "thp_threadPool.h"
 #include "opt_getOpt.h"
 #include "lin_linNet.h"
 
@@ -67,11 +88,98 @@
 # define SL "/"
 #endif
 
+/** Each line, which the server writes to stdout, begins with this tag. It separates the
+    status lines from the greeting and from the echo of the log on the console. */
+#define SERVER_RESPONSE_TAG     LIN_APP_NAME ":"
+
+/** The request, which terminates the server. */
+#define SERVER_REQUEST_QUIT     "quit"
+
 
 /*
  * Local type definitions
  */
 
+/** A job of a parallel batch run: the processing of one of the input files. */
+typedef struct job_t
+{
+    /** The name of the circuit file to process. */
+    const char *circuitFileName;
+
+    /** The name of the log file of the job as malloc allocated string or NULL if no log
+        file is used. */
+    const char *logFileName;
+
+    /** The job couldn't open its log file. */
+    boolean cantOpenLogFile;
+
+    /** The circuit file has been processed successfully. */
+    boolean success;
+
+    /** The index of an earlier job, whose circuit file has the same name, or UINT_MAX if
+        there's none. Both jobs would write the same log and output files at the same time;
+        the job is not run. */
+    unsigned int idxJobOfSameName;
+
+} job_t;
+
+
+/** The common data of all jobs of a parallel batch run. */
+typedef struct batch_t
+{
+    /** The result of the command line parsing. */
+    const opt_cmdLineOptions_t *pCmdLine;
+
+    /** The jobs, one for each input file. */
+    job_t *jobAry;
+
+} batch_t;
+
+
+/** The solution of the most recently solved network. It is kept in incremental mode for
+    reuse by the next circuit, which has the same network. */
+typedef struct prevSolution_t
+{
+    /** The hash code of the network of the solution, see pci_getHashOfNetwork. */
+    unsigned long long hashOfNetwork;
+
+    /** The solution or NULL if no solution has been kept yet. */
+    const sol_solution_t *pSolution;
+
+} prevSolution_t;
+
+
+/** A request to the server: A circuit file and the options, which control its output. The
+    options have the meaning of the command line options of same name. */
+typedef struct request_t
+{
+    /** The name of the circuit file to process. */
+    const char *circuitFileName;
+
+    /** The name and path of the Octave output folder or NULL. */
+    const char *octaveOutputPath;
+
+    /** Generated Octave output doesn't comprise static, problem independent parts of
+        scripting. */
+    boolean dontCopyPrivateOctaveScripts;
+
+    /** The transfer functions are written as binary data files for the Octave code. */
+    boolean binaryOctaveData;
+
+    /** The transfer functions are written in factored form into the Octave code. */
+    boolean factoredOctaveCode;
+
+    /** The name and path of the output folder for the frequency responses or NULL. */
+    const char *freqResponsePath;
+
+    /** The name and path of the folder, which holds the cache of solutions, or NULL. */
+    const char *cachePath;
+
+    /** The name and path of the output folder for the performance report or NULL. */
+    const char *perfReportPath;
+
+} request_t;
+
 
 /*
  * Local prototypes
@@ -97,9 +205,9 @@ const char *_installDir = NULL;
  * Get the current system time as printable string.
  *   @return
  * The time string is returned. The returned pointer is valid until next entry into this
- * function.
+ * function from the same thread.
  *   @remark
- * The function is not reentrant but uses static memory to store the time information.
+ * The function uses thread-local static memory to store the time information.
  */
 
 static const char *getTimeStr()
@@ -107,11 +215,16 @@ static const char *getTimeStr()
     /* Get current time as string of fixed length. */
     time_t t;
     time(&t);
+#ifdef __unix__
+    char timeStrBuf[26];
+    const char * const timeStrLF = ctime_r(&t, timeStrBuf);
+#else
     const char * const timeStrLF = ctime(&t);
+#endif
 
     /* Copy the time string only partial, we don't need the line feed at the end. */
     assert(strlen(timeStrLF) == 25);
-    static char timeStr[25];
+    static THREAD_LOCAL char timeStr[25];
     timeStr[0] = '\0';
     strncat(timeStr, timeStrLF, sizeof(timeStr)-1);
 
@@ -122,6 +235,46 @@ static const char *getTimeStr()
 
 
 
+/**
+ * Compose the name of the log file of a single circuit file. It is named as the circuit
+ * file.
+ *   @return
+ * Get the file name as malloc allocated string.
+ *   @param path
+ * The path, where to place the log file, not including the final slash.
+ *   @param circuitFileName
+ * The name of the circuit file.
+ */
+
+static const char *composeLogFileName( const char * const path
+                                     , const char * const circuitFileName
+                                     )
+{
+    char *pureFileName;
+    fil_splitPath( /* pPath */ NULL
+                 , &pureFileName
+                 , /* pExt */ NULL
+                 , circuitFileName
+                 );
+
+    char logFileName[strlen(path) + sizeof(SL) + strlen(pureFileName)
+                     + sizeof(LIN_LOG_FILE_NAME_EXT)
+                    ];
+    snprintf( logFileName
+            , sizeof(logFileName)
+            , "%s" SL "%s%s"
+            , path
+            , pureFileName
+            , LIN_LOG_FILE_NAME_EXT
+            );
+    free((char*)pureFileName);
+    return stralloccpy(logFileName);
+
+} /* End of composeLogFileName */
+
+
+
+
 /**
  * Figure out the name of the log file. It is either user-specified or derived from a circuit
  * file or application name.\n
@@ -135,7 +288,8 @@ static const char *getTimeStr()
  *   @param pCmdLine
  * The result of the command line parsing is passed by reference.
  *   @param circuitFileName
- * The name of the only or the first input file name.
+ * The name of the only or the first input file name or NULL if there are no input files
+ * on the command line.
  */
 
 static const char *getLogFileName( const opt_cmdLineOptions_t * const pCmdLine
@@ -162,10 +316,10 @@ static const char *getLogFileName( const opt_cmdLineOptions_t * const pCmdLine
         else
             path = ".";
 
-        if(pCmdLine->noInputFiles > 1)
+        if(pCmdLine->noInputFiles != 1)
         {
-            /* If there are several input files, then we use the application name for the
-               log file. */
+            /* If there are several input files or if the server reads them from stdin,
+               then we use the application name for the log file. */
             char logFileName[strlen(path) + sizeof(SL) + sizeof(LIN_LOG_FILE_NAME)];
             snprintf(logFileName, sizeof(logFileName), "%s" SL LIN_LOG_FILE_NAME, path);
             return stralloccpy(logFileName);
@@ -174,25 +328,7 @@ static const char *getLogFileName( const opt_cmdLineOptions_t * const pCmdLine
         {
             /* We have a single input file. Its name is re-used for the log file. */
             assert(pCmdLine->noInputFiles == 1);
-            char *pureFileName;
-            fil_splitPath( /* pPath */ NULL
-                         , &pureFileName
-                         , /* pExt */ NULL
-                         , circuitFileName
-                         );
-
-            char logFileName[strlen(path) + sizeof(SL) + strlen(pureFileName)
-                             + sizeof(LIN_LOG_FILE_NAME_EXT)
-                            ];
-            snprintf( logFileName
-                    , sizeof(logFileName)
-                    , "%s" SL "%s%s"
-                    , path
-                    , pureFileName
-                    , LIN_LOG_FILE_NAME_EXT
-                    );
-            free((char*)pureFileName);
-            return stralloccpy(logFileName);
+            return composeLogFileName(path, circuitFileName);
 
         } /* End if(One or multiple input files?) */
 
@@ -203,6 +339,92 @@ static const char *getLogFileName( const opt_cmdLineOptions_t * const pCmdLine
 
 
 
+/**
+ * Configure a logger object with the demands of the command line.
+ *   @param hLogger
+ * The logger to configure.
+ *   @param pCmdLine
+ * The result of the command line parsing is passed by reference.
+ */
+
+static void configureLogger( log_hLogger_t hLogger
+                           , const opt_cmdLineOptions_t * const pCmdLine
+                           )
+{
+    if(pCmdLine->lineFormat != NULL)
+        log_parseLineFormat(hLogger, pCmdLine->lineFormat);
+    if(pCmdLine->logLevel != NULL)
+        log_parseLogLevel(hLogger, pCmdLine->logLevel);
+
+} /* End of configureLogger */
+
+
+
+
+/**
+ * Initialize all the modules, which process a circuit file.
+ *   @param hLogger
+ * The modules write all their progress messages into this logger.
+ *   @param pCmdLine
+ * The parsed command line. It holds the number of threads of the solver, its resource
+ * budget and the error bound of approximated frequency domain results.
+ *   @remark
+ * The data of the modules is thread-local. The modules are initialized in and can be used
+ * by the calling thread only.
+ */
+
+static void initModules( log_hLogger_t hLogger
+                       , const opt_cmdLineOptions_t * const pCmdLine
+                       )
+{
+    const sol_resourceBudget_t budget =
+                                { .maxNoAddendsOfCoef = pCmdLine->maxNoAddendsOfCoef
+                                , .maxNoAddendsOfHeap = pCmdLine->maxNoAddendsOfHeap
+                                , .maxWallTime = pCmdLine->maxWallTime
+                                };
+    pci_initModule();
+    rat_initModule(hLogger);
+    coe_initModule(hLogger);
+    tbv_initModule(hLogger);
+    les_initModule(hLogger);
+    spt_initModule(hLogger);
+    sol_initModule(hLogger, pCmdLine->noThreads, &budget);
+    nsl_initModule(hLogger, pCmdLine->noThreads);
+    frq_initModule(hLogger, pCmdLine->approximationErrorBound);
+    nfr_initModule(hLogger);
+    msc_initModule(hLogger);
+    prf_initModule(hLogger);
+
+} /* End of initModules */
+
+
+
+
+/**
+ * Final cleanup by the modules, which had been initialized by initModules. Particularly
+ * useful in DEBUG compilation as memory leaks can be recognized.
+ */
+
+static void shutdownModules()
+{
+    prf_shutdownModule();
+    msc_shutdownModule();
+    nfr_shutdownModule();
+    frq_shutdownModule();
+    nsl_shutdownModule();
+    sol_shutdownModule();
+    spt_shutdownModule();
+    les_shutdownModule();
+    tbv_shutdownModule();
+    coe_shutdownModule();
+    rat_shutdownModule();
+    pci_shutdownModule();
+
+} /* End of shutdownModules */
+
+
+
+
 /**
  * Check if the needed output directory for the generated Octave scripts already exists. If
  * not, make it now and pre-fill it with all the static, never changing parts of the
@@ -336,6 +558,127 @@ static boolean makeOctaveOutputDir( const char * const outputPath
 
 
 
+/**
+ * Solve a LES with the numeric solver and present all user-defined results. The results
+ * are logged and their frequency responses are written as CSV files on demand.
+ *   @return
+ * \a true if the LES could be solved and all results could be computed, \a false
+ * otherwise. The errors have been reported.
+ *   @param pLES
+ * The LES.
+ *   @param pParseResult
+ * The parsed circuit, which holds the result definitions.
+ *   @param circuitFileName
+ * The name of the input file. The names of the CSV files are derived from it.
+ *   @param freqResponsePath
+ * NULL or the path, where the frequency responses of all results are written as CSV files.
+ *   @param hLog
+ * The logger to write all progress messages and the results into.
+ */
+
+static boolean solveNumerically( les_linearEquationSystem_t * const pLES
+                               , const pci_circuit_t * const pParseResult
+                               , const char * const circuitFileName
+                               , const char * const freqResponsePath
+                               , log_hLogger_t hLog
+                               )
+{
+    const nsl_numericSolution_t *pSolution;
+    prf_startPhase(prf_phaseSolve);
+    boolean success = nsl_createSolution(&pSolution, pLES);
+    prf_stopPhase(prf_phaseSolve);
+    if(!success)
+        return false;
+
+    /* The result with index -1 is the generic result of all dependents. It is demanded
+       only if the user didn't specify any other result. */
+    signed int idxResult;
+    for(idxResult=-1; idxResult<(signed)pParseResult->noResultDefs; ++idxResult)
+    {
+        if(idxResult == -1)
+        {
+            if(pParseResult->noResultDefs == 0)
+            {
+                LOG_WARN( hLog
+                        , "No user-defined result found in input file. The solution for"
+                          " all dependent quantities is figured out instead"
+                        );
+                log_flush(hLog);
+            }
+            else
+                continue;
+        }
+
+        const nsl_numericResult_t *pResult;
+        prf_startPhase(prf_phaseFreqDomain);
+        boolean successResult = nsl_createResult(&pResult, pSolution, idxResult);
+        prf_stopPhase(prf_phaseFreqDomain);
+
+        if(successResult)
+        {
+            prf_startPhase(prf_phaseLogging);
+            nsl_logResult(pResult, hLog, /* logLevel */ log_result);
+            prf_stopPhase(prf_phaseLogging);
+        }
+
+        /* The CSV files are named as for the symbolic solver. */
+        if(successResult &&  freqResponsePath != NULL)
+        {
+            prf_startPhase(prf_phaseFreqResponse);
+            char *circuitName;
+            fil_splitPath(NULL, &circuitName, NULL, circuitFileName);
+            const size_t lenFileName = strlen(freqResponsePath)
+                                       + strlen(circuitName)
+                                       + strlen(pResult->name)
+                                       + sizeof(SL "." ".step.csv");
+            char csvFileName[lenFileName]
+               , pzFileName[lenFileName]
+               , stepFileName[lenFileName];
+            snprintf( csvFileName
+                    , sizeof(csvFileName)
+                    , "%s" SL "%s.%s.csv"
+                    , freqResponsePath
+                    , circuitName
+                    , pResult->name
+                    );
+            snprintf( pzFileName
+                    , sizeof(pzFileName)
+                    , "%s" SL "%s.%s.pz.csv"
+                    , freqResponsePath
+                    , circuitName
+                    , pResult->name
+                    );
+            snprintf( stepFileName
+                    , sizeof(stepFileName)
+                    , "%s" SL "%s.%s.step.csv"
+                    , freqResponsePath
+                    , circuitName
+                    , pResult->name
+                    );
+            successResult = nfr_exportFrequencyResponseOfNumericResult(pResult, csvFileName)
+                            &&  nfr_exportPoleZeroAndStepResponseOfNumericResult
+                                                                        ( pResult
+                                                                        , pzFileName
+                                                                        , stepFileName
+                                                                        );
+            free(circuitName);
+            prf_stopPhase(prf_phaseFreqResponse);
+        }
+
+        nsl_deleteResult(pResult);
+        if(!successResult)
+            success = false;
+
+    } /* End for(All user defined results) */
+
+    nsl_deleteSolution(pSolution);
+    return success;
+
+} /* End of solveNumerically */
+
+
+
+
 /**
  * A single input file is completely processed: The cicuit file is parsed, the computation
  * is conducted, the results are presented and the Octace scripts are generated.
@@ -354,6 +697,35 @@ static boolean makeOctaveOutputDir( const char * const outputPath
  * dontCopyPrivateOctaveScripts is \a true then these files are added to the result. One
  * might e.g. have installed these files once as part of his Octave installation, so that
  * making a copy for each computation result would be counterproductive.
+ *   @param binaryOctaveData
+ * If Octave scripts should be generated: If \a true then the numerators and denominators
+ * of the results are written as binary data files, which are loaded by the generated
+ * scripts.
+ *   @param factoredOctaveCode
+ * If Octave scripts should be generated: If \a true then the numerators and denominators
+ * of the results are written in factored form, with common sums as intermediate
+ * variables.
+ *   @param freqResponsePath
+ * NULL or a path designation. If not NULL then the frequency responses of all results are
+ * computed numerically and written as CSV files into the specified path.
+ *   @param cachePath
+ * NULL or a path designation. If not NULL then the symbolic solution of the circuit is
+ * loaded from a cache file in the specified path if the same circuit had been processed
+ * before. Otherwise the solution is computed and stored in the cache file.
+ *   @param perfReportPath
+ * NULL or a path designation. If not NULL then the time spent in the phases of processing
+ * the input file, the statistics of the solver and the high-water marks of the heaps are
+ * recorded and written as JSON file into the specified path.
+ *   @param numericSolver
+ * If \a true then the LES is solved by the numeric solver. No Octave code can be
+ * generated, no cache can be used and incremental mode is not supported; pass NULL for \a
+ * octaveOutputPath, \a cachePath and \a pPrevSolution.
+ *   @param pPrevSolution
+ * NULL or the solution of the previously processed circuit in incremental mode. If the
+ * network of the circuit is the same then the solution of the LES is derived from the
+ * previous one rather than computed. Otherwise the computed solution is stored in *
+ * \a pPrevSolution for the next circuit. The kept solution needs to be deleted after
+ * the last circuit.
  *   @param hLog
  * The logger to write all progress messages into.
  *   @see
@@ -364,25 +736,145 @@ static boolean makeOctaveOutputDir( const char * const outputPath
 static boolean processInputFile( const char * const circuitFileName
                                , const char * const octaveOutputPath
                                , boolean dontCopyPrivateOctaveScripts
+                               , boolean binaryOctaveData
+                               , boolean factoredOctaveCode
+                               , const char * const freqResponsePath
+                               , const char * const cachePath
+                               , const char * const perfReportPath
+                               , boolean numericSolver
+                               , prevSolution_t * const pPrevSolution
                                , log_hLogger_t hLog
                                )
 {
+    assert(!numericSolver
+           ||  (octaveOutputPath == NULL  &&  cachePath == NULL  &&  pPrevSolution == NULL)
+          );
+
+    /* If a performance report is wanted then all phases of processing are timed. */
+    if(perfReportPath != NULL)
+        prf_startReport();
+
     /* Parse the input file and generate a net list object. */
     const pci_circuit_t *pParseResult = NULL;
+    prf_startPhase(prf_phaseParse);
     boolean success = pci_parseCircuitFile( hLog
                                           , &pParseResult
                                           , circuitFileName
                                           );
+    prf_stopPhase(prf_phaseParse);
+
+    /* In incremental mode, the kept solution is useless if the network has changed. It is
+       deleted before the new LES is created: The representation of coefficients depends
+       on the number of constants of a circuit and must not change while coefficients of
+       the previous circuit are still alive. */
+    unsigned long long hashOfNetwork = 0;
+    if(success  &&  pPrevSolution != NULL)
+    {
+        hashOfNetwork = pci_getHashOfNetwork(pParseResult);
+        if(pPrevSolution->pSolution != NULL
+           &&  pPrevSolution->hashOfNetwork != hashOfNetwork
+          )
+        {
+            sol_deleteSolution(pPrevSolution->pSolution);
+            pPrevSolution->pSolution = NULL;
+        }
+    }
 
     /* Create a linear equation system object from the parse result. */
     les_linearEquationSystem_t *pLES = NULL;
     if(success)
+    {
+        prf_startPhase(prf_phaseCreateLES);
         success = les_createLES(&pLES, pParseResult);
+        prf_stopPhase(prf_phaseCreateLES);
+        if(success)
+        {
+            const tbv_tableOfVariables_t * const pTabOfVars = pLES->pTableOfVars;
+            prf_recordSizeOfLES( pTabOfVars->noKnowns
+                               , pTabOfVars->noUnknowns
+                               , pTabOfVars->noConstants
+                               );
+        }
+    }
 
-    /* Compute the solution of the LES. */
+    /* In incremental mode, the solution of the previous circuit is reused if only its
+       result definitions, user-defined voltages, plot information or device values have
+       changed. */
     const sol_solution_t *pSolution = NULL;
-    if(success)
+    boolean isReused = false;
+    if(success  &&  pPrevSolution != NULL  &&  pPrevSolution->pSolution != NULL)
+    {
+        assert(pPrevSolution->hashOfNetwork == hashOfNetwork);
+        prf_startPhase(prf_phaseSolve);
+        isReused = sol_createSolutionFromPrevious( &pSolution
+                                                 , pLES
+                                                 , pPrevSolution->pSolution
+                                                 );
+        prf_stopPhase(prf_phaseSolve);
+    }
+
+    /* Compute the solution of the LES. If a cache of solutions is in use then the solution
+       is taken from there if the same circuit had been processed before. The cache file is
+       named after the hash code of the circuit. */
+    if(isReused)
+    {
+        /* The solution is available, there's nothing left to do. */
+    }
+    else if(success  &&  numericSolver)
+    {
+        /* The numeric solver has no algebraic solution. The results are computed and
+           presented immediately. */
+        success = solveNumerically(pLES, pParseResult, circuitFileName, freqResponsePath, hLog);
+    }
+    else if(success  &&  cachePath != NULL)
+    {
+        const unsigned long long hashOfCircuit = pci_getHashOfCircuit(pParseResult);
+        char cacheFileName[strlen(cachePath) + sizeof(SL "0123456789abcdef.lnc")];
+        snprintf( cacheFileName
+                , sizeof(cacheFileName)
+                , "%s" SL "%08lx%08lx.lnc"
+                , cachePath
+                , (unsigned long)(hashOfCircuit >> 32)
+                , (unsigned long)(hashOfCircuit & 0xffffffffull)
+                );
+        prf_startPhase(prf_phaseCache);
+        const boolean isCached = sol_loadSolution( &pSolution
+                                                 , pLES
+                                                 , hashOfCircuit
+                                                 , cacheFileName
+                                                 );
+        prf_stopPhase(prf_phaseCache);
+        if(!isCached)
+        {
+            prf_startPhase(prf_phaseSolve);
+            success = sol_createSolution(&pSolution, pLES);
+            prf_stopPhase(prf_phaseSolve);
+
+            /* A failure to fill the cache doesn't affect the results; it has been reported
+               as a warning. */
+            if(success)
+            {
+                prf_startPhase(prf_phaseCache);
+                sol_storeSolution(pSolution, hashOfCircuit, cacheFileName);
+                prf_stopPhase(prf_phaseCache);
+            }
+        }
+    }
+    else if(success)
+    {
+        prf_startPhase(prf_phaseSolve);
         success = sol_createSolution(&pSolution, pLES);
+        prf_stopPhase(prf_phaseSolve);
+    }
+
+    /* A newly computed solution replaces the kept one for the next circuit. A derived
+       solution is not kept; it may lack unknowns, which the kept one provides. */
+    if(success  &&  pPrevSolution != NULL  &&  !isReused)
+    {
+        sol_deleteSolution(pPrevSolution->pSolution);
+        pPrevSolution->pSolution = sol_cloneByConstReference(pSolution);
+        pPrevSolution->hashOfNetwork = hashOfNetwork;
+    }
 
     /* Delete the LES, which is solved and no longer needed. */
     les_deleteLES(pLES);
@@ -390,12 +882,22 @@ static boolean processInputFile( const char * const circuitFileName
 
     /* Print the algebraic solution of the LES. This is not yet the wanted, final result
        representation and therefore it is done only on level INFO. */
-    if(success)
+    if(success  &&  !numericSolver)
+    {
+        prf_startPhase(prf_phaseLogging);
         sol_logSolution(pSolution, /* logLevel */ log_info);
+        prf_stopPhase(prf_phaseLogging);
+    }
 
     signed int idxResult;
-    if(success)
+    if(success  &&  !numericSolver)
     {
+        /* All results are derived from the same algebraic solution. They share the
+           transformed numerators and the common denominator through a cache. */
+        prf_startPhase(prf_phaseFreqDomain);
+        frq_expressionCache_t * const pExprCache = frq_createExpressionCache(pSolution);
+        prf_stopPhase(prf_phaseFreqDomain);
+
         for(idxResult=-1; idxResult<(signed)pParseResult->noResultDefs; ++idxResult)
         {
             /* Actually, a result with index -1 doesn't exist as such. -1 means the generic
@@ -418,24 +920,31 @@ static boolean processInputFile( const char * const circuitFileName
 
             /* Generate the requested result from the algebraic solution of the LES. */
             const frq_freqDomainSolution_t *pFreqDomainSolution;
+            prf_startPhase(prf_phaseFreqDomain);
             boolean successResult = frq_createFreqDomainSolution( &pFreqDomainSolution
                                                                 , pSolution
                                                                 , idxResult
+                                                                , pExprCache
                                                                 );
+            prf_stopPhase(prf_phaseFreqDomain);
 
             /* Print the solution of the LES in the frequency domain. */
             if(successResult)
             {
+                prf_startPhase(prf_phaseLogging);
                 frq_logFreqDomainSolution( pFreqDomainSolution
                                          , hLog
                                          , /* logLevel */ log_result
                                          );
+                prf_stopPhase(prf_phaseLogging);
             }
 
             /* If Octave scripts are wanted as result representation: Compose the name of
                the Octave output file and open the file. */
             if(successResult &&  octaveOutputPath != NULL)
             {
+                prf_startPhase(prf_phaseExportMCode);
+
                 /* The name of the folder collecting all parts of the Ocatve script code is
                    derived from the name of the circuit file. */
                 char *folderName;
@@ -481,20 +990,94 @@ static boolean processInputFile( const char * const circuitFileName
                             successResult = false;
                         if(!msc_writeTextBlock(pMScript, msc_txtBlkLoadPkgs))
                             successResult = false;
-                        if(!frq_exportAsMCode(pFreqDomainSolution, pMScript))
+                        if(!frq_exportAsMCode( pFreqDomainSolution
+                                             , pMScript
+                                             , /* useBinaryData */ binaryOctaveData
+                                             , /* factored */ factoredOctaveCode
+                                             )
+                          )
+                        {
                             successResult = false;
+                        }
                         if(!msc_writeTextBlock(pMScript, msc_txtBlkTrailer))
                             successResult = false;
                     }
 
                     /* The M script is now generated, the object is no longer used. */
                     msc_deleteMScript(pMScript);
+
+                    /* The binary data file, which is loaded by the M script, has the name
+                       of the script with extension .lnb instead of .m. */
+                    if(binaryOctaveData)
+                    {
+                        char binaryFileName[sizeof(octaveFileName) + sizeof("lnb")];
+                        snprintf( binaryFileName
+                                , sizeof(binaryFileName)
+                                , "%s" SL "%s" SL "%s.lnb"
+                                , octaveOutputPath
+                                , folderName
+                                , pFreqDomainSolution->name
+                                );
+                        if(!frq_exportAsBinaryData(pFreqDomainSolution, binaryFileName))
+                            successResult = false;
+                    }
                 }
 
                 free(folderName);
+                prf_stopPhase(prf_phaseExportMCode);
 
             } /* End if(User demands Octave scripts?) */
 
+            /* If numeric frequency responses are wanted: They are written into a CSV
+               file, which is named after circuit file and result. Poles, zeros and step
+               responses go into two more CSV files. */
+            if(successResult &&  freqResponsePath != NULL)
+            {
+                prf_startPhase(prf_phaseFreqResponse);
+                char *circuitName;
+                fil_splitPath( NULL
+                             , &circuitName
+                             , NULL
+                             , circuitFileName
+                             );
+                const size_t lenFileName = strlen(freqResponsePath)
+                                           + strlen(circuitName)
+                                           + strlen(pFreqDomainSolution->name)
+                                           + sizeof(SL "." ".step.csv");
+                char csvFileName[lenFileName]
+                   , pzFileName[lenFileName]
+                   , stepFileName[lenFileName];
+                snprintf( csvFileName
+                        , sizeof(csvFileName)
+                        , "%s" SL "%s.%s.csv"
+                        , freqResponsePath
+                        , circuitName
+                        , pFreqDomainSolution->name
+                        );
+                snprintf( pzFileName
+                        , sizeof(pzFileName)
+                        , "%s" SL "%s.%s.pz.csv"
+                        , freqResponsePath
+                        , circuitName
+                        , pFreqDomainSolution->name
+                        );
+                snprintf( stepFileName
+                        , sizeof(stepFileName)
+                        , "%s" SL "%s.%s.step.csv"
+                        , freqResponsePath
+                        , circuitName
+                        , pFreqDomainSolution->name
+                        );
+                successResult = nfr_exportFrequencyResponse(pFreqDomainSolution, csvFileName)
+                                &&  nfr_exportPoleZeroAndStepResponse( pFreqDomainSolution
+                                                                     , pzFileName
+                                                                     , stepFileName
+                                                                     );
+                free(circuitName);
+                prf_stopPhase(prf_phaseFreqResponse);
+
+            } /* End if(User demands numeric frequency responses?) */
+
             /* The frequency domain result is not longer referenced. Delete it. */
             frq_deleteFreqDomainSolution(pFreqDomainSolution);
 
@@ -504,6 +1087,8 @@ static boolean processInputFile( const char * const circuitFileName
 
         } /* End for(All user defined results) */
 
+        frq_deleteExpressionCache(pExprCache);
+
     } /* End if(Algebraic solution is available?) */
 
     /* Delete the reference to the parse result. */
@@ -514,6 +1099,27 @@ static boolean processInputFile( const char * const circuitFileName
     sol_deleteSolution(pSolution);
     pSolution = NULL;
 
+    /* The performance report is written into a JSON file, which is named after the
+       circuit file. It is written for failing circuits, too. */
+    if(perfReportPath != NULL)
+    {
+        char *circuitName;
+        fil_splitPath(NULL, &circuitName, NULL, circuitFileName);
+        char reportFileName[strlen(perfReportPath)
+                            + strlen(circuitName)
+                            + sizeof(SL ".perf.json")
+                           ];
+        snprintf( reportFileName
+                , sizeof(reportFileName)
+                , "%s" SL "%s.perf.json"
+                , perfReportPath
+                , circuitName
+                );
+        if(!prf_writeReport(reportFileName, circuitFileName, success))
+            success = false;
+        free(circuitName);
+    }
+
     return success;
 
 } /* End of processInputFile */
@@ -521,6 +1127,531 @@ static boolean processInputFile( const char * const circuitFileName
 
 
 
+/**
+ * A job of a parallel batch run as a task of the thread pool: A single input file is
+ * completely processed. The job has its own logger and its own instances of all modules.
+ *   @param pContext
+ * The description of the batch run, an object of type batch_t.
+ *   @param idxTask
+ * The index of the job.
+ *   @param idxThread
+ * The index of the executing thread. Used for reporting only.
+ */
+
+static void processJob(void *pContext, unsigned int idxTask, unsigned int idxThread)
+{
+    const batch_t * const pBatch = (const batch_t*)pContext;
+    const opt_cmdLineOptions_t * const pCmdLine = pBatch->pCmdLine;
+    job_t * const pJob = &pBatch->jobAry[idxTask];
+
+    pJob->success = false;
+    if(pJob->idxJobOfSameName != UINT_MAX)
+        return;
+
+    log_hLogger_t hLog = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+    pJob->cantOpenLogFile = !log_createLogger( &hLog
+                                             , pJob->logFileName
+                                             , log_result
+                                             , log_fmtLong
+                                             , pCmdLine->echoToConsole
+                                             , pCmdLine->doAppend
+                                             );
+
+    /* The logger object can still be used if it logs to stdout. Otherwise we can't
+       process the file as no results could be reported. */
+    if(!pJob->cantOpenLogFile  ||  pCmdLine->echoToConsole)
+    {
+        configureLogger(hLog, pCmdLine);
+        if(pJob->cantOpenLogFile)
+            LOG_ERROR(hLog, "Can't open log file %s", pJob->logFileName)
+        if(log_getLineFormat(hLog) != log_fmtLong)
+            LOG_RESULT(hLog, "Beginning of processing at %s", getTimeStr())
+        LOG_DEBUG(hLog, "Job %u is executed by thread %u", idxTask+1, idxThread)
+
+        initModules(hLog, pCmdLine);
+        pJob->success = processInputFile( pJob->circuitFileName
+                                        , pCmdLine->octaveOutputPath
+                                        , pCmdLine->dontCopyPrivateOctaveScripts
+                                        , pCmdLine->binaryOctaveData
+                                        , pCmdLine->factoredOctaveCode
+                                        , pCmdLine->freqResponsePath
+                                        , pCmdLine->cachePath
+                                        , pCmdLine->perfReportPath
+                                        , pCmdLine->numericSolver
+                                        , /* pPrevSolution */ NULL
+                                        , hLog
+                                        );
+        shutdownModules();
+
+        if(log_getLineFormat(hLog) != log_fmtLong)
+            LOG_RESULT(hLog, "End of processing at %s", getTimeStr())
+    }
+
+    log_deleteLogger(hLog);
+
+} /* End of processJob */
+
+
+
+
+/**
+ * Process all input files in parallel jobs. Each job uses its own logger and its own
+ * instances of all modules, which are kept in thread-local data.
+ *   @return
+ * Get the number of successfully processed input files.
+ *   @param pCmdLine
+ * The result of the command line parsing is passed by reference.
+ *   @param circuitFileNameAry
+ * The names of the input files. The number of files is found in \a pCmdLine.
+ *   @param hGlobalLogger
+ * The global application log. It receives a summary of the jobs.
+ */
+
+static unsigned int processInputFilesInParallel( const opt_cmdLineOptions_t * const pCmdLine
+                                               , char * const circuitFileNameAry[]
+                                               , log_hLogger_t hGlobalLogger
+                                               )
+{
+    const unsigned int noFiles = pCmdLine->noInputFiles;
+
+    /* The log files of the jobs are named after the circuit files. They are located where
+       the log of a single input file would be. */
+    assert(pCmdLine->octaveOutputPath == NULL  ||  *pCmdLine->octaveOutputPath != '\0');
+    const char * const path = pCmdLine->octaveOutputPath != NULL
+                              ? pCmdLine->octaveOutputPath
+                              : ".";
+
+    /* The log file and all output files are named after the circuit file without its path
+       and extension. Circuit files of same name, e.g. from different directories, would
+       write the same files at the same time. Only the first one of them is processed. */
+    char *pureFileNameAry[noFiles];
+    job_t jobAry[noFiles];
+    unsigned int idxJob;
+    for(idxJob=0; idxJob<noFiles; ++idxJob)
+    {
+        job_t * const pJob = &jobAry[idxJob];
+        pJob->circuitFileName = circuitFileNameAry[idxJob];
+        fil_splitPath( /* pPath */ NULL
+                     , &pureFileNameAry[idxJob]
+                     , /* pExt */ NULL
+                     , pJob->circuitFileName
+                     );
+        pJob->idxJobOfSameName = UINT_MAX;
+        unsigned int idxPrevJob;
+        for(idxPrevJob=0; idxPrevJob<idxJob; ++idxPrevJob)
+        {
+            if(strcmp(pureFileNameAry[idxPrevJob], pureFileNameAry[idxJob]) == 0)
+            {
+                pJob->idxJobOfSameName = idxPrevJob;
+                break;
+            }
+        }
+        pJob->logFileName = pCmdLine->logFileName != NULL
+                            &&  pJob->idxJobOfSameName == UINT_MAX
+                            ? composeLogFileName(path, pJob->circuitFileName)
+                            : NULL;
+        pJob->cantOpenLogFile = false;
+        pJob->success = false;
+    }
+    for(idxJob=0; idxJob<noFiles; ++idxJob)
+        free(pureFileNameAry[idxJob]);
+
+    const unsigned int noJobs = pCmdLine->noJobs < noFiles? pCmdLine->noJobs: noFiles;
+    LOG_INFO( hGlobalLogger
+            , "Processing %u input files in %u parallel jobs"
+            , noFiles
+            , noJobs
+            )
+    log_flush(hGlobalLogger);
+
+    const batch_t batch = {.pCmdLine = pCmdLine, .jobAry = jobAry};
+    thp_hThreadPool_t hThreadPool = thp_createThreadPool( hGlobalLogger
+                                                        , noJobs
+                                                        , /* fctStartThread */ NULL
+                                                        , /* fctStopThread */ NULL
+                                                        , /* pContext */ NULL
+                                                        );
+    thp_runTasks(hThreadPool, /* noTasks */ noFiles, processJob, (void*)&batch);
+    thp_deleteThreadPool(hThreadPool);
+
+    /* Report the outcome of all jobs in the order of the input files. */
+    unsigned int noSuccessfulFiles = 0;
+    for(idxJob=0; idxJob<noFiles; ++idxJob)
+    {
+        job_t * const pJob = &jobAry[idxJob];
+        if(pJob->idxJobOfSameName != UINT_MAX)
+        {
+            LOG_ERROR( hGlobalLogger
+                     , "Circuit file %s is not processed. It has the same name as circuit"
+                       " file %s and both parallel jobs would write into the same log and"
+                       " output files. Please rename one of the files or process them in"
+                       " separate runs"
+                     , pJob->circuitFileName
+                     , jobAry[pJob->idxJobOfSameName].circuitFileName
+                     )
+            continue;
+        }
+        if(pJob->cantOpenLogFile)
+        {
+            LOG_ERROR( hGlobalLogger
+                     , "Can't open log file %s of circuit file %s"
+                     , pJob->logFileName
+                     , pJob->circuitFileName
+                     )
+        }
+        if(pJob->success)
+        {
+            LOG_INFO( hGlobalLogger
+                    , "Circuit file %s successfully processed"
+                    , pJob->circuitFileName
+                    )
+            ++ noSuccessfulFiles;
+        }
+        else
+        {
+            LOG_ERROR( hGlobalLogger
+                     , "Errors occurred while processing circuit file %s. Please refer to"
+                       " log file %s for details"
+                     , pJob->circuitFileName
+                     , pJob->logFileName != NULL? pJob->logFileName: "(none)"
+                     )
+        }
+        if(pJob->logFileName != NULL)
+            free((char*)pJob->logFileName);
+    }
+
+    return noSuccessfulFiles;
+
+} /* End of processInputFilesInParallel */
+
+
+
+
+/**
+ * Read a line of arbitrary length from a stdio stream.
+ *   @return
+ * Get the line as malloc allocated string, including the terminating end of line
+ * character if there is one. NULL is returned at the end of the stream.
+ *   @param hStream
+ * The stream to read from.
+ */
+
+static char *readLine(FILE * const hStream)
+{
+    size_t maxLen = 256
+         , len = 0;
+    char *line = smalloc(maxLen, __FILE__, __LINE__);
+    while(fgets(line+len, (signed int)(maxLen-len), hStream) != NULL)
+    {
+        len += strlen(line+len);
+        if(len > 0  &&  line[len-1] == '\n')
+            break;
+
+        /* The buffer is full but the line is not complete yet. */
+        if(len+1 == maxLen)
+        {
+            maxLen *= 2;
+            line = srealloc(line, maxLen, __FILE__, __LINE__);
+        }
+    }
+
+    if(len == 0)
+    {
+        free(line);
+        return NULL;
+    }
+    else
+        return line;
+
+} /* End of readLine */
+
+
+
+
+/**
+ * Parse a request to the server. A request is a line {option} circuitFileName. The
+ * options -o, -n, -p, -k, -i, -b and -F are supported with the meaning they have on the
+ * command line; an argument is always attached to the option character. The options of
+ * the request replace the settings from the command line for this request only. The
+ * circuit file name is the rest of the line. It may contain blanks; it is separated from
+ * the options by a double hyphen if it could be mixed up with an option.
+ *   @return
+ * \a true if the request could be parsed, \a false otherwise. A problem is reported in
+ * the log.
+ *   @param pRequest
+ * The parsed request is placed into * \a pRequest. The strings point into \a line.
+ *   @param line
+ * The request as read from stdin. The line is modified by the parser.
+ *   @param pCmdLine
+ * The parsed command line. It holds the default settings of all requests.
+ *   @param hLog
+ * Problems are reported in this logger.
+ */
+
+static boolean parseRequest( request_t * const pRequest
+                           , char * const line
+                           , const opt_cmdLineOptions_t * const pCmdLine
+                           , log_hLogger_t hLog
+                           )
+{
+    pRequest->circuitFileName = NULL;
+    pRequest->octaveOutputPath = pCmdLine->octaveOutputPath;
+    pRequest->dontCopyPrivateOctaveScripts = pCmdLine->dontCopyPrivateOctaveScripts;
+    pRequest->binaryOctaveData = pCmdLine->binaryOctaveData;
+    pRequest->factoredOctaveCode = pCmdLine->factoredOctaveCode;
+    pRequest->freqResponsePath = pCmdLine->freqResponsePath;
+    pRequest->cachePath = pCmdLine->cachePath;
+    pRequest->perfReportPath = pCmdLine->perfReportPath;
+
+    /* Loop over all blank separated words, which begin with a hyphen. */
+    char *pCh = line;
+    while(true)
+    {
+        while(isspace((unsigned char)*pCh))
+            ++ pCh;
+        if(*pCh != '-')
+            break;
+
+        /* Isolate the next option as a zero terminated string. */
+        char * const option = pCh;
+        while(*pCh != '\0'  &&  !isspace((unsigned char)*pCh))
+            ++ pCh;
+        if(*pCh != '\0')
+            * pCh++ = '\0';
+
+        /* The double hyphen ends the list of options. */
+        if(strcmp(option, "--") == 0)
+        {
+            while(isspace((unsigned char)*pCh))
+                ++ pCh;
+            break;
+        }
+
+        const char * const arg = option[1] != '\0'? &option[2]: &option[1];
+        boolean isValid = true;
+        switch(option[1])
+        {
+        case 'o':
+            pRequest->octaveOutputPath = *arg != '\0'? arg: ".";
+            break;
+        case 'n':
+            pRequest->freqResponsePath = *arg != '\0'? arg: ".";
+            break;
+        case 'p':
+            pRequest->perfReportPath = *arg != '\0'? arg: ".";
+            break;
+        case 'k':
+            isValid = *arg != '\0';
+            pRequest->cachePath = arg;
+            break;
+        case 'i':
+            isValid = *arg == '\0';
+            pRequest->dontCopyPrivateOctaveScripts = true;
+            break;
+        case 'b':
+            isValid = *arg == '\0';
+            pRequest->binaryOctaveData = true;
+            break;
+        case 'F':
+            isValid = *arg == '\0';
+            pRequest->factoredOctaveCode = true;
+            break;
+        default:
+            isValid = false;
+        }
+        if(!isValid)
+        {
+            LOG_ERROR( hLog
+                     , "Invalid option %s in request. Supported are -o[DIRNAME],"
+                       " -n[DIRNAME], -p[DIRNAME], -kDIRNAME, -i, -b and -F"
+                     , option
+                     )
+            return false;
+        }
+    } /* End while(All options of the request) */
+
+    /* The rest of the line is the name of the circuit file. Trailing white space,
+       including the end of line, is removed. */
+    char *pEnd = pCh + strlen(pCh);
+    while(pEnd > pCh  &&  isspace((unsigned char)pEnd[-1]))
+        -- pEnd;
+    *pEnd = '\0';
+    if(*pCh == '\0')
+    {
+        LOG_ERROR(hLog, "Circuit file is missing in request")
+        return false;
+    }
+    pRequest->circuitFileName = pCh;
+
+    /* The binary data files are an alternative representation of the Octave code. */
+    if(pRequest->binaryOctaveData  &&  pRequest->octaveOutputPath == NULL)
+    {
+        LOG_ERROR( hLog
+                 , "Binary data files (-b) are written only together with Octave code;"
+                   " please, specify the Octave output directory (-o) in request for"
+                   " circuit file %s"
+                 , pRequest->circuitFileName
+                 )
+        return false;
+    }
+
+    /* The factored form is a representation of the Octave code. */
+    if(pRequest->factoredOctaveCode
+       &&  (pRequest->octaveOutputPath == NULL  ||  pRequest->binaryOctaveData)
+      )
+    {
+        LOG_ERROR( hLog
+                 , "The factored form (-F) is written only into Octave code; please,"
+                   " specify the Octave output directory (-o) and don't combine it with"
+                   " binary data files (-b) in request for circuit file %s"
+                 , pRequest->circuitFileName
+                 )
+        return false;
+    }
+
+    /* The numeric solver has no symbolic solution. */
+    if(pCmdLine->numericSolver
+       &&  (pRequest->octaveOutputPath != NULL  ||  pRequest->cachePath != NULL)
+      )
+    {
+        LOG_ERROR( hLog
+                 , "The numeric solver (-N) can't be combined with Octave code (-o) or a"
+                   " cache of solutions (-k) in request for circuit file %s"
+                 , pRequest->circuitFileName
+                 )
+        return false;
+    }
+
+    return true;
+
+} /* End of parseRequest */
+
+
+
+
+/**
+ * Run the application as resident server: The requests are read from stdin and processed
+ * one after another until the end of the input or until the request quit is read. The
+ * modules stay initialized and their heaps stay filled between the requests; this saves
+ * the overhead of starting the application for each circuit file.\n
+ *   Each request is answered by a single line on stdout. It consists of the tag
+ * #SERVER_RESPONSE_TAG, the status ok or failed, the number of the request, counted from
+ * one, and the name of the processed circuit file if it is known. The line "linNet:
+ * ready" is written when the server is ready to receive its first request. All other
+ * output of the processing is made as without server mode, i.e. into the log and into
+ * the output folders.
+ *   @return
+ * \a true if all requests succeeded, \a false otherwise.
+ *   @param pCmdLine
+ * The parsed command line. It holds the default settings of all requests.
+ *   @param hLog
+ * The logger, which has been passed to the modules at their initialization. All
+ * processing of the requests is reported in this logger.
+ *   @remark
+ * The modules need to be initialized by the calling thread.
+ */
+
+static boolean serveRequests( const opt_cmdLineOptions_t * const pCmdLine
+                            , log_hLogger_t hLog
+                            )
+{
+    unsigned int noRequests = 0
+               , noSuccessfulRequests = 0;
+
+    /* In incremental mode, the solution of the last solved network is kept across the
+       requests. */
+    prevSolution_t prevSolution = {.hashOfNetwork = 0, .pSolution = NULL};
+
+    LOG_INFO(hLog, "Server is ready, requests are read from stdin")
+    log_flush(hLog);
+    printf(SERVER_RESPONSE_TAG " ready\n");
+    fflush(stdout);
+
+    char *line;
+    while((line = readLine(stdin)) != NULL)
+    {
+        /* Empty lines are ignored. The request quit terminates the server. */
+        const char *pCh = line;
+        while(isspace((unsigned char)*pCh))
+            ++ pCh;
+        const size_t lenQuit = sizeof(SERVER_REQUEST_QUIT) - 1;
+        boolean isQuit = strncmp(pCh, SERVER_REQUEST_QUIT, lenQuit) == 0;
+        if(isQuit)
+        {
+            for(pCh+=lenQuit; isspace((unsigned char)*pCh); ++pCh)
+                ;
+            isQuit = *pCh == '\0';
+        }
+        if(isQuit)
+        {
+            free(line);
+            break;
+        }
+        else if(*pCh == '\0')
+        {
+            free(line);
+            continue;
+        }
+
+        ++ noRequests;
+        request_t request;
+        boolean success = parseRequest(&request, line, pCmdLine, hLog);
+        if(success)
+        {
+            LOG_INFO( hLog
+                    , "Request %u: Processing circuit file %s"
+                    , noRequests
+                    , request.circuitFileName
+                    )
+            success = processInputFile( request.circuitFileName
+                                      , request.octaveOutputPath
+                                      , request.dontCopyPrivateOctaveScripts
+                                      , request.binaryOctaveData
+                                      , request.factoredOctaveCode
+                                      , request.freqResponsePath
+                                      , request.cachePath
+                                      , request.perfReportPath
+                                      , pCmdLine->numericSolver
+                                      , pCmdLine->incremental  &&  !pCmdLine->numericSolver
+                                        ? &prevSolution
+                                        : NULL
+                                      , hLog
+                                      );
+        }
+        if(success)
+            ++ noSuccessfulRequests;
+        else
+            LOG_ERROR(hLog, "Request %u failed", noRequests)
+
+        /* The log is complete when the client sees the response. */
+        log_flush(hLog);
+        printf( SERVER_RESPONSE_TAG " %s %u%s%s\n"
+              , success? "ok": "failed"
+              , noRequests
+              , request.circuitFileName != NULL? " ": ""
+              , request.circuitFileName != NULL? request.circuitFileName: ""
+              );
+        fflush(stdout);
+
+        free(line);
+
+    } /* End while(All requests) */
+
+    sol_deleteSolution(prevSolution.pSolution);
+
+    LOG_INFO( hLog
+            , "Server terminates. Successfully processed %u out of %u requests"
+            , noSuccessfulRequests
+            , noRequests
+            )
+
+    return noSuccessfulRequests == noRequests;
+
+} /* End of serveRequests */
+
+
+
+
 /**
  * Main entry point of the application. Parse input file, conduct the computation, present
  * the results.
@@ -567,7 +1698,15 @@ signed int main(signed int argc, char *argv[])
        omitted then find approriate default values now. */
     if(cmdLine.octaveOutputPath != NULL  &&  *cmdLine.octaveOutputPath == '\0')
         cmdLine.octaveOutputPath = "."; /* Operate in current working directory. */
-    const char *logFileName = getLogFileName(&cmdLine, argv[cmdLine.idxFirstInputFile]);
+    if(cmdLine.freqResponsePath != NULL  &&  *cmdLine.freqResponsePath == '\0')
+        cmdLine.freqResponsePath = "."; /* Operate in current working directory. */
+    if(cmdLine.perfReportPath != NULL  &&  *cmdLine.perfReportPath == '\0')
+        cmdLine.perfReportPath = "."; /* Operate in current working directory. */
+    const char *logFileName = getLogFileName( &cmdLine
+                                            , cmdLine.noInputFiles > 0
+                                              ? argv[cmdLine.idxFirstInputFile]
+                                              : NULL
+                                            );
 
     log_initModule();
 
@@ -608,10 +1747,13 @@ signed int main(signed int argc, char *argv[])
        since it echos everything to stdout. We proceed. */
 
     /* Configure the logger with the demands of the command line. */
-    if(cmdLine.lineFormat != NULL)
-        log_parseLineFormat(hGlobalLogger, cmdLine.lineFormat);
-    if(cmdLine.logLevel != NULL)
-        log_parseLogLevel(hGlobalLogger, cmdLine.logLevel);
+    configureLogger(hGlobalLogger, &cmdLine);
+
+    /* All loggers of the application, including those of the parallel jobs, write
+       asynchronously if demanded. */
+    boolean cantStartAsynchronousLogging = false;
+    if(cmdLine.asynchronousLogging)
+        cantStartAsynchronousLogging = !log_setAsynchronousMode(/* isAsynchronous */ true);
 
     /* Log the greeting but don't do this a second time on the normal console. */
     log_setEchoToConsole(hGlobalLogger, /* echoToConsole */ false);
@@ -622,6 +1764,13 @@ signed int main(signed int argc, char *argv[])
         LOG_INFO(hGlobalLogger, "Log file name is %s", logFileName)
     if(cantOpenLogFile)
         LOG_ERROR(hGlobalLogger, "Can't open log file %s", logFileName)
+    if(cantStartAsynchronousLogging)
+    {
+        LOG_WARN( hGlobalLogger
+                , "Can't start the writer thread of the asynchronous logging. The log is"
+                  " written synchronously"
+                )
+    }
 
     /* The log file name is not used down here. */
     if(logFileName != NULL)
@@ -652,36 +1801,66 @@ signed int main(signed int argc, char *argv[])
     if(log_getLineFormat(hGlobalLogger) != log_fmtLong)
         LOG_RESULT(hGlobalLogger, "Beginning of processing at %s", getTimeStr())
 
-    /* Initialize the modules. */
-    pci_initModule();
-    rat_initModule(hGlobalLogger);
-    coe_initModule(hGlobalLogger);
-    tbv_initModule(hGlobalLogger);
-    les_initModule(hGlobalLogger);
-    sol_initModule(hGlobalLogger);
-    frq_initModule(hGlobalLogger);
-    msc_initModule(hGlobalLogger);
-
-    /* Loop over all named input file. Continue even in case of failures; all circuit files
-       should be independent of eachother. */
-    unsigned int u, noSuccessfulFiles;
-    for(u=cmdLine.idxFirstInputFile, noSuccessfulFiles=0; u<(unsigned)argc; ++u)
-    {
-        if(processInputFile( /* circuitFileName */ argv[u]
-                           , cmdLine.octaveOutputPath
-                           , cmdLine.dontCopyPrivateOctaveScripts
-                           , hGlobalLogger
-                           )
-          )
-        {
-            /* Count successful files and report a statistics if there are more than one
-               input files. */
-            ++ noSuccessfulFiles;
-        }
-        else
+    unsigned int noSuccessfulFiles = 0;
+    if(cmdLine.serverMode)
+    {
+        /* Resident server: The modules are initialized once for all requests. */
+        initModules(hGlobalLogger, &cmdLine);
+        success = serveRequests(&cmdLine, hGlobalLogger);
+        shutdownModules();
+    }
+    else if(cmdLine.noJobs > 1  &&  cmdLine.noInputFiles > 1)
+    {
+        /* Parallel batch run: The jobs initialize the modules on their own. */
+        noSuccessfulFiles = processInputFilesInParallel( &cmdLine
+                                                       , &argv[cmdLine.idxFirstInputFile]
+                                                       , hGlobalLogger
+                                                       );
+        if(noSuccessfulFiles != cmdLine.noInputFiles)
             success = false;
+    }
+    else
+    {
+        /* Initialize the modules. */
+        initModules(hGlobalLogger, &cmdLine);
+
+        /* Loop over all named input file. Continue even in case of failures; all circuit
+           files should be independent of eachother. In incremental mode, the solution of
+           the last solved network is kept from one file to the next. */
+        prevSolution_t prevSolution = {.hashOfNetwork = 0, .pSolution = NULL};
+        unsigned int u;
+        for(u=cmdLine.idxFirstInputFile; u<(unsigned)argc; ++u)
+        {
+            if(processInputFile( /* circuitFileName */ argv[u]
+                               , cmdLine.octaveOutputPath
+                               , cmdLine.dontCopyPrivateOctaveScripts
+                               , cmdLine.binaryOctaveData
+                               , cmdLine.factoredOctaveCode
+                               , cmdLine.freqResponsePath
+                               , cmdLine.cachePath
+                               , cmdLine.perfReportPath
+                               , cmdLine.numericSolver
+                               , cmdLine.incremental  &&  !cmdLine.numericSolver
+                                 ? &prevSolution
+                                 : NULL
+                               , hGlobalLogger
+                               )
+              )
+            {
+                /* Count successful files and report a statistics if there are more than
+                   one input files. */
+                ++ noSuccessfulFiles;
+            }
+            else
+                success = false;
 
-    } /* End for(All input files on the command line) */
+        } /* End for(All input files on the command line) */
+        sol_deleteSolution(prevSolution.pSolution);
+
+        /* Final cleanup by the modules. Particularly useful in DEBUG compilation as memory
+           leaks can be recognized. */
+        shutdownModules();
+    }
 
     if(cmdLine.noInputFiles > 1)
     {
@@ -702,17 +1881,6 @@ signed int main(signed int argc, char *argv[])
         }
     }
 
-    /* Final cleanup by the modules. Particularly useful in DEBUG compilation as memory
-       leaks can be recognized. */
-    msc_shutdownModule();
-    frq_shutdownModule();
-    sol_shutdownModule();
-    les_shutdownModule();
-    tbv_shutdownModule();
-    coe_shutdownModule();
-    rat_shutdownModule();
-    pci_shutdownModule();
-
     /* If the logger object doesn't write a line header with full time information we make
        a final time notice now. */
     if(log_getLineFormat(hGlobalLogger) != log_fmtLong)
@@ -35,6 +35,11 @@
  * Include files
  */
 
+/* The reentrant function ctime_r is a POSIX extension of the C library. */
+#ifdef __unix__
+# define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -46,6 +51,7 @@
 #include "log_logger.h"
 #include "lin_linNet.h"
 #include "fil_file.h"
+#include "ost_outputStream.h"
 #include "msc_mScript.h"
 
 
@@ -69,11 +75,11 @@
  */
 
 /** A global logger object is referenced from anywhere for writing progress messages. */
-static log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
 
 #ifdef  DEBUG
 /** A global counter of all references to any created objects. Used to detect memory leaks. */
-static unsigned int _noRefsToObjects = 0;
+static THREAD_LOCAL unsigned int _noRefsToObjects = 0;
 #endif
 
 
@@ -156,24 +162,29 @@ function [tf_%s deviceConstants wBode tiStep] = %s(deviceConstants)\n\
     /* Get current time as string of fixed length. */
     time_t t;
     time(&t);
+#ifdef __unix__
+    char timeStrBuf[26];
+    const char * const timeStr = ctime_r(&t, timeStrBuf);
+#else
     const char * const timeStr = ctime(&t);
+#endif
     char yearStr[5];
     snprintf(yearStr, 5, timeStr+20);
 
-    return fprintf( pMScript->hFile
-                  , M_FILE_HDR
-                  , pMScript->resultName
-                  , pMScript->resultName
-                  , pMScript->resultName
-                  , pMScript->resultName
-                  , pMScript->circuitFileName
-                  , pMScript->resultName
-                  , pMScript->resultName
-                  , pMScript->resultName
-                  , pMScript->resultName
-                  , yearStr
-                  )
-           > 0;
+    ost_printf( &pMScript->outputStream
+              , M_FILE_HDR
+              , pMScript->resultName
+              , pMScript->resultName
+              , pMScript->resultName
+              , pMScript->resultName
+              , pMScript->circuitFileName
+              , pMScript->resultName
+              , pMScript->resultName
+              , pMScript->resultName
+              , pMScript->resultName
+              , yearStr
+              );
+    return !pMScript->outputStream.isError;
 
 #undef M_FILE_HDR
 } /* End of writeFileHeader */
@@ -201,7 +212,8 @@ end %% of function %s\n\
                                          , /* pExt */ NULL
                                          , pMScript->resultName
                                          );
-    return fprintf(pMScript->hFile, M_FILE_TRAILER, mfilename) > 0;
+    ost_printf(&pMScript->outputStream, M_FILE_TRAILER, mfilename);
+    return !pMScript->outputStream.isError;
 
 #undef M_FILE_TRAILER
 } /* End of writeFileTrailer */
@@ -321,6 +333,7 @@ boolean msc_createMScript( msc_mScript_t ** const ppMScript
         pObj->circuitFileName = stralloccpy(circuitFileName);
         pObj->resultName = stralloccpy(resultName);
         pObj->hFile = pFile;
+        ost_initOutputStream(&pObj->outputStream, pFile);
 #ifdef DEBUG
         pObj->handleBorrowed = false;
 #endif
@@ -395,7 +408,9 @@ void msc_deleteMScript(msc_mScript_t * const pMScript)
     {
         if(pMScript->hFile != NULL)
         {
-            if(fclose(pMScript->hFile) != 0)
+            /* Write the buffered end of the script before closing the file. */
+            const boolean successFlush = ost_closeOutputStream(&pMScript->outputStream);
+            if(fclose(pMScript->hFile) != 0  ||  !successFlush)
             {
                 LOG_ERROR( _log
                          , "Error while closing file %s. The file contents are possibly"
@@ -454,21 +469,24 @@ boolean msc_writeTextBlock( msc_mScript_t * const pMScript
         break;
 
     case msc_txtBlkBlankLine:
-        success = fputs("\n", pMScript->hFile) >= 0;
+        ost_putChar(&pMScript->outputStream, '\n');
+        success = !pMScript->outputStream.isError;
         break;
 
     case msc_txtBlkAddPath:
-        success = fputs("addpath " "linNet_private" ";\n", pMScript->hFile) >= 0;
+        ost_putString(&pMScript->outputStream, "addpath " "linNet_private" ";\n");
+        success = !pMScript->outputStream.isError;
         break;
 
     case msc_txtBlkLoadPkgs:
-        success = fputs( "% Load the required Octave packages.\n"
-                         "if isOctave\n"
-                         "    pkg load control\n"
-                         "end\n"
-                         "\n"
-                       , pMScript->hFile
-                       ) >= 0;
+        ost_putString( &pMScript->outputStream
+                     , "% Load the required Octave packages.\n"
+                       "if isOctave\n"
+                       "    pkg load control\n"
+                       "end\n"
+                       "\n"
+                     );
+        success = !pMScript->outputStream.isError;
         break;
         
     default:
@@ -492,9 +510,9 @@ boolean msc_writeTextBlock( msc_mScript_t * const pMScript
 
 
 /**
- * Borrow the stream from the object. The returned stream object is a standard stream,
- * which can eb used with all the output functions of the library stdio. The output methods
- * of this class must not be used while the stream object is borrowed.\n
+ * Borrow the stream from the object. The returned stream object is a buffered output
+ * stream, which can be used with all the output functions of module ost_outputStream. The
+ * output methods of this class must not be used while the stream object is borrowed.\n
  *   Two clients must not borrow the stream object at the same time. This holds still true
  * if the different clients have different clones (by reference) of the same object.
  *   @return
@@ -504,14 +522,13 @@ boolean msc_writeTextBlock( msc_mScript_t * const pMScript
  *   @see void releaseStream(msc_mScript_t * const pMScript)
  */
 
-FILE *msc_borrowStream(msc_mScript_t * const pMScript)
+ost_outputStream_t *msc_borrowStream(msc_mScript_t * const pMScript)
 {
     assert(pMScript != NULL  &&  !pMScript->handleBorrowed);
-    fflush(pMScript->hFile);
 #ifdef DEBUG
     pMScript->handleBorrowed = true;
 #endif
-    return pMScript->hFile;
+    return &pMScript->outputStream;
 
 } /* End of msc_borrowStream */
 
@@ -524,8 +541,8 @@ FILE *msc_borrowStream(msc_mScript_t * const pMScript)
  *   @param pMScript
  * The pointer to the object, whose stream is returned.
  *   @remark
- * The function FILE *msc_borrowStream(msc_mScript_t * const) needs to be called again
- * prior to using output function of the library stdio again.
+ * The function ost_outputStream_t *msc_borrowStream(msc_mScript_t * const) needs to be
+ * called again prior to using the output functions of module ost_outputStream again.
  */
 
 void msc_releaseStream(msc_mScript_t * const pMScript)
@@ -533,8 +550,10 @@ void msc_releaseStream(msc_mScript_t * const pMScript)
     assert(pMScript != NULL  &&  pMScript->handleBorrowed);
 #ifdef DEBUG
     pMScript->handleBorrowed = false;
+#else
+    /* The output stream is shared with the borrower; there's nothing to do. */
+    (void)pMScript;
 #endif
-    fflush(pMScript->hFile);
 
 } /* End of msc_releaseStream */
 
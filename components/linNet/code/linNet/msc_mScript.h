@@ -24,8 +24,11 @@
  * Include files
  */
 
+#include <stdio.h>
+
 #include "types.h"
 #include "log_logger.h"
+#include "ost_outputStream.h"
 
 
 /*
@@ -58,6 +61,10 @@ typedef struct msc_mScript_t
     
     /** The file handle. */
     FILE *hFile;
+
+    /** The buffered output stream, which writes into \a hFile. All output to the M script
+        is done through this stream. */
+    ost_outputStream_t outputStream;
     
 #ifdef DEBUG
     /** Is the file handle borrowed by a client of the object? In which case not output is
@@ -139,7 +146,7 @@ boolean msc_writeTextBlock( msc_mScript_t * const pMScript
                           );
                           
 /** Borrow the stream object from the M script object to do direct output. */
-FILE *msc_borrowStream(msc_mScript_t * const pMScript);
+ost_outputStream_t *msc_borrowStream(msc_mScript_t * const pMScript);
 
 /** Notify that the borrowed stream is no longer used for direct output. */
 void msc_releaseStream(msc_mScript_t * const pMScript);
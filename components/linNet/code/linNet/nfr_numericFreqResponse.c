@@ -0,0 +1,2998 @@
+/**
+ * @file nfr_numericFreqResponse.c
+ *   Numeric evaluation of a solution in the frequency domain. The frequency responses of
+ * all dependents of a result with respect to all of its independents are computed for a
+ * vector of frequencies and written into a CSV file. This is a fast alternative to running
+ * the generated Octave scripts, e.g. for sweeps through the values of some devices, which
+ * require the numeric results only.\n
+ *   A solution is first compiled into an evaluation plan, see nfr_evaluationPlan_t. The
+ * linked lists of addends of the numerators and the denominator are flattened into
+ * contiguous arrays in three levels: A monomial is a product of powers of device
+ * constants. A coefficient is a sum of rational multiples of monomials; it is the
+ * coefficient of a power of s. An expression is a polynomial in s with such coefficients,
+ * times a common factor. Each level is deduplicated by hashing; a monomial, coefficient or
+ * expression, which is used several times, is computed only once per evaluation. In
+ * particular, identical numerators of different transfer functions share a single
+ * expression, like the expression map does in the Octave output of module
+ * frq_freqDomainSolution.\n
+ *   A plan is evaluated for many parameter vectors, i.e. sets of values of the device
+ * constants, and many frequencies at once. The parameter vectors are laid out in
+ * structure-of-arrays form. All computation steps are loops over the parameter vectors,
+ * which the compiler can vectorize. The polynomials are evaluated by the Horner scheme for s
+ * = j*omega.\n
+ *   For the nominal device values, the gains, zeros and poles of all transfer functions
+ * and their step responses are computed, too. The roots of the polynomials are found by
+ * the Aberth-Ehrlich method and the step responses by partial fraction expansion. This
+ * replaces the functions pzmap and step of the Octave control package for runs, which
+ * require the numbers only.
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   nfr_initModule
+ *   nfr_shutdownModule
+ *   nfr_createEvaluationPlan
+ *   nfr_createEvaluationPlanOfNumericResult
+ *   nfr_deleteEvaluationPlan
+ *   nfr_getNominalValues
+ *   nfr_evaluatePlan
+ *   nfr_exportFrequencyResponse
+ *   nfr_exportFrequencyResponseOfNumericResult
+ *   nfr_exportPoleZeroAndStepResponse
+ *   nfr_exportPoleZeroAndStepResponseOfNumericResult
+ * Local functions
+ *   createFrequencyVector
+ *   growArray
+ *   hashWords
+ *   createHashSet
+ *   deleteHashSet
+ *   findOrAddEntry
+ *   isEqualMonomial
+ *   isEqualCoef
+ *   isEqualExpression
+ *   hashDouble
+ *   addMonomial
+ *   addCoef
+ *   addExpression
+ *   addNumericCoef
+ *   addPolynomial
+ *   evaluateMonomials
+ *   evaluateCoefs
+ *   evaluateExpressions
+ *   getMagnitudeAndPhase
+ *   writeCsvFile
+ *   exportFrequencyResponse
+ *   getPolynomialOfExpression
+ *   cmpRoots
+ *   normalizeRoots
+ *   findRootsOfPolynomial
+ *   getPolesAndZeros
+ *   computeStepResponse
+ *   writePoleZeroFile
+ *   writeStepResponseFile
+ *   exportPoleZeroAndStepResponse
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <complex.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "smalloc.h"
+#include "log_logger.h"
+#include "pci_parserCircuit.h"
+#include "tbv_tableOfVariables.h"
+#include "frq_freqDomainSolution.h"
+#include "frq_freqDomainSolution.inlineInterface.h"
+#include "nsl_numericSolver.h"
+#include "nfr_numericFreqResponse.h"
+
+
+/*
+ * Defines
+ */
+
+/** The constant pi. */
+#define PI  3.14159265358979323846
+
+/** The invalid entry of a hash set. */
+#define EMPTY_SLOT  UINT_MAX
+
+/** The maximum number of iterations of the computation of the roots of a polynomial. */
+#define MAX_NO_ITERATIONS_ROOTS     500
+
+/** A root of a polynomial is considered real if its imaginary part is less than its
+    magnitude times this tolerance. */
+#define REL_TOL_IMAG_PART_OF_ROOT   1e-12
+
+/** Two poles are considered a double pole in the computation of the step response if
+    their distance is less than their magnitude times this tolerance. Multiple roots are
+    found with an accuracy of about the m-th root of the machine epsilon only. For the same
+    reason, a pair of conjugate complex roots, which are closer to one another, is
+    considered a multiple real root. */
+#define REL_TOL_MULTIPLE_POLE       1e-5
+
+/** Without plot information, the step response is computed up to this number of time
+    constants of the slowest stable pole. */
+#define STEP_RESPONSE_NO_TIME_CONSTANTS 7.0
+
+
+/*
+ * Local type definitions
+ */
+
+/** A function, which compares two entries of one kind of a plan under construction. */
+typedef boolean (*isEqualEntry_t)( const nfr_evaluationPlan_t * const pPlan
+                                 , unsigned int idxEntryA
+                                 , unsigned int idxEntryB
+                                 );
+
+/** A slot of an open addressing hash set. */
+typedef struct slotOfHashSet_t
+{
+    /** The hash code of the entry. */
+    unsigned int hash;
+
+    /** The index of the entry in its array of the plan or #EMPTY_SLOT. */
+    unsigned int idxEntry;
+
+} slotOfHashSet_t;
+
+
+/** A hash set of the entries of one kind of a plan under construction. It is used to find
+    an already existing, identical entry. */
+typedef struct hashSet_t
+{
+    /** The slots. The number is a power of two. */
+    slotOfHashSet_t *slotAry;
+
+    /** The number of slots. */
+    unsigned int noSlots;
+
+    /** The number of used slots. */
+    unsigned int noEntries;
+
+    /** The comparison of entries. */
+    isEqualEntry_t isEqual;
+
+} hashSet_t;
+
+
+/** The data needed while compiling a solution into a plan. */
+typedef struct planBuilder_t
+{
+    /** The plan under construction. */
+    nfr_evaluationPlan_t *pPlan;
+
+    /** The allocated sizes of the growing arrays of the plan. */
+    unsigned int maxNoFactors, maxNoMonomials, maxNoTerms, maxNoCoefs, maxNoIdxCoefs
+               , maxNoExprs;
+
+    /** The hash sets of monomials, coefficients and expressions of the plan. */
+    hashSet_t monomialSet, coefSet, exprSet;
+
+} planBuilder_t;
+
+
+/** Gain, zeros and poles of a transfer function H(s) = gain * prod(s-z_i) / prod(s-p_i). */
+typedef struct poleZeroDesc_t
+{
+    /** The ratio of the coefficients of the highest powers of s of numerator and
+        denominator. Null for the null transfer function. */
+    double gain;
+
+    /** The number of zeros at the origin. */
+    unsigned int noZerosAtOrigin;
+
+    /** The number of other zeros. */
+    unsigned int noZeros;
+
+    /** The zeros other than at the origin. */
+    double complex *zeroAry;
+
+    /** The number of poles at the origin. */
+    unsigned int noPolesAtOrigin;
+
+    /** The number of other poles. */
+    unsigned int noPoles;
+
+    /** The poles other than at the origin. */
+    double complex *poleAry;
+
+} poleZeroDesc_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** A global logger object is referenced from anywhere for writing progress messages. */
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+#ifdef  DEBUG
+/** A global counter of all created plan objects. Used to detect memory leaks. */
+static THREAD_LOCAL unsigned int _noRefsToObjects = 0;
+#endif
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Create the vector of frequencies, which the frequency response is computed for. The
+ * vector is shaped in accordance with the plot information of the result, like the Octave
+ * script getFrequencyVector does.
+ *   @return
+ * Get the number of frequency points.
+ *   @param pFreqAry
+ * The frequencies in Hz are returned in * \a pFreqAry as a malloc allocated array. It
+ * needs to be freed after use.
+ *   @param pPlotInfo
+ * The plot information of the result or NULL if the circuit file doesn't specify one. A
+ * logarithmic distribution of the default frequency range is used in the latter case.
+ */
+
+static unsigned int createFrequencyVector( double * * const pFreqAry
+                                         , const pci_plotInfo_t * const pPlotInfo
+                                         )
+{
+    boolean isLogX;
+    unsigned int noPoints;
+    double fMin, fMax;
+    if(pPlotInfo != NULL)
+    {
+        isLogX = pPlotInfo->isLogX;
+        noPoints = pPlotInfo->noPoints;
+        fMin = pPlotInfo->freqLimitAry[0];
+        fMax = pPlotInfo->freqLimitAry[1];
+    }
+    else
+    {
+        isLogX = true;
+        noPoints = NFR_DEFAULT_NO_POINTS;
+        fMin = NFR_DEFAULT_FREQ_MIN;
+        fMax = NFR_DEFAULT_FREQ_MAX;
+    }
+    if(noPoints == 0)
+        noPoints = 1;
+
+    double * const freqAry = smalloc(noPoints*sizeof(double), __FILE__, __LINE__);
+    if(noPoints == 1)
+        freqAry[0] = fMin;
+    else if(isLogX  &&  fMin > 0.0  &&  fMax > 0.0)
+    {
+        const double ratio = fMax/fMin;
+        unsigned int idxPoint;
+        for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+            freqAry[idxPoint] = fMin * pow(ratio, (double)idxPoint/(double)(noPoints-1));
+    }
+    else
+    {
+        const double step = (fMax-fMin)/(double)(noPoints-1);
+        unsigned int idxPoint;
+        for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+            freqAry[idxPoint] = fMin + (double)idxPoint*step;
+    }
+
+    *pFreqAry = freqAry;
+    return noPoints;
+
+} /* End of createFrequencyVector */
+
+
+
+
+
+
+
+/**
+ * Ensure the capacity of a growing array.
+ *   @return
+ * Get the (possibly moved) array.
+ *   @param array
+ * The array. NULL is permitted if the current capacity is null.
+ *   @param pMaxNoElements
+ * The current capacity of the array prior to the call and the new capacity after return.
+ *   @param noElements
+ * The number of elements the array needs to hold.
+ *   @param sizeOfElement
+ * The size of an element in Byte.
+ */
+
+static void *growArray( void * const array
+                      , unsigned int * const pMaxNoElements
+                      , unsigned int noElements
+                      , size_t sizeOfElement
+                      )
+{
+    if(noElements <= *pMaxNoElements)
+        return array;
+
+    unsigned int maxNoElements = *pMaxNoElements > 0? *pMaxNoElements: 16;
+    while(maxNoElements < noElements)
+        maxNoElements *= 2;
+    *pMaxNoElements = maxNoElements;
+
+    return srealloc(array, maxNoElements*sizeOfElement, __FILE__, __LINE__);
+
+} /* End of growArray */
+
+
+
+
+/**
+ * Extend a hash code by a sequence of words (FNV-1a).
+ *   @return
+ * Get the extended hash code.
+ *   @param hash
+ * The hash code to extend. Use 2166136261u to start a new code.
+ *   @param wordAry
+ * The words.
+ *   @param noWords
+ * The number of words.
+ */
+
+static inline unsigned int hashWords( unsigned int hash
+                                    , const unsigned int wordAry[]
+                                    , unsigned int noWords
+                                    )
+{
+    unsigned int u;
+    for(u=0; u<noWords; ++u)
+        hash = (hash ^ wordAry[u]) * 16777619u;
+    return hash;
+
+} /* End of hashWords */
+
+
+
+
+/**
+ * Initialize an empty hash set.
+ *   @param pSet
+ * The hash set to initialize.
+ *   @param isEqual
+ * The comparison of the entries of the set.
+ */
+
+static void createHashSet(hashSet_t * const pSet, isEqualEntry_t isEqual)
+{
+    pSet->noSlots = 64;
+    pSet->noEntries = 0;
+    pSet->isEqual = isEqual;
+    pSet->slotAry = smalloc(pSet->noSlots*sizeof(slotOfHashSet_t), __FILE__, __LINE__);
+    unsigned int idxSlot;
+    for(idxSlot=0; idxSlot<pSet->noSlots; ++idxSlot)
+        pSet->slotAry[idxSlot].idxEntry = EMPTY_SLOT;
+
+} /* End of createHashSet */
+
+
+
+
+/**
+ * Free the memory of a hash set after use.
+ *   @param pSet
+ * The hash set.
+ */
+
+static void deleteHashSet(hashSet_t * const pSet)
+{
+    free(pSet->slotAry);
+    pSet->slotAry = NULL;
+    pSet->noSlots = pSet->noEntries = 0;
+
+} /* End of deleteHashSet */
+
+
+
+
+/**
+ * Look for an entry of a plan under construction, which is identical to a candidate
+ * entry. The candidate is added to the set if there's no such entry.
+ *   @return
+ * Get the index of the identical entry or \a idxCandidate if the candidate is new.
+ *   @param pSet
+ * The hash set of the kind of entries.
+ *   @param pPlan
+ * The plan under construction. It holds the candidate entry.
+ *   @param hash
+ * The hash code of the candidate.
+ *   @param idxCandidate
+ * The index of the candidate entry in its array of the plan.
+ */
+
+static unsigned int findOrAddEntry( hashSet_t * const pSet
+                                  , const nfr_evaluationPlan_t * const pPlan
+                                  , unsigned int hash
+                                  , unsigned int idxCandidate
+                                  )
+{
+    /* Keep the load of the set below 50%. */
+    if(2*(pSet->noEntries+1) > pSet->noSlots)
+    {
+        const unsigned int noSlots = 2*pSet->noSlots
+                         , mask = noSlots-1;
+        slotOfHashSet_t * const slotAry = smalloc( noSlots*sizeof(slotOfHashSet_t)
+                                                 , __FILE__
+                                                 , __LINE__
+                                                 );
+        unsigned int idxSlot;
+        for(idxSlot=0; idxSlot<noSlots; ++idxSlot)
+            slotAry[idxSlot].idxEntry = EMPTY_SLOT;
+        for(idxSlot=0; idxSlot<pSet->noSlots; ++idxSlot)
+        {
+            const slotOfHashSet_t * const pSlot = &pSet->slotAry[idxSlot];
+            if(pSlot->idxEntry != EMPTY_SLOT)
+            {
+                unsigned int idxNewSlot = pSlot->hash & mask;
+                while(slotAry[idxNewSlot].idxEntry != EMPTY_SLOT)
+                    idxNewSlot = (idxNewSlot+1) & mask;
+                slotAry[idxNewSlot] = *pSlot;
+            }
+        }
+        free(pSet->slotAry);
+        pSet->slotAry = slotAry;
+        pSet->noSlots = noSlots;
+    }
+
+    const unsigned int mask = pSet->noSlots-1;
+    unsigned int idxSlot = hash & mask;
+    while(pSet->slotAry[idxSlot].idxEntry != EMPTY_SLOT)
+    {
+        const slotOfHashSet_t * const pSlot = &pSet->slotAry[idxSlot];
+        if(pSlot->hash == hash  &&  pSet->isEqual(pPlan, pSlot->idxEntry, idxCandidate))
+            return pSlot->idxEntry;
+        idxSlot = (idxSlot+1) & mask;
+    }
+
+    pSet->slotAry[idxSlot].hash = hash;
+    pSet->slotAry[idxSlot].idxEntry = idxCandidate;
+    ++ pSet->noEntries;
+
+    return idxCandidate;
+
+} /* End of findOrAddEntry */
+
+
+
+
+/**
+ * Compare two monomials of a plan.
+ *   @return
+ * \a true if both monomials are identical.
+ *   @param pPlan
+ * The plan.
+ *   @param idxMonomialA
+ * The index of the first monomial.
+ *   @param idxMonomialB
+ * The index of the second monomial.
+ */
+
+static boolean isEqualMonomial( const nfr_evaluationPlan_t * const pPlan
+                              , unsigned int idxMonomialA
+                              , unsigned int idxMonomialB
+                              )
+{
+    const nfr_monomial_t * const pA = &pPlan->monomialAry[idxMonomialA]
+                       , * const pB = &pPlan->monomialAry[idxMonomialB];
+    if(pA->noFactors != pB->noFactors)
+        return false;
+
+    const nfr_factorOfMonomial_t * const factorAryA = pPlan->factorAry + pA->idxFirstFactor
+                                 , * const factorAryB = pPlan->factorAry + pB->idxFirstFactor;
+    unsigned int u;
+    for(u=0; u<pA->noFactors; ++u)
+    {
+        if(factorAryA[u].idxConst != factorAryB[u].idxConst
+           ||  factorAryA[u].power != factorAryB[u].power
+          )
+        {
+            return false;
+        }
+    }
+    return true;
+
+} /* End of isEqualMonomial */
+
+
+
+
+/**
+ * Compare two coefficients of a plan.
+ *   @return
+ * \a true if both coefficients are identical.
+ *   @param pPlan
+ * The plan.
+ *   @param idxCoefA
+ * The index of the first coefficient.
+ *   @param idxCoefB
+ * The index of the second coefficient.
+ */
+
+static boolean isEqualCoef( const nfr_evaluationPlan_t * const pPlan
+                          , unsigned int idxCoefA
+                          , unsigned int idxCoefB
+                          )
+{
+    const nfr_coef_t * const pA = &pPlan->coefAry[idxCoefA]
+                   , * const pB = &pPlan->coefAry[idxCoefB];
+    if(pA->noTerms != pB->noTerms)
+        return false;
+
+    const nfr_termOfCoef_t * const termAryA = pPlan->termAry + pA->idxFirstTerm
+                           , * const termAryB = pPlan->termAry + pB->idxFirstTerm;
+    unsigned int u;
+    for(u=0; u<pA->noTerms; ++u)
+    {
+        if(termAryA[u].factor != termAryB[u].factor
+           ||  termAryA[u].idxMonomial != termAryB[u].idxMonomial
+          )
+        {
+            return false;
+        }
+    }
+    return true;
+
+} /* End of isEqualCoef */
+
+
+
+
+/**
+ * Compare two expressions of a plan.
+ *   @return
+ * \a true if both expressions are identical.
+ *   @param pPlan
+ * The plan.
+ *   @param idxExprA
+ * The index of the first expression.
+ *   @param idxExprB
+ * The index of the second expression.
+ */
+
+static boolean isEqualExpression( const nfr_evaluationPlan_t * const pPlan
+                                , unsigned int idxExprA
+                                , unsigned int idxExprB
+                                )
+{
+    const nfr_expression_t * const pA = &pPlan->exprAry[idxExprA]
+                         , * const pB = &pPlan->exprAry[idxExprB];
+    if(pA->factor != pB->factor
+       ||  pA->idxMonomial != pB->idxMonomial
+       ||  pA->powerOfS != pB->powerOfS
+       ||  pA->noCoefs != pB->noCoefs
+      )
+    {
+        return false;
+    }
+
+    return memcmp( pPlan->idxCoefAry + pA->idxFirstCoef
+                 , pPlan->idxCoefAry + pB->idxFirstCoef
+                 , pA->noCoefs*sizeof(unsigned int)
+                 ) == 0;
+
+} /* End of isEqualExpression */
+
+
+
+
+/**
+ * Get the hash code of a floating point number.
+ *   @return
+ * Get the extended hash code.
+ *   @param hash
+ * The hash code to extend.
+ *   @param x
+ * The number. It must not be -0.0, which would get another code than 0.0.
+ */
+
+static inline unsigned int hashDouble(unsigned int hash, double x)
+{
+    unsigned int wordAry[sizeof(double)/sizeof(unsigned int)];
+    memcpy(wordAry, &x, sizeof(wordAry));
+    return hashWords(hash, wordAry, sizeof(wordAry)/sizeof(wordAry[0]));
+
+} /* End of hashDouble */
+
+
+
+
+/**
+ * Add the monomial of an addend of a frequency domain expression to a plan under
+ * construction.
+ *   @return
+ * Get the index of the monomial in the array of monomials of the plan. If the plan already
+ * has an identical monomial then this one's index is returned.
+ *   @param pBuilder
+ * The plan under construction.
+ *   @param pAddend
+ * The addend. Only its powers of the device constants are considered.
+ */
+
+static unsigned int addMonomial( planBuilder_t * const pBuilder
+                               , const frq_frqDomExpressionAddend_t * const pAddend
+                               )
+{
+    nfr_evaluationPlan_t * const pPlan = pBuilder->pPlan;
+
+    /* The candidate is tentatively appended to the arrays of the plan. It is committed
+       only if it is new. */
+    pPlan->monomialAry = growArray( pPlan->monomialAry
+                                  , &pBuilder->maxNoMonomials
+                                  , pPlan->noMonomials+1
+                                  , sizeof(nfr_monomial_t)
+                                  );
+    nfr_monomial_t * const pMonomial = &pPlan->monomialAry[pPlan->noMonomials];
+    pMonomial->idxFirstFactor = pPlan->noFactors;
+    pMonomial->noFactors = 0;
+
+    unsigned int hash = 2166136261u
+               , idxConst;
+    for(idxConst=0; idxConst<pPlan->noConst; ++idxConst)
+    {
+        const signed int power = pAddend->powerOfConstAry[idxConst];
+        if(power != 0)
+        {
+            pPlan->factorAry = growArray( pPlan->factorAry
+                                        , &pBuilder->maxNoFactors
+                                        , pPlan->noFactors + pMonomial->noFactors + 1
+                                        , sizeof(nfr_factorOfMonomial_t)
+                                        );
+            nfr_factorOfMonomial_t * const pFactor =
+                                    &pPlan->factorAry[pPlan->noFactors + pMonomial->noFactors];
+            pFactor->idxConst = idxConst;
+            pFactor->power = power;
+            ++ pMonomial->noFactors;
+
+            const unsigned int wordAry[2] = {idxConst, (unsigned)power};
+            hash = hashWords(hash, wordAry, 2);
+        }
+    }
+
+    const unsigned int idxMonomial = findOrAddEntry( &pBuilder->monomialSet
+                                                   , pPlan
+                                                   , hash
+                                                   , pPlan->noMonomials
+                                                   );
+    if(idxMonomial == pPlan->noMonomials)
+    {
+        pPlan->noFactors += pMonomial->noFactors;
+        ++ pPlan->noMonomials;
+    }
+
+    return idxMonomial;
+
+} /* End of addMonomial */
+
+
+
+
+/**
+ * Add the coefficient of a power of s of a frequency domain expression to a plan under
+ * construction.
+ *   @return
+ * Get the index of the coefficient in the array of coefficients of the plan. If the plan
+ * already has an identical coefficient then this one's index is returned.
+ *   @param pBuilder
+ * The plan under construction.
+ *   @param pExpr
+ * The expression, a list of addends with non negative powers of s.
+ *   @param powerOfS
+ * The power of s, which the coefficient is requested for.
+ */
+
+static unsigned int addCoef( planBuilder_t * const pBuilder
+                           , const frq_frqDomExpression_t * const pExpr
+                           , signed int powerOfS
+                           )
+{
+    nfr_evaluationPlan_t * const pPlan = pBuilder->pPlan;
+
+    /* The terms of the candidate are tentatively appended to the array of terms. Adding
+       the monomials doesn't touch this array. */
+    unsigned int noTerms = 0
+               , hash = 2166136261u;
+    const frq_frqDomExpressionAddend_t *pAddend;
+    for(pAddend=pExpr; pAddend!=NULL; pAddend=pAddend->pNext)
+    {
+        if(pAddend->powerOfS != powerOfS)
+            continue;
+
+        const unsigned int idxMonomial = addMonomial(pBuilder, pAddend);
+        pPlan->termAry = growArray( pPlan->termAry
+                                  , &pBuilder->maxNoTerms
+                                  , pPlan->noTerms + noTerms + 1
+                                  , sizeof(nfr_termOfCoef_t)
+                                  );
+        nfr_termOfCoef_t * const pTerm = &pPlan->termAry[pPlan->noTerms + noTerms];
+        pTerm->factor = (double)pAddend->factor.n / (double)pAddend->factor.d;
+        pTerm->idxMonomial = idxMonomial;
+        ++ noTerms;
+
+        hash = hashDouble(hash, pTerm->factor);
+        hash = hashWords(hash, &idxMonomial, 1);
+    }
+
+    pPlan->coefAry = growArray( pPlan->coefAry
+                              , &pBuilder->maxNoCoefs
+                              , pPlan->noCoefs+1
+                              , sizeof(nfr_coef_t)
+                              );
+    nfr_coef_t * const pCoef = &pPlan->coefAry[pPlan->noCoefs];
+    pCoef->idxFirstTerm = pPlan->noTerms;
+    pCoef->noTerms = noTerms;
+
+    const unsigned int idxCoef = findOrAddEntry( &pBuilder->coefSet
+                                               , pPlan
+                                               , hash
+                                               , pPlan->noCoefs
+                                               );
+    if(idxCoef == pPlan->noCoefs)
+    {
+        pPlan->noTerms += noTerms;
+        ++ pPlan->noCoefs;
+    }
+
+    return idxCoef;
+
+} /* End of addCoef */
+
+
+
+
+/**
+ * Add a normalized frequency domain expression to a plan under construction.
+ *   @return
+ * Get the index of the expression in the array of expressions of the plan. If the plan
+ * already has an identical expression then this one's index is returned. The null
+ * expression is represented by #NFR_NULL_EXPRESSION.
+ *   @param pBuilder
+ * The plan under construction.
+ *   @param pNExpr
+ * The expression or NULL for the null expression.
+ */
+
+static unsigned int addExpression( planBuilder_t * const pBuilder
+                                 , const frq_normalizedFrqDomExpression_t * const pNExpr
+                                 )
+{
+    if(pNExpr == NULL)
+        return NFR_NULL_EXPRESSION;
+
+    nfr_evaluationPlan_t * const pPlan = pBuilder->pPlan;
+
+    /* The remaining expression of a normalized expression has only non negative powers of
+       s. */
+    const frq_frqDomExpressionAddend_t *pAddend;
+    unsigned int degree = 0;
+    for(pAddend=pNExpr->pExpr; pAddend!=NULL; pAddend=pAddend->pNext)
+    {
+        assert(pAddend->powerOfS >= 0);
+        if((unsigned)pAddend->powerOfS > degree)
+            degree = (unsigned)pAddend->powerOfS;
+    }
+
+    /* The coefficients of the candidate are tentatively appended to the array of
+       coefficient indexes. Adding the coefficients doesn't touch this array. */
+    const unsigned int noCoefs = degree+1;
+    pPlan->idxCoefAry = growArray( pPlan->idxCoefAry
+                                 , &pBuilder->maxNoIdxCoefs
+                                 , pPlan->noIdxCoefs + noCoefs
+                                 , sizeof(unsigned int)
+                                 );
+    unsigned int * const idxCoefAry = pPlan->idxCoefAry + pPlan->noIdxCoefs
+               , power;
+    for(power=0; power<noCoefs; ++power)
+        idxCoefAry[power] = addCoef(pBuilder, pNExpr->pExpr, (signed)power);
+
+    const double factor = (double)pNExpr->pFactor->factor.n
+                          / (double)pNExpr->pFactor->factor.d;
+    const unsigned int idxMonomial = addMonomial(pBuilder, pNExpr->pFactor);
+    pPlan->exprAry = growArray( pPlan->exprAry
+                              , &pBuilder->maxNoExprs
+                              , pPlan->noExprs+1
+                              , sizeof(nfr_expression_t)
+                              );
+    nfr_expression_t * const pExpr = &pPlan->exprAry[pPlan->noExprs];
+    pExpr->factor = factor;
+    pExpr->idxMonomial = idxMonomial;
+    pExpr->powerOfS = pNExpr->pFactor->powerOfS;
+    pExpr->idxFirstCoef = pPlan->noIdxCoefs;
+    pExpr->noCoefs = noCoefs;
+
+    unsigned int hash = hashDouble(2166136261u, factor);
+    const unsigned int wordAry[2] = {idxMonomial, (unsigned)pExpr->powerOfS};
+    hash = hashWords(hash, wordAry, 2);
+    hash = hashWords(hash, idxCoefAry, noCoefs);
+
+    const unsigned int idxExpr = findOrAddEntry( &pBuilder->exprSet
+                                               , pPlan
+                                               , hash
+                                               , pPlan->noExprs
+                                               );
+    if(idxExpr == pPlan->noExprs)
+    {
+        pPlan->noIdxCoefs += noCoefs;
+        ++ pPlan->noExprs;
+    }
+
+    return idxExpr;
+
+} /* End of addExpression */
+
+
+
+
+/**
+ * Add a numeric coefficient of a polynomial to a plan under construction. The coefficient
+ * has a single term, the numeric value times the monomial one.
+ *   @return
+ * Get the index of the coefficient in the array of coefficients of the plan. If the plan
+ * already has an identical coefficient then this one's index is returned.
+ *   @param pBuilder
+ * The plan under construction.
+ *   @param value
+ * The value of the coefficient.
+ *   @param idxMonomialOne
+ * The index of the monomial one, which has no factors.
+ */
+
+static unsigned int addNumericCoef( planBuilder_t * const pBuilder
+                                  , double value
+                                  , unsigned int idxMonomialOne
+                                  )
+{
+    nfr_evaluationPlan_t * const pPlan = pBuilder->pPlan;
+
+    /* The null coefficient has no terms. -0.0 would get another hash code than 0.0. */
+    const unsigned int noTerms = value != 0.0? 1: 0;
+    unsigned int hash = 2166136261u;
+    if(noTerms > 0)
+    {
+        pPlan->termAry = growArray( pPlan->termAry
+                                  , &pBuilder->maxNoTerms
+                                  , pPlan->noTerms+1
+                                  , sizeof(nfr_termOfCoef_t)
+                                  );
+        nfr_termOfCoef_t * const pTerm = &pPlan->termAry[pPlan->noTerms];
+        pTerm->factor = value;
+        pTerm->idxMonomial = idxMonomialOne;
+        hash = hashDouble(hash, pTerm->factor);
+        hash = hashWords(hash, &idxMonomialOne, 1);
+    }
+
+    pPlan->coefAry = growArray( pPlan->coefAry
+                              , &pBuilder->maxNoCoefs
+                              , pPlan->noCoefs+1
+                              , sizeof(nfr_coef_t)
+                              );
+    nfr_coef_t * const pCoef = &pPlan->coefAry[pPlan->noCoefs];
+    pCoef->idxFirstTerm = pPlan->noTerms;
+    pCoef->noTerms = noTerms;
+
+    const unsigned int idxCoef = findOrAddEntry( &pBuilder->coefSet
+                                               , pPlan
+                                               , hash
+                                               , pPlan->noCoefs
+                                               );
+    if(idxCoef == pPlan->noCoefs)
+    {
+        pPlan->noTerms += noTerms;
+        ++ pPlan->noCoefs;
+    }
+
+    return idxCoef;
+
+} /* End of addNumericCoef */
+
+
+
+
+/**
+ * Add a polynomial with numeric coefficients to a plan under construction.
+ *   @return
+ * Get the index of the expression in the array of expressions of the plan. If the plan
+ * already has an identical expression then this one's index is returned. The null
+ * polynomial is represented by #NFR_NULL_EXPRESSION.
+ *   @param pBuilder
+ * The plan under construction.
+ *   @param pPoly
+ * The polynomial.
+ *   @param idxMonomialOne
+ * The index of the monomial one, which has no factors.
+ */
+
+static unsigned int addPolynomial( planBuilder_t * const pBuilder
+                                 , const nsl_polynomial_t * const pPoly
+                                 , unsigned int idxMonomialOne
+                                 )
+{
+    if(pPoly->noCoefs == 0)
+        return NFR_NULL_EXPRESSION;
+
+    nfr_evaluationPlan_t * const pPlan = pBuilder->pPlan;
+    const unsigned int noCoefs = pPoly->noCoefs;
+    pPlan->idxCoefAry = growArray( pPlan->idxCoefAry
+                                 , &pBuilder->maxNoIdxCoefs
+                                 , pPlan->noIdxCoefs + noCoefs
+                                 , sizeof(unsigned int)
+                                 );
+    unsigned int * const idxCoefAry = pPlan->idxCoefAry + pPlan->noIdxCoefs
+               , idxCoef;
+    for(idxCoef=0; idxCoef<noCoefs; ++idxCoef)
+    {
+        idxCoefAry[idxCoef] = addNumericCoef( pBuilder
+                                            , pPoly->coefAry[idxCoef]
+                                            , idxMonomialOne
+                                            );
+    }
+
+    pPlan->exprAry = growArray( pPlan->exprAry
+                              , &pBuilder->maxNoExprs
+                              , pPlan->noExprs+1
+                              , sizeof(nfr_expression_t)
+                              );
+    nfr_expression_t * const pExpr = &pPlan->exprAry[pPlan->noExprs];
+    pExpr->factor = 1.0;
+    pExpr->idxMonomial = idxMonomialOne;
+    pExpr->powerOfS = pPoly->powerOfS;
+    pExpr->idxFirstCoef = pPlan->noIdxCoefs;
+    pExpr->noCoefs = noCoefs;
+
+    unsigned int hash = hashDouble(2166136261u, pExpr->factor);
+    const unsigned int wordAry[2] = {idxMonomialOne, (unsigned)pExpr->powerOfS};
+    hash = hashWords(hash, wordAry, 2);
+    hash = hashWords(hash, idxCoefAry, noCoefs);
+
+    const unsigned int idxExpr = findOrAddEntry( &pBuilder->exprSet
+                                               , pPlan
+                                               , hash
+                                               , pPlan->noExprs
+                                               );
+    if(idxExpr == pPlan->noExprs)
+    {
+        pPlan->noIdxCoefs += noCoefs;
+        ++ pPlan->noExprs;
+    }
+
+    return idxExpr;
+
+} /* End of addPolynomial */
+
+
+
+
+/**
+ * Compute the values of all monomials of a plan for many parameter vectors.
+ *   @param monomialValAry
+ * The values are placed into this array. Row i holds the \a noParamSets values of monomial
+ * i.
+ *   @param pPlan
+ * The plan.
+ *   @param noParamSets
+ * The number of parameter vectors.
+ *   @param valueOfConstAry
+ * The parameter vectors in structure-of-arrays form, see nfr_evaluatePlan().
+ */
+
+static void evaluateMonomials( double * restrict const monomialValAry
+                             , const nfr_evaluationPlan_t * const pPlan
+                             , unsigned int noParamSets
+                             , const double * restrict const valueOfConstAry
+                             )
+{
+    unsigned int idxMonomial, idxSet;
+    for(idxMonomial=0; idxMonomial<pPlan->noMonomials; ++idxMonomial)
+    {
+        double * restrict const valAry = monomialValAry + (size_t)idxMonomial*noParamSets;
+        for(idxSet=0; idxSet<noParamSets; ++idxSet)
+            valAry[idxSet] = 1.0;
+
+        const nfr_monomial_t * const pMonomial = &pPlan->monomialAry[idxMonomial];
+        const nfr_factorOfMonomial_t * const factorAry = pPlan->factorAry
+                                                         + pMonomial->idxFirstFactor;
+        unsigned int idxFactor;
+        for(idxFactor=0; idxFactor<pMonomial->noFactors; ++idxFactor)
+        {
+            const double * restrict const constAry = valueOfConstAry
+                                             + (size_t)factorAry[idxFactor].idxConst*noParamSets;
+            const signed int power = factorAry[idxFactor].power;
+
+            /* The by far most frequent powers are handled without the costly pow. */
+            if(power == 1)
+            {
+                for(idxSet=0; idxSet<noParamSets; ++idxSet)
+                    valAry[idxSet] *= constAry[idxSet];
+            }
+            else if(power == -1)
+            {
+                for(idxSet=0; idxSet<noParamSets; ++idxSet)
+                    valAry[idxSet] /= constAry[idxSet];
+            }
+            else
+            {
+                for(idxSet=0; idxSet<noParamSets; ++idxSet)
+                    valAry[idxSet] *= pow(constAry[idxSet], (double)power);
+            }
+        }
+    }
+} /* End of evaluateMonomials */
+
+
+
+
+/**
+ * Compute the values of all coefficients of a plan for many parameter vectors.
+ *   @param coefValAry
+ * The values are placed into this array. Row i holds the \a noParamSets values of
+ * coefficient i.
+ *   @param pPlan
+ * The plan.
+ *   @param noParamSets
+ * The number of parameter vectors.
+ *   @param monomialValAry
+ * The values of all monomials as computed by evaluateMonomials().
+ */
+
+static void evaluateCoefs( double * restrict const coefValAry
+                         , const nfr_evaluationPlan_t * const pPlan
+                         , unsigned int noParamSets
+                         , const double * restrict const monomialValAry
+                         )
+{
+    unsigned int idxCoef, idxSet;
+    for(idxCoef=0; idxCoef<pPlan->noCoefs; ++idxCoef)
+    {
+        double * restrict const valAry = coefValAry + (size_t)idxCoef*noParamSets;
+        for(idxSet=0; idxSet<noParamSets; ++idxSet)
+            valAry[idxSet] = 0.0;
+
+        const nfr_coef_t * const pCoef = &pPlan->coefAry[idxCoef];
+        const nfr_termOfCoef_t * const termAry = pPlan->termAry + pCoef->idxFirstTerm;
+        unsigned int idxTerm;
+        for(idxTerm=0; idxTerm<pCoef->noTerms; ++idxTerm)
+        {
+            const double factor = termAry[idxTerm].factor;
+            const double * restrict const monAry = monomialValAry
+                                           + (size_t)termAry[idxTerm].idxMonomial*noParamSets;
+            for(idxSet=0; idxSet<noParamSets; ++idxSet)
+                valAry[idxSet] += factor*monAry[idxSet];
+        }
+    }
+} /* End of evaluateCoefs */
+
+
+
+
+/**
+ * Compute the values of all expressions of a plan at a single frequency for many
+ * parameter vectors.
+ *   @param reAry
+ * The real parts of the values are placed into this array. Row i holds the \a noParamSets
+ * values of expression i.
+ *   @param imAry
+ * The imaginary parts of the values, organized like \a reAry.
+ *   @param pPlan
+ * The plan.
+ *   @param noParamSets
+ * The number of parameter vectors.
+ *   @param monomialValAry
+ * The values of all monomials as computed by evaluateMonomials().
+ *   @param coefValAry
+ * The values of all coefficients as computed by evaluateCoefs().
+ *   @param omega
+ * The angular frequency; the expressions are evaluated for s = j*omega.
+ */
+
+static void evaluateExpressions( double * restrict const reAry
+                               , double * restrict const imAry
+                               , const nfr_evaluationPlan_t * const pPlan
+                               , unsigned int noParamSets
+                               , const double * restrict const monomialValAry
+                               , const double * restrict const coefValAry
+                               , double omega
+                               )
+{
+    unsigned int idxExpr, idxSet;
+    for(idxExpr=0; idxExpr<pPlan->noExprs; ++idxExpr)
+    {
+        const nfr_expression_t * const pExpr = &pPlan->exprAry[idxExpr];
+        const unsigned int * const idxCoefAry = pPlan->idxCoefAry + pExpr->idxFirstCoef;
+        double * restrict const re = reAry + (size_t)idxExpr*noParamSets
+               , * restrict const im = imAry + (size_t)idxExpr*noParamSets;
+
+        /* Horner scheme: p := p*s + c, with s = j*omega:
+           (re + j*im)*j*omega = -im*omega + j*re*omega. */
+        unsigned int power = pExpr->noCoefs-1;
+        const double *c = coefValAry + (size_t)idxCoefAry[power]*noParamSets;
+        for(idxSet=0; idxSet<noParamSets; ++idxSet)
+        {
+            re[idxSet] = c[idxSet];
+            im[idxSet] = 0.0;
+        }
+        while(power-- > 0)
+        {
+            c = coefValAry + (size_t)idxCoefAry[power]*noParamSets;
+            for(idxSet=0; idxSet<noParamSets; ++idxSet)
+            {
+                const double tmp = re[idxSet];
+                re[idxSet] = c[idxSet] - im[idxSet]*omega;
+                im[idxSet] = tmp*omega;
+            }
+        }
+
+        /* Multiply by the common factor, which may have any power of s; the power of j
+           rotates the result by a multiple of 90 degrees. */
+        const double factor = pExpr->factor * pow(omega, (double)pExpr->powerOfS);
+        const double * restrict const monAry = monomialValAry
+                                               + (size_t)pExpr->idxMonomial*noParamSets;
+        const unsigned int powerOfJ = (unsigned)(((pExpr->powerOfS % 4) + 4) % 4);
+        static const double reOfPowerOfJAry[4] = {1.0, 0.0, -1.0, 0.0}
+                          , imOfPowerOfJAry[4] = {0.0, 1.0, 0.0, -1.0};
+        const double reJ = reOfPowerOfJAry[powerOfJ]
+                   , imJ = imOfPowerOfJAry[powerOfJ];
+        for(idxSet=0; idxSet<noParamSets; ++idxSet)
+        {
+            const double f = factor*monAry[idxSet]
+                       , r = f*re[idxSet]
+                       , i = f*im[idxSet];
+            re[idxSet] = reJ*r - imJ*i;
+            im[idxSet] = imJ*r + reJ*i;
+        }
+    }
+} /* End of evaluateExpressions */
+
+
+
+
+
+
+
+
+/**
+ * Convert complex numbers into magnitude and phase. The complex numbers are replaced by
+ * the result in place.
+ *   @param magAry
+ * The real parts prior to the call and the magnitudes in dB after return.
+ *   @param phaseAry
+ * The imaginary parts prior to the call and the phases in degrees after return. The phase
+ * is unwrapped, i.e. it is continued beyond +/-180 degrees where it doesn't jump.
+ *   @param noPoints
+ * The number of elements of both arrays.
+ */
+
+static void getMagnitudeAndPhase( double * restrict const magAry
+                                , double * restrict const phaseAry
+                                , unsigned int noPoints
+                                )
+{
+    unsigned int idxPoint;
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+    {
+        const double re = magAry[idxPoint]
+                   , im = phaseAry[idxPoint];
+        magAry[idxPoint] = 20.0*log10(hypot(re, im));
+
+        /* Adding null turns a negative zero into a positive one, which would otherwise
+           appear as "-0" in the output. */
+        phaseAry[idxPoint] = atan2(im, re) * (180.0/PI) + 0.0;
+    }
+
+    for(idxPoint=1; idxPoint<noPoints; ++idxPoint)
+    {
+        const double prev = phaseAry[idxPoint-1];
+        while(phaseAry[idxPoint] - prev > 180.0)
+            phaseAry[idxPoint] -= 360.0;
+        while(phaseAry[idxPoint] - prev < -180.0)
+            phaseAry[idxPoint] += 360.0;
+    }
+} /* End of getMagnitudeAndPhase */
+
+
+
+
+/**
+ * Write the computed frequency responses into a CSV file. The first column holds the
+ * frequency in Hz, each transfer function adds a column for the magnitude in dB and a
+ * column for the phase in degrees.
+ *   @return
+ * \a true if the file could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param fileName
+ * The name of the file. An existing file is overwritten.
+ *   @param noDependents
+ * The number of dependents.
+ *   @param nameOfDependentAry
+ * The names of the dependents.
+ *   @param noIndependents
+ * The number of independents.
+ *   @param nameOfIndependentAry
+ * The names of the independents.
+ *   @param freqAry
+ * The \a noPoints frequencies.
+ *   @param noPoints
+ * The number of frequency points.
+ *   @param magAry
+ * The magnitudes of all transfer functions. Row i*noIndependents+j holds the \a noPoints
+ * values of dependent i with respect to independent j.
+ *   @param phaseAry
+ * The phases of all transfer functions, organized like \a magAry.
+ */
+
+static boolean writeCsvFile( const char * const fileName
+                           , unsigned int noDependents
+                           , const char * const nameOfDependentAry[]
+                           , unsigned int noIndependents
+                           , const char * const nameOfIndependentAry[]
+                           , const double freqAry[]
+                           , unsigned int noPoints
+                           , const double * const magAry
+                           , const double * const phaseAry
+                           )
+{
+    FILE * const hFile = fopen(fileName, "w");
+    if(hFile == NULL)
+    {
+        LOG_ERROR( _log
+                 , "Frequency response file %s can't be opened for write access (errno:"
+                   " %d, %s)"
+                 , fileName
+                 , errno
+                 , strerror(errno)
+                 )
+        return false;
+    }
+
+    const unsigned int noTransferFcts = noDependents*noIndependents;
+
+    fprintf(hFile, "f (Hz)");
+    unsigned int idxDep, idxIndep;
+    for(idxDep=0; idxDep<noDependents; ++idxDep)
+    {
+        const char * const nameDep = nameOfDependentAry[idxDep];
+        for(idxIndep=0; idxIndep<noIndependents; ++idxIndep)
+        {
+            const char * const nameIndep = nameOfIndependentAry[idxIndep];
+            fprintf( hFile
+                   , ",|%s/%s| (dB),arg(%s/%s) (deg)"
+                   , nameDep
+                   , nameIndep
+                   , nameDep
+                   , nameIndep
+                   );
+        }
+    }
+    fprintf(hFile, "\n");
+
+    unsigned int idxPoint;
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+    {
+        fprintf(hFile, "%.9g", freqAry[idxPoint]);
+        unsigned int idxTf;
+        for(idxTf=0; idxTf<noTransferFcts; ++idxTf)
+        {
+            fprintf( hFile
+                   , ",%.9g,%.9g"
+                   , magAry[idxTf*noPoints + idxPoint]
+                   , phaseAry[idxTf*noPoints + idxPoint]
+                   );
+        }
+        fprintf(hFile, "\n");
+    }
+
+    boolean success = !ferror(hFile);
+    if(fclose(hFile) != 0)
+        success = false;
+    if(success)
+        LOG_INFO(_log, "Frequency response file %s successfully written", fileName)
+    else
+    {
+        LOG_ERROR( _log
+                 , "Error while writing file %s. The file contents are possibly corrupt"
+                 , fileName
+                 )
+    }
+
+    return success;
+
+} /* End of writeCsvFile */
+
+
+
+
+/**
+ * Compute the frequency responses of all transfer functions of a plan and write them into
+ * a CSV file. The device constants get their nominal values, see nfr_getNominalValues().
+ *   @return
+ * \a true if the file could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param fileName
+ * The name of the CSV file. An existing file is overwritten.
+ *   @param pPlan
+ * The plan.
+ *   @param nameOfResult
+ * The name of the result. Used for reporting.
+ *   @param pPlotInfo
+ * The plot information of the result, which defines the frequency points, or NULL for the
+ * default frequencies.
+ *   @param nameOfDependentAry
+ * The names of the dependents of the plan.
+ *   @param nameOfIndependentAry
+ * The names of the independents of the plan.
+ */
+
+static boolean exportFrequencyResponse( const char * const fileName
+                                      , const nfr_evaluationPlan_t * const pPlan
+                                      , const char * const nameOfResult
+                                      , const pci_plotInfo_t * const pPlotInfo
+                                      , const char * const nameOfDependentAry[]
+                                      , const char * const nameOfIndependentAry[]
+                                      )
+{
+    double *freqAry;
+    const unsigned int noPoints = createFrequencyVector(&freqAry, pPlotInfo);
+    double * const omegaAry = smalloc(noPoints*sizeof(double), __FILE__, __LINE__);
+    unsigned int idxPoint;
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+        omegaAry[idxPoint] = 2.0*PI*freqAry[idxPoint];
+
+    double * const valueOfConstAry = smalloc( (pPlan->noConst > 0? pPlan->noConst: 1)
+                                              * sizeof(double)
+                                            , __FILE__
+                                            , __LINE__
+                                            );
+    nfr_getNominalValues(pPlan, valueOfConstAry);
+
+    const unsigned int noTransferFcts = pPlan->noDependents*pPlan->noIndependents;
+    LOG_DEBUG( _log
+             , "Result %s: The frequency responses of %u transfer functions are computed"
+               " for %u frequencies"
+             , nameOfResult
+             , noTransferFcts
+             , noPoints
+             )
+
+    /* A single parameter vector: The layout of the results of the evaluation is the one
+       required by writeCsvFile. */
+    const size_t noValues = (size_t)noTransferFcts*noPoints;
+    double * const magAry = smalloc( (noValues > 0? 2*noValues: 1)*sizeof(double)
+                                   , __FILE__
+                                   , __LINE__
+                                   )
+           , * const phaseAry = magAry + noValues;
+    nfr_evaluatePlan( pPlan
+                    , /* noParamSets */ 1
+                    , valueOfConstAry
+                    , noPoints
+                    , omegaAry
+                    , magAry
+                    , phaseAry
+                    );
+    unsigned int idxTf;
+    for(idxTf=0; idxTf<noTransferFcts; ++idxTf)
+    {
+        getMagnitudeAndPhase( magAry + (size_t)idxTf*noPoints
+                            , phaseAry + (size_t)idxTf*noPoints
+                            , noPoints
+                            );
+    }
+
+    const boolean success = writeCsvFile( fileName
+                                        , pPlan->noDependents
+                                        , nameOfDependentAry
+                                        , pPlan->noIndependents
+                                        , nameOfIndependentAry
+                                        , freqAry
+                                        , noPoints
+                                        , magAry
+                                        , phaseAry
+                                        );
+    free(magAry);
+    free(valueOfConstAry);
+    free(omegaAry);
+    free(freqAry);
+
+    return success;
+
+} /* End of exportFrequencyResponse */
+
+
+
+
+/**
+ * Get a polynomial of an evaluation plan as a real polynomial in s for a single parameter
+ * vector. The common factor of the expression is multiplied into the coefficients, except
+ * for its power of s. Null coefficients of the lowest and highest powers are removed from
+ * the polynomial; the lowest power of s is returned separately.
+ *   @return
+ * Get the number of coefficients of the polynomial, which is its degree plus one. Null is
+ * returned if the expression is the null expression or if all of its coefficients are
+ * null.
+ *   @param polyAry
+ * The coefficients are placed into this array, the coefficient of s^0 first; it needs to
+ * have room for \a noCoefs elements of the expression.
+ *   @param pPowerOfS
+ * The power of s of the common factor of the polynomial is returned in * \a pPowerOfS.
+ *   @param pPlan
+ * The plan.
+ *   @param monomialValAry
+ * The values of all monomials for the single parameter vector as computed by
+ * evaluateMonomials().
+ *   @param coefValAry
+ * The values of all coefficients for the single parameter vector as computed by
+ * evaluateCoefs().
+ *   @param idxExpr
+ * The expression as index into \a pPlan->exprAry or #NFR_NULL_EXPRESSION.
+ */
+
+static unsigned int getPolynomialOfExpression( double polyAry[]
+                                             , signed int * const pPowerOfS
+                                             , const nfr_evaluationPlan_t * const pPlan
+                                             , const double monomialValAry[]
+                                             , const double coefValAry[]
+                                             , unsigned int idxExpr
+                                             )
+{
+    *pPowerOfS = 0;
+    if(idxExpr == NFR_NULL_EXPRESSION)
+        return 0;
+
+    assert(idxExpr < pPlan->noExprs);
+    const nfr_expression_t * const pExpr = &pPlan->exprAry[idxExpr];
+    const unsigned int * const idxCoefAry = pPlan->idxCoefAry + pExpr->idxFirstCoef;
+    const double factor = pExpr->factor * monomialValAry[pExpr->idxMonomial];
+
+    /* Strip the null coefficients at both ends. */
+    unsigned int idxFirst = 0
+               , noCoefs = pExpr->noCoefs;
+    while(noCoefs > 0  &&  coefValAry[idxCoefAry[noCoefs-1]] == 0.0)
+        -- noCoefs;
+    while(idxFirst < noCoefs  &&  coefValAry[idxCoefAry[idxFirst]] == 0.0)
+        ++ idxFirst;
+    if(noCoefs == 0  ||  factor == 0.0)
+        return 0;
+
+    unsigned int power;
+    for(power=idxFirst; power<noCoefs; ++power)
+        polyAry[power-idxFirst] = factor*coefValAry[idxCoefAry[power]];
+
+    *pPowerOfS = pExpr->powerOfS + (signed int)idxFirst;
+    return noCoefs - idxFirst;
+
+} /* End of getPolynomialOfExpression */
+
+
+
+
+/**
+ * Compare function for qsort; used to sort the roots of a polynomial in a deterministic
+ * order, which doesn't depend on the order, in which the iteration found them: by
+ * ascending magnitude, equal magnitudes by descending imaginary part, i.e. a root in the
+ * upper half plane precedes its conjugate, and eventually by ascending real part.
+ *   @return
+ * The result is greater than null if op1 is greater than op2, null if they are equal and
+ * less than null otherwise.
+ *   @param pOp1
+ * First operand of comparison, an object of type double complex.
+ *   @param pOp2
+ * Second operand of comparison, an object of type double complex.
+ */
+
+static signed int cmpRoots(const void *pOp1, const void *pOp2)
+{
+    const double complex r1 = *(const double complex*)pOp1
+                       , r2 = *(const double complex*)pOp2;
+    const double mag1 = cabs(r1)
+               , mag2 = cabs(r2);
+    if(mag1 != mag2)
+        return mag1 < mag2? -1: 1;
+    else if(cimag(r1) != cimag(r2))
+        return cimag(r1) > cimag(r2)? -1: 1;
+    else if(creal(r1) != creal(r2))
+        return creal(r1) < creal(r2)? -1: 1;
+    else
+        return 0;
+
+} /* End of cmpRoots */
+
+
+
+
+/**
+ * Normalize the roots of a real polynomial as found by the iteration. The non-real roots
+ * of a real polynomial are pairs of complex conjugates but the iteration yields the two
+ * roots of a pair with independent rounding errors. Each root in the upper half plane is
+ * paired with the root in the lower half plane, which is closest to its conjugate, and
+ * both are replaced by their mean, so that they become exact conjugates. A pair, whose
+ * distance is less than #REL_TOL_MULTIPLE_POLE times its magnitude, is a multiple real
+ * root, which the iteration can't resolve any better; it becomes real. Eventually, the
+ * roots are sorted, see cmpRoots.
+ *   @param rootAry
+ * The \a degree roots. They are modified in place.
+ *   @param degree
+ * The degree of the polynomial, at least one.
+ */
+
+static void normalizeRoots(double complex rootAry[], unsigned int degree)
+{
+    assert(degree > 0);
+
+    /* Roots, which are real within the accuracy of the iteration, get a null imaginary
+       part. */
+    boolean isPairedAry[degree];
+    unsigned int j;
+    for(j=0; j<degree; ++j)
+    {
+        if(fabs(cimag(rootAry[j])) <= REL_TOL_IMAG_PART_OF_ROOT*cabs(rootAry[j]))
+            rootAry[j] = creal(rootAry[j]);
+        isPairedAry[j] = false;
+    }
+
+    for(j=0; j<degree; ++j)
+    {
+        if(isPairedAry[j]  ||  cimag(rootAry[j]) <= 0.0)
+            continue;
+
+        /* Look for the conjugate partner of the root in the upper half plane. A root can
+           lack its partner only if the iteration didn't converge. */
+        unsigned int idxPartner = UINT_MAX
+                   , k;
+        double minDistance = 0.0;
+        for(k=0; k<degree; ++k)
+        {
+            if(isPairedAry[k]  ||  cimag(rootAry[k]) >= 0.0)
+                continue;
+            const double distance = cabs(rootAry[j] - conj(rootAry[k]));
+            if(idxPartner == UINT_MAX  ||  distance < minDistance)
+            {
+                idxPartner = k;
+                minDistance = distance;
+            }
+        }
+        if(idxPartner == UINT_MAX)
+            continue;
+
+        double complex mean = (rootAry[j] + conj(rootAry[idxPartner])) / 2.0;
+        if(2.0*cimag(mean) <= REL_TOL_MULTIPLE_POLE*cabs(mean))
+            mean = creal(mean);
+        rootAry[j] = mean;
+        rootAry[idxPartner] = conj(mean);
+        isPairedAry[j] =
+        isPairedAry[idxPartner] = true;
+
+    } /* End for(All roots in the upper half plane) */
+
+    qsort(rootAry, degree, sizeof(rootAry[0]), cmpRoots);
+
+} /* End of normalizeRoots */
+
+
+
+
+/**
+ * Find all roots of a real polynomial by the Aberth-Ehrlich method. The iteration
+ * refines approximations of all roots simultaneously; it converges for multiple roots,
+ * too, though only linearly. The polynomial is scaled in s such that the geometric mean
+ * of the magnitudes of the roots is one; the coefficients of polynomials in s of
+ * electronic circuits typically span hundreds of orders of magnitude. The found roots are
+ * normalized, see normalizeRoots.
+ *   @return
+ * \a true if the iteration converged for all roots, \a false if the iteration limit was
+ * reached. The roots are still the best available approximations in the latter case.
+ *   @param rootAry
+ * The \a degree roots are placed into this array.
+ *   @param polyAry
+ * The \a degree+1 coefficients of the polynomial, the coefficient of s^0 first. The
+ * coefficients of s^0 and of s^degree must not be null.
+ *   @param degree
+ * The degree of the polynomial.
+ */
+
+static boolean findRootsOfPolynomial( double complex rootAry[]
+                                    , const double polyAry[]
+                                    , unsigned int degree
+                                    )
+{
+    assert(polyAry[0] != 0.0  &&  polyAry[degree] != 0.0);
+    if(degree == 0)
+        return true;
+
+    /* Scale the polynomial to b(z) = a(sigma*z) / (a_n*sigma^n). b is monic and |b_0| is
+       one. The error bound of the evaluation of b at z is the evaluation of the
+       magnitudes of the coefficients at |z| times the machine epsilon. */
+    const double sigma = pow(fabs(polyAry[0]/polyAry[degree]), 1.0/(double)degree);
+    double bAry[degree+1]
+         , bAbsAry[degree+1];
+    unsigned int k;
+    for(k=0; k<=degree; ++k)
+    {
+        bAry[k] = polyAry[k]/polyAry[degree] * pow(sigma, (double)k - (double)degree);
+        bAbsAry[k] = fabs(bAry[k]);
+    }
+    bAry[degree] = 1.0;
+
+    /* The initial approximations are equally distributed on the unit circle. The offset
+       of the angle avoids a symmetry with the real axis, which would make the conjugate
+       roots of a real polynomial unreachable. */
+    boolean isConvergedAry[degree];
+    unsigned int j;
+    for(j=0; j<degree; ++j)
+    {
+        rootAry[j] = cexp(I*(2.0*PI*(double)j/(double)degree + 0.4));
+        isConvergedAry[j] = false;
+    }
+
+    unsigned int noConverged = 0
+               , iter;
+    for(iter=0; iter<MAX_NO_ITERATIONS_ROOTS  &&  noConverged < degree; ++iter)
+    {
+        for(j=0; j<degree; ++j)
+        {
+            if(isConvergedAry[j])
+                continue;
+
+            /* Horner scheme for b(z), b'(z) and the error bound of b(z). */
+            const double complex z = rootAry[j];
+            const double absZ = cabs(z);
+            double complex b = 1.0
+                         , db = 0.0;
+            double errBound = 1.0;
+            for(k=degree; k-- > 0; )
+            {
+                db = db*z + b;
+                b = b*z + bAry[k];
+                errBound = errBound*absZ + bAbsAry[k];
+            }
+
+            /* Stop iterating a root if b(z) is within the rounding error of its
+               evaluation. */
+            if(cabs(b) <= 4.0*DBL_EPSILON*errBound  ||  db == 0.0)
+            {
+                isConvergedAry[j] = true;
+                ++ noConverged;
+                continue;
+            }
+
+            const double complex ratio = b/db;
+            double complex sum = 0.0;
+            for(k=0; k<degree; ++k)
+            {
+                if(k != j)
+                    sum += 1.0/(z - rootAry[k]);
+            }
+            rootAry[j] = z - ratio/(1.0 - ratio*sum);
+        }
+    } /* End for(All iterations) */
+
+    /* Undo the scaling. */
+    for(j=0; j<degree; ++j)
+        rootAry[j] *= sigma;
+    normalizeRoots(rootAry, degree);
+
+    return noConverged == degree;
+
+} /* End of findRootsOfPolynomial */
+
+
+
+
+/**
+ * Get gain, zeros and poles of a transfer function of a plan for a single parameter
+ * vector.
+ *   @param pPoleZero
+ * The result is placed into * \a pPoleZero. The arrays of zeros and poles are malloc
+ * allocated and need to be freed after use.
+ *   @param pRootsConverged
+ * If the root finding didn't converge then * \a pRootsConverged is set to false.
+ * Otherwise it is not touched.
+ *   @param polyAry
+ * A work area for the polynomials of the plan. It needs to have room for the highest
+ * number of coefficients of all expressions of the plan.
+ *   @param pPlan
+ * The plan.
+ *   @param monomialValAry
+ * The values of all monomials for the single parameter vector.
+ *   @param coefValAry
+ * The values of all coefficients for the single parameter vector.
+ *   @param idxExprNum
+ * The numerator of the transfer function as index into \a pPlan->exprAry or
+ * #NFR_NULL_EXPRESSION.
+ *   @param idxExprDen
+ * The denominator of the transfer function as index into \a pPlan->exprAry.
+ */
+
+static void getPolesAndZeros( poleZeroDesc_t * const pPoleZero
+                            , boolean * const pRootsConverged
+                            , double polyAry[]
+                            , const nfr_evaluationPlan_t * const pPlan
+                            , const double monomialValAry[]
+                            , const double coefValAry[]
+                            , unsigned int idxExprNum
+                            , unsigned int idxExprDen
+                            )
+{
+    signed int powerOfSNum, powerOfSDen;
+    double leadingCoefNum;
+
+    const unsigned int noCoefsNum = getPolynomialOfExpression( polyAry
+                                                             , &powerOfSNum
+                                                             , pPlan
+                                                             , monomialValAry
+                                                             , coefValAry
+                                                             , idxExprNum
+                                                             );
+    pPoleZero->noZeros = noCoefsNum > 0? noCoefsNum-1: 0;
+    pPoleZero->zeroAry = smalloc( (pPoleZero->noZeros > 0? pPoleZero->noZeros: 1)
+                                  * sizeof(double complex)
+                                , __FILE__
+                                , __LINE__
+                                );
+    if(noCoefsNum > 0)
+    {
+        leadingCoefNum = polyAry[noCoefsNum-1];
+        if(!findRootsOfPolynomial(pPoleZero->zeroAry, polyAry, pPoleZero->noZeros))
+            *pRootsConverged = false;
+    }
+    else
+        leadingCoefNum = 0.0;
+
+    const unsigned int noCoefsDen = getPolynomialOfExpression( polyAry
+                                                             , &powerOfSDen
+                                                             , pPlan
+                                                             , monomialValAry
+                                                             , coefValAry
+                                                             , idxExprDen
+                                                             );
+    assert(noCoefsDen > 0);
+    pPoleZero->noPoles = noCoefsDen-1;
+    pPoleZero->poleAry = smalloc( (pPoleZero->noPoles > 0? pPoleZero->noPoles: 1)
+                                  * sizeof(double complex)
+                                , __FILE__
+                                , __LINE__
+                                );
+    if(!findRootsOfPolynomial(pPoleZero->poleAry, polyAry, pPoleZero->noPoles))
+        *pRootsConverged = false;
+
+    pPoleZero->gain = leadingCoefNum/polyAry[noCoefsDen-1];
+
+    /* The common powers of s of numerator and denominator become the roots at the
+       origin. A null transfer function has neither zeros nor poles. */
+    pPoleZero->noZerosAtOrigin =
+    pPoleZero->noPolesAtOrigin = 0;
+    if(noCoefsNum == 0)
+        pPoleZero->noPoles = 0;
+    else if(powerOfSNum > powerOfSDen)
+        pPoleZero->noZerosAtOrigin = (unsigned)(powerOfSNum - powerOfSDen);
+    else
+        pPoleZero->noPolesAtOrigin = (unsigned)(powerOfSDen - powerOfSNum);
+
+} /* End of getPolesAndZeros */
+
+
+
+
+/**
+ * Compute the step response of a transfer function by partial fraction expansion. The
+ * Laplace transform of the step response is Y(s) = H(s)/s. Each pole p of multiplicity m
+ * of Y contributes the terms c_k * t^(k-1)/(k-1)! * exp(p*t), k=1..m, to y(t): c_k is the
+ * coefficient of (s-p)^(m-k) of the Taylor series of (s-p)^m*Y(s) at p. Poles, which
+ * coincide within the accuracy of the roots, are joined to a multiple pole.
+ *   @return
+ * \a true if the step response could be computed, \a false if the transfer function is
+ * not proper. The step response then contains a Dirac impulse.
+ *   @param yAry
+ * The values of the step response are placed into this array of \a noPoints elements.
+ *   @param pPoleZero
+ * The transfer function.
+ *   @param tAry
+ * The \a noPoints points in time.
+ *   @param noPoints
+ * The number of points in time.
+ */
+
+static boolean computeStepResponse( double yAry[]
+                                  , const poleZeroDesc_t * const pPoleZero
+                                  , const double tAry[]
+                                  , unsigned int noPoints
+                                  )
+{
+    unsigned int idxPoint;
+    if(pPoleZero->gain == 0.0)
+    {
+        for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+            yAry[idxPoint] = 0.0;
+        return true;
+    }
+
+    if(pPoleZero->noZeros + pPoleZero->noZerosAtOrigin
+       > pPoleZero->noPoles + pPoleZero->noPolesAtOrigin
+      )
+    {
+        return false;
+    }
+
+    /* The poles of Y are the poles of H and the origin. The roots at the origin are
+       exact; zeros and poles there cancel. */
+    const signed int noPolesAtOriginY = (signed int)pPoleZero->noPolesAtOrigin + 1
+                                        - (signed int)pPoleZero->noZerosAtOrigin;
+    const unsigned int noZerosAtOriginY = noPolesAtOriginY < 0? (unsigned)-noPolesAtOriginY: 0
+                     , noZerosY = pPoleZero->noZeros + noZerosAtOriginY
+                     , maxNoClusters = pPoleZero->noPoles + 1;
+    double complex poleOfClusterAry[maxNoClusters];
+    unsigned int multiplicityOfClusterAry[maxNoClusters]
+               , noClusters = 0
+               , idxPole
+               , idxCluster;
+    if(noPolesAtOriginY > 0)
+    {
+        poleOfClusterAry[0] = 0.0;
+        multiplicityOfClusterAry[0] = (unsigned)noPolesAtOriginY;
+        noClusters = 1;
+    }
+    for(idxPole=0; idxPole<pPoleZero->noPoles; ++idxPole)
+    {
+        const double complex p = pPoleZero->poleAry[idxPole];
+        for(idxCluster=0; idxCluster<noClusters; ++idxCluster)
+        {
+            const double complex c = poleOfClusterAry[idxCluster];
+            if(cabs(p - c) <= REL_TOL_MULTIPLE_POLE*fmax(cabs(p), cabs(c)))
+                break;
+        }
+        if(idxCluster < noClusters)
+        {
+            /* A multiple pole at the origin stays exact. Otherwise use the mean. */
+            const unsigned int m = multiplicityOfClusterAry[idxCluster];
+            if(poleOfClusterAry[idxCluster] != 0.0)
+            {
+                poleOfClusterAry[idxCluster] = ((double)m*poleOfClusterAry[idxCluster] + p)
+                                               / (double)(m+1);
+            }
+            multiplicityOfClusterAry[idxCluster] = m+1;
+        }
+        else
+        {
+            poleOfClusterAry[noClusters] = p;
+            multiplicityOfClusterAry[noClusters] = 1;
+            ++ noClusters;
+        }
+    } /* End for(All poles of H) */
+
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+        yAry[idxPoint] = 0.0;
+
+    for(idxCluster=0; idxCluster<noClusters; ++idxCluster)
+    {
+        const double complex p = poleOfClusterAry[idxCluster];
+        const unsigned int m = multiplicityOfClusterAry[idxCluster];
+
+        /* The Taylor series of (s-p)^m*Y(s) at p, truncated after u^(m-1), u=s-p: A
+           factor (s-x) = (p-x)+u is multiplied in, a factor 1/(s-x) divided out. */
+        double complex taylorAry[m];
+        unsigned int n, r;
+        taylorAry[0] = pPoleZero->gain;
+        for(n=1; n<m; ++n)
+            taylorAry[n] = 0.0;
+
+        for(r=0; r<noZerosY; ++r)
+        {
+            const double complex a = p - (r < pPoleZero->noZeros? pPoleZero->zeroAry[r]: 0.0);
+            for(n=m; n-- > 0; )
+                taylorAry[n] = a*taylorAry[n] + (n > 0? taylorAry[n-1]: 0.0);
+        }
+        unsigned int idxOther;
+        for(idxOther=0; idxOther<noClusters; ++idxOther)
+        {
+            if(idxOther == idxCluster)
+                continue;
+
+            const double complex a = p - poleOfClusterAry[idxOther];
+            for(r=0; r<multiplicityOfClusterAry[idxOther]; ++r)
+            {
+                for(n=0; n<m; ++n)
+                    taylorAry[n] = (taylorAry[n] - (n > 0? taylorAry[n-1]: 0.0)) / a;
+            }
+        }
+
+        for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+        {
+            const double t = tAry[idxPoint];
+            double complex sum = 0.0;
+            double powerOfT = 1.0;
+            unsigned int k;
+            for(k=1; k<=m; ++k)
+            {
+                sum += taylorAry[m-k] * powerOfT;
+                powerOfT *= t/(double)k;
+            }
+            yAry[idxPoint] += creal(sum * cexp(p*t));
+        }
+    } /* End for(All distinct poles of Y) */
+
+    return true;
+
+} /* End of computeStepResponse */
+
+
+
+
+/**
+ * Write gains, zeros and poles of all transfer functions into a CSV file. Each line holds
+ * a transfer function, the kind of the value (gain, zero or pole) and the value as real
+ * and imaginary part. The gain is the ratio of the coefficients of the highest powers of
+ * s of numerator and denominator.
+ *   @return
+ * \a true if the file could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param fileName
+ * The name of the file. An existing file is overwritten.
+ *   @param noDependents
+ * The number of dependents.
+ *   @param nameOfDependentAry
+ * The names of the dependents.
+ *   @param noIndependents
+ * The number of independents.
+ *   @param nameOfIndependentAry
+ * The names of the independents.
+ *   @param poleZeroAry
+ * The gains, zeros and poles of all transfer functions. Element i*noIndependents+j
+ * belongs to dependent i with respect to independent j.
+ */
+
+static boolean writePoleZeroFile( const char * const fileName
+                                , unsigned int noDependents
+                                , const char * const nameOfDependentAry[]
+                                , unsigned int noIndependents
+                                , const char * const nameOfIndependentAry[]
+                                , const poleZeroDesc_t poleZeroAry[]
+                                )
+{
+    FILE * const hFile = fopen(fileName, "w");
+    if(hFile == NULL)
+    {
+        LOG_ERROR( _log
+                 , "Pole/zero file %s can't be opened for write access (errno: %d, %s)"
+                 , fileName
+                 , errno
+                 , strerror(errno)
+                 )
+        return false;
+    }
+
+    fprintf(hFile, "transfer function,kind,re,im\n");
+    unsigned int idxDep, idxIndep;
+    for(idxDep=0; idxDep<noDependents; ++idxDep)
+    {
+        const char * const nameDep = nameOfDependentAry[idxDep];
+        for(idxIndep=0; idxIndep<noIndependents; ++idxIndep)
+        {
+            const char * const nameIndep = nameOfIndependentAry[idxIndep];
+            const poleZeroDesc_t * const pPoleZero =
+                                            &poleZeroAry[idxDep*noIndependents + idxIndep];
+            fprintf(hFile, "%s/%s,gain,%.9g,0\n", nameDep, nameIndep, pPoleZero->gain);
+
+            unsigned int u;
+            for(u=0; u<pPoleZero->noZerosAtOrigin; ++u)
+                fprintf(hFile, "%s/%s,zero,0,0\n", nameDep, nameIndep);
+            for(u=0; u<pPoleZero->noZeros; ++u)
+            {
+                /* Adding null turns a negative zero into a positive one. */
+                fprintf( hFile
+                       , "%s/%s,zero,%.9g,%.9g\n"
+                       , nameDep
+                       , nameIndep
+                       , creal(pPoleZero->zeroAry[u]) + 0.0
+                       , cimag(pPoleZero->zeroAry[u]) + 0.0
+                       );
+            }
+            for(u=0; u<pPoleZero->noPolesAtOrigin; ++u)
+                fprintf(hFile, "%s/%s,pole,0,0\n", nameDep, nameIndep);
+            for(u=0; u<pPoleZero->noPoles; ++u)
+            {
+                fprintf( hFile
+                       , "%s/%s,pole,%.9g,%.9g\n"
+                       , nameDep
+                       , nameIndep
+                       , creal(pPoleZero->poleAry[u]) + 0.0
+                       , cimag(pPoleZero->poleAry[u]) + 0.0
+                       );
+            }
+        }
+    }
+
+    boolean success = !ferror(hFile);
+    if(fclose(hFile) != 0)
+        success = false;
+    if(success)
+        LOG_INFO(_log, "Pole/zero file %s successfully written", fileName)
+    else
+    {
+        LOG_ERROR( _log
+                 , "Error while writing file %s. The file contents are possibly corrupt"
+                 , fileName
+                 )
+    }
+
+    return success;
+
+} /* End of writePoleZeroFile */
+
+
+
+
+/**
+ * Write the computed step responses into a CSV file. The first column holds the time in
+ * s, each transfer function adds a column with its step response.
+ *   @return
+ * \a true if the file could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param fileName
+ * The name of the file. An existing file is overwritten.
+ *   @param noDependents
+ * The number of dependents.
+ *   @param nameOfDependentAry
+ * The names of the dependents.
+ *   @param noIndependents
+ * The number of independents.
+ *   @param nameOfIndependentAry
+ * The names of the independents.
+ *   @param tAry
+ * The \a noPoints points in time.
+ *   @param noPoints
+ * The number of points in time.
+ *   @param yAry
+ * The step responses of all transfer functions. Row i*noIndependents+j holds the \a
+ * noPoints values of dependent i with respect to independent j.
+ */
+
+static boolean writeStepResponseFile( const char * const fileName
+                                    , unsigned int noDependents
+                                    , const char * const nameOfDependentAry[]
+                                    , unsigned int noIndependents
+                                    , const char * const nameOfIndependentAry[]
+                                    , const double tAry[]
+                                    , unsigned int noPoints
+                                    , const double * const yAry
+                                    )
+{
+    FILE * const hFile = fopen(fileName, "w");
+    if(hFile == NULL)
+    {
+        LOG_ERROR( _log
+                 , "Step response file %s can't be opened for write access (errno: %d,"
+                   " %s)"
+                 , fileName
+                 , errno
+                 , strerror(errno)
+                 )
+        return false;
+    }
+
+    const unsigned int noTransferFcts = noDependents*noIndependents;
+
+    fprintf(hFile, "t (s)");
+    unsigned int idxDep, idxIndep;
+    for(idxDep=0; idxDep<noDependents; ++idxDep)
+    {
+        for(idxIndep=0; idxIndep<noIndependents; ++idxIndep)
+        {
+            fprintf( hFile
+                   , ",step(%s/%s)"
+                   , nameOfDependentAry[idxDep]
+                   , nameOfIndependentAry[idxIndep]
+                   );
+        }
+    }
+    fprintf(hFile, "\n");
+
+    unsigned int idxPoint;
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+    {
+        fprintf(hFile, "%.9g", tAry[idxPoint]);
+        unsigned int idxTf;
+        for(idxTf=0; idxTf<noTransferFcts; ++idxTf)
+            fprintf(hFile, ",%.9g", yAry[idxTf*noPoints + idxPoint] + 0.0);
+        fprintf(hFile, "\n");
+    }
+
+    boolean success = !ferror(hFile);
+    if(fclose(hFile) != 0)
+        success = false;
+    if(success)
+        LOG_INFO(_log, "Step response file %s successfully written", fileName)
+    else
+    {
+        LOG_ERROR( _log
+                 , "Error while writing file %s. The file contents are possibly corrupt"
+                 , fileName
+                 )
+    }
+
+    return success;
+
+} /* End of writeStepResponseFile */
+
+
+
+
+/**
+ * Compute the poles, zeros and step responses of all transfer functions of a plan and
+ * write them into two CSV files. The device constants get their nominal values, see
+ * nfr_getNominalValues().\n
+ *   The points in time follow the plot information of the result like in the Octave
+ * script getSampleTimeVector: They reach from null to the period of the lowest frequency.
+ * Without plot information, #NFR_DEFAULT_NO_POINTS points reach to
+ * #STEP_RESPONSE_NO_TIME_CONSTANTS times the slowest time constant of the stable
+ * poles of the common denominator.
+ *   @return
+ * \a true if the files could be written, \a false otherwise. An error has been reported
+ * in the latter case.
+ *   @param fileNamePoleZero
+ * The name of the CSV file with the poles and zeros. An existing file is overwritten.
+ *   @param fileNameStepResponse
+ * The name of the CSV file with the step responses. An existing file is overwritten.
+ *   @param pPlan
+ * The plan.
+ *   @param nameOfResult
+ * The name of the result. Used for reporting.
+ *   @param pPlotInfo
+ * The plot information of the result, which defines the points in time, or NULL for the
+ * default.
+ *   @param nameOfDependentAry
+ * The names of the dependents of the plan.
+ *   @param nameOfIndependentAry
+ * The names of the independents of the plan.
+ */
+
+static boolean exportPoleZeroAndStepResponse( const char * const fileNamePoleZero
+                                            , const char * const fileNameStepResponse
+                                            , const nfr_evaluationPlan_t * const pPlan
+                                            , const char * const nameOfResult
+                                            , const pci_plotInfo_t * const pPlotInfo
+                                            , const char * const nameOfDependentAry[]
+                                            , const char * const nameOfIndependentAry[]
+                                            )
+{
+    double * const valueOfConstAry = smalloc( (pPlan->noConst > 0? pPlan->noConst: 1)
+                                              * sizeof(double)
+                                            , __FILE__
+                                            , __LINE__
+                                            );
+    nfr_getNominalValues(pPlan, valueOfConstAry);
+
+    unsigned int maxNoCoefsOfExpr = 1
+               , idxExpr;
+    for(idxExpr=0; idxExpr<pPlan->noExprs; ++idxExpr)
+    {
+        if(pPlan->exprAry[idxExpr].noCoefs > maxNoCoefsOfExpr)
+            maxNoCoefsOfExpr = pPlan->exprAry[idxExpr].noCoefs;
+    }
+    const size_t noWorkVals = (size_t)pPlan->noMonomials + pPlan->noCoefs + maxNoCoefsOfExpr;
+    double * const workAry = smalloc(noWorkVals*sizeof(double), __FILE__, __LINE__)
+           , * const monomialValAry = workAry
+           , * const coefValAry = monomialValAry + pPlan->noMonomials
+           , * const polyAry = coefValAry + pPlan->noCoefs;
+    evaluateMonomials(monomialValAry, pPlan, /* noParamSets */ 1, valueOfConstAry);
+    evaluateCoefs(coefValAry, pPlan, /* noParamSets */ 1, monomialValAry);
+
+    /* Check the denominator first; it is common to all transfer functions. */
+    signed int powerOfS;
+    if(getPolynomialOfExpression( polyAry
+                                , &powerOfS
+                                , pPlan
+                                , monomialValAry
+                                , coefValAry
+                                , pPlan->idxExprDenominator
+                                )
+       == 0
+      )
+    {
+        LOG_ERROR( _log
+                 , "Result %s: The denominator is null for the nominal device values. Poles"
+                   " and zeros can't be computed"
+                 , nameOfResult
+                 )
+        free(workAry);
+        free(valueOfConstAry);
+        return false;
+    }
+
+    const unsigned int noTransferFcts = pPlan->noDependents*pPlan->noIndependents;
+    poleZeroDesc_t poleZeroAry[noTransferFcts > 0? noTransferFcts: 1];
+    boolean rootsConverged = true;
+    unsigned int idxTf;
+    for(idxTf=0; idxTf<noTransferFcts; ++idxTf)
+    {
+        getPolesAndZeros( &poleZeroAry[idxTf]
+                        , &rootsConverged
+                        , polyAry
+                        , pPlan
+                        , monomialValAry
+                        , coefValAry
+                        , pPlan->idxExprNumeratorAry[idxTf]
+                        , pPlan->idxExprDenominator
+                        );
+    }
+    if(!rootsConverged)
+    {
+        LOG_WARN( _log
+                , "Result %s: The computation of the roots of numerators or denominator"
+                  " didn't converge. Poles, zeros and step responses are inaccurate"
+                , nameOfResult
+                )
+    }
+
+    boolean success = writePoleZeroFile( fileNamePoleZero
+                                       , pPlan->noDependents
+                                       , nameOfDependentAry
+                                       , pPlan->noIndependents
+                                       , nameOfIndependentAry
+                                       , poleZeroAry
+                                       );
+
+    /* The points in time. */
+    unsigned int noPoints;
+    double tEnd;
+    if(pPlotInfo != NULL  &&  pPlotInfo->freqLimitAry[0] > 0.0)
+    {
+        noPoints = pPlotInfo->noPoints;
+        tEnd = 1.0/(2.0*PI*pPlotInfo->freqLimitAry[0]);
+    }
+    else
+    {
+        /* All transfer functions have the poles of the common denominator; a null
+           transfer function has none. */
+        double minAbsRealPart = 0.0;
+        for(idxTf=0; idxTf<noTransferFcts; ++idxTf)
+        {
+            unsigned int idxPole;
+            for(idxPole=0; idxPole<poleZeroAry[idxTf].noPoles; ++idxPole)
+            {
+                const double re = creal(poleZeroAry[idxTf].poleAry[idxPole]);
+                if(re < 0.0  &&  (minAbsRealPart == 0.0  ||  -re < minAbsRealPart))
+                    minAbsRealPart = -re;
+            }
+        }
+        noPoints = NFR_DEFAULT_NO_POINTS;
+        if(minAbsRealPart > 0.0)
+            tEnd = STEP_RESPONSE_NO_TIME_CONSTANTS/minAbsRealPart;
+        else
+            tEnd = 1.0/(2.0*PI*NFR_DEFAULT_FREQ_MIN);
+    }
+    if(noPoints < 2)
+        noPoints = 2;
+
+    LOG_DEBUG( _log
+             , "Result %s: The step responses of %u transfer functions are computed for %u"
+               " points in time up to %g s"
+             , nameOfResult
+             , noTransferFcts
+             , noPoints
+             , tEnd
+             )
+
+    double * const tAry = smalloc(noPoints*sizeof(double), __FILE__, __LINE__);
+    unsigned int idxPoint;
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+        tAry[idxPoint] = tEnd*(double)idxPoint/(double)(noPoints-1);
+
+    const size_t noValues = (size_t)noTransferFcts*noPoints;
+    double * const yAry = smalloc( (noValues > 0? noValues: 1)*sizeof(double)
+                                 , __FILE__
+                                 , __LINE__
+                                 );
+    for(idxTf=0; idxTf<noTransferFcts; ++idxTf)
+    {
+        double * const yOfTfAry = yAry + (size_t)idxTf*noPoints;
+        if(!computeStepResponse(yOfTfAry, &poleZeroAry[idxTf], tAry, noPoints))
+        {
+            LOG_WARN( _log
+                    , "Result %s: The transfer function %s/%s is not proper. Its step"
+                      " response contains a Dirac impulse and is not computed"
+                    , nameOfResult
+                    , nameOfDependentAry[idxTf/pPlan->noIndependents]
+                    , nameOfIndependentAry[idxTf%pPlan->noIndependents]
+                    )
+            for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+                yOfTfAry[idxPoint] = NAN;
+        }
+    }
+
+    if(!writeStepResponseFile( fileNameStepResponse
+                             , pPlan->noDependents
+                             , nameOfDependentAry
+                             , pPlan->noIndependents
+                             , nameOfIndependentAry
+                             , tAry
+                             , noPoints
+                             , yAry
+                             )
+      )
+    {
+        success = false;
+    }
+
+    for(idxTf=0; idxTf<noTransferFcts; ++idxTf)
+    {
+        free(poleZeroAry[idxTf].zeroAry);
+        free(poleZeroAry[idxTf].poleAry);
+    }
+    free(yAry);
+    free(tAry);
+    free(workAry);
+    free(valueOfConstAry);
+
+    return success;
+
+} /* End of exportPoleZeroAndStepResponse */
+
+
+
+
+/**
+ * Initialize the module at application startup.
+ *   @param hLogger
+ * This module will use the passed logger object for all reporting during application life
+ * time. It must be a real object, LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT is not permitted.
+ *   @remark
+ * Do not forget to call the counterpart at application end.
+ *   @remark
+ * This module depends on the other module log_logger. It needs to be initialized after
+ * this other module.
+ *   @remark Using this function is not an option but a must. You need to call it
+ * prior to any other call of this module and prior to accessing any of its global data
+ * objects.
+ *   @see void nfr_shutdownModule()
+ */
+
+void nfr_initModule(log_hLogger_t hLogger)
+{
+    assert(hLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+    _log = log_cloneByReference(hLogger);
+
+#ifdef  DEBUG
+    /* The DEBUG compilation counts all created plan objects. */
+    _noRefsToObjects = 0;
+#endif
+} /* End of nfr_initModule */
+
+
+
+
+/**
+ * Do all cleanup after use of the module, which is required to avoid memory leaks,
+ * orphaned handles, etc.
+ */
+
+void nfr_shutdownModule()
+{
+#ifdef  DEBUG
+    /* The DEBUG compilation looks for still allocated objects in order to detect memory
+       leaks. */
+    if(_noRefsToObjects != 0)
+    {
+        fprintf( stderr
+               , "nfr_shutdownModule: %u objects of type nfr_evaluationPlan_t have not been"
+                 " deleted at application shutdown. There are probable memory leaks\n"
+               , _noRefsToObjects
+               );
+    }
+#endif
+
+    /* Discard reference to the logger object. */
+    log_deleteLogger(_log);
+    _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+} /* End of nfr_shutdownModule */
+
+
+
+
+/**
+ * Compile a solution in the frequency domain into an evaluation plan. All numerators and
+ * the common denominator are flattened into the arrays of monomials, coefficients and
+ * expressions of the plan. Identical entries are stored only once.
+ *   @return
+ * Get the new plan. It needs to be deleted after use with nfr_deleteEvaluationPlan().\n
+ *   The plan doesn't reference the solution, which may be deleted before the plan. It
+ * holds a reference to the table of variables of the solution.
+ *   @param pSolution
+ * The solution in the frequency domain.
+ */
+
+const nfr_evaluationPlan_t *nfr_createEvaluationPlan
+                                    (const frq_freqDomainSolution_t * const pSolution)
+{
+    nfr_evaluationPlan_t * const pPlan = smalloc( sizeof(nfr_evaluationPlan_t)
+                                                , __FILE__
+                                                , __LINE__
+                                                );
+    memset(pPlan, /* value */ 0, sizeof(nfr_evaluationPlan_t));
+    pPlan->pTableOfVars = tbv_cloneByConstReference(pSolution->pTableOfVars);
+    pPlan->noConst = pSolution->pTableOfVars->noConstants;
+    pPlan->noDependents = frq_getNoDependents(pSolution);
+    pPlan->noIndependents = frq_getNoIndependents(pSolution);
+
+    planBuilder_t builder =
+        { .pPlan = pPlan
+        , .maxNoFactors = 0
+        , .maxNoMonomials = 0
+        , .maxNoTerms = 0
+        , .maxNoCoefs = 0
+        , .maxNoIdxCoefs = 0
+        , .maxNoExprs = 0
+        };
+    createHashSet(&builder.monomialSet, isEqualMonomial);
+    createHashSet(&builder.coefSet, isEqualCoef);
+    createHashSet(&builder.exprSet, isEqualExpression);
+
+    assert(pSolution->pDenominator != NULL);
+    pPlan->idxExprDenominator = addExpression(&builder, pSolution->pDenominator);
+
+    const unsigned int noTransferFcts = pPlan->noDependents*pPlan->noIndependents;
+    pPlan->idxExprNumeratorAry = smalloc( (noTransferFcts > 0? noTransferFcts: 1)
+                                          * sizeof(unsigned int)
+                                        , __FILE__
+                                        , __LINE__
+                                        );
+    unsigned int idxDep, idxIndep;
+    for(idxDep=0; idxDep<pPlan->noDependents; ++idxDep)
+    {
+        for(idxIndep=0; idxIndep<pPlan->noIndependents; ++idxIndep)
+        {
+            pPlan->idxExprNumeratorAry[idxDep*pPlan->noIndependents + idxIndep] =
+                        addExpression(&builder, pSolution->numeratorAry[idxDep][idxIndep]);
+        }
+    }
+
+    deleteHashSet(&builder.monomialSet);
+    deleteHashSet(&builder.coefSet);
+    deleteHashSet(&builder.exprSet);
+
+    LOG_DEBUG( _log
+             , "Result %s: The evaluation plan of %u transfer functions has %u expressions,"
+               " %u coefficients with %u terms and %u monomials with %u factors"
+             , pSolution->name
+             , noTransferFcts
+             , pPlan->noExprs
+             , pPlan->noCoefs
+             , pPlan->noTerms
+             , pPlan->noMonomials
+             , pPlan->noFactors
+             )
+
+#ifdef  DEBUG
+    ++ _noRefsToObjects;
+#endif
+    return pPlan;
+
+} /* End of nfr_createEvaluationPlan */
+
+
+
+
+/**
+ * Compile a result of the numeric solver into an evaluation plan. The coefficients of the
+ * polynomials are numbers; the plan has the only monomial one and its evaluation doesn't
+ * depend on the values of the device constants.
+ *   @return
+ * Get the new plan. It needs to be deleted after use with nfr_deleteEvaluationPlan().\n
+ *   The plan doesn't reference the result, which may be deleted before the plan. It holds
+ * a reference to the table of variables of the result.
+ *   @param pResult
+ * The result of the numeric solver.
+ */
+
+const nfr_evaluationPlan_t *nfr_createEvaluationPlanOfNumericResult
+                                            (const nsl_numericResult_t * const pResult)
+{
+    nfr_evaluationPlan_t * const pPlan = smalloc( sizeof(nfr_evaluationPlan_t)
+                                                , __FILE__
+                                                , __LINE__
+                                                );
+    memset(pPlan, /* value */ 0, sizeof(nfr_evaluationPlan_t));
+    pPlan->pTableOfVars = tbv_cloneByConstReference(pResult->pTableOfVars);
+    pPlan->noConst = pResult->pTableOfVars->noConstants;
+    pPlan->noDependents = pResult->noDependents;
+    pPlan->noIndependents = pResult->noIndependents;
+
+    planBuilder_t builder =
+        { .pPlan = pPlan
+        , .maxNoFactors = 0
+        , .maxNoMonomials = 0
+        , .maxNoTerms = 0
+        , .maxNoCoefs = 0
+        , .maxNoIdxCoefs = 0
+        , .maxNoExprs = 0
+        };
+    createHashSet(&builder.monomialSet, isEqualMonomial);
+    createHashSet(&builder.coefSet, isEqualCoef);
+    createHashSet(&builder.exprSet, isEqualExpression);
+
+    /* The only monomial is the product of no factors. */
+    pPlan->monomialAry = growArray( pPlan->monomialAry
+                                  , &builder.maxNoMonomials
+                                  , 1
+                                  , sizeof(nfr_monomial_t)
+                                  );
+    pPlan->monomialAry[0].idxFirstFactor = 0;
+    pPlan->monomialAry[0].noFactors = 0;
+    pPlan->noMonomials = 1;
+    const unsigned int idxMonomialOne = 0;
+
+    pPlan->idxExprDenominator = addPolynomial(&builder, &pResult->denominator, idxMonomialOne);
+    assert(pPlan->idxExprDenominator != NFR_NULL_EXPRESSION);
+
+    const unsigned int noTransferFcts = pPlan->noDependents*pPlan->noIndependents;
+    pPlan->idxExprNumeratorAry = smalloc( (noTransferFcts > 0? noTransferFcts: 1)
+                                          * sizeof(unsigned int)
+                                        , __FILE__
+                                        , __LINE__
+                                        );
+    unsigned int idxDep, idxIndep;
+    for(idxDep=0; idxDep<pPlan->noDependents; ++idxDep)
+    {
+        for(idxIndep=0; idxIndep<pPlan->noIndependents; ++idxIndep)
+        {
+            pPlan->idxExprNumeratorAry[idxDep*pPlan->noIndependents + idxIndep] =
+                                addPolynomial( &builder
+                                             , &pResult->numeratorAry[idxDep][idxIndep]
+                                             , idxMonomialOne
+                                             );
+        }
+    }
+
+    deleteHashSet(&builder.monomialSet);
+    deleteHashSet(&builder.coefSet);
+    deleteHashSet(&builder.exprSet);
+
+    LOG_DEBUG( _log
+             , "Numeric result %s: The evaluation plan of %u transfer functions has %u"
+               " expressions and %u coefficients"
+             , pResult->name
+             , noTransferFcts
+             , pPlan->noExprs
+             , pPlan->noCoefs
+             )
+
+#ifdef  DEBUG
+    ++ _noRefsToObjects;
+#endif
+    return pPlan;
+
+} /* End of nfr_createEvaluationPlanOfNumericResult */
+
+
+
+
+/**
+ * Delete an evaluation plan after use.
+ *   @param pPlan
+ * The plan to delete. NULL is permitted and ignored.
+ */
+
+void nfr_deleteEvaluationPlan(const nfr_evaluationPlan_t * const pPlan)
+{
+    if(pPlan == NULL)
+        return;
+
+#ifdef  DEBUG
+    assert(_noRefsToObjects > 0);
+    -- _noRefsToObjects;
+#endif
+
+    tbv_deleteTableOfVariables(pPlan->pTableOfVars);
+    free(pPlan->factorAry);
+    free(pPlan->monomialAry);
+    free(pPlan->termAry);
+    free(pPlan->coefAry);
+    free(pPlan->idxCoefAry);
+    free(pPlan->exprAry);
+    free(pPlan->idxExprNumeratorAry);
+    free((nfr_evaluationPlan_t*)pPlan);
+
+} /* End of nfr_deleteEvaluationPlan */
+
+
+
+
+/**
+ * Get the nominal values of the device constants. These are the values specified in the
+ * circuit file or the same default values as used by the generated Octave scripts.
+ *   @param pPlan
+ * The plan.
+ *   @param valueOfConstAry
+ * The values are placed into this array of \a pPlan->noConst elements. It is a single
+ * parameter vector as expected by nfr_evaluatePlan().
+ */
+
+void nfr_getNominalValues( const nfr_evaluationPlan_t * const pPlan
+                         , double valueOfConstAry[]
+                         )
+{
+    const tbv_tableOfVariables_t * const pTableOfVars = pPlan->pTableOfVars;
+    unsigned int idxConst;
+    for(idxConst=0; idxConst<pPlan->noConst; ++idxConst)
+    {
+        const unsigned int idxDev = pTableOfVars->constantIdxToDevIdxAry[idxConst];
+        assert(idxDev < pTableOfVars->pCircuitNetList->noDevices);
+        const pci_device_t * const pDev = pTableOfVars->pCircuitNetList->pDeviceAry[idxDev];
+
+        /* Devices, which are related to another device, have been substituted by the
+           referenced device in the frequency domain expressions. Their power is always
+           null and the value doesn't matter. */
+        if(pDev->devRelation.idxDeviceRef == PCI_NULL_DEVICE)
+        {
+            boolean isDefaultValue;
+            valueOfConstAry[idxConst] = tbv_getValueOfDevice(pDev, &isDefaultValue);
+            if(isDefaultValue)
+            {
+                LOG_DEBUG( _log
+                         , "Device constant %s is assigned the default value %g"
+                         , pDev->name
+                         , valueOfConstAry[idxConst]
+                         )
+            }
+        }
+        else
+            valueOfConstAry[idxConst] = 1.0;
+    }
+} /* End of nfr_getNominalValues */
+
+
+
+
+/**
+ * Evaluate all transfer functions of a plan for many parameter vectors and many
+ * frequencies. The monomials and coefficients don't depend on the frequency and are
+ * computed once for all parameter vectors. All loops are innermost over the parameter
+ * vectors.
+ *   @param pPlan
+ * The plan.
+ *   @param noParamSets
+ * The number of parameter vectors.
+ *   @param valueOfConstAry
+ * The parameter vectors in structure-of-arrays form: Element i*noParamSets+k is the value
+ * of device constant i in parameter vector k. The number of constants and their order is
+ * the one of the table of variables of the plan, see \a pPlan->noConst.
+ *   @param noPoints
+ * The number of frequency points.
+ *   @param omegaAry
+ * The \a noPoints angular frequencies.
+ *   @param reAry
+ * The real parts of the results are placed into this array. Element
+ * (t*noPoints+p)*noParamSets+k is the value of transfer function t at frequency p for
+ * parameter vector k; transfer function t=i*noIndependents+j relates dependent i to
+ * independent j.
+ *   @param imAry
+ * The imaginary parts of the results, organized like \a reAry.
+ */
+
+void nfr_evaluatePlan( const nfr_evaluationPlan_t * const pPlan
+                     , unsigned int noParamSets
+                     , const double valueOfConstAry[]
+                     , unsigned int noPoints
+                     , const double omegaAry[]
+                     , double reAry[]
+                     , double imAry[]
+                     )
+{
+    const size_t noMonomialVals = (size_t)pPlan->noMonomials*noParamSets
+               , noCoefVals = (size_t)pPlan->noCoefs*noParamSets
+               , noExprVals = (size_t)pPlan->noExprs*noParamSets
+               , noWorkVals = noMonomialVals + noCoefVals + 2*noExprVals;
+    double * const workAry = smalloc( (noWorkVals > 0? noWorkVals: 1)*sizeof(double)
+                                    , __FILE__
+                                    , __LINE__
+                                    )
+           , * const monomialValAry = workAry
+           , * const coefValAry = monomialValAry + noMonomialVals
+           , * const exprReAry = coefValAry + noCoefVals
+           , * const exprImAry = exprReAry + noExprVals;
+
+    evaluateMonomials(monomialValAry, pPlan, noParamSets, valueOfConstAry);
+    evaluateCoefs(coefValAry, pPlan, noParamSets, monomialValAry);
+
+    const unsigned int noTransferFcts = pPlan->noDependents*pPlan->noIndependents;
+    const double * restrict const reD = exprReAry
+                                        + (size_t)pPlan->idxExprDenominator*noParamSets
+               , * restrict const imD = exprImAry
+                                        + (size_t)pPlan->idxExprDenominator*noParamSets;
+    unsigned int idxPoint, idxTf, idxSet;
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+    {
+        evaluateExpressions( exprReAry
+                           , exprImAry
+                           , pPlan
+                           , noParamSets
+                           , monomialValAry
+                           , coefValAry
+                           , omegaAry[idxPoint]
+                           );
+
+        for(idxTf=0; idxTf<noTransferFcts; ++idxTf)
+        {
+            const size_t offs = ((size_t)idxTf*noPoints + idxPoint)*noParamSets;
+            double * restrict const reH = reAry + offs
+                   , * restrict const imH = imAry + offs;
+            const unsigned int idxExprNum = pPlan->idxExprNumeratorAry[idxTf];
+            if(idxExprNum == NFR_NULL_EXPRESSION)
+            {
+                for(idxSet=0; idxSet<noParamSets; ++idxSet)
+                    reH[idxSet] = imH[idxSet] = 0.0;
+                continue;
+            }
+
+            /* Complex division N/D by Smith's method, which avoids overflow of the
+               intermediate results. */
+            const double * restrict const reN = exprReAry + (size_t)idxExprNum*noParamSets
+                       , * restrict const imN = exprImAry + (size_t)idxExprNum*noParamSets;
+            for(idxSet=0; idxSet<noParamSets; ++idxSet)
+            {
+                const double a = reN[idxSet]
+                           , b = imN[idxSet]
+                           , c = reD[idxSet]
+                           , d = imD[idxSet];
+                if(fabs(c) >= fabs(d))
+                {
+                    const double r = d/c
+                               , den = c + d*r;
+                    reH[idxSet] = (a + b*r)/den;
+                    imH[idxSet] = (b - a*r)/den;
+                }
+                else
+                {
+                    const double r = c/d
+                               , den = c*r + d;
+                    reH[idxSet] = (a*r + b)/den;
+                    imH[idxSet] = (b*r - a)/den;
+                }
+            }
+        }
+    }
+
+    free(workAry);
+
+} /* End of nfr_evaluatePlan */
+
+
+
+
+/**
+ * Compute the frequency responses of all dependents of a solution with respect to all of
+ * its independents and write them into a CSV file. The device constants get their nominal
+ * values, see nfr_getNominalValues(). The frequency points are taken from the plot
+ * information of the result; a logarithmic distribution from #NFR_DEFAULT_FREQ_MIN to
+ * #NFR_DEFAULT_FREQ_MAX Hz in #NFR_DEFAULT_NO_POINTS points is used if the circuit file
+ * doesn't specify the plot information.
+ *   @return
+ * \a true if the file could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param pSolution
+ * The solution in the frequency domain.
+ *   @param fileName
+ * The name of the CSV file. An existing file is overwritten.
+ */
+
+boolean nfr_exportFrequencyResponse( const frq_freqDomainSolution_t * const pSolution
+                                   , const char * const fileName
+                                   )
+{
+    assert(_log != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+
+    const tbv_tableOfVariables_t * const pTableOfVars = pSolution->pTableOfVars;
+    const pci_plotInfo_t *pPlotInfo = NULL;
+    if(pSolution->idxResult >= 0)
+    {
+        assert((unsigned)pSolution->idxResult < pTableOfVars->pCircuitNetList->noResultDefs);
+        pPlotInfo = pTableOfVars->pCircuitNetList->resultDefAry[pSolution->idxResult]
+                                                  .pPlotInfo;
+    }
+
+    const unsigned int noDependents = frq_getNoDependents(pSolution)
+                     , noIndependents = frq_getNoIndependents(pSolution);
+    const char *nameOfDependentAry[noDependents > 0? noDependents: 1]
+             , *nameOfIndependentAry[noIndependents > 0? noIndependents: 1];
+    unsigned int idx;
+    for(idx=0; idx<noDependents; ++idx)
+        nameOfDependentAry[idx] = frq_getNameOfDependent(pSolution, idx);
+    for(idx=0; idx<noIndependents; ++idx)
+        nameOfIndependentAry[idx] = frq_getNameOfIndependent(pSolution, idx);
+
+    const nfr_evaluationPlan_t * const pPlan = nfr_createEvaluationPlan(pSolution);
+    const boolean success = exportFrequencyResponse( fileName
+                                                   , pPlan
+                                                   , pSolution->name
+                                                   , pPlotInfo
+                                                   , nameOfDependentAry
+                                                   , nameOfIndependentAry
+                                                   );
+    nfr_deleteEvaluationPlan(pPlan);
+
+    return success;
+
+} /* End of nfr_exportFrequencyResponse */
+
+
+
+
+/**
+ * Compute the frequency responses of all dependents of a result of the numeric solver
+ * with respect to all of its independents and write them into a CSV file. The frequency
+ * points are chosen as for nfr_exportFrequencyResponse().
+ *   @return
+ * \a true if the file could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param pResult
+ * The numeric result.
+ *   @param fileName
+ * The name of the CSV file. An existing file is overwritten.
+ */
+
+boolean nfr_exportFrequencyResponseOfNumericResult( const nsl_numericResult_t * const pResult
+                                                  , const char * const fileName
+                                                  )
+{
+    assert(_log != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+
+    const tbv_tableOfVariables_t * const pTableOfVars = pResult->pTableOfVars;
+    const pci_plotInfo_t *pPlotInfo = NULL;
+    if(pResult->idxResult >= 0)
+    {
+        assert((unsigned)pResult->idxResult < pTableOfVars->pCircuitNetList->noResultDefs);
+        pPlotInfo = pTableOfVars->pCircuitNetList->resultDefAry[pResult->idxResult]
+                                                  .pPlotInfo;
+    }
+
+    const nfr_evaluationPlan_t * const pPlan =
+                                        nfr_createEvaluationPlanOfNumericResult(pResult);
+    const boolean success = exportFrequencyResponse( fileName
+                                                   , pPlan
+                                                   , pResult->name
+                                                   , pPlotInfo
+                                                   , pResult->nameOfDependentAry
+                                                   , pResult->nameOfIndependentAry
+                                                   );
+    nfr_deleteEvaluationPlan(pPlan);
+
+    return success;
+
+} /* End of nfr_exportFrequencyResponseOfNumericResult */
+
+
+
+
+/**
+ * Compute gain, zeros and poles of all transfer functions of a solution and their step
+ * responses. The results are written into two CSV files. The device constants get their
+ * nominal values, see nfr_getNominalValues(). The points in time of the step responses
+ * are derived from the plot information of the result, like the generated Octave code
+ * does.
+ *   @return
+ * \a true if the files could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param pSolution
+ * The solution in the frequency domain.
+ *   @param fileNamePoleZero
+ * The name of the CSV file with the poles and zeros. An existing file is overwritten.
+ *   @param fileNameStepResponse
+ * The name of the CSV file with the step responses. An existing file is overwritten.
+ */
+
+boolean nfr_exportPoleZeroAndStepResponse( const frq_freqDomainSolution_t * const pSolution
+                                         , const char * const fileNamePoleZero
+                                         , const char * const fileNameStepResponse
+                                         )
+{
+    assert(_log != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+
+    const tbv_tableOfVariables_t * const pTableOfVars = pSolution->pTableOfVars;
+    const pci_plotInfo_t *pPlotInfo = NULL;
+    if(pSolution->idxResult >= 0)
+    {
+        assert((unsigned)pSolution->idxResult < pTableOfVars->pCircuitNetList->noResultDefs);
+        pPlotInfo = pTableOfVars->pCircuitNetList->resultDefAry[pSolution->idxResult]
+                                                  .pPlotInfo;
+    }
+
+    const unsigned int noDependents = frq_getNoDependents(pSolution)
+                     , noIndependents = frq_getNoIndependents(pSolution);
+    const char *nameOfDependentAry[noDependents > 0? noDependents: 1]
+             , *nameOfIndependentAry[noIndependents > 0? noIndependents: 1];
+    unsigned int idx;
+    for(idx=0; idx<noDependents; ++idx)
+        nameOfDependentAry[idx] = frq_getNameOfDependent(pSolution, idx);
+    for(idx=0; idx<noIndependents; ++idx)
+        nameOfIndependentAry[idx] = frq_getNameOfIndependent(pSolution, idx);
+
+    const nfr_evaluationPlan_t * const pPlan = nfr_createEvaluationPlan(pSolution);
+    const boolean success = exportPoleZeroAndStepResponse( fileNamePoleZero
+                                                         , fileNameStepResponse
+                                                         , pPlan
+                                                         , pSolution->name
+                                                         , pPlotInfo
+                                                         , nameOfDependentAry
+                                                         , nameOfIndependentAry
+                                                         );
+    nfr_deleteEvaluationPlan(pPlan);
+
+    return success;
+
+} /* End of nfr_exportPoleZeroAndStepResponse */
+
+
+
+
+/**
+ * Compute gain, zeros and poles of all transfer functions of a result of the numeric
+ * solver and their step responses like nfr_exportPoleZeroAndStepResponse() does.
+ *   @return
+ * \a true if the files could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param pResult
+ * The numeric result.
+ *   @param fileNamePoleZero
+ * The name of the CSV file with the poles and zeros. An existing file is overwritten.
+ *   @param fileNameStepResponse
+ * The name of the CSV file with the step responses. An existing file is overwritten.
+ */
+
+boolean nfr_exportPoleZeroAndStepResponseOfNumericResult
+                                            ( const nsl_numericResult_t * const pResult
+                                            , const char * const fileNamePoleZero
+                                            , const char * const fileNameStepResponse
+                                            )
+{
+    assert(_log != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+
+    const tbv_tableOfVariables_t * const pTableOfVars = pResult->pTableOfVars;
+    const pci_plotInfo_t *pPlotInfo = NULL;
+    if(pResult->idxResult >= 0)
+    {
+        assert((unsigned)pResult->idxResult < pTableOfVars->pCircuitNetList->noResultDefs);
+        pPlotInfo = pTableOfVars->pCircuitNetList->resultDefAry[pResult->idxResult]
+                                                  .pPlotInfo;
+    }
+
+    const nfr_evaluationPlan_t * const pPlan =
+                                        nfr_createEvaluationPlanOfNumericResult(pResult);
+    const boolean success = exportPoleZeroAndStepResponse( fileNamePoleZero
+                                                         , fileNameStepResponse
+                                                         , pPlan
+                                                         , pResult->name
+                                                         , pPlotInfo
+                                                         , pResult->nameOfDependentAry
+                                                         , pResult->nameOfIndependentAry
+                                                         );
+    nfr_deleteEvaluationPlan(pPlan);
+
+    return success;
+
+} /* End of nfr_exportPoleZeroAndStepResponseOfNumericResult */
@@ -0,0 +1,266 @@
+#ifndef NFR_NUMERICFREQRESPONSE_INCLUDED
+#define NFR_NUMERICFREQRESPONSE_INCLUDED
+/**
+ * @file nfr_numericFreqResponse.h
+ * Definition of global interface of module nfr_numericFreqResponse.c
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <limits.h>
+
+#include "types.h"
+#include "log_logger.h"
+#include "tbv_tableOfVariables.h"
+#include "frq_freqDomainSolution.h"
+#include "nsl_numericSolver.h"
+
+
+/*
+ * Defines
+ */
+
+/** The lower end of the frequency range in Hz, which is used if the circuit file doesn't
+    specify a plot information for a result. */
+#define NFR_DEFAULT_FREQ_MIN    1.0
+
+/** The upper end of the frequency range in Hz, which is used if the circuit file doesn't
+    specify a plot information for a result. */
+#define NFR_DEFAULT_FREQ_MAX    1e6
+
+/** The number of frequency points, which is used if the circuit file doesn't specify a
+    plot information for a result. The default gives 50 points per decade. */
+#define NFR_DEFAULT_NO_POINTS   301
+
+/** The index of an expression of an evaluation plan, which designates the null
+    expression. */
+#define NFR_NULL_EXPRESSION     UINT_MAX
+
+
+/*
+ * Global type definitions
+ */
+
+/** A factor of a monomial of an evaluation plan: a device constant to a power. */
+typedef struct nfr_factorOfMonomial_t
+{
+    /** The index of the device constant in the table of variables. */
+    unsigned int idxConst;
+
+    /** The power of the constant, not null. */
+    signed int power;
+
+} nfr_factorOfMonomial_t;
+
+
+/** A monomial of an evaluation plan: a product of powers of device constants. */
+typedef struct nfr_monomial_t
+{
+    /** The factors of the monomial are found in the array of factors of the plan, beginning
+        at this index. */
+    unsigned int idxFirstFactor;
+
+    /** The number of factors of the monomial. Null for the monomial 1. */
+    unsigned int noFactors;
+
+} nfr_monomial_t;
+
+
+/** An addend of a coefficient of an evaluation plan: a numeric factor times a monomial. */
+typedef struct nfr_termOfCoef_t
+{
+    /** The numeric factor. */
+    double factor;
+
+    /** The index of the monomial in the array of monomials of the plan. */
+    unsigned int idxMonomial;
+
+} nfr_termOfCoef_t;
+
+
+/** A coefficient of an evaluation plan: the sum of some terms. It is the coefficient of a
+    power of s of one or more of the expressions of the plan. */
+typedef struct nfr_coef_t
+{
+    /** The terms of the coefficient are found in the array of terms of the plan, beginning
+        at this index. */
+    unsigned int idxFirstTerm;
+
+    /** The number of terms. Null for the coefficient null. */
+    unsigned int noTerms;
+
+} nfr_coef_t;
+
+
+/** An expression of an evaluation plan: a polynomial in s times a common factor. The
+    factor is a numeric factor times a monomial times a power of s. */
+typedef struct nfr_expression_t
+{
+    /** The numeric part of the common factor. */
+    double factor;
+
+    /** The index of the monomial of the common factor. */
+    unsigned int idxMonomial;
+
+    /** The power of s of the common factor. */
+    signed int powerOfS;
+
+    /** The coefficients of the polynomial are listed in the array of coefficient indexes
+        of the plan, beginning at this index. The first one belongs to s^0. */
+    unsigned int idxFirstCoef;
+
+    /** The number of coefficients, which is the degree of the polynomial plus one. */
+    unsigned int noCoefs;
+
+} nfr_expression_t;
+
+
+/** An evaluation plan is a solution in the frequency domain compiled into flat arrays for
+    fast repeated numeric evaluation. Identical monomials, coefficients and expressions are
+    shared: Each of them is computed only once per evaluation. */
+typedef struct nfr_evaluationPlan_t
+{
+    /** The table of variables of the compiled solution. It describes the constants, which
+        the parameter vectors of the evaluation hold the values of. */
+    const tbv_tableOfVariables_t *pTableOfVars;
+
+    /** The number of device constants, which is the length of a parameter vector. */
+    unsigned int noConst;
+
+    /** The factors of all monomials. */
+    nfr_factorOfMonomial_t *factorAry;
+
+    /** The number of elements of \a factorAry. */
+    unsigned int noFactors;
+
+    /** The distinct monomials. */
+    nfr_monomial_t *monomialAry;
+
+    /** The number of elements of \a monomialAry. */
+    unsigned int noMonomials;
+
+    /** The terms of all coefficients. */
+    nfr_termOfCoef_t *termAry;
+
+    /** The number of elements of \a termAry. */
+    unsigned int noTerms;
+
+    /** The distinct coefficients. */
+    nfr_coef_t *coefAry;
+
+    /** The number of elements of \a coefAry. */
+    unsigned int noCoefs;
+
+    /** The coefficients of all expressions as indexes into \a coefAry. */
+    unsigned int *idxCoefAry;
+
+    /** The number of elements of \a idxCoefAry. */
+    unsigned int noIdxCoefs;
+
+    /** The distinct expressions. */
+    nfr_expression_t *exprAry;
+
+    /** The number of elements of \a exprAry. */
+    unsigned int noExprs;
+
+    /** The number of dependents of the compiled solution. */
+    unsigned int noDependents;
+
+    /** The number of independents of the compiled solution. */
+    unsigned int noIndependents;
+
+    /** The index of the expression of the common denominator into \a exprAry. */
+    unsigned int idxExprDenominator;
+
+    /** The numerators of all transfer functions as indexes into \a exprAry or
+        #NFR_NULL_EXPRESSION. Element i*noIndependents+j belongs to dependent i and
+        independent j. */
+    unsigned int *idxExprNumeratorAry;
+
+} nfr_evaluationPlan_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize the module prior to first use of any of its methods or global data objects. */
+void nfr_initModule(log_hLogger_t hGlobalLogger);
+
+/** Shutdown of module after use. Release of memory, closing files, etc. */
+void nfr_shutdownModule(void);
+
+/** Compile a solution in the frequency domain into an evaluation plan. */
+const nfr_evaluationPlan_t *nfr_createEvaluationPlan
+                                    (const frq_freqDomainSolution_t * const pSolution);
+
+/** Compile a result of the numeric solver into an evaluation plan. */
+const nfr_evaluationPlan_t *nfr_createEvaluationPlanOfNumericResult
+                                            (const nsl_numericResult_t * const pResult);
+
+/** Delete an evaluation plan after use. */
+void nfr_deleteEvaluationPlan(const nfr_evaluationPlan_t * const pPlan);
+
+/** Get the nominal values of the device constants as parameter vector of a plan. */
+void nfr_getNominalValues( const nfr_evaluationPlan_t * const pPlan
+                         , double valueOfConstAry[]
+                         );
+
+/** Evaluate all transfer functions of a plan for many parameter vectors and frequencies. */
+void nfr_evaluatePlan( const nfr_evaluationPlan_t * const pPlan
+                     , unsigned int noParamSets
+                     , const double valueOfConstAry[]
+                     , unsigned int noPoints
+                     , const double omegaAry[]
+                     , double reAry[]
+                     , double imAry[]
+                     );
+
+/** Compute the frequency responses of a solution and write them into a CSV file. */
+boolean nfr_exportFrequencyResponse( const frq_freqDomainSolution_t * const pSolution
+                                   , const char * const fileName
+                                   );
+
+/** Compute the frequency responses of a numeric result and write them into a CSV file. */
+boolean nfr_exportFrequencyResponseOfNumericResult
+                                            ( const nsl_numericResult_t * const pResult
+                                            , const char * const fileName
+                                            );
+
+/** Compute poles, zeros and step responses of a solution and write them into CSV files. */
+boolean nfr_exportPoleZeroAndStepResponse( const frq_freqDomainSolution_t * const pSolution
+                                         , const char * const fileNamePoleZero
+                                         , const char * const fileNameStepResponse
+                                         );
+
+/** Compute poles, zeros and step responses of a numeric result and write them into CSV
+    files. */
+boolean nfr_exportPoleZeroAndStepResponseOfNumericResult
+                                            ( const nsl_numericResult_t * const pResult
+                                            , const char * const fileNamePoleZero
+                                            , const char * const fileNameStepResponse
+                                            );
+
+#endif  /* NFR_NUMERICFREQRESPONSE_INCLUDED */
@@ -0,0 +1,2338 @@
+/**
+ * @file nsl_numericSolver.c
+ *   A numeric solver of the LES. It computes the transfer functions of a circuit as
+ * polynomials in s with numeric coefficients for the nominal values of the devices.\n
+ * Design considerations:\n
+ *   The symbolic solver sol_solver.c expands the system determinant and the numerators of
+ * Cramer's rule into sums of products of device constants. For larger circuits the number
+ * of addends explodes, although the final transfer function - a ratio of two polynomials
+ * in s - has a number of coefficients, which is bounded by the number of reactive devices.
+ * If only the numeric value of these coefficients is of interest, then they can be
+ * figured out at polynomial cost by evaluation and interpolation:\n
+ *   The device values are substituted into the coefficients of the LES. Each coefficient
+ * becomes a short polynomial in s. The range of powers of s of the determinant and all
+ * numerators is bounded by the sum of the highest and lowest powers of the columns of the
+ * matrix. N points s(k) on a circle with radius r in the complex plane are chosen, where
+ * N is the next power of two, which is not less than the number of possible powers. The
+ * numeric LES is solved by LU decomposition with partial pivoting at each of the points;
+ * this yields the determinant and, by back substitution, the solutions of all unknowns
+ * for all knowns. The points are independent of one another and are distributed among
+ * the threads of a pool.\n
+ *   The values of all polynomials at the points are known now: The determinant D(s(k))
+ * and the numerators N(s(k)) = D(s(k))*x(s(k)). Since the points are the scaled N-th roots
+ * of unity, a single FFT per polynomial yields its coefficients. The radius r is chosen
+ * from the magnitudes of the devices such that the terms of the polynomials have a
+ * similar magnitude at the points; this is essential for the conditioning of the
+ * interpolation, think of nF and kOhm in the same circuit. The points are rotated by half
+ * a step off the real and imaginary axis, where some circuits have poles.\n
+ *   A single circle resolves only those coefficients, whose terms are not too small in
+ * comparison to the dominant term at the radius r. The terms of higher order circuits,
+ * like long ladder networks, span more orders of magnitude than the accuracy of the
+ * floating point numbers. Further circles with smaller and larger radii are evaluated as
+ * long as they resolve more of the lowest and highest powers of the determinant; then
+ * circles are placed at the radii, where the least accurate coefficients of the
+ * determinant become dominant. Each coefficient is taken from the circle, where its
+ * rounding error is the smallest.\n
+ *   The result is normalized such that the lowest power of the determinant has the
+ * coefficient one. The results have the same structure as the frequency domain results of
+ * frq_freqDomainSolution.c; they can be printed and their frequency response can be
+ * computed by module nfr_numericFreqResponse.c. Other than the symbolic solution, the
+ * numeric solution is subject to rounding errors; coefficients, whose magnitude is below
+ * the rounding error of the evaluation, are considered null.
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   nsl_initModule
+ *   nsl_shutdownModule
+ *   nsl_createSolution
+ *   nsl_deleteSolution
+ *   nsl_createResult
+ *   nsl_deleteResult
+ *   nsl_logResult
+ * Local functions
+ *   getAdmittanceOfConstants
+ *   compileLES
+ *   getRangeOfPowersOfS
+ *   getRadius
+ *   renormalize
+ *   taskEvaluatePoint
+ *   fft
+ *   interpolate
+ *   evaluateCircle
+ *   addCoefficients
+ *   addCircle
+ *   getResolvedCoefs
+ *   getLogOfErrorBound
+ *   getRadiusForAccuracy
+ *   createPolynomial
+ *   copyPolynomial
+ *   freePolynomial
+ *   createMatrixOfPolynomials
+ *   deleteMatrixOfPolynomials
+ *   findName
+ *   logPolynomial
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <complex.h>
+#include <assert.h>
+
+#include "smalloc.h"
+#include "snprintf.h"
+#include "log_logger.h"
+#include "thp_threadPool.h"
+#include "rat_rationalNumber.h"
+#include "coe_coefficient.h"
+#include "coe_coefficient.inlineInterface.h"
+#include "pci_parserCircuit.h"
+#include "tbv_tableOfVariables.h"
+#include "les_linearEquationSystem.h"
+#include "nsl_numericSolver.h"
+
+
+/*
+ * Defines
+ */
+
+/** The mathematical constant pi. */
+#define PI  3.14159265358979323846
+
+/** A coefficient of a polynomial is considered null if its magnitude is less than this
+    fraction of its error bound, which is the largest magnitude of the values, which it has
+    been interpolated from. The bound is some orders of magnitude above the rounding
+    errors of the LU decomposition and the FFT. */
+#define ZERO_THRESHOLD  1e-11
+
+/** The ratio of the radii of neighbouring circles of evaluation points, when searching
+    for the lowest and highest powers of s. */
+#define RADIUS_STEP  100.0
+
+/** A further circle of evaluation points is placed if the error bound of a coefficient
+    of the determinant exceeds its magnitude by more than this factor, which roughly means
+    a relative accuracy of less than ten digits. */
+#define ACCURACY_TARGET  1e6
+
+/** A further circle of evaluation points is placed only if it promises to reduce the
+    error bound of a coefficient by at least this factor. */
+#define ACCURACY_GAIN  10.0
+
+/** The maximum number of circles of evaluation points. */
+#define MAX_NO_CIRCLES  32
+
+/** The interpolated coefficients are real by principle. A warning is emitted if their
+    imaginary part exceeds this fraction of the largest magnitude of the interpolated
+    values; the solution is then ill-conditioned. */
+#define IMAGINARY_PART_THRESHOLD  1e-6
+
+
+/*
+ * Local type definitions
+ */
+
+/** The admittance of a device constant after substitution of the value of the device: A
+    numeric value times a power of s. */
+typedef struct admittanceOfConst_t
+{
+    /** The numeric value. */
+    double value;
+
+    /** The power of s, either -1, 0 or 1. */
+    signed int powerOfS;
+
+} admittanceOfConst_t;
+
+
+/** A term of a coefficient of the numeric LES: A numeric weight times a power of s. */
+typedef struct termOfCoef_t
+{
+    /** The numeric weight. */
+    double weight;
+
+    /** The power of s. */
+    signed int powerOfS;
+
+} termOfCoef_t;
+
+
+/** A coefficient of the numeric LES: A short polynomial in s, which is represented by a
+    contiguous range of terms in a common array of terms. */
+typedef struct numericCoef_t
+{
+    /** The index of the first term. */
+    unsigned int idxFirstTerm;
+
+    /** The number of terms. Null for the null coefficient. */
+    unsigned int noTerms;
+
+} numericCoef_t;
+
+
+/** The data of the evaluation of the LES at all points. It is shared by all tasks. */
+typedef struct evaluation_t
+{
+    /** The number of rows and unknowns, \a m, and the number of columns, \a n, of the LES.
+        The columns m..n-1 belong to the knowns. */
+    unsigned int m, n;
+
+    /** The matrix [m, n] of numeric coefficients in row major order. */
+    const numericCoef_t *coefAry;
+
+    /** The terms of all coefficients. */
+    const termOfCoef_t *termAry;
+
+    /** The range of powers of s, which appear in the terms. */
+    signed int minPowerOfTerms, maxPowerOfTerms;
+
+    /** The number of evaluation points, a power of two. */
+    unsigned int noPoints;
+
+    /** The radius of the circle of evaluation points. */
+    double radius;
+
+    /** The workspace of each thread, a matrix [m, n] in row major order. */
+    double complex * *workspaceAry;
+
+    /** For each point: The mantissa and the binary exponent of the system determinant. A
+        mantissa of null indicates a singular matrix at this point. */
+    double complex *detMantissaAry;
+    signed int *detExponentAry;
+
+    /** For each point: The matrix [m, n-m] of solutions of all unknowns for all knowns.
+        Element [idxCol, idxKnown] is found at index idxCol*(n-m)+idxKnown. */
+    double complex *solutionAry;
+
+} evaluation_t;
+
+
+/** The coefficients of all polynomials of the solution as far as they have been
+    interpolated from the circles evaluated so far. For each coefficient, the estimate of
+    the circle with the smallest error bound is kept. */
+typedef struct interpolation_t
+{
+    /** The number of polynomials: The determinant and the numerators of all dependents
+        for all knowns. */
+    unsigned int noPolys;
+
+    /** The number of coefficients of each polynomial, the number of possible powers of s. */
+    unsigned int noCoefs;
+
+    /** The power of s of the first coefficient. */
+    signed int minPowerOfS;
+
+    /** The matrix [noPolys, noCoefs] of the estimated coefficients in row major order.
+        They are scaled with the common factor 2^-exponentOfScale. */
+    double *coefAry;
+
+    /** The matrix [noPolys, noCoefs] of the error bounds of the estimates in the same
+        scaling. An estimate is considered null if it is not significantly larger. */
+    double *errorAry;
+
+    /** The matrix [noPolys, noCoefs] of the imaginary parts of the estimates relative to
+        their error bound. */
+    double *imagPartAry;
+
+    /** The scaling is defined by the first circle. */
+    boolean isScaleDefined;
+
+    /** The binary exponent of the scaling, see  coefAry. */
+    signed int exponentOfScale;
+
+} interpolation_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** A global logger object is referenced from anywhere for writing progress messages. */
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+/** The number of threads the evaluation of the points is distributed to. */
+static THREAD_LOCAL unsigned int _noThreads = 0;
+
+/** The pool of worker threads. It is created on first use, as most applications of the
+    module don't use the numeric solver. */
+static THREAD_LOCAL thp_hThreadPool_t _hThreadPool = THP_HANDLE_INVALID_THREAD_POOL;
+
+#ifdef DEBUG
+/** A global counter of all references to any created objects. Used to detect memory leaks. */
+static THREAD_LOCAL unsigned int _noRefsToObjects = 0;
+#endif
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Substitute the nominal values of the devices into the constants of the LES. A constant
+ * of the LES represents the admittance of a device; it is a numeric value times a power
+ * of s.
+ *   @return
+ * \a true if the substitution succeeded, \a false if the relation of a device to another
+ * one could not be resolved. An error has been reported in this case.
+ *   @param admittanceAry
+ * The admittance of each constant is returned in this array, which has one element per
+ * constant of the table of variables.
+ *   @param pTableOfVars
+ * The table of variables, which the constants are defined in.
+ */
+
+static boolean getAdmittanceOfConstants( admittanceOfConst_t admittanceAry[]
+                                       , const tbv_tableOfVariables_t * const pTableOfVars
+                                       )
+{
+    unsigned int idxBit;
+    for(idxBit=0; idxBit<pTableOfVars->noConstants; ++idxBit)
+    {
+        rat_num_t refFactor;
+        unsigned int idxBitRefDev;
+        const pci_device_t *pDevice;
+        if(!tbv_getReferencedDeviceByBitIndex( pTableOfVars
+                                             , &refFactor
+                                             , &pDevice
+                                             , &idxBitRefDev
+                                             , idxBit
+                                             )
+          )
+        {
+            return false;
+        }
+
+        boolean isDefaultValue;
+        const double value = (double)refFactor.n / (double)refFactor.d
+                             * tbv_getValueOfDevice(pDevice, &isDefaultValue);
+        admittanceOfConst_t * const pAdmittance = &admittanceAry[idxBit];
+        switch(pDevice->type)
+        {
+            case pci_devType_resistor:
+                pAdmittance->value = 1.0/value;
+                pAdmittance->powerOfS = 0;
+                break;
+
+            case pci_devType_capacitor:
+                pAdmittance->value = value;
+                pAdmittance->powerOfS = 1;
+                break;
+
+            case pci_devType_inductivity:
+                pAdmittance->value = 1.0/value;
+                pAdmittance->powerOfS = -1;
+                break;
+
+            case pci_devType_conductance:
+            case pci_devType_srcUByU:
+            case pci_devType_srcUByI:
+            case pci_devType_srcIByU:
+            case pci_devType_srcIByI:
+                pAdmittance->value = value;
+                pAdmittance->powerOfS = 0;
+                break;
+
+            case pci_devType_srcI:
+            case pci_devType_srcU:
+            case pci_devType_opAmp:
+            default: assert(false);
+
+        } /* End switch(Which kind of device?) */
+
+    } /* End for(All constants of the LES) */
+
+    return true;
+
+} /* End of getAdmittanceOfConstants */
+
+
+
+
+/**
+ * Substitute the admittances of the constants into all coefficients of the LES. The
+ * addends of a coefficient, which have the same power of s, are merged into a single term.
+ *   @param pEval
+ * The matrix of numeric coefficients and their terms are stored in * \a pEval. Both are
+ * malloc allocated and need to be freed after use. Moreover, the range of powers of s of
+ * the terms is set.
+ *   @param A
+ * The matrix of symbolic coefficients of the LES.
+ *   @param admittanceAry
+ * The admittance of each constant, see getAdmittanceOfConstants.
+ */
+
+static void compileLES( evaluation_t * const pEval
+                      , const coe_coefMatrix_t A
+                      , const admittanceOfConst_t admittanceAry[]
+                      )
+{
+    const unsigned int m = pEval->m
+                     , n = pEval->n
+                     , noWords = coe_getNoWordsOfProduct();
+    numericCoef_t * const coefAry = smalloc(m*n*sizeof(numericCoef_t), __FILE__, __LINE__);
+    unsigned int maxNoTerms = m*n + 1
+               , noTerms = 0;
+    termOfCoef_t *termAry = smalloc(maxNoTerms*sizeof(termOfCoef_t), __FILE__, __LINE__);
+    pEval->minPowerOfTerms = 0;
+    pEval->maxPowerOfTerms = 0;
+
+    unsigned int row, col;
+    for(row=0; row<m; ++row)
+    {
+        for(col=0; col<n; ++col)
+        {
+            numericCoef_t * const pCoef = &coefAry[row*n + col];
+            pCoef->idxFirstTerm = noTerms;
+            pCoef->noTerms = 0;
+
+            const coe_coefAddend_t *pAddend;
+            for(pAddend=A[row][col]; pAddend!=NULL; pAddend=pAddend->pNext)
+            {
+                double weight = (double)pAddend->factor;
+                signed int powerOfS = 0;
+                unsigned int idxBit = coe_findConstInProductOfConst( pAddend->productOfConst
+                                                                   , 0
+                                                                   , noWords
+                                                                   );
+                while(idxBit != UINT_MAX)
+                {
+                    weight *= admittanceAry[idxBit].value;
+                    powerOfS += admittanceAry[idxBit].powerOfS;
+                    idxBit = coe_findConstInProductOfConst( pAddend->productOfConst
+                                                          , idxBit+1
+                                                          , noWords
+                                                          );
+                }
+
+                /* Addends of same power of s are merged. The coefficients of the LES have
+                   only a few addends and a linear search is appropriate. */
+                unsigned int idxTerm;
+                for(idxTerm=pCoef->idxFirstTerm; idxTerm<noTerms; ++idxTerm)
+                    if(termAry[idxTerm].powerOfS == powerOfS)
+                        break;
+                if(idxTerm < noTerms)
+                    termAry[idxTerm].weight += weight;
+                else
+                {
+                    if(noTerms >= maxNoTerms)
+                    {
+                        maxNoTerms *= 2;
+                        termAry = srealloc( termAry
+                                          , maxNoTerms*sizeof(termOfCoef_t)
+                                          , __FILE__
+                                          , __LINE__
+                                          );
+                    }
+                    termAry[noTerms].weight = weight;
+                    termAry[noTerms].powerOfS = powerOfS;
+                    ++ noTerms;
+                    ++ pCoef->noTerms;
+
+                    if(powerOfS < pEval->minPowerOfTerms)
+                        pEval->minPowerOfTerms = powerOfS;
+                    if(powerOfS > pEval->maxPowerOfTerms)
+                        pEval->maxPowerOfTerms = powerOfS;
+                }
+            } /* End for(All addends of the coefficient) */
+        } /* End for(All columns) */
+    } /* End for(All rows) */
+
+    pEval->coefAry = coefAry;
+    pEval->termAry = termAry;
+
+} /* End of compileLES */
+
+
+
+
+/**
+ * Determine the range of powers of s, which the system determinant and the numerators of
+ * all unknowns can have. The determinant is a sum of products, which take one coefficient
+ * from each column of the unknowns. A numerator replaces one of these columns by the
+ * column of a known. The range is bounded by the sums of the extreme powers of the
+ * columns and by the numbers of capacitors and inductivities of the circuit.
+ *   @return
+ * \a true if the range could be determined, \a false if the matrix has a column of null
+ * coefficients. The system determinant is null in this case; an error has been reported.
+ *   @param pMinPowerOfS
+ * The lowest possible power of s is returned in * \a pMinPowerOfS.
+ *   @param pMaxPowerOfS
+ * The highest possible power of s is returned in * \a pMaxPowerOfS.
+ *   @param pEval
+ * The compiled numeric LES.
+ *   @param admittanceAry
+ * The admittance of each constant, see getAdmittanceOfConstants.
+ *   @param pLES
+ * The LES. Only used for error reporting.
+ *   @param noConstants
+ * The number of constants.
+ */
+
+static boolean getRangeOfPowersOfS( signed int * const pMinPowerOfS
+                                  , signed int * const pMaxPowerOfS
+                                  , const evaluation_t * const pEval
+                                  , const admittanceOfConst_t admittanceAry[]
+                                  , const les_linearEquationSystem_t * const pLES
+                                  , unsigned int noConstants
+                                  )
+{
+    const unsigned int m = pEval->m
+                     , n = pEval->n;
+    signed int minPowerOfColAry[n], maxPowerOfColAry[n];
+    boolean isColNullAry[n];
+    unsigned int col;
+    for(col=0; col<n; ++col)
+    {
+        minPowerOfColAry[col] = INT_MAX;
+        maxPowerOfColAry[col] = INT_MIN;
+        isColNullAry[col] = true;
+
+        unsigned int row;
+        for(row=0; row<m; ++row)
+        {
+            const numericCoef_t * const pCoef = &pEval->coefAry[row*n + col];
+            unsigned int idxTerm;
+            for(idxTerm=0; idxTerm<pCoef->noTerms; ++idxTerm)
+            {
+                const signed int powerOfS =
+                                    pEval->termAry[pCoef->idxFirstTerm + idxTerm].powerOfS;
+                if(powerOfS < minPowerOfColAry[col])
+                    minPowerOfColAry[col] = powerOfS;
+                if(powerOfS > maxPowerOfColAry[col])
+                    maxPowerOfColAry[col] = powerOfS;
+                isColNullAry[col] = false;
+            }
+        }
+    } /* End for(All columns) */
+
+    signed int sumOfMin = 0
+             , sumOfMax = 0;
+    for(col=0; col<m; ++col)
+    {
+        if(isColNullAry[col])
+        {
+            const tbv_unknownVariable_t * const unknownAry = les_getTableOfUnknowns(pLES, NULL);
+            unsigned int idxUnknown;
+            for(idxUnknown=0; idxUnknown<m; ++idxUnknown)
+                if(unknownAry[idxUnknown].idxCol == col)
+                    break;
+            assert(idxUnknown < m);
+            LOG_ERROR( _log
+                     , "The numeric solver can't solve the LES. Unknown %s doesn't appear in"
+                       " any equation and the system determinant is null"
+                     , unknownAry[idxUnknown].name
+                     )
+            return false;
+        }
+        sumOfMin += minPowerOfColAry[col];
+        sumOfMax += maxPowerOfColAry[col];
+    }
+
+    signed int minPowerOfS = sumOfMin
+             , maxPowerOfS = sumOfMax;
+    for(col=0; col<m; ++col)
+    {
+        unsigned int colKnown;
+        for(colKnown=m; colKnown<n; ++colKnown)
+        {
+            if(isColNullAry[colKnown])
+                continue;
+
+            const signed int minPower = sumOfMin - minPowerOfColAry[col]
+                                        + minPowerOfColAry[colKnown]
+                           , maxPower = sumOfMax - maxPowerOfColAry[col]
+                                        + maxPowerOfColAry[colKnown];
+            if(minPower < minPowerOfS)
+                minPowerOfS = minPower;
+            if(maxPower > maxPowerOfS)
+                maxPowerOfS = maxPower;
+        }
+    }
+
+    /* Each device constant appears at most once in each product of the expanded
+       determinant. */
+    signed int noCapacitors = 0
+             , noInductivities = 0;
+    unsigned int idxConst;
+    for(idxConst=0; idxConst<noConstants; ++idxConst)
+    {
+        if(admittanceAry[idxConst].powerOfS > 0)
+            ++ noCapacitors;
+        else if(admittanceAry[idxConst].powerOfS < 0)
+            ++ noInductivities;
+    }
+    if(maxPowerOfS > noCapacitors)
+        maxPowerOfS = noCapacitors;
+    if(minPowerOfS < -noInductivities)
+        minPowerOfS = -noInductivities;
+    assert(minPowerOfS <= maxPowerOfS);
+
+    *pMinPowerOfS = minPowerOfS;
+    *pMaxPowerOfS = maxPowerOfS;
+    return true;
+
+} /* End of getRangeOfPowersOfS */
+
+
+
+
+/**
+ * Choose the radius of the circle of evaluation points. The radius should be close to the
+ * characteristic frequencies of the circuit, such that the terms of the polynomials have
+ * similar magnitudes. It is estimated as geometric mean of the corner frequencies of the
+ * reactive devices with a typical conductance, which is the geometric mean of the
+ * conductances of the circuit.
+ *   @return
+ * Get the radius.
+ *   @param admittanceAry
+ * The admittance of each constant, see getAdmittanceOfConstants.
+ *   @param pTableOfVars
+ * The table of variables, which the constants are defined in.
+ */
+
+static double getRadius( const admittanceOfConst_t admittanceAry[]
+                       , const tbv_tableOfVariables_t * const pTableOfVars
+                       )
+{
+    const pci_circuit_t * const pNetList = pTableOfVars->pCircuitNetList;
+    double sumOfLog = 0.0;
+    unsigned int noConductances = 0
+               , idxConst;
+    for(idxConst=0; idxConst<pTableOfVars->noConstants; ++idxConst)
+    {
+        const pci_device_t * const pDevice =
+                        pNetList->pDeviceAry[pTableOfVars->constantIdxToDevIdxAry[idxConst]];
+        const double value = fabs(admittanceAry[idxConst].value);
+        if((pDevice->type == pci_devType_resistor
+            ||  pDevice->type == pci_devType_conductance
+           )
+           &&  value > 0.0
+          )
+        {
+            sumOfLog += log(value);
+            ++ noConductances;
+        }
+    }
+    const double logOfConductance = noConductances > 0? sumOfLog/noConductances: 0.0;
+
+    sumOfLog = 0.0;
+    unsigned int noReactances = 0;
+    for(idxConst=0; idxConst<pTableOfVars->noConstants; ++idxConst)
+    {
+        const double value = fabs(admittanceAry[idxConst].value);
+        if(admittanceAry[idxConst].powerOfS != 0  &&  value > 0.0)
+        {
+            /* A capacitor has the admittance C*s, its corner frequency is G/C. An
+               inductivity has 1/(L*s), its corner frequency is 1/(L*G). */
+            if(admittanceAry[idxConst].powerOfS > 0)
+                sumOfLog += logOfConductance - log(value);
+            else
+                sumOfLog += log(value) - logOfConductance;
+            ++ noReactances;
+        }
+    }
+
+    return noReactances > 0? exp(sumOfLog/noReactances): 1.0;
+
+} /* End of getRadius */
+
+
+
+
+/**
+ * Move the binary exponent of a complex number into a separate integer, such that long
+ * products can be computed without overflow or underflow.
+ *   @param pMantissa
+ * The number on entry, the mantissa on return. Its larger component has a magnitude in
+ * the range [0.5, 1[.
+ *   @param pExponent
+ * The binary exponent of the number is added to * \a pExponent.
+ */
+
+static inline void renormalize(double complex * const pMantissa, signed int * const pExponent)
+{
+    const double re = creal(*pMantissa)
+               , im = cimag(*pMantissa);
+    signed int exponent;
+    frexp(fabs(re) > fabs(im)? re: im, &exponent);
+    *pMantissa = ldexp(re, -exponent) + ldexp(im, -exponent)*I;
+    *pExponent += exponent;
+
+} /* End of renormalize */
+
+
+
+
+/**
+ * The task of a thread: Evaluate the LES at a single point, compute its determinant and
+ * solve it for all knowns.
+ *   @param pContext
+ * The evaluation under progress by reference, see evaluation_t.
+ *   @param idxPoint
+ * The index of the point to evaluate.
+ *   @param idxThread
+ * The index of the executing thread. It selects the workspace.
+ */
+
+static void taskEvaluatePoint(void *pContext, unsigned int idxPoint, unsigned int idxThread)
+{
+    evaluation_t * const pEval = (evaluation_t*)pContext;
+    const unsigned int m = pEval->m
+                     , n = pEval->n
+                     , noKnowns = n - m;
+    double complex * const M = pEval->workspaceAry[idxThread];
+
+    /* The powers of s at the point, which are needed to evaluate the coefficients. */
+    const double theta = 2.0*PI*(idxPoint + 0.5) / pEval->noPoints;
+    const signed int minPower = pEval->minPowerOfTerms;
+    const unsigned int noPowers = (unsigned)(pEval->maxPowerOfTerms - minPower) + 1;
+    double complex powerOfSAry[noPowers];
+    signed int power;
+    for(power=minPower; power<=pEval->maxPowerOfTerms; ++power)
+    {
+        powerOfSAry[power-minPower] = pow(pEval->radius, power)
+                                      * cexp(I*(double)power*theta);
+    }
+
+    unsigned int idxCoef;
+    for(idxCoef=0; idxCoef<m*n; ++idxCoef)
+    {
+        const numericCoef_t * const pCoef = &pEval->coefAry[idxCoef];
+        const termOfCoef_t * const pTerm = &pEval->termAry[pCoef->idxFirstTerm];
+        double complex value = 0.0;
+        unsigned int idxTerm;
+        for(idxTerm=0; idxTerm<pCoef->noTerms; ++idxTerm)
+            value += pTerm[idxTerm].weight * powerOfSAry[pTerm[idxTerm].powerOfS - minPower];
+        M[idxCoef] = value;
+    }
+
+    /* LU decomposition with partial pivoting. The elimination is applied to the columns
+       of the knowns, too. */
+    double complex detMantissa = 1.0;
+    signed int detExponent = 0;
+    unsigned int k;
+    for(k=0; k<m; ++k)
+    {
+        unsigned int rowPivot = k
+                   , row;
+        double maxMagnitude = cabs(M[k*n + k]);
+        for(row=k+1; row<m; ++row)
+        {
+            const double magnitude = cabs(M[row*n + k]);
+            if(magnitude > maxMagnitude)
+            {
+                maxMagnitude = magnitude;
+                rowPivot = row;
+            }
+        }
+        if(maxMagnitude == 0.0)
+        {
+            pEval->detMantissaAry[idxPoint] = 0.0;
+            pEval->detExponentAry[idxPoint] = 0;
+            return;
+        }
+        if(rowPivot != k)
+        {
+            unsigned int col;
+            for(col=k; col<n; ++col)
+            {
+                const double complex tmp = M[k*n + col];
+                M[k*n + col] = M[rowPivot*n + col];
+                M[rowPivot*n + col] = tmp;
+            }
+            detMantissa = -detMantissa;
+        }
+
+        const double complex pivot = M[k*n + k];
+        detMantissa *= pivot;
+        renormalize(&detMantissa, &detExponent);
+
+        for(row=k+1; row<m; ++row)
+        {
+            const double complex f = M[row*n + k] / pivot;
+            if(f != 0.0)
+            {
+                unsigned int col;
+                for(col=k+1; col<n; ++col)
+                    M[row*n + col] -= f * M[k*n + col];
+            }
+        }
+    } /* End for(All elimination steps) */
+
+    pEval->detMantissaAry[idxPoint] = detMantissa;
+    pEval->detExponentAry[idxPoint] = detExponent;
+
+    /* Back substitution for all knowns. The LES has the form A_u*x + A_k*u = 0, the
+       solution is x = -A_u^-1*A_k. */
+    double complex * const X = pEval->solutionAry + (size_t)idxPoint*m*noKnowns;
+    unsigned int idxKnown;
+    for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+    {
+        unsigned int row = m;
+        while(row-- > 0)
+        {
+            double complex sum = -M[row*n + m + idxKnown];
+            unsigned int col;
+            for(col=row+1; col<m; ++col)
+                sum -= M[row*n + col] * X[col*noKnowns + idxKnown];
+            X[row*noKnowns + idxKnown] = sum / M[row*n + row];
+        }
+    }
+} /* End of taskEvaluatePoint */
+
+
+
+
+/**
+ * In place radix-2 FFT: a(m) := sum_k a(k)*exp(-2*pi*i*k*m/N).
+ *   @param a
+ * The vector to transform.
+ *   @param N
+ * The length of the vector, a power of two.
+ */
+
+static void fft(double complex a[], unsigned int N)
+{
+    /* Bit reversal permutation. */
+    unsigned int i, j = 0;
+    for(i=1; i<N; ++i)
+    {
+        unsigned int bit = N >> 1;
+        for(; j & bit; bit>>=1)
+            j ^= bit;
+        j ^= bit;
+        if(i < j)
+        {
+            const double complex tmp = a[i];
+            a[i] = a[j];
+            a[j] = tmp;
+        }
+    }
+
+    unsigned int len;
+    for(len=2; len<=N; len<<=1)
+    {
+        const unsigned int half = len/2;
+        unsigned int k;
+        for(k=0; k<half; ++k)
+        {
+            /* The twiddle factor is computed directly, not as a power of the root of
+               unity, to avoid accumulation of rounding errors. */
+            const double complex w = cexp(-2.0*PI*I*(double)k/(double)len);
+            for(i=k; i<N; i+=len)
+            {
+                const double complex u = a[i]
+                                   , v = a[i+half] * w;
+                a[i] = u + v;
+                a[i+half] = u - v;
+            }
+        }
+    }
+} /* End of fft */
+
+
+
+
+/**
+ * Interpolate the coefficients of a polynomial from its values at the evaluation points.
+ * The values are multiplied by s(k)^-minPowerOfS on entry, such that they belong to a
+ * polynomial with powers 0..N-1 in s/r.
+ *   @param yAry
+ * The N values on entry, the N coefficients of the powers of s/r on exit.
+ *   @param N
+ * The number of points.
+ */
+
+static void interpolate(double complex yAry[], unsigned int N)
+{
+    /* The points are s(k) = r*exp(i*theta(k)), theta(k) = 2*pi*(k+1/2)/N. With
+       the coefficients d(m) of the powers of s/r, the values are
+         y(k) = sum_m d(m)*exp(i*pi*m/N)*exp(2*pi*i*k*m/N)
+       and the inverse DFT yields d(m). */
+    fft(yAry, N);
+    unsigned int idx;
+    for(idx=0; idx<N; ++idx)
+        yAry[idx] *= cexp(-I*PI*(double)idx/(double)N) / N;
+
+} /* End of interpolate */
+
+
+
+
+/**
+ * Evaluate the LES at all points of a circle. The points are distributed among the
+ * threads of the pool.
+ *   @return
+ * \a true if the evaluation succeeded, \a false if the matrix is singular at any of the
+ * points. An error has been reported in this case.
+ *   @param pEval
+ * The evaluation by reference. The radius of the circle is set and the determinants and
+ * solutions at all points are returned in * \a pEval.
+ *   @param radius
+ * The radius of the circle.
+ */
+
+static boolean evaluateCircle(evaluation_t * const pEval, double radius)
+{
+    pEval->radius = radius;
+    LOG_DEBUG( _log
+             , "Numeric solver: The LES is evaluated at %u points on a circle with radius %g"
+             , pEval->noPoints
+             , radius
+             )
+    thp_runTasks(_hThreadPool, /* noTasks */ pEval->noPoints, taskEvaluatePoint, pEval);
+
+    /* A singular matrix at any point means a null determinant; the points are chosen off
+       the axes, where the poles of passive circuits are. */
+    unsigned int idxPoint;
+    for(idxPoint=0; idxPoint<pEval->noPoints; ++idxPoint)
+    {
+        if(pEval->detMantissaAry[idxPoint] == 0.0)
+        {
+            LOG_ERROR( _log
+                     , "The numeric solver can't solve the LES. The system determinant is"
+                       " null or the matrix is numerically singular"
+                     )
+            return false;
+        }
+    }
+    return true;
+
+} /* End of evaluateCircle */
+
+
+
+
+/**
+ * Interpolate the coefficients of a polynomial from its values on the current circle and
+ * keep those, which are more accurate than the estimates from the circles evaluated
+ * before.
+ *   @param pInterpol
+ * The interpolation under progress by reference, see interpolation_t.
+ *   @param idxPoly
+ * The index of the polynomial.
+ *   @param yAry
+ * The values of the polynomial at the points, multiplied by s(k)^-minPowerOfS. The array
+ * is used as workspace and is invalid on return.
+ *   @param noPoints
+ * The number of points, the number of elements of \a yAry.
+ *   @param logOfScale
+ * The natural logarithm of the factor, which relates the values on the current circle to
+ * the scale of the first circle.
+ *   @param logOfRadius
+ * The natural logarithm of the radius of the current circle.
+ */
+
+static void addCoefficients( interpolation_t * const pInterpol
+                           , unsigned int idxPoly
+                           , double complex yAry[]
+                           , unsigned int noPoints
+                           , double logOfScale
+                           , double logOfRadius
+                           )
+{
+    double reference = 0.0;
+    unsigned int idx;
+    for(idx=0; idx<noPoints; ++idx)
+    {
+        if(cabs(yAry[idx]) > reference)
+            reference = cabs(yAry[idx]);
+    }
+    if(reference == 0.0)
+        return;
+
+    /* The interpolated value d(m) is the coefficient of s^(minPowerOfS+m) times
+       r^(minPowerOfS+m). Its rounding error is bounded by a fraction of the largest
+       value, which it has been interpolated from. */
+    interpolate(yAry, noPoints);
+    const unsigned int noCoefs = pInterpol->noCoefs;
+    double * const coefAry = pInterpol->coefAry + (size_t)idxPoly*noCoefs
+       , * const errorAry = pInterpol->errorAry + (size_t)idxPoly*noCoefs
+       , * const imagPartAry = pInterpol->imagPartAry + (size_t)idxPoly*noCoefs;
+    for(idx=0; idx<noCoefs; ++idx)
+    {
+        const double factor = exp(logOfScale
+                                  - (pInterpol->minPowerOfS + (signed)idx)*logOfRadius
+                                 )
+                   , error = factor*reference;
+        if(error < errorAry[idx])
+        {
+            coefAry[idx] = factor*creal(yAry[idx]);
+            errorAry[idx] = error;
+            imagPartAry[idx] = fabs(cimag(yAry[idx])) / reference;
+        }
+    }
+} /* End of addCoefficients */
+
+
+
+
+/**
+ * Interpolate the coefficients of the determinant and of all numerators from the
+ * evaluation of the LES on the current circle.
+ *   @param pInterpol
+ * The interpolation under progress by reference, see interpolation_t.
+ *   @param pEval
+ * The evaluation of the LES on the current circle, see evaluateCircle.
+ *   @param pTableOfVars
+ * The table of variables of the solution, which decides about the order of unknowns in
+ * the solution and about the meaning of the user-defined voltages.
+ *   @param unknownAry
+ * The table of unknowns of the LES, which relates the unknowns to the columns of the
+ * matrix.
+ */
+
+static void addCircle( interpolation_t * const pInterpol
+                     , const evaluation_t * const pEval
+                     , const tbv_tableOfVariables_t * const pTableOfVars
+                     , const tbv_unknownVariable_t unknownAry[]
+                     )
+{
+    const unsigned int noPoints = pEval->noPoints
+                     , noUnknowns = pEval->m
+                     , noKnowns = pEval->n - pEval->m;
+    const pci_circuit_t * const pNetList = pTableOfVars->pCircuitNetList;
+    const unsigned int noDependents = noUnknowns + pNetList->noVoltageDefs;
+    assert(pInterpol->noPolys == 1 + noDependents*noKnowns);
+
+    /* The determinant at all points in a common scaling. The scaling of the first circle
+       is the reference for all further ones. */
+    signed int maxExponent = INT_MIN;
+    unsigned int idxPoint;
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+    {
+        if(pEval->detExponentAry[idxPoint] > maxExponent)
+            maxExponent = pEval->detExponentAry[idxPoint];
+    }
+    if(!pInterpol->isScaleDefined)
+    {
+        pInterpol->exponentOfScale = maxExponent;
+        pInterpol->isScaleDefined = true;
+    }
+    const double logOfScale = (maxExponent - pInterpol->exponentOfScale)*log(2.0)
+               , logOfRadius = log(pEval->radius);
+
+    /* The values of all polynomials are rotated by exp(-i*minPowerOfS*theta), such that
+       the interpolation yields the powers from minPowerOfS on. */
+    double complex detAry[noPoints], rotationAry[noPoints], yAry[noPoints];
+    for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+    {
+        const double theta = 2.0*PI*(idxPoint + 0.5) / noPoints;
+        rotationAry[idxPoint] = cexp(-I*(double)pInterpol->minPowerOfS*theta);
+        const double complex mantissa = pEval->detMantissaAry[idxPoint];
+        const signed int exponent = pEval->detExponentAry[idxPoint] - maxExponent;
+        detAry[idxPoint] = ldexp(creal(mantissa), exponent)
+                           + ldexp(cimag(mantissa), exponent)*I;
+        yAry[idxPoint] = detAry[idxPoint] * rotationAry[idxPoint];
+    }
+    addCoefficients(pInterpol, /* idxPoly */ 0, yAry, noPoints, logOfScale, logOfRadius);
+
+    /* The numerators of all dependents, N(s(k)) = D(s(k))*x(s(k)). The user-defined
+       voltages are the differences of the potentials of their nodes. */
+    double complex (* const valueAry)[noDependents > 0? noDependents: 1] =
+                        smalloc( (size_t)noPoints*(noDependents > 0? noDependents: 1)
+                                 * sizeof(double complex)
+                               , __FILE__
+                               , __LINE__
+                               );
+    const size_t sizeOfPoint = (size_t)noUnknowns*noKnowns;
+    unsigned int idxKnown;
+    for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+    {
+        for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+        {
+            const double complex * const X = pEval->solutionAry + idxPoint*sizeOfPoint;
+            unsigned int idxUnknown;
+            for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
+            {
+                const unsigned int idxSol =
+                                        pTableOfVars->unknownLookUpAry[idxUnknown].idxCol;
+                assert(idxSol < noUnknowns);
+                valueAry[idxPoint][idxSol] = detAry[idxPoint]
+                                             * X[unknownAry[idxUnknown].idxCol*noKnowns
+                                                 + idxKnown
+                                                ]
+                                             * rotationAry[idxPoint];
+            }
+            unsigned int idxVoltage;
+            for(idxVoltage=0; idxVoltage<pNetList->noVoltageDefs; ++idxVoltage)
+            {
+                const pci_voltageDef_t * const pVoltageDef =
+                                                        &pNetList->voltageDefAry[idxVoltage];
+                const tbv_unknownVariable_t
+                      * const pPlus = tbv_getUnknownByNode( pTableOfVars
+                                                          , pVoltageDef->idxNodePlus
+                                                          )
+                    , * const pMinus = tbv_getUnknownByNode( pTableOfVars
+                                                           , pVoltageDef->idxNodeMinus
+                                                           );
+                double complex value = 0.0;
+                if(pPlus != NULL)
+                    value += valueAry[idxPoint][pPlus->idxCol];
+                if(pMinus != NULL)
+                    value -= valueAry[idxPoint][pMinus->idxCol];
+                valueAry[idxPoint][noUnknowns + idxVoltage] = value;
+            }
+        } /* End for(All points) */
+
+        unsigned int idxDependent;
+        for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
+        {
+            for(idxPoint=0; idxPoint<noPoints; ++idxPoint)
+                yAry[idxPoint] = valueAry[idxPoint][idxDependent];
+            addCoefficients( pInterpol
+                           , /* idxPoly */ 1 + idxDependent*noKnowns + idxKnown
+                           , yAry
+                           , noPoints
+                           , logOfScale
+                           , logOfRadius
+                           );
+        }
+    } /* End for(All knowns) */
+    free(valueAry);
+
+} /* End of addCircle */
+
+
+
+
+/**
+ * Check, which coefficients of a polynomial are resolved by the circles evaluated so far.
+ * A coefficient is resolved if it is significantly larger than its error bound.
+ *   @return
+ * Get the number of resolved coefficients.
+ *   @param pIdxFirst
+ * The index of the lowest resolved coefficient is returned in * \a pIdxFirst. Unmodified
+ * if the function returns null.
+ *   @param pIdxLast
+ * The index of the highest resolved coefficient is returned in * \a pIdxLast. Unmodified
+ * if the function returns null.
+ *   @param pInterpol
+ * The interpolation under progress, see interpolation_t.
+ *   @param idxPoly
+ * The index of the polynomial.
+ */
+
+static unsigned int getResolvedCoefs( unsigned int * const pIdxFirst
+                                    , unsigned int * const pIdxLast
+                                    , const interpolation_t * const pInterpol
+                                    , unsigned int idxPoly
+                                    )
+{
+    const unsigned int noCoefs = pInterpol->noCoefs;
+    const double * const coefAry = pInterpol->coefAry + (size_t)idxPoly*noCoefs
+             , * const errorAry = pInterpol->errorAry + (size_t)idxPoly*noCoefs;
+    unsigned int noResolvedCoefs = 0
+               , idx;
+    for(idx=0; idx<noCoefs; ++idx)
+    {
+        if(fabs(coefAry[idx]) > ZERO_THRESHOLD*errorAry[idx])
+        {
+            if(noResolvedCoefs++ == 0)
+                *pIdxFirst = idx;
+            *pIdxLast = idx;
+        }
+    }
+    return noResolvedCoefs;
+
+} /* End of getResolvedCoefs */
+
+
+
+
+/**
+ * Estimate the error bound of a coefficient of a polynomial on a circle of given radius.
+ * The bound is proportional to the largest term |c(j)|*r^j of the polynomial divided by
+ * r^k.
+ *   @return
+ * Get the natural logarithm of the estimated error bound.
+ *   @param logOfCoefAry
+ * The natural logarithm of the magnitudes of the coefficients, -HUGE_VAL for null ones.
+ *   @param noCoefs
+ * The number of coefficients.
+ *   @param idxCoef
+ * The index k of the coefficient.
+ *   @param logOfRadius
+ * The natural logarithm of the radius r.
+ */
+
+static double getLogOfErrorBound( const double logOfCoefAry[]
+                                , unsigned int noCoefs
+                                , unsigned int idxCoef
+                                , double logOfRadius
+                                )
+{
+    double logOfErrorBound = -HUGE_VAL;
+    unsigned int idx;
+    for(idx=0; idx<noCoefs; ++idx)
+    {
+        const double logOfTerm = logOfCoefAry[idx]
+                                 + ((signed)idx - (signed)idxCoef)*logOfRadius;
+        if(logOfTerm > logOfErrorBound)
+            logOfErrorBound = logOfTerm;
+    }
+    return logOfErrorBound;
+
+} /* End of getLogOfErrorBound */
+
+
+
+
+/**
+ * Find the radius of a further circle, which improves the accuracy of the least accurate
+ * coefficient of the determinant.
+ *   @return
+ * \a true if a circle is found, \a false if all coefficients are accurate enough or if no
+ * further circle promises a significant improvement.
+ *   @param pRadius
+ * The radius of the new circle is returned in * \a pRadius if the function returns \a
+ * true.
+ *   @param pInterpol
+ * The interpolation under progress, see interpolation_t.
+ *   @param radiusAry
+ * The radii of the circles evaluated so far.
+ *   @param noCircles
+ * The number of elements of \a radiusAry.
+ */
+
+static boolean getRadiusForAccuracy( double * const pRadius
+                                   , const interpolation_t * const pInterpol
+                                   , const double radiusAry[]
+                                   , unsigned int noCircles
+                                   )
+{
+    assert(noCircles > 0);
+    const unsigned int noCoefs = pInterpol->noCoefs;
+    const double * const coefAry = pInterpol->coefAry
+               , * const errorAry = pInterpol->errorAry;
+
+    /* The estimation of the error bounds considers all unresolved coefficients null. */
+    double logOfCoefAry[noCoefs];
+    unsigned int idx;
+    for(idx=0; idx<noCoefs; ++idx)
+    {
+        logOfCoefAry[idx] = fabs(coefAry[idx]) > ZERO_THRESHOLD*errorAry[idx]
+                            ? log(fabs(coefAry[idx]))
+                            : -HUGE_VAL;
+    }
+    double minLogOfRadius = HUGE_VAL
+         , maxLogOfRadius = -HUGE_VAL;
+    unsigned int idxCircle;
+    for(idxCircle=0; idxCircle<noCircles; ++idxCircle)
+    {
+        const double logOfRadius = log(radiusAry[idxCircle]);
+        if(logOfRadius < minLogOfRadius)
+            minLogOfRadius = logOfRadius;
+        if(logOfRadius > maxLogOfRadius)
+            maxLogOfRadius = logOfRadius;
+    }
+
+    boolean found = false;
+    double maxRatio = ACCURACY_TARGET;
+    for(idx=0; idx<noCoefs; ++idx)
+    {
+        if(logOfCoefAry[idx] == -HUGE_VAL  ||  errorAry[idx] <= maxRatio*fabs(coefAry[idx]))
+            continue;
+
+        /* The logarithm of the error bound is a convex function of the logarithm of the
+           radius. Its minimum is searched by ternary search in the range of the
+           evaluated radii, widened by one step. */
+        double a = minLogOfRadius - log(RADIUS_STEP)
+             , b = maxLogOfRadius + log(RADIUS_STEP);
+        unsigned int iteration;
+        for(iteration=0; iteration<60; ++iteration)
+        {
+            const double x1 = a + (b-a)/3.0
+                       , x2 = b - (b-a)/3.0;
+            if(getLogOfErrorBound(logOfCoefAry, noCoefs, idx, x1)
+               < getLogOfErrorBound(logOfCoefAry, noCoefs, idx, x2)
+              )
+            {
+                b = x2;
+            }
+            else
+                a = x1;
+        }
+        const double logOfRadius = (a+b)/2.0;
+        if(log(errorAry[idx]) - getLogOfErrorBound(logOfCoefAry, noCoefs, idx, logOfRadius)
+           < log(ACCURACY_GAIN)
+          )
+        {
+            continue;
+        }
+
+        /* A circle close to an evaluated one won't improve the accuracy. */
+        for(idxCircle=0; idxCircle<noCircles; ++idxCircle)
+        {
+            if(fabs(log(radiusAry[idxCircle]) - logOfRadius) < log(2.0))
+                break;
+        }
+        if(idxCircle < noCircles)
+            continue;
+
+        maxRatio = errorAry[idx] / fabs(coefAry[idx]);
+        *pRadius = exp(logOfRadius);
+        found = true;
+    }
+
+    return found;
+
+} /* End of getRadiusForAccuracy */
+
+
+
+
+/**
+ * Create a polynomial from the interpolated coefficients. Unresolved coefficients are
+ * considered null.
+ *   @param pPoly
+ * The polynomial is returned in * \a pPoly. The array of coefficients is malloc allocated.
+ *   @param pInterpol
+ * The completed interpolation, see interpolation_t.
+ *   @param idxPoly
+ * The index of the interpolated polynomial.
+ *   @param factor
+ * All coefficients are multiplied with this factor.
+ *   @param powerOfNorm
+ * The power of s, which is divided off all coefficients, as index into the interpolated
+ * coefficients. The coefficient with this index belongs to s^0 in the result.
+ *   @param pMaxImagPart
+ * The largest relative imaginary part of a resolved coefficient is returned in * \a
+ * pMaxImagPart if it is larger than the value on entry.
+ */
+
+static void createPolynomial( nsl_polynomial_t * const pPoly
+                            , const interpolation_t * const pInterpol
+                            , unsigned int idxPoly
+                            , double factor
+                            , signed int powerOfNorm
+                            , double * const pMaxImagPart
+                            )
+{
+    pPoly->powerOfS = 0;
+    pPoly->noCoefs = 0;
+    pPoly->coefAry = NULL;
+
+    unsigned int idxFirst = 0
+               , idxLast = 0;
+    if(getResolvedCoefs(&idxFirst, &idxLast, pInterpol, idxPoly) == 0)
+        return;
+
+    const unsigned int noCoefs = pInterpol->noCoefs;
+    const double * const coefAry = pInterpol->coefAry + (size_t)idxPoly*noCoefs
+             , * const errorAry = pInterpol->errorAry + (size_t)idxPoly*noCoefs
+             , * const imagPartAry = pInterpol->imagPartAry + (size_t)idxPoly*noCoefs;
+    pPoly->powerOfS = (signed)idxFirst - powerOfNorm;
+    pPoly->noCoefs = idxLast - idxFirst + 1;
+    pPoly->coefAry = smalloc(pPoly->noCoefs*sizeof(double), __FILE__, __LINE__);
+    unsigned int idx;
+    for(idx=idxFirst; idx<=idxLast; ++idx)
+    {
+        if(fabs(coefAry[idx]) > ZERO_THRESHOLD*errorAry[idx])
+        {
+            pPoly->coefAry[idx-idxFirst] = factor*coefAry[idx];
+            if(imagPartAry[idx] > *pMaxImagPart)
+                *pMaxImagPart = imagPartAry[idx];
+        }
+        else
+            pPoly->coefAry[idx-idxFirst] = 0.0;
+    }
+} /* End of createPolynomial */
+
+
+
+
+/**
+ * Copy a polynomial.
+ *   @param pTo
+ * The copy is returned in * \a pTo.
+ *   @param pFrom
+ * The polynomial to copy.
+ */
+
+static void copyPolynomial(nsl_polynomial_t * const pTo, const nsl_polynomial_t * const pFrom)
+{
+    *pTo = *pFrom;
+    if(pFrom->noCoefs > 0)
+    {
+        pTo->coefAry = smalloc(pFrom->noCoefs*sizeof(double), __FILE__, __LINE__);
+        memcpy(pTo->coefAry, pFrom->coefAry, pFrom->noCoefs*sizeof(double));
+    }
+    else
+        pTo->coefAry = NULL;
+
+} /* End of copyPolynomial */
+
+
+
+
+/**
+ * Free the memory of a polynomial.
+ *   @param pPoly
+ * The polynomial. It becomes the null polynomial.
+ */
+
+static void freePolynomial(nsl_polynomial_t * const pPoly)
+{
+    free(pPoly->coefAry);
+    pPoly->coefAry = NULL;
+    pPoly->noCoefs = 0;
+    pPoly->powerOfS = 0;
+
+} /* End of freePolynomial */
+
+
+
+
+/**
+ * Create a matrix of null polynomials.
+ *   @return
+ * Get the matrix as an array of pointers to rows. It needs to be deleted with
+ * deleteMatrixOfPolynomials after use.
+ *   @param noRows
+ * The number of rows.
+ *   @param noCols
+ * The number of columns.
+ */
+
+static nsl_polynomial_t **createMatrixOfPolynomials(unsigned int noRows, unsigned int noCols)
+{
+    nsl_polynomial_t * * const matrix = smalloc( (noRows > 0? noRows: 1)
+                                                 * sizeof(nsl_polynomial_t*)
+                                               , __FILE__
+                                               , __LINE__
+                                               );
+    unsigned int row, col;
+    for(row=0; row<noRows; ++row)
+    {
+        matrix[row] = smalloc( (noCols > 0? noCols: 1)*sizeof(nsl_polynomial_t)
+                             , __FILE__
+                             , __LINE__
+                             );
+        for(col=0; col<noCols; ++col)
+        {
+            matrix[row][col].powerOfS = 0;
+            matrix[row][col].noCoefs = 0;
+            matrix[row][col].coefAry = NULL;
+        }
+    }
+
+    return matrix;
+
+} /* End of createMatrixOfPolynomials */
+
+
+
+
+/**
+ * Delete a matrix of polynomials after use.
+ *   @param matrix
+ * The matrix as got from createMatrixOfPolynomials.
+ *   @param noRows
+ * The number of rows.
+ *   @param noCols
+ * The number of columns.
+ */
+
+static void deleteMatrixOfPolynomials( nsl_polynomial_t * * const matrix
+                                     , unsigned int noRows
+                                     , unsigned int noCols
+                                     )
+{
+    unsigned int row, col;
+    for(row=0; row<noRows; ++row)
+    {
+        for(col=0; col<noCols; ++col)
+            freePolynomial(&matrix[row][col]);
+        free(matrix[row]);
+    }
+    free(matrix);
+
+} /* End of deleteMatrixOfPolynomials */
+
+
+
+
+/**
+ * Find a dependent or independent quantity of a numeric solution by name. This is the
+ * counterpart of sol_findName.
+ *   @return
+ * Get the number of matches. The name is valid only if the return value is one; an
+ * error has been reported otherwise.
+ *   @param pIdxSolution
+ * If the name designates an unknown or a user-defined voltage then its index into the
+ * numerators of the solution is returned in * \a pIdxSolution, otherwise -1.
+ *   @param pIdxKnown
+ * If the name designates a known then its index is returned in * \a pIdxKnown, otherwise
+ * -1.
+ *   @param pTabOfVars
+ * The table of variables of the solution.
+ *   @param name
+ * The name of the quantity.
+ */
+
+static unsigned int findName( signed int * const pIdxSolution
+                            , signed int * const pIdxKnown
+                            , const tbv_tableOfVariables_t * const pTabOfVars
+                            , const char * const name
+                            )
+{
+    unsigned int noMatches = 0;
+    *pIdxSolution = -1;
+    *pIdxKnown = -1;
+
+    const pci_circuit_t * const pNetList = pTabOfVars->pCircuitNetList;
+    unsigned int idx;
+    for(idx=0; idx<pTabOfVars->noUnknowns; ++idx)
+    {
+        if(strcmp(pTabOfVars->unknownLookUpAry[idx].name, name) == 0  &&  noMatches++ == 0)
+            *pIdxSolution = (signed)idx;
+    }
+    for(idx=0; idx<pNetList->noVoltageDefs; ++idx)
+    {
+        if(strcmp(pNetList->voltageDefAry[idx].name, name) == 0  &&  noMatches++ == 0)
+            *pIdxSolution = (signed)(pTabOfVars->noUnknowns + idx);
+    }
+    for(idx=0; idx<pTabOfVars->noKnowns; ++idx)
+    {
+        if(strcmp(pTabOfVars->knownLookUpAry[idx].name, name) == 0  &&  noMatches++ == 0)
+            *pIdxKnown = (signed)idx;
+    }
+
+    if(noMatches != 1)
+    {
+        LOG_ERROR( _log
+                 , "A solution refers to quantity %s. %s"
+                 , name
+                 , noMatches > 1
+                   ? "This name is ambiguous. (Forbidden name ambiguities include clashes"
+                     " between dependent and independent quantities.)"
+                   : "No such quantity is defined."
+                 )
+    }
+
+    return noMatches;
+
+} /* End of findName */
+
+
+
+
+/**
+ * Write a polynomial into the current line of a log, highest power first. Each power is
+ * written on a separate line.
+ *   @param hLog
+ * The logger.
+ *   @param pPoly
+ * The polynomial.
+ *   @param indentation
+ * The number of blanks, which precede the continuation lines.
+ */
+
+static void logPolynomial( log_hLogger_t hLog
+                         , const nsl_polynomial_t * const pPoly
+                         , unsigned int indentation
+                         )
+{
+    if(pPoly->noCoefs == 0)
+    {
+        log_log(hLog, log_continueLine, "0");
+        return;
+    }
+
+    boolean isFirst = true;
+    unsigned int idx = pPoly->noCoefs;
+    while(idx-- > 0)
+    {
+        const double coef = pPoly->coefAry[idx];
+        if(coef == 0.0)
+            continue;
+
+        if(!isFirst)
+            log_log(hLog, log_continueLine, "\n%*s", (int)indentation, "");
+        log_log( hLog
+               , log_continueLine
+               , "%s%.9g"
+               , coef < 0.0? "-": (isFirst? "": "+")
+               , fabs(coef)
+               );
+        const signed int powerOfS = pPoly->powerOfS + (signed)idx;
+        if(powerOfS == 1)
+            log_log(hLog, log_continueLine, " * s");
+        else if(powerOfS != 0)
+            log_log(hLog, log_continueLine, " * s^%d", powerOfS);
+        isFirst = false;
+    }
+} /* End of logPolynomial */
+
+
+
+
+/**
+ * Initialize the module at application startup.
+ *   @param hGlobalLogger
+ * This module will use the passed logger object for all reporting during application life
+ * time. It must be a real object, LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT is not permitted.
+ *   @param noThreads
+ * The number of threads, which the evaluation of the LES at the different points is
+ * distributed to. The threads are created on first use of the numeric solver.
+ *   @remark
+ * Do not forget to call the counterpart at application end.
+ *   @remark
+ * This module depends on the modules coe_coefficient and tbv_tableOfVariables. They need
+ * to be initialized before and shut down after this module.
+ *   @see void nsl_shutdownModule()
+ */
+
+void nsl_initModule(log_hLogger_t hGlobalLogger, unsigned int noThreads)
+{
+    assert(hGlobalLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+    _log = log_cloneByReference(hGlobalLogger);
+
+    assert(noThreads >= 1  &&  noThreads <= THP_MAX_NO_THREADS);
+    _noThreads = noThreads;
+    _hThreadPool = THP_HANDLE_INVALID_THREAD_POOL;
+
+#ifdef DEBUG
+    /* The DEBUG compilation counts all references to all created objects. */
+    _noRefsToObjects = 0;
+#endif
+} /* End of nsl_initModule */
+
+
+
+
+/**
+ * Do all cleanup after use of the module, which is required to avoid memory leaks,
+ * orphaned handles, etc.
+ */
+
+void nsl_shutdownModule()
+{
+#ifdef DEBUG
+    /* The DEBUG compilation looks for still allocated objects in order to detect memory
+       leaks. */
+    if(_noRefsToObjects != 0)
+    {
+        fprintf( stderr
+               , "nsl_shutdownModule: %u references to objects of type"
+                 " nsl_numericSolution_t or nsl_numericResult_t have not been discarded at"
+                 " application shutdown. There are probable memory leaks\n"
+               , _noRefsToObjects
+               );
+    }
+#endif
+
+    if(_hThreadPool != THP_HANDLE_INVALID_THREAD_POOL)
+    {
+        thp_deleteThreadPool(_hThreadPool);
+        _hThreadPool = THP_HANDLE_INVALID_THREAD_POOL;
+    }
+    _noThreads = 0;
+
+    /* Discard reference to the logger object. */
+    log_deleteLogger(_log);
+    _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+} /* End of nsl_shutdownModule */
+
+
+
+
+/**
+ * Compute the numeric solution of a LES. The LES is evaluated at a set of points and the
+ * coefficients of the determinant and of all numerators are recovered by interpolation.
+ *   @return
+ * \a true if the solution could be computed, \a false otherwise. An error has been
+ * reported in this case.
+ *   @param ppSolution
+ * The new solution object is returned in * \a ppSolution. It needs to be deleted with
+ * nsl_deleteSolution after use. NULL is returned in case of an error.
+ *   @param pLES
+ * The LES. Its matrix is set up as required by the solver but its coefficients are not
+ * modified.
+ */
+
+boolean nsl_createSolution( const nsl_numericSolution_t * * const ppSolution
+                          , les_linearEquationSystem_t * const pLES
+                          )
+{
+    assert(_log != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+    *ppSolution = NULL;
+
+    /* The shallow copy freezes the order of the unknowns, see sol_createSolution. */
+    tbv_tableOfVariables_t * const pTabOfVars = tbv_cloneByShallowCopy(pLES->pTableOfVars);
+    unsigned int noKnowns, noUnknowns, noConstants;
+    les_getNoVariables(pLES, &noKnowns, &noUnknowns, &noConstants);
+    assert(noUnknowns > 0);
+    const tbv_unknownVariable_t * const unknownAry = les_getTableOfUnknowns(pLES, NULL);
+    if(!les_setupLES(pLES, unknownAry[0].name))
+    {
+        tbv_deleteTableOfVariables(pTabOfVars);
+        return false;
+    }
+
+    admittanceOfConst_t admittanceAry[noConstants > 0? noConstants: 1];
+    if(!getAdmittanceOfConstants(admittanceAry, pTabOfVars))
+    {
+        tbv_deleteTableOfVariables(pTabOfVars);
+        return false;
+    }
+
+    evaluation_t eval = { .m = noUnknowns, .n = noUnknowns + noKnowns };
+    compileLES(&eval, pLES->A, admittanceAry);
+
+    signed int minPowerOfS, maxPowerOfS;
+    if(!getRangeOfPowersOfS( &minPowerOfS
+                           , &maxPowerOfS
+                           , &eval
+                           , admittanceAry
+                           , pLES
+                           , noConstants
+                           )
+      )
+    {
+        free((void*)eval.coefAry);
+        free((void*)eval.termAry);
+        tbv_deleteTableOfVariables(pTabOfVars);
+        return false;
+    }
+
+    /* The number of points is the next power of two, which is not less than the number of
+       possible powers of s. A few more points make the recognition of null coefficients
+       more reliable. */
+    const unsigned int noPowers = (unsigned)(maxPowerOfS - minPowerOfS) + 1;
+    unsigned int noPoints = noPowers > 1? 4: 1;
+    while(noPoints < noPowers)
+        noPoints *= 2;
+    eval.noPoints = noPoints;
+    LOG_DEBUG( _log
+             , "Numeric solver: The powers of s are in the range [%d, %d]"
+             , minPowerOfS
+             , maxPowerOfS
+             )
+
+    /* The worker threads are created on first use. */
+    if(_hThreadPool == THP_HANDLE_INVALID_THREAD_POOL)
+    {
+        _hThreadPool = thp_createThreadPool( _log
+                                           , _noThreads
+                                           , /* fctStartThread */ NULL
+                                           , /* fctStopThread */ NULL
+                                           , /* pContext */ NULL
+                                           );
+    }
+    const unsigned int noThreads = thp_getNoThreads(_hThreadPool)
+                     , m = eval.m
+                     , n = eval.n;
+    eval.workspaceAry = smalloc(noThreads*sizeof(double complex*), __FILE__, __LINE__);
+    unsigned int idxThread;
+    for(idxThread=0; idxThread<noThreads; ++idxThread)
+    {
+        eval.workspaceAry[idxThread] = smalloc( (size_t)m*n*sizeof(double complex)
+                                              , __FILE__
+                                              , __LINE__
+                                              );
+    }
+    eval.detMantissaAry = smalloc(noPoints*sizeof(double complex), __FILE__, __LINE__);
+    eval.detExponentAry = smalloc(noPoints*sizeof(signed int), __FILE__, __LINE__);
+    eval.solutionAry = smalloc( ((size_t)noPoints*m*noKnowns > 0
+                                 ? (size_t)noPoints*m*noKnowns
+                                 : 1
+                                )
+                                * sizeof(double complex)
+                              , __FILE__
+                              , __LINE__
+                              );
+
+    /* The polynomials are the determinant, index 0, and the numerators of all dependents
+       for all knowns. No coefficient is known before the first circle. */
+    const pci_circuit_t * const pNetList = pTabOfVars->pCircuitNetList;
+    const unsigned int noDependents = noUnknowns + pNetList->noVoltageDefs
+                     , noPolys = 1 + noDependents*noKnowns;
+    const size_t sizeOfCoefAry = (size_t)noPolys*noPowers*sizeof(double);
+    interpolation_t interpol = { .noPolys = noPolys
+                               , .noCoefs = noPowers
+                               , .minPowerOfS = minPowerOfS
+                               , .coefAry = smalloc(sizeOfCoefAry, __FILE__, __LINE__)
+                               , .errorAry = smalloc(sizeOfCoefAry, __FILE__, __LINE__)
+                               , .imagPartAry = smalloc(sizeOfCoefAry, __FILE__, __LINE__)
+                               , .isScaleDefined = false
+                               , .exponentOfScale = 0
+                               };
+    size_t idxCoef;
+    for(idxCoef=0; idxCoef<(size_t)noPolys*noPowers; ++idxCoef)
+    {
+        interpol.coefAry[idxCoef] = 0.0;
+        interpol.errorAry[idxCoef] = HUGE_VAL;
+        interpol.imagPartAry[idxCoef] = 0.0;
+    }
+
+    /* The first circle is placed at the characteristic frequencies of the circuit. If
+       it can't resolve the lowest or highest possible powers of the determinant then
+       further circles are evaluated with decreasing or increasing radius, as long as
+       each of them resolves more of these powers. Finally, circles are placed at the
+       radii, which suit the least accurate coefficients best. */
+    double radiusAry[MAX_NO_CIRCLES];
+    radiusAry[0] = getRadius(admittanceAry, pTabOfVars);
+    double minRadius = radiusAry[0]
+         , maxRadius = radiusAry[0];
+    boolean success = evaluateCircle(&eval, radiusAry[0]);
+    unsigned int noCircles = 1
+               , idxFirst = 0
+               , idxLast = noPowers-1;
+    if(success)
+    {
+        addCircle(&interpol, &eval, pTabOfVars, unknownAry);
+        getResolvedCoefs(&idxFirst, &idxLast, &interpol, /* idxPoly */ 0);
+    }
+    boolean searchDown = idxFirst > 0
+          , searchUp = idxLast+1 < noPowers;
+    while(success)
+    {
+        double radius;
+        if(searchDown)
+            radius = minRadius /= RADIUS_STEP;
+        else if(searchUp)
+            radius = maxRadius *= RADIUS_STEP;
+        else if(!getRadiusForAccuracy(&radius, &interpol, radiusAry, noCircles))
+            break;
+
+        if(noCircles >= MAX_NO_CIRCLES)
+        {
+            LOG_WARN( _log
+                    , "The numeric solver can't determine the coefficients of the powers of"
+                      " s in the range [%d, %d] accurately with %u circles of evaluation"
+                      " points. The result may be inaccurate"
+                    , minPowerOfS
+                    , maxPowerOfS
+                    , noCircles
+                    )
+            break;
+        }
+
+        success = evaluateCircle(&eval, radius);
+        if(success)
+        {
+            radiusAry[noCircles++] = radius;
+            addCircle(&interpol, &eval, pTabOfVars, unknownAry);
+            unsigned int idxFirstNew = idxFirst
+                       , idxLastNew = idxLast;
+            getResolvedCoefs(&idxFirstNew, &idxLastNew, &interpol, /* idxPoly */ 0);
+            if(searchDown)
+                searchDown = idxFirstNew < idxFirst  &&  idxFirstNew > 0;
+            else if(searchUp)
+                searchUp = idxLastNew > idxLast  &&  idxLastNew+1 < noPowers;
+            idxFirst = idxFirstNew;
+            idxLast = idxLastNew;
+        }
+    } /* End while(More circles are required) */
+    LOG_DEBUG(_log, "Numeric solver: %u circles of evaluation points used", noCircles)
+
+    for(idxThread=0; idxThread<noThreads; ++idxThread)
+        free(eval.workspaceAry[idxThread]);
+    free(eval.workspaceAry);
+    free((void*)eval.coefAry);
+    free((void*)eval.termAry);
+    free(eval.detMantissaAry);
+    free(eval.detExponentAry);
+    free(eval.solutionAry);
+
+    if(!success)
+    {
+        free(interpol.coefAry);
+        free(interpol.errorAry);
+        free(interpol.imagPartAry);
+        tbv_deleteTableOfVariables(pTabOfVars);
+        return false;
+    }
+
+    nsl_numericSolution_t * const pSol = smalloc( sizeof(nsl_numericSolution_t)
+                                                , __FILE__
+                                                , __LINE__
+                                                );
+#ifdef DEBUG
+    ++ _noRefsToObjects;
+#endif
+    pSol->pTableOfVars = pTabOfVars;
+    pSol->numeratorAry = createMatrixOfPolynomials(noDependents, noKnowns);
+
+    /* The determinant is normalized such that its lowest resolved coefficient becomes
+       the coefficient one of s^0. The first circle has at least resolved the dominant
+       coefficient. */
+    double maxImagPart = 0.0;
+    const unsigned int noResolvedCoefs = getResolvedCoefs( &idxFirst
+                                                         , &idxLast
+                                                         , &interpol
+                                                         , /* idxPoly */ 0
+                                                         );
+    assert(noResolvedCoefs > 0);
+    (void)noResolvedCoefs;
+    const signed int powerOfNorm = (signed)idxFirst;
+    const double normalization = interpol.coefAry[idxFirst];
+    createPolynomial( &pSol->determinant
+                    , &interpol
+                    , /* idxPoly */ 0
+                    , /* factor */ 1.0/normalization
+                    , powerOfNorm
+                    , &maxImagPart
+                    );
+
+    unsigned int idxDependent, idxKnown;
+    for(idxDependent=0; idxDependent<noDependents; ++idxDependent)
+    {
+        for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+        {
+            createPolynomial( &pSol->numeratorAry[idxDependent][idxKnown]
+                            , &interpol
+                            , /* idxPoly */ 1 + idxDependent*noKnowns + idxKnown
+                            , /* factor */ 1.0/normalization
+                            , powerOfNorm
+                            , &maxImagPart
+                            );
+        }
+    }
+    free(interpol.coefAry);
+    free(interpol.errorAry);
+    free(interpol.imagPartAry);
+
+    if(maxImagPart > IMAGINARY_PART_THRESHOLD)
+    {
+        LOG_WARN( _log
+                , "The numeric solution of the LES is ill-conditioned. The interpolated"
+                  " coefficients have an imaginary part of up to %g relative to their"
+                  " magnitude. The result may be inaccurate"
+                , maxImagPart
+                )
+    }
+
+    *ppSolution = pSol;
+    return true;
+
+} /* End of nsl_createSolution */
+
+
+
+
+/**
+ * Delete a solution object after use.
+ *   @param pSolution
+ * The object to delete. No action if NULL is passed.
+ */
+
+void nsl_deleteSolution(const nsl_numericSolution_t * const pSolution)
+{
+    if(pSolution == NULL)
+        return;
+
+    const tbv_tableOfVariables_t * const pTabOfVars = pSolution->pTableOfVars;
+    nsl_numericSolution_t * const pSol = (nsl_numericSolution_t*)pSolution;
+    deleteMatrixOfPolynomials( pSol->numeratorAry
+                             , pTabOfVars->noUnknowns
+                               + pTabOfVars->pCircuitNetList->noVoltageDefs
+                             , pTabOfVars->noKnowns
+                             );
+    freePolynomial(&pSol->determinant);
+    tbv_deleteTableOfVariables(pTabOfVars);
+    free(pSol);
+
+#ifdef DEBUG
+    assert(_noRefsToObjects > 0);
+    -- _noRefsToObjects;
+#endif
+} /* End of nsl_deleteSolution */
+
+
+
+
+/**
+ * Derive a user-defined result from a numeric solution. The selection of the transfer
+ * functions is the same as for the frequency domain results of the symbolic solver, see
+ * frq_createFreqDomainSolution.
+ *   @return
+ * \a true if the result could be created, \a false otherwise. An error has been reported
+ * in this case.
+ *   @param ppResult
+ * The new result object is returned in * \a ppResult. It needs to be deleted with
+ * nsl_deleteResult after use. NULL is returned in case of an error.
+ *   @param pSolution
+ * The numeric solution.
+ *   @param idxResult
+ * The index of the user-defined result or -1 for the result of all dependents.
+ */
+
+boolean nsl_createResult( const nsl_numericResult_t * * const ppResult
+                        , const nsl_numericSolution_t * const pSolution
+                        , signed int idxResult
+                        )
+{
+    *ppResult = NULL;
+
+    const tbv_tableOfVariables_t * const pTabOfVars = pSolution->pTableOfVars;
+    const pci_circuit_t * const pNetList = pTabOfVars->pCircuitNetList;
+    const unsigned int noKnowns = pTabOfVars->noKnowns
+                     , noUnknowns = pTabOfVars->noUnknowns;
+
+    nsl_numericResult_t * const pRes = smalloc( sizeof(nsl_numericResult_t)
+                                              , __FILE__
+                                              , __LINE__
+                                              );
+#ifdef DEBUG
+    ++ _noRefsToObjects;
+#endif
+    pRes->pTableOfVars = tbv_cloneByConstReference(pTabOfVars);
+    pRes->idxResult = idxResult;
+
+    /* Numerator and denominator of a transfer function are addressed to by a pair of
+       indexes into the solution; a dependent index of -1 designates the determinant. */
+    const pci_resultDef_t *pResultDef = NULL;
+    boolean isBode = false;
+    signed int idxSolutionNum = -1
+             , idxSolutionDenom = -1;
+    unsigned int idxKnownNum = 0
+               , idxKnownDenom = 0;
+    boolean success = true;
+    if(idxResult >= 0)
+    {
+        assert((unsigned)idxResult < pNetList->noResultDefs);
+        pResultDef = &pNetList->resultDefAry[idxResult];
+        assert(pResultDef->noDependents > 0);
+        pRes->name = pResultDef->name;
+        isBode = pResultDef->independentName != NULL;
+        pRes->noDependents = pResultDef->noDependents;
+        pRes->noIndependents = isBode? 1: noKnowns;
+    }
+    else
+    {
+        pRes->name = "allDependents";
+        pRes->noDependents = noUnknowns + pNetList->noVoltageDefs;
+        pRes->noIndependents = noKnowns;
+    }
+    const unsigned int noDependents = pRes->noDependents
+                     , noIndependents = pRes->noIndependents;
+    pRes->nameOfDependentAry = smalloc( (noDependents > 0? noDependents: 1)*sizeof(char*)
+                                      , __FILE__
+                                      , __LINE__
+                                      );
+    pRes->nameOfIndependentAry = smalloc( (noIndependents > 0? noIndependents: 1)
+                                          * sizeof(char*)
+                                        , __FILE__
+                                        , __LINE__
+                                        );
+    pRes->numeratorAry = createMatrixOfPolynomials(noDependents, noIndependents);
+    pRes->denominator.powerOfS = 0;
+    pRes->denominator.noCoefs = 0;
+    pRes->denominator.coefAry = NULL;
+
+    unsigned int idxDependent, idxKnown;
+    if(isBode)
+    {
+        pRes->nameOfDependentAry[0] = pResultDef->dependentNameAry[0];
+        pRes->nameOfIndependentAry[0] = pResultDef->independentName;
+
+        signed int idxSolutionDependent, idxKnownDependent
+                 , idxSolutionIndependent, idxKnownIndependent;
+        success = findName( &idxSolutionDependent
+                          , &idxKnownDependent
+                          , pTabOfVars
+                          , pResultDef->dependentNameAry[0]
+                          ) == 1
+                  &&  findName( &idxSolutionIndependent
+                              , &idxKnownIndependent
+                              , pTabOfVars
+                              , pResultDef->independentName
+                              ) == 1;
+        if(success)
+        {
+            if(idxSolutionDependent >= 0  &&  idxKnownIndependent >= 0)
+            {
+                idxSolutionNum = idxSolutionDependent;
+                idxKnownNum = (unsigned)idxKnownIndependent;
+            }
+            else if(idxKnownDependent >= 0  &&  idxSolutionIndependent >= 0)
+            {
+                /* The inverse transfer function. */
+                idxSolutionDenom = idxSolutionIndependent;
+                idxKnownDenom = (unsigned)idxKnownDependent;
+            }
+            else if(idxSolutionDependent >= 0  &&  idxSolutionIndependent >= 0)
+            {
+                if(noKnowns == 1)
+                {
+                    idxSolutionNum = idxSolutionDependent;
+                    idxSolutionDenom = idxSolutionIndependent;
+                }
+                else
+                {
+                    success = false;
+                    LOG_ERROR( _log
+                             , "The dependent quantity %s can't be plotted as function"
+                               " of the other dependent quantity %s. Two dependents"
+                               " can be a function of each other only in the case of a"
+                               " single independent quantity. The given system has"
+                               " however %u inputs"
+                             , pResultDef->dependentNameAry[0]
+                             , pResultDef->independentName
+                             , noKnowns
+                             )
+                }
+            }
+            else
+            {
+                success = false;
+                LOG_ERROR( _log
+                         , "The independent quantity %s can't be plotted as function"
+                           " of the other independent quantity %s. Two independents"
+                           " or system inputs must not be specified for"
+                           " a Bode plot result"
+                         , pResultDef->dependentNameAry[0]
+                         , pResultDef->independentName
+                         )
+            }
+        } /* End if(Do the referenced dependent and independent exist?) */
+
+        if(success)
+        {
+            const nsl_polynomial_t * const pNum = idxSolutionNum >= 0
+                                    ? &pSolution->numeratorAry[idxSolutionNum][idxKnownNum]
+                                    : &pSolution->determinant
+                                 , * const pDenom = idxSolutionDenom >= 0
+                                    ? &pSolution->numeratorAry[idxSolutionDenom]
+                                                              [idxKnownDenom]
+                                    : &pSolution->determinant;
+            if(pDenom->noCoefs > 0)
+            {
+                copyPolynomial(&pRes->numeratorAry[0][0], pNum);
+                copyPolynomial(&pRes->denominator, pDenom);
+            }
+            else
+            {
+                success = false;
+                LOG_ERROR( _log
+                         , "The numeric solver can't compute result %s. The denominator"
+                           " of %s as function of %s is null"
+                         , pRes->name
+                         , pResultDef->dependentNameAry[0]
+                         , pResultDef->independentName
+                         )
+            }
+        }
+    }
+    else
+    {
+        /* A full result: All independents are knowns, the denominator is the system
+           determinant. */
+        for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+            pRes->nameOfIndependentAry[idxKnown] = pTabOfVars->knownLookUpAry[idxKnown].name;
+        copyPolynomial(&pRes->denominator, &pSolution->determinant);
+
+        for(idxDependent=0; success && idxDependent<noDependents; ++idxDependent)
+        {
+            signed int idxSolution;
+            if(pResultDef != NULL)
+            {
+                const char * const name = pResultDef->dependentNameAry[idxDependent];
+                signed int idxKnownOfName;
+                pRes->nameOfDependentAry[idxDependent] = name;
+                if(findName(&idxSolution, &idxKnownOfName, pTabOfVars, name) != 1)
+                    success = false;
+                else if(idxSolution < 0)
+                {
+                    success = false;
+                    LOG_ERROR( _log
+                             , "A full result has been requested for quantity %s."
+                               " This is invalid as %s is a known quantity of the"
+                               " system (i.e. a system input)"
+                             , name
+                             , name
+                             )
+                }
+            }
+            else
+            {
+                idxSolution = (signed)idxDependent;
+                pRes->nameOfDependentAry[idxDependent] =
+                        idxDependent < noUnknowns
+                        ? pTabOfVars->unknownLookUpAry[idxDependent].name
+                        : pNetList->voltageDefAry[idxDependent-noUnknowns].name;
+            }
+
+            for(idxKnown=0; success && idxKnown<noKnowns; ++idxKnown)
+            {
+                copyPolynomial( &pRes->numeratorAry[idxDependent][idxKnown]
+                              , &pSolution->numeratorAry[idxSolution][idxKnown]
+                              );
+            }
+        } /* End for(All dependents of the result) */
+    } /* End if(Bode plot or full result?) */
+
+    if(success  &&  noDependents*noIndependents == 0)
+    {
+        success = false;
+        LOG_ERROR( _log
+                 , "The system has an abnormal solution with no independents or no"
+                   " dependents. Result %s can't be computed"
+                 , pRes->name
+                 )
+    }
+
+    if(success)
+        *ppResult = pRes;
+    else
+        nsl_deleteResult(pRes);
+
+    return success;
+
+} /* End of nsl_createResult */
+
+
+
+
+/**
+ * Delete a result object after use.
+ *   @param pResult
+ * The object to delete. No action if NULL is passed.
+ */
+
+void nsl_deleteResult(const nsl_numericResult_t * const pResult)
+{
+    if(pResult == NULL)
+        return;
+
+    nsl_numericResult_t * const pRes = (nsl_numericResult_t*)pResult;
+    deleteMatrixOfPolynomials(pRes->numeratorAry, pRes->noDependents, pRes->noIndependents);
+    freePolynomial(&pRes->denominator);
+    free(pRes->nameOfDependentAry);
+    free(pRes->nameOfIndependentAry);
+    tbv_deleteTableOfVariables(pRes->pTableOfVars);
+    free(pRes);
+
+#ifdef DEBUG
+    assert(_noRefsToObjects > 0);
+    -- _noRefsToObjects;
+#endif
+} /* End of nsl_deleteResult */
+
+
+
+
+/**
+ * Print a numeric result to the application log. The output resembles the one of
+ * frq_logFreqDomainSolution but the coefficients of the polynomials are numbers.
+ *   @param pResult
+ * The result to print.
+ *   @param hLog
+ * The logger to write to.
+ *   @param logLevel
+ * The log level of the output. No output if this level is not enabled.
+ */
+
+void nsl_logResult( const nsl_numericResult_t * const pResult
+                  , log_hLogger_t hLog
+                  , log_logLevel_t logLevel
+                  )
+{
+    if(!log_checkLogLevel(hLog, logLevel))
+        return;
+
+    const boolean isBode = pResult->idxResult >= 0
+                           &&  pResult->pTableOfVars->pCircuitNetList
+                                 ->resultDefAry[pResult->idxResult].independentName != NULL;
+    log_log( hLog
+           , logLevel
+           , "%s %s%s, numeric solution:\n"
+           , pResult->idxResult >= 0? "User-defined result": "Result"
+           , pResult->name
+           , isBode? " (Bode plot)": ""
+           );
+
+    unsigned int idxDependent, idxIndependent;
+    for(idxDependent=0; idxDependent<pResult->noDependents; ++idxDependent)
+    {
+        const char * const nameOfDependent = pResult->nameOfDependentAry[idxDependent];
+        if(isBode)
+        {
+            log_log( hLog
+                   , log_continueLine
+                   , "The dependency of %s on %s:\n"
+                   , nameOfDependent
+                   , pResult->nameOfIndependentAry[0]
+                   );
+        }
+        else
+            log_log(hLog, log_continueLine, "The solution for unknown %s:\n", nameOfDependent);
+
+        log_log(hLog, log_continueLine, "  %s(s) =", nameOfDependent);
+        boolean isFirst = true;
+        for(idxIndependent=0; idxIndependent<pResult->noIndependents; ++idxIndependent)
+        {
+            if(pResult->numeratorAry[idxDependent][idxIndependent].noCoefs == 0)
+                continue;
+            log_log( hLog
+                   , log_continueLine
+                   , "%s N_%s_%s(s)/D(s) * %s(s)"
+                   , isFirst? "": " +"
+                   , nameOfDependent
+                   , pResult->nameOfIndependentAry[idxIndependent]
+                   , pResult->nameOfIndependentAry[idxIndependent]
+                   );
+            isFirst = false;
+        }
+        log_log(hLog, log_continueLine, "%s, with\n", isFirst? " 0": "");
+
+        for(idxIndependent=0; idxIndependent<pResult->noIndependents; ++idxIndependent)
+        {
+            const nsl_polynomial_t * const pNum =
+                                        &pResult->numeratorAry[idxDependent][idxIndependent];
+            if(pNum->noCoefs == 0)
+                continue;
+            char prefix[160];
+            const int lenOfPrefix = snprintf
+                                    ( prefix
+                                    , sizeof(prefix)
+                                    , "    N_%s_%s(s) = "
+                                    , nameOfDependent
+                                    , pResult->nameOfIndependentAry[idxIndependent]
+                                    );
+            log_log(hLog, log_continueLine, "%s", prefix);
+            logPolynomial( hLog
+                         , pNum
+                         , lenOfPrefix > 0  &&  (size_t)lenOfPrefix < sizeof(prefix)
+                           ? (unsigned)lenOfPrefix
+                           : 4
+                         );
+            log_log(hLog, log_continueLine, "\n");
+        }
+    } /* End for(All dependents) */
+
+    log_log(hLog, log_continueLine, "  D(s) = ");
+    logPolynomial(hLog, &pResult->denominator, /* indentation */ 9);
+    log_log(hLog, log_continueLine, "\n");
+    log_flush(hLog);
+
+} /* End of nsl_logResult */
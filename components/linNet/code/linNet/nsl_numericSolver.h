@@ -0,0 +1,154 @@
+#ifndef NSL_NUMERICSOLVER_INCLUDED
+#define NSL_NUMERICSOLVER_INCLUDED
+/**
+ * @file nsl_numericSolver.h
+ * Definition of global interface of module nsl_numericSolver.c
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include "types.h"
+#include "log_logger.h"
+#include "tbv_tableOfVariables.h"
+#include "les_linearEquationSystem.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Global type definitions
+ */
+
+/** A polynomial in s with numeric coefficients. The powers of s may be negative. */
+typedef struct nsl_polynomial_t
+{
+    /** The power of s of the first coefficient. */
+    signed int powerOfS;
+
+    /** The number of coefficients. Null for the null polynomial. */
+    unsigned int noCoefs;
+
+    /** The coefficients of s^powerOfS, s^(powerOfS+1), ... as malloc allocated array or
+        NULL for the null polynomial. The first and the last coefficient are not null. */
+    double *coefAry;
+
+} nsl_polynomial_t;
+
+
+/** The numeric solution of a LES: The system determinant and the numerators of all
+    dependents are polynomials in s, which have been computed for the nominal values of
+    the devices. It is the numeric counterpart of sol_solution_t; the transformation into
+    the frequency domain is already done. */
+typedef struct nsl_numericSolution_t
+{
+    /** The table of variables describes the knowns, unknowns and constants of the problem;
+        among more, their names are found here. */
+    const tbv_tableOfVariables_t *pTableOfVars;
+
+    /** The system determinant and the common denominator of all dependents. It is
+        normalized: Its lowest power of s is null and has the coefficient one. */
+    nsl_polynomial_t determinant;
+
+    /** An array [noDependents, noKnowns] of numerators. The dependents are the unknowns of
+        the LES followed by the user-defined voltages, like in sol_solution_t. */
+    nsl_polynomial_t **numeratorAry;
+
+} nsl_numericSolution_t;
+
+
+/** A user-defined result, which is derived from a numeric solution. It has the same
+    structure as the frequency domain result frq_freqDomainSolution_t: A common denominator
+    and a matrix of numerators, one for each pair of dependent and independent of the
+    result. */
+typedef struct nsl_numericResult_t
+{
+    /** The name of the result. */
+    const char *name;
+
+    /** The table of variables of the solution, which the result is derived from. */
+    const tbv_tableOfVariables_t *pTableOfVars;
+
+    /** The index of the user-defined result in the table of result definitions of the
+        circuit or -1 for the generic result of all dependents. */
+    signed int idxResult;
+
+    /** The number of dependents of the result. */
+    unsigned int noDependents;
+
+    /** The names of the dependents. */
+    const char * *nameOfDependentAry;
+
+    /** The number of independents of the result. */
+    unsigned int noIndependents;
+
+    /** The names of the independents. */
+    const char * *nameOfIndependentAry;
+
+    /** The common denominator of all transfer functions of the result. */
+    nsl_polynomial_t denominator;
+
+    /** An array [noDependents, noIndependents] of numerators. */
+    nsl_polynomial_t **numeratorAry;
+
+} nsl_numericResult_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize the module prior to first use of any of its methods or global data objects. */
+void nsl_initModule(log_hLogger_t hGlobalLogger, unsigned int noThreads);
+
+/** Shutdown of module after use. Release of memory, closing files, etc. */
+void nsl_shutdownModule(void);
+
+/** Compute the numeric solution of a LES by evaluation and interpolation. */
+boolean nsl_createSolution( const nsl_numericSolution_t * * const ppSolution
+                          , les_linearEquationSystem_t * const pLES
+                          );
+
+/** Delete a solution object as got from nsl_createSolution. */
+void nsl_deleteSolution(const nsl_numericSolution_t * const pSolution);
+
+/** Derive a user-defined result from a numeric solution. */
+boolean nsl_createResult( const nsl_numericResult_t * * const ppResult
+                        , const nsl_numericSolution_t * const pSolution
+                        , signed int idxResult
+                        );
+
+/** Delete a result object as got from nsl_createResult. */
+void nsl_deleteResult(const nsl_numericResult_t * const pResult);
+
+/** Print a numeric result to the application log. */
+void nsl_logResult( const nsl_numericResult_t * const pResult
+                  , log_hLogger_t hLog
+                  , log_logLevel_t logLevel
+                  );
+
+#endif  /* NSL_NUMERICSOLVER_INCLUDED */
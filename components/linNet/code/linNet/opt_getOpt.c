@@ -21,6 +21,7 @@
  *   opt_parseCmdLine
  *   opt_echoUserInput
  * Local functions
+ *   parseResourceLimit
  *   checkUserInput
  */
 
@@ -42,6 +43,7 @@
 #endif
 
 #include "lin_linNet.h"
+#include "thp_threadPool.h"
 #include "opt_getOpt.h"
 
 
@@ -51,27 +53,61 @@
 
 #if OPT_USE_POSIX_GETOPT != 0
 # define HELP_TEXT                                                                          \
-"usage: linNet [-hrsci] [-v <logLevel>] [-f <headerFormat>] [-l <logFileName>]"             \
-" [-o <outputPath>] [--] {<circuitFileName>}\n"                                             \
+"usage: linNet [-hrscAibFSIN] [-v <logLevel>] [-p <reportPath>] [-f <headerFormat>]"        \
+" [-l <logFileName>] [-o <outputPath>] [-n <outputPath>] [-k <cachePath>]"                  \
+" [-t <noThreads>] [-j <noJobs>] [-a <errorBound>] [-m <maxNoAddends>]"                     \
+" [-M <maxNoAddends>] [-T <maxTime>] [--] {<circuitFileName>}\n"                            \
 "  h: Print this help and terminate\n"                                                      \
 "  r: Print the software revision and terminate\n"                                          \
 "  v: Verbosity; one out of INFO, RESULT, WARN, ERROR or FATAL. Default is RESULT\n"        \
+"  p: The path where to put a performance report per input file as JSON file. The\n"        \
+"     specified directory needs to exist. Default is not to write a report\n"               \
 "  f: Log entry format, one out of raw, short or long. Default is long\n"                   \
 "  s: Silent. Do not echo results to stdout (but still write into log file)\n"              \
 "  l: Log file name. Default is not to open a log file. Precondition: Either a log file\n"  \
 "     is specified or -s is not given\n"                                                    \
 "  c: Clear log file at the beginning. Default is to append\n"                              \
+"  A: Asynchronous logging. The log is written by a background thread\n"                    \
 "  o: The path where to put the generated Octave code. The specified directory needs to\n"  \
 "     exist. Default is not to generate Octave code\n"                                      \
 "  i: Inhibit copying static Octave scripts. The generated Octave code builds on some\n"    \
 "     common scripts, which are normally copied into the output folder. Use -i to\n"        \
 "     not copy these files into each result\n"                                              \
+"  b: Write the transfer functions as binary data files, which are loaded by the\n"         \
+"     generated Octave code. Large results load much faster. Requires -o\n"                 \
+"  F: Write the transfer functions in factored form into the Octave code, with common\n"    \
+"     sums as intermediate variables. Requires -o, can't be combined with -b\n"             \
+"  n: The path where to put the numerically computed frequency responses as CSV files.\n"   \
+"     The specified directory needs to exist. Default is not to compute them\n"             \
+"  k: The path of a cache of solutions. The solution of a circuit is loaded from the\n"     \
+"     cache if it had been computed before. The specified directory needs to exist.\n"      \
+"     Default is not to use a cache\n"                                                      \
+"  t: The number of threads, which are used by the solver. Default is 1\n"                  \
+"  j: The number of input files, which are processed in parallel. Default is 1\n"           \
+"  a: Approximate the results by dropping insignificant terms. The relative error\n"        \
+"     bound of the coefficients is in the range ]0, 1[, e.g. 1e-3. Default is exact\n"      \
+"     results\n"                                                                            \
+"  m: The maximum number of addends of a coefficient of the LES. Default is no limit\n"     \
+"  M: The maximum number of addends, which a thread of the solver may hold. Default is\n"   \
+"     no limit\n"                                                                           \
+"  T: The maximum computation time of the solver per circuit in s. Default is no limit\n"   \
+"  S: Server mode. Read requests from stdin, each a line {<option>} <circuitFileName>,\n"   \
+"     and answer with a status line on stdout. -o, -n, -p, -k, -i, -b and -F may be\n"      \
+"     given per request. Input files must not be given on the command line\n"               \
+"  I: Incremental mode. The symbolic solution of a circuit is reused for the next\n"        \
+"     circuit or request, which has the same network, e.g. which differs only in its\n"     \
+"     results, voltage definitions or plot information. Not effective with -j\n"            \
+"  N: Numeric solver. The transfer functions are computed as polynomials in s with\n"       \
+"     numeric coefficients for the nominal device values. Can't be combined with -o or\n"   \
+"     -k; -a, -m, -M, -T and -I have no effect\n"                                           \
 "  {<circuitFileName>}: A list of circuit files, each either *.ckt or *.cir. At least\n"    \
-"     one input file needs to be specified\n"
+"     one input file needs to be specified unless -S is given\n"
 #else
 # define HELP_TEXT                                                                          \
-"usage: linNet [-hsci] [-v logLevel] [-f headerFormat] [-l[logFileName]] [-o[outputPath]]"  \
-" [--] {circuitFileName}\n"                                                                 \
+"usage: linNet [-hscAibFSIN] [-v logLevel] [-p[reportPath]] [-f headerFormat]"              \
+" [-l[logFileName]] [-o[outputPath]] [-n[outputPath]] [-k cachePath] [-t noThreads]"        \
+" [-j noJobs] [-a errorBound] [-m maxNoAddends] [-M maxNoAddends] [-T maxTime] [--]"        \
+" {circuitFileName}\n"                                                                      \
 "Options:\n"                                                                                \
 "  -h, --help\n"                                                                            \
 "    Print this help and terminate\n"                                                       \
@@ -80,6 +116,14 @@
 "  -v LEVEL, --verbosity=LEVEL\n"                                                           \
 "    Verbosity of application; LEVEL is one out of INFO, RESULT, WARN, ERROR or FATAL.\n"   \
 "    Default is RESULT\n"                                                                   \
+"  -p[DIRNAME], --performance-report[=DIRNAME]\n"                                           \
+"    Write a performance report per input file. The consumed wall-clock and CPU time\n"     \
+"    of all phases of processing, the numbers of created and cancelled addends and the\n"   \
+"    largest coefficient of each elimination step of the solver and the high-water\n"       \
+"    marks of all heaps are written as a JSON file, which is named after the circuit.\n"    \
+"    The specified directory needs to exist. No report is written if this option is\n"      \
+"    not used. The files are put into the current working directory if the option is\n"     \
+"    used without argument DIRNAME\n"                                                       \
 "  -f FORMAT, --format-of-log-entry=FORMAT\n"                                               \
 "    Log entry format, FORMAT is one out of raw, short or long. Default is long\n"          \
 "  -s, --silent\n"                                                                          \
@@ -95,6 +139,11 @@
 "  -c, --clear-log-file\n"                                                                  \
 "    Clear the log file at the beginning of operation. Default is to append to a possibly\n"\
 "    existing log file\n"                                                                   \
+"  -A, --asynchronous-logging\n"                                                            \
+"    Asynchronous logging. The log entries are formatted by the threads, which produce\n"   \
+"    them, and written into the log files and to the console by a background thread.\n"     \
+"    The processing is not slowed down by the output streams, e.g. at verbosity level\n"    \
+"    DEBUG. The log is completed on fatal errors and at the end of the application\n"       \
 "  -o[DIRNAME], --Octave-output-directory[=DIRNAME]\n"                                      \
 "    The path where to put the generated Octave code. The specified directory needs to\n"   \
 "    exist. No Octave code is generated if this option is not used. The generated code\n"   \
@@ -104,10 +153,85 @@
 "    Inhibit copying static Octave scripts. The generated Octave code builds on some\n"     \
 "    common scripts, which are normally copied into the output folder. Use -i in order\n"   \
 "    to not copy these files into each result folder\n"                                     \
+"  -b, --binary-Octave-data\n"                                                              \
+"    Write the numerators and denominators of the transfer functions as binary data\n"      \
+"    files into the Octave output directory. The generated Octave code loads the binary\n"  \
+"    data instead of containing the expressions, which is much faster for large\n"          \
+"    results. This option requires option -o\n"                                             \
+"  -F, --factored-Octave-code\n"                                                            \
+"    Write the numerators and denominators of the transfer functions in factored form\n"    \
+"    into the generated Octave code. The coefficients are nested according to Horner's\n"   \
+"    scheme and all sums, which are found more than once, are assigned to intermediate\n"   \
+"    variables. This shrinks the code of large results significantly. This option\n"        \
+"    requires option -o and it can't be combined with -b\n"                                 \
+"  -n[DIRNAME], --frequency-response-directory[=DIRNAME]\n"                                 \
+"    The path where to put the numerically computed frequency responses. Magnitude and\n"   \
+"    phase of all transfer functions of a result are written as a CSV file, which is\n"     \
+"    named after circuit and result. Further CSV files hold gains, zeros and poles\n"       \
+"    (*.pz.csv) and step responses (*.step.csv). The specified directory needs to\n"        \
+"    exist. The frequency responses are not computed if this option is not used. The\n"     \
+"    files are put into the current working directory if the option is used without\n"      \
+"    argument DIRNAME\n"                                                                    \
+"  -k DIRNAME, --cache-directory=DIRNAME\n"                                                 \
+"    The path of a cache of symbolic solutions. The solution of a circuit is stored in\n"   \
+"    the cache after its computation. If the same circuit is processed again then its\n"    \
+"    solution is loaded from the cache instead of being computed. A circuit is\n"           \
+"    recognized regardless of comments, white space and numeric values of devices. The\n"   \
+"    specified directory needs to exist. No cache is used if this option is not used\n"     \
+"  -t N, --threads=N\n"                                                                     \
+"    The number of threads, which are used by the solver, in the range 1..256. The\n"       \
+"    results don't depend on the number of threads. Default is 1\n"                         \
+"  -j N, --jobs=N\n"                                                                        \
+"    The number of input files, which are processed in parallel, in the range 1..256.\n"    \
+"    Each of the jobs has its own solver with the number of threads set by -t. If a log\n"  \
+"    file is used then each input file gets its own log file, which is named after the\n"   \
+"    circuit file and which is placed into the Octave output directory or the current\n"    \
+"    working directory. The common log file reports the overall progress only. Input\n"     \
+"    files of same name, e.g. from different directories, would write the same files at\n"  \
+"    the same time; only the first one of them is processed. Default is 1\n"                \
+"  -a BOUND, --approximation=BOUND\n"                                                       \
+"    Approximate the results in the frequency domain. The addends of each coefficient\n"    \
+"    of a numerator or denominator are evaluated for the nominal values of the devices\n"   \
+"    and the least significant addends are dropped as long as their sum stays below the\n"  \
+"    relative error BOUND of the coefficient. BOUND is in the range ]0, 1[, e.g. 1e-3.\n"   \
+"    The symbolic solution and the cache of solutions are not affected. Default is to\n"    \
+"    compute exact results\n"                                                               \
+"  -m N, --max-addends-of-coefficient=N\n"                                                  \
+"    The maximum number of addends of a single coefficient of the LES. The solution of a\n" \
+"    circuit is aborted with an error if a coefficient becomes longer and the next\n"       \
+"    input file is processed. Default is no limit\n"                                        \
+"  -M N, --max-addends=N\n"                                                                 \
+"    The maximum number of addends of coefficients, which each thread of the solver may\n"  \
+"    hold in memory. The solution is aborted if a thread needs more. Default is no\n"       \
+"    limit\n"                                                                               \
+"  -T SEC, --time-limit=SEC\n"                                                              \
+"    The maximum wall-clock time in seconds of the solution of a single circuit. The\n"     \
+"    solution is aborted if it takes longer. Default is no limit\n"                         \
+"  -S, --server\n"                                                                          \
+"    Server mode. The application stays resident and processes the requests read from\n"    \
+"    stdin one after another. A request is a line {OPTION} FILENAME, where FILENAME is\n"   \
+"    the circuit file and OPTION is one out of -o[DIRNAME], -n[DIRNAME], -p[DIRNAME],\n"    \
+"    -kDIRNAME, -i, -b or -F. These options apply to the request only. Each request is\n"   \
+"    answered by a status line on stdout. The server terminates at the end of the\n"        \
+"    input or with the request quit. No input files are given on the command line\n"        \
+"  -I, --incremental\n"                                                                     \
+"    Incremental mode. The symbolic solution of a circuit is kept and reused for the\n"     \
+"    next circuit file or server request, which has the same network: the same\n"           \
+"    nodes and devices. Only the user-defined voltages and results are computed if\n"       \
+"    merely the results, the voltage definitions, the plot information or the device\n"     \
+"    values have been changed. The option has no effect on parallel jobs, see -j\n"         \
+"  -N, --numeric\n"                                                                         \
+"    Numeric solver. The transfer functions are computed as polynomials in s with\n"        \
+"    numeric coefficients for the nominal values of the devices. The LES is evaluated\n"    \
+"    at a set of points in the complex plane and the coefficients are recovered by\n"       \
+"    interpolation. This is much faster than the symbolic solution for large circuits\n"    \
+"    but the results are subject to rounding errors. No Octave code can be generated\n"     \
+"    and no cache can be used, the options -o and -k can't be combined with -N. The\n"      \
+"    options -a, -m, -M, -T and -I have no effect\n"                                        \
 "Input files:\n"                                                                            \
 "  Program arguments, which are neither options nor their arguments are considered input\n" \
 "  files. Pass the names of the circuit files to be processed, each either a *.ckt or a\n"  \
-"  *.cnl file. At least one input file needs to be specified\n"                             \
+"  *.cnl file. At least one input file needs to be specified unless -S is given\n"          \
 "    If the names of input files could clash with options or arguments then separate\n"     \
 "  options and input files in this order by a double hyphen (--)\n"
 #endif /* OPT_USE_POSIX_GETOPT */
@@ -132,6 +256,48 @@
  * Function implementation
  */
 
+/**
+ * Parse the argument of an option, which sets a limit of the resource budget of the
+ * solver. An error message is printed if the argument is not a positive integer number.
+ *   @return
+ * \a true if the argument could be parsed, \a false otherwise.
+ *   @param pLimit
+ * The parsed limit is returned in * \a pLimit. It is not touched in case of errors.
+ *   @param option
+ * The character of the option for error reporting.
+ *   @param arg
+ * The argument of the option.
+ *   @param maxLimit
+ * The greatest permitted value of the limit.
+ */
+
+static boolean parseResourceLimit( unsigned long * const pLimit
+                                 , signed int option
+                                 , const char * const arg
+                                 , unsigned long maxLimit
+                                 )
+{
+    char *pEnd;
+    const unsigned long limit = strtoul(arg, &pEnd, /* base */ 10);
+    if(*arg == '\0'  ||  *pEnd != '\0'  ||  limit < 1  ||  limit > maxLimit
+       ||  !isdigit((unsigned char)*arg)
+      )
+    {
+        fprintf( stderr
+               , "Option -%c requires a positive integer number in the range 1..%lu as"
+                 " argument, got %s\n"
+               , option
+               , maxLimit
+               , arg
+               );
+        return false;
+    }
+    else
+    {
+        *pLimit = limit;
+        return true;
+    }
+} /* End of parseResourceLimit */
 
 
 
@@ -174,8 +340,73 @@ static boolean checkUserInput( boolean parseSuccess
                    );
         }
 
+        /* The binary data files are an alternative representation of the Octave code. */
+        if(parseSuccess
+           &&  pCmdLineOptions->binaryOctaveData
+           &&  pCmdLineOptions->octaveOutputPath == NULL
+          )
+        {
+            parseSuccess = false;
+            fprintf( stderr
+                   , "Binary data files (-b) are written only together with Octave code;"
+                     " please, specify\n"
+                     "the Octave output directory (-o)\n"
+                   );
+        }
+
+        /* The factored form is a representation of the Octave code. */
+        if(parseSuccess
+           &&  pCmdLineOptions->factoredOctaveCode
+           &&  (pCmdLineOptions->octaveOutputPath == NULL
+                ||  pCmdLineOptions->binaryOctaveData
+               )
+          )
+        {
+            parseSuccess = false;
+            fprintf( stderr
+                   , "The factored form (-F) is written only into Octave code; please,"
+                     " specify the\n"
+                     "Octave output directory (-o) and don't combine it with binary data"
+                     " files (-b)\n"
+                   );
+        }
+
+        /* The numeric solver has no symbolic solution, which could be exported as Octave
+           code or stored in the cache. */
+        if(parseSuccess
+           &&  pCmdLineOptions->numericSolver
+           &&  (pCmdLineOptions->octaveOutputPath != NULL
+                ||  pCmdLineOptions->cachePath != NULL
+               )
+          )
+        {
+            parseSuccess = false;
+            fprintf( stderr
+                   , "The numeric solver (-N) can't be combined with Octave code (-o) or a"
+                     " cache of\n"
+                     "solutions (-k); it has no symbolic solution\n"
+                   );
+        }
+
+        /* The server reads its input files from stdin. */
+        if(parseSuccess
+           &&  pCmdLineOptions->serverMode
+           &&  pCmdLineOptions->noInputFiles > 0
+          )
+        {
+            parseSuccess = false;
+            fprintf( stderr
+                   , "Server mode (-S) and input files on the command line cannot be"
+                     " combined; the\n"
+                     "server reads the names of the circuit files from stdin\n"
+                   );
+        }
+
         /* We need at least one file to process. */
-        if(parseSuccess &&  pCmdLineOptions->noInputFiles == 0)
+        if(parseSuccess
+           &&  !pCmdLineOptions->serverMode
+           &&  pCmdLineOptions->noInputFiles == 0
+          )
         {
             parseSuccess = false;
             fprintf( stderr
@@ -234,27 +465,54 @@ boolean opt_parseCmdLine( opt_cmdLineOptions_t * const pCmdLineOptions
     /* The definition of the supported command line options. POSIX doesn't support the
        double colon to make the argument of a short option optional. */
 #if OPT_USE_POSIX_GETOPT != 0
-    const static char * const shortOptionString = "hrsciv:f:l:o:";
+    const static char * const shortOptionString = "hrscAibFSINv:p:f:l:o:n:k:t:j:a:m:M:T:";
 #else
-    const char * const shortOptionString = "hrsciv:f:l::o::";
+    const char * const shortOptionString = "hrscAibFSINv:p::f:l::o::n::k:t:j:a:m:M:T:";
     const struct option longOptionAry[] =
     { {.name = "help", .has_arg = no_argument, .flag = NULL, .val = 'h'}
     , {.name = "version", .has_arg = no_argument, .flag = NULL, .val = 'r'}
     , {.name = "silent", .has_arg = no_argument, .flag = NULL, .val = 's'}
     , {.name = "clear-log-file", .has_arg = no_argument, .flag = NULL, .val = 'c'}
+    , {.name = "asynchronous-logging", .has_arg = no_argument, .flag = NULL, .val = 'A'}
     , { .name = "do-not-copy-common-Octave-code"
       , .has_arg = no_argument
       , .flag = NULL
       , .val = 'i'
       }
+    , {.name = "binary-Octave-data", .has_arg = no_argument, .flag = NULL, .val = 'b'}
+    , {.name = "factored-Octave-code", .has_arg = no_argument, .flag = NULL, .val = 'F'}
+    , {.name = "server", .has_arg = no_argument, .flag = NULL, .val = 'S'}
+    , {.name = "incremental", .has_arg = no_argument, .flag = NULL, .val = 'I'}
+    , {.name = "numeric", .has_arg = no_argument, .flag = NULL, .val = 'N'}
     , {.name = "verbosity", .has_arg = required_argument, .flag = NULL, .val = 'v'}
+    , { .name = "performance-report"
+      , .has_arg = optional_argument
+      , .flag = NULL
+      , .val = 'p'
+      }
     , {.name = "format-of-log-entry", .has_arg = required_argument, .flag = NULL, .val = 'f'}
     , {.name = "log-file-name", .has_arg = optional_argument, .flag = NULL, .val = 'l'}
+    , {.name = "threads", .has_arg = required_argument, .flag = NULL, .val = 't'}
+    , {.name = "jobs", .has_arg = required_argument, .flag = NULL, .val = 'j'}
+    , {.name = "approximation", .has_arg = required_argument, .flag = NULL, .val = 'a'}
+    , { .name = "max-addends-of-coefficient"
+      , .has_arg = required_argument
+      , .flag = NULL
+      , .val = 'm'
+      }
+    , {.name = "max-addends", .has_arg = required_argument, .flag = NULL, .val = 'M'}
+    , {.name = "time-limit", .has_arg = required_argument, .flag = NULL, .val = 'T'}
     , { .name = "Octave-output-directory"
       , .has_arg = optional_argument
       , .flag = NULL
       , .val = 'o'
       }
+    , { .name = "frequency-response-directory"
+      , .has_arg = optional_argument
+      , .flag = NULL
+      , .val = 'n'
+      }
+    , {.name = "cache-directory", .has_arg = required_argument, .flag = NULL, .val = 'k'}
     /* End of list: All null values */
     , {.name = NULL, .has_arg = 0, .flag = NULL, .val = 0}
     };
@@ -263,12 +521,27 @@ boolean opt_parseCmdLine( opt_cmdLineOptions_t * const pCmdLineOptions
     pCmdLineOptions->help = false;
     pCmdLineOptions->showVersion = false;
     pCmdLineOptions->logLevel = NULL;
+    pCmdLineOptions->perfReportPath = NULL; /* NULL means to not write a report. */
     pCmdLineOptions->logFileName = NULL; /* NULL means to not use a log file. */
     pCmdLineOptions->lineFormat = NULL;
     pCmdLineOptions->echoToConsole = true;
     pCmdLineOptions->doAppend = true;
+    pCmdLineOptions->asynchronousLogging = false;
     pCmdLineOptions->octaveOutputPath = NULL; /* NULL means to not generate Octave code. */
     pCmdLineOptions->dontCopyPrivateOctaveScripts = false;
+    pCmdLineOptions->binaryOctaveData = false;
+    pCmdLineOptions->factoredOctaveCode = false;
+    pCmdLineOptions->freqResponsePath = NULL; /* NULL means to not compute the responses. */
+    pCmdLineOptions->cachePath = NULL; /* NULL means to not use a cache of solutions. */
+    pCmdLineOptions->noThreads = 1;
+    pCmdLineOptions->noJobs = 1;
+    pCmdLineOptions->serverMode = false;
+    pCmdLineOptions->incremental = false;
+    pCmdLineOptions->numericSolver = false;
+    pCmdLineOptions->approximationErrorBound = 0.0; /* Null means exact results. */
+    pCmdLineOptions->maxNoAddendsOfCoef = 0; /* Null means no limit. */
+    pCmdLineOptions->maxNoAddendsOfHeap = 0;
+    pCmdLineOptions->maxWallTime = 0;
     pCmdLineOptions->noInputFiles = 0;
     pCmdLineOptions->idxFirstInputFile = UINT_MAX;
 
@@ -307,6 +580,22 @@ boolean opt_parseCmdLine( opt_cmdLineOptions_t * const pCmdLineOptions
             pCmdLineOptions->logLevel = optarg;
             break;
 
+        /* The path where to place the JSON files with the performance reports. */
+        case 'p':
+            /* The option output path has an optional argument. The default value is
+               indicated by the empty string. */
+            if(optarg != NULL)
+                pCmdLineOptions->perfReportPath = optarg;
+            else
+            {
+#if OPT_USE_POSIX_GETOPT != 0
+                /* POSIX doesn't support optional arguments. */
+                assert(false);
+#endif
+                pCmdLineOptions->perfReportPath = "";
+            }
+            break;
+
         /* Line header format. The formats are defined by and passed to module log. */
         case 'f':
             pCmdLineOptions->lineFormat = optarg;
@@ -338,6 +627,11 @@ boolean opt_parseCmdLine( opt_cmdLineOptions_t * const pCmdLineOptions
            pCmdLineOptions->doAppend = false;
            break;
 
+        /* Write the log by a background thread. */
+        case 'A':
+           pCmdLineOptions->asynchronousLogging = true;
+           break;
+
         /* The path where to place the the generated folders with Octave scripting. */
         case 'o':
             /* The option output path has an optional argument. The default value is
@@ -354,11 +648,153 @@ boolean opt_parseCmdLine( opt_cmdLineOptions_t * const pCmdLineOptions
             }
             break;
 
+        /* The path where to place the CSV files with the computed frequency responses. */
+        case 'n':
+            /* The option output path has an optional argument. The default value is
+               indicated by the empty string. */
+            if(optarg != NULL)
+                pCmdLineOptions->freqResponsePath = optarg;
+            else
+            {
+#if OPT_USE_POSIX_GETOPT != 0
+                /* POSIX doesn't support optional arguments. */
+                assert(false);
+#endif
+                pCmdLineOptions->freqResponsePath = "";
+            }
+            break;
+
+        /* The path of the cache of solutions. */
+        case 'k':
+            pCmdLineOptions->cachePath = optarg;
+            break;
+
         /* Inhibit copying common Octave scripts into each result. */
         case 'i':
             pCmdLineOptions->dontCopyPrivateOctaveScripts = true;
             break;
 
+        /* Write the transfer functions as binary data files for the Octave code. */
+        case 'b':
+            pCmdLineOptions->binaryOctaveData = true;
+            break;
+
+        /* Write the transfer functions in factored form into the Octave code. */
+        case 'F':
+            pCmdLineOptions->factoredOctaveCode = true;
+            break;
+
+        /* Run as resident server, which reads its requests from stdin. */
+        case 'S':
+            pCmdLineOptions->serverMode = true;
+            break;
+
+        /* Reuse the solution of the previous circuit if it has the same network. */
+        case 'I':
+            pCmdLineOptions->incremental = true;
+            break;
+
+        /* Use the numeric instead of the symbolic solver. */
+        case 'N':
+            pCmdLineOptions->numericSolver = true;
+            break;
+
+        /* The number of threads of the solver. */
+        case 't':
+        {
+            char *pEnd;
+            const unsigned long noThreads = strtoul(optarg, &pEnd, /* base */ 10);
+            if(*optarg == '\0'  ||  *pEnd != '\0'
+               ||  noThreads < 1  ||  noThreads > THP_MAX_NO_THREADS
+              )
+            {
+                success = false;
+                fprintf( stderr
+                       , "Option -t requires a number of threads in the range 1..%u as"
+                         " argument, got %s\n"
+                       , THP_MAX_NO_THREADS
+                       , optarg
+                       );
+            }
+            else
+                pCmdLineOptions->noThreads = (unsigned int)noThreads;
+            break;
+        }
+
+        /* The number of input files, which are processed in parallel. */
+        case 'j':
+        {
+            char *pEnd;
+            const unsigned long noJobs = strtoul(optarg, &pEnd, /* base */ 10);
+            if(*optarg == '\0'  ||  *pEnd != '\0'
+               ||  noJobs < 1  ||  noJobs > THP_MAX_NO_THREADS
+              )
+            {
+                success = false;
+                fprintf( stderr
+                       , "Option -j requires a number of parallel jobs in the range 1..%u as"
+                         " argument, got %s\n"
+                       , THP_MAX_NO_THREADS
+                       , optarg
+                       );
+            }
+            else
+                pCmdLineOptions->noJobs = (unsigned int)noJobs;
+            break;
+        }
+
+        /* The error bound of the approximated results. */
+        case 'a':
+        {
+            char *pEnd;
+            const double errorBound = strtod(optarg, &pEnd);
+            if(*optarg == '\0'  ||  *pEnd != '\0'
+               ||  !(errorBound > 0.0  &&  errorBound < 1.0)
+              )
+            {
+                success = false;
+                fprintf( stderr
+                       , "Option -a requires a relative error bound in the range ]0, 1[ as"
+                         " argument, got %s\n"
+                       , optarg
+                       );
+            }
+            else
+                pCmdLineOptions->approximationErrorBound = errorBound;
+            break;
+        }
+
+        /* The resource budget of the solver. */
+        case 'm':
+        {
+            unsigned long maxNoAddendsOfCoef;
+            if(parseResourceLimit(&maxNoAddendsOfCoef, c, optarg, UINT_MAX))
+                pCmdLineOptions->maxNoAddendsOfCoef = (unsigned int)maxNoAddendsOfCoef;
+            else
+                success = false;
+            break;
+        }
+        case 'M':
+            if(!parseResourceLimit( &pCmdLineOptions->maxNoAddendsOfHeap
+                                  , c
+                                  , optarg
+                                  , ULONG_MAX
+                                  )
+              )
+            {
+                success = false;
+            }
+            break;
+        case 'T':
+        {
+            unsigned long maxWallTime;
+            if(parseResourceLimit(&maxWallTime, c, optarg, UINT_MAX))
+                pCmdLineOptions->maxWallTime = (unsigned int)maxWallTime;
+            else
+                success = false;
+            break;
+        }
+
         /* Error handling: Check getopt's global variable optopt. */
         case '?':
             success = false;
@@ -385,13 +821,55 @@ boolean opt_parseCmdLine( opt_cmdLineOptions_t * const pCmdLineOptions
                        , optopt
                        );
             }
-            else if(optopt == 'o')
+            else if(optopt == 'o'  ||  optopt == 'p')
             {
                 fprintf( stderr
                        , "Option -%c requires an existing target directory as argument\n"
                        , optopt
                        );
             }
+            else if(optopt == 'k')
+            {
+                fprintf( stderr
+                       , "Option -%c requires an existing cache directory as argument\n"
+                       , optopt
+                       );
+            }
+            else if(optopt == 't')
+            {
+                fprintf( stderr
+                       , "Option -%c requires the number of threads as argument\n"
+                       , optopt
+                       );
+            }
+            else if(optopt == 'j')
+            {
+                fprintf( stderr
+                       , "Option -%c requires the number of parallel jobs as argument\n"
+                       , optopt
+                       );
+            }
+            else if(optopt == 'a')
+            {
+                fprintf( stderr
+                       , "Option -%c requires the relative error bound as argument\n"
+                       , optopt
+                       );
+            }
+            else if(optopt == 'm'  ||  optopt == 'M')
+            {
+                fprintf( stderr
+                       , "Option -%c requires the maximum number of addends as argument\n"
+                       , optopt
+                       );
+            }
+            else if(optopt == 'T')
+            {
+                fprintf( stderr
+                       , "Option -%c requires the maximum computation time as argument\n"
+                       , optopt
+                       );
+            }
             else if(isprint(optopt))
                 fprintf(stderr, "Unknown option -%c\n", optopt);
             else
@@ -436,22 +914,52 @@ void opt_echoUserInput(FILE *stream, const opt_cmdLineOptions_t * const pCmdLine
     fprintf( stream
            , "Help: %s\n"
              "Level of verbosity: %s\n"
+             "Performance report path: %s\n"
              "Log entry format: %s\n"
              "Silent: %s\n"
              "Log file name: %s\n"
              "Clear log: %s\n"
+             "Asynchronous logging: %s\n"
              "Octave output path: %s\n"
              "Inhibit copying common Octave scripts: %s\n"
+             "Binary Octave data: %s\n"
+             "Factored Octave code: %s\n"
+             "Frequency response output path: %s\n"
+             "Cache path: %s\n"
+             "Number of threads: %u\n"
+             "Number of parallel jobs: %u\n"
+             "Server mode: %s\n"
+             "Incremental mode: %s\n"
+             "Numeric solver: %s\n"
+             "Approximation error bound: %g\n"
+             "Maximum number of addends of a coefficient: %u\n"
+             "Maximum number of addends of a thread: %lu\n"
+             "Maximum computation time: %u s\n"
              "Number of input files: %u\n"
              "Index of first program file argument: %u\n"
            , BOOL_STR(pCmdLineOptions->help)
            , CHAR_PTR(pCmdLineOptions->logLevel)
+           , CHAR_PTR(pCmdLineOptions->perfReportPath)
            , CHAR_PTR(pCmdLineOptions->lineFormat)
            , BOOL_STR(!pCmdLineOptions->echoToConsole)
            , CHAR_PTR(pCmdLineOptions->logFileName)
            , BOOL_STR(!pCmdLineOptions->doAppend)
+           , BOOL_STR(pCmdLineOptions->asynchronousLogging)
            , CHAR_PTR(pCmdLineOptions->octaveOutputPath)
            , BOOL_STR(pCmdLineOptions->dontCopyPrivateOctaveScripts)
+           , BOOL_STR(pCmdLineOptions->binaryOctaveData)
+           , BOOL_STR(pCmdLineOptions->factoredOctaveCode)
+           , CHAR_PTR(pCmdLineOptions->freqResponsePath)
+           , CHAR_PTR(pCmdLineOptions->cachePath)
+           , pCmdLineOptions->noThreads
+           , pCmdLineOptions->noJobs
+           , BOOL_STR(pCmdLineOptions->serverMode)
+           , BOOL_STR(pCmdLineOptions->incremental)
+           , BOOL_STR(pCmdLineOptions->numericSolver)
+           , pCmdLineOptions->approximationErrorBound
+           , pCmdLineOptions->maxNoAddendsOfCoef
+           , pCmdLineOptions->maxNoAddendsOfHeap
+           , pCmdLineOptions->maxWallTime
            , pCmdLineOptions->noInputFiles
            , pCmdLineOptions->idxFirstInputFile
            );
@@ -54,6 +54,9 @@ typedef struct opt_cmdLineOptions_t
     /** The verbosity level of logging. */
     const char *logLevel;
 
+    /** The name and path of the output folder for the performance reports. */
+    const char *perfReportPath;
+
     /** The name of the log file. */
     const char *logFileName;
 
@@ -66,6 +69,9 @@ typedef struct opt_cmdLineOptions_t
     /** Logging output is appended to the (existing) log file. */
     boolean doAppend;
 
+    /** The log is written by a background thread. */
+    boolean asynchronousLogging;
+
     /** The name and path of the Octave output folder. */
     const char *octaveOutputPath;
 
@@ -73,6 +79,54 @@ typedef struct opt_cmdLineOptions_t
         scripting. */
     boolean dontCopyPrivateOctaveScripts;
 
+    /** The numerators and denominators of the results are written as binary data files,
+        which are loaded by the generated Octave code. */
+    boolean binaryOctaveData;
+
+    /** The numerators and denominators of the results are written in factored form into
+        the generated Octave code. */
+    boolean factoredOctaveCode;
+
+    /** The name and path of the output folder for the numerically computed frequency
+        responses. */
+    const char *freqResponsePath;
+
+    /** The name and path of the folder, which holds the cache of solutions. */
+    const char *cachePath;
+
+    /** The number of threads, which are used by the solver. */
+    unsigned int noThreads;
+
+    /** The number of input files, which are processed in parallel. */
+    unsigned int noJobs;
+
+    /** The application runs as resident server: It processes the requests read from stdin
+        one after another instead of the input files from the command line. */
+    boolean serverMode;
+
+    /** The solution of a circuit is reused for the next circuit if it has the same
+        network. */
+    boolean incremental;
+
+    /** The transfer functions are computed by the numeric solver instead of the symbolic
+        one. */
+    boolean numericSolver;
+
+    /** The relative error bound of the approximated results in the range ]0, 1[ or null
+        if the results are exact. */
+    double approximationErrorBound;
+
+    /** The maximum number of addends of a coefficient of the LES or null for no limit. */
+    unsigned int maxNoAddendsOfCoef;
+
+    /** The maximum number of addends of coefficients, which a thread of the solver may
+        hold, or null for no limit. */
+    unsigned long maxNoAddendsOfHeap;
+
+    /** The maximum wall-clock time in seconds of the solution of a circuit or null for no
+        limit. */
+    unsigned int maxWallTime;
+
     /** The number of input files. */
     unsigned int noInputFiles;
 
@@ -0,0 +1,207 @@
+/**
+ * @file ost_outputStream.c
+ *   A buffered output stream for the generation of large text files. The results of a
+ * circuit are rendered in tiny fragments of text; single characters, names and numbers.
+ * For large results, the generated text reaches tens of Megabyte. Writing each fragment
+ * through the stdio library costs much more time than the computation of the result. The
+ * output stream collects the fragments in a large buffer and formats characters, strings
+ * and integer numbers without the printf machinery.
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   ost_initOutputStream
+ *   ost_flush
+ *   ost_closeOutputStream
+ *   ost_printf
+ * Local functions
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <assert.h>
+
+#include "types.h"
+#include "smalloc.h"
+#include "ost_outputStream.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Initialize an output stream prior to its first use.
+ *   @param pStream
+ * The output stream object to initialize. It needs to be closed with \a
+ * ost_closeOutputStream after use.
+ *   @param hFile
+ * The stdio stream, which receives the output. The stdio stream is not owned by the output
+ * stream; it isn't closed by ost_closeOutputStream.
+ */
+
+void ost_initOutputStream(ost_outputStream_t * const pStream, FILE * const hFile)
+{
+    assert(hFile != NULL);
+    pStream->hFile = hFile;
+    pStream->bufferAry = smalloc(OST_SIZE_OF_BUFFER, __FILE__, __LINE__);
+    pStream->noChars = 0;
+    pStream->isError = false;
+
+} /* End of ost_initOutputStream */
+
+
+
+
+/**
+ * Write all buffered text of an output stream into its stdio stream. Use this function
+ * before writing to the stdio stream by other means.
+ *   @return
+ * \a false if any write operation into the stdio stream failed since the output stream has
+ * been initialized, \a true otherwise.
+ *   @param pStream
+ * The output stream.
+ */
+
+boolean ost_flush(ost_outputStream_t * const pStream)
+{
+    if(pStream->noChars > 0)
+    {
+        if(fwrite(pStream->bufferAry, 1, pStream->noChars, pStream->hFile)
+           != pStream->noChars
+          )
+        {
+            pStream->isError = true;
+        }
+        pStream->noChars = 0;
+    }
+
+    return !pStream->isError;
+
+} /* End of ost_flush */
+
+
+
+
+/**
+ * Flush an output stream and release its buffer after use. The stdio stream is flushed,
+ * too, but it is not closed.
+ *   @return
+ * \a false if any write operation failed, \a true otherwise.
+ *   @param pStream
+ * The output stream.
+ */
+
+boolean ost_closeOutputStream(ost_outputStream_t * const pStream)
+{
+    boolean success = ost_flush(pStream);
+    if(fflush(pStream->hFile) != 0)
+        success = false;
+
+    free(pStream->bufferAry);
+    pStream->bufferAry = NULL;
+    pStream->hFile = NULL;
+
+    return success;
+
+} /* End of ost_closeOutputStream */
+
+
+
+
+/**
+ * Write formatted text into an output stream. This function uses the printf formatting of
+ * the C library. It should be used for the less frequent, complex output only, like
+ * floating point numbers or padded fields.
+ *   @return
+ * Get the number of written characters.
+ *   @param pStream
+ * The output stream.
+ *   @param fmt
+ * The printf like format string.
+ *   @param ...
+ * The arguments of the format string.
+ */
+
+unsigned int ost_printf(ost_outputStream_t * const pStream, const char * const fmt, ...)
+{
+    /* Try to format the output into the free space of the buffer. If it doesn't fit then
+       the buffer is flushed and the formatting is repeated with the empty buffer. Some
+       implementations of vsnprintf return a negative value if the output is truncated;
+       this is handled like too long output. */
+    va_list argptr;
+    va_start(argptr, fmt);
+    signed int noChars = vsnprintf( &pStream->bufferAry[pStream->noChars]
+                                  , OST_SIZE_OF_BUFFER - pStream->noChars
+                                  , fmt
+                                  , argptr
+                                  );
+    va_end(argptr);
+
+    if(noChars < 0  ||  (unsigned)noChars >= OST_SIZE_OF_BUFFER - pStream->noChars)
+    {
+        ost_flush(pStream);
+        va_start(argptr, fmt);
+        noChars = vsnprintf(pStream->bufferAry, OST_SIZE_OF_BUFFER, fmt, argptr);
+        va_end(argptr);
+
+        if(noChars < 0  ||  (unsigned)noChars >= OST_SIZE_OF_BUFFER)
+        {
+            /* Very long output bypasses the buffer. */
+            va_start(argptr, fmt);
+            noChars = vfprintf(pStream->hFile, fmt, argptr);
+            va_end(argptr);
+            if(noChars < 0)
+            {
+                pStream->isError = true;
+                return 0;
+            }
+            return (unsigned)noChars;
+        }
+    }
+
+    /* The terminating zero of vsnprintf is not part of the output; it is overwritten by
+       the next output. */
+    pStream->noChars += (unsigned)noChars;
+    return (unsigned)noChars;
+
+} /* End of ost_printf */
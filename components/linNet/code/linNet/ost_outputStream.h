@@ -0,0 +1,310 @@
+#ifndef OST_OUTPUTSTREAM_INCLUDED
+#define OST_OUTPUTSTREAM_INCLUDED
+/**
+ * @file ost_outputStream.h
+ * Definition of global interface of module ost_outputStream.c
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "types.h"
+
+
+/*
+ * Defines
+ */
+
+/** The size in Byte of the buffer of an output stream. */
+#define OST_SIZE_OF_BUFFER  (1024u*1024u)
+
+/** The maximum number of characters of a formatted integer number, including the sign. */
+#define OST_MAX_LEN_OF_INTEGER  24u
+
+
+/*
+ * Global type definitions
+ */
+
+/** An output stream collects the written text in a large buffer and passes it on to an
+    stdio stream in big chunks. The characters and numbers are formatted without the
+    printf machinery of the C library; only rarely used, complex formatting falls back to
+    the library.\n
+      The stdio stream must not be used directly as long as the output stream owns
+    buffered text. Call ost_flush before. */
+typedef struct ost_outputStream_t
+{
+    /** The stdio stream, which receives the output. */
+    FILE *hFile;
+
+    /** The buffer of #OST_SIZE_OF_BUFFER characters. */
+    char *bufferAry;
+
+    /** The number of buffered characters. */
+    unsigned int noChars;
+
+    /** \a true if writing to the stdio stream failed at least once. */
+    boolean isError;
+
+} ost_outputStream_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize an output stream, which writes into an stdio stream. */
+void ost_initOutputStream(ost_outputStream_t * const pStream, FILE * const hFile);
+
+/** Write the buffered text of an output stream into its stdio stream. */
+boolean ost_flush(ost_outputStream_t * const pStream);
+
+/** Flush an output stream and release its buffer after use. */
+boolean ost_closeOutputStream(ost_outputStream_t * const pStream);
+
+/** Write formatted text into an output stream using the printf formatting. */
+unsigned int ost_printf(ost_outputStream_t * const pStream, const char * const fmt, ...);
+
+
+/*
+ * Global inline interface
+ */
+
+/**
+ * Ensure that the buffer of an output stream has room for some more characters. The
+ * buffered text is flushed if required.
+ *   @param pStream
+ * The output stream.
+ *   @param noChars
+ * The number of characters, which are going to be written. Not more than
+ * #OST_SIZE_OF_BUFFER.
+ */
+
+static inline void ost_reserve(ost_outputStream_t * const pStream, unsigned int noChars)
+{
+    assert(noChars <= OST_SIZE_OF_BUFFER);
+    if(pStream->noChars + noChars > OST_SIZE_OF_BUFFER)
+        ost_flush(pStream);
+
+} /* End of ost_reserve */
+
+
+
+
+/**
+ * Write a single character into an output stream.
+ *   @return
+ * Get the number of written characters, which is one.
+ *   @param pStream
+ * The output stream.
+ *   @param c
+ * The character.
+ */
+
+static inline unsigned int ost_putChar(ost_outputStream_t * const pStream, char c)
+{
+    ost_reserve(pStream, 1);
+    pStream->bufferAry[pStream->noChars++] = c;
+    return 1;
+
+} /* End of ost_putChar */
+
+
+
+
+/**
+ * Write a sequence of bytes into an output stream. This is the output function of choice
+ * for binary data.
+ *   @return
+ * Get the number of written bytes.
+ *   @param pStream
+ * The output stream.
+ *   @param data
+ * The bytes to write.
+ *   @param noBytes
+ * The number of bytes.
+ */
+
+static inline unsigned int ost_putBytes( ost_outputStream_t * const pStream
+                                       , const void * const data
+                                       , unsigned int noBytes
+                                       )
+{
+    if(noBytes <= OST_SIZE_OF_BUFFER)
+    {
+        ost_reserve(pStream, noBytes);
+        memcpy(&pStream->bufferAry[pStream->noChars], data, noBytes);
+        pStream->noChars += noBytes;
+    }
+    else
+    {
+        /* Data longer than the whole buffer is written directly. */
+        ost_flush(pStream);
+        if(fwrite(data, 1, noBytes, pStream->hFile) != noBytes)
+            pStream->isError = true;
+    }
+    return noBytes;
+
+} /* End of ost_putBytes */
+
+
+
+
+/**
+ * Write a character string into an output stream.
+ *   @return
+ * Get the number of written characters.
+ *   @param pStream
+ * The output stream.
+ *   @param str
+ * The zero terminated string.
+ */
+
+static inline unsigned int ost_putString( ost_outputStream_t * const pStream
+                                        , const char *str
+                                        )
+{
+    return ost_putBytes(pStream, str, (unsigned int)strlen(str));
+
+} /* End of ost_putString */
+
+
+
+
+/**
+ * Write a number of blanks into an output stream.
+ *   @return
+ * Get the number of written characters.
+ *   @param pStream
+ * The output stream.
+ *   @param noBlanks
+ * The number of blanks.
+ */
+
+static inline unsigned int ost_putBlanks( ost_outputStream_t * const pStream
+                                        , unsigned int noBlanks
+                                        )
+{
+    unsigned int u;
+    for(u=0; u<noBlanks; ++u)
+        ost_putChar(pStream, ' ');
+    return noBlanks;
+
+} /* End of ost_putBlanks */
+
+
+
+
+/**
+ * Write an unsigned integer number in decimal representation into an output stream. The
+ * output is identical to printf's %lu.
+ *   @return
+ * Get the number of written characters.
+ *   @param pStream
+ * The output stream.
+ *   @param value
+ * The number.
+ */
+
+static inline unsigned int ost_putUnsigned( ost_outputStream_t * const pStream
+                                          , unsigned long value
+                                          )
+{
+    /* The digits are produced from the least significant one upwards. */
+    char digitAry[OST_MAX_LEN_OF_INTEGER];
+    char *pDigit = &digitAry[OST_MAX_LEN_OF_INTEGER];
+    do
+    {
+        *--pDigit = (char)('0' + value%10);
+        value /= 10;
+    }
+    while(value != 0);
+
+    const unsigned int len = (unsigned int)(&digitAry[OST_MAX_LEN_OF_INTEGER] - pDigit);
+    ost_reserve(pStream, len);
+    memcpy(&pStream->bufferAry[pStream->noChars], pDigit, len);
+    pStream->noChars += len;
+    return len;
+
+} /* End of ost_putUnsigned */
+
+
+
+
+/**
+ * Write the magnitude of a signed integer number in decimal representation into an output
+ * stream. The magnitude is computed in unsigned arithmetics; this is well defined for the
+ * most negative number, too. Callers, which print a sign on their own, should use this
+ * function rather than passing a signed absolute value to ost_putSigned.
+ *   @return
+ * Get the number of written characters.
+ *   @param pStream
+ * The output stream.
+ *   @param value
+ * The number, whose magnitude is written.
+ */
+
+static inline unsigned int ost_putMagnitude( ost_outputStream_t * const pStream
+                                           , signed long value
+                                           )
+{
+    return ost_putUnsigned( pStream
+                          , value < 0? 0ul - (unsigned long)value: (unsigned long)value
+                          );
+
+} /* End of ost_putMagnitude */
+
+
+
+
+/**
+ * Write a signed integer number in decimal representation into an output stream. The
+ * output is identical to printf's %ld.
+ *   @return
+ * Get the number of written characters.
+ *   @param pStream
+ * The output stream.
+ *   @param value
+ * The number.
+ */
+
+static inline unsigned int ost_putSigned( ost_outputStream_t * const pStream
+                                        , signed long value
+                                        )
+{
+    if(value < 0)
+    {
+        ost_putChar(pStream, '-');
+        return 1 + ost_putMagnitude(pStream, value);
+    }
+    else
+        return ost_putUnsigned(pStream, (unsigned long)value);
+
+} /* End of ost_putSigned */
+
+#endif  /* OST_OUTPUTSTREAM_INCLUDED */
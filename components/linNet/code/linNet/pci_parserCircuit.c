@@ -26,17 +26,27 @@
  *   pci_initModule
  *   pci_shutdownModule
  *   pci_parseCircuitFile
+ *   pci_parseCircuitBuffer
  *   pci_cloneByConstReference
  *   pci_deleteParseResult
  *   pci_getNameOfDeviceType
+ *   pci_getHashOfCircuit
+ *   pci_getHashOfNetwork
  *   pci_exportPlotInfoAsMCode
  * Local functions
  *   openInput
  *   createParseResult
+ *   growArray
+ *   hashName
+ *   initNameIndex
+ *   deleteNameIndex
+ *   addToNameIndex
  *   getToken
  *   enterNode
  *   deviceTypeToString
  *   findDevice
+ *   findDeviceByName
+ *   findNodeByName
  *   sync
  *   parseListOfNodes
  *   enterDeviceDef
@@ -49,9 +59,20 @@
  *   parsePlotInfo
  *   parseIdentifier
  *   parseVoltageDefintion
+ *   openResultDef
+ *   addDependent
  *   parseResultDefintion
+ *   createNameInInstance
+ *   parseSubcircuitInstance
+ *   parseSubcircuitDef
  *   checkNodeReference
  *   checkNodeReferences
+ *   checkReferenceOfNode
+ *   findReducibleInstances
+ *   parseCircuit
+ *   hashValue
+ *   hashString
+ *   hashNetwork
  */
 
 /*
@@ -78,6 +99,25 @@
  * Defines
  */
 
+/** The initial number of elements of the growable arrays of the parse result. */
+#define MIN_SIZE_OF_ARRAY       8
+
+/** The initial number of slots of the hash table of a name index. A power of two. */
+#define MIN_SIZE_OF_NAME_INDEX  16
+
+/** The value of an unused slot of the hash table of a name index. */
+#define NAME_INDEX_EMPTY_SLOT   (UINT_MAX)
+
+/** The names of the nodes and devices of a subcircuit instance are derived from the name
+    of the instance and the names in the subcircuit definition. This is the separator
+    between both parts. */
+#define SEPARATOR_INSTANCE_NAME "_"
+
+/** The prefix, which the LES uses to derive the name of an unknown voltage from a node's
+    name. It needs to be identical to the definition in les_linearEquationSystem.c; the
+    result definitions reference node voltages by the names of these unknowns. */
+#define SYMBOL_PREFIX_VOLTAGE   "U_"
+
 
 /*
  * Local type definitions
@@ -94,9 +134,42 @@ enum { tokenTypePlotInfo = tok_tokenType_firstCustomToken
      , tokenTypeVoltageDef
      , tokenTypeResultDef
      , tokenTypeBodeResultDef
+     , tokenTypeSubcircuitDef
+     , tokenTypeSubcircuitEnd
      };
 
 
+/** A slot of the hash table of a name index. */
+typedef struct
+{
+    /** The hash code of the name, see hashName(). */
+    unsigned int hash;
+
+    /** The index of the named object into its array in the parse result or
+        #NAME_INDEX_EMPTY_SLOT if the slot is unused. */
+    unsigned int idx;
+
+} nameIndexSlot_t;
+
+
+/** A name index maps the names of the nodes or devices onto their indexes into the
+    according array of the parse result. It is a hash table with open addressing and
+    linear probing. The lookup by name doesn't depend on the number of objects; parsing
+    stays linear in the size of the circuit, even for large, generated circuits. */
+typedef struct
+{
+    /** The number of slots of the hash table. A power of two. */
+    unsigned int noSlots;
+
+    /** The number of used slots. The load factor is kept below one half. */
+    unsigned int noEntries;
+
+    /** The hash table of \a noSlots slots. */
+    nameIndexSlot_t *slotAry;
+
+} nameIndex_t;
+
+
 /*
  * Local prototypes
  */
@@ -108,37 +181,47 @@ static boolean getToken();
  * Data definitions
  */
 
-/** A global logger object is referenced from anywhere for writing progress messages. */
-static log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+/** A global logger object is referenced from anywhere for writing progress messages.
+      @remark The state of the parser is held in thread-local variables; the jobs of a
+    parallel batch run can parse their circuit files at the same time. */
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
 
 /** For simplicity all functions read the next input token from a global stream object. */
-static tok_hTokenStream_t _hTokenStream = TOK_HANDLE_TO_INVALID_TOKEN_STREAM;
+static THREAD_LOCAL tok_hTokenStream_t _hTokenStream = TOK_HANDLE_TO_INVALID_TOKEN_STREAM;
 
 /** For simplicity all functions find the current input token in a global object. */
-static tok_token_t _token = TOK_UNINITIALIZED_TOKEN;
+static THREAD_LOCAL tok_token_t _token = TOK_UNINITIALIZED_TOKEN;
 
 /** The overall parse result can be accessed from any nested sub-routine. We use a global
     variable to implement this. */
-static boolean _parseError = false;
+static THREAD_LOCAL boolean _parseError = false;
 
 /** The parser still supports an old-fashioned style of circuit input files, which is
     compatible with the net list of an early release of the simulation tool SPICE.\n
       At run-time, this flag indicates to the parser's sub-routines, which input format to
     support. true means the new, standard format. */
-static boolean _isStdFormat = false;
+static THREAD_LOCAL boolean _isStdFormat = false;
 
 /* The number of voltage sources needs to be one and only one in the elder format; there it
    is the system input definition (i.e. the only independent of the only result) at the
    same time. This global variable is used to count the parsed definitions. */
-static unsigned int _noOldStyleInputDefs = 0;
+static THREAD_LOCAL unsigned int _noOldStyleInputDefs = 0;
 
 /** The parser is case insenitive for the elder format and case sensitive for the standard
     format. This is handled by using this global function pointer for all string tests. */
-static signed int (*_strcmp)(const char *str1, const char *str2) = NULL;
+static THREAD_LOCAL signed int (*_strcmp)(const char *str1, const char *str2) = NULL;
+
+/** The index of the names of all nodes of the parse result. It is used during parsing
+    only. */
+static THREAD_LOCAL nameIndex_t _nodeNameIndex = {.noSlots = 0, .slotAry = NULL};
+
+/** The index of the names of all devices of the parse result. It is used during parsing
+    only. */
+static THREAD_LOCAL nameIndex_t _deviceNameIndex = {.noSlots = 0, .slotAry = NULL};
 
 #ifdef DEBUG
 /** A global counter of all references to any created objects. Used to detect memory leaks. */
-static unsigned int _noRefsToObjects = 0;
+static THREAD_LOCAL unsigned int _noRefsToObjects = 0;
 #endif
 
 /*
@@ -147,17 +230,26 @@ static unsigned int _noRefsToObjects = 0;
 
 
 /**
- * Open (or close) the input file.
+ * Open (or close) the input file or buffer.
  *   @return
  * True if streams could be initialized as wanted, else false.
  *   @param fileName
- * Name of circuit file to be opened and parsed.
+ * Name of circuit file to be opened and parsed. If \a netlist is not NULL then it is
+ * the name of the circuit, which is used for logging only.
+ *   @param netlist
+ * The circuit as text in memory or NULL if the file \a fileName is parsed.
+ *   @param sizeOfNetlist
+ * The number of characters in \a netlist. Not used if \a netlist is NULL.
  *   @param open
  * Boolean flag. Pass true to open the streams and - after parsing - call again and pass
  * false to close the input file.
  */
 
-static boolean openInput(const char * const fileName, boolean open)
+static boolean openInput( const char * const fileName
+                        , const char * const netlist
+                        , size_t sizeOfNetlist
+                        , boolean open
+                        )
 {
     if(open)
     {
@@ -178,6 +270,8 @@ static boolean openInput(const char * const fileName, boolean open)
             {"LOG",  tokenTypePlotLogAxis},
             {"DEC",  tokenTypePlotLogAxisOld},
             {"LIN",  tokenTypePlotLinAxis},
+            {"SUBCKT", tokenTypeSubcircuitDef},
+            {"ENDS",   tokenTypeSubcircuitEnd},
             {";",    tok_tokenTypeEndOfLine},
         };
 
@@ -192,13 +286,27 @@ static boolean openInput(const char * const fileName, boolean open)
 
         /* Open the token stream. No object is returned if this fails. */
         char *errMsg;
-        boolean success = tok_createTokenStream( &_hTokenStream
-                                               , &errMsg
-                                               , fileName
-                                               , hStream
-                                               , /* customGetChar */ NULL
-                                               , &tokenDescriptorTable
-                                               );
+        boolean success;
+        if(netlist != NULL)
+        {
+            success = tok_createTokenStreamOnBuffer( &_hTokenStream
+                                                   , &errMsg
+                                                   , fileName
+                                                   , netlist
+                                                   , sizeOfNetlist
+                                                   , &tokenDescriptorTable
+                                                   );
+        }
+        else
+        {
+            success = tok_createTokenStream( &_hTokenStream
+                                           , &errMsg
+                                           , fileName
+                                           , hStream
+                                           , /* customGetChar */ NULL
+                                           , &tokenDescriptorTable
+                                           );
+        }
         if(success)
         {
             assert(errMsg == NULL);
@@ -247,10 +355,25 @@ static pci_circuit_t *createParseResult()
     ++ _noRefsToObjects;
 #endif
 
+    /* The arrays are allocated on demand, when the first element is entered. */
     pParseResult->noNodes = 0;
+    pParseResult->maxNoNodes = 0;
+    pParseResult->nodeNameAry = NULL;
     pParseResult->noDevices = 0;
+    pParseResult->maxNoDevices = 0;
+    pParseResult->pDeviceAry = NULL;
     pParseResult->noVoltageDefs = 0;
+    pParseResult->maxNoVoltageDefs = 0;
+    pParseResult->voltageDefAry = NULL;
     pParseResult->noResultDefs = 0;
+    pParseResult->maxNoResultDefs = 0;
+    pParseResult->resultDefAry = NULL;
+    pParseResult->noSubcircuitDefs = 0;
+    pParseResult->maxNoSubcircuitDefs = 0;
+    pParseResult->subcircuitDefAry = NULL;
+    pParseResult->noSubcircuitInstances = 0;
+    pParseResult->maxNoSubcircuitInstances = 0;
+    pParseResult->subcircuitInstanceAry = NULL;
 
     return pParseResult;
 
@@ -259,6 +382,167 @@ static pci_circuit_t *createParseResult()
 
 
 
+/**
+ * Ensure that a growable array has room for at least one more element. The size of a full
+ * array is doubled.
+ *   @return
+ * Get the pointer to the array. It may differ from \a pAry. The contents of the first \a
+ * noElements elements are preserved.
+ *   @param pAry
+ * The pointer to the malloc allocated array or NULL if it has not been allocated yet.
+ *   @param pMaxNoElements
+ * The number of allocated elements of the array is passed in \a * pMaxNoElements. It is
+ * updated if the array grows.
+ *   @param noElements
+ * The number of elements in use.
+ *   @param sizeOfElement
+ * The size of an element of the array in Byte.
+ */
+
+static void *growArray( void * const pAry
+                      , unsigned int * const pMaxNoElements
+                      , unsigned int noElements
+                      , size_t sizeOfElement
+                      )
+{
+    assert(noElements <= *pMaxNoElements  &&  (pAry != NULL || *pMaxNoElements == 0));
+    if(noElements < *pMaxNoElements)
+        return pAry;
+
+    const unsigned int maxNoElements = *pMaxNoElements == 0
+                                       ? MIN_SIZE_OF_ARRAY
+                                       : 2 * *pMaxNoElements;
+    assert(maxNoElements > *pMaxNoElements);
+    *pMaxNoElements = maxNoElements;
+    return srealloc(pAry, maxNoElements*sizeOfElement, __FILE__, __LINE__);
+
+} /* End of growArray */
+
+
+
+
+/**
+ * Compute the hash code of a name of a node or device. The FNV-1a hash algorithm of 32 Bit
+ * is applied. The elder format is case insensitive, see \a _strcmp; here, the characters
+ * are hashed in lower case so that names, which compare equal have the same hash code.
+ *   @return
+ * Get the hash code.
+ *   @param name
+ * The hashed name.
+ */
+
+static unsigned int hashName(const char *name)
+{
+    unsigned int hash = 2166136261u;
+    while(*name != '\0')
+    {
+        const unsigned char c = (unsigned char)*name++;
+        hash = (hash ^ (_isStdFormat? c: (unsigned char)tolower(c))) * 16777619u;
+    }
+    return hash;
+
+} /* End of hashName */
+
+
+
+
+/**
+ * Initialize an empty name index.
+ *   @param pIndex
+ * The pointer to the initialized object. After use, it needs to be freed with
+ * deleteNameIndex().
+ */
+
+static void initNameIndex(nameIndex_t * const pIndex)
+{
+    pIndex->noSlots = MIN_SIZE_OF_NAME_INDEX;
+    pIndex->noEntries = 0;
+    pIndex->slotAry = smalloc(pIndex->noSlots*sizeof(nameIndexSlot_t), __FILE__, __LINE__);
+
+    unsigned int idxSlot;
+    for(idxSlot=0; idxSlot<pIndex->noSlots; ++idxSlot)
+        pIndex->slotAry[idxSlot].idx = NAME_INDEX_EMPTY_SLOT;
+
+} /* End of initNameIndex */
+
+
+
+
+/**
+ * Free the memory of a name index after use.
+ *   @param pIndex
+ * The pointer to the object, which had been initialized with initNameIndex().
+ */
+
+static void deleteNameIndex(nameIndex_t * const pIndex)
+{
+    free(pIndex->slotAry);
+    pIndex->slotAry = NULL;
+    pIndex->noSlots = 0;
+    pIndex->noEntries = 0;
+
+} /* End of deleteNameIndex */
+
+
+
+
+/**
+ * Enter another name into a name index. The name is not checked for uniqueness; a name,
+ * which is entered repeatedly will be found repeatedly when searching the index. The hash
+ * table is doubled in size and rehashed if its load factor would exceed one half.
+ *   @param pIndex
+ * The pointer to the name index.
+ *   @param hash
+ * The hash code of the name as got from hashName().
+ *   @param idx
+ * The index of the named object into its array in the parse result.
+ */
+
+static void addToNameIndex(nameIndex_t * const pIndex, unsigned int hash, unsigned int idx)
+{
+    assert(idx != NAME_INDEX_EMPTY_SLOT  &&  pIndex->slotAry != NULL);
+
+    unsigned int mask = pIndex->noSlots - 1
+               , idxSlot;
+    if(2*(pIndex->noEntries+1) > pIndex->noSlots)
+    {
+        /* Rehash: All entries are moved into the table of doubled size. */
+        nameIndexSlot_t * const oldSlotAry = pIndex->slotAry;
+        const unsigned int oldNoSlots = pIndex->noSlots;
+        pIndex->noSlots *= 2;
+        mask = pIndex->noSlots - 1;
+        pIndex->slotAry = smalloc( pIndex->noSlots*sizeof(nameIndexSlot_t)
+                                 , __FILE__
+                                 , __LINE__
+                                 );
+        for(idxSlot=0; idxSlot<pIndex->noSlots; ++idxSlot)
+            pIndex->slotAry[idxSlot].idx = NAME_INDEX_EMPTY_SLOT;
+
+        unsigned int idxOldSlot;
+        for(idxOldSlot=0; idxOldSlot<oldNoSlots; ++idxOldSlot)
+        {
+            if(oldSlotAry[idxOldSlot].idx != NAME_INDEX_EMPTY_SLOT)
+            {
+                idxSlot = oldSlotAry[idxOldSlot].hash & mask;
+                while(pIndex->slotAry[idxSlot].idx != NAME_INDEX_EMPTY_SLOT)
+                    idxSlot = (idxSlot+1) & mask;
+                pIndex->slotAry[idxSlot] = oldSlotAry[idxOldSlot];
+            }
+        }
+        free(oldSlotAry);
+    }
+
+    idxSlot = hash & mask;
+    while(pIndex->slotAry[idxSlot].idx != NAME_INDEX_EMPTY_SLOT)
+        idxSlot = (idxSlot+1) & mask;
+    pIndex->slotAry[idxSlot] = (nameIndexSlot_t){.hash = hash, .idx = idx};
+    ++ pIndex->noEntries;
+
+} /* End of addToNameIndex */
+
+
+
+
 /**
  * Read the next token from the input stream into the global variable. Emit an error
  * message if this fails.
@@ -316,8 +600,7 @@ static void sync()
  *   @return
  * True if returned index is valid, otherwise false.
  *   @param pIdxNode
- * The index of the node in the array of all nodes is written into \a * pIdxNode. Or
- * PCI_NULL_NODE if the maximum number of supported nodes has been exceeded.
+ * The index of the node in the array of all nodes is written into \a * pIdxNode.
  *   @param pParseResult
  * The parse result as known so far.
  *   @param nodeName
@@ -336,36 +619,36 @@ static boolean enterNode( unsigned int *pIdxNode
 {
     assert(_parseError == false);
 
-    /* No need to ever have something different as linear search: The number of actually
-       possible nodes is very low. */
-    unsigned int idxNode;
-    for(idxNode=0; idxNode<pParseResult->noNodes; ++idxNode)
+    /* Generated circuits can have thousands of nodes; the node is looked up in the hash
+       table of all node names. */
+    const unsigned int hash = hashName(nodeName)
+                     , mask = _nodeNameIndex.noSlots - 1;
+    unsigned int idxSlot = hash & mask
+               , idxNode;
+    while((idxNode=_nodeNameIndex.slotAry[idxSlot].idx) != NAME_INDEX_EMPTY_SLOT)
     {
-        if(_strcmp(pParseResult->nodeNameAry[idxNode], nodeName) == 0)
+        assert(idxNode < pParseResult->noNodes);
+        if(_nodeNameIndex.slotAry[idxSlot].hash == hash
+           &&  _strcmp(pParseResult->nodeNameAry[idxNode], nodeName) == 0
+          )
         {
             *pIdxNode = idxNode;
             return true;
         }
+        idxSlot = (idxSlot+1) & mask;
     }
 
-    /* Not found; add this node at the end if possible. */
-    if(pParseResult->noNodes < PCI_MAX_NO_NODES)
-    {
-        pParseResult->nodeNameAry[pParseResult->noNodes] = nodeName;
-        *pIdxNode = pParseResult->noNodes++;
-        return true;
-    }
-    else
-    {
-        _parseError = true;
-        LOG_FATAL( _log
-                 , "Line %u: Maximum number %u of nodes exceeded"
-                 , tok_getLine(_hTokenStream)
-                 , PCI_MAX_NO_NODES
-                 );
-        *pIdxNode = PCI_NULL_NODE;
-        return false;
-    }
+    /* Not found; add this node at the end. */
+    pParseResult->nodeNameAry = growArray( pParseResult->nodeNameAry
+                                         , &pParseResult->maxNoNodes
+                                         , pParseResult->noNodes
+                                         , sizeof(*pParseResult->nodeNameAry)
+                                         );
+    pParseResult->nodeNameAry[pParseResult->noNodes] = nodeName;
+    *pIdxNode = pParseResult->noNodes++;
+    addToNameIndex(&_nodeNameIndex, hash, *pIdxNode);
+    return true;
+
 } /* End of enterNode */
 
 
@@ -431,17 +714,33 @@ static boolean findDevice( unsigned int * const pIdxDev
                          , const char * const devName
                          )
 {
-    unsigned int u;
-    const pci_device_t * const * ppDev = pParseResult->pDeviceAry;
-    for(u=0; u<pParseResult->noDevices; ++u)
+    /* All devices of same name are found along the probing sequence of the hash table.
+       Like the former linear search we return the first matching one in the order of
+       definition. */
+    const unsigned int hash = hashName(devName)
+                     , mask = _deviceNameIndex.noSlots - 1;
+    unsigned int idxSlot = hash & mask
+               , idxDev
+               , idxFoundDev = PCI_NULL_DEVICE;
+    while((idxDev=_deviceNameIndex.slotAry[idxSlot].idx) != NAME_INDEX_EMPTY_SLOT)
     {
-        if((*ppDev)->type == devType  &&  strcmp((*ppDev)->name, devName) == 0)
+        assert(idxDev < pParseResult->noDevices);
+        const pci_device_t * const pDev = pParseResult->pDeviceAry[idxDev];
+        if(_deviceNameIndex.slotAry[idxSlot].hash == hash
+           &&  idxDev < idxFoundDev
+           &&  pDev->type == devType
+           &&  strcmp(pDev->name, devName) == 0
+          )
         {
-            *pIdxDev = u;
-            return true;
+            idxFoundDev = idxDev;
         }
+        idxSlot = (idxSlot+1) & mask;
+    }
 
-        ++ ppDev;
+    if(idxFoundDev != PCI_NULL_DEVICE)
+    {
+        *pIdxDev = idxFoundDev;
+        return true;
     }
 
     _parseError = true;
@@ -461,6 +760,85 @@ static boolean findDevice( unsigned int * const pIdxDev
 
 
 
+/**
+ * Search for a device of any type by name in the half-way completed parse result. The
+ * names are compared with the format dependent string compare function \a _strcmp.
+ *   @return
+ * Get the index of the first defined device of the given name or PCI_NULL_DEVICE if there
+ * is no such device.
+ *   @param pParseResult
+ * The searched parse result.
+ *   @param devName
+ * The name of the device.
+ */
+
+static unsigned int findDeviceByName( const pci_circuit_t * const pParseResult
+                                    , const char * const devName
+                                    )
+{
+    const unsigned int hash = hashName(devName)
+                     , mask = _deviceNameIndex.noSlots - 1;
+    unsigned int idxSlot = hash & mask
+               , idxDev
+               , idxFoundDev = PCI_NULL_DEVICE;
+    while((idxDev=_deviceNameIndex.slotAry[idxSlot].idx) != NAME_INDEX_EMPTY_SLOT)
+    {
+        assert(idxDev < pParseResult->noDevices);
+        if(_deviceNameIndex.slotAry[idxSlot].hash == hash
+           &&  idxDev < idxFoundDev
+           &&  _strcmp(pParseResult->pDeviceAry[idxDev]->name, devName) == 0
+          )
+        {
+            idxFoundDev = idxDev;
+        }
+        idxSlot = (idxSlot+1) & mask;
+    }
+
+    return idxFoundDev;
+
+} /* End of findDeviceByName */
+
+
+
+
+/**
+ * Search for a node by name in the half-way completed parse result. The names are compared
+ * with the format dependent string compare function \a _strcmp.
+ *   @return
+ * Get the index of the node of the given name or PCI_NULL_NODE if there is no such node.
+ *   @param pParseResult
+ * The searched parse result.
+ *   @param nodeName
+ * The name of the node.
+ */
+
+static unsigned int findNodeByName( const pci_circuit_t * const pParseResult
+                                  , const char * const nodeName
+                                  )
+{
+    const unsigned int hash = hashName(nodeName)
+                     , mask = _nodeNameIndex.noSlots - 1;
+    unsigned int idxSlot = hash & mask
+               , idxNode;
+    while((idxNode=_nodeNameIndex.slotAry[idxSlot].idx) != NAME_INDEX_EMPTY_SLOT)
+    {
+        assert(idxNode < pParseResult->noNodes);
+        if(_nodeNameIndex.slotAry[idxSlot].hash == hash
+           &&  _strcmp(pParseResult->nodeNameAry[idxNode], nodeName) == 0
+          )
+        {
+            return idxNode;
+        }
+        idxSlot = (idxSlot+1) & mask;
+    }
+
+    return PCI_NULL_NODE;
+
+} /* End of findNodeByName */
+
+
+
+
 /**
  * Enter the parsed information concerning a device in the parse result structure. The next
  * element of the device array is filled.
@@ -483,6 +861,9 @@ static boolean findDevice( unsigned int * const pIdxDev
  *   @param deviceValue
  * The device value to be used for simulation and plotting if specified or a negative value
  * otherwise.
+ *   @param isNumeric
+ * \a true if \a deviceValue is substituted into the LES rather than being represented by
+ * a symbol.
  *   @param deviceRelation
  * The device value in relation to another device. An invalid reference is passed if no
  * such relation is specified in the input.
@@ -497,6 +878,7 @@ static boolean enterDeviceDef( pci_circuit_t * const pParseResult
                              , unsigned int idxNodeAry[4]
                              , unsigned int idxDevCurrentProbe
                              , double deviceValue
+                             , boolean isNumeric
                              , const pci_deviceRelation_t deviceRelation
                              )
 {
@@ -533,27 +915,24 @@ static boolean enterDeviceDef( pci_circuit_t * const pParseResult
 
     /* Optional information about the value of the device. */
     dev.numValue = deviceValue;
+    dev.isNumeric = isNumeric;
     dev.devRelation = deviceRelation;
     assert(dev.numValue == -1.0  ||  dev.devRelation.idxDeviceRef == PCI_NULL_DEVICE);
+    assert(!dev.isNumeric  ||  dev.numValue > 0.0);
 
     /* Success: Allocate a new object and add it to the list. */
-    if(pParseResult->noDevices < PCI_MAX_NO_DEVICES)
-    {
-        pci_device_t *pNew = smalloc(sizeof(pci_device_t), __FILE__, __LINE__);
-        *pNew = dev;
-        pParseResult->pDeviceAry[pParseResult->noDevices++] = pNew;
-        return true;
-    }
-    else
-    {
-        _parseError = true;
-        LOG_FATAL( _log
-                 , "Line %u: Maximum number %u of devices exceeded"
-                 , tok_getLine(_hTokenStream)
-                 , PCI_MAX_NO_DEVICES
-                 );
-        return false;
-    }
+    pci_device_t *pNew = smalloc(sizeof(pci_device_t), __FILE__, __LINE__);
+    *pNew = dev;
+    pParseResult->pDeviceAry = growArray( pParseResult->pDeviceAry
+                                        , &pParseResult->maxNoDevices
+                                        , pParseResult->noDevices
+                                        , sizeof(*pParseResult->pDeviceAry)
+                                        );
+    pParseResult->pDeviceAry[pParseResult->noDevices] = pNew;
+    addToNameIndex(&_deviceNameIndex, hashName(devName), pParseResult->noDevices);
+    ++ pParseResult->noDevices;
+    return true;
+
 } /* End of enterDeviceDef */
 
 
@@ -690,58 +1069,51 @@ static boolean disambiguateDeviceName( const char * * const pNewName
     unsigned int try = 0;
     do
     {
-        isUnique = true;
-        unsigned int idxDev;
-        for(idxDev=0; idxDev<pParseResult->noDevices; ++idxDev)
+        isUnique = findDeviceByName(pParseResult, newName) == PCI_NULL_DEVICE;
+        if(!isUnique)
         {
-            if(_strcmp(pParseResult->pDeviceAry[idxDev]->name, newName) == 0)
+            /* The current name candidate is ambiguous, create the next candidate. */
+
+            /* Normally it should be sufficent to use the line number to disambiguate a
+               name but for pathologic situations we will also need a globally unique
+               ID. */
+            static THREAD_LOCAL unsigned int globalIdxDev = 1;
+            char nameCandidate[strlen(name) + 2*sizeof("_L4294967295")+1];
+            if(try == 0)
             {
-                /* The current name candidate is ambiguous, create the next candidate. */
-                isUnique = false;
-
-                /* Normally it should be sufficent to use the line number to disambiguate a
-                   name but for pathologic situations we will also need a globally unique
-                   ID. */
-                static unsigned int globalIdxDev = 1;
-                char nameCandidate[strlen(name) + 2*sizeof("_L4294967295")+1];
-                if(try == 0)
-                {
-                    snprintf( nameCandidate
-                            , sizeof(nameCandidate)
-                            , "%s_L%02u"
-                            , name
-                            , tok_getLine(_hTokenStream)
-                            );
-
-                    /* First attempt: Pointer newName is identical to pointer name and is
-                       not freed as name may be used for reporting below. We will free it
-                       after reporting. */
-                }
-                else
-                {
-                    snprintf( nameCandidate
-                            , sizeof(nameCandidate)
-                            , "%s_L%02u_%u"
-                            , name
-                            , tok_getLine(_hTokenStream)
-                            , globalIdxDev++
-                            );
+                snprintf( nameCandidate
+                        , sizeof(nameCandidate)
+                        , "%s_L%02u"
+                        , name
+                        , tok_getLine(_hTokenStream)
+                        );
 
-                    /* Free name candidate of first attempt. */
-                    free((void*)newName);
-                }
-                newName = stralloccpy(nameCandidate);
+                /* First attempt: Pointer newName is identical to pointer name and is
+                   not freed as name may be used for reporting below. We will free it
+                   after reporting. */
+            }
+            else
+            {
+                snprintf( nameCandidate
+                        , sizeof(nameCandidate)
+                        , "%s_L%02u_%u"
+                        , name
+                        , tok_getLine(_hTokenStream)
+                        , globalIdxDev++
+                        );
 
-                /* Re-start the outer loop. Check in second pass if name candidate is okay. */
-                break;
+                /* Free name candidate of first attempt. */
+                free((void*)newName);
             }
-        } /* End for(Compare name candidate with all names already in use) */
+            newName = stralloccpy(nameCandidate);
+
+        } /* End if(Name candidate is already in use?) */
 
-        /* Count number of attempts. */
+        /* Count number of attempts. Check in next pass if name candidate is okay. */
         ++ try;
     }
     while(!isUnique);
-    assert(try <= PCI_MAX_NO_DEVICES+1);
+    assert(try <= pParseResult->noDevices+1);
 
     if(newName != name)
     {
@@ -872,12 +1244,15 @@ static boolean parseRatNum( unsigned long *pNumerator
 
 /**
  * Parse the value of a device constant assignment. Either a number or a multiple of
- * another, already known device.
+ * another, already known device. A number can be followed by the keyword numeric.
  *   @return
  * True if parsing succeeded, else false.
  *   @param pDeviceValue
  * If the function succeeds then the physical value of the device is placed in * \a
  * pDeviceValue if it is specified absolute.
+ *   @param pIsNumeric
+ * If the function succeeds then \a true is placed in * \a pIsNumeric if the absolute
+ * value is annotated as numeric, i.e. if it is substituted into the LES.
  *   @param pDeviceRelation
  * The parse result is placed in * \a pDeviceRelation if the device is related to another,
  * already known.
@@ -892,6 +1267,7 @@ static boolean parseRatNum( unsigned long *pNumerator
  */
 
 static boolean parseDeviceRelation( double * const pDeviceValue
+                                  , boolean * const pIsNumeric
                                   , pci_deviceRelation_t * const pDeviceRelation
                                   , const pci_circuit_t * const pParseResult
                                   , pci_deviceType_t devType
@@ -1060,15 +1436,7 @@ static boolean parseDeviceRelation( double * const pDeviceValue
 
                 /* Resolve the reference: The name of the referenced device is replaced by the
                    index into the table of already known devices. */
-                unsigned int idxDev;
-                for(idxDev=0; idxDev<pParseResult->noDevices; ++idxDev)
-                {
-                    if(_strcmp(pParseResult->pDeviceAry[idxDev]->name, nameRefDev) == 0)
-                    {
-                        idxDeviceRef = idxDev;
-                        break;
-                    }
-                }
+                idxDeviceRef = findDeviceByName(pParseResult, nameRefDev);
                 if(idxDeviceRef == PCI_NULL_DEVICE)
                 {
                     success = false;
@@ -1101,6 +1469,20 @@ static boolean parseDeviceRelation( double * const pDeviceValue
                              )
                     note =". Bad device reference, see before";
                 }
+                else if(pParseResult->pDeviceAry[idxDeviceRef]->isNumeric)
+                {
+                    success = false;
+                    _parseError = true;
+                    idxDeviceRef = PCI_NULL_DEVICE;
+                    LOG_ERROR( _log
+                             , "Line %u: The referenced device %s has a numeric value. A"
+                               " numeric device is not represented by a symbol and it can't"
+                               " be referenced"
+                             , tok_getLine(_hTokenStream)
+                             , nameRefDev
+                             )
+                    note =". Bad device reference, see before";
+                }
 
                 if(!getToken())
                     return false;
@@ -1128,6 +1510,40 @@ static boolean parseDeviceRelation( double * const pDeviceValue
         return false;
     }
 
+    /* A physical value can be annotated as numeric. It is then substituted into the LES
+       and the device doesn't become a symbol of the results. The Laplace variable of
+       capacitors and inductivities can't be substituted. */
+    boolean isNumeric = false;
+    if(isPhysicalValue &&  _token.type == tok_tokenTypeIdentifier
+       &&  stricmp(_token.value.identifier, "numeric") == 0
+      )
+    {
+        if(devType == pci_devType_capacitor  ||  devType == pci_devType_inductivity)
+        {
+            _parseError = true;
+            LOG_ERROR( _log
+                     , "Line %u: The value of a capacitor or inductivity can't be"
+                       " numeric. Only resistors, conductances and controlled sources"
+                       " can have a numeric value"
+                     , tok_getLine(_hTokenStream)
+                     )
+            return false;
+        }
+        else if(deviceValue == 0.0)
+        {
+            _parseError = true;
+            LOG_ERROR( _log
+                     , "Line %u: A numeric device value must not be null"
+                     , tok_getLine(_hTokenStream)
+                     )
+            return false;
+        }
+
+        isNumeric = true;
+        if(!getToken())
+            return false;
+    }
+
     if(success &&  _token.type != tok_tokenTypeEndOfLine
        &&  _token.type != tok_tokenTypeEndOfFile
       )
@@ -1156,6 +1572,7 @@ static boolean parseDeviceRelation( double * const pDeviceValue
            ||  (factor.n != 0  &&  factor.d != 0  &&  rat_sign(factor) > 0)
           );
     *pDeviceValue = deviceValue;
+    *pIsNumeric = isNumeric;
     pDeviceRelation->idxDeviceRef = idxDeviceRef;
     pDeviceRelation->factorRef = factor;
 
@@ -1179,6 +1596,8 @@ static boolean parseDeviceRelation( double * const pDeviceValue
  *   @param pDeviceValue
  * The physical value of the device is placed in * \a pDeviceValue if it is specified
  * absolute.
+ *   @param pIsNumeric
+ * \a true is placed in * \a pIsNumeric if the absolute value is annotated as numeric.
  *   @param pDeviceRelation
  * The parse result is placed in * \a pDeviceRelation if the device is related to another,
  * already known.
@@ -1195,6 +1614,7 @@ static boolean parseDeviceRelation( double * const pDeviceValue
 
 static boolean parseDevValueAssignment( boolean *pAssignmentFound
                                       , double * const pDeviceValue
+                                      , boolean * const pIsNumeric
                                       , pci_deviceRelation_t * const pDeviceRelation
                                       , const pci_circuit_t * const pParseResult
                                       , pci_deviceType_t devType
@@ -1320,8 +1740,16 @@ static boolean parseDevValueAssignment( boolean *pAssignmentFound
 
         } /* End if(Which syntax format?) */
 
-        if(!parseDeviceRelation(pDeviceValue, pDeviceRelation, pParseResult, devType))
+        if(!parseDeviceRelation( pDeviceValue
+                               , pIsNumeric
+                               , pDeviceRelation
+                               , pParseResult
+                               , devType
+                              )
+          )
+        {
             return false;
+        }
 
     } /* End if(Optional value assignment is present in input stream?) */
 
@@ -1597,6 +2025,7 @@ static boolean parseDeviceDef(pci_circuit_t * const pParseResult)
 
     /* The value of a device can be specified. */
     double deviceValue = -1.0;
+    boolean isNumeric = false;
     pci_deviceRelation_t deviceRelation = { .idxDeviceRef = PCI_NULL_DEVICE
                                           , .factorRef = RAT_NULL
                                           };
@@ -1605,6 +2034,7 @@ static boolean parseDeviceDef(pci_circuit_t * const pParseResult)
         boolean assignmentFound;
         success = parseDevValueAssignment( &assignmentFound
                                          , &deviceValue
+                                         , &isNumeric
                                          , &deviceRelation
                                          , pParseResult
                                          , devType
@@ -1628,6 +2058,7 @@ static boolean parseDeviceDef(pci_circuit_t * const pParseResult)
                                 , idxNodeAry
                                 , idxDevCurrentProbe
                                 , deviceValue
+                                , isNumeric
                                 , deviceRelation
                                 );
     }
@@ -1741,6 +2172,11 @@ static boolean parseOldStyleOutput(pci_circuit_t * const pParseResult)
     /* The old style syntax only allows a single output voltage. */
     if(pParseResult->noVoltageDefs == 0)
     {
+        pParseResult->voltageDefAry = growArray( pParseResult->voltageDefAry
+                                               , &pParseResult->maxNoVoltageDefs
+                                               , pParseResult->noVoltageDefs
+                                               , sizeof(*pParseResult->voltageDefAry)
+                                               );
         pParseResult->voltageDefAry[0].name = stralloccpy("U2");
         pParseResult->voltageDefAry[0].idxNodePlus = idxNodeAry[0];
         pParseResult->voltageDefAry[0].idxNodeMinus = idxNodeAry[1];
@@ -1991,18 +2427,12 @@ static boolean parseVoltageDefintion(pci_circuit_t * const pParseResult)
 {
     assert(_parseError == false);
 
-    if(pParseResult->noVoltageDefs >= PCI_MAX_NO_VOLTAGE_DEFINITIONS)
-    {
-        _parseError = true;
-        LOG_FATAL( _log
-                 , "Line %u: Maximum number of %u voltage definitions exceeded"
-                 , tok_getLine(_hTokenStream)
-                 , PCI_MAX_NO_VOLTAGE_DEFINITIONS
-                 );
-        return false;
-    }
-
     /* Create new voltage definition array entry. */
+    pParseResult->voltageDefAry = growArray( pParseResult->voltageDefAry
+                                           , &pParseResult->maxNoVoltageDefs
+                                           , pParseResult->noVoltageDefs
+                                           , sizeof(*pParseResult->voltageDefAry)
+                                           );
     pci_voltageDef_t * const pVolDef = &pParseResult
                                         ->voltageDefAry[pParseResult->noVoltageDefs];
 
@@ -2068,6 +2498,66 @@ static boolean parseVoltageDefintion(pci_circuit_t * const pParseResult)
 
 
 
+/**
+ * Open the next entry of the array of result definitions of the parse result. The array
+ * grows if it is full. The entry is initialized as a result without name and dependents;
+ * it is not yet counted as a result definition.
+ *   @return
+ * Get the pointer to the new entry. It is valid only until the array grows again.
+ *   @param pParseResult
+ * The parse result, which the result definition is added to.
+ */
+
+static pci_resultDef_t *openResultDef(pci_circuit_t * const pParseResult)
+{
+    pParseResult->resultDefAry = growArray( pParseResult->resultDefAry
+                                          , &pParseResult->maxNoResultDefs
+                                          , pParseResult->noResultDefs
+                                          , sizeof(*pParseResult->resultDefAry)
+                                          );
+    pci_resultDef_t * const pResultDef = &pParseResult
+                                          ->resultDefAry[pParseResult->noResultDefs];
+    *pResultDef = (pci_resultDef_t){ .name = NULL
+                                   , .noDependents = 0
+                                   , .maxNoDependents = 0
+                                   , .dependentNameAry = NULL
+                                   , .independentName = NULL
+                                   , .pPlotInfo = NULL
+                                   };
+    return pResultDef;
+
+} /* End of openResultDef */
+
+
+
+
+/**
+ * Append a dependent quantity to a result definition. The array of dependents grows if it
+ * is full.
+ *   @param pResultDef
+ * The result definition, which the dependent is added to.
+ *   @param dependentName
+ * The name of the dependent. A malloc allocated string is expected; the result definition
+ * takes the ownership. NULL is permitted if parsing the name failed. This entry is then
+ * counted, too, until freed again after the error.
+ */
+
+static void addDependent( pci_resultDef_t * const pResultDef
+                        , const char * const dependentName
+                        )
+{
+    pResultDef->dependentNameAry = growArray( pResultDef->dependentNameAry
+                                            , &pResultDef->maxNoDependents
+                                            , pResultDef->noDependents
+                                            , sizeof(*pResultDef->dependentNameAry)
+                                            );
+    pResultDef->dependentNameAry[pResultDef->noDependents++] = dependentName;
+
+} /* End of addDependent */
+
+
+
+
 /**
  * Parse a line, which defines a user wanted result.
  *   @return
@@ -2087,23 +2577,8 @@ static boolean parseResultDefintion(pci_circuit_t * const pParseResult, boolean
 {
     assert(_parseError == false);
 
-    if(pParseResult->noResultDefs >= PCI_MAX_NO_RESULTS)
-    {
-        _parseError = true;
-        LOG_FATAL( _log
-                 , "Line %u: Maximum number of %u result definitions exceeded"
-                 , tok_getLine(_hTokenStream)
-                 , PCI_MAX_NO_RESULTS
-                 );
-        return false;
-    }
-
     /* Open a new result definition array entry. */
-    pci_resultDef_t * const pResultDef = &pParseResult
-                                          ->resultDefAry[pParseResult->noResultDefs];
-    pResultDef->noDependents = 0;
-    pResultDef->independentName = NULL;
-    pResultDef->pPlotInfo = NULL;
+    pci_resultDef_t * const pResultDef = openResultDef(pParseResult);
 
     /* Read the name of the user demanded result. */
     pResultDef->name = parseIdentifier(/* meaningOfIdent */ "Name of user demanded result");
@@ -2146,18 +2621,7 @@ static boolean parseResultDefintion(pci_circuit_t * const pParseResult, boolean
                                                       "Name of dependent quantity or"
                                                       " unknown"
                                                     );
-                if(pResultDef->noDependents < PCI_MAX_SIZE_OF_RESULT_SETS)
-                    pResultDef->dependentNameAry[pResultDef->noDependents++] = dependent;
-                else
-                {
-                    _parseError = true;
-                    LOG_FATAL( _log
-                             , "Line %u: Maximum number of %u dependent quantities in a"
-                               " result exceeded"
-                             , tok_getLine(_hTokenStream)
-                             , PCI_MAX_SIZE_OF_RESULT_SETS
-                             );
-                }
+                addDependent(pResultDef, dependent);
             }
             while(!_parseError &&  _token.type == tok_tokenTypeIdentifier);
 
@@ -2168,11 +2632,12 @@ static boolean parseResultDefintion(pci_circuit_t * const pParseResult, boolean
         /* Parse the dependent quantity. */
         if(!_parseError)
         {
-            pResultDef->dependentNameAry[pResultDef->noDependents++] =
-                                parseIdentifier( /* meaningOfIdent */
-                                                 "Name of dependent quantity (behind the"
-                                                 " result's name)"
-                                               );
+            addDependent( pResultDef
+                        , parseIdentifier( /* meaningOfIdent */
+                                           "Name of dependent quantity (behind the"
+                                           " result's name)"
+                                         )
+                        );
         } /* End if(No error yet?) */
 
         /* Parse the independent quantity. */
@@ -2214,6 +2679,9 @@ static boolean parseResultDefintion(pci_circuit_t * const pParseResult, boolean
             if(pMallocString != NULL)
                 free((char*)pMallocString);
         }
+        free((void*)pResultDef->dependentNameAry);
+        pResultDef->dependentNameAry = NULL;
+        pResultDef->maxNoDependents = 0;
 
         if(pResultDef->independentName != NULL)
         {
@@ -2237,6 +2705,481 @@ static boolean parseResultDefintion(pci_circuit_t * const pParseResult, boolean
 
 
 
+/**
+ * Derive the name of a node or device of a subcircuit instance from the name of the
+ * instance and the name of the node or device in the subcircuit definition.
+ *   @return
+ * Get the name as malloc allocated string. The caller becomes the owner of the string and
+ * needs to free it after use.
+ *   @param instanceName
+ * The name of the instance.
+ *   @param name
+ * The name of the node or device in the definition of the subcircuit.
+ */
+
+static char *createNameInInstance(const char * const instanceName, const char * const name)
+{
+    const size_t sizeOfName = strlen(instanceName) + sizeof(SEPARATOR_INSTANCE_NAME)-1
+                              + strlen(name) + 1;
+    char * const nameInInstance = smalloc(sizeOfName, __FILE__, __LINE__);
+    snprintf( nameInInstance
+            , sizeOfName
+            , "%s" SEPARATOR_INSTANCE_NAME "%s"
+            , instanceName
+            , name
+            );
+    return nameInInstance;
+
+} /* End of createNameInInstance */
+
+
+
+
+/**
+ * Parse a line, which instantiates a subcircuit. The devices and the internal nodes of the
+ * subcircuit are copied into the parse result; the names of the copies are prefixed with
+ * the name of the instance. The ports of the subcircuit are connected to the nodes, which
+ * are listed in the line.
+ *   @return
+ * True if parsing succeeded, else false.
+ *   @param pParseResult
+ * The devices and nodes of the instance are added to \a * pParseResult. This is either the
+ * circuit or the definition of another subcircuit, which is currently parsed.
+ *   @param pCircuit
+ * The circuit, which holds the definitions of all subcircuits. If it is the same object
+ * as \a pParseResult then the instance is recorded in the circuit.
+ *   @param nameOfSubcircuitDef
+ * The name of the subcircuit, whose definition is currently parsed and which \a
+ * pParseResult belongs to, or NULL if the instance is a part of the circuit.
+ *   @remark
+ * The global error flag \a _parseError is set and a message is written to the log in case
+ * of an error.
+ */
+
+static boolean parseSubcircuitInstance( pci_circuit_t * const pParseResult
+                                      , pci_circuit_t * const pCircuit
+                                      , const char * const nameOfSubcircuitDef
+                                      )
+{
+    assert(_parseError == false);
+
+    /* On entry, the token is the device qualifier of an instance. */
+    assert(_token.type == tok_tokenTypeIdentifier
+           &&  _strcmp(_token.value.identifier, "X") == 0
+          );
+    if(!getToken())
+        return false;
+
+    const char * const instanceName = parseIdentifier("Name of subcircuit instance");
+    if(instanceName == NULL)
+        return false;
+    const char * const subcircuitName = parseIdentifier("Name of instantiated subcircuit");
+    if(subcircuitName == NULL)
+    {
+        free((char*)instanceName);
+        return false;
+    }
+
+    /* Forward references are not supported; the subcircuit needs to be defined before. A
+       subcircuit can't instantiate itself as it is not yet defined while its lines are
+       parsed. The (only) recursion, which is possible in the syntax, gets a dedicated
+       error message. */
+    if(nameOfSubcircuitDef != NULL  &&  _strcmp(nameOfSubcircuitDef, subcircuitName) == 0)
+    {
+        _parseError = true;
+        LOG_ERROR( _log
+                 , "Line %u: Subcircuit %s instantiates itself as %s. Recursive definitions"
+                   " of subcircuits are not supported"
+                 , tok_getLine(_hTokenStream)
+                 , subcircuitName
+                 , instanceName
+                 )
+        free((char*)subcircuitName);
+        free((char*)instanceName);
+        return false;
+    }
+    unsigned int idxDef;
+    for(idxDef=0; idxDef<pCircuit->noSubcircuitDefs; ++idxDef)
+    {
+        if(_strcmp(pCircuit->subcircuitDefAry[idxDef].name, subcircuitName) == 0)
+            break;
+    }
+    if(idxDef >= pCircuit->noSubcircuitDefs)
+    {
+        _parseError = true;
+        LOG_ERROR( _log
+                 , "Line %u: Subcircuit %s of instance %s is not defined. Please note that"
+                   " forward references are not supported; the subcircuit needs to be"
+                   " defined in a previous line"
+                 , tok_getLine(_hTokenStream)
+                 , subcircuitName
+                 , instanceName
+                 )
+        free((char*)subcircuitName);
+        free((char*)instanceName);
+        return false;
+    }
+    free((char*)subcircuitName);
+    const pci_subcircuitDef_t * const pDef = &pCircuit->subcircuitDefAry[idxDef];
+    const pci_circuit_t * const pSubcircuit = pDef->pCircuit;
+
+    /* The map of the nodes of the subcircuit onto the nodes of the parse result begins
+       with the nodes, which the ports of the instance are connected to. */
+    unsigned int * const idxNodeAry = smalloc( pSubcircuit->noNodes * sizeof(unsigned int)
+                                             , __FILE__
+                                             , __LINE__
+                                             );
+    boolean success = parseListOfNodes(pParseResult, idxNodeAry, pDef->noPorts);
+    if(!success  &&  (_token.type == tok_tokenTypeEndOfLine
+                      ||  _token.type == tok_tokenTypeEndOfFile
+                     )
+      )
+    {
+        LOG_ERROR( _log
+                 , "Line %u: Instance %s of subcircuit %s is connected to less than %u"
+                   " nodes. Expect one node for each port of the subcircuit"
+                 , tok_getLine(_hTokenStream)
+                 , instanceName
+                 , pDef->name
+                 , pDef->noPorts
+                 )
+    }
+    else if(success &&  _token.type != tok_tokenTypeEndOfLine
+            &&  _token.type != tok_tokenTypeEndOfFile
+           )
+    {
+        success = false;
+        _parseError = true;
+        LOG_ERROR( _log
+                 , "Line %u: Instance %s of subcircuit %s is connected to more than %u"
+                   " nodes. Expect one node for each port of the subcircuit"
+                 , tok_getLine(_hTokenStream)
+                 , instanceName
+                 , pDef->name
+                 , pDef->noPorts
+                 )
+    }
+
+    /* The internal nodes of the subcircuit become new nodes of the parse result. Their
+       names must not clash with existing nodes; this would silently connect the instance
+       to some other part of the circuit. */
+    unsigned int idxNode;
+    for(idxNode=pDef->noPorts; success && idxNode<pSubcircuit->noNodes; ++idxNode)
+    {
+        char * const nodeName = createNameInInstance( instanceName
+                                                    , pSubcircuit->nodeNameAry[idxNode]
+                                                    );
+        const unsigned int noNodes = pParseResult->noNodes;
+        if(enterNode(&idxNodeAry[idxNode], pParseResult, nodeName)
+           &&  idxNodeAry[idxNode] >= noNodes
+          )
+        {
+            /* The parse result took the ownership of the name. */
+        }
+        else
+        {
+            success = false;
+            _parseError = true;
+            LOG_ERROR( _log
+                     , "Line %u: The internal node %s of subcircuit instance %s is named %s"
+                       " but this node name had been used before. The names of the"
+                       " internal nodes of an instance need to be unique"
+                     , tok_getLine(_hTokenStream)
+                     , pSubcircuit->nodeNameAry[idxNode]
+                     , instanceName
+                     , nodeName
+                     )
+            free(nodeName);
+        }
+    } /* End for(All internal nodes of the subcircuit) */
+
+    /* Copy the devices. References between devices of the subcircuit, i.e. relations of
+       device values and the current probes of current controlled sources, are relocated
+       to the copies. */
+    const unsigned int idxFirstDevice = pParseResult->noDevices;
+    unsigned int idxDev;
+    for(idxDev=0; success && idxDev<pSubcircuit->noDevices; ++idxDev)
+    {
+        const pci_device_t * const pDev = pSubcircuit->pDeviceAry[idxDev];
+        const char *devName = createNameInInstance(instanceName, pDev->name);
+        success = disambiguateDeviceName(&devName, pParseResult, devName);
+
+        unsigned int idxNodeDevAry[4] = { idxNodeAry[pDev->idxNodeFrom]
+                                        , idxNodeAry[pDev->idxNodeTo]
+                                        , PCI_NULL_NODE
+                                        , PCI_NULL_NODE
+                                        };
+        if(pDev->idxNodeOpOut != PCI_NULL_NODE)
+            idxNodeDevAry[2] = idxNodeAry[pDev->idxNodeOpOut];
+        if(pDev->idxNodeCtrlPlus != PCI_NULL_NODE)
+        {
+            idxNodeDevAry[2] = idxNodeAry[pDev->idxNodeCtrlPlus];
+            idxNodeDevAry[3] = idxNodeAry[pDev->idxNodeCtrlMinus];
+        }
+
+        pci_deviceRelation_t deviceRelation = pDev->devRelation;
+        if(deviceRelation.idxDeviceRef != PCI_NULL_DEVICE)
+            deviceRelation.idxDeviceRef += idxFirstDevice;
+
+        if(success)
+        {
+            success = enterDeviceDef( pParseResult
+                                    , pDev->type
+                                    , devName
+                                    , idxNodeDevAry
+                                    , pDev->idxCurrentProbe != PCI_NULL_DEVICE
+                                      ? idxFirstDevice + pDev->idxCurrentProbe
+                                      : PCI_NULL_DEVICE
+                                    , pDev->numValue
+                                    , pDev->isNumeric
+                                    , deviceRelation
+                                    );
+        }
+        if(!success)
+            free((char*)devName);
+
+    } /* End for(All devices of the subcircuit) */
+
+    if(success)
+    {
+        LOG_DEBUG( _log
+                 , "Line %u: Found instance %s of subcircuit %s, %u devices and %u internal"
+                   " nodes have been added to the circuit"
+                 , tok_getLine(_hTokenStream)
+                 , instanceName
+                 , pDef->name
+                 , pSubcircuit->noDevices
+                 , pSubcircuit->noNodes - pDef->noPorts
+                 )
+    }
+
+    /* Only the instances in the circuit are recorded. The devices of an instance, which
+       is part of another subcircuit, simply belong to that other subcircuit. */
+    if(success &&  pParseResult == pCircuit)
+    {
+        pCircuit->subcircuitInstanceAry = growArray( pCircuit->subcircuitInstanceAry
+                                                   , &pCircuit->maxNoSubcircuitInstances
+                                                   , pCircuit->noSubcircuitInstances
+                                                   , sizeof(*pCircuit->subcircuitInstanceAry)
+                                                   );
+        pci_subcircuitInstance_t * const pInstance =
+                            &pCircuit->subcircuitInstanceAry[pCircuit->noSubcircuitInstances];
+        pInstance->name = instanceName;
+        pInstance->idxSubcircuitDef = idxDef;
+        pInstance->idxFirstDevice = idxFirstDevice;
+        pInstance->idxNodeAry = idxNodeAry;
+        pInstance->isReducible = false;
+        ++ pCircuit->noSubcircuitInstances;
+    }
+    else
+    {
+        free((char*)instanceName);
+        free(idxNodeAry);
+    }
+
+    return success;
+
+} /* End of parseSubcircuitInstance */
+
+
+
+
+/**
+ * Parse the definition of a subcircuit. The definition begins with a line, which names the
+ * subcircuit and its ports, and it ends with a line ENDS. The lines in between define the
+ * devices of the subcircuit or they instantiate other, previously defined subcircuits.
+ *   @return
+ * True if parsing succeeded, else false.
+ *   @param pCircuit
+ * The definition of the subcircuit is added to the circuit * \a pCircuit.
+ *   @remark
+ * The global error flag \a _parseError is set and a message is written to the log in case
+ * of an error.
+ */
+
+static boolean parseSubcircuitDef(pci_circuit_t * const pCircuit)
+{
+    assert(_parseError == false);
+
+    const unsigned int lineOfDef = tok_getLine(_hTokenStream);
+    const char * const name = parseIdentifier("Name of subcircuit");
+    if(name == NULL)
+        return false;
+
+    boolean success = true;
+    unsigned int idxDef;
+    for(idxDef=0; idxDef<pCircuit->noSubcircuitDefs; ++idxDef)
+    {
+        if(_strcmp(pCircuit->subcircuitDefAry[idxDef].name, name) == 0)
+        {
+            success = false;
+            _parseError = true;
+            LOG_ERROR( _log
+                     , "Line %u: Subcircuit %s had been defined before. The names of"
+                       " subcircuits need to be unique"
+                     , tok_getLine(_hTokenStream)
+                     , name
+                     )
+            break;
+        }
+    }
+
+    /* The subcircuit is parsed into a parse result of its own. Its nodes and devices have
+       an own name space. */
+    pci_circuit_t * const pSubcircuit = createParseResult();
+    const nameIndex_t nodeNameIndexOfCircuit = _nodeNameIndex
+                    , deviceNameIndexOfCircuit = _deviceNameIndex;
+    initNameIndex(&_nodeNameIndex);
+    initNameIndex(&_deviceNameIndex);
+
+    /* The ports are the first nodes of the subcircuit. */
+    while(success &&  _token.type != tok_tokenTypeEndOfLine  &&  _token.type != EOF)
+    {
+        const unsigned int noNodes = pSubcircuit->noNodes;
+        unsigned int idxNode;
+        success = parseListOfNodes(pSubcircuit, &idxNode, /* noNodes */ 1);
+        if(success &&  idxNode < noNodes)
+        {
+            success = false;
+            _parseError = true;
+            LOG_ERROR( _log
+                     , "Line %u: Port %s of subcircuit %s is specified repeatedly"
+                     , tok_getLine(_hTokenStream)
+                     , pSubcircuit->nodeNameAry[idxNode]
+                     , name
+                     )
+        }
+    }
+    const unsigned int noPorts = pSubcircuit->noNodes;
+    if(success &&  noPorts < 2)
+    {
+        success = false;
+        _parseError = true;
+        LOG_ERROR( _log
+                 , "Line %u: Subcircuit %s needs to have at least two ports"
+                 , tok_getLine(_hTokenStream)
+                 , name
+                 )
+    }
+
+    /* Even if the first line is bad: Read all lines of the definition, so that parsing of
+       the circuit can continue behind the definition. */
+    if(_parseError)
+        sync();
+
+    /* Read and interpret all lines of the subcircuit until token ENDS is seen. */
+    boolean isEnd = false;
+    while(!isEnd)
+    {
+        _parseError = false;
+        if(_token.type == EOF)
+        {
+            success = false;
+            LOG_ERROR( _log
+                     , "Line %u: End of file in the definition of subcircuit %s, which"
+                       " begins in line %u. The definition needs to be closed with ENDS"
+                     , tok_getLine(_hTokenStream)
+                     , name
+                     , lineOfDef
+                     )
+            break;
+        }
+        else if(_token.type == tok_tokenTypeEndOfLine)
+            getToken();
+        else if(_token.type == tokenTypeSubcircuitEnd)
+        {
+            isEnd = true;
+            getToken();
+        }
+        else if(_token.type == tok_tokenTypeIdentifier
+                &&  ((strlen(_token.value.identifier) == 1
+                      &&  strchr("RYCLUI", _token.value.identifier[0]) != NULL
+                     )
+                     ||  _strcmp(_token.value.identifier, "OP") == 0
+                     ||  _strcmp(_token.value.identifier, "PI") == 0
+                    )
+               )
+        {
+            parseDeviceDef(pSubcircuit);
+        }
+        else if(_token.type == tok_tokenTypeIdentifier
+                &&  _strcmp(_token.value.identifier, "X") == 0
+               )
+        {
+            parseSubcircuitInstance(pSubcircuit, pCircuit, /* nameOfSubcircuitDef */ name);
+        }
+        else
+        {
+            _parseError = true;
+            LOG_ERROR( _log
+                     , "Line %u: Syntax error. Expect a device definition, a subcircuit"
+                       " instance or ENDS in the definition of subcircuit %s"
+                     , tok_getLine(_hTokenStream)
+                     , name
+                     )
+        }
+
+        /* Skip the rest of a bad line and continue with the next one. */
+        if(_parseError)
+        {
+            success = false;
+            sync();
+        }
+    } /* End while(Not yet the end of the definition) */
+
+    if(success &&  pSubcircuit->noDevices == 0)
+    {
+        success = false;
+        LOG_ERROR( _log
+                 , "Line %u: Subcircuit %s doesn't contain any device"
+                 , tok_getLine(_hTokenStream)
+                 , name
+                 )
+    }
+
+    deleteNameIndex(&_nodeNameIndex);
+    deleteNameIndex(&_deviceNameIndex);
+    _nodeNameIndex = nodeNameIndexOfCircuit;
+    _deviceNameIndex = deviceNameIndexOfCircuit;
+
+    if(success)
+    {
+        LOG_DEBUG( _log
+                 , "Line %u: Found definition of subcircuit %s with %u ports, %u internal"
+                   " nodes and %u devices"
+                 , lineOfDef
+                 , name
+                 , noPorts
+                 , pSubcircuit->noNodes - noPorts
+                 , pSubcircuit->noDevices
+                 )
+
+        pCircuit->subcircuitDefAry = growArray( pCircuit->subcircuitDefAry
+                                              , &pCircuit->maxNoSubcircuitDefs
+                                              , pCircuit->noSubcircuitDefs
+                                              , sizeof(*pCircuit->subcircuitDefAry)
+                                              );
+        pci_subcircuitDef_t * const pDef =
+                                    &pCircuit->subcircuitDefAry[pCircuit->noSubcircuitDefs];
+        pDef->name = name;
+        pDef->noPorts = noPorts;
+        pDef->pCircuit = pSubcircuit;
+        ++ pCircuit->noSubcircuitDefs;
+    }
+    else
+    {
+        _parseError = true;
+        pci_deleteParseResult(pSubcircuit);
+        free((char*)name);
+    }
+
+    return success;
+
+} /* End of parseSubcircuitDef */
+
+
+
+
 /**
  * Validate that a node is a true, physical network node, i.e. that it really is connected
  * to an electrical connector of a device (but not only to a voltage sense input or not at
@@ -2364,6 +3307,292 @@ static boolean checkNodeReferences(const pci_circuit_t * const pParseResult)
 
 
 
+/**
+ * Helper of findReducibleInstances: Check a reference to a node. If the node is an internal
+ * node of a subcircuit instance and if the reference is made from outside of this instance
+ * then the instance can't be represented by a port model.
+ *   @param pParseResult
+ * The completed parse result.
+ *   @param idxInstanceOfNodeAry
+ * The map of all nodes of the circuit onto the instances, which they are an internal node
+ * of, or UINT_MAX for all other nodes.
+ *   @param idxNode
+ * The referenced node or PCI_NULL_NODE if there is no reference.
+ *   @param idxInstanceOfRef
+ * The instance, which the reference is made from, or UINT_MAX if it is made from outside
+ * of any instance.
+ */
+
+static void checkReferenceOfNode( pci_circuit_t * const pParseResult
+                                , const unsigned int idxInstanceOfNodeAry[]
+                                , unsigned int idxNode
+                                , unsigned int idxInstanceOfRef
+                                )
+{
+    if(idxNode != PCI_NULL_NODE
+       &&  idxInstanceOfNodeAry[idxNode] != UINT_MAX
+       &&  idxInstanceOfNodeAry[idxNode] != idxInstanceOfRef
+      )
+    {
+        pParseResult->subcircuitInstanceAry[idxInstanceOfNodeAry[idxNode]].isReducible = false;
+    }
+} /* End of checkReferenceOfNode */
+
+
+
+
+/**
+ * Decide for all subcircuit instances of the circuit, whether they can be represented by
+ * the port model of their subcircuit. The LES can then use a single unknown and equation
+ * for the instance instead of the unknown voltages of all of its internal nodes. This
+ * requires:\n
+ *   The subcircuit is a two-terminal network of passive devices only. Each of its
+ * internal nodes is connected to a port through its devices; otherwise the port model
+ * would have a null denominator.\n
+ *   No internal node of the instance is referenced from outside the instance: It is not
+ * connected to another device, not sensed by a voltage controlled source, not used in a
+ * user-defined voltage and its voltage is not referenced by name in a result definition.
+ *   @param pParseResult
+ * The completed parse result. The flags pci_subcircuitInstance_t.isReducible are set.
+ *   @remark
+ * The function needs to be called before the name index of the nodes is deleted.
+ */
+
+static void findReducibleInstances(pci_circuit_t * const pParseResult)
+{
+    if(pParseResult->noSubcircuitInstances == 0)
+        return;
+
+    /* Check the subcircuits first. */
+    boolean isPassiveOnePortAry[pParseResult->noSubcircuitDefs];
+    unsigned int idxDef;
+    for(idxDef=0; idxDef<pParseResult->noSubcircuitDefs; ++idxDef)
+    {
+        const pci_subcircuitDef_t * const pDef = &pParseResult->subcircuitDefAry[idxDef];
+        const pci_circuit_t * const pSubcircuit = pDef->pCircuit;
+        boolean isPassiveOnePort = pDef->noPorts == 2;
+
+        unsigned int idxDev;
+        for(idxDev=0; isPassiveOnePort && idxDev<pSubcircuit->noDevices; ++idxDev)
+        {
+            switch(pSubcircuit->pDeviceAry[idxDev]->type)
+            {
+            case pci_devType_resistor   :
+            case pci_devType_conductance:
+            case pci_devType_capacitor  :
+            case pci_devType_inductivity:
+                break;
+
+            default:
+                isPassiveOnePort = false;
+            }
+        }
+
+        /* Propagate the connection to a port through the devices until no further node is
+           found. */
+        if(isPassiveOnePort)
+        {
+            boolean isConnectedAry[pSubcircuit->noNodes];
+            unsigned int idxNode;
+            for(idxNode=0; idxNode<pSubcircuit->noNodes; ++idxNode)
+                isConnectedAry[idxNode] = idxNode < pDef->noPorts;
+
+            boolean isChanged;
+            do
+            {
+                isChanged = false;
+                for(idxDev=0; idxDev<pSubcircuit->noDevices; ++idxDev)
+                {
+                    const pci_device_t * const pDev = pSubcircuit->pDeviceAry[idxDev];
+                    if(isConnectedAry[pDev->idxNodeFrom] != isConnectedAry[pDev->idxNodeTo])
+                    {
+                        isConnectedAry[pDev->idxNodeFrom] =
+                        isConnectedAry[pDev->idxNodeTo] = true;
+                        isChanged = true;
+                    }
+                }
+            }
+            while(isChanged);
+
+            for(idxNode=pDef->noPorts; idxNode<pSubcircuit->noNodes; ++idxNode)
+            {
+                if(!isConnectedAry[idxNode])
+                    isPassiveOnePort = false;
+            }
+        } /* End if(Still a candidate?) */
+
+        isPassiveOnePortAry[idxDef] = isPassiveOnePort;
+
+    } /* End for(All subcircuits) */
+
+    /* A map from the nodes and devices of the circuit onto the instances, which they belong
+       to. The ports are not owned by an instance. */
+    unsigned int * const idxInstanceOfNodeAry = smalloc( pParseResult->noNodes
+                                                         * sizeof(unsigned int)
+                                                       , __FILE__
+                                                       , __LINE__
+                                                       )
+               , * const idxInstanceOfDevAry = smalloc( pParseResult->noDevices
+                                                        * sizeof(unsigned int)
+                                                      , __FILE__
+                                                      , __LINE__
+                                                      );
+    unsigned int u;
+    for(u=0; u<pParseResult->noNodes; ++u)
+        idxInstanceOfNodeAry[u] = UINT_MAX;
+    for(u=0; u<pParseResult->noDevices; ++u)
+        idxInstanceOfDevAry[u] = UINT_MAX;
+
+    unsigned int idxInst;
+    for(idxInst=0; idxInst<pParseResult->noSubcircuitInstances; ++idxInst)
+    {
+        pci_subcircuitInstance_t * const pInst = &pParseResult->subcircuitInstanceAry[idxInst];
+        const pci_subcircuitDef_t * const pDef =
+                                    &pParseResult->subcircuitDefAry[pInst->idxSubcircuitDef];
+        for(u=pDef->noPorts; u<pDef->pCircuit->noNodes; ++u)
+            idxInstanceOfNodeAry[pInst->idxNodeAry[u]] = idxInst;
+        for(u=0; u<pDef->pCircuit->noDevices; ++u)
+            idxInstanceOfDevAry[pInst->idxFirstDevice+u] = idxInst;
+
+        pInst->isReducible = isPassiveOnePortAry[pInst->idxSubcircuitDef];
+    }
+
+    /* A reference to an internal node from outside of its instance inhibits the
+       reduction. */
+    for(u=0; u<pParseResult->noDevices; ++u)
+    {
+        const pci_device_t * const pDev = pParseResult->pDeviceAry[u];
+        const unsigned int idxNodeAry[] = { pDev->idxNodeFrom
+                                          , pDev->idxNodeTo
+                                          , pDev->idxNodeOpOut
+                                          , pDev->idxNodeCtrlPlus
+                                          , pDev->idxNodeCtrlMinus
+                                          };
+        unsigned int idxRef;
+        for(idxRef=0; idxRef<sizeof(idxNodeAry)/sizeof(idxNodeAry[0]); ++idxRef)
+        {
+            checkReferenceOfNode( pParseResult
+                                , idxInstanceOfNodeAry
+                                , idxNodeAry[idxRef]
+                                , /* idxInstanceOfRef */ idxInstanceOfDevAry[u]
+                                );
+        }
+    }
+    for(u=0; u<pParseResult->noVoltageDefs; ++u)
+    {
+        checkReferenceOfNode( pParseResult
+                            , idxInstanceOfNodeAry
+                            , pParseResult->voltageDefAry[u].idxNodePlus
+                            , /* idxInstanceOfRef */ UINT_MAX
+                            );
+        checkReferenceOfNode( pParseResult
+                            , idxInstanceOfNodeAry
+                            , pParseResult->voltageDefAry[u].idxNodeMinus
+                            , /* idxInstanceOfRef */ UINT_MAX
+                            );
+    }
+
+    /* The results reference the voltages of nodes by the names of the unknowns of the LES,
+       which are derived from the node names. */
+    const size_t lenPrefix = sizeof(SYMBOL_PREFIX_VOLTAGE)-1;
+    for(u=0; u<pParseResult->noResultDefs; ++u)
+    {
+        const pci_resultDef_t * const pResultDef = &pParseResult->resultDefAry[u];
+        unsigned int idxName;
+        for(idxName=0; idxName<=pResultDef->noDependents; ++idxName)
+        {
+            const char * const name = idxName < pResultDef->noDependents
+                                      ? pResultDef->dependentNameAry[idxName]
+                                      : pResultDef->independentName;
+            if(name != NULL  &&  strncmp(name, SYMBOL_PREFIX_VOLTAGE, lenPrefix) == 0)
+            {
+                checkReferenceOfNode( pParseResult
+                                    , idxInstanceOfNodeAry
+                                    , findNodeByName(pParseResult, name+lenPrefix)
+                                    , /* idxInstanceOfRef */ UINT_MAX
+                                    );
+            }
+        }
+    }
+
+    for(idxInst=0; idxInst<pParseResult->noSubcircuitInstances; ++idxInst)
+    {
+        const pci_subcircuitInstance_t * const pInst =
+                                            &pParseResult->subcircuitInstanceAry[idxInst];
+        LOG_DEBUG( _log
+                 , "Subcircuit instance %s of %s %s be represented by a port model"
+                 , pInst->name
+                 , pParseResult->subcircuitDefAry[pInst->idxSubcircuitDef].name
+                 , pInst->isReducible? "can": "can't"
+                 )
+    }
+
+    free(idxInstanceOfNodeAry);
+    free(idxInstanceOfDevAry);
+
+} /* End of findReducibleInstances */
+
+
+
+
+/**
+ * Continue the computation of a hash code with another integer value. The FNV-1a hash
+ * algorithm of 64 Bit is applied to the eight bytes of the value, least significant byte
+ * first. This makes the hash code independent of the byte order of the machine.
+ *   @return
+ * Get the updated hash code.
+ *   @param hash
+ * The hash code so far.
+ *   @param value
+ * The hashed value.
+ */
+
+static unsigned long long hashValue(unsigned long long hash, unsigned long long value)
+{
+    unsigned int u;
+    for(u=0; u<8; ++u)
+    {
+        hash ^= value & 0xffull;
+        hash *= 0x100000001b3ull;
+        value >>= 8;
+    }
+    return hash;
+
+} /* End of hashValue */
+
+
+
+
+/**
+ * Continue the computation of a hash code with a character string. The terminating zero
+ * byte is hashed, too; this way, the concatenation of two strings can't have the same
+ * hash code as another split of the same characters.
+ *   @return
+ * Get the updated hash code.
+ *   @param hash
+ * The hash code so far.
+ *   @param str
+ * The hashed string. NULL is permitted and hashed like an empty string.
+ */
+
+static unsigned long long hashString(unsigned long long hash, const char *str)
+{
+    if(str != NULL)
+    {
+        while(*str != '\0')
+        {
+            hash ^= (unsigned char)*str++;
+            hash *= 0x100000001b3ull;
+        }
+    }
+    hash *= 0x100000001b3ull;
+    return hash;
+
+} /* End of hashString */
+
+
+
+
 /**
  * Initialize the module at application startup.
  *   @remark
@@ -2418,27 +3647,29 @@ void pci_shutdownModule()
 
 
 /**
- * Parse the input file.
+ * Parse a circuit file or a circuit held in memory. This is the common implementation of
+ * pci_parseCircuitFile and pci_parseCircuitBuffer.
  *   @return
- * The function returns true if the file could be parsed entirely error free. If it returns
- * false than all according error messages and hints have been written to the log file.
+ * The function returns true if the input could be parsed entirely error free.
  *   @param hLogger
- * The handle to an opened and configured logger is passed to the function. All progressa
- * and result messages are written to the logger.
+ * The logger to write all progress and result messages to.
  *   @param ppParseResult
- * The pointer to the parse result object is placed in \a * ppParseResult. After usage the
- * reference to the data structure needs to be released with \a pci_deleteParseResult.\n
- *   The returned pointer is valid only if the function returns true.
+ * The pointer to the parse result object is placed in \a * ppParseResult.
  *   @param inputFileName
- * The name of the circuit file to parse.
- *   @see const pci_circuit_t *pci_cloneByConstReference(const pci_circuit_t * const)
- *   @see void pci_deleteParseResult(const pci_deviceRelation_t *pParseResult)
+ * The name of the circuit file to parse or the name of the circuit in memory. The name
+ * decides about the format of the input, see pci_parseCircuitBuffer.
+ *   @param netlist
+ * The circuit as text in memory or NULL if the file \a inputFileName is parsed.
+ *   @param sizeOfNetlist
+ * The number of characters in \a netlist. Not used if \a netlist is NULL.
  */
 
-boolean pci_parseCircuitFile( log_hLogger_t hLogger
-                            , const pci_circuit_t * * const ppParseResult
-                            , const char * const inputFileName
-                            )
+static boolean parseCircuit( log_hLogger_t hLogger
+                           , const pci_circuit_t * * const ppParseResult
+                           , const char * const inputFileName
+                           , const char * const netlist
+                           , size_t sizeOfNetlist
+                           )
 {
     boolean parseError = false;
 
@@ -2457,7 +3688,7 @@ boolean pci_parseCircuitFile( log_hLogger_t hLogger
     else
         _strcmp = stricmp;
 
-    if(!parseError && !openInput(inputFileName, /* open */ true))
+    if(!parseError && !openInput(inputFileName, netlist, sizeOfNetlist, /* open */ true))
         parseError = true;
     else
     {
@@ -2472,8 +3703,11 @@ boolean pci_parseCircuitFile( log_hLogger_t hLogger
     pci_plotInfo_t *pPlotInfoOld = NULL;
     if(!parseError)
     {
-        /* Create result structure. */
+        /* Create result structure and the indexes for the lookup of nodes and devices by
+           name. */
         pParseResult = createParseResult();
+        initNameIndex(&_nodeNameIndex);
+        initNameIndex(&_deviceNameIndex);
 
         /* Start counting the tags "U1" in the old format. */
         _noOldStyleInputDefs = 0;
@@ -2542,6 +3776,15 @@ boolean pci_parseCircuitFile( log_hLogger_t hLogger
                     recognized = true;
                     parseDeviceDef(pParseResult);
                 }
+                else if(_isStdFormat &&  _strcmp(_token.value.identifier, "X") == 0)
+                {
+                    /* An instance of a subcircuit follows. */
+                    recognized = true;
+                    parseSubcircuitInstance( pParseResult
+                                           , /* pCircuit */ pParseResult
+                                           , /* nameOfSubcircuitDef */ NULL
+                                           );
+                }
             } /* End if(Device definition?) */
 
 
@@ -2586,6 +3829,17 @@ boolean pci_parseCircuitFile( log_hLogger_t hLogger
             }
 
 
+            /* The standard format supports the definition of subcircuits. The definition
+               spans several lines. */
+            if(!recognized && _isStdFormat &&  _token.type == tokenTypeSubcircuitDef)
+            {
+                recognized = true;
+
+                getToken();
+                parseSubcircuitDef(pParseResult);
+            }
+
+
             /* A comment line, defined by a leading asterisk. Only defined in the old
                format. */
             if(!recognized && !_isStdFormat && _token.type == '*')
@@ -2639,6 +3893,11 @@ boolean pci_parseCircuitFile( log_hLogger_t hLogger
     if(!parseError && !checkNodeReferences(pParseResult))
         parseError = true;
 
+    /* Decide, which subcircuit instances can be represented by a port model. The name
+       index of the nodes is still required. */
+    if(!parseError)
+        findReducibleInstances(pParseResult);
+
     /* The elder format demands to define a single input voltage and this is implicitly
        part of the only result definition. Double-check the found number. */
     if(!_isStdFormat && !parseError &&  _noOldStyleInputDefs != 1)
@@ -2664,21 +3923,19 @@ boolean pci_parseCircuitFile( log_hLogger_t hLogger
         if(pParseResult->noVoltageDefs == 1)
         {
             /* Demand a plot result for the input impedance Z = U1(I_U1). */
-            pci_resultDef_t *pResDef = &pParseResult->resultDefAry[pParseResult->noResultDefs];
+            pci_resultDef_t *pResDef = openResultDef(pParseResult);
 
             pResDef->name = stralloccpy("Z");
-            pResDef->noDependents = 1;
-            pResDef->dependentNameAry[0] = stralloccpy("U1"); /* U1 is a known in any *.ckt */
+            addDependent(pResDef, stralloccpy("U1")); /* U1 is a known in any *.ckt */
             pResDef->independentName = stralloccpy("I_U1"); /* I_U1 is internally derived */
             pResDef->pPlotInfo = pPlotInfoOld;              /* from U1 */
             ++ pParseResult->noResultDefs;
 
             /* Demand a plot result for the one and only output voltage. It is shown as
                function of the one and only input voltage: G = U2(U1). */
-            ++ pResDef;
+            pResDef = openResultDef(pParseResult);
             pResDef->name = stralloccpy("G");
-            pResDef->noDependents = 1;
-            pResDef->dependentNameAry[0] = stralloccpy("U2");
+            addDependent(pResDef, stralloccpy("U2"));
             pResDef->independentName = stralloccpy("U1"); /* U1 is a known in a valid *.ckt */
 
             /* Each result has its own plot information. Make a deep copy of the object if
@@ -2712,8 +3969,13 @@ boolean pci_parseCircuitFile( log_hLogger_t hLogger
     if(pPlotInfoOld != NULL)
         free(pPlotInfoOld);
 
+    /* The name indexes are not part of the parse result, they are needed only while
+       parsing. */
+    deleteNameIndex(&_nodeNameIndex);
+    deleteNameIndex(&_deviceNameIndex);
+
     /* Try to close input file, even in case of failures. */
-    openInput(inputFileName, /* open */ false);
+    openInput(inputFileName, netlist, sizeOfNetlist, /* open */ false);
 
     if(parseError)
         LOG_ERROR(_log, "Reading circuit file %s failed", inputFileName)
@@ -2734,11 +3996,88 @@ boolean pci_parseCircuitFile( log_hLogger_t hLogger
 
     return !parseError;
 
+} /* End of parseCircuit */
+
+
+
+
+/**
+ * Parse the input file.
+ *   @return
+ * The function returns true if the file could be parsed entirely error free. If it returns
+ * false than all according error messages and hints have been written to the log file.
+ *   @param hLogger
+ * The handle to an opened and configured logger is passed to the function. All progressa
+ * and result messages are written to the logger.
+ *   @param ppParseResult
+ * The pointer to the parse result object is placed in \a * ppParseResult. After usage the
+ * reference to the data structure needs to be released with \a pci_deleteParseResult.\n
+ *   The returned pointer is valid only if the function returns true.
+ *   @param inputFileName
+ * The name of the circuit file to parse.
+ *   @see const pci_circuit_t *pci_cloneByConstReference(const pci_circuit_t * const)
+ *   @see void pci_deleteParseResult(const pci_deviceRelation_t *pParseResult)
+ */
+
+boolean pci_parseCircuitFile( log_hLogger_t hLogger
+                            , const pci_circuit_t * * const ppParseResult
+                            , const char * const inputFileName
+                            )
+{
+    return parseCircuit( hLogger
+                       , ppParseResult
+                       , inputFileName
+                       , /* netlist */ NULL
+                       , /* sizeOfNetlist */ 0
+                       );
+
 } /* End of pci_parseCircuitFile */
 
 
 
 
+/**
+ * Parse a circuit, which is held in memory as text. The syntax is the same as of a
+ * circuit file. This function is meant for applications, which embed linNet and which
+ * generate or receive the netlist without writing it into a file.
+ *   @return
+ * The function returns true if the netlist could be parsed entirely error free. If it
+ * returns false than all according error messages and hints have been written to the log.
+ *   @param hLogger
+ * The handle to an opened and configured logger is passed to the function. All progress
+ * and result messages are written to the logger.
+ *   @param ppParseResult
+ * The pointer to the parse result object is placed in \a * ppParseResult. After usage the
+ * reference to the data structure needs to be released with \a pci_deleteParseResult.\n
+ *   The returned pointer is valid only if the function returns true.
+ *   @param circuitName
+ * The name of the circuit. It is used for logging and it decides about the format like
+ * the name of a circuit file does: A name with extension .ckt selects the elder, case
+ * insensitive format.
+ *   @param netlist
+ * The text of the circuit. It doesn't need to be null terminated. The buffer is no longer
+ * used after return.
+ *   @param sizeOfNetlist
+ * The number of characters in \a netlist.
+ *   @see boolean pci_parseCircuitFile(log_hLogger_t, const pci_circuit_t * * const, const
+ * char * const)
+ */
+
+boolean pci_parseCircuitBuffer( log_hLogger_t hLogger
+                              , const pci_circuit_t * * const ppParseResult
+                              , const char * const circuitName
+                              , const char * const netlist
+                              , size_t sizeOfNetlist
+                              )
+{
+    assert(netlist != NULL);
+    return parseCircuit(hLogger, ppParseResult, circuitName, netlist, sizeOfNetlist);
+
+} /* End of pci_parseCircuitBuffer */
+
+
+
+
 /**
  * Request a reference to a parse result object. The new reference is counted internally for
  * later and safe control of the delete operation.\n
@@ -2803,13 +4142,16 @@ void pci_deleteParseResult(const pci_circuit_t *pParseResult)
         unsigned int u;
         for(u=0; u<pParseResult->noNodes; ++u)
             free((void*)pParseResult->nodeNameAry[u]);
+        free((void*)pParseResult->nodeNameAry);
         for(u=0; u<pParseResult->noDevices; ++u)
         {
             free((char*)pParseResult->pDeviceAry[u]->name);
             free((void*)pParseResult->pDeviceAry[u]);
         }
+        free((void*)pParseResult->pDeviceAry);
         for(u=0; u<pParseResult->noVoltageDefs; ++u)
             free((char*)pParseResult->voltageDefAry[u].name);
+        free((void*)pParseResult->voltageDefAry);
 
         for(u=0; u<pParseResult->noResultDefs; ++u)
         {
@@ -2825,9 +4167,24 @@ void pci_deleteParseResult(const pci_circuit_t *pParseResult)
             }
             if(pResDef->independentName != NULL)
                 free((char*)pResDef->independentName);
+            free((void*)pResDef->dependentNameAry);
             if(pResDef->pPlotInfo != NULL)
                 free((void*)pResDef->pPlotInfo);
         }
+        free((void*)pParseResult->resultDefAry);
+
+        for(u=0; u<pParseResult->noSubcircuitDefs; ++u)
+        {
+            free((char*)pParseResult->subcircuitDefAry[u].name);
+            pci_deleteParseResult(pParseResult->subcircuitDefAry[u].pCircuit);
+        }
+        free((void*)pParseResult->subcircuitDefAry);
+        for(u=0; u<pParseResult->noSubcircuitInstances; ++u)
+        {
+            free((char*)pParseResult->subcircuitInstanceAry[u].name);
+            free(pParseResult->subcircuitInstanceAry[u].idxNodeAry);
+        }
+        free((void*)pParseResult->subcircuitInstanceAry);
 
         free((void*)pParseResult);
 
@@ -2858,6 +4215,168 @@ const char *pci_getNameOfDeviceType(const pci_device_t * const pDevice)
 
 
 
+/**
+ * Hash the network of a circuit: the nodes, the devices and the relations between
+ * devices. This is the part of the circuit, which the symbolic elimination depends on.
+ *   @return
+ * Get the updated hash code.
+ *   @param hash
+ * The hash code so far.
+ *   @param pCircuit
+ * The parse result.
+ */
+
+static unsigned long long hashNetwork( unsigned long long hash
+                                     , const pci_circuit_t * const pCircuit
+                                     )
+{
+    unsigned int u;
+    hash = hashValue(hash, pCircuit->noNodes);
+    for(u=0; u<pCircuit->noNodes; ++u)
+        hash = hashString(hash, pCircuit->nodeNameAry[u]);
+
+    hash = hashValue(hash, pCircuit->noDevices);
+    for(u=0; u<pCircuit->noDevices; ++u)
+    {
+        const pci_device_t * const pDev = pCircuit->pDeviceAry[u];
+        hash = hashValue(hash, (unsigned)pDev->type);
+        hash = hashString(hash, pDev->name);
+        hash = hashValue(hash, pDev->idxNodeFrom);
+        hash = hashValue(hash, pDev->idxNodeTo);
+        hash = hashValue(hash, pDev->idxNodeOpOut);
+        hash = hashValue(hash, pDev->idxNodeCtrlPlus);
+        hash = hashValue(hash, pDev->idxNodeCtrlMinus);
+        hash = hashValue(hash, pDev->idxCurrentProbe);
+        hash = hashValue(hash, pDev->devRelation.idxDeviceRef);
+        if(pDev->devRelation.idxDeviceRef != PCI_NULL_DEVICE)
+        {
+            /* The factor of the relation is hashed in its canonical form, with cancelled
+               common divisor and positive denominator. */
+            rat_num_t factor = pDev->devRelation.factorRef;
+            rat_signed_int gcd = rat_gcd(factor.n, factor.d);
+            if(gcd == 0)
+                gcd = 1;
+            if((factor.d < 0) != (gcd < 0))
+                gcd = -gcd;
+            hash = hashValue(hash, (unsigned long long)(signed long long)(factor.n / gcd));
+            hash = hashValue(hash, (unsigned long long)(signed long long)(factor.d / gcd));
+        }
+
+        /* A numeric device value is part of the LES. Symbolic devices don't contribute,
+           their circuits keep their hash codes. */
+        if(pDev->isNumeric)
+        {
+            unsigned long long valueBits;
+            assert(sizeof(valueBits) == sizeof(pDev->numValue));
+            memcpy(&valueBits, &pDev->numValue, sizeof(valueBits));
+            hash = hashValue(hash, valueBits);
+        }
+    }
+
+    /* The subcircuit instances, which are represented by a port model, change the LES.
+       Flat circuits are not affected; they keep their hash codes. */
+    if(pCircuit->noSubcircuitInstances > 0)
+    {
+        hash = hashValue(hash, pCircuit->noSubcircuitInstances);
+        for(u=0; u<pCircuit->noSubcircuitInstances; ++u)
+        {
+            const pci_subcircuitInstance_t * const pInst = &pCircuit->subcircuitInstanceAry[u];
+            hash = hashValue(hash, pInst->idxSubcircuitDef);
+            hash = hashValue(hash, pInst->idxFirstDevice);
+            hash = hashValue(hash, (unsigned)pInst->isReducible);
+        }
+    }
+
+    return hash;
+
+} /* End of hashNetwork */
+
+
+
+
+/**
+ * Compute a hash code of a circuit, which identifies its symbolic solution. The hash code
+ * is computed from the canonical parse result rather than from the circuit file; it
+ * doesn't change if only comments, white space or the order of definitions on a line of
+ * the circuit file change.\n
+ *   The hash code covers all information, which the symbolic solution of the LES
+ * depends on: the topology of the network, the types of the devices, the relations
+ * between devices and the user-defined voltages and results. The names of nodes and
+ * devices are covered, too, since they determine the order of the unknowns and constants
+ * in the solution. The values of the devices, which are declared \a numeric, are covered
+ * as well; they are substituted into the LES and become part of its symbolic solution.
+ * Not covered are the values of all other devices and the plot information; they only
+ * matter for the evaluation of the solution.
+ *   @return
+ * Get the hash code as an unsigned 64 Bit integer.
+ *   @param pCircuit
+ * The parse result as got from pci_parseCircuitFile.
+ */
+
+unsigned long long pci_getHashOfCircuit(const pci_circuit_t * const pCircuit)
+{
+    /* The offset basis of the FNV-1a hash algorithm of 64 Bit. The version of the hashed
+       data layout is hashed first; it needs to be changed if the set of hashed
+       information changes. */
+    unsigned long long hash = 0xcbf29ce484222325ull;
+    hash = hashValue(hash, /* version */ 1);
+    hash = hashNetwork(hash, pCircuit);
+
+    unsigned int u;
+    hash = hashValue(hash, pCircuit->noVoltageDefs);
+    for(u=0; u<pCircuit->noVoltageDefs; ++u)
+    {
+        const pci_voltageDef_t * const pVoltageDef = &pCircuit->voltageDefAry[u];
+        hash = hashString(hash, pVoltageDef->name);
+        hash = hashValue(hash, pVoltageDef->idxNodePlus);
+        hash = hashValue(hash, pVoltageDef->idxNodeMinus);
+    }
+
+    hash = hashValue(hash, pCircuit->noResultDefs);
+    for(u=0; u<pCircuit->noResultDefs; ++u)
+    {
+        const pci_resultDef_t * const pResultDef = &pCircuit->resultDefAry[u];
+        hash = hashValue(hash, pResultDef->noDependents);
+        unsigned int idxDep;
+        for(idxDep=0; idxDep<pResultDef->noDependents; ++idxDep)
+            hash = hashString(hash, pResultDef->dependentNameAry[idxDep]);
+        hash = hashValue(hash, pResultDef->independentName != NULL);
+        hash = hashString(hash, pResultDef->independentName);
+    }
+
+    return hash;
+
+} /* End of pci_getHashOfCircuit */
+
+
+
+
+/**
+ * Compute a hash code of the network of a circuit. Other than pci_getHashOfCircuit, the
+ * hash code doesn't cover the user-defined voltages and results: Two circuits with same
+ * hash code of the network differ at maximum in their result definitions, voltage
+ * definitions, plot information and the values of the devices, which are not declared \a
+ * numeric. They have the same table of variables and the same solution of the LES, only
+ * different sets of unknowns may be required for their results.
+ *   @return
+ * Get the hash code as an unsigned 64 Bit integer.
+ *   @param pCircuit
+ * The parse result as got from pci_parseCircuitFile.
+ */
+
+unsigned long long pci_getHashOfNetwork(const pci_circuit_t * const pCircuit)
+{
+    /* The hash code is seeded differently to never match a hash code of a complete
+       circuit. */
+    unsigned long long hash = 0xcbf29ce484222325ull;
+    hash = hashValue(hash, /* version */ 0x100 + 1);
+    return hashNetwork(hash, pCircuit);
+
+} /* End of pci_getHashOfNetwork */
+
+
+
+
 /**
  * Render a plot information object as Octave script code. The object is represented as a M
  * code struct; the generated M code can e.g. be used as RHS of an assignment.
@@ -2879,7 +4398,7 @@ void pci_exportPlotInfoAsMCode( msc_mScript_t * const pMScript
                               )
 {
     /* Write into the stream associated with the M script object. */
-    FILE *hMFile = msc_borrowStream(pMScript);
+    ost_outputStream_t * const pStream = msc_borrowStream(pMScript);
     
     if(pPlotInfo != NULL)
     {
@@ -2904,39 +4423,39 @@ void pci_exportPlotInfoAsMCode( msc_mScript_t * const pMScript
         else if(fMin == fMax)
             noPoints = 1;
 
-        fprintf( hMFile
-               , "%sstruct( 'isLogX', %s ...\n"
-                 "%s      , 'noPoints', %lu ...\n"
-                 "%s      , 'freqMin', %.6g ... %% Hz\n"
-                 "%s      , 'freqMax', %.6g ... %% Hz\n"
-                 "%s      )"
-               , indentStr
-               , pPlotInfo->isLogX? "true": "false"
-               , indentStr
-               , noPoints
-               , indentStr
-               , fMin
-               , indentStr
-               , fMax
-               , indentStr
-               );
+        ost_printf( pStream
+                  , "%sstruct( 'isLogX', %s ...\n"
+                    "%s      , 'noPoints', %lu ...\n"
+                    "%s      , 'freqMin', %.6g ... %% Hz\n"
+                    "%s      , 'freqMax', %.6g ... %% Hz\n"
+                    "%s      )"
+                  , indentStr
+                  , pPlotInfo->isLogX? "true": "false"
+                  , indentStr
+                  , noPoints
+                  , indentStr
+                  , fMin
+                  , indentStr
+                  , fMax
+                  , indentStr
+                  );
     }               
     else
     {
         /* An empty struct having the correct structure is generated to indicate "use
            plotting defaults". */
-        fprintf( hMFile
-               , "%sstruct( 'isLogX', {} ...\n"
-                 "%s      , 'noPoints', {} ...\n"
-                 "%s      , 'freqMin', {} ...\n"
-                 "%s      , 'freqMax', {} ...\n"
-                 "%s      )"
-               , indentStr
-               , indentStr
-               , indentStr
-               , indentStr
-               , indentStr
-               );
+        ost_printf( pStream
+                  , "%sstruct( 'isLogX', {} ...\n"
+                    "%s      , 'noPoints', {} ...\n"
+                    "%s      , 'freqMin', {} ...\n"
+                    "%s      , 'freqMax', {} ...\n"
+                    "%s      )"
+                  , indentStr
+                  , indentStr
+                  , indentStr
+                  , indentStr
+                  , indentStr
+                  );
     }               
     
     /* The probable final semicolon and a newline depends on the application of the
@@ -37,32 +37,12 @@
  * Defines
  */
 
-/** The maximum number of nodes. */
-#define PCI_MAX_NO_NODES    200
-
-/** The maximum number of branches. */
-#define PCI_MAX_NO_BRANCHES 200
-
-/** The maximum number of devices. */
-#define PCI_MAX_NO_DEVICES  200
-
 /** The invalid node index. Indication, that this is not a node. */
 #define PCI_NULL_NODE   UINT_MAX
 
 /** The invalid device index. Indication, that this is not a device. */
 #define PCI_NULL_DEVICE UINT_MAX
 
-/** The maximum number of reported output voltages. */
-#define PCI_MAX_NO_VOLTAGE_DEFINITIONS  100
-
-/** The maximum number of LTI (transfer function) results. */
-#define PCI_MAX_NO_RESULTS      100
-
-/** The maximum number of dependent and independent quantities in any user defined result.
-    The limit is defined relative to other limits, but this is not a real constraint, any
-    positive number can be set. */
-#define PCI_MAX_SIZE_OF_RESULT_SETS ((COE_MAX_NO_CONST)+(PCI_MAX_NO_VOLTAGE_DEFINITIONS))
-
 
 /*
  * Global type definitions
@@ -153,6 +133,12 @@ typedef struct
     /** The numerical default value for later evaluation of the network analysis results.
         -1.0 means: "No numeric value is specified." */
     double numValue;
+
+    /** If \a true then the device value \a numValue is not kept as a symbol but it is
+        substituted as rational number into the LES before the symbolic elimination. The
+        device's symbol doesn't appear in the results. Only resistors, conductances and
+        controlled sources can be numeric. */
+    boolean isNumeric;
     
 } pci_device_t;
 
@@ -199,10 +185,13 @@ typedef struct
     /** The number of dependent quantities in the result. */
     unsigned int noDependents;
 
-    /** The name(s) of the dependent quantities. Normally this is a set of unknowns. In the
-        particular case of one dependent and one independent, this may also be a known if
-        an inverse transfer function is requested. */
-    const char *dependentNameAry[PCI_MAX_SIZE_OF_RESULT_SETS];
+    /** The number of allocated elements of \a dependentNameAry. */
+    unsigned int maxNoDependents;
+
+    /** An array of \a noDependents names of the dependent quantities. Normally this is a
+        set of unknowns. In the particular case of one dependent and one independent, this
+        may also be a known if an inverse transfer function is requested. */
+    const char * *dependentNameAry;
 
     /** The name of the independent quantity. Normally this is a known. In the particular
         case of one dependent and one independent quantity, this may also be an unknown if
@@ -219,8 +208,58 @@ typedef struct
 } pci_resultDef_t;
 
 
-/** The complete parsing result, the complete circuit. */
-typedef struct
+/** The definition of a subcircuit type. A subcircuit is a circuit of its own, which is
+    instantiated in a parent circuit by connecting its ports to nodes of the parent. */
+typedef struct pci_subcircuitDef_t
+{
+    /** The name of the subcircuit type. */
+    const char *name;
+
+    /** The number of ports. The ports are the first \a noPorts nodes of * \a pCircuit. */
+    unsigned int noPorts;
+
+    /** The nodes and devices of the subcircuit. The circuit doesn't have voltage or
+        result definitions. Instances of other subcircuits, which are used in the
+        definition of this one, are already expanded into its list of devices. */
+    const struct pci_circuit_t *pCircuit;
+
+} pci_subcircuitDef_t;
+
+
+/** An instance of a subcircuit in the circuit. The devices and the internal nodes of the
+    subcircuit are copied into the circuit; the names of the copies are prefixed with the
+    name of the instance. The circuit is still a flat net list, the instance describes,
+    where in this net list the subcircuit is found. */
+typedef struct pci_subcircuitInstance_t
+{
+    /** The name of the instance. */
+    const char *name;
+
+    /** The type of the instance as index into the array of subcircuit definitions. */
+    unsigned int idxSubcircuitDef;
+
+    /** The copies of the devices of the subcircuit are found in the array of devices of
+        the circuit beginning at this index. They have the order of the devices in the
+        subcircuit. */
+    unsigned int idxFirstDevice;
+
+    /** A malloc allocated map from the nodes of the subcircuit onto the nodes of the
+        circuit. The first elements belong to the ports. */
+    unsigned int *idxNodeAry;
+
+    /** The instance can be represented by the port model of its subcircuit: The
+        subcircuit is a two-terminal network of passive devices and no internal node of
+        the instance is referenced from outside of the instance. */
+    boolean isReducible;
+
+} pci_subcircuitInstance_t;
+
+
+/** The complete parsing result, the complete circuit.\n
+      The arrays of nodes, devices, voltage definitions and results are malloc allocated.
+    They grow as required while parsing; there is no limit of the size of a circuit other
+    than by the available memory. */
+typedef struct pci_circuit_t
 {
     /** A counter of references to this object. Used to control deletion of object. */
     unsigned int noReferencesToThis;
@@ -228,26 +267,56 @@ typedef struct
     /** The number of different nodes used to interconnect the devices. */
     unsigned int noNodes;
 
+    /** The number of allocated elements of \a nodeNameAry. */
+    unsigned int maxNoNodes;
+
     /** An array of \a noNodes names of nodes. */
-    const char * nodeNameAry[PCI_MAX_NO_NODES];
+    const char * *nodeNameAry;
 
     /** The number of different devices interconnected in the circuit. */
     unsigned int noDevices;
 
-    /** An array of references to objects describing a device. */
-    const pci_device_t * pDeviceAry[PCI_MAX_NO_DEVICES];
+    /** The number of allocated elements of \a pDeviceAry. */
+    unsigned int maxNoDevices;
+
+    /** An array of \a noDevices references to objects describing a device. */
+    const pci_device_t * *pDeviceAry;
 
     /** The number of output voltages the user is interested in. */
     unsigned int noVoltageDefs;
 
+    /** The number of allocated elements of \a voltageDefAry. */
+    unsigned int maxNoVoltageDefs;
+
     /** An array of \a noVoltageDefs voltage definitions. */
-    pci_voltageDef_t voltageDefAry[PCI_MAX_NO_VOLTAGE_DEFINITIONS];
+    pci_voltageDef_t *voltageDefAry;
 
     /** The number of user defined LTI (Transfer function) results. */
     unsigned int noResultDefs;
 
+    /** The number of allocated elements of \a resultDefAry. */
+    unsigned int maxNoResultDefs;
+
     /** An array of \a noResultDefs user demanded results. */
-    pci_resultDef_t resultDefAry[PCI_MAX_SIZE_OF_RESULT_SETS];
+    pci_resultDef_t *resultDefAry;
+
+    /** The number of defined subcircuit types. */
+    unsigned int noSubcircuitDefs;
+
+    /** The number of allocated elements of \a subcircuitDefAry. */
+    unsigned int maxNoSubcircuitDefs;
+
+    /** An array of \a noSubcircuitDefs subcircuit types. */
+    pci_subcircuitDef_t *subcircuitDefAry;
+
+    /** The number of instances of subcircuits in the circuit. */
+    unsigned int noSubcircuitInstances;
+
+    /** The number of allocated elements of \a subcircuitInstanceAry. */
+    unsigned int maxNoSubcircuitInstances;
+
+    /** An array of \a noSubcircuitInstances instances of subcircuits. */
+    pci_subcircuitInstance_t *subcircuitInstanceAry;
 
 } pci_circuit_t;
 
@@ -274,6 +343,14 @@ boolean pci_parseCircuitFile( log_hLogger_t logger
                             , const char * const inputFileName
                             );
 
+/** Parse a circuit, which is held in memory as text. */
+boolean pci_parseCircuitBuffer( log_hLogger_t logger
+                              , const pci_circuit_t * * const ppParseResult
+                              , const char * const circuitName
+                              , const char * const netlist
+                              , size_t sizeOfNetlist
+                              );
+
 /** Get another reference to the same object. */
 const pci_circuit_t *pci_cloneByConstReference(const pci_circuit_t * const pParseResult);
 
@@ -284,6 +361,12 @@ void pci_deleteParseResult(const pci_circuit_t *pParseResult);
     and reporting purpose. */
 const char *pci_getNameOfDeviceType(const pci_device_t * const pDevice);
 
+/** Compute a hash code of a circuit, which identifies its symbolic solution. */
+unsigned long long pci_getHashOfCircuit(const pci_circuit_t * const pCircuit);
+
+/** Compute a hash code of the network of a circuit, which identifies its LES. */
+unsigned long long pci_getHashOfNetwork(const pci_circuit_t * const pCircuit);
+
 /** Render a plot information object as Octave script code. */
 void pci_exportPlotInfoAsMCode( msc_mScript_t * const pMScript
                               , const pci_plotInfo_t * const pPlotInfo
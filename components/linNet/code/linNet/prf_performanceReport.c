@@ -0,0 +1,781 @@
+/**
+ * @file prf_performanceReport.c
+ *   Built-in performance measurement. The processing of an input file is partitioned into
+ * phases, e.g. parsing, solving, computing the results in the frequency domain. The
+ * consumed wall-clock and CPU time are recorded per phase. The solver reports its passes
+ * through the linear equation system and, for each elimination step, the number of
+ * computed and cancelled addends and the size of the largest computed coefficient. At
+ * the end, the high-water marks of all heaps of the memory manager and the peak memory
+ * consumption of the process are queried. All of this is written as a machine-readable
+ * JSON file per input file; it permits to track the performance of the application over
+ * the revisions and to compare circuits, see the benchmark in folder test/bench.\n
+ *   The recording is disabled unless a report has been started. The overhead of the
+ * disabled module is a function call per phase or elimination step.\n
+ *   The CPU time is the time of the process. It includes the worker threads of the
+ * solver and, in a parallel batch run, the other jobs, too.
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   prf_initModule
+ *   prf_shutdownModule
+ *   prf_startReport
+ *   prf_startPhase
+ *   prf_stopPhase
+ *   prf_startSolverPass
+ *   prf_stopSolverPass
+ *   prf_recordElimStep
+ *   prf_recordSizeOfLES
+ *   prf_writeReport
+ * Local functions
+ *   getWallTime
+ *   getCpuTime
+ *   getMaxResidentSetSize
+ *   writeJsonString
+ *   writePhases
+ *   writeSolver
+ *   writeHeaps
+ */
+
+/*
+ * Include files
+ */
+
+/* clock_gettime is a POSIX extension of the C library. */
+#ifdef __unix__
+# define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <assert.h>
+#ifdef __unix__
+# include <sys/resource.h>
+#endif
+
+#include "smalloc.h"
+#include "log_logger.h"
+#include "mem_memoryManager.h"
+#include "prf_performanceReport.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Local type definitions
+ */
+
+/** The accumulated time of a phase. */
+typedef struct phaseTimer_t
+{
+    /** The number of periods of time, which the phase has been active. */
+    unsigned int noPeriods;
+
+    /** The accumulated wall-clock time in s. */
+    double wallTime;
+
+    /** The accumulated CPU time in s. */
+    double cpuTime;
+
+    /** The wall-clock time, when the current period had been started. */
+    double tiWallStart;
+
+    /** The CPU time, when the current period had been started. */
+    double tiCpuStart;
+
+    /** The phase is currently active. */
+    boolean isActive;
+
+} phaseTimer_t;
+
+
+/** The record of a pass of the solver through a linear equation system. */
+typedef struct solverPass_t
+{
+    /** The number of unknowns of the system. */
+    unsigned int m;
+
+    /** The number of columns of the system. */
+    unsigned int n;
+
+    /** The consumed wall-clock time in s. */
+    double wallTime;
+
+    /** The consumed CPU time in s. */
+    double cpuTime;
+
+    /** The index of the first elimination step of the pass in \a _elimStepAry. */
+    unsigned int idxFirstElimStep;
+
+    /** The number of recorded elimination steps. */
+    unsigned int noElimSteps;
+
+} solverPass_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** A global logger object is referenced from anywhere for writing progress messages. */
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+/** The recording is enabled between prf_startReport and prf_writeReport. */
+static THREAD_LOCAL boolean _isEnabled = false;
+
+/** The timers of all phases. */
+static THREAD_LOCAL phaseTimer_t _phaseTimerAry[prf_noPhases];
+
+/** The names of the phases in the JSON report. */
+static const char * const _nameOfPhaseAry[prf_noPhases] =
+                { [prf_phaseParse] = "parse"
+                , [prf_phaseCreateLES] = "createLES"
+                , [prf_phaseSolve] = "solve"
+                , [prf_phaseCache] = "cache"
+                , [prf_phaseLogging] = "logging"
+                , [prf_phaseFreqDomain] = "freqDomain"
+                , [prf_phaseCancellation] = "cancellation"
+                , [prf_phaseExportMCode] = "exportMCode"
+                , [prf_phaseFreqResponse] = "freqResponse"
+                };
+
+/** All recorded passes of the solver. */
+static THREAD_LOCAL solverPass_t *_solverPassAry = NULL;
+
+/** The number of entries in \a _solverPassAry. */
+static THREAD_LOCAL unsigned int _noSolverPasses = 0;
+
+/** The capacity of \a _solverPassAry. */
+static THREAD_LOCAL unsigned int _maxNoSolverPasses = 0;
+
+/** A pass of the solver is currently being recorded. It is the last one in \a
+    _solverPassAry. */
+static THREAD_LOCAL boolean _isSolverPassActive = false;
+
+/** All recorded elimination steps of all passes of the solver. */
+static THREAD_LOCAL prf_elimStep_t *_elimStepAry = NULL;
+
+/** The number of entries in \a _elimStepAry. */
+static THREAD_LOCAL unsigned int _noElimSteps = 0;
+
+/** The capacity of \a _elimStepAry. */
+static THREAD_LOCAL unsigned int _maxNoElimSteps = 0;
+
+/** The wall-clock time, when the report had been started. */
+static THREAD_LOCAL double _tiWallStartReport = 0.0;
+
+/** The CPU time, when the report had been started. */
+static THREAD_LOCAL double _tiCpuStartReport = 0.0;
+
+/** The numbers of knowns, unknowns and device constants of the LES of the circuit. */
+static THREAD_LOCAL unsigned int _noKnowns = 0
+                               , _noUnknowns = 0
+                               , _noConstants = 0;
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Get the wall-clock time.
+ *   @return
+ * The time in s since an arbitrary but fixed instance in the past.
+ */
+
+static double getWallTime(void)
+{
+#ifdef __unix__
+    struct timespec ti;
+    clock_gettime(CLOCK_MONOTONIC, &ti);
+    return (double)ti.tv_sec + 1e-9*(double)ti.tv_nsec;
+#else
+    return (double)time(NULL);
+#endif
+} /* End of getWallTime */
+
+
+
+
+/**
+ * Get the CPU time of the process.
+ *   @return
+ * The time in s since process start.
+ */
+
+static double getCpuTime(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+
+} /* End of getCpuTime */
+
+
+
+
+/**
+ * Get the peak memory consumption of the process.
+ *   @return
+ * The maximum resident set size in kByte since process start or null if the figure is
+ * not available on the platform.
+ */
+
+static unsigned long getMaxResidentSetSize(void)
+{
+#ifdef __linux__
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+        return (unsigned long)usage.ru_maxrss;
+#endif
+    return 0;
+
+} /* End of getMaxResidentSetSize */
+
+
+
+
+/**
+ * Write a string as JSON string literal. The quotes, backslashes and control characters
+ * are escaped; e.g. the backslashes of a Windows path would otherwise corrupt the file.
+ *   @param hFile
+ * The file to write to.
+ *   @param string
+ * The string to write.
+ */
+
+static void writeJsonString(FILE * const hFile, const char *string)
+{
+    fputc('"', hFile);
+    for(; *string != '\0'; ++string)
+    {
+        const unsigned char c = (unsigned char)*string;
+        if(c == '"'  ||  c == '\\')
+            fprintf(hFile, "\\%c", c);
+        else if(c < 0x20)
+            fprintf(hFile, "\\u%04x", (unsigned)c);
+        else
+            fputc(c, hFile);
+    }
+    fputc('"', hFile);
+
+} /* End of writeJsonString */
+
+
+
+
+/**
+ * Write the timing of all phases as JSON array.
+ *   @param hFile
+ * The file to write to.
+ */
+
+static void writePhases(FILE * const hFile)
+{
+    fprintf(hFile, "  \"phases\":\n  [");
+    prf_phase_t phase;
+    for(phase=0; phase<prf_noPhases; ++phase)
+    {
+        const phaseTimer_t * const pTimer = &_phaseTimerAry[phase];
+        fprintf( hFile
+               , "%s\n    {\"name\": \"%s\", \"noPeriods\": %u, \"wallTime\": %.6f"
+                 ", \"cpuTime\": %.6f}"
+               , phase == 0? "": ","
+               , _nameOfPhaseAry[phase]
+               , pTimer->noPeriods
+               , pTimer->wallTime
+               , pTimer->cpuTime
+               );
+    }
+    fprintf(hFile, "\n  ],\n");
+
+} /* End of writePhases */
+
+
+
+
+/**
+ * Write the record of the solver as JSON object. It contains the totals and an array of
+ * passes with their elimination steps.
+ *   @param hFile
+ * The file to write to.
+ */
+
+static void writeSolver(FILE * const hFile)
+{
+    unsigned long long noProducts = 0, noAddends = 0, noSkippedElemSteps = 0
+                     , noMemoizedElemSteps = 0;
+    unsigned int maxNoAddendsOfCoef = 0;
+    unsigned int idxStep;
+    for(idxStep=0; idxStep<_noElimSteps; ++idxStep)
+    {
+        const prf_elimStep_t * const pStep = &_elimStepAry[idxStep];
+        noSkippedElemSteps += pStep->noSkippedElemSteps;
+        noMemoizedElemSteps += pStep->noMemoizedElemSteps;
+        noProducts += pStep->noProducts;
+        noAddends += pStep->noAddends;
+        if(pStep->maxNoAddendsOfCoef > maxNoAddendsOfCoef)
+            maxNoAddendsOfCoef = pStep->maxNoAddendsOfCoef;
+    }
+    fprintf( hFile
+           , "  \"solver\":\n  {\n"
+             "    \"noPasses\": %u,\n"
+             "    \"noElimSteps\": %u,\n"
+             "    \"noSkippedElemSteps\": %llu,\n"
+             "    \"noMemoizedElemSteps\": %llu,\n"
+             "    \"noProducts\": %llu,\n"
+             "    \"noAddendsCreated\": %llu,\n"
+             "    \"noAddendsCancelled\": %llu,\n"
+             "    \"maxNoAddendsOfCoef\": %u,\n"
+             "    \"passes\":\n    ["
+           , _noSolverPasses
+           , _noElimSteps
+           , noSkippedElemSteps
+           , noMemoizedElemSteps
+           , noProducts
+           , noAddends
+           , noProducts - noAddends
+           , maxNoAddendsOfCoef
+           );
+
+    unsigned int idxPass;
+    for(idxPass=0; idxPass<_noSolverPasses; ++idxPass)
+    {
+        const solverPass_t * const pPass = &_solverPassAry[idxPass];
+        fprintf( hFile
+               , "%s\n      {\"m\": %u, \"n\": %u, \"wallTime\": %.6f, \"cpuTime\": %.6f"
+                 ", \"elimSteps\":\n        ["
+               , idxPass == 0? "": ","
+               , pPass->m
+               , pPass->n
+               , pPass->wallTime
+               , pPass->cpuTime
+               );
+        for(idxStep=0; idxStep<pPass->noElimSteps; ++idxStep)
+        {
+            const prf_elimStep_t * const pStep =
+                                        &_elimStepAry[pPass->idxFirstElimStep + idxStep];
+            assert(pStep->noAddends <= pStep->noProducts);
+            fprintf( hFile
+                   , "%s\n          {\"noRows\": %u, \"noCols\": %u, \"noAddendsOfPivot\":"
+                     " %u, \"noAddendsOfDivisor\": %u, \"noSkippedElemSteps\": %u"
+                     ", \"noMemoizedElemSteps\": %u, \"noProducts\": %llu"
+                     ", \"noAddendsCreated\": %llu, \"noAddendsCancelled\": %llu"
+                     ", \"maxNoAddendsOfCoef\": %u}"
+                   , idxStep == 0? "": ","
+                   , pStep->noRows
+                   , pStep->noCols
+                   , pStep->noAddendsOfPivot
+                   , pStep->noAddendsOfDivisor
+                   , pStep->noSkippedElemSteps
+                   , pStep->noMemoizedElemSteps
+                   , pStep->noProducts
+                   , pStep->noAddends
+                   , pStep->noProducts - pStep->noAddends
+                   , pStep->maxNoAddendsOfCoef
+                   );
+        }
+        fprintf(hFile, "\n        ]\n      }");
+    }
+    fprintf(hFile, "\n    ]\n  },\n");
+
+} /* End of writeSolver */
+
+
+
+
+/**
+ * Write the statistics of all heaps of the calling thread as JSON array.
+ *   @param hFile
+ * The file to write to.
+ */
+
+static void writeHeaps(FILE * const hFile)
+{
+    fprintf(hFile, "  \"heaps\":\n  [");
+    mem_hHeap_t hHeap = MEM_HANDLE_INVALID_HEAP;
+    boolean isFirst = true;
+    while((hHeap = mem_getNextHeap(hHeap)) != MEM_HANDLE_INVALID_HEAP)
+    {
+        mem_heapStatistics_t stat;
+        mem_getStatistics(&stat, hHeap);
+        fprintf(hFile, "%s\n    {\"name\": ", isFirst? "": ",");
+        writeJsonString(hFile, stat.name);
+        fprintf( hFile
+               , ", \"sizeOfObj\": %lu, \"sizeOfHeap\": %lu, \"noUsedObjs\": %lu"
+                 ", \"maxNoUsedObjs\": %lu, \"maxSizeInUse\": %llu, \"isLinked\": %s}"
+               , (unsigned long)stat.sizeOfObj
+               , stat.sizeOfHeap
+               , stat.noUsedObjs
+               , stat.maxNoUsedObjs
+               , (unsigned long long)stat.maxNoUsedObjs * stat.sizeOfObj
+               , stat.isLinked? "true": "false"
+               );
+        isFirst = false;
+    }
+    fprintf(hFile, "\n  ]\n");
+
+} /* End of writeHeaps */
+
+
+
+
+/**
+ * Initialize the module at application startup.
+ *   @param hLogger
+ * This module will use the passed logger object for all reporting during application life
+ * time. It must be a real object, LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT is not permitted.
+ *   @remark
+ * Do not forget to call the counterpart at application end.
+ *   @remark
+ * This module depends on the other module log_logger. It needs to be initialized after
+ * this other module.
+ *   @remark Using this function is not an option but a must. You need to call it
+ * prior to any other call of this module and prior to accessing any of its global data
+ * objects.
+ *   @see void prf_shutdownModule()
+ */
+
+void prf_initModule(log_hLogger_t hLogger)
+{
+    assert(hLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+    _log = log_cloneByReference(hLogger);
+    _isEnabled = false;
+
+} /* End of prf_initModule */
+
+
+
+
+/**
+ * Do all cleanup after use of the module, which is required to avoid memory leaks,
+ * orphaned handles, etc.
+ */
+
+void prf_shutdownModule()
+{
+    free(_solverPassAry);
+    _solverPassAry = NULL;
+    _noSolverPasses = 0;
+    _maxNoSolverPasses = 0;
+    free(_elimStepAry);
+    _elimStepAry = NULL;
+    _noElimSteps = 0;
+    _maxNoElimSteps = 0;
+    _isEnabled = false;
+
+    /* Discard reference to the logger object. */
+    log_deleteLogger(_log);
+    _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+} /* End of prf_shutdownModule */
+
+
+
+
+/**
+ * Begin recording the performance data of an input file. All records of a previous file
+ * are discarded and the high-water marks of all heaps are reset.
+ */
+
+void prf_startReport()
+{
+    _isEnabled = true;
+    _tiWallStartReport = getWallTime();
+    _tiCpuStartReport = getCpuTime();
+    _noKnowns = _noUnknowns = _noConstants = 0;
+    memset(&_phaseTimerAry[0], 0, sizeof(_phaseTimerAry));
+    _noSolverPasses = 0;
+    _isSolverPassActive = false;
+    _noElimSteps = 0;
+
+    mem_hHeap_t hHeap = MEM_HANDLE_INVALID_HEAP;
+    while((hHeap = mem_getNextHeap(hHeap)) != MEM_HANDLE_INVALID_HEAP)
+        mem_resetHighWaterMark(hHeap);
+
+} /* End of prf_startReport */
+
+
+
+
+/**
+ * Begin the next period of time of a phase. A phase may be active several times during
+ * processing an input file; the times are accumulated. The function does nothing if no
+ * report has been started.
+ *   @param phase
+ * The phase. It must not be active yet.
+ */
+
+void prf_startPhase(prf_phase_t phase)
+{
+    if(!_isEnabled)
+        return;
+
+    assert(phase < prf_noPhases);
+    phaseTimer_t * const pTimer = &_phaseTimerAry[phase];
+    assert(!pTimer->isActive);
+    pTimer->isActive = true;
+    pTimer->tiWallStart = getWallTime();
+    pTimer->tiCpuStart = getCpuTime();
+
+} /* End of prf_startPhase */
+
+
+
+
+/**
+ * End the current period of time of a phase. The function does nothing if no report has
+ * been started.
+ *   @param phase
+ * The phase. It needs to be active.
+ *   @see void prf_startPhase(prf_phase_t)
+ */
+
+void prf_stopPhase(prf_phase_t phase)
+{
+    if(!_isEnabled)
+        return;
+
+    assert(phase < prf_noPhases);
+    phaseTimer_t * const pTimer = &_phaseTimerAry[phase];
+    assert(pTimer->isActive);
+    pTimer->isActive = false;
+    pTimer->wallTime += getWallTime() - pTimer->tiWallStart;
+    pTimer->cpuTime += getCpuTime() - pTimer->tiCpuStart;
+    ++ pTimer->noPeriods;
+
+} /* End of prf_stopPhase */
+
+
+
+
+/**
+ * Begin recording a pass of the solver through a linear equation system. A pass is a
+ * complete Gauss elimination. Depending on the mode of operation, the solver makes one
+ * pass or a pass per unknown or per independent subsystem. The function does nothing if
+ * no report has been started.
+ *   @param m
+ * The number of unknowns of the system.
+ *   @param n
+ * The number of columns of the system.
+ */
+
+void prf_startSolverPass(unsigned int m, unsigned int n)
+{
+    if(!_isEnabled)
+        return;
+
+    assert(!_isSolverPassActive);
+    if(_noSolverPasses >= _maxNoSolverPasses)
+    {
+        _maxNoSolverPasses = _maxNoSolverPasses > 0? 2*_maxNoSolverPasses: 16;
+        _solverPassAry = srealloc( _solverPassAry
+                                 , _maxNoSolverPasses * sizeof(_solverPassAry[0])
+                                 , __FILE__
+                                 , __LINE__
+                                 );
+    }
+    solverPass_t * const pPass = &_solverPassAry[_noSolverPasses++];
+    pPass->m = m;
+    pPass->n = n;
+    pPass->idxFirstElimStep = _noElimSteps;
+    pPass->noElimSteps = 0;
+
+    /* The duration is accumulated from negative start time. */
+    pPass->wallTime = -getWallTime();
+    pPass->cpuTime = -getCpuTime();
+    _isSolverPassActive = true;
+
+} /* End of prf_startSolverPass */
+
+
+
+
+/**
+ * End recording the current pass of the solver. The function does nothing if no report
+ * has been started.
+ */
+
+void prf_stopSolverPass()
+{
+    if(!_isEnabled)
+        return;
+
+    assert(_isSolverPassActive  &&  _noSolverPasses > 0);
+    solverPass_t * const pPass = &_solverPassAry[_noSolverPasses-1];
+    pPass->wallTime += getWallTime();
+    pPass->cpuTime += getCpuTime();
+    _isSolverPassActive = false;
+
+} /* End of prf_stopSolverPass */
+
+
+
+
+/**
+ * Record the statistics of an elimination step of the current pass of the solver. The
+ * function does nothing if no report has been started.
+ *   @param pElimStep
+ * The statistics. They are copied.
+ */
+
+void prf_recordElimStep(const prf_elimStep_t * const pElimStep)
+{
+    if(!_isEnabled)
+        return;
+
+    assert(_isSolverPassActive  &&  _noSolverPasses > 0);
+    if(_noElimSteps >= _maxNoElimSteps)
+    {
+        _maxNoElimSteps = _maxNoElimSteps > 0? 2*_maxNoElimSteps: 256;
+        _elimStepAry = srealloc( _elimStepAry
+                               , _maxNoElimSteps * sizeof(_elimStepAry[0])
+                               , __FILE__
+                               , __LINE__
+                               );
+    }
+    _elimStepAry[_noElimSteps++] = *pElimStep;
+    ++ _solverPassAry[_noSolverPasses-1].noElimSteps;
+
+} /* End of prf_recordElimStep */
+
+
+
+
+/**
+ * Record the size of the linear equation system of the circuit. The size permits to chart
+ * the performance figures of different circuits. The function does nothing if no report
+ * has been started.
+ *   @param noKnowns
+ * The number of known, independent quantities, i.e. the sources.
+ *   @param noUnknowns
+ * The number of unknowns.
+ *   @param noConstants
+ * The number of device constants.
+ */
+
+void prf_recordSizeOfLES( unsigned int noKnowns
+                        , unsigned int noUnknowns
+                        , unsigned int noConstants
+                        )
+{
+    if(!_isEnabled)
+        return;
+
+    _noKnowns = noKnowns;
+    _noUnknowns = noUnknowns;
+    _noConstants = noConstants;
+
+} /* End of prf_recordSizeOfLES */
+
+
+
+
+/**
+ * End recording the performance data of an input file and write them as a JSON file.
+ *   @return
+ * \a true if the file could be written, \a false otherwise. An error has been reported in
+ * the latter case.
+ *   @param fileName
+ * The name of the file. An existing file is overwritten.
+ *   @param circuitFileName
+ * The name of the processed input file. It is put into the report.
+ *   @param success
+ * The outcome of processing the input file. It is put into the report. The performance
+ * data of a failing input file are incomplete; e.g. an aborted solver doesn't finish its
+ * last pass.
+ */
+
+boolean prf_writeReport( const char * const fileName
+                       , const char * const circuitFileName
+                       , boolean success
+                       )
+{
+    assert(_isEnabled);
+    _isEnabled = false;
+
+    /* A phase, which is still active, is an error in the calling code. A pass of the
+       solver can be left open by an error. */
+#ifdef DEBUG
+    prf_phase_t phase;
+    for(phase=0; phase<prf_noPhases; ++phase)
+        assert(!_phaseTimerAry[phase].isActive);
+#endif
+    assert(!_isSolverPassActive  ||  !success);
+    _isSolverPassActive = false;
+
+    FILE * const hFile = fopen(fileName, "w");
+    if(hFile == NULL)
+    {
+        LOG_ERROR( _log
+                 , "Performance report file %s can't be opened for write access (errno:"
+                   " %d, %s)"
+                 , fileName
+                 , errno
+                 , strerror(errno)
+                 )
+        return false;
+    }
+
+    fprintf(hFile, "{\n  \"circuitFile\": ");
+    writeJsonString(hFile, circuitFileName);
+    fprintf( hFile
+           , ",\n"
+             "  \"success\": %s,\n"
+             "  \"noKnowns\": %u,\n"
+             "  \"noUnknowns\": %u,\n"
+             "  \"noConstants\": %u,\n"
+             "  \"wallTime\": %.6f,\n"
+             "  \"cpuTime\": %.6f,\n"
+             "  \"maxResidentSetSize\": %lu,\n"
+           , success? "true": "false"
+           , _noKnowns
+           , _noUnknowns
+           , _noConstants
+           , getWallTime() - _tiWallStartReport
+           , getCpuTime() - _tiCpuStartReport
+           , getMaxResidentSetSize()
+           );
+    writePhases(hFile);
+    writeSolver(hFile);
+    writeHeaps(hFile);
+    fprintf(hFile, "}\n");
+
+    boolean successWrite = !ferror(hFile);
+    if(fclose(hFile) != 0)
+        successWrite = false;
+    if(successWrite)
+        LOG_INFO(_log, "Performance report file %s successfully written", fileName)
+    else
+    {
+        LOG_ERROR( _log
+                 , "Error while writing file %s. The file contents are possibly corrupt"
+                 , fileName
+                 )
+    }
+
+    return successWrite;
+
+} /* End of prf_writeReport */
@@ -0,0 +1,138 @@
+#ifndef PRF_PERFORMANCEREPORT_INCLUDED
+#define PRF_PERFORMANCEREPORT_INCLUDED
+/**
+ * @file prf_performanceReport.h
+ * Definition of global interface of module prf_performanceReport.c
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include "types.h"
+#include "log_logger.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Global type definitions
+ */
+
+/** The phases of processing an input file, which are timed separately. The phases are
+    not necessarily disjoint; the cancellation of fractions is done as part of logging
+    and exporting the results. */
+typedef enum { prf_phaseParse
+             , prf_phaseCreateLES
+             , prf_phaseSolve
+             , prf_phaseCache
+             , prf_phaseLogging
+             , prf_phaseFreqDomain
+             , prf_phaseCancellation
+             , prf_phaseExportMCode
+             , prf_phaseFreqResponse
+             , prf_noPhases
+             } prf_phase_t;
+
+
+/** The statistics of a single elimination step of the solver. */
+typedef struct prf_elimStep_t
+{
+    /** The number of manipulated rows. */
+    unsigned int noRows;
+
+    /** The number of manipulated columns of each row. */
+    unsigned int noCols;
+
+    /** The number of addends of the pivot element. */
+    unsigned int noAddendsOfPivot;
+
+    /** The number of addends of the known divisor. */
+    unsigned int noAddendsOfDivisor;
+
+    /** The number of elementary steps, which have been skipped because they could only
+        yield a null coefficient. */
+    unsigned int noSkippedElemSteps;
+
+    /** The number of elementary steps, whose result has been copied from another
+        elementary step with identical operands. */
+    unsigned int noMemoizedElemSteps;
+
+    /** The number of relevant products, which have been accumulated in the numerators of
+        all elementary steps. */
+    unsigned long long noProducts;
+
+    /** The number of addends of all computed coefficients. All other products have
+        cancelled out. */
+    unsigned long long noAddends;
+
+    /** The number of addends of the largest computed coefficient. */
+    unsigned int maxNoAddendsOfCoef;
+
+} prf_elimStep_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize the module prior to first use of any of its methods or global data objects. */
+void prf_initModule(log_hLogger_t hGlobalLogger);
+
+/** Shutdown of module after use. Release of memory, closing files, etc. */
+void prf_shutdownModule(void);
+
+/** Begin recording the performance data of the next input file. */
+void prf_startReport(void);
+
+/** Begin the next period of time of a phase. */
+void prf_startPhase(prf_phase_t phase);
+
+/** End the current period of time of a phase. */
+void prf_stopPhase(prf_phase_t phase);
+
+/** Begin recording a pass of the solver through a linear equation system. */
+void prf_startSolverPass(unsigned int m, unsigned int n);
+
+/** End recording the current pass of the solver. */
+void prf_stopSolverPass(void);
+
+/** Record the statistics of an elimination step of the current pass of the solver. */
+void prf_recordElimStep(const prf_elimStep_t * const pElimStep);
+
+/** Record the size of the linear equation system of the circuit. */
+void prf_recordSizeOfLES( unsigned int noKnowns
+                        , unsigned int noUnknowns
+                        , unsigned int noConstants
+                        );
+
+/** End recording and write the performance data as a JSON file. */
+boolean prf_writeReport( const char * const fileName
+                       , const char * const circuitFileName
+                       , boolean success
+                       );
+
+#endif  /* PRF_PERFORMANCEREPORT_INCLUDED */
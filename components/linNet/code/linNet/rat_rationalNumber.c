@@ -27,11 +27,16 @@
  *   rat_lcm
  *   rat_mul
  *   rat_add
+ *   rat_fromDouble
  * Local functions
  *   reportOverflow
+ *   gcdWord
+ *   countTrailingZerosLong
  *   gcdLong
  *   approximate
- *   truncate
+ *   cancelAndTruncate
+ *   isHalfWord
+ *   cancelWord
  */
 
 /*
@@ -41,6 +46,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include <assert.h>
 
 #include "types.h"
@@ -52,28 +58,39 @@
  * Defines
  */
  
-#if RAT_USE_64BIT_ARITHMETIC == 1
-/** A mask of bits in the internally used longer integer type, which must not be set in
-    proper result values. If a number bit in the mask is found to be set in the preliminary
-    result then we decide on overflow. ("Number bit" means: a set bit for positive numbers
-    and a null bit for negative numbers.) */
-# define OVF_MASK    ((signed long long)0xffffffff80000000)
+#if RAT_USE_128BIT_ARITHMETIC == 1
+/** The largest numerator or denominator of a rational number. A preliminary result, which
+    is computed in the internally used longer integer type, is checked against this limit
+    for overflow. */
+# define MAX_NUMBER  ((rat_signed_long_int)RAT_SIGNED_INT_MAX)
 
-/** A mask that filters the sign bit of the longer signed integer type. */
-# define SIGN_BIT_RAT_SIGNED_LONG ((signed long long)0x8000000000000000)
+#elif RAT_USE_64BIT_ARITHMETIC == 1
+
+# define MAX_NUMBER  ((rat_signed_long_int)0x7fffffff)
 
 #else /* Use 16/32 Bit representation of rational numbers */
 
-# define OVF_MASK                    ((signed long)0xffff8000)
-# define SIGN_BIT_RAT_SIGNED_LONG    ((signed long)0x80000000)
+# define MAX_NUMBER  ((rat_signed_long_int)0x7fff)
 
 #endif /* Short or long representation. */
 
+/** The most negative numerator of a rational number. */
+#define MIN_NUMBER  (-MAX_NUMBER-1)
+
 
 /*
  * Local type definitions
  */
  
+#if RAT_USE_128BIT_ARITHMETIC == 1
+/** The unsigned counterpart of the internally used longer integer type. It holds the
+    magnitudes of the intermediate results. */
+typedef unsigned __int128 unsignedLongInt_t;
+#elif RAT_USE_64BIT_ARITHMETIC == 1
+typedef unsigned long long unsignedLongInt_t;
+#else
+typedef unsigned long unsignedLongInt_t;
+#endif
  
 /*
  * Local prototypes
@@ -85,12 +102,14 @@
  */
  
 /** A global logger object is referenced from anywhere for writing progress messages. */
-static log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
 
 /** A global flag to indicate overflows.
       @remark Despite of its global declaration is this a module internal variable. Never
-    touch this variable from outside this module! */
-boolean rat_overflowFlag = false;
+    touch this variable from outside this module!
+      @remark The flag is thread-local. The jobs of a parallel batch run don't see the
+    overflows of one another. */
+THREAD_LOCAL boolean rat_overflowFlag = false;
 
 
 /*
@@ -118,18 +137,28 @@ static void reportOverflow(rat_signed_long_int n, rat_signed_long_int d)
            but requires %I64d, see
            http://stackoverflow.com/questions/13590735/printf-long-long-int-in-c-with-gcc,
            Feb 2014. */
-#if defined(__WIN32) || defined(__WIN64)
-# define F64D    "%I64d"
+#if RAT_USE_128BIT_ARITHMETIC == 1
+        /* There's no printf formatting character for 128 Bit integers. */
+        LOG_FATAL( _log
+                 , "Arithmetic overflow during computation. Number %.17g/%.17g"
+                   " = %.15g can't be represented by objects of class rat_num"
+                 , (double)n, (double)d
+                 , (double)n/(double)d
+                 );
 #else
-# define F64D    "%lld"
-#endif
+# if defined(__WIN32) || defined(__WIN64)
+#  define F64D    "%I64d"
+# else
+#  define F64D    "%lld"
+# endif
         LOG_FATAL( _log
                  , "Arithmetic overflow during computation. Number " F64D "/" F64D 
                    " = %.15g can't be represented by objects of class rat_num"
                  , (signed long long)n, (signed long long)d
                  , (double)n/d
                  );
-#undef F64D
+# undef F64D
+#endif
     }
 } /* End of reportOverflow */
 
@@ -137,35 +166,111 @@ static void reportOverflow(rat_signed_long_int n, rat_signed_long_int d)
 
 
 /**
- * Euclid's algorithm to find the greatest common divisor of two integer numbers. This
- * second implementation of the same algorithm is used internally to implement safe
- * overflow recognition.
+ * Stein's binary algorithm to find the greatest common divisor of two unsigned integer
+ * numbers of native machine word size.
  *   @return
- * Get the gcd of \a a and \a b. The sign of gcd is the sign of the operands if they have
- * identical sign or undefined otherwise.
- *   @param a
- * The first numeric operand, a signed integer. If \a a is null then the function returns
- * \a b.
- *   @param b
- * The second numeric operand, a signed integer. If \a b is null then the function returns
- * \a a.
+ * Get the gcd of \a u and \a v.
+ *   @param u
+ * The first numeric operand. If \a u is null then the function returns \a v.
+ *   @param v
+ * The second numeric operand. If \a v is null then the function returns \a u.
  *   @see rat_signed_int rat_gcd(rat_signed_int, rat_signed_int)
  */
 
-static inline rat_signed_long_int gcdLong(rat_signed_long_int a, rat_signed_long_int b)
+static inline unsigned long long gcdWord(unsigned long long u, unsigned long long v)
 {
-    /* See http://de.wikipedia.org/wiki/Euklidischer_Algorithmus and particularly
-       http://de.wikipedia.org/wiki/Euklidischer_Algorithmus#Beschreibung_durch_Pseudocode
-       (visited on Mar 6, 2014) for details on Euclid's algorithm. */
-    while(b != 0)
+    if(u == 0)
+        return v;
+    else if(v == 0)
+        return u;
+
+    /* See rat_gcd for details on the algorithm. */
+    const int shift = __builtin_ctzll(u | v);
+    u >>= __builtin_ctzll(u);
+    v >>= __builtin_ctzll(v);
+    while(u != v)
     {
-        /* In C99, h always has the sign of a. */
-        rat_signed_long_int h = a % b;
-        a = b;
-        b = h; 
+        const unsigned long long diff = v - u
+                               , min = u < v? u: v;
+        v = (u < v? diff: u - v) >> __builtin_ctzll(diff);
+        u = min;
     }
-    return a;
-    
+
+    return u << shift;
+
+} /* End of gcdWord */
+
+
+
+
+#if RAT_USE_128BIT_ARITHMETIC == 1
+/**
+ * Count the trailing zero bits of an integer of the internally used longer integer type.
+ *   @return
+ * Get the number of trailing zero bits.
+ *   @param a
+ * The integer. It must not be null.
+ */
+
+static inline unsigned int countTrailingZerosLong(unsignedLongInt_t a)
+{
+    assert(a != 0);
+    const unsigned long long lowWord = (unsigned long long)a;
+    if(lowWord != 0)
+        return (unsigned int)__builtin_ctzll(lowWord);
+    else
+        return 64u + (unsigned int)__builtin_ctzll((unsigned long long)(a >> 64));
+
+} /* End of countTrailingZerosLong */
+#endif
+
+
+
+
+/**
+ * Stein's binary algorithm to find the greatest common divisor of two unsigned integer
+ * numbers of the internally used longer integer type. The computation is done in the
+ * native machine word size if both operands fit into it, which is the normal case.
+ *   @return
+ * Get the gcd of \a u and \a v.
+ *   @param u
+ * The first numeric operand. If \a u is null then the function returns \a v.
+ *   @param v
+ * The second numeric operand. If \a v is null then the function returns \a u.
+ */
+
+static inline unsignedLongInt_t gcdLong(unsignedLongInt_t u, unsignedLongInt_t v)
+{
+#if RAT_USE_128BIT_ARITHMETIC == 1
+    if(((u | v) >> 64) == 0)
+        return gcdWord((unsigned long long)u, (unsigned long long)v);
+    else if(u == 0)
+        return v;
+    else if(v == 0)
+        return u;
+
+    const unsigned int shift = countTrailingZerosLong(u | v);
+    u >>= countTrailingZerosLong(u);
+    v >>= countTrailingZerosLong(v);
+    while(u != v)
+    {
+        const unsignedLongInt_t diff = v - u
+                              , min = u < v? u: v;
+        v = (u < v? diff: u - v) >> countTrailingZerosLong(diff);
+        u = min;
+
+        /* The operands shrink and the native machine word size may be used soon. */
+        if(((u | v) >> 64) == 0)
+        {
+            return (unsignedLongInt_t)gcdWord((unsigned long long)u, (unsigned long long)v)
+                   << shift;
+        }
+    }
+
+    return u << shift;
+#else
+    return gcdWord(u, v);
+#endif
 } /* End of gcdLong */
 
 
@@ -249,7 +354,9 @@ static rat_num_t approximate(rat_signed_long_int n, rat_signed_long_int d)
         
         /* If n==0 then the gcd c will become d and the correct result is represented by
            0/1, which is perfect. */
-        const rat_signed_long_int c = gcdLong(n, d);
+        const rat_signed_long_int c = (rat_signed_long_int)gcdLong( (unsignedLongInt_t)n
+                                                                  , (unsignedLongInt_t)d
+                                                                  );
         if(c != 1)
         {
             n /= c;
@@ -258,7 +365,7 @@ static rat_num_t approximate(rat_signed_long_int n, rat_signed_long_int d)
         
 //printf("n>>4: %ld, d>>4: %ld\n", n, d);
     }
-    while((n & OVF_MASK) != 0  ||  (d & OVF_MASK) != 0);
+    while(n > MAX_NUMBER  ||  d > MAX_NUMBER);
     
     /* No danger of overflow in sign inversion here, as we will only make positive numbers
        negative. */
@@ -269,7 +376,7 @@ static rat_num_t approximate(rat_signed_long_int n, rat_signed_long_int d)
     LOG_DEBUG( _log
              , "rat_rationalNumber::approximate: %.15g is approximated by %ld/%ld = %.15g"
              , number
-             , n, d
+             , (long)n, (long)d
              , (double)(rat_signed_int)n/(double)(rat_signed_int)d
              );
 #endif
@@ -282,39 +389,136 @@ static rat_num_t approximate(rat_signed_long_int n, rat_signed_long_int d)
 
 
 /**
- * Check a number for overflow. The principle is trivial. We first do the operation in an
- * integer size, which is larger than the result type. Then we test the operation result if
- * it would also fit into the shorter result type and truncate it safely. The test done by
- * this function.\n
+ * Cancel a ratio and check it for overflow. The principle is trivial. We first do the
+ * operation in an integer size, which is larger than the result type. Then we cancel the
+ * ratio and test if it would also fit into the shorter result type and truncate it
+ * safely. The test done by this function. The intermediate result is exact, an overflow
+ * is reported only if the cancelled ratio can't be represented.\n
  *   If an overflow is recognized then it is reported by side effect in the global error
  * variable, which the client can query after his computations. This way of doing is more
  * efficient than permanent return code checks but makes the operations implemented in this
  * module non re-entrant.
  *   @return
- * The safely truncated number \a a: either the same number or the (unavoidable) error has
- * been reported and an approximation of \a a is returned.
+ * The safely truncated number \a n / \a d: either the cancelled, exact number or the
+ * (unavoidable) error has been reported and an approximation is returned. The denominator
+ * of the result is positive.
  *   @param n
- * The numerator of the rational number to be checked and truncated.
+ * The numerator of the rational number to be checked and truncated. Its magnitude is less
+ * than the maximum of the longer integer type.
  *   @param d
- * The denominator of the rational number to be checked and truncated.
+ * The denominator of the rational number to be checked and truncated. It must not be null
+ * and its magnitude is less than the maximum of the longer integer type.
  */ 
 
-static inline rat_num_t truncate(rat_signed_long_int n, rat_signed_long_int d)
+static inline rat_num_t cancelAndTruncate(rat_signed_long_int n, rat_signed_long_int d)
 {
-    const rat_signed_long_int upperHalfWordN = n & OVF_MASK
-                            , upperHalfWordD = d & OVF_MASK;
-    if((upperHalfWordN == 0  ||  upperHalfWordN == OVF_MASK)
-       && (upperHalfWordD == 0  ||  upperHalfWordD == OVF_MASK)
-      )
+    assert(d != 0);
+    if(d < 0)
+    {
+        n = -n;
+        d = -d;
+    }
+    const boolean isNegative = n < 0;
+    unsignedLongInt_t absN = isNegative? -(unsignedLongInt_t)n: (unsignedLongInt_t)n
+                    , absD = (unsignedLongInt_t)d;
+
+    /* Cancel the ratio. If n is null then the gcd becomes d and we get the correct result
+       0/1. */
+    if(absD != 1)
     {
-        return (rat_num_t){.n = (rat_signed_int)n, .d=(rat_signed_int)d};
+        const unsignedLongInt_t c = gcdLong(absN, absD);
+        if(c != 1)
+        {
+#if RAT_USE_128BIT_ARITHMETIC == 1
+            /* The division of the longer integer type is emulated by a library function;
+               it is avoided if possible. */
+            if(((absN | absD) >> 64) == 0)
+            {
+                absN = (unsigned long long)absN / (unsigned long long)c;
+                absD = (unsigned long long)absD / (unsigned long long)c;
+            }
+            else
+#endif
+            {
+                absN /= c;
+                absD /= c;
+            }
+        }
     }
+
+    /* Go back to result range and check for overflow. */
+    n = isNegative? -(rat_signed_long_int)absN: (rat_signed_long_int)absN;
+    d = (rat_signed_long_int)absD;
+    if(n >= MIN_NUMBER  &&  n <= MAX_NUMBER  &&  d <= MAX_NUMBER)
+        return (rat_num_t){.n = (rat_signed_int)n, .d = (rat_signed_int)d};
     else
     {
         reportOverflow(n, d);
         return approximate(n, d);
     }
-} /* End of truncate */
+} /* End of cancelAndTruncate */
+
+
+
+
+#if RAT_USE_128BIT_ARITHMETIC == 1
+/**
+ * Check if a number is small enough to be the operand of an operation, which is done in the
+ * native machine word size rather than in the longer integer type.
+ *   @return
+ * Get \a true if the magnitudes of numerator and denominator are less than 2^31.
+ *   @param a
+ * The tested number.
+ */
+
+static inline boolean isHalfWord(rat_num_t a)
+{
+    return (unsigned long)a.n + 0x7fffffffu < 0xffffffffu
+           &&  (unsigned long)a.d + 0x7fffffffu < 0xffffffffu;
+
+} /* End of isHalfWord */
+
+
+
+
+/**
+ * Cancel a ratio, which is computed in the native machine word size from operands, which
+ * fulfill isHalfWord. This is the fast path of cancelAndTruncate: The magnitudes of \a n
+ * and \a d are less than 2^63 and no overflow can occur.
+ *   @return
+ * The cancelled ratio \a n / \a d with positive denominator.
+ *   @param n
+ * The numerator of the rational number.
+ *   @param d
+ * The denominator of the rational number. It must not be null.
+ */
+
+static inline rat_num_t cancelWord(signed long long n, signed long long d)
+{
+    assert(d != 0);
+    if(d < 0)
+    {
+        n = -n;
+        d = -d;
+    }
+
+    /* If n is null then the gcd becomes d and we get the correct result 0/1. */
+    if(d != 1)
+    {
+        const signed long long c = (signed long long)gcdWord( n<0? -(unsigned long long)n
+                                                                 : (unsigned long long)n
+                                                            , (unsigned long long)d
+                                                            );
+        if(c != 1)
+        {
+            n /= c;
+            d /= c;
+        }
+    }
+    return (rat_num_t){.n = (rat_signed_int)n, .d = (rat_signed_int)d};
+
+} /* End of cancelWord */
+#endif
 
 
 
@@ -400,8 +604,7 @@ rat_signed_int rat_lcm(rat_signed_int a, rat_signed_int b)
     
     /* Truncate result to shorter, externally known range. This can easily cause an
        overflow. */
-    const rat_signed_long_int upperHalfWordP = p & OVF_MASK;
-    if(upperHalfWordP == 0  ||  upperHalfWordP == OVF_MASK)
+    if(p >= MIN_NUMBER  &&  p <= MAX_NUMBER)
         return (rat_signed_int)p;
     else
     {
@@ -425,14 +628,23 @@ rat_signed_int rat_lcm(rat_signed_int a, rat_signed_int b)
 
 rat_num_t rat_mul(rat_num_t a, rat_num_t b)
 {
-    /* The product can be computed safely in the longer integer size. */
-    rat_signed_long_int n = (rat_signed_long_int)a.n * b.n
-                      , d = (rat_signed_long_int)a.d * b.d;
+#if RAT_USE_128BIT_ARITHMETIC == 1
+    /* Fast path: Most numbers are small and the product can be computed exactly in the
+       native machine word size. */
+    if(isHalfWord(a)  &&  isHalfWord(b))
+    {
+        return cancelWord( (signed long long)a.n * b.n
+                         , (signed long long)a.d * b.d
+                         );
+    }
+#endif
+
+    /* The product can be computed safely and exactly in the longer integer size. */
+    const rat_signed_long_int n = (rat_signed_long_int)a.n * b.n
+                            , d = (rat_signed_long_int)a.d * b.d;
     
-    /* The Euclid algorithm can safely be used in the longer integer size oto cancel the
-       ratio. */
-    rat_signed_long_int c = gcdLong(n, d);
-    return truncate(n/c, d/c);
+    /* Cancel the ratio and go back to the result range. */
+    return cancelAndTruncate(n, d);
 
 } /* End of rat_mul */
 
@@ -451,21 +663,43 @@ rat_num_t rat_mul(rat_num_t a, rat_num_t b)
 
 rat_num_t rat_add(rat_num_t a, rat_num_t b)
 {
+#if RAT_USE_128BIT_ARITHMETIC == 1
+    /* Fast path: Most numbers are small and the sum can be computed exactly in the native
+       machine word size. Each product is less than 2^62 and their sum can't overflow. */
+    if(isHalfWord(a)  &&  isHalfWord(b))
+    {
+        if(a.d == b.d)
+            return cancelWord((signed long long)a.n + b.n, a.d);
+        else
+        {
+            return cancelWord( (signed long long)a.n * b.d + (signed long long)a.d * b.n
+                             , (signed long long)a.d * b.d
+                             );
+        }
+    }
+#endif
+
+    /* The frequent case of a common denominator, particularly of two integers, doesn't
+       need any multiplication. */
+    if(a.d == b.d)
+        return cancelAndTruncate((rat_signed_long_int)a.n + b.n, a.d);
+
     /* The denominator is a product, which can safely be computed in the longer integer
        size. */
     rat_signed_long_int d = (rat_signed_long_int)a.d * b.d;
 
     /* The numerator of the sum is the sum of two products. Each of these can be safely
-       computed in the longer integer size. */
+       computed in the longer integer size. The sum is computed in unsigned arithmetic,
+       which doesn't have undefined behavior on overflow. */
     rat_signed_long_int n1 = (rat_signed_long_int)a.n * b.d
                       , n2 = (rat_signed_long_int)a.d * b.n
-                      , n = n1 + n2;
+                      , n = (rat_signed_long_int)((unsignedLongInt_t)n1
+                                                  + (unsignedLongInt_t)n2
+                                                 );
                       
     /* The sum of the two numerator terms has been safely done if both operands have
        different signs or if the sum didn't undergo a sign inversion. */
-    if(((n1^n2) & SIGN_BIT_RAT_SIGNED_LONG) == 0
-       &&  ((n^n1) & SIGN_BIT_RAT_SIGNED_LONG) != 0
-      )
+    if((n1 < 0) == (n2 < 0)  &&  (n < 0) != (n1 < 0))
     {
         /* Error: The computed sum n caused an overflow. n must not be used. */
 
@@ -480,15 +714,82 @@ rat_num_t rat_add(rat_num_t a, rat_num_t b)
         reportOverflow(n, d);
     }
 
-    /* The Euclid algorithm can safely be used in the longer integer size to cancel the
-       ratio. */
-    rat_signed_long_int c = gcdLong(n, d);
-
-    /* Go back to result range and check for overflow. */
-    return truncate(n/c, d/c);
+    /* Cancel the ratio and go back to result range and check for overflow. */
+    return cancelAndTruncate(n, d);
     
 } /* End of rat_add */
 
 
 
 
+/**
+ * Find the rational number, which is represented by a floating point number. The number
+ * is expanded into a continued fraction until a convergent is found, whose relative
+ * deviation from the number is not greater than the resolution of a decimal number with
+ * twelve significant digits. A number like 4.7e-9, which had been written in decimal
+ * notation, is found exactly, i.e. as 47/10000000000.\n
+ *   An overflow is reported if no such convergent can be represented. The last
+ * representable convergent is returned in this case; you will have to check the global
+ * error flag.
+ *   @return
+ * Get the rational number with positive denominator.
+ *   @param x
+ * The floating point number.
+ */
+
+rat_num_t rat_fromDouble(double x)
+{
+    const boolean isNegative = x < 0.0;
+    if(isNegative)
+        x = -x;
+
+    /* The convergents of the continued fraction are computed by the common recursion from
+       their two predecessors. The operands of a product are in the range of the result
+       type, the product can safely be computed in the longer integer size. */
+    rat_signed_long_int h = 1
+                      , k = 0
+                      , hPrev = 0
+                      , kPrev = 1;
+    double r = x;
+    do
+    {
+        const double a = floor(r);
+        if(a > (double)MAX_NUMBER)
+        {
+            reportOverflow((rat_signed_long_int)a, 1);
+            break;
+        }
+        const rat_signed_long_int hNext = (rat_signed_long_int)a*h + hPrev
+                                , kNext = (rat_signed_long_int)a*k + kPrev;
+        if(hNext > MAX_NUMBER  ||  kNext > MAX_NUMBER)
+        {
+            reportOverflow(hNext, kNext);
+            break;
+        }
+        hPrev = h;
+        kPrev = k;
+        h = hNext;
+        k = kNext;
+
+        /* The expansion ends if the remainder is null. */
+        if(r == a)
+            break;
+        r = 1.0 / (r - a);
+    }
+    while(fabs((double)h/(double)k - x) > 1e-12*x);
+
+    /* A number, which exceeds the range already in the first step, is approximated by the
+       largest representable number. */
+    if(k == 0)
+    {
+        h = MAX_NUMBER;
+        k = 1;
+    }
+
+    return (rat_num_t){.n = (rat_signed_int)(isNegative? -h: h), .d = (rat_signed_int)k};
+
+} /* End of rat_fromDouble */
+
+
+
+
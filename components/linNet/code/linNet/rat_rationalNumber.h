@@ -25,6 +25,7 @@
  */
 
 #include <limits.h>
+#include <assert.h>
 #include "types.h"
 #include "log_logger.h"
 
@@ -39,8 +40,20 @@
     Bit and the operations are done with 32 Bit. */
 #define RAT_USE_64BIT_ARITHMETIC    1
 
+/** If the compiler offers a 128 Bit integer type and if long int has 64 Bit then the
+    operations are done with 128 Bit and numerator and denominator can use the full range
+    of 64 Bit. Otherwise they are restricted to 32 Bit. */
+#if RAT_USE_64BIT_ARITHMETIC == 1 && defined(__SIZEOF_INT128__) && LONG_MAX > 0x7fffffffl
+# define RAT_USE_128BIT_ARITHMETIC  1
+#else
+# define RAT_USE_128BIT_ARITHMETIC  0
+#endif
+
 
-#if RAT_USE_64BIT_ARITHMETIC == 1
+#if RAT_USE_128BIT_ARITHMETIC == 1
+/** A mask that filters the sign bit of the externally known, shorter signed integer type. */
+# define RAT_SIGN_BIT_RAT_SIGNED_INT (LONG_MIN)
+#elif RAT_USE_64BIT_ARITHMETIC == 1
 /** A mask that filters the sign bit of the externally known, shorter signed integer type. */
 # define RAT_SIGN_BIT_RAT_SIGNED_INT 0x80000000l
 #else
@@ -59,7 +72,12 @@
 
 /* Range of the signed integer and longer signed integer type used in the implementation of
    rational numbers. */
-#if RAT_USE_64BIT_ARITHMETIC == 1
+#if RAT_USE_128BIT_ARITHMETIC == 1
+# define RAT_SIGNED_INT_MAX      (LONG_MAX)
+# define RAT_SIGNED_INT_MIN      (LONG_MIN)
+# define RAT_SIGNED_LONG_INT_MAX ((rat_signed_long_int)(~(unsigned __int128)0 >> 1))
+# define RAT_SIGNED_LONG_INT_MIN (-RAT_SIGNED_LONG_INT_MAX - 1)
+#elif RAT_USE_64BIT_ARITHMETIC == 1
 # define RAT_SIGNED_INT_MAX      (LONG_MAX)
 # define RAT_SIGNED_INT_MIN      (LONG_MIN)
 # define RAT_SIGNED_LONG_INT_MAX (LLONG_MAX)
@@ -76,7 +94,14 @@
  * Global type definitions
  */
 
-#if RAT_USE_64BIT_ARITHMETIC == 1
+#if RAT_USE_128BIT_ARITHMETIC == 1
+/** The type of the numerators and denominators of all rational numbers. It has 64 Bit. */
+typedef signed long int rat_signed_int;
+
+/** The longer type of integers, which is used internally for exact intermediate results
+    and for overflow recognition. */
+typedef __int128 rat_signed_long_int;
+#elif RAT_USE_64BIT_ARITHMETIC == 1
 /** The type of the numerators and denominators of all rational numbers. Basically any
     signed int type could be used, but we implement a simple overflow recognition by using
     signed long int and thus having signed long long int as kind of internal reserve to
@@ -112,7 +137,7 @@ typedef struct rat_num_t
 /** A global flag to indicate overflows.
       @remark Despite of its global declaration is this a module internal variable. Never
     touch this variable! */
-extern boolean rat_overflowFlag;
+extern THREAD_LOCAL boolean rat_overflowFlag;
 
 
 /*
@@ -225,10 +250,11 @@ static inline rat_num_t rat_div(rat_num_t n, rat_num_t d)
 
 
 /**
- * Euclid's algorithm to find the greatest common divisor of two integer numbers.
+ * Stein's binary algorithm to find the greatest common divisor of two integer numbers. It
+ * replaces the divisions of Euclid's algorithm by shifts and subtractions.
  *   @return
- * Get the gcd of \a a and \a b. The sign of gcd is the sign of the operands if they have
- * identical sign or undefined otherwise.
+ * Get the gcd of \a a and \a b. The gcd is not negative. (The only exception is the gcd
+ * of RAT_SIGNED_INT_MIN with itself or with null, which is not representable.)
  *   @param a
  * The first numeric operand, a signed integer. If \a a is null then the function returns
  * \a b.
@@ -239,18 +265,33 @@ static inline rat_num_t rat_div(rat_num_t n, rat_num_t d)
 
 static inline rat_signed_int rat_gcd(rat_signed_int a, rat_signed_int b)
 {
-    /* See http://de.wikipedia.org/wiki/Euklidischer_Algorithmus and particularly
-       http://de.wikipedia.org/wiki/Euklidischer_Algorithmus#Beschreibung_durch_Pseudocode
-       (visited on Mar 6, 2014) for details on Euclid's algorithm. */
-    while(b != 0)
+    /* See http://en.wikipedia.org/wiki/Binary_GCD_algorithm for details on the algorithm.
+       It operates on the magnitudes, which are computed in unsigned arithmetic; this type
+       can represent the magnitude of the most negative number, too. */
+    unsigned long u = a < 0? -(unsigned long)a: (unsigned long)a
+                , v = b < 0? -(unsigned long)b: (unsigned long)b;
+    if(u == 0)
+        return (rat_signed_int)v;
+    else if(v == 0)
+        return (rat_signed_int)u;
+
+    /* The common power of two is taken out. Afterwards, u and v are kept odd: The
+       difference of two odd numbers is even and the power of two is removed from it. The
+       trailing zeros of the difference are counted regardless of its sign, which shortens
+       the chain of dependent instructions of an iteration. */
+    const int shift = __builtin_ctzl(u | v);
+    u >>= __builtin_ctzl(u);
+    v >>= __builtin_ctzl(v);
+    while(u != v)
     {
-        /* In C99, h always has the sign of a. */
-        rat_signed_int h = a % b;
-        a = b;
-        b = h; 
+        const unsigned long diff = v - u
+                          , min = u < v? u: v;
+        v = (u < v? diff: u - v) >> __builtin_ctzl(diff);
+        u = min;
     }
-    return a;
-    
+
+    return (rat_signed_int)(u << shift);
+
 } /* End of rat_gcd */
 
 
@@ -313,5 +354,8 @@ rat_num_t rat_mul(rat_num_t a, rat_num_t b);
 /** Compute the sum of two rational numbers. */
 rat_num_t rat_add(rat_num_t a, rat_num_t b);
 
+/** Find the rational number, which is represented by a floating point number. */
+rat_num_t rat_fromDouble(double x);
+
 
 #endif  /* RAT_RATIONALNUMBER_INCLUDED */
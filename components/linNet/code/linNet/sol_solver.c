@@ -21,9 +21,12 @@
  *   sol_initModule
  *   sol_shutdownModule
  *   sol_createSolution
+ *   sol_createSolutionFromPrevious
  *   sol_cloneByReference
  *   sol_cloneByConstReference
  *   sol_deleteSolution
+ *   sol_storeSolution
+ *   sol_loadSolution
  *   sol_getNoIndependents
  *   sol_getNameOfIndependent
  *   sol_getNoDependents
@@ -32,8 +35,34 @@
  *   sol_logSolution
  * Local functions
  *   getVectorOfReqDependents
+ *   getMaxAbsFactor
  *   elementaryStep
+ *   taskElementaryStep
+ *   reserveRowsOfElimStep
+ *   reserveTasksOfElimStep
+ *   memoizeElementarySteps
+ *   initPatternOfElimStep
+ *   exchangeRowsOfPattern
+ *   exchangeColsOfPattern
+ *   eliminateRows
  *   solverLES
+ *   selectPivotElement
+ *   permuteLES
+ *   solverLESForAllUnknowns
+ *   findIndependentSubsystems
+ *   solverLESOfIndependentSubsystems
+ *   solverLESWithDecomposition
+ *   isNumericCoef
+ *   presolveLES
+ *   backSubstitutePresolvedUnknowns
+ *   solverLESWithPresolve
+ *   solveUnknownByUnknown
+ *   solveAllUnknownsAtOnce
+ *   computeUserDefVoltages
+ *   alignToCacheFileSection
+ *   getCoefOfCacheFile
+ *   readCacheFile
+ *   releaseCacheFile
  */
 
 
@@ -44,12 +73,25 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
 #include <assert.h>
+#include <unistd.h>
+#ifdef __unix__
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+#endif
 #include "smalloc.h"
+#include "snprintf.h"
 #include "log_logger.h"
+#include "thp_threadPool.h"
 #include "coe_coefficient.h"
 #include "coe_coefficient.inlineInterface.h"
 #include "les_linearEquationSystem.h"
+#include "spt_spanningTreeSolver.h"
+#include "prf_performanceReport.h"
 #include "sol_solver.h"
 
 
@@ -57,11 +99,305 @@
  * Defines
  */
 
+/** The magic number at the beginning of a cache file. It reads "LNC1" in a hex dump of
+    a file, which has been written on a little endian machine. */
+#define CACHE_FILE_MAGIC    0x31434e4cu
+
+/** The version of the format of a cache file. It needs to be incremented with any change
+    of the data layout. */
+#define CACHE_FILE_VERSION  1u
+
+/** All sections of a cache file begin at a multiple of this number of Byte. This permits
+    to access the data in place, if the file is mapped into memory. */
+#define CACHE_FILE_ALIGNMENT 8u
+
+/** The number of bits of a word of the pattern of non null coefficients of the LES. */
+#define NO_BITS_OF_PATTERN_WORD (8u*sizeof(unsigned long long))
+
+/** If set to 1 then the elementary steps of an elimination step, which have identical
+    operands, are carried out only once; the others get a copy of the result. The memo
+    table costs a hash code per elementary step. */
+#define MEMOIZE_ELEMENTARY_STEPS    1
+
 
 /*
  * Local type definitions
  */
 
+/** The reasons for aborting the elimination because of an exhausted resource budget or
+    because the numeric factors of the addends leave the range of their type. */
+typedef enum { abortReason_none
+             , abortReason_noAddendsOfCoef
+             , abortReason_sizeOfHeap
+             , abortReason_wallTime
+             , abortReason_numericOverflow } abortReason_t;
+
+
+/** The working data of a thread, which executes elementary steps of the elimination. It
+    holds the objects, which are reused in all elementary steps. */
+typedef struct workspace_t
+{
+    /** The accumulator of addends, which is used to compute the numerator of the quotient
+        in the elementary step. */
+    coe_accumulator_t *pAccumulator;
+
+    /** The element A[row][step] of the row under progress in packed representation. */
+    coe_packedCoef_t rowHead;
+
+    /** The row, whose element A[row][step] is currently held in \a rowHead. UINT_MAX if
+        \a rowHead is invalid. */
+    unsigned int idxRowOfRowHead;
+
+    /** The buffer, which receives the relevant products of an addend with all addends of
+        another operand. */
+    coe_packedCoef_t products;
+
+    /** The heaps of coefficients of the thread, one for each number of words of a product
+        of constants; element \a i is used for \a i+1 words. The heaps are created on
+        demand. The main thread uses the heaps of the module coe_coefficient and has
+        MEM_HANDLE_INVALID_HEAP here. */
+    mem_hHeap_t hHeapOfCoefAddendAry[COE_MAX_NO_WORDS_OF_PRODUCT];
+
+    /** The reason, why the thread had to abort the current elimination step, or
+        abortReason_none. A thread, which has exceeded the resource budget, skips all
+        remaining elementary steps of the elimination step. */
+    abortReason_t abortReason;
+
+    /** The number of relevant products, which have been accumulated by the thread in the
+        current elimination step. */
+    unsigned long long noProducts;
+
+    /** The number of addends of all coefficients, which have been computed by the thread
+        in the current elimination step. */
+    unsigned long long noAddends;
+
+    /** The number of addends of the largest coefficient, which has been computed by the
+        thread in the current elimination step. */
+    unsigned int maxNoAddendsOfCoef;
+
+} workspace_t;
+
+
+/** The position of a coefficient in the matrix of the LES. */
+typedef struct coefIdx_t
+{
+    /** The row of the coefficient. */
+    unsigned int row;
+
+    /** The column of the coefficient. */
+    unsigned int col;
+
+} coefIdx_t;
+
+
+/** An elementary step, whose result is copied from another elementary step of the same
+    elimination step with identical operands. */
+typedef struct memoizedStep_t
+{
+    /** The position of the coefficient, which receives the copy. */
+    coefIdx_t dest;
+
+    /** The position of the coefficient, which is computed. */
+    coefIdx_t src;
+
+} memoizedStep_t;
+
+
+/** An entry of the memo table of the elementary steps of an elimination step. */
+typedef struct memoSlot_t
+{
+    /** The hash code of the operands of the elementary step. */
+    unsigned long long hash;
+
+    /** The index of the elementary step in the list of tasks or UINT_MAX for an empty
+        entry. */
+    unsigned int idxTask;
+
+} memoSlot_t;
+
+
+/** The description of an elimination step. It holds the operands, which are common to all
+    elementary steps of the elimination step, in packed representation and the set of
+    elementary steps to do. The elementary steps are independent of one another and are
+    carried out by the threads of the module's thread pool. */
+typedef struct elimStep_t
+{
+    /** The matrix of coefficients under progress. */
+    coe_coefMatrix_t A;
+
+    /** The index of the elimination step. */
+    unsigned int idxStep;
+
+    /** The pivot element A[step][step] of the current elimination step. */
+    coe_packedCoef_t pivot;
+
+    /** The known divisor of the current elimination step, which is the pivot element of
+        the previous step. */
+    coe_packedCoef_t divisor;
+
+    /** The indexes of the rows, which are manipulated in this elimination step. */
+    unsigned int *idxRowAry;
+
+    /** The number of entries in \a idxRowAry. */
+    unsigned int noRows;
+
+    /** The capacity of \a idxRowAry. */
+    unsigned int maxNoRows;
+
+    /** The pattern of non null coefficients of the matrix under progress. Row \a i of the
+        matrix has \a noWordsOfPattern words, beginning at patternAry[i*noWordsOfPattern].
+        Bit \a j of the row is set if A[i][j] is not null. The pattern is permuted together
+        with the matrix. It is maintained for the rows and columns, which are still under
+        progress only. */
+    unsigned long long *patternAry;
+
+    /** The number of words of the pattern of a row. */
+    unsigned int noWordsOfPattern;
+
+    /** The capacity of \a patternAry in words. */
+    size_t maxNoWordsOfPatternAry;
+
+    /** The elementary steps of the elimination step. An elementary step, whose operands
+        are all null or can only yield a null coefficient, is not listed. */
+    coefIdx_t *taskAry;
+
+    /** The number of entries in \a taskAry. */
+    unsigned int noTasks;
+
+    /** The capacity of \a taskAry and \a memoizedStepAry. */
+    unsigned int maxNoTasks;
+
+    /** The elementary steps, which are not carried out because another elementary step in
+        \a taskAry has identical operands. */
+    memoizedStep_t *memoizedStepAry;
+
+    /** The number of entries in \a memoizedStepAry. */
+    unsigned int noMemoizedSteps;
+
+    /** The memo table, which finds the elementary steps with identical operands. */
+    memoSlot_t *memoTableAry;
+
+    /** The capacity of \a memoTableAry. */
+    unsigned int maxNoSlotsOfMemoTable;
+
+    /** The hash codes of the operands A(step,n) of all columns. */
+    unsigned long long *hashOfColAry;
+
+    /** The capacity of \a hashOfColAry. */
+    unsigned int maxNoHashesOfCols;
+
+    /** The number of columns, which are manipulated in each of the rows. These are the
+        columns idxStep+1..n-1. */
+    unsigned int noCols;
+
+    /** The number of words of a product of constants of the circuit under progress. */
+    unsigned int noWordsOfProduct;
+
+    /** The working data of the threads of the pool, one object per thread. The worker
+        threads can't access the module's data, which is thread-local, and get it from
+        here. */
+    workspace_t *workspaceAry;
+
+    /** The number of threads and workspaces. */
+    unsigned int noThreads;
+
+    /** The maximum number of addends of a computed coefficient. UINT_MAX if there's no
+        limit. */
+    unsigned int maxNoAddendsOfCoef;
+
+    /** The wall-clock time, when the solution of the LES has to be aborted, or null if
+        there's no limit. */
+    time_t deadline;
+
+} elimStep_t;
+
+
+/** The description of an unknown, which is removed from the LES by the presolve. */
+typedef struct presolveStep_t
+{
+    /** The index of the equation, which determines the unknown. */
+    unsigned int idxRow;
+
+    /** The index of the unknown. */
+    unsigned int idxCol;
+
+    /** The coefficient of the unknown in its equation, either 1 or -1. */
+    signed int pivot;
+
+} presolveStep_t;
+
+
+/** The header of a cache file, which holds a solution in binary form.\n
+      The solution is stored using the native representation of the machine; a cache file
+    is meant to be reused on the same machine only. The header records the sizes of the
+    native types so that a file from an incompatible machine is safely rejected.\n
+      The header is followed by these sections, each of them beginning at a multiple of
+    #CACHE_FILE_ALIGNMENT Byte:\n
+      - The Boolean vector of available dependents, one Byte per dependent\n
+      - The indexes of the first addend of all coefficients, as unsigned long long. The
+    first coefficient is the determinant, the next ones are the numerators, row by row.
+    There's one additional element, which holds the total number of addends\n
+      - The numeric factors of all addends\n
+      - The products of constants of all addends, \a noWordsOfProduct words each\n
+      There are no pointers in the file; the coefficients are read by means of the packed
+    representation, which directly refers to the factors and products in place. */
+typedef struct cacheFileHeader_t
+{
+    /** The magic number #CACHE_FILE_MAGIC. */
+    unsigned int magic;
+
+    /** The version of the format, #CACHE_FILE_VERSION. */
+    unsigned int version;
+
+    /** The size in Byte of a word of a product of constants on the writing machine. */
+    unsigned int sizeOfProductWord;
+
+    /** The size in Byte of a numeric factor on the writing machine. */
+    unsigned int sizeOfNumericFactor;
+
+    /** The hash code of the circuit, see pci_getHashOfCircuit. */
+    unsigned long long hashOfCircuit;
+
+    /** The number of unknowns of the LES. */
+    unsigned int noUnknowns;
+
+    /** The number of knowns of the LES. */
+    unsigned int noKnowns;
+
+    /** The number of dependents, i.e. unknowns of the LES plus user-defined voltages. */
+    unsigned int noDependents;
+
+    /** The number of constants of the LES. */
+    unsigned int noConstants;
+
+    /** The number of words of a product of constants. */
+    unsigned int noWordsOfProduct;
+
+    /** The number of stored coefficients, the determinant plus all numerators. */
+    unsigned int noCoefs;
+
+    /** The total number of addends of all stored coefficients. */
+    unsigned long long noAddends;
+
+} cacheFileHeader_t;
+
+
+/** The contents of a cache file in memory. Either the file is mapped into memory or it
+    has been read into a buffer. */
+typedef struct cacheFileImage_t
+{
+    /** The contents of the file. */
+    const void *pData;
+
+    /** The size of the file in Byte. */
+    size_t size;
+
+    /** \a true if \a pData is a memory mapping of the file, \a false if it is a malloc
+        allocated buffer. */
+    boolean isMapped;
+
+} cacheFileImage_t;
+
 
 /*
  * Local prototypes
@@ -72,12 +408,43 @@
  * Data definitions
  */
 
-/** A global logger object is referenced from anywhere for writing progress messages. */
-static log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+/** A global logger object is referenced from anywhere for writing progress messages.
+      @remark The data of the module is thread-local. Each job of a parallel batch run has
+    its own solver with its own pool of threads. */
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+/** The description of the current elimination step. The object is reused in all steps. */
+static THREAD_LOCAL elimStep_t _elimStep = { .idxRowAry = NULL
+                                           , .patternAry = NULL
+                                           , .taskAry = NULL
+                                           , .memoizedStepAry = NULL
+                                           , .memoTableAry = NULL
+                                           , .hashOfColAry = NULL
+                                           };
+
+/** The pool of threads, which carry out the elementary steps. */
+static THREAD_LOCAL thp_hThreadPool_t _hThreadPool = THP_HANDLE_INVALID_THREAD_POOL;
+
+/** The working data of the threads of the pool, one object per thread. Element null is
+    used by the main thread. */
+static THREAD_LOCAL workspace_t *_workspaceAry = NULL;
+
+/** The number of threads and workspaces. */
+static THREAD_LOCAL unsigned int _noThreads = 0;
+
+/** The limits of the resources, which the solution of a single LES may consume. */
+static THREAD_LOCAL sol_resourceBudget_t _budget = { .maxNoAddendsOfCoef = 0
+                                                   , .maxNoAddendsOfHeap = 0
+                                                   , .maxWallTime = 0
+                                                   };
+
+/** \a true if the solution of the current LES has been aborted because of an exhausted
+    resource budget or a numeric overflow. The problem has already been reported. */
+static THREAD_LOCAL boolean _isBudgetExceeded = false;
 
 #ifdef  DEBUG
 /** A global counter of all references to any created objects. Used to detect memory leaks. */
-static unsigned int _noRefsToObjects = 0;
+static THREAD_LOCAL unsigned int _noRefsToObjects = 0;
 #endif
 
 
@@ -256,6 +623,33 @@ static const boolean *getVectorOfReqDependents(const sol_solution_t * const pSol
 
 
 
+/**
+ * Get the greatest magnitude of the numeric factors of a packed coefficient.
+ *   @return
+ * Get the magnitude as floating point number.
+ *   @param pCoef
+ * The packed coefficient.
+ */
+
+static double getMaxAbsFactor(const coe_packedCoef_t * const pCoef)
+{
+    coe_numericFactor_t max = 0;
+    unsigned int u;
+    for(u=0; u<pCoef->noAddends; ++u)
+    {
+        const coe_numericFactor_t factor = pCoef->factorAry[u];
+        if(factor > max)
+            max = factor;
+        else if(-factor > max)
+            max = -factor;
+    }
+    return (double)max;
+
+} /* End of getMaxAbsFactor */
+
+
+
+
 /**
  * The most basic operation of the extended Gauss elimination. It re-computes one
  * coefficient of the LES according to: A(m,n)=(A(m,n)*A(step,step)-A(step,n)*A(m,step))/t.
@@ -275,118 +669,171 @@ static const boolean *getVectorOfReqDependents(const sol_solution_t * const pSol
  * The row index of the coefficient under operation.
  *   @param col
  * The column index of the coefficient under operation.
- *   @param pKnownDivisor
- * The known divisor.
+ *   @param pElimStep
+ * The description of the elimination step. It holds the operands A(step,step) and the
+ * known divisor t in packed representation. The calling code has to keep these operands
+ * up to date.
+ *   @param pWorkspace
+ * The working data of the calling thread. It holds the accumulator for the numerator and
+ * the operand A(m,step) in packed representation. The calling code has to keep this
+ * operand up to date. The buffer for the relevant products is used internally.\n
+ *   If the resource budget of the solver is found to be exhausted then the reason is
+ * recorded in the workspace. A(m,n) is not touched if the result has too many addends or
+ * if its numeric factors could leave the range of their type.\n
+ *   The numbers of accumulated products and of computed addends are counted in the
+ * workspace for the performance report.
+ *   @remark
+ * The elementary steps of an elimination step can be carried out in parallel. Besides the
+ * workspace, the function only reads the operands and it writes A(m,n) only.
  */
 
 static void elementaryStep( coe_coefMatrix_t A
                           , signed int step
                           , signed int row
                           , signed int col
-                          , const coe_coef_t * const pKnownDivisor
+                          , const elimStep_t * const pElimStep
+                          , workspace_t * const pWorkspace
                           )
 {
     /* If the current diagonal element is null then the determinant is already known to be
        null and we must not have got here. */
-    assert(!coe_isCoefAddendNull(A[step][step]));
+    assert(!coe_isCoefAddendNull(A[step][step])
+           &&  pElimStep->pivot.noAddends > 0
+           &&  pElimStep->divisor.noAddends > 0
+          );
 
     /* In the first step we compute the numerator of the quotient as the sum of two
        products of two coefficients each. At the end of this step *pNumerator will take the
        value A(m,n)*A(step,step)-A(step,n)*A(m,step). (See below for a refinement of this
        statement.) We start with null and add two times the products of all combinations of
        terms from first and second coeffcient. */
-    coe_coef_t *pNumerator = coe_coefAddendNull();
-    const coe_productOfConst_t prodOfCDiv = pKnownDivisor->productOfConst;
-
-    /* The outer loop implements the sum of the two products with different sign. */
+    coe_accumulator_t * const pNumerator = pWorkspace->pAccumulator;
+    coe_resetAccumulator(pNumerator);
+    const coe_packedCoef_t * const pDivisor = &pElimStep->divisor;
+    const unsigned int noWords = pElimStep->noWordsOfProduct;
+    const coe_productOfConstWord_t * const prodOfCDiv = &pDivisor->productOfConstAry[0];
+
+    /* The relevant products of an addend with all addends of any of the packed operands
+       are collected in a buffer. */
+    coe_packedCoef_t * const pProducts = &pWorkspace->products;
+    unsigned int maxNoProducts = pElimStep->pivot.noAddends;
+    if(pWorkspace->rowHead.noAddends > maxNoProducts)
+        maxNoProducts = pWorkspace->rowHead.noAddends;
+    if(pDivisor->noAddends > maxNoProducts)
+        maxNoProducts = pDivisor->noAddends;
+    coe_reservePackedCoef(pProducts, maxNoProducts);
+    coe_productOfConstWord_t * const prodOfCProdAry = pProducts->productOfConstAry;
+    coe_numericFactor_t * const factorProdAry = pProducts->factorAry;
+
+    /* The numeric factors of the addends are not necessarily absolute one; devices with
+       numeric value are substituted into the LES as integer factors. No factor, which is
+       computed in the elementary step, can exceed the sum of the magnitudes of all
+       products, which are accumulated. A product is bounded before it is computed and the
+       sum is bounded before it is accumulated; the factor two is the margin for later
+       sums of solutions, e.g. in the user-defined voltages. */
+    const double maxBoundOfFactors = (double)(LONG_MAX/2);
+    double boundOfFactors = 0.0;
+
+    /* The outer loop implements the sum of the two products with different sign. The
+       second operand of both products is found in packed representation. Its addends
+       are iterated in the inner loop. */
     signed int sign;
-    const coe_coef_t *pOperand2;
+    const coe_packedCoef_t *pOperand2;
     const coe_coefAddend_t *pAddend1;
-    for( sign = +1, pAddend1 = A[row][col], pOperand2 = A[step][step]
+
+    /* The first operand of the first product is the coefficient, which is replaced by the
+       result. Its tail is found on the fly; it permits to free it in constant time. */
+    coe_coefAddend_t *pTailOfCoef = NULL;
+    unsigned int noAddendsOfCoef = 0;
+    for( sign = +1, pAddend1 = A[row][col], pOperand2 = &pElimStep->pivot
        ; sign >= -1
-       ; sign -= 2, pAddend1 = A[step][col], pOperand2 = A[row][step]
+       ; sign -= 2, pAddend1 = A[step][col], pOperand2 = &pWorkspace->rowHead
        )
     {
+        const double maxAbsFactor2 = getMaxAbsFactor(pOperand2);
+        const unsigned int noAddends2 = pOperand2->noAddends;
+        const coe_productOfConstWord_t * const prodOfC2Ary = pOperand2->productOfConstAry;
+        const coe_numericFactor_t * const factor2Ary = pOperand2->factorAry;
+
         /* Loop over all addends of first operand. */
         while(!coe_isCoefAddendNull(pAddend1))
         {
-            assert(pAddend1->factor == 1  ||  pAddend1->factor == -1);
-            const coe_productOfConst_t prodOfC1 = pAddend1->productOfConst;
+            const coe_productOfConstWord_t * const prodOfC1 = pAddend1->productOfConst;
+            const coe_numericFactor_t factor1 = sign > 0? pAddend1->factor: -pAddend1->factor;
+            if(sign > 0)
+            {
+                pTailOfCoef = (coe_coefAddend_t*)pAddend1;
+                ++ noAddendsOfCoef;
+            }
 
-            /* Each addend of the second operand is combined with the current addend of the
-               first operand. Re-initialize the pointer to the addends of the second
-               coefficient. */
-            const coe_coefAddend_t *pAddend2 = pOperand2;
-            while(!coe_isCoefAddendNull(pAddend2))
+            if(fabs((double)factor1) * maxAbsFactor2 > maxBoundOfFactors)
             {
-                assert(pAddend1->factor == 1  ||  pAddend1->factor == -1);
-                const coe_productOfConst_t prodOfC2 = pAddend2->productOfConst;
-
-                /* It is proven that the numerator of the quotient will eventually contain
-                   only such addends, which can be divided by the first addend of the
-                   denominator such that all resulting constants have powers of null or one.
-                   Intermediate results could basically occur here that do not fit into this
-                   pattern but they would sooner or later be anyway eliminated by similar
-                   addends of inverse sign. Therefore we may decide to immediately discard
-                   those addends.
-                     The first part of the condition discards addends, which can't be
-                   devided by the first addend of the denominator (they don't contain the
-                   combination of constants of the denominator term).
-                     The second part of the condition discards addends, which would lead to
-                   powers of constants greater than one in the result. */
-                if(((~prodOfC1 & ~prodOfC2 & prodOfCDiv)
-                    | (prodOfC1 & prodOfC2 & ~prodOfCDiv)
-                   ) == 0
-                  )
-                {
-                    /* This term is relevant for the final result. */
-
-                    /* The product is computed and added to the numerator of the quotient.
-                       However, not as such but already divided by the first addend of the
-                       divisor. Just keep in mind that the first step of the later division
-                       has already been done. (If we'd truely store the product, we'd need
-                       another representation of the constants: The products can have
-                       constants to the power of two.)
-                         The exclusive or adds the bits (i.e. powers of constants) but
-                       because of the overrun it also implements the subtraction of the
-                       divisor powers. The result is correct as we have already checked
-                       that the final result for each bit is in the implemented range of
-                       0..1.
-                         No overflow recognition has been implemented for the numeric
-                       factor. The result of the computation is the sum of two products of
-                       two coefficients each. The combined four coefficients are either the
-                       original coefficients of the LES or the result of the solver in the
-                       previous elimination step. The numeric factor of all addends of all
-                       of these four coefficients have the absolute value of one.
-                       Consequently, each addend of the intermediate result (which is a
-                       product of two addends from the coefficients) has a numeric factor
-                       of absolute one, too. Factors not equal to absolute one can appear
-                       in the intermediate result but they are yielded only by
-                       incrementally adding another addend with a factor of (absolute) one,
-                       so the factor in the intermediate result can increase only in steps
-                       of one with each computed addend of the resulting sum of products.
-                       There's no faster accumulation of the factor e.g. by multiplicative
-                       effects. An overrun would therefore occur at earliest after having
-                       figured out 2^31 products of addends. (And in fact it would require
-                       many times more products as most of the terms are of course not
-                       identical with respect to the product of constants.) An overrun can
-                       thus happen only after a pseudo-infinite computation time and a
-                       recognition of such an overrun would not help in any fashion as
-                       nobody would ever wait for this response of the software.
-                         Practically spoken, if the algorithm ends in finite time then
-                       surely no overrun occurred. */
-                    coe_addAddend( &pNumerator
-                                 , /* factor */ pAddend1->factor * (sign > 0
-                                                                    ? pAddend2->factor
-                                                                    : -pAddend2->factor
-                                                                   )
-                                 , /* productOfConsts */ prodOfC1 ^ prodOfC2  ^ prodOfCDiv
-                                 );
-                } /* End if(Is this term relevant for the final result?) */
+                pWorkspace->abortReason = abortReason_numericOverflow;
+                return;
+            }
 
-                pAddend2 = pAddend2->pNext;
+            /* Each addend of the second operand is combined with the current addend of the
+               first operand.
+                 It is proven that the numerator of the quotient will eventually contain
+               only such addends, which can be divided by the first addend of the
+               denominator such that all resulting constants have powers of null or one.
+               Intermediate results could basically occur here that do not fit into this
+               pattern but they would sooner or later be anyway eliminated by similar
+               addends of inverse sign. Therefore we may decide to immediately discard
+               those addends.
+                 The first part of the condition discards addends, which can't be
+               devided by the first addend of the denominator (they don't contain the
+               combination of constants of the denominator term).
+                 The second part of the condition discards addends, which would lead to
+               powers of constants greater than one in the result.
+                 The test of the condition for all addends of the second operand is the
+               hot spot of the solver. It is implemented by a kernel, which is selected at
+               run-time for the CPU in use and which may test many addends at once. */
+            const unsigned int noProducts = coe_filterProducts( prodOfCProdAry
+                                                              , factorProdAry
+                                                              , prodOfC1
+                                                              , factor1
+                                                              , prodOfC2Ary
+                                                              , factor2Ary
+                                                              , noAddends2
+                                                              , prodOfCDiv
+                                                              , noWords
+                                                              );
+            pWorkspace->noProducts += noProducts;
+            unsigned int idxProduct;
+            for(idxProduct=0; idxProduct<noProducts; ++idxProduct)
+            {
+                /* This term is relevant for the final result.
 
-            }/* Ende der Schleife ueber die Liste des 2. Operanden */
+                     The product has been computed and is added to the numerator of the
+                   quotient. However, not as such but already divided by the first addend
+                   of the divisor. Just keep in mind that the first step of the later
+                   division has already been done. (If we'd truely store the product, we'd
+                   need another representation of the constants: The products can have
+                   constants to the power of two.)
+                     The exclusive or adds the bits (i.e. powers of constants) but
+                   because of the overrun it also implements the subtraction of the
+                   divisor powers. The result is correct as we have already checked
+                   that the final result for each bit is in the implemented range of
+                   0..1.
+                     The numeric factor can't overflow: The magnitudes of the product and
+                   of all sums, which the accumulator forms with it, are bounded by
+                   boundOfFactors. If all factors of the LES are absolute one, which is
+                   the case for a purely symbolic circuit, then the factors grow only in
+                   steps of one with each accumulated product and the bound is never
+                   reached in practice. */
+                assert(factorProdAry[idxProduct] != 0);
+                boundOfFactors += fabs((double)factorProdAry[idxProduct]);
+                if(boundOfFactors > maxBoundOfFactors)
+                {
+                    pWorkspace->abortReason = abortReason_numericOverflow;
+                    return;
+                }
+                coe_accumulateAddend( pNumerator
+                                    , factorProdAry[idxProduct]
+                                    , &prodOfCProdAry[idxProduct*noWords]
+                                    );
+            } /* End for(All relevant products with the addends of the second operand) */
 
             pAddend1 = pAddend1->pNext;
 
@@ -403,267 +850,2683 @@ static void elementaryStep( coe_coefMatrix_t A
     coe_coef_t *pResult = coe_coefAddendNull()
              , **ppResultEnd = &pResult;
 
-    const coe_numericFactor_t factorDiv = pKnownDivisor->factor;
-
-    /* The factor of all addends that are input to the elementary step is always absolute
-       one. As opposed to this, the numeric factors of the addends of *pNumerator may have
-       values other than absolute one. */
-    assert(factorDiv == 1  ||  factorDiv == -1);
-
-    /* We loop over all addends of the numerator. */
-    while(!coe_isCoefAddendNull(pNumerator))
+    const coe_numericFactor_t factorDiv = pDivisor->factorAry[0];
+    assert(factorDiv != 0);
+    const unsigned int noAddendsDiv = pDivisor->noAddends;
+    const double maxAbsFactorDiv = getMaxAbsFactor(pDivisor);
+
+    /* We loop over all addends of the numerator. The accumulator returns them in the
+       order of falling binary interpretation of the product of constants. */
+    coe_numericFactor_t factorNum;
+    coe_productOfConstWord_t prodOfCRes[COE_MAX_NO_WORDS_OF_PRODUCT];
+    unsigned int noAddendsRes = 0;
+    while(coe_fetchMaxAddend(pNumerator, prodOfCRes, &factorNum))
     {
-        /* Here we test the numeric factor of an addend from the internal numerator
-           variable. The numeric factors of the numerator variable are not per se absolute
-           one; only here and now, when the addend becomes the addend under progress the
-           factor needs to be one. If not, the resulting addend of the final result would
-           have a numeric factor other than one and this is proven to be impossible. */
-        assert(pNumerator->factor == 1  ||  pNumerator->factor == -1);
+        /* A result, which exceeds the budget, is discarded. The remaining addends of the
+           numerator are dropped with the next reset of the accumulator. */
+        if(++noAddendsRes > pElimStep->maxNoAddendsOfCoef)
+        {
+            *ppResultEnd = NULL;
+            coe_freeCoef(pResult);
+            pWorkspace->abortReason = abortReason_noAddendsOfCoef;
+            return;
+        }
 
         /* It is proven, that the numeric quotient of the factors can be computed without a
            remainder. */
-        assert(pNumerator->factor % factorDiv == 0);
-        const coe_numericFactor_t factorRes = pNumerator->factor / factorDiv;
+        assert(factorNum % factorDiv == 0);
+        const coe_numericFactor_t factorRes = factorNum / factorDiv;
 
-        /* The division of products of constants has already been conducted. Just hold a
-           faster reference to the result. */
-        const coe_productOfConst_t prodOfCRes = pNumerator->productOfConst;
+        /* The products with the divisor are accumulated, too, and they are bounded in the
+           same way. */
+        if(fabs((double)factorRes) * maxAbsFactorDiv > maxBoundOfFactors)
+        {
+            *ppResultEnd = NULL;
+            coe_freeCoef(pResult);
+            pWorkspace->abortReason = abortReason_numericOverflow;
+            return;
+        }
 
-        /* Put the new result term into the result coefficient. The terms are sorted in the
+        /* The division of products of constants has already been conducted and the result
+           is found in prodOfCRes.
+             Put the new result term into the result coefficient. The terms are sorted in the
            order of falling binary interpretation of the product of constants and the
            result terms appear in exactly this order. So we can be sure, that the added
            term always has to be appended to the end of the list of addends. */
         coe_coefAddend_t *pNewResultAddend = coe_newCoefAddend();
         pNewResultAddend->factor = factorRes;
-        pNewResultAddend->productOfConst = prodOfCRes;
+        coe_copyProductOfConst(pNewResultAddend->productOfConst, prodOfCRes, noWords);
         *ppResultEnd = pNewResultAddend;
         ppResultEnd = &pNewResultAddend->pNext;
 
         /* The new addend of the result is now multiplied with all the terms of the divisor
            and all terms of this product are subtracted from the numerator. Evidently, the
-           first subtracted term will clear the addend in progress from the numerator. Less
-           evident and due to the sort order of the addends in all the coefficients, all
-           further terms will be located to left of this first term or with other words,
-           the operation will discard the head of the numerator list and insert a number of
-           new addends somewhere behind. */
-        const coe_coefAddend_t *pAddendDiv = pKnownDivisor;
-        do
-        {
-            assert(pAddendDiv->factor == -1  ||  pAddendDiv->factor == 1);
-            const coe_productOfConst_t prodOfCAddendDiv = pAddendDiv->productOfConst;
-
-            /* Here we have the complement to the computation of the numerator. There we'd
-               discarded terms that would anyway not remain in the computation. Here is the
-               second source for such terms. At latest the terms produced here would
-               eliminate the irrelevant terms of the numerator computation. Since we had
-               discarded those it is a must to discard these as well. */
-            if(((~prodOfCAddendDiv & ~prodOfCRes & prodOfCDiv)
-                | (prodOfCAddendDiv & prodOfCRes & ~prodOfCDiv)
-               ) == 0
-              )
-            {
-                /* The prove of the finiteness of the algorithm is based on the sort order
-                   of terms in the coeffcients. No term, which is again inserted in the
-                   numerator must have a combination of constants that is greater than that
-                   of the term under progress (where "greater" refers to a comparison, which
-                   interprets the product of constants as an unsigned binary number). */
-                assert(pAddendDiv == pKnownDivisor
-                       || (prodOfCAddendDiv ^ prodOfCRes ^ prodOfCDiv) < prodOfCRes
-                      );
+           first subtracted term will clear the addend in progress from the numerator; it
+           has already been removed by fetching it from the accumulator so that we can
+           begin with the second term of the divisor. Less evident and due to the sort
+           order of the addends in all the coefficients, all further terms will be located
+           to left of this first term or with other words, the operation will insert a
+           number of new addends behind the fetched one. */
+        assert(factorDiv * factorRes == factorNum);
+
+        /* Here we have the complement to the computation of the numerator. There we'd
+           discarded terms that would anyway not remain in the computation. Here is the
+           second source for such terms. At latest the terms produced here would eliminate
+           the irrelevant terms of the numerator computation. Since we had discarded those
+           it is a must to discard these as well. The same kernel is applied. */
+        const unsigned int noProducts =
+                            coe_filterProducts( prodOfCProdAry
+                                              , factorProdAry
+                                              , prodOfCRes
+                                              , - factorRes
+                                              , &pDivisor->productOfConstAry[noWords]
+                                              , &pDivisor->factorAry[1]
+                                              , noAddendsDiv - 1
+                                              , prodOfCDiv
+                                              , noWords
+                                              );
+        pWorkspace->noProducts += noProducts;
+        unsigned int idxProduct;
+        for(idxProduct=0; idxProduct<noProducts; ++idxProduct)
+        {
+            /* The prove of the finiteness of the algorithm is based on the sort order of
+               terms in the coeffcients. No term, which is again inserted in the numerator
+               must have a combination of constants that is greater than that of the term
+               under progress (where "greater" refers to a comparison, which interprets the
+               product of constants as an unsigned binary number). The accumulator relies
+               on this, too: A fetched product of constants must not be accumulated
+               again. */
+            assert(coe_compareProductOfConst( &prodOfCProdAry[idxProduct*noWords]
+                                            , prodOfCRes
+                                            , noWords
+                                            ) < 0
+                  );
 
-                /* This term is relevant for the final result.
-                     No overrun recognition is required here, for the same reason as
-                   documented for the call of coe_addAddend above. */
-                coe_addAddend( &pNumerator
-                             , /* factor */ - pAddendDiv->factor * factorRes
-                             , /* productOfConsts */ prodOfCAddendDiv ^ prodOfCRes ^ prodOfCDiv
-                             );
+            /* This term is relevant for the final result.
+                 The overrun recognition is the same as for the accumulation of the products
+               above. */
+            assert(factorProdAry[idxProduct] != 0);
+            boundOfFactors += fabs((double)factorProdAry[idxProduct]);
+            if(boundOfFactors > maxBoundOfFactors)
+            {
+                *ppResultEnd = NULL;
+                coe_freeCoef(pResult);
+                pWorkspace->abortReason = abortReason_numericOverflow;
+                return;
             }
-
-            /* Handle product of result term with next addend of divisor. */
-            pAddendDiv = pAddendDiv->pNext;
-        }
-        while(!coe_isCoefAddendNull(pAddendDiv));
+            coe_accumulateAddend( pNumerator
+                                , factorProdAry[idxProduct]
+                                , &prodOfCProdAry[idxProduct*noWords]
+                                );
+        } /* End for(All relevant products with all but the first addend of the divisor) */
 
     } /* End while(Divide all addends of the numerator) */
 
     /* Terminate the result list of addends. Eventually we need to write the NULL pointer. */
     *ppResultEnd = NULL;
-
-    /* The numerator should be entirely processed. */
-    assert(coe_isCoefAddendNull(pNumerator));
+    pWorkspace->noAddends += noAddendsRes;
+    if(noAddendsRes > pWorkspace->maxNoAddendsOfCoef)
+        pWorkspace->maxNoAddendsOfCoef = noAddendsRes;
 
     /* Put the result directly into the matrix. Do a replace by first freeing the current
        element. */
-    coe_freeCoef(A[row][col]);
+    coe_freeCoefWithTail(A[row][col], pTailOfCoef, noAddendsOfCoef);
     assert(coe_checkOrderOfAddends(pResult));
     A[row][col] = pResult;
 
-} /* End of elementaryStep */
+    /* The budgets of memory and time are checked once per elementary step. The heap is the
+       one of the calling thread. */
+    if(mem_isSizeLimitExceeded(coe_hHeapOfCoefAddend))
+        pWorkspace->abortReason = abortReason_sizeOfHeap;
+    else if(pElimStep->deadline != 0  &&  time(NULL) > pElimStep->deadline)
+        pWorkspace->abortReason = abortReason_wallTime;
 
+} /* End of elementaryStep */
 
 
 
 
 
 /**
- * The solver for a linear equation system.\n
- *   The system is solved by the modified Gaussian elimination method. The required
- * algebraic structure the coefficients belongs to is less demanding than for the original
- * elimination: The division is not required. The modified elimination can e.g. be
- * performed with integer numbers. The coefficients' algebraic structure needs to have the
- * sum and the multiplication operation.\n
- *   The arithmetic is not done in this routine; it only implements the control structure.
- * The algebraic operations on the coefficients are solely done in the sub-routine
- * elementaryOperation. By exchanging this sub-routine the solver could be used for other
- * sets of coefficients.\n
- *   A possible impact of the actual arithmetics on the control structure in this routine
- * could be a round off error of the multiplikation operation. True pivoting could
- * become an issue. The current implementation of the control structure just implements a
- * simple pivoting, which suffices for error-free sum and multiplication.
- *   @return
- * The function returns true if the LES could be solved. false ii e.g. returned in case of
- * linearly dependent equations.
- *   @param A
- * The array of coefficients, which are manipulated in place. The result is returned in
- * place.\n
- *   The array is organized as m rows and n columns, where n >= m+1. The rectangular area
- * A[0..m-1][0..m-1] holds the coefficients belonging to the m unknowns. If the algorithm
- * returns true than this area is a diagonal matrix, where A[i][i], i=0..m-1, holds the
- * denominator of the solution for unknown i.\n
- *   A[0..m-1][m..n-1] holds the left hand side of the LES (where the sign of these
- * coefficients is such that the sum of all row elements becomes null). Column i, i=m..n-1,
- * holds the coefficients belonging to the known input variable i-m. If the algorithm
- * returns true than this area contains the numerators of the solution. A[i][j+m]*V_j,
- * i=0..m-1, j=0..n-m-1, is the complete numerator of the result for unknown i.
- *   @param m
- * The number \a m of rows of the matrix \a A.
- *   @param n
- * The number \a n of columns of the matrix \a A.
- *   @see void elementaryStep(coe_coefMatrix_t, int, int, int, coe_coef_t *)
+ * A single elementary step as a task of the thread pool. The task index is mapped onto
+ * the row and column of the manipulated coefficient by the list of elementary steps of
+ * the elimination step. Tasks of neighbouring index refer to the same row so that the
+ * packed operand A(m,step) can mostly be reused.
+ *   @param pContext
+ * The description of the elimination step, an object of type elimStep_t.
+ *   @param idxTask
+ * The index of the elementary step in the range 0..noTasks-1.
+ *   @param idxThread
+ * The index of the executing thread. It selects the workspace.
  */
 
-static boolean solverLES( coe_coefMatrix_t A
-                        , const unsigned int m
-                        , const unsigned int n
-                        )
+static void taskElementaryStep(void *pContext, unsigned int idxTask, unsigned int idxThread)
 {
-    /* The first elimination step doesn't know a common divisor yet. The divisor is
-       initialized with one. */
-    coe_coefAddend_t addendOne = {.pNext = NULL, .factor = 1, .productOfConst = 0};
-    coe_coef_t *pDivisor = &addendOne;
+    const elimStep_t * const pElimStep = (const elimStep_t*)pContext;
+    assert(idxThread < pElimStep->noThreads  &&  idxTask < pElimStep->noTasks);
+    workspace_t * const pWorkspace = &pElimStep->workspaceAry[idxThread];
+    if(pWorkspace->abortReason != abortReason_none)
+        return;
 
-    /* Do all m-1 elimination steps. */
-    unsigned int elimStep;
-    boolean doSignInversion = false;
-    for(elimStep=0; elimStep<m-1; ++elimStep)
+    /* A worker thread uses its own heap of coefficients. The heap depends on the circuit
+       under progress. */
+    if(idxThread > 0)
     {
-        /* Pivoting: Avoid a generalizing product with a null coefficient, which would
-           break the algorithm. We look for a line, whose coefficient under progress is not
-           null. Such a line needs to exist, otherwise it was the prove that the LES
-           contains linear dependent or contradictory equations. */
-        if(coe_isCoefAddendNull(A[elimStep][elimStep]))
-        {
-            unsigned int idxPivotRow = elimStep;
-            do
-            {
-                if(++idxPivotRow >= m)
-                {
-                    /* No usable line found at all. The network analysis, which is part of
-                       making the LES, failed to recognize the problem when checking the
-                       (physical) constraints, which apply to an electric circuit. */
-                    LOG_ERROR( _log
-                             , "Gauss elimination of LES is aborted. Pivoting doesn't find"
-                               " any non null coefficient in the %u. elimination step. The"
-                               " equations are linear dependent or contradictory. Please"
-                               " double-check your circuit net list"
-                             , elimStep+1
-                             )
-                    return false;
-                }
-            }
-            while(coe_isCoefAddendNull(A[idxPivotRow][elimStep]));
-
-            LOG_DEBUG( _log
-                     , "Pivoting in elimination step %u: Line exchange %u <-> %u"
-                     , elimStep
-                     , elimStep, idxPivotRow
-                     );
-
-            /* Exchange the row of the current elimination step with the pivot row. */
-            coe_coef_t **elimRow = A[elimStep];
-            A[elimStep] = A[idxPivotRow];
-            A[idxPivotRow] = elimRow;
+        const unsigned int noWords = pElimStep->noWordsOfProduct;
+        assert(pWorkspace->hHeapOfCoefAddendAry[noWords-1] != MEM_HANDLE_INVALID_HEAP);
+        coe_setHeapOfThread(pWorkspace->hHeapOfCoefAddendAry[noWords-1], noWords);
+    }
 
-            /* Each exchange of rows means a sign change of the determinant of the LES. We
-               keep track of this since we want to have the final solution in a form, where
-               the denominator is this determinant. */
-            doSignInversion = !doSignInversion;
+    const unsigned int row = pElimStep->taskAry[idxTask].row
+                     , col = pElimStep->taskAry[idxTask].col;
+    if(row != pWorkspace->idxRowOfRowHead)
+    {
+        coe_packCoef(&pWorkspace->rowHead, pElimStep->A[row][pElimStep->idxStep]);
+        pWorkspace->idxRowOfRowHead = row;
+    }
 
-        } /* End if(Pivot element is null) */
+    /* Elimination at A(row,col) */
+    elementaryStep(pElimStep->A, pElimStep->idxStep, row, col, pElimStep, pWorkspace);
 
-        /* Do the coefficient elimination/manipulation for all remaining, not yet handled
-           rows and columns. */
-        unsigned int row;
-        for(row=elimStep+1; row<m; ++row)
-        {
-            unsigned int col;
-            for(col=elimStep+1; col<n; ++col)
-            {
-                /* Elimination at A(row,col) */
-                elementaryStep(A, elimStep, row, col, pDivisor);
-            }
+} /* End of taskElementaryStep */
 
-            /* We set the eliminated coefficient explicitly to null. This operation is
-               useless with respect to the wanted result but it frees some memory and is
-               advantageous for logging purpose. */
-            coe_freeCoef(A[row][elimStep]);
-            A[row][elimStep] = coe_coefAddendNull();
-        }
 
-        /* Remind the divisor of the next elimination step. */
-        pDivisor = A[elimStep][elimStep];
 
-#if 0
-        /* If memory usage is an important matter, then we can free the coefficients of the
-           upper lines of the matrix. We will end up with only the n-m+1 coefficients of
-           the last line, that represent the result plus the divisor of the last
-           elimination step. For logging purpose it might however be better not do so. */
 
-        /* Loop over the line above those, where we eliminated the heading column. */
-        unsigned int col;
-        for(col=0; col<n; col++)
-        {
-            /* The elements on the diagonal are the still used divisors of the next
-               elimination step. Don't free the last recent one. */
-            if(col != elimStep)
-                coe_freeCoef(A[elimStep][col]);
-        }
-        /* The no longer used divisor of the previous elimination step can now be freed. */
-        if(elimStep > 0)
-            coe_freeCoef(A[elimStep-1][elimStep-1]);
-#endif
-    } /* End for(All m-1 elimination steps) */
+/**
+ * Ensure the capacity of the list of rows of the description of the elimination step.
+ *   @param pElimStep
+ * The description of the elimination step.
+ *   @param maxNoRows
+ * The required number of rows.
+ */
 
-    /* The result is now immediately available for the last unknown in the last row. The
-       denominator of this result is the system determinant if we consider possible
-       intermediate sign changes caused by pivoting. We want to do so. */
-    if(doSignInversion)
+static void reserveRowsOfElimStep(elimStep_t * const pElimStep, unsigned int maxNoRows)
+{
+    if(maxNoRows > pElimStep->maxNoRows)
     {
-        /* All non null coefficients of the last equation after the last elimination step
-           are sign inverted. The equation is thus not changed. */
-        unsigned int col;
-        for(col=m-1; col<n; ++col)
-            coe_mulConst(A[m-1][col], /* constant */ -1);
+        pElimStep->idxRowAry = srealloc( pElimStep->idxRowAry
+                                       , maxNoRows * sizeof(pElimStep->idxRowAry[0])
+                                       , __FILE__
+                                       , __LINE__
+                                       );
+        pElimStep->maxNoRows = maxNoRows;
     }
+} /* End of reserveRowsOfElimStep */
 
-    return true;
+
+
+
+/**
+ * Ensure the capacity of the list of elementary steps of the description of the
+ * elimination step.
+ *   @param pElimStep
+ * The description of the elimination step.
+ *   @param maxNoTasks
+ * The required number of elementary steps.
+ */
+
+static void reserveTasksOfElimStep(elimStep_t * const pElimStep, unsigned int maxNoTasks)
+{
+    if(maxNoTasks > pElimStep->maxNoTasks)
+    {
+        pElimStep->taskAry = srealloc( pElimStep->taskAry
+                                     , maxNoTasks * sizeof(pElimStep->taskAry[0])
+                                     , __FILE__
+                                     , __LINE__
+                                     );
+        pElimStep->memoizedStepAry = srealloc( pElimStep->memoizedStepAry
+                                             , maxNoTasks
+                                               * sizeof(pElimStep->memoizedStepAry[0])
+                                             , __FILE__
+                                             , __LINE__
+                                             );
+        pElimStep->maxNoTasks = maxNoTasks;
+    }
+} /* End of reserveTasksOfElimStep */
+
+
+
+
+/**
+ * Find the elementary steps of an elimination step, which have identical operands. The
+ * pivot element and the divisor are common to all elementary steps, so the result
+ * depends only on the operands A(m,n), A(step,n) and A(m,step). The LES of a circuit
+ * often has the same coefficient in several places, e.g. the admittance of a device in
+ * four places. Out of a group of elementary steps with identical operands only the first
+ * one is kept in the list of tasks. The others are moved into the list of memoized steps
+ * and get a copy of its result.
+ *   @param pElimStep
+ * The description of the elimination step. The list of elementary steps has been
+ * compiled.
+ *   @param n
+ * The number \a n of columns of the matrix.
+ */
+
+static void memoizeElementarySteps(elimStep_t * const pElimStep, const unsigned int n)
+{
+    pElimStep->noMemoizedSteps = 0;
+    const unsigned int noTasks = pElimStep->noTasks;
+    if(noTasks < 2)
+        return;
+
+    /* The memo table is a hash table with linear probing and a load factor of at most one
+       half. It holds the indexes of the elementary steps, which are carried out. */
+    unsigned int log2NoSlots = 1;
+    while((1u<<log2NoSlots) < 2*noTasks)
+        ++ log2NoSlots;
+    const unsigned int noSlots = 1u<<log2NoSlots
+                     , mask = noSlots - 1;
+    if(noSlots > pElimStep->maxNoSlotsOfMemoTable)
+    {
+        pElimStep->memoTableAry = srealloc( pElimStep->memoTableAry
+                                          , noSlots * sizeof(pElimStep->memoTableAry[0])
+                                          , __FILE__
+                                          , __LINE__
+                                          );
+        pElimStep->maxNoSlotsOfMemoTable = noSlots;
+    }
+    memoSlot_t * const memoTableAry = pElimStep->memoTableAry;
+    unsigned int idxSlot;
+    for(idxSlot=0; idxSlot<noSlots; ++idxSlot)
+        memoTableAry[idxSlot].idxTask = UINT_MAX;
+
+    /* The hash codes of the operands A(step,n) are shared by all rows. */
+    if(n > pElimStep->maxNoHashesOfCols)
+    {
+        pElimStep->hashOfColAry = srealloc( pElimStep->hashOfColAry
+                                          , n * sizeof(pElimStep->hashOfColAry[0])
+                                          , __FILE__
+                                          , __LINE__
+                                          );
+        pElimStep->maxNoHashesOfCols = n;
+    }
+    const coe_coefMatrix_t A = pElimStep->A;
+    const unsigned int step = pElimStep->idxStep;
+    unsigned long long * const hashOfColAry = pElimStep->hashOfColAry;
+    unsigned int col;
+    for(col=step+1; col<n; ++col)
+        hashOfColAry[col] = coe_getHashOfCoef(A[step][col]);
+
+    /* The list of tasks is compacted in place. */
+    coefIdx_t * const taskAry = pElimStep->taskAry;
+    unsigned int noTasksRes = 0
+               , rowOfHash = UINT_MAX
+               , idxTask;
+    unsigned long long hashOfRowHead = 0;
+    for(idxTask=0; idxTask<noTasks; ++idxTask)
+    {
+        const coefIdx_t task = taskAry[idxTask];
+        if(task.row != rowOfHash)
+        {
+            hashOfRowHead = coe_getHashOfCoef(A[task.row][step]);
+            rowOfHash = task.row;
+        }
+        const unsigned long long hash = ((coe_getHashOfCoef(A[task.row][task.col])
+                                          * 0x9E3779B97F4A7C15ull
+                                          ^ hashOfColAry[task.col]
+                                         ) * 0x9E3779B97F4A7C15ull
+                                        ) ^ hashOfRowHead;
+
+        boolean isMemoized = false;
+        idxSlot = (unsigned int)((hash * 0x9E3779B97F4A7C15ull) >> (64 - log2NoSlots));
+        while(memoTableAry[idxSlot].idxTask != UINT_MAX)
+        {
+            const coefIdx_t * const pOrig = &taskAry[memoTableAry[idxSlot].idxTask];
+            if(memoTableAry[idxSlot].hash == hash
+               &&  coe_isEqualCoef(A[task.row][task.col], A[pOrig->row][pOrig->col])
+               &&  coe_isEqualCoef(A[step][task.col], A[step][pOrig->col])
+               &&  coe_isEqualCoef(A[task.row][step], A[pOrig->row][step])
+              )
+            {
+                memoizedStep_t * const pMemoizedStep =
+                                &pElimStep->memoizedStepAry[pElimStep->noMemoizedSteps++];
+                pMemoizedStep->dest = task;
+                pMemoizedStep->src = *pOrig;
+                isMemoized = true;
+                break;
+            }
+            idxSlot = (idxSlot+1) & mask;
+        }
+        if(!isMemoized)
+        {
+            memoTableAry[idxSlot].hash = hash;
+            memoTableAry[idxSlot].idxTask = noTasksRes;
+            taskAry[noTasksRes++] = task;
+        }
+    } /* End for(All elementary steps) */
+
+    assert(noTasksRes + pElimStep->noMemoizedSteps == noTasks);
+    pElimStep->noTasks = noTasksRes;
+
+} /* End of memoizeElementarySteps */
+
+
+
+
+/**
+ * Set up the pattern of non null coefficients of a LES prior to its elimination.
+ *   @param pElimStep
+ * The description of the elimination step, which holds the pattern.
+ *   @param A
+ * The LES.
+ *   @param m
+ * The number \a m of rows of the matrix \a A.
+ *   @param n
+ * The number \a n of columns of the matrix \a A.
+ */
+
+static void initPatternOfElimStep( elimStep_t * const pElimStep
+                                 , const coe_coefMatrix_t A
+                                 , const unsigned int m
+                                 , const unsigned int n
+                                 )
+{
+    const unsigned int noWordsOfPattern = (n + NO_BITS_OF_PATTERN_WORD - 1)
+                                          / NO_BITS_OF_PATTERN_WORD;
+    const size_t noWords = (size_t)m * noWordsOfPattern;
+    if(noWords > pElimStep->maxNoWordsOfPatternAry)
+    {
+        pElimStep->patternAry = srealloc( pElimStep->patternAry
+                                        , noWords * sizeof(pElimStep->patternAry[0])
+                                        , __FILE__
+                                        , __LINE__
+                                        );
+        pElimStep->maxNoWordsOfPatternAry = noWords;
+    }
+    pElimStep->noWordsOfPattern = noWordsOfPattern;
+    memset(pElimStep->patternAry, 0, noWords * sizeof(pElimStep->patternAry[0]));
+
+    unsigned int row, col;
+    for(row=0; row<m; ++row)
+    {
+        unsigned long long * const patternOfRow =
+                                        &pElimStep->patternAry[row*noWordsOfPattern];
+        for(col=0; col<n; ++col)
+        {
+            if(!coe_isCoefAddendNull(A[row][col]))
+            {
+                patternOfRow[col / NO_BITS_OF_PATTERN_WORD] |=
+                                            1ull << (col % NO_BITS_OF_PATTERN_WORD);
+            }
+        }
+    }
+} /* End of initPatternOfElimStep */
+
+
+
+
+/**
+ * Exchange two rows of the pattern of non null coefficients. This is done together with
+ * the exchange of the rows of the LES.
+ *   @param pElimStep
+ * The description of the elimination step, which holds the pattern.
+ *   @param rowA
+ * The index of the first row.
+ *   @param rowB
+ * The index of the second row.
+ */
+
+static void exchangeRowsOfPattern( elimStep_t * const pElimStep
+                                 , unsigned int rowA
+                                 , unsigned int rowB
+                                 )
+{
+    const unsigned int noWordsOfPattern = pElimStep->noWordsOfPattern;
+    unsigned long long * const patternOfRowA =
+                                        &pElimStep->patternAry[rowA*noWordsOfPattern]
+                       , * const patternOfRowB =
+                                        &pElimStep->patternAry[rowB*noWordsOfPattern];
+    unsigned int idxWord;
+    for(idxWord=0; idxWord<noWordsOfPattern; ++idxWord)
+    {
+        const unsigned long long word = patternOfRowA[idxWord];
+        patternOfRowA[idxWord] = patternOfRowB[idxWord];
+        patternOfRowB[idxWord] = word;
+    }
+} /* End of exchangeRowsOfPattern */
+
+
+
+
+/**
+ * Exchange two columns of the pattern of non null coefficients. This is done together
+ * with the exchange of the columns of the LES.
+ *   @param pElimStep
+ * The description of the elimination step, which holds the pattern.
+ *   @param m
+ * The number of rows of the LES.
+ *   @param colA
+ * The index of the first column.
+ *   @param colB
+ * The index of the second column.
+ */
+
+static void exchangeColsOfPattern( elimStep_t * const pElimStep
+                                 , const unsigned int m
+                                 , unsigned int colA
+                                 , unsigned int colB
+                                 )
+{
+    const unsigned int noWordsOfPattern = pElimStep->noWordsOfPattern
+                     , idxWordA = colA / NO_BITS_OF_PATTERN_WORD
+                     , idxWordB = colB / NO_BITS_OF_PATTERN_WORD;
+    const unsigned long long maskA = 1ull << (colA % NO_BITS_OF_PATTERN_WORD)
+                           , maskB = 1ull << (colB % NO_BITS_OF_PATTERN_WORD);
+    unsigned int row;
+    for(row=0; row<m; ++row)
+    {
+        unsigned long long * const patternOfRow =
+                                        &pElimStep->patternAry[row*noWordsOfPattern];
+        const boolean isSetA = (patternOfRow[idxWordA] & maskA) != 0
+                    , isSetB = (patternOfRow[idxWordB] & maskB) != 0;
+        if(isSetA != isSetB)
+        {
+            patternOfRow[idxWordA] ^= maskA;
+            patternOfRow[idxWordB] ^= maskB;
+        }
+    }
+} /* End of exchangeColsOfPattern */
+
+
+
+
+/**
+ * Do all elementary steps of an elimination step. All listed rows are manipulated in all
+ * columns right of the pivot column. The elementary steps are distributed among the
+ * threads of the pool. Eventually, the coefficients of the pivot column of all listed rows
+ * are set to null.\n
+ *   An elementary step, which can only yield null, is skipped. The pattern of non null
+ * coefficients is used to find these steps and it is updated with the results.
+ *   @return
+ * \a false if the resource budget of the solver is exhausted. An error has been reported
+ * and the state of the elimination is undefined; the LES can only be logged and deleted.
+ *   @param pElimStep
+ * The description of the elimination step. The matrix, the index of the step, the packed
+ * pivot element and divisor, the list of rows and the pattern of non null coefficients
+ * need to be set.
+ *   @param n
+ * The number \a n of columns of the matrix.
+ */
+
+static boolean eliminateRows(elimStep_t * const pElimStep, const unsigned int n)
+{
+    assert(pElimStep->idxStep+1 < n);
+    const unsigned int step = pElimStep->idxStep;
+    pElimStep->noCols = n - step - 1;
+
+    /* The list of elementary steps is compiled from the pattern of non null coefficients.
+       The elementary step computes (A(m,n)*A(step,step) - A(step,n)*A(m,step)) / divisor.
+       The result is null if A(m,n) is null and if A(step,n) or A(m,step) is null, too.
+       These steps are skipped; the coefficient just stays null. The LES of a circuit is
+       sparse and most elementary steps are skipped in the first elimination steps. */
+    const coe_coefMatrix_t A = pElimStep->A;
+    const unsigned int noWordsOfPattern = pElimStep->noWordsOfPattern
+                     , idxFirstWord = (step+1) / NO_BITS_OF_PATTERN_WORD;
+    unsigned long long * const patternAry = pElimStep->patternAry;
+    const unsigned long long * const patternOfPivotRow = &patternAry[step*noWordsOfPattern];
+    const unsigned long long maskOfFirstWord = ~0ull << ((step+1) % NO_BITS_OF_PATTERN_WORD);
+    reserveTasksOfElimStep(pElimStep, pElimStep->noRows * pElimStep->noCols);
+    coefIdx_t * const taskAry = pElimStep->taskAry;
+    unsigned int noTasks = 0
+               , idxRow;
+    for(idxRow=0; idxRow<pElimStep->noRows; ++idxRow)
+    {
+        const unsigned int row = pElimStep->idxRowAry[idxRow];
+        const unsigned long long * const patternOfRow = &patternAry[row*noWordsOfPattern];
+        const boolean isRowHeadNull = coe_isCoefAddendNull(A[row][step]);
+        unsigned int idxWord;
+        for(idxWord=idxFirstWord; idxWord<noWordsOfPattern; ++idxWord)
+        {
+            unsigned long long word = patternOfRow[idxWord];
+            if(!isRowHeadNull)
+                word |= patternOfPivotRow[idxWord];
+            if(idxWord == idxFirstWord)
+                word &= maskOfFirstWord;
+
+            while(word != 0)
+            {
+                taskAry[noTasks].row = row;
+                taskAry[noTasks].col = idxWord*NO_BITS_OF_PATTERN_WORD
+                                       + (unsigned int)__builtin_ctzll(word);
+                assert(taskAry[noTasks].col < n);
+                ++ noTasks;
+                word &= word - 1;
+            }
+        }
+    }
+    assert(noTasks <= pElimStep->noRows * pElimStep->noCols);
+    pElimStep->noTasks = noTasks;
+#if MEMOIZE_ELEMENTARY_STEPS == 1
+    memoizeElementarySteps(pElimStep, n);
+    noTasks = pElimStep->noTasks;
+#else
+    pElimStep->noMemoizedSteps = 0;
+#endif
+    const unsigned int noMemoizedSteps = pElimStep->noMemoizedSteps;
+
+    /* The packed operands A(m,step) of the workspaces are outdated. The worker threads
+       need a heap of coefficients for the circuit under progress. The heaps can be created
+       now as no other thread is using coefficients. */
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    pElimStep->noWordsOfProduct = noWords;
+    pElimStep->workspaceAry = _workspaceAry;
+    pElimStep->noThreads = _noThreads;
+    unsigned int idxThread;
+    for(idxThread=0; idxThread<_noThreads; ++idxThread)
+    {
+        workspace_t * const pWorkspace = &_workspaceAry[idxThread];
+        pWorkspace->idxRowOfRowHead = UINT_MAX;
+        pWorkspace->abortReason = abortReason_none;
+        pWorkspace->noProducts = 0;
+        pWorkspace->noAddends = 0;
+        pWorkspace->maxNoAddendsOfCoef = 0;
+        mem_hHeap_t hHeap = coe_hHeapOfCoefAddend;
+        if(idxThread > 0)
+        {
+            if(pWorkspace->hHeapOfCoefAddendAry[noWords-1] == MEM_HANDLE_INVALID_HEAP)
+                pWorkspace->hHeapOfCoefAddendAry[noWords-1] = coe_createHeapForThread();
+            hHeap = pWorkspace->hHeapOfCoefAddendAry[noWords-1];
+        }
+
+        /* The heap of each thread is limited separately. */
+        mem_setSizeLimit(hHeap, _budget.maxNoAddendsOfHeap);
+    }
+
+    thp_runTasks(_hThreadPool, noTasks, taskElementaryStep, pElimStep);
+
+    /* The statistics of all threads are summed up for the performance report. */
+    prf_elimStep_t statistics = { .noRows = pElimStep->noRows
+                                , .noCols = pElimStep->noCols
+                                , .noAddendsOfPivot = pElimStep->pivot.noAddends
+                                , .noAddendsOfDivisor = pElimStep->divisor.noAddends
+                                , .noSkippedElemSteps = pElimStep->noRows
+                                                        * pElimStep->noCols
+                                                        - noTasks
+                                                        - noMemoizedSteps
+                                , .noMemoizedElemSteps = noMemoizedSteps
+                                , .noProducts = 0
+                                , .noAddends = 0
+                                , .maxNoAddendsOfCoef = 0
+                                };
+    for(idxThread=0; idxThread<_noThreads; ++idxThread)
+    {
+        const workspace_t * const pWorkspace = &_workspaceAry[idxThread];
+        statistics.noProducts += pWorkspace->noProducts;
+        statistics.noAddends += pWorkspace->noAddends;
+        if(pWorkspace->maxNoAddendsOfCoef > statistics.maxNoAddendsOfCoef)
+            statistics.maxNoAddendsOfCoef = pWorkspace->maxNoAddendsOfCoef;
+    }
+    prf_recordElimStep(&statistics);
+
+    /* Any thread may have found the budget exhausted. The first reason found is
+       reported. */
+    abortReason_t abortReason = abortReason_none;
+    for(idxThread=0; idxThread<_noThreads; ++idxThread)
+    {
+        if(_workspaceAry[idxThread].abortReason != abortReason_none)
+        {
+            abortReason = _workspaceAry[idxThread].abortReason;
+            break;
+        }
+    }
+    if(abortReason == abortReason_numericOverflow)
+    {
+        LOG_ERROR( _log
+                 , "Gauss elimination of LES is aborted in the %u. elimination step. The"
+                   " numeric factors of the addends exceed the range of their type. Please"
+                   " use fewer devices with numeric value or values with fewer significant"
+                   " digits"
+                 , pElimStep->idxStep+1
+                 )
+        _isBudgetExceeded = true;
+        return false;
+    }
+    else if(abortReason != abortReason_none)
+    {
+        char reason[80];
+        if(abortReason == abortReason_noAddendsOfCoef)
+        {
+            snprintf( reason
+                    , sizeof(reason)
+                    , "A coefficient has more than %u addends"
+                    , _budget.maxNoAddendsOfCoef
+                    );
+        }
+        else if(abortReason == abortReason_sizeOfHeap)
+        {
+            snprintf( reason
+                    , sizeof(reason)
+                    , "A thread holds more than %lu addends"
+                    , _budget.maxNoAddendsOfHeap
+                    );
+        }
+        else
+        {
+            assert(abortReason == abortReason_wallTime);
+            snprintf( reason
+                    , sizeof(reason)
+                    , "The computation takes more than %u s"
+                    , _budget.maxWallTime
+                    );
+        }
+        LOG_ERROR( _log
+                 , "Gauss elimination of LES is aborted in the %u. elimination step. %s."
+                   " The step manipulates %u rows in %u columns, its pivot element has %u"
+                   " and its divisor %u addends. The circuit is too complex for the"
+                   " resource budget of the solver"
+                 , pElimStep->idxStep+1
+                 , reason
+                 , pElimStep->noRows
+                 , pElimStep->noCols
+                 , pElimStep->pivot.noAddends
+                 , pElimStep->divisor.noAddends
+                 )
+        _isBudgetExceeded = true;
+        return false;
+    }
+
+    /* The memoized elementary steps get a copy of the result of the elementary step with
+       identical operands. */
+    const memoizedStep_t * const memoizedStepAry = pElimStep->memoizedStepAry;
+    unsigned int idxTask;
+    for(idxTask=0; idxTask<noMemoizedSteps; ++idxTask)
+    {
+        const coefIdx_t * const pDest = &memoizedStepAry[idxTask].dest
+                        , * const pSrc = &memoizedStepAry[idxTask].src;
+        coe_freeCoef(A[pDest->row][pDest->col]);
+        A[pDest->row][pDest->col] = coe_cloneByDeepCopy(A[pSrc->row][pSrc->col]);
+    }
+
+    /* The pattern is updated with the results. A result can be null, even if not all
+       operands were, since addends can cancel out. */
+    for(idxTask=0; idxTask<noTasks+noMemoizedSteps; ++idxTask)
+    {
+        const coefIdx_t * const pCoefIdx = idxTask < noTasks
+                                           ? &taskAry[idxTask]
+                                           : &memoizedStepAry[idxTask-noTasks].dest;
+        const unsigned int row = pCoefIdx->row
+                         , col = pCoefIdx->col;
+        const unsigned long long mask = 1ull << (col % NO_BITS_OF_PATTERN_WORD);
+        unsigned long long * const pWord = &patternAry[row*noWordsOfPattern
+                                                       + col / NO_BITS_OF_PATTERN_WORD
+                                                      ];
+        if(coe_isCoefAddendNull(A[row][col]))
+            *pWord &= ~mask;
+        else
+            *pWord |= mask;
+    }
+
+    /* We set the eliminated coefficients explicitly to null. This operation is useless
+       with respect to the wanted result but it frees some memory and is advantageous for
+       logging purpose. */
+    const unsigned long long maskOfStep = 1ull << (step % NO_BITS_OF_PATTERN_WORD);
+    for(idxRow=0; idxRow<pElimStep->noRows; ++idxRow)
+    {
+        const unsigned int row = pElimStep->idxRowAry[idxRow];
+        coe_freeCoef(A[row][step]);
+        A[row][step] = coe_coefAddendNull();
+        patternAry[row*noWordsOfPattern + step/NO_BITS_OF_PATTERN_WORD] &= ~maskOfStep;
+    }
+
+    return true;
+
+} /* End of eliminateRows */
+
+
+
+
+
+
+/**
+ * The solver for a linear equation system.\n
+ *   The system is solved by the modified Gaussian elimination method. The required
+ * algebraic structure the coefficients belongs to is less demanding than for the original
+ * elimination: The division is not required. The modified elimination can e.g. be
+ * performed with integer numbers. The coefficients' algebraic structure needs to have the
+ * sum and the multiplication operation.\n
+ *   The arithmetic is not done in this routine; it only implements the control structure.
+ * The algebraic operations on the coefficients are solely done in the sub-routine
+ * elementaryOperation. By exchanging this sub-routine the solver could be used for other
+ * sets of coefficients.\n
+ *   A possible impact of the actual arithmetics on the control structure in this routine
+ * could be a round off error of the multiplikation operation. True pivoting could
+ * become an issue. The current implementation of the control structure just implements a
+ * simple pivoting, which suffices for error-free sum and multiplication.
+
+ *   The solver is memory-lean unless the log level is DEBUG: A row is no longer used
+ * after its elimination step and it is freed immediately. The peak memory consumption is
+ * then determined by the remaining rows rather than by the complete triangular matrix. At
+ * log level DEBUG the rows are kept, so that the final state of the matrix can be logged.
+ *   @return
+ * The function returns true if the LES could be solved. false ii e.g. returned in case of
+ * linearly dependent equations.
+ *   @param A
+ * The array of coefficients, which are manipulated in place. The result is returned in
+ * place.\n
+ *   The array is organized as m rows and n columns, where n >= m+1. The rectangular area
+ * A[0..m-1][0..m-1] holds the coefficients belonging to the m unknowns. If the algorithm
+ * returns true than this area is a diagonal matrix, where A[i][i], i=0..m-1, holds the
+ * denominator of the solution for unknown i. In memory-lean operation, all rows but the
+ * last one are null on return.\n
+ *   A[0..m-1][m..n-1] holds the left hand side of the LES (where the sign of these
+ * coefficients is such that the sum of all row elements becomes null). Column i, i=m..n-1,
+ * holds the coefficients belonging to the known input variable i-m. If the algorithm
+ * returns true than this area contains the numerators of the solution. A[i][j+m]*V_j,
+ * i=0..m-1, j=0..n-m-1, is the complete numerator of the result for unknown i.
+ *   @param m
+ * The number \a m of rows of the matrix \a A.
+ *   @param n
+ * The number \a n of columns of the matrix \a A.
+ *   @see void elementaryStep(coe_coefMatrix_t, int, int, int, const elimStep_t * const,
+ * workspace_t * const)
+ */
+
+static boolean solverLES( coe_coefMatrix_t A
+                        , const unsigned int m
+                        , const unsigned int n
+                        )
+{
+    /* The first elimination step doesn't know a common divisor yet. The divisor is
+       initialized with one. */
+    elimStep_t * const pElimStep = &_elimStep;
+    pElimStep->A = A;
+    reserveRowsOfElimStep(pElimStep, m);
+    coe_reservePackedCoef(&pElimStep->divisor, 1);
+    pElimStep->divisor.noAddends = 1;
+    pElimStep->divisor.factorAry[0] = 1;
+    coe_copyProductOfConst( &pElimStep->divisor.productOfConstAry[0]
+                          , COE_PRODUCT_OF_NO_CONST.wordAry
+                          , coe_getNoWordsOfProduct()
+                          );
+
+    /* The rows above the current elimination step are needed only for logging the final
+       state of the LES. */
+    const boolean isMemoryLean = !log_checkLogLevel(_log, log_debug);
+
+    /* The elementary steps are selected by the pattern of non null coefficients. */
+    initPatternOfElimStep(pElimStep, A, m, n);
+
+    /* Do all m-1 elimination steps. */
+    unsigned int elimStep;
+    boolean doSignInversion = false;
+    for(elimStep=0; elimStep<m-1; ++elimStep)
+    {
+        /* Pivoting: Avoid a generalizing product with a null coefficient, which would
+           break the algorithm. We look for a line, whose coefficient under progress is not
+           null. Such a line needs to exist, otherwise it was the prove that the LES
+           contains linear dependent or contradictory equations. */
+        if(coe_isCoefAddendNull(A[elimStep][elimStep]))
+        {
+            unsigned int idxPivotRow = elimStep;
+            do
+            {
+                if(++idxPivotRow >= m)
+                {
+                    /* No usable line found at all. The network analysis, which is part of
+                       making the LES, failed to recognize the problem when checking the
+                       (physical) constraints, which apply to an electric circuit. */
+                    LOG_ERROR( _log
+                             , "Gauss elimination of LES is aborted. Pivoting doesn't find"
+                               " any non null coefficient in the %u. elimination step. The"
+                               " equations are linear dependent or contradictory. Please"
+                               " double-check your circuit net list"
+                             , elimStep+1
+                             )
+                    return false;
+                }
+            }
+            while(coe_isCoefAddendNull(A[idxPivotRow][elimStep]));
+
+            LOG_DEBUG( _log
+                     , "Pivoting in elimination step %u: Line exchange %u <-> %u"
+                     , elimStep
+                     , elimStep, idxPivotRow
+                     );
+
+            /* Exchange the row of the current elimination step with the pivot row. */
+            coe_coef_t **elimRow = A[elimStep];
+            A[elimStep] = A[idxPivotRow];
+            A[idxPivotRow] = elimRow;
+            exchangeRowsOfPattern(pElimStep, elimStep, idxPivotRow);
+
+            /* Each exchange of rows means a sign change of the determinant of the LES. We
+               keep track of this since we want to have the final solution in a form, where
+               the denominator is this determinant. */
+            doSignInversion = !doSignInversion;
+
+        } /* End if(Pivot element is null) */
+
+        /* The pivot element is an operand of all elementary steps of this elimination
+           step. */
+        pElimStep->idxStep = elimStep;
+        coe_packCoef(&pElimStep->pivot, A[elimStep][elimStep]);
+
+        /* Do the coefficient elimination/manipulation for all remaining, not yet handled
+           rows and columns. */
+        unsigned int row;
+        pElimStep->noRows = 0;
+        for(row=elimStep+1; row<m; ++row)
+            pElimStep->idxRowAry[pElimStep->noRows++] = row;
+        if(!eliminateRows(pElimStep, n))
+            return false;
+
+        /* Remind the divisor of the next elimination step. It is the current pivot
+           element; we can simply exchange the packed objects. */
+        const coe_packedCoef_t nextDivisor = pElimStep->pivot;
+        pElimStep->pivot = pElimStep->divisor;
+        pElimStep->divisor = nextDivisor;
+
+        /* In memory-lean operation, the coefficients of the upper lines of the matrix are
+           freed. We will end up with only the n-m+1 coefficients of the last line, that
+           represent the result. The pivot row of this step is no longer used; even its
+           diagonal element is dead, the next elimination step uses the packed copy as
+           divisor. */
+        if(isMemoryLean)
+        {
+            unsigned int col;
+            for(col=elimStep; col<n; col++)
+            {
+                coe_freeCoef(A[elimStep][col]);
+                A[elimStep][col] = coe_coefAddendNull();
+            }
+        }
+    } /* End for(All m-1 elimination steps) */
+
+    /* The result is now immediately available for the last unknown in the last row. The
+       denominator of this result is the system determinant if we consider possible
+       intermediate sign changes caused by pivoting. We want to do so. */
+    if(doSignInversion)
+    {
+        /* All non null coefficients of the last equation after the last elimination step
+           are sign inverted. The equation is thus not changed. */
+        unsigned int col;
+        for(col=m-1; col<n; ++col)
+            coe_mulConst(A[m-1][col], /* constant */ -1);
+    }
+
+    return true;
 
 } /* End of solverLES */
 
 
 
 
+/**
+ * Select the pivot element of an elimination step of the fraction-free Gauss-Jordan
+ * elimination. The unknown is chosen, whose diagonal element has the fewest addends. The
+ * pivot element is an operand of all elementary steps of the elimination step and it is
+ * the divisor of all elementary steps of the next one. Even more important, the diagonal
+ * elements are the principal minors of the LES, which are formed by the already eliminated
+ * unknowns plus the one in question; choosing the smallest one keeps all intermediate
+ * results small. A good order of elimination saves a significant part of the computation
+ * and of the memory.\n
+ *   A structural criterion, like the Markowitz criterion, is not suitable. The fill-ins
+ * are irrelevant in fraction-free elimination; all coefficients of all rows under progress
+ * are anyway manipulated in each elimination step.
+ *   @return
+ * Get the index of the row and column of the pivot element. It is \a elimStep if all
+ * diagonal elements of the remaining unknowns are null.
+ *   @param A
+ * The LES under progress.
+ *   @param m
+ * The number of unknowns of the LES.
+ *   @param elimStep
+ * The index of the elimination step. The diagonal elements of the unknowns
+ * \a elimStep..m-1 are considered.
+ */
+
+static unsigned int selectPivotElement( const coe_coefMatrix_t A
+                                      , const unsigned int m
+                                      , const unsigned int elimStep
+                                      )
+{
+    unsigned int idxPivot = elimStep
+               , minNoAddends = UINT_MAX
+               , idxUnknown;
+    for(idxUnknown=elimStep; idxUnknown<m; ++idxUnknown)
+    {
+        /* The number of addends is determined only up to the best count so far. */
+        const coe_coefAddend_t *pAddend = A[idxUnknown][idxUnknown];
+        unsigned int noAddends = 0;
+        while(!coe_isCoefAddendNull(pAddend)  &&  noAddends < minNoAddends)
+        {
+            ++ noAddends;
+            pAddend = pAddend->pNext;
+        }
+        if(noAddends > 0  &&  noAddends < minNoAddends)
+        {
+            idxPivot = idxUnknown;
+            minNoAddends = noAddends;
+        }
+    }
+
+    return idxPivot;
+
+} /* End of selectPivotElement */
+
+
+
+
+/**
+ * Apply a symmetric permutation to the LHS of a LES: Rows and columns of the unknowns are
+ * reordered in the same way. This doesn't change the solution of the LES and not even the
+ * sign of its determinant. The RHS columns of the knowns are not affected.
+ *   @param A
+ * The LES, which is permuted in place. Only pointers to rows and coefficients are moved.
+ *   @param m
+ * The number of unknowns of the LES.
+ *   @param orderAry
+ * The permutation. Element \a k is the index of the row and column, which are moved to
+ * position \a k.
+ *   @param doInverse
+ * If \a true, the inverse permutation is applied: Row and column \a k are moved to
+ * position orderAry[k].
+ */
+
+static void permuteLES( coe_coefMatrix_t A
+                      , const unsigned int m
+                      , const unsigned int orderAry[]
+                      , boolean doInverse
+                      )
+{
+    coe_coef_t **rowAry[m];
+    coe_coef_t *coefAry[m];
+    unsigned int row, k;
+
+    for(k=0; k<m; ++k)
+        rowAry[k] = A[k];
+    for(k=0; k<m; ++k)
+    {
+        if(doInverse)
+            A[orderAry[k]] = rowAry[k];
+        else
+            A[k] = rowAry[orderAry[k]];
+    }
+
+    for(row=0; row<m; ++row)
+    {
+        coe_coef_t ** const pRow = A[row];
+        for(k=0; k<m; ++k)
+            coefAry[k] = pRow[k];
+        for(k=0; k<m; ++k)
+        {
+            if(doInverse)
+                pRow[orderAry[k]] = coefAry[k];
+            else
+                pRow[k] = coefAry[orderAry[k]];
+        }
+    }
+} /* End of permuteLES */
+
+
+
+
+/**
+ * The solver for a linear equation system, which figures out the solution for all unknowns
+ * in a single run.\n
+ *   The system is solved by the fraction-free Gauss-Jordan elimination method. It is the
+ * same modified Gaussian elimination as implemented by solverLES but each elimination step
+ * does not only manipulate the rows below the pivot row but the rows above, too. The
+ * elementary operation and its known divisor are identical for both groups of rows. After
+ * the last elimination step all diagonal elements of the LHS would hold the system
+ * determinant and the RHS columns of any row \a i would hold the numerators of the solution
+ * for unknown \a i. Other than solverLES, this function needs one elimination only to find
+ * the solutions of all unknowns; solverLES needs to be run once per unknown, each time
+ * repeating most of the computation.\n
+ *   To save memory and computation time, only the diagonal element of the last row is
+ * kept; it holds the system determinant. The diagonal elements of all other rows are
+ * freed as soon as they are no longer needed as divisor. Moreover, the rows above the pivot
+ * row are manipulated only if they belong to an unknown, which is actually required. The
+ * coefficients of all other rows are freed as soon as the row has served as pivot row.\n
+ *   The order of elimination of the unknowns is chosen step by step such that the
+ * intermediate results stay small, see selectPivotElement. The unknowns are reordered by
+ * symmetric permutations of the LES, which are undone before return.
+ *   @return
+ * The function returns true if the LES could be solved. false is returned in case of
+ * linearly dependent equations or if the system determinant is null.
+ *   @param A
+ * The array of coefficients, which are manipulated in place. The result is returned in
+ * place.\n
+ *   The array is organized as m rows and n columns, where n >= m+1. The rectangular area
+ * A[0..m-1][0..m-1] holds the coefficients belonging to the m unknowns. If the algorithm
+ * returns true than this area is null with the exception of A[m-1][m-1], which holds the
+ * system determinant, the common denominator of the solutions of all unknowns.\n
+ *   A[0..m-1][m..n-1] holds the left hand side of the LES (where the sign of these
+ * coefficients is such that the sum of all row elements becomes null). Column i, i=m..n-1,
+ * holds the coefficients belonging to the known input variable i-m. If the algorithm
+ * returns true than row i of this area contains the numerators of the solution of unknown
+ * i, or null if this unknown was not required.
+ *   @param m
+ * The number \a m of rows of the matrix \a A.
+ *   @param n
+ * The number \a n of columns of the matrix \a A.
+ *   @param isRowRequiredAry
+ * A Boolean vector of \a m elements. Element \a i tells whether the solution of the unknown
+ * in column \a i is required.
+ *   @param pIsDetNull
+ * The function returns false if the LES can't be solved. In this case * \a pIsDetNull
+ * tells whether this is because only the very last elimination step failed. All prior
+ * steps had succeeded and the system determinant has been found to be null. No error
+ * message has been written in this case.
+ *   @param orderAry
+ * The order of elimination is returned in this array of \a m elements. Element \a k is the
+ * index of the unknown, which had been eliminated in elimination step \a k. The contents
+ * are valid for the elimination steps, which have been done, even if the function fails.
+ *   @see boolean solverLES(coe_coefMatrix_t, const unsigned int, const unsigned int)
+ */
+
+static boolean solverLESForAllUnknowns( coe_coefMatrix_t A
+                                      , const unsigned int m
+                                      , const unsigned int n
+                                      , const boolean isRowRequiredAsIsAry[]
+                                      , boolean * const pIsDetNull
+                                      , unsigned int orderAry[]
+                                      )
+{
+    *pIsDetNull = false;
+
+    /* The unknowns are reordered during elimination. Row i of the permuted LES belongs to
+       unknown orderAry[i]. */
+    boolean isRowRequiredAry[m];
+    unsigned int idxUnknown;
+    for(idxUnknown=0; idxUnknown<m; ++idxUnknown)
+    {
+        orderAry[idxUnknown] = idxUnknown;
+        isRowRequiredAry[idxUnknown] = isRowRequiredAsIsAry[idxUnknown];
+    }
+
+    /* The first elimination step doesn't know a common divisor yet. The divisor is
+       initialized with one. */
+    elimStep_t * const pElimStep = &_elimStep;
+    pElimStep->A = A;
+    reserveRowsOfElimStep(pElimStep, m);
+    coe_reservePackedCoef(&pElimStep->divisor, 1);
+    pElimStep->divisor.noAddends = 1;
+    pElimStep->divisor.factorAry[0] = 1;
+    coe_copyProductOfConst( &pElimStep->divisor.productOfConstAry[0]
+                          , COE_PRODUCT_OF_NO_CONST.wordAry
+                          , coe_getNoWordsOfProduct()
+                          );
+
+    /* The elementary steps are selected by the pattern of non null coefficients. */
+    initPatternOfElimStep(pElimStep, A, m, n);
+
+    /* Do all m elimination steps. Other than in solverLES, the last step is required, too:
+       it eliminates the last column in all rows above the last row. */
+    unsigned int elimStep;
+    boolean success = true
+          , doSignInversion = false;
+    for(elimStep=0; success && elimStep<m; ++elimStep)
+    {
+        /* Choose the unknown to eliminate in this step. It is moved to row and column
+           elimStep. The symmetric exchange of rows and columns doesn't change the sign of
+           the determinant. Only rows, which have not been used as pivot row yet, and their
+           columns are considered. */
+        const unsigned int idxPivot = selectPivotElement(A, m, elimStep);
+        if(idxPivot != elimStep)
+        {
+            coe_coef_t ** const pivotRow = A[idxPivot];
+            A[idxPivot] = A[elimStep];
+            A[elimStep] = pivotRow;
+
+            unsigned int row;
+            for(row=0; row<m; ++row)
+            {
+                coe_coef_t * const pCoef = A[row][idxPivot];
+                A[row][idxPivot] = A[row][elimStep];
+                A[row][elimStep] = pCoef;
+            }
+            exchangeRowsOfPattern(pElimStep, idxPivot, elimStep);
+            exchangeColsOfPattern(pElimStep, m, idxPivot, elimStep);
+
+            const boolean isRowRequired = isRowRequiredAry[idxPivot];
+            isRowRequiredAry[idxPivot] = isRowRequiredAry[elimStep];
+            isRowRequiredAry[elimStep] = isRowRequired;
+
+            idxUnknown = orderAry[idxPivot];
+            orderAry[idxPivot] = orderAry[elimStep];
+            orderAry[elimStep] = idxUnknown;
+        }
+
+        /* Pivoting: Avoid a generalizing product with a null coefficient, which would
+           break the algorithm. We look for a line below, whose coefficient under progress
+           is not null. The rows above must not be used; they have been used as pivot rows
+           before.
+             This is the rare case that all remaining diagonal elements are null. */
+        if(coe_isCoefAddendNull(A[elimStep][elimStep]))
+        {
+            /* If only the last pivot element is null then the system determinant is null.
+               The calling code decides how to proceed. */
+            if(elimStep == m-1)
+            {
+                *pIsDetNull = true;
+                success = false;
+                break;
+            }
+
+            unsigned int idxPivotRow = elimStep;
+            do
+            {
+                if(++idxPivotRow >= m)
+                {
+                    /* No usable line found at all. The network analysis, which is part of
+                       making the LES, failed to recognize the problem when checking the
+                       (physical) constraints, which apply to an electric circuit. */
+                    LOG_ERROR( _log
+                             , "Gauss elimination of LES is aborted. Pivoting doesn't find"
+                               " any non null coefficient in the %u. elimination step. The"
+                               " equations are linear dependent or contradictory. Please"
+                               " double-check your circuit net list"
+                             , elimStep+1
+                             )
+                    success = false;
+                    break;
+                }
+            }
+            while(coe_isCoefAddendNull(A[idxPivotRow][elimStep]));
+            if(!success)
+                break;
+
+            LOG_DEBUG( _log
+                     , "Pivoting in elimination step %u: Line exchange %u <-> %u"
+                     , elimStep
+                     , elimStep, idxPivotRow
+                     );
+
+            /* Exchange the row of the current elimination step with the pivot row. Both
+               rows have not been used as pivot row yet, so they are both operated in all
+               remaining columns. */
+            coe_coef_t **elimRow = A[elimStep];
+            A[elimStep] = A[idxPivotRow];
+            A[idxPivotRow] = elimRow;
+            exchangeRowsOfPattern(pElimStep, elimStep, idxPivotRow);
+
+            /* Each exchange of rows means a sign change of the determinant of the LES. */
+            doSignInversion = !doSignInversion;
+
+        } /* End if(Pivot element is null) */
+
+        /* Do the coefficient elimination/manipulation for all rows but the pivot row and
+           for all not yet handled columns. Rows above the pivot row, which belong to an
+           unknown that is not required, had already been freed. */
+        pElimStep->idxStep = elimStep;
+        coe_packCoef(&pElimStep->pivot, A[elimStep][elimStep]);
+        unsigned int row;
+        pElimStep->noRows = 0;
+        for(row=0; row<m; ++row)
+        {
+            if(row != elimStep  &&  (row > elimStep  ||  isRowRequiredAry[row]))
+                pElimStep->idxRowAry[pElimStep->noRows++] = row;
+        }
+        if(!eliminateRows(pElimStep, n))
+        {
+            success = false;
+            break;
+        }
+
+        /* The divisor of this elimination step is the diagonal element of the previous one.
+           It is no longer used and can be freed. */
+        if(elimStep > 0)
+        {
+            coe_freeCoef(A[elimStep-1][elimStep-1]);
+            A[elimStep-1][elimStep-1] = coe_coefAddendNull();
+        }
+
+        /* A pivot row, which belongs to a not required unknown won't be used any more; all
+           of its coefficients but the divisor of the next elimination step can be freed. */
+        if(!isRowRequiredAry[elimStep]  &&  elimStep < m-1)
+        {
+            unsigned int col;
+            for(col=elimStep+1; col<n; ++col)
+            {
+                coe_freeCoef(A[elimStep][col]);
+                A[elimStep][col] = coe_coefAddendNull();
+            }
+        }
+
+        /* Remind the divisor of the next elimination step. It is the current pivot
+           element; we can simply exchange the packed objects. */
+        const coe_packedCoef_t nextDivisor = pElimStep->pivot;
+        pElimStep->pivot = pElimStep->divisor;
+        pElimStep->divisor = nextDivisor;
+
+    } /* End for(All m elimination steps) */
+
+    /* Undo the reordering of the unknowns. The system determinant is found in the diagonal
+       element of the unknown eliminated last; it's moved to the bottom right corner, where
+       the other diagonal elements have already been freed. */
+    permuteLES(A, m, orderAry, /* doInverse */ true);
+    if(!success)
+        return false;
+    if(orderAry[m-1] != m-1)
+    {
+        assert(coe_isCoefAddendNull(A[m-1][m-1]));
+        A[m-1][m-1] = A[orderAry[m-1]][orderAry[m-1]];
+        A[orderAry[m-1]][orderAry[m-1]] = coe_coefAddendNull();
+    }
+
+    /* The result is now available for all required unknowns. The denominator of the
+       results is the system determinant if we consider possible intermediate sign changes
+       caused by pivoting. We want to do so. */
+    if(doSignInversion)
+    {
+        /* All non null coefficients of the result equations are sign inverted. The
+           equations are thus not changed. */
+        coe_mulConst(A[m-1][m-1], /* constant */ -1);
+        unsigned int row;
+        for(row=0; row<m; ++row)
+        {
+            unsigned int col;
+            for(col=m; col<n; ++col)
+                coe_mulConst(A[row][col], /* constant */ -1);
+        }
+    }
+
+    return true;
+
+} /* End of solverLESForAllUnknowns */
+
+
+
+
+/**
+ * Find the independent subsystems of a LES. Two unknowns belong to the same subsystem if
+ * one of them has a non null coefficient in the equation (i.e. row) of the other one or if
+ * they are connected through a chain of such unknowns. Unconnected parts of a circuit
+ * yield independent subsystems - unless they are coupled by controlled sources.
+ *   @return
+ * Get the number of subsystems.
+ *   @param idxSubsystemAry
+ * An array of \a m elements. Element \a i receives the index of the subsystem, which
+ * unknown \a i belongs to. The subsystems are numbered in the order of their first
+ * unknowns.
+ *   @param A
+ * The LES as set up for the solver.
+ *   @param m
+ * The number of unknowns of the LES.
+ */
+
+static unsigned int findIndependentSubsystems( unsigned int idxSubsystemAry[]
+                                             , const coe_coefMatrix_t A
+                                             , const unsigned int m
+                                             )
+{
+    unsigned int idxUnknown;
+    for(idxUnknown=0; idxUnknown<m; ++idxUnknown)
+        idxSubsystemAry[idxUnknown] = UINT_MAX;
+
+    /* The unknowns of a subsystem are collected by a depth first search. The stack holds
+       the found unknowns, which still need to be examined for their neighbours. */
+    unsigned int stackAry[m]
+               , noSubsystems = 0;
+    for(idxUnknown=0; idxUnknown<m; ++idxUnknown)
+    {
+        if(idxSubsystemAry[idxUnknown] != UINT_MAX)
+            continue;
+
+        unsigned int sizeOfStack = 0;
+        idxSubsystemAry[idxUnknown] = noSubsystems;
+        stackAry[sizeOfStack++] = idxUnknown;
+        while(sizeOfStack > 0)
+        {
+            const unsigned int i = stackAry[--sizeOfStack];
+            unsigned int j;
+            for(j=0; j<m; ++j)
+            {
+                if(idxSubsystemAry[j] == UINT_MAX
+                   &&  (!coe_isCoefAddendNull(A[i][j])  ||  !coe_isCoefAddendNull(A[j][i]))
+                  )
+                {
+                    idxSubsystemAry[j] = noSubsystems;
+                    stackAry[sizeOfStack++] = j;
+                }
+            }
+        }
+        ++ noSubsystems;
+    }
+
+    return noSubsystems;
+
+} /* End of findIndependentSubsystems */
+
+
+
+
+/**
+ * The solver for a linear equation system, which decomposes into independent subsystems.
+ * Each subsystem is solved by solverLESForAllUnknowns and the solution of the LES is
+ * assembled from the partial results:\n
+ *   After reordering of the unknowns, the LES has block diagonal form. Its determinant is
+ * the product of the determinants of the subsystems and the numerator of the solution of
+ * an unknown is the numerator of its subsystem times the determinants of all other
+ * subsystems. The result is identical to the result of solverLESForAllUnknowns for the
+ * entire LES but the costs of symbolic elimination grow steeply with the number of
+ * unknowns; solving several small systems is much cheaper.
+ *   @return
+ * The function returns true if the LES could be solved. false is returned in case of
+ * linearly dependent equations or if the system determinant is null.
+ *   @param A
+ * The array of coefficients, which are manipulated in place. The result is returned in
+ * place. See solverLESForAllUnknowns for details.
+ *   @param m
+ * The number \a m of rows of the matrix \a A.
+ *   @param n
+ * The number \a n of columns of the matrix \a A.
+ *   @param isRowRequiredAry
+ * A Boolean vector of \a m elements. Element \a i tells whether the solution of the unknown
+ * in column \a i is required.
+ *   @param noSubsystems
+ * The number of independent subsystems, at least two.
+ *   @param idxSubsystemAry
+ * The subsystem of each unknown as got from findIndependentSubsystems.
+ *   @param pIsDetNull
+ * The function returns false if the LES can't be solved. In this case * \a pIsDetNull
+ * tells whether this is because the system determinant of a subsystem has been found to be
+ * null. No error message has been written in this case.
+ *   @param orderAry
+ * The order of elimination is returned in this array of \a m elements. Element \a k is the
+ * index of the unknown, which had been eliminated in elimination step \a k, where the
+ * elimination steps of all subsystems are counted one after another.
+ *   @see boolean solverLESForAllUnknowns(coe_coefMatrix_t, const unsigned int, const
+ * unsigned int, const boolean [], boolean * const, unsigned int [])
+ */
+
+static boolean solverLESOfIndependentSubsystems( coe_coefMatrix_t A
+                                               , const unsigned int m
+                                               , const unsigned int n
+                                               , const boolean isRowRequiredAry[]
+                                               , const unsigned int noSubsystems
+                                               , const unsigned int idxSubsystemAry[]
+                                               , boolean * const pIsDetNull
+                                               , unsigned int orderAry[]
+                                               )
+{
+    assert(noSubsystems >= 2);
+    const unsigned int noKnowns = n - m;
+    coe_coef_t *detAry[noSubsystems];
+    boolean success = true;
+    unsigned int idxSubsystem, noElimSteps = 0;
+    for(idxSubsystem=0; idxSubsystem<noSubsystems; ++idxSubsystem)
+        detAry[idxSubsystem] = coe_coefAddendNull();
+
+    for(idxSubsystem=0; success && idxSubsystem<noSubsystems; ++idxSubsystem)
+    {
+        /* Build the LES of the subsystem. The coefficients are moved; the matrix of the
+           subsystem is just another view on them. */
+        unsigned int idxUnknownAry[m]
+                   , mSub = 0
+                   , idxUnknown;
+        for(idxUnknown=0; idxUnknown<m; ++idxUnknown)
+            if(idxSubsystemAry[idxUnknown] == idxSubsystem)
+                idxUnknownAry[mSub++] = idxUnknown;
+        assert(mSub > 0);
+
+        coe_coefMatrix_t ASub = coe_createMatrix(mSub, mSub+noKnowns);
+        boolean isRowRequiredSubAry[mSub];
+        unsigned int row, col;
+        for(row=0; row<mSub; ++row)
+        {
+            coe_coef_t ** const pRow = A[idxUnknownAry[row]];
+            isRowRequiredSubAry[row] = isRowRequiredAry[idxUnknownAry[row]];
+            for(col=0; col<mSub; ++col)
+            {
+                ASub[row][col] = pRow[idxUnknownAry[col]];
+                pRow[idxUnknownAry[col]] = coe_coefAddendNull();
+            }
+            for(col=0; col<noKnowns; ++col)
+            {
+                ASub[row][mSub+col] = pRow[m+col];
+                pRow[m+col] = coe_coefAddendNull();
+            }
+        }
+
+        LOG_DEBUG( _log
+                 , "Solving independent subsystem %u of %u with %u unknowns"
+                 , idxSubsystem+1
+                 , noSubsystems
+                 , mSub
+                 )
+        unsigned int orderSubAry[mSub];
+        prf_startSolverPass(mSub, mSub+noKnowns);
+        success = solverLESForAllUnknowns( ASub
+                                         , mSub
+                                         , mSub+noKnowns
+                                         , isRowRequiredSubAry
+                                         , pIsDetNull
+                                         , orderSubAry
+                                         );
+        prf_stopSolverPass();
+
+        /* Move the results back into the LES. If the subsystem couldn't be solved, then
+           the state of its elimination is moved back for reporting. */
+        for(row=0; row<mSub; ++row)
+        {
+            coe_coef_t ** const pRow = A[idxUnknownAry[row]];
+            for(col=0; col<mSub; ++col)
+                pRow[idxUnknownAry[col]] = ASub[row][col];
+            for(col=0; col<noKnowns; ++col)
+                pRow[m+col] = ASub[row][mSub+col];
+        }
+        /* The coefficients are owned by A again. Only the memory chunk of the matrix
+           remains to be freed; see crm_deleteMatrix. */
+        free(ASub);
+        for(row=0; row<mSub; ++row)
+            orderAry[noElimSteps++] = idxUnknownAry[orderSubAry[row]];
+
+        if(success)
+        {
+            const unsigned int idxLast = idxUnknownAry[mSub-1];
+            detAry[idxSubsystem] = A[idxLast][idxLast];
+            A[idxLast][idxLast] = coe_coefAddendNull();
+        }
+    } /* End for(All subsystems) */
+
+    if(success)
+    {
+        /* The numerators of each subsystem are multiplied with the determinants of all
+           other subsystems. These products are found as product of the determinants of all
+           subsystems before and all subsystems behind the given one. */
+        coe_coef_t *prodOfDetBehindAry[noSubsystems];
+        prodOfDetBehindAry[noSubsystems-1] = coe_coefAddendOne();
+        for(idxSubsystem=noSubsystems-1; idxSubsystem>0; --idxSubsystem)
+        {
+            prodOfDetBehindAry[idxSubsystem-1] = coe_mul( prodOfDetBehindAry[idxSubsystem]
+                                                        , detAry[idxSubsystem]
+                                                        );
+        }
+
+        coe_coef_t *pProdOfDetBefore = coe_coefAddendOne();
+        for(idxSubsystem=0; idxSubsystem<noSubsystems; ++idxSubsystem)
+        {
+            coe_coef_t * const pProdOfOtherDets =
+                            coe_mul(pProdOfDetBefore, prodOfDetBehindAry[idxSubsystem]);
+            unsigned int row;
+            for(row=0; row<m; ++row)
+            {
+                if(idxSubsystemAry[row] != idxSubsystem  ||  !isRowRequiredAry[row])
+                    continue;
+
+                unsigned int col;
+                for(col=m; col<n; ++col)
+                {
+                    coe_coef_t * const pNumerator = coe_mul(A[row][col], pProdOfOtherDets);
+                    coe_freeCoef(A[row][col]);
+                    A[row][col] = pNumerator;
+                }
+            }
+            coe_freeCoef(pProdOfOtherDets);
+            coe_freeCoef(prodOfDetBehindAry[idxSubsystem]);
+
+            coe_coef_t * const pProdOfDet = coe_mul(pProdOfDetBefore, detAry[idxSubsystem]);
+            coe_freeCoef(pProdOfDetBefore);
+            pProdOfDetBefore = pProdOfDet;
+        }
+
+        /* The system determinant is the product of all. */
+        assert(coe_isCoefAddendNull(A[m-1][m-1]));
+        A[m-1][m-1] = pProdOfDetBefore;
+    }
+    else
+    {
+        /* The remaining subsystems have not been eliminated. */
+        while(idxSubsystem < noSubsystems)
+        {
+            unsigned int idxUnknown;
+            for(idxUnknown=0; idxUnknown<m; ++idxUnknown)
+                if(idxSubsystemAry[idxUnknown] == idxSubsystem)
+                    orderAry[noElimSteps++] = idxUnknown;
+            ++ idxSubsystem;
+        }
+    }
+    assert(noElimSteps == m);
+
+    for(idxSubsystem=0; idxSubsystem<noSubsystems; ++idxSubsystem)
+        coe_freeCoef(detAry[idxSubsystem]);
+
+    return success;
+
+} /* End of solverLESOfIndependentSubsystems */
+
+
+
+
+/**
+ * Check if a coefficient is a numeric constant, i.e. if it doesn't depend on any of the
+ * physical constants of the circuit.
+ *   @return
+ * Get the Boolean answer. The null coefficient is a numeric constant, too.
+ *   @param pValue
+ * If the function returns true then the value of the constant is returned in * \a pValue.
+ * Otherwise * \a pValue is set to null.
+ *   @param pCoef
+ * The coefficient to check.
+ */
+
+static inline boolean isNumericCoef( coe_numericFactor_t * const pValue
+                                   , const coe_coef_t * const pCoef
+                                   )
+{
+    if(coe_isCoefAddendNull(pCoef))
+    {
+        *pValue = 0;
+        return true;
+    }
+    else if(coe_isCoefAddendNull(pCoef->pNext)
+            &&  coe_isProductOfNoConst(pCoef->productOfConst, coe_getNoWordsOfProduct())
+           )
+    {
+        *pValue = pCoef->factor;
+        return true;
+    }
+    else
+    {
+        *pValue = 0;
+        return false;
+    }
+} /* End of isNumericCoef */
+
+
+
+
+/**
+ * Presolve of the LES: Equations, which have numeric coefficients only and the coefficient
+ * one or minus one for at least one unknown, determine this unknown as a sum of other
+ * unknowns and knowns. These are the equations of the constant voltage sources, the op-amps
+ * and the current probes; the unknown is a node voltage. The unknown is substituted in all
+ * other equations; this is an elimination step of the Gaussian elimination, which requires
+ * no symbolic multiplication. Equation and unknown are removed from the LES, which is
+ * solved by the symbolic solver. Each removed unknown saves an elimination step of the
+ * symbolic solver and makes all others cheaper.\n
+ *   The substitution can make more equations numeric; all such equations are found. The
+ * unknown of each equation is chosen such that the fill-in is least.\n
+ *   The equations of the removed unknowns are kept unchanged in \a A. Their columns are
+ * null in all other rows. The solutions of the removed unknowns are later found by
+ * backSubstitutePresolvedUnknowns.
+ *   @return
+ * Get the number of removed unknowns. This is the number of used elements of \a stepAry.
+ *   @param stepAry
+ * The removed equations and unknowns are returned in this array of \a m elements in the
+ * order of their removal.
+ *   @param pSignOfDet
+ * The determinant of the LES is the determinant of the remaining, reduced LES times the
+ * sign, which is returned in * \a pSignOfDet.
+ *   @param A
+ * The array of coefficients, which are manipulated in place. It is organized as m rows
+ * and n columns, see solverLESForAllUnknowns.
+ *   @param m
+ * The number \a m of rows of the matrix \a A.
+ *   @param n
+ * The number \a n of columns of the matrix \a A.
+ *   @param isRowRemovedAry
+ * A Boolean vector of \a m elements. Element \a i is set to true if equation \a i has been
+ * removed from the LES.
+ *   @param isColRemovedAry
+ * A Boolean vector of \a m elements. Element \a i is set to true if unknown \a i has been
+ * removed from the LES.
+ */
+
+static unsigned int presolveLES( presolveStep_t stepAry[]
+                               , signed int * const pSignOfDet
+                               , coe_coefMatrix_t A
+                               , const unsigned int m
+                               , const unsigned int n
+                               , boolean isRowRemovedAry[]
+                               , boolean isColRemovedAry[]
+                               )
+{
+    unsigned int row, col;
+    for(row=0; row<m; ++row)
+        isRowRemovedAry[row] = isColRemovedAry[row] = false;
+    *pSignOfDet = 1;
+
+    unsigned int noSteps = 0;
+    boolean isFound;
+    do
+    {
+        isFound = false;
+        for(row=0; row<m; ++row)
+        {
+            if(isRowRemovedAry[row])
+                continue;
+
+            /* Check the equation and look for the unknown with the least number of
+               occurrences in the other equations. */
+            boolean isNumericRow = true;
+            unsigned int idxColPivot = UINT_MAX
+                       , minNoRefs = UINT_MAX;
+            coe_numericFactor_t pivot = 0;
+            double sumOfAbsValues = 0.0;
+            for(col=0; isNumericRow && col<n; ++col)
+            {
+                coe_numericFactor_t value;
+                if(!isNumericCoef(&value, A[row][col]))
+                {
+                    isNumericRow = false;
+                    continue;
+                }
+
+                sumOfAbsValues += fabs((double)value);
+                if(col < m  &&  (value == 1  ||  value == -1))
+                {
+                    assert(!isColRemovedAry[col]);
+                    unsigned int noRefs = 0
+                               , r;
+                    for(r=0; r<m; ++r)
+                        if(!isRowRemovedAry[r]  &&  !coe_isCoefAddendNull(A[r][col]))
+                            ++ noRefs;
+                    if(noRefs < minNoRefs)
+                    {
+                        idxColPivot = col;
+                        minNoRefs = noRefs;
+                        pivot = value;
+                    }
+                }
+            }
+            if(!isNumericRow  ||  idxColPivot == UINT_MAX)
+                continue;
+
+            /* The substitution multiplies the coefficients of the unknown with the values
+               of the equation. Devices with numeric value can make both large; a
+               substitution, which could overflow the numeric factors, is left to the
+               elimination, which checks the range. */
+            double maxAbsFactorOfCol = 0.0;
+            unsigned int r;
+            for(r=0; r<m; ++r)
+            {
+                const coe_coefAddend_t *pAddend;
+                for( pAddend=A[r][idxColPivot]
+                   ; !coe_isCoefAddendNull(pAddend)
+                   ; pAddend=pAddend->pNext
+                   )
+                {
+                    if(fabs((double)pAddend->factor) > maxAbsFactorOfCol)
+                        maxAbsFactorOfCol = fabs((double)pAddend->factor);
+                }
+            }
+            if(maxAbsFactorOfCol * sumOfAbsValues > (double)(LONG_MAX/4))
+                continue;
+
+            /* The determinant is the pivot element times the determinant of the minor,
+               with the sign given by its position in the not yet reduced LES. */
+            unsigned int pos = 0
+                       , u;
+            for(u=0; u<row; ++u)
+                if(!isRowRemovedAry[u])
+                    ++ pos;
+            for(u=0; u<idxColPivot; ++u)
+                if(!isColRemovedAry[u])
+                    ++ pos;
+            if((pos & 1u) != 0)
+                *pSignOfDet = -*pSignOfDet;
+            if(pivot < 0)
+                *pSignOfDet = -*pSignOfDet;
+
+            /* Substitute the unknown in all other remaining equations:
+               A[r][j] -= A[r][p]*A[row][j]/pivot, where the pivot is 1 or -1. */
+            for(r=0; r<m; ++r)
+            {
+                coe_coef_t * const pCoefOfUnknown = A[r][idxColPivot];
+                if(r == row
+                   ||  isRowRemovedAry[r]
+                   ||  coe_isCoefAddendNull(pCoefOfUnknown)
+                  )
+                {
+                    continue;
+                }
+
+                for(col=0; col<n; ++col)
+                {
+                    coe_numericFactor_t value;
+#ifdef DEBUG
+                    const boolean isNumeric =
+#endif
+                    isNumericCoef(&value, A[row][col]);
+                    assert(isNumeric);
+                    if(col == idxColPivot  ||  value == 0)
+                        continue;
+
+                    coe_coef_t * const pTerm = coe_mulConst
+                                                ( coe_cloneByDeepCopy(pCoefOfUnknown)
+                                                , /* constant */ value*pivot
+                                                );
+                    A[r][col] = coe_diff(A[r][col], pTerm);
+                    coe_freeCoef(pTerm);
+                }
+                coe_freeCoef(pCoefOfUnknown);
+                A[r][idxColPivot] = coe_coefAddendNull();
+            }
+
+            stepAry[noSteps].idxRow = row;
+            stepAry[noSteps].idxCol = idxColPivot;
+            stepAry[noSteps].pivot = (signed int)pivot;
+            ++ noSteps;
+            isRowRemovedAry[row] = true;
+            isColRemovedAry[idxColPivot] = true;
+            isFound = true;
+
+        } /* End for(All remaining equations) */
+    }
+    while(isFound);
+
+    return noSteps;
+
+} /* End of presolveLES */
+
+
+
+
+/**
+ * Compute the solutions of the unknowns, which had been removed from the LES by
+ * presolveLES, from the solutions of the other unknowns. The unknowns are handled in
+ * reverse order of their removal: An equation of a removed unknown refers only to the
+ * unknowns of the reduced LES and to unknowns, which had been removed later.\n
+ *   With the determinant D and the numerators N_j of the solutions of the LES, the
+ * numerators of unknown p, which is removed by equation s with pivot element A[s][p], are
+ * N_p = A[s][p] * (A[s][known]*D - sum_j(A[s][j]*N_j)),
+ * where the numerators are represented with the sign, which the elimination in place
+ * yields, see solverLESForAllUnknowns. All operations are additions and multiplications
+ * with the numeric coefficients of equation s.
+ *   @param numeratorAry
+ * A matrix of m rows and n-m columns. Row \a i holds the numerators of the solution of
+ * unknown \a i. On entry, the rows of the unknowns of the reduced LES are set. On return,
+ * the rows of the removed, required unknowns are set, too.
+ *   @param pDeterminant
+ * The system determinant of the entire LES.
+ *   @param A
+ * The LES after presolveLES. Only the equations of the removed unknowns are read.
+ *   @param m
+ * The number \a m of rows of the matrix \a A.
+ *   @param n
+ * The number \a n of columns of the matrix \a A.
+ *   @param stepAry
+ * The removed equations and unknowns as got from presolveLES.
+ *   @param noSteps
+ * The number of removed unknowns.
+ *   @param isUnknownRequiredAry
+ * A Boolean vector of \a m elements. Element \a i tells whether the solution of unknown
+ * \a i is required. All unknowns, which the equations of required removed unknowns refer
+ * to, need to be required, too.
+ */
+
+static void backSubstitutePresolvedUnknowns( coe_coefMatrix_t numeratorAry
+                                           , const coe_coef_t * const pDeterminant
+                                           , const coe_coefMatrix_t A
+                                           , const unsigned int m
+                                           , const unsigned int n
+                                           , const presolveStep_t stepAry[]
+                                           , const unsigned int noSteps
+                                           , const boolean isUnknownRequiredAry[]
+                                           )
+{
+    unsigned int idxStep = noSteps;
+    while(idxStep-- > 0)
+    {
+        const presolveStep_t * const pStep = &stepAry[idxStep];
+        if(!isUnknownRequiredAry[pStep->idxCol])
+            continue;
+
+        coe_coef_t ** const eqAry = A[pStep->idxRow];
+        unsigned int idxKnown;
+        for(idxKnown=0; idxKnown<n-m; ++idxKnown)
+        {
+            coe_coef_t *pNumerator = coe_coefAddendNull();
+            coe_numericFactor_t value;
+            unsigned int col;
+            for(col=0; col<m; ++col)
+            {
+                if(col == pStep->idxCol)
+                    continue;
+#ifdef DEBUG
+                const boolean isNumeric =
+#endif
+                isNumericCoef(&value, eqAry[col]);
+                assert(isNumeric);
+                if(value == 0)
+                    continue;
+
+                assert(isUnknownRequiredAry[col]);
+                if(coe_isCoefAddendNull(numeratorAry[col][idxKnown]))
+                    continue;
+                coe_coef_t * const pTerm = coe_mulConst
+                                          ( coe_cloneByDeepCopy(numeratorAry[col][idxKnown])
+                                          , /* constant */ value
+                                          );
+                pNumerator = coe_diff(pNumerator, pTerm);
+                coe_freeCoef(pTerm);
+            }
+
+#ifdef DEBUG
+            const boolean isNumeric =
+#endif
+            isNumericCoef(&value, eqAry[m+idxKnown]);
+            assert(isNumeric);
+            if(value != 0)
+            {
+                coe_coef_t * const pTerm = coe_mulConst
+                                                ( coe_cloneByDeepCopy(pDeterminant)
+                                                , /* constant */ -value
+                                                );
+                pNumerator = coe_diff(pNumerator, pTerm);
+                coe_freeCoef(pTerm);
+            }
+
+            if(pStep->pivot < 0)
+                coe_mulConst(pNumerator, /* constant */ -1);
+
+            assert(coe_isCoefAddendNull(numeratorAry[pStep->idxCol][idxKnown]));
+            numeratorAry[pStep->idxCol][idxKnown] = pNumerator;
+        }
+    } /* End for(All removed unknowns in reverse order) */
+
+} /* End of backSubstitutePresolvedUnknowns */
+
+
+
+
+/**
+ * Solve the LES for all required unknowns. Unconnected parts of the circuit are solved
+ * independently by solverLESOfIndependentSubsystems, a connected circuit is solved by
+ * solverLESForAllUnknowns. The interface and the result are identical to
+ * solverLESForAllUnknowns.
+ *   @return
+ * The function returns true if the LES could be solved. false is returned in case of
+ * linearly dependent equations or if the system determinant is null.
+ *   @param A
+ * The array of coefficients, which are manipulated in place. The result is returned in
+ * place. See solverLESForAllUnknowns for details.
+ *   @param m
+ * The number \a m of rows of the matrix \a A.
+ *   @param n
+ * The number \a n of columns of the matrix \a A.
+ *   @param isRowRequiredAry
+ * A Boolean vector of \a m elements. Element \a i tells whether the solution of the unknown
+ * in column \a i is required.
+ *   @param pIsDetNull
+ * The function returns false if the LES can't be solved. In this case * \a pIsDetNull
+ * tells whether this is because the system determinant has been found to be null. No
+ * error message has been written in this case.
+ *   @param orderAry
+ * The order of elimination is returned in this array of \a m elements.
+ */
+
+static boolean solverLESWithDecomposition( coe_coefMatrix_t A
+                                         , const unsigned int m
+                                         , const unsigned int n
+                                         , const boolean isRowRequiredAry[]
+                                         , boolean * const pIsDetNull
+                                         , unsigned int orderAry[]
+                                         )
+{
+    unsigned int idxSubsystemAry[m];
+    const unsigned int noSubsystems = findIndependentSubsystems(idxSubsystemAry, A, m);
+    boolean success;
+    if(noSubsystems > 1)
+    {
+        success = solverLESOfIndependentSubsystems( A
+                                                  , m
+                                                  , n
+                                                  , isRowRequiredAry
+                                                  , noSubsystems
+                                                  , idxSubsystemAry
+                                                  , pIsDetNull
+                                                  , orderAry
+                                                  );
+    }
+    else
+    {
+        prf_startSolverPass(m, n);
+        success = solverLESForAllUnknowns( A
+                                         , m
+                                         , n
+                                         , isRowRequiredAry
+                                         , pIsDetNull
+                                         , orderAry
+                                         );
+        prf_stopSolverPass();
+    }
+
+    return success;
+
+} /* End of solverLESWithDecomposition */
+
+
+
+
+/**
+ * Solve the LES for all required unknowns: The LES is reduced by presolveLES, the reduced
+ * LES is solved by solverLESWithDecomposition and the solutions of the removed unknowns
+ * are found by back-substitution. The interface and the result are identical to
+ * solverLESForAllUnknowns.\n
+ *   The presolve doesn't change the result; the system determinant and all numerators
+ * are identical to those of the elimination of the entire LES.
+ *   @return
+ * The function returns true if the LES could be solved. false is returned in case of
+ * linearly dependent equations or if the system determinant is null.
+ *   @param A
+ * The array of coefficients, which are manipulated in place. The result is returned in
+ * place. See solverLESForAllUnknowns for details.
+ *   @param m
+ * The number \a m of rows of the matrix \a A.
+ *   @param n
+ * The number \a n of columns of the matrix \a A.
+ *   @param isRowRequiredAry
+ * A Boolean vector of \a m elements. Element \a i tells whether the solution of the unknown
+ * in column \a i is required.
+ *   @param pIsDetNull
+ * The function returns false if the LES can't be solved. In this case * \a pIsDetNull
+ * tells whether this is because the system determinant has been found to be null. No
+ * error message has been written in this case.
+ *   @param orderAry
+ * The order of elimination is returned in this array of \a m elements. The unknowns
+ * removed by the presolve come first.
+ */
+
+static boolean solverLESWithPresolve( coe_coefMatrix_t A
+                                    , const unsigned int m
+                                    , const unsigned int n
+                                    , const boolean isRowRequiredAry[]
+                                    , boolean * const pIsDetNull
+                                    , unsigned int orderAry[]
+                                    )
+{
+    const unsigned int noKnowns = n - m;
+    presolveStep_t stepAry[m];
+    boolean isRowRemovedAry[m]
+          , isColRemovedAry[m];
+    signed int signOfDet;
+    const unsigned int noSteps = presolveLES( stepAry
+                                            , &signOfDet
+                                            , A
+                                            , m
+                                            , n
+                                            , isRowRemovedAry
+                                            , isColRemovedAry
+                                            );
+
+    LOG_DEBUG( _log
+             , "Presolve of LES: %u of %u unknowns are removed by substitution"
+             , noSteps
+             , m
+             )
+    if(noSteps == 0)
+    {
+        return solverLESWithDecomposition( A
+                                         , m
+                                         , n
+                                         , isRowRequiredAry
+                                         , pIsDetNull
+                                         , orderAry
+                                         );
+    }
+
+    /* The equations of the removed and required unknowns refer to other unknowns, whose
+       solutions are required for the back-substitution. An equation refers only to
+       unknowns, which are removed later or which are not removed at all. */
+    boolean isUnknownRequiredAry[m];
+    unsigned int idxStep, row, col;
+    for(col=0; col<m; ++col)
+        isUnknownRequiredAry[col] = isRowRequiredAry[col];
+    for(idxStep=0; idxStep<noSteps; ++idxStep)
+    {
+        const presolveStep_t * const pStep = &stepAry[idxStep];
+        orderAry[idxStep] = pStep->idxCol;
+        if(!isUnknownRequiredAry[pStep->idxCol])
+            continue;
+        for(col=0; col<m; ++col)
+        {
+            if(col != pStep->idxCol  &&  !coe_isCoefAddendNull(A[pStep->idxRow][col]))
+                isUnknownRequiredAry[col] = true;
+        }
+    }
+
+    /* The reduced LES is built from the remaining equations and unknowns. The coefficients
+       are moved; the matrix of the reduced LES is just another view on them.
+         An equation is assigned to the unknown it had belonged to. If this unknown has
+       been removed then it is assigned to the unknown of the equation, which had removed
+       it - or to the unknown this equation had been assigned to and so on. This keeps
+       the equations of unconnected parts of the circuit apart so that they can still be
+       solved independently. */
+    unsigned int idxRowOfColAry[m];
+    for(idxStep=0; idxStep<noSteps; ++idxStep)
+        idxRowOfColAry[stepAry[idxStep].idxCol] = stepAry[idxStep].idxRow;
+    const unsigned int mRed = m - noSteps;
+    unsigned int idxRowRedAry[mRed > 0? mRed: 1]
+               , idxColRedAry[mRed > 0? mRed: 1]
+               , u = 0;
+    for(row=0; row<m; ++row)
+    {
+        if(!isRowRemovedAry[row])
+        {
+            col = row;
+            while(isColRemovedAry[col])
+                col = idxRowOfColAry[col];
+            idxRowRedAry[u] = row;
+            idxColRedAry[u] = col;
+            ++ u;
+        }
+    }
+    assert(u == mRed);
+
+    /* The sign of the determinant has been determined for the unknowns of the reduced LES
+       in their natural order. It changes with each transposition of two of them. */
+    for(row=0; row<mRed; ++row)
+        for(u=row+1; u<mRed; ++u)
+            if(idxColRedAry[u] < idxColRedAry[row])
+                signOfDet = -signOfDet;
+
+    coe_coef_t *pDeterminant = coe_coefAddendOne();
+    coe_coefMatrix_t ARed = NULL;
+    boolean success = true;
+    if(mRed > 0)
+    {
+        const unsigned int nRed = mRed + noKnowns;
+        ARed = coe_createMatrix(mRed, nRed);
+        boolean isRowRequiredRedAry[mRed];
+        for(row=0; row<mRed; ++row)
+        {
+            coe_coef_t ** const pRow = A[idxRowRedAry[row]];
+            isRowRequiredRedAry[row] = isUnknownRequiredAry[idxColRedAry[row]];
+            for(col=0; col<mRed; ++col)
+            {
+                ARed[row][col] = pRow[idxColRedAry[col]];
+                pRow[idxColRedAry[col]] = coe_coefAddendNull();
+            }
+            for(col=0; col<noKnowns; ++col)
+            {
+                ARed[row][mRed+col] = pRow[m+col];
+                pRow[m+col] = coe_coefAddendNull();
+            }
+        }
+
+        unsigned int orderRedAry[mRed];
+        success = solverLESWithDecomposition( ARed
+                                            , mRed
+                                            , nRed
+                                            , isRowRequiredRedAry
+                                            , pIsDetNull
+                                            , orderRedAry
+                                            );
+        for(row=0; row<mRed; ++row)
+            orderAry[noSteps+row] = idxColRedAry[orderRedAry[row]];
+
+        if(success)
+        {
+            coe_freeCoef(pDeterminant);
+            pDeterminant = ARed[mRed-1][mRed-1];
+            ARed[mRed-1][mRed-1] = coe_coefAddendNull();
+        }
+        else
+        {
+            /* The state of the elimination is moved back for reporting. */
+            for(row=0; row<mRed; ++row)
+            {
+                coe_coef_t ** const pRow = A[idxRowRedAry[row]];
+                for(col=0; col<mRed; ++col)
+                    pRow[idxColRedAry[col]] = ARed[row][col];
+                for(col=0; col<noKnowns; ++col)
+                    pRow[m+col] = ARed[row][mRed+col];
+            }
+            free(ARed);
+            coe_freeCoef(pDeterminant);
+            return false;
+        }
+    }
+    else
+    {
+        /* The LES is entirely solved by the presolve; the reduced LES is empty and its
+           determinant is one. */
+        *pIsDetNull = false;
+    }
+
+    /* Collect the numerators of all unknowns. Row i of the reduced LES holds the solution
+       of unknown i of the reduced LES. All signs relate to the determinant of the reduced
+       LES; they are corrected for the determinant of the entire LES. */
+    coe_coefMatrix_t numeratorAry = coe_createMatrix(m, noKnowns > 0? noKnowns: 1);
+    for(row=0; row<mRed; ++row)
+    {
+        for(col=0; col<noKnowns; ++col)
+        {
+            coe_coef_t * const pNumerator = ARed[row][mRed+col];
+            ARed[row][mRed+col] = coe_coefAddendNull();
+            numeratorAry[idxColRedAry[row]][col] = signOfDet < 0
+                                                   ? coe_mulConst(pNumerator, -1)
+                                                   : pNumerator;
+        }
+    }
+    if(signOfDet < 0)
+        coe_mulConst(pDeterminant, /* constant */ -1);
+
+    /* The reduced LES is no longer needed; its remaining coefficients are owned by it. */
+    if(ARed != NULL)
+        coe_deleteMatrix(ARed, mRed, mRed+noKnowns);
+
+    backSubstitutePresolvedUnknowns( numeratorAry
+                                   , pDeterminant
+                                   , A
+                                   , m
+                                   , n
+                                   , stepAry
+                                   , noSteps
+                                   , isUnknownRequiredAry
+                                   );
+
+    /* Return the result in place, in the layout of solverLESForAllUnknowns. */
+    for(row=0; row<m; ++row)
+    {
+        for(col=0; col<m; ++col)
+        {
+            coe_freeCoef(A[row][col]);
+            A[row][col] = coe_coefAddendNull();
+        }
+        for(col=0; col<noKnowns; ++col)
+        {
+            coe_freeCoef(A[row][m+col]);
+            A[row][m+col] = numeratorAry[row][col];
+        }
+    }
+    A[m-1][m-1] = pDeterminant;
+
+    /* The coefficients are owned by A now. Only the memory chunk of the matrix remains to
+       be freed; see crm_deleteMatrix. */
+    free(numeratorAry);
+
+    return true;
+
+} /* End of solverLESWithPresolve */
+
+
+
+
+/**
+ * Compute the solution of the LES by running the core solver solverLES once per required
+ * unknown. Prior to calling the core solver it reorders the unknowns so that each of them
+ * is found once as last one.\n
+ *   This had been the original solution strategy. It repeats the computation of the same
+ * system determinant for each unknown and is thus much more expensive than
+ * solveAllUnknownsAtOnce. It is still used as fallback if the system determinant is null
+ * and in the DEBUG compilation to double-check the results of the faster solver.
+ *   @return
+ * true if the LES could be solved, false otherwise. No error message is written in the
+ * latter case.
+ *   @param numeratorAry
+ * The numerators of the solution of the required unknowns are stored in this matrix. The
+ * rows of the unknowns, which are not required, are not touched.
+ *   @param ppDeterminant
+ * The system determinant is returned in * \a ppDeterminant. It needs to be null on entry.
+ *   @param pLES
+ * The LES to solve. It is modified in place.
+ *   @param pTabOfVars
+ * The table of variables of the solution. It determines the position of the solution of a
+ * required unknown in \a numeratorAry.
+ *   @param pIsDependentAvailableAry
+ * A Boolean vector telling which of the unknowns of the LES are required.
+ */
+
+static boolean solveUnknownByUnknown( coe_coefMatrix_t numeratorAry
+                                    , coe_coef_t * * const ppDeterminant
+                                    , les_linearEquationSystem_t * const pLES
+                                    , const tbv_tableOfVariables_t * const pTabOfVars
+                                    , const boolean * const pIsDependentAvailableAry
+                                    )
+{
+    unsigned int noKnowns, noUnknowns, noConstants;
+    les_getNoVariables(pLES, &noKnowns, &noUnknowns, &noConstants);
+
+    /* We need a loop over all unknowns. */
+    const tbv_unknownVariable_t * const unknownAry = les_getTableOfUnknowns(pLES, NULL);
+
+    boolean success = true
+          , storeDet = true
+          , isSignOfDetInv = true;
+    unsigned int idxUnknown;
+    for(idxUnknown=0; success && idxUnknown<noUnknowns; ++idxUnknown)
+    {
+        if(!pIsDependentAvailableAry[idxUnknown])
+            continue;
+        
+        const char * const nameOfUnknown = unknownAry[idxUnknown].name;
+
+        /* Setup the matrix of coefficients so that the coefficients in column m relate the
+           the unknown of interest.
+             Sign of determinante: Basically, each call of the solver of the LES will
+           (re-)produce the same value of the system determinante. Only the sign will be
+           toggled each time because each time we setup the LES we exchange one pair of
+           columns. We need to keep track of the sign inversion in order to become able to
+           store the determinante only once for all dependents. */
+        success = les_setupLES(pLES, nameOfUnknown);
+        isSignOfDetInv = !isSignOfDetInv;
+
+        /* Run the symbolic solver, which makes an upper triangular matrix from the LES. It
+           fails if the system determinant is null. */
+        if(success)
+        {
+            prf_startSolverPass(noUnknowns, noKnowns + noUnknowns);
+            success = solverLES( pLES->A, /* m */ noUnknowns, /* n */ noKnowns + noUnknowns);
+            prf_stopSolverPass();
+
+            /* Logging can be done even if the solver fails: We could recognize the linear
+               dependent equations in the reported last state of the elimination. */
+            if(log_checkLogLevel(_log, log_debug))
+            {
+                LOG_DEBUG( _log
+                         , "LES after%s elimination of %s:"
+                         , success? "": " aborted"
+                         , nameOfUnknown
+                         )
+                coe_logMatrix( log_debug
+                             , pLES->A
+                             , /* m */ noUnknowns
+                             , /* n */ noKnowns + noUnknowns
+                             , pLES->pTableOfVars
+                             );
+            }
+        }
+
+        /* Don't do further result evaluation and storage if there's no solution. */
+        if(!success)
+            break;
+
+        /* The system determinant is the denominator of all result terms. It is stored only
+           in the first cycle. (The debug compilation validates identity in subsequent
+           runs.) */
+        if(storeDet)
+        {
+            /* The ownership of the coefficient that holds the determinant is moved from
+               *pLES to the newly created solution object. The coefficient in *pLES is set
+               to the null object in order to inhibit later freeing of the moved
+               coefficient object. */
+            assert(coe_isCoefAddendNull(*ppDeterminant));
+            *ppDeterminant = pLES->A[noUnknowns-1][noUnknowns-1];
+            pLES->A[noUnknowns-1][noUnknowns-1] = coe_coefAddendNull();
+            storeDet = false;
+        }
+        else
+        {
+#ifdef DEBUG
+            /* Validate identity of the system determinant in each repeated solution of the
+               LES.
+                 Caution: The validation changes the coefficient matrix pLES->A in
+               comparison to the PRODUCTION compilation. */
+
+            /* We have to consider that in each loop one pair of columns of the LES is
+               swapped, this leads to a sign inversion of the determinant. Here, we
+               compensate for this. */
+            if(isSignOfDetInv)
+                coe_mulConst(pLES->A[noUnknowns-1][noUnknowns-1], /* constant */ -1);
+
+            pLES->A[noUnknowns-1][noUnknowns-1] = coe_diff( pLES->A[noUnknowns-1][noUnknowns-1]
+                                                          , *ppDeterminant
+                                                          );
+            assert(coe_isCoefAddendNull(pLES->A[noUnknowns-1][noUnknowns-1]));
+#endif
+        } /* End if(The very first unknown or any other one?) */
+
+        /* Store the terms of the result of this unknown in the solution object. One such
+           term exists for each known.
+             The ownership of the coefficients that hold the terms is moved from *pLES to
+           the newly created solution object. The coefficients in *pLES are set to null
+           objects in order to inhibit later freeing of the moved coefficient objects. */
+        unsigned int idxKnown;
+        const unsigned int idxUnknownInSol = pTabOfVars->unknownLookUpAry[idxUnknown].idxCol;
+        assert(strcmp(pTabOfVars->unknownLookUpAry[idxUnknown].name, nameOfUnknown) == 0);
+        for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+        {
+            numeratorAry[idxUnknownInSol][idxKnown] =
+                                                    pLES->A[noUnknowns-1][noUnknowns+idxKnown];
+            pLES->A[noUnknowns-1][noUnknowns+idxKnown] = coe_coefAddendNull();
+
+            /* The LES had been set up with all terms on one side and the condition sum of
+               all is null. This means that the coefficients of the numerators need to be
+               sign inverted in the result.
+                 We have to consider also that in each loop one pair of columns of the LES is
+               swapped, which leads to a sign inversion of the determinant. We have stored
+               the determinant of the first loop as common denominator, so need to do a
+               sign inversion in every other cycle.
+                 Putting both together we need to do the inversion in the first and then in
+               every second cyle. */
+            if(!isSignOfDetInv)
+                coe_mulConst(numeratorAry[idxUnknownInSol][idxKnown], /* constant */ -1);
+        }
+        
+    } /* End for(All required unknowns of the LES) */
+
+    assert(!success || !storeDet);
+
+    return success;
+
+} /* End of solveUnknownByUnknown */
+
+
+
+
+/**
+ * Compute the solution of the LES for all required unknowns by a single run of the core
+ * solver solverLESForAllUnknowns. A network of passive devices and current sources is
+ * solved by enumeration of its spanning trees instead, see spt_solverLES.
+ *   @return
+ * true if the LES could be solved, false otherwise.
+ *   @param numeratorAry
+ * The numerators of the solution of the required unknowns are stored in this matrix. The
+ * rows of the unknowns, which are not required, are not touched.
+ *   @param ppDeterminant
+ * The system determinant is returned in * \a ppDeterminant. It needs to be null on entry.
+ *   @param pLES
+ * The LES to solve. It is modified in place.
+ *   @param pTabOfVars
+ * The table of variables of the solution. It determines the position of the solution of a
+ * required unknown in \a numeratorAry.
+ *   @param pIsDependentAvailableAry
+ * A Boolean vector telling which of the unknowns of the LES are required.
+ *   @param pIsDetNull
+ * If the function returns false then * \a pIsDetNull tells whether the LES could be set up
+ * and eliminated up to the very last step, where the system determinant has been found
+ * to be null. No error has been reported in this case and the calling code can decide
+ * how to continue. In all other cases of failure an error has been reported.
+ */
+
+static boolean solveAllUnknownsAtOnce( coe_coefMatrix_t numeratorAry
+                                     , coe_coef_t * * const ppDeterminant
+                                     , les_linearEquationSystem_t * const pLES
+                                     , const tbv_tableOfVariables_t * const pTabOfVars
+                                     , const boolean * const pIsDependentAvailableAry
+                                     , boolean * const pIsDetNull
+                                     )
+{
+    *pIsDetNull = false;
+
+    unsigned int noKnowns, noUnknowns, noConstants;
+    les_getNoVariables(pLES, &noKnowns, &noUnknowns, &noConstants);
+    const tbv_unknownVariable_t * const unknownAry = les_getTableOfUnknowns(pLES, NULL);
+
+    /* The order of unknowns doesn't matter for this solver. We set up the LES exactly as
+       the first cycle of solveUnknownByUnknown does. This yields the identical sign of the
+       system determinant in both variants of the solver. */
+    unsigned int idxUnknown;
+    for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
+        if(pIsDependentAvailableAry[idxUnknown])
+            break;
+    if(idxUnknown >= noUnknowns)
+    {
+        /* Nothing to compute. The determinant is not figured out either. */
+        return true;
+    }
+    if(!les_setupLES(pLES, unknownAry[idxUnknown].name))
+    {
+        /* The set up fails on a numeric overflow in the values of the numeric devices,
+           which has already been reported. */
+        _isBudgetExceeded = true;
+        return false;
+    }
+
+    /* Find out, which rows of the matrix belong to the required unknowns. The association
+       is made by the column index, which has just been defined by setting up the LES. */
+    boolean isRowRequiredAry[noUnknowns];
+    for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
+    {
+        assert(unknownAry[idxUnknown].idxCol < noUnknowns);
+        isRowRequiredAry[unknownAry[idxUnknown].idxCol] =
+                                                    pIsDependentAvailableAry[idxUnknown];
+    }
+
+    /* A network of passive devices and current sources is solved by enumeration of its
+       spanning trees. The solver figures out from the LES, whether it is applicable. It
+       needs to know, which column belongs to the node of the current balance of a row. */
+    unsigned int idxColOfRowAry[noUnknowns];
+    for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
+    {
+        assert(unknownAry[idxUnknown].idxRow < noUnknowns);
+        idxColOfRowAry[unknownAry[idxUnknown].idxRow] = unknownAry[idxUnknown].idxCol;
+    }
+    boolean isTopological;
+    boolean success = spt_solverLES( &isTopological
+                                   , pIsDetNull
+                                   , pLES->A
+                                   , /* m */ noUnknowns
+                                   , /* n */ noKnowns + noUnknowns
+                                   , idxColOfRowAry
+                                   , isRowRequiredAry
+                                   , _elimStep.maxNoAddendsOfCoef
+                                   , _elimStep.deadline
+                                   );
+    if(isTopological  &&  !success  &&  !*pIsDetNull)
+        _isBudgetExceeded = true;
+
+    /* All other LES: Trivially determined unknowns are substituted before the symbolic
+       elimination. */
+    unsigned int orderAry[noUnknowns];
+    if(!isTopological)
+    {
+        success = solverLESWithPresolve( pLES->A
+                                       , /* m */ noUnknowns
+                                       , /* n */ noKnowns + noUnknowns
+                                       , isRowRequiredAry
+                                       , pIsDetNull
+                                       , orderAry
+                                       );
+    }
+
+    /* Logging can be done even if the solver fails: We could recognize the linear
+       dependent equations in the reported last state of the elimination. */
+    if(!isTopological  &&  log_checkLogLevel(_log, log_debug))
+    {
+        LOG_DEBUG(_log, "Order of elimination of unknowns:")
+        unsigned int elimStep;
+        for(elimStep=0; elimStep<noUnknowns; ++elimStep)
+        {
+            for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
+                if(unknownAry[idxUnknown].idxCol == orderAry[elimStep])
+                    break;
+            assert(idxUnknown < noUnknowns);
+            LOG_DEBUG( _log
+                     , "  Elimination step %u: %s"
+                     , elimStep+1
+                     , unknownAry[idxUnknown].name
+                     )
+        }
+        LOG_DEBUG( _log
+                 , "LES after%s elimination of all unknowns:"
+                 , success? "": " aborted"
+                 )
+        coe_logMatrix( log_debug
+                     , pLES->A
+                     , /* m */ noUnknowns
+                     , /* n */ noKnowns + noUnknowns
+                     , pLES->pTableOfVars
+                     );
+    }
+
+    if(!success)
+        return false;
+
+    /* The ownership of the coefficient that holds the determinant is moved from *pLES to
+       the solution. The coefficient in *pLES is set to the null object in order to inhibit
+       later freeing of the moved coefficient object. */
+    assert(coe_isCoefAddendNull(*ppDeterminant));
+    *ppDeterminant = pLES->A[noUnknowns-1][noUnknowns-1];
+    pLES->A[noUnknowns-1][noUnknowns-1] = coe_coefAddendNull();
+
+    /* Move the terms of the results of all required unknowns into the solution. */
+    for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
+    {
+        if(!pIsDependentAvailableAry[idxUnknown])
+            continue;
+
+        const unsigned int idxRow = unknownAry[idxUnknown].idxCol
+                         , idxUnknownInSol = pTabOfVars->unknownLookUpAry[idxUnknown].idxCol;
+        assert(strcmp( pTabOfVars->unknownLookUpAry[idxUnknown].name
+                     , unknownAry[idxUnknown].name
+                     ) == 0
+              );
+        unsigned int idxKnown;
+        for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+        {
+            /* The LES had been set up with all terms on one side and the condition sum of
+               all is null. This means that the coefficients of the numerators need to be
+               sign inverted in the result. */
+            numeratorAry[idxUnknownInSol][idxKnown] =
+                coe_mulConst(pLES->A[idxRow][noUnknowns+idxKnown], /* constant */ -1);
+            pLES->A[idxRow][noUnknowns+idxKnown] = coe_coefAddendNull();
+        }
+    }
+
+    return true;
+
+} /* End of solveAllUnknownsAtOnce */
+
+
+
+
+/**
+ * Round a size up to the next multiple of the alignment of the sections of a cache file.
+ *   @return
+ * Get the rounded size.
+ *   @param size
+ * The size in Byte.
+ */
+
+static inline size_t alignToCacheFileSection(size_t size)
+{
+    return (size + CACHE_FILE_ALIGNMENT - 1) & ~(size_t)(CACHE_FILE_ALIGNMENT - 1);
+
+} /* End of alignToCacheFileSection */
+
+
+
+
+/**
+ * Get a coefficient of a solution by its index in a cache file.
+ *   @return
+ * Get the coefficient by reference.
+ *   @param pSolution
+ * The solution.
+ *   @param idxCoef
+ * The index of the coefficient. Index null is the determinant, the numerators follow row
+ * by row, i.e. numeratorAry[i][j] has index 1+i*noKnowns+j.
+ */
+
+static const coe_coef_t *getCoefOfCacheFile( const sol_solution_t * const pSolution
+                                           , unsigned int idxCoef
+                                           )
+{
+    if(idxCoef == 0)
+        return pSolution->pDeterminant;
+    else
+    {
+        const unsigned int noKnowns = pSolution->pTableOfVars->noKnowns;
+        -- idxCoef;
+        return pSolution->numeratorAry[idxCoef / noKnowns][idxCoef % noKnowns];
+    }
+} /* End of getCoefOfCacheFile */
+
+
+
+
+/**
+ * Make the contents of a cache file available in memory. The file is mapped into memory
+ * if the system supports this; otherwise it is read into a buffer.
+ *   @return
+ * \a true if the file could be opened and read, \a false otherwise. No error is reported;
+ * a missing cache file is a normal situation.
+ *   @param pImage
+ * The contents of the file are returned in * \a pImage. Release the object with \a
+ * releaseCacheFile after use.
+ *   @param fileName
+ * The name of the cache file.
+ */
+
+static boolean readCacheFile(cacheFileImage_t * const pImage, const char * const fileName)
+{
+    pImage->pData = NULL;
+    pImage->size = 0;
+    pImage->isMapped = false;
+
+#ifdef __unix__
+    const int hFile = open(fileName, O_RDONLY);
+    if(hFile < 0)
+        return false;
+
+    struct stat fileInfo;
+    boolean success = fstat(hFile, &fileInfo) == 0  &&  fileInfo.st_size > 0;
+    if(success)
+    {
+        void * const pData = mmap( /* addr */ NULL
+                                 , (size_t)fileInfo.st_size
+                                 , PROT_READ
+                                 , MAP_PRIVATE
+                                 , hFile
+                                 , /* offset */ 0
+                                 );
+        if(pData != MAP_FAILED)
+        {
+            pImage->pData = pData;
+            pImage->size = (size_t)fileInfo.st_size;
+            pImage->isMapped = true;
+        }
+        else
+            success = false;
+    }
+
+    /* The mapping remains valid after the file is closed. */
+    close(hFile);
+    return success;
+#else
+    FILE * const hFile = fopen(fileName, "rb");
+    if(hFile == NULL)
+        return false;
+
+    boolean success = fseek(hFile, 0, SEEK_END) == 0;
+    long size = success? ftell(hFile): -1;
+    if(size <= 0  ||  fseek(hFile, 0, SEEK_SET) != 0)
+        success = false;
+    if(success)
+    {
+        void * const pData = smalloc((size_t)size, __FILE__, __LINE__);
+        if(fread(pData, /* size */ 1, (size_t)size, hFile) == (size_t)size)
+        {
+            pImage->pData = pData;
+            pImage->size = (size_t)size;
+        }
+        else
+        {
+            free(pData);
+            success = false;
+        }
+    }
+
+    fclose(hFile);
+    return success;
+#endif
+} /* End of readCacheFile */
+
+
+
+
+/**
+ * Release the contents of a cache file after use.
+ *   @param pImage
+ * The contents of the file as got from readCacheFile.
+ */
+
+static void releaseCacheFile(cacheFileImage_t * const pImage)
+{
+    if(pImage->pData != NULL)
+    {
+#ifdef __unix__
+        if(pImage->isMapped)
+            munmap((void*)pImage->pData, pImage->size);
+        else
+#endif
+            free((void*)pImage->pData);
+    }
+    pImage->pData = NULL;
+    pImage->size = 0;
+
+} /* End of releaseCacheFile */
+
+
+
+
 
 /**
  * Initialize the module at application startup.
@@ -675,16 +3538,90 @@ static boolean solverLES( coe_coefMatrix_t A
  *   @remark
  * This module depends on the other module log_logger. It needs to be initialized after
  * this other module.
+ *   @remark
+ * This module depends on the other module coe_coefficient. It needs to be initialized
+ * after this other module.
  *   @remark Using this function is not an option but a must. You need to call it
  * prior to any other call of this module and prior to accessing any of its global data
  * objects.
+ *   @param noThreads
+ * The number of threads, which carry out the elimination steps of the solver, in the range
+ * 1..#THP_MAX_NO_THREADS. The main thread counts as one of them. The results don't depend
+ * on the number of threads.
+ *   @param pBudget
+ * The limits of the resources, which the solution of a single LES may consume. The
+ * solution of a circuit, which exceeds any of the limits, is aborted with an error and
+ * the next circuit can be processed. The budget is copied.
  *   @see void sol_shutdownModule()
  */
 
-void sol_initModule(log_hLogger_t hLogger)
+void sol_initModule( log_hLogger_t hLogger
+                   , unsigned int noThreads
+                   , const sol_resourceBudget_t * const pBudget
+                   )
 {
     assert(hLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
     _log = log_cloneByReference(hLogger);
+    _budget = *pBudget;
+    _isBudgetExceeded = false;
+
+    /* Create the working data, which is reused in all elimination steps. */
+    coe_initPackedCoef(&_elimStep.pivot);
+    coe_initPackedCoef(&_elimStep.divisor);
+    _elimStep.idxRowAry = NULL;
+    _elimStep.maxNoRows = 0;
+    _elimStep.patternAry = NULL;
+    _elimStep.noWordsOfPattern = 0;
+    _elimStep.maxNoWordsOfPatternAry = 0;
+    _elimStep.taskAry = NULL;
+    _elimStep.noTasks = 0;
+    _elimStep.maxNoTasks = 0;
+    _elimStep.memoizedStepAry = NULL;
+    _elimStep.noMemoizedSteps = 0;
+    _elimStep.memoTableAry = NULL;
+    _elimStep.maxNoSlotsOfMemoTable = 0;
+    _elimStep.hashOfColAry = NULL;
+    _elimStep.maxNoHashesOfCols = 0;
+    _elimStep.maxNoAddendsOfCoef = _budget.maxNoAddendsOfCoef > 0
+                                   ? _budget.maxNoAddendsOfCoef
+                                   : UINT_MAX;
+    _elimStep.deadline = 0;
+
+    /* Create the working data of all threads. The worker threads get their own heaps of
+       coefficients. The heaps are created on demand as they depend on the circuit. */
+    assert(noThreads >= 1  &&  noThreads <= THP_MAX_NO_THREADS  &&  _workspaceAry == NULL);
+    _workspaceAry = smalloc(noThreads*sizeof(workspace_t), __FILE__, __LINE__);
+    unsigned int idxThread;
+    for(idxThread=0; idxThread<noThreads; ++idxThread)
+    {
+        workspace_t * const pWorkspace = &_workspaceAry[idxThread];
+        pWorkspace->pAccumulator = coe_createAccumulator();
+        coe_initPackedCoef(&pWorkspace->rowHead);
+        pWorkspace->idxRowOfRowHead = UINT_MAX;
+        coe_initPackedCoef(&pWorkspace->products);
+        unsigned int idxHeap;
+        for(idxHeap=0; idxHeap<COE_MAX_NO_WORDS_OF_PRODUCT; ++idxHeap)
+            pWorkspace->hHeapOfCoefAddendAry[idxHeap] = MEM_HANDLE_INVALID_HEAP;
+    }
+    _noThreads = noThreads;
+
+    _hThreadPool = thp_createThreadPool( _log
+                                       , noThreads
+                                       , /* fctStartThread */ NULL
+                                       , /* fctStopThread */ NULL
+                                       , /* pContext */ NULL
+                                       );
+
+    /* The pool may have less threads than requested. The working data of the other
+       threads is returned immediately. */
+    while(_noThreads > thp_getNoThreads(_hThreadPool))
+    {
+        workspace_t * const pWorkspace = &_workspaceAry[--_noThreads];
+        coe_deleteAccumulator(pWorkspace->pAccumulator);
+        coe_freePackedCoef(&pWorkspace->rowHead);
+        coe_freePackedCoef(&pWorkspace->products);
+    }
+    LOG_DEBUG(_log, "The solver uses %u threads", _noThreads)
 
 #ifdef  DEBUG
     /* The DEBUG compilation counts all references to all created objects. */
@@ -716,6 +3653,49 @@ void sol_shutdownModule()
     }
 #endif
 
+    /* Terminate the worker threads. Afterwards, their heaps of coefficients can be
+       returned to module coe_coefficient. Coefficients, which had been allocated by the
+       worker threads, stay valid. */
+    thp_deleteThreadPool(_hThreadPool);
+    _hThreadPool = THP_HANDLE_INVALID_THREAD_POOL;
+    unsigned int idxThread;
+    for(idxThread=0; idxThread<_noThreads; ++idxThread)
+    {
+        workspace_t * const pWorkspace = &_workspaceAry[idxThread];
+        coe_deleteAccumulator(pWorkspace->pAccumulator);
+        coe_freePackedCoef(&pWorkspace->rowHead);
+        coe_freePackedCoef(&pWorkspace->products);
+        unsigned int idxHeap;
+        for(idxHeap=0; idxHeap<COE_MAX_NO_WORDS_OF_PRODUCT; ++idxHeap)
+        {
+            if(pWorkspace->hHeapOfCoefAddendAry[idxHeap] != MEM_HANDLE_INVALID_HEAP)
+                coe_deleteHeapForThread(pWorkspace->hHeapOfCoefAddendAry[idxHeap]);
+        }
+    }
+    free(_workspaceAry);
+    _workspaceAry = NULL;
+    _noThreads = 0;
+
+    coe_freePackedCoef(&_elimStep.pivot);
+    coe_freePackedCoef(&_elimStep.divisor);
+    free(_elimStep.idxRowAry);
+    _elimStep.idxRowAry = NULL;
+    _elimStep.maxNoRows = 0;
+    free(_elimStep.patternAry);
+    _elimStep.patternAry = NULL;
+    _elimStep.maxNoWordsOfPatternAry = 0;
+    free(_elimStep.taskAry);
+    _elimStep.taskAry = NULL;
+    _elimStep.maxNoTasks = 0;
+    free(_elimStep.memoizedStepAry);
+    _elimStep.memoizedStepAry = NULL;
+    free(_elimStep.memoTableAry);
+    _elimStep.memoTableAry = NULL;
+    _elimStep.maxNoSlotsOfMemoTable = 0;
+    free(_elimStep.hashOfColAry);
+    _elimStep.hashOfColAry = NULL;
+    _elimStep.maxNoHashesOfCols = 0;
+
     /* Discard reference to the logger object. */
     log_deleteLogger(_log);
 
@@ -724,6 +3704,104 @@ void sol_shutdownModule()
 
 
 
+/**
+ * The user-defined voltages of a solution are computed from the solutions of the unknowns.
+ * These voltages are differences of node voltages. Only the voltages are computed, which
+ * are required by the user-defined results.
+ *   @param pSol
+ * The solution object under construction. The numerators of all required unknowns need
+ * to be available. The numerators of the required voltages are set.
+ */
+
+static void computeUserDefVoltages(sol_solution_t * const pSol)
+{
+    const tbv_tableOfVariables_t * const pTabOfVars = pSol->pTableOfVars;
+    const unsigned int noKnowns = pTabOfVars->noKnowns
+                     , noUnknowns = pTabOfVars->noUnknowns
+                     , noUserDefVoltages = pTabOfVars->pCircuitNetList->noVoltageDefs;
+
+    /* The additional results are user defined voltages. These voltages are differences of
+       node voltages, which can easily be the same as an already found unknown. The
+       difference of any pair of node voltages is defined in the same arithmetic space as
+       the unknowns so far, so we can compute and store the additional results just like
+       that. In particular, the denominator is the same and doesn't need any attention. */
+    unsigned int idxSolution, idxUserDefVoltage;
+    for( idxUserDefVoltage = 0, idxSolution = noUnknowns
+       ; idxUserDefVoltage < noUserDefVoltages
+       ; ++idxUserDefVoltage, ++idxSolution
+       )
+    {
+        const pci_voltageDef_t * const pVoltageDef =
+                        &pTabOfVars->pCircuitNetList->voltageDefAry[idxUserDefVoltage];
+
+        if(!pSol->pIsDependentAvailableAry[idxSolution])
+        {
+            LOG_INFO( _log
+                    , "User defined voltage %s (%u) is not required for the final result(s)"
+                      " and hence not computed. Its value is set to null"
+                    , pVoltageDef->name
+                    , idxUserDefVoltage
+                    )
+            continue;
+        }
+        
+        /* Find the index of the already stored solutions of those nodes' voltages, which
+           are defined to be plus and minus pole of the voltage of interest. Both of them
+           can be the ground node, in which case no solution is stored. This is indicated
+           by index UINT_MAX. */
+        const tbv_unknownVariable_t *pUnknown = tbv_getUnknownByNode
+                                                 ( pTabOfVars
+                                                 , /* idxNode */ pVoltageDef->idxNodePlus
+                                                 );
+        const unsigned int idxUnknownPlus = pUnknown != NULL? pUnknown->idxCol: UINT_MAX;
+
+        pUnknown = tbv_getUnknownByNode( pTabOfVars
+                                       , /* idxNode */ pVoltageDef->idxNodeMinus
+                                       );
+        const unsigned int idxUnknownMinus = pUnknown != NULL? pUnknown->idxCol: UINT_MAX;
+
+        /* Compute the voltage as difference of the numerators of all known-related terms. */
+        unsigned int idxKnown;
+        for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+        {
+            assert(pSol->pIsDependentAvailableAry[idxSolution]);
+            
+            /* The positive node potential is brought into the new result by deep copy. */
+            if(idxUnknownPlus != UINT_MAX)
+            {
+                assert(pSol->pIsDependentAvailableAry[idxUnknownPlus]);
+                pSol->numeratorAry[idxSolution][idxKnown] =
+                            coe_cloneByDeepCopy(pSol->numeratorAry[idxUnknownPlus][idxKnown]);
+            }
+            else
+            {
+                /* Plus pole of user voltage is ground, i.e. we set the first operand of
+                   the difference to null. */
+                pSol->numeratorAry[idxSolution][idxKnown] = coe_coefAddendNull();
+            }
+
+            /* The negative node potential is subtracted in place. */
+            if(idxUnknownMinus != UINT_MAX)
+            {
+                assert(pSol->pIsDependentAvailableAry[idxUnknownMinus]);
+                pSol->numeratorAry[idxSolution][idxKnown] =
+                                    coe_diff( pSol->numeratorAry[idxSolution][idxKnown]
+                                            , pSol->numeratorAry[idxUnknownMinus][idxKnown]
+                                            );
+            }
+            else
+            {
+                /* Minus pole of user voltage is ground, we have to subtract null, which
+                   means doing nothing. */
+            }
+        }
+    } /* End for(All user defined voltages are computed as node differential potentials) */
+
+} /* End of computeUserDefVoltages */
+
+
+
+
 /**
  * The complete solution of a LES is figured out and returned as a new object.
  *   @return
@@ -783,19 +3861,12 @@ boolean sol_createSolution( const sol_solution_t * * const ppSolution
        request only a sub-set of all unknown quantities for plotting or printing. */
     pSol->pIsDependentAvailableAry = getVectorOfReqDependents(pSol);
     
-    /* The core solver can bring the LES only in the shape of an upper triangular matrix,
-       i.e. only the solution of a single unknown is entirely figured out. This unknown is
-       the last one in the order of columns. The function here overcomes this limitation by
-       running the core solver once per unknown. Prior to calling the core solver it
-       reorders the unknowns so that each of them is found once as last one.
-         We need a loop over all unknowns. */
+    /* The core solver brings the LES into diagonal shape in a single run and all solutions
+       are figured out at once. This fails for a null system determinant; in this case, we
+       use the original solver, which can still provide the (meaningless) numerators. */
     const tbv_unknownVariable_t * const unknownAry = les_getTableOfUnknowns(pLES, NULL);
-
-    boolean success = true
-          , storeDet = true
-          , isSignOfDetInv = true;
     unsigned int idxUnknown;
-    for(idxUnknown=0; success && idxUnknown<noUnknowns; ++idxUnknown)
+    for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
     {
         if(!pSol->pIsDependentAvailableAry[idxUnknown])
         {
@@ -805,212 +3876,225 @@ boolean sol_createSolution( const sol_solution_t * * const ppSolution
                     , unknownAry[idxUnknown].name
                     , idxUnknown
                     )
-            continue;
         }
-        
-        const char * const nameOfUnknown = unknownAry[idxUnknown].name;
+    }
 
-        /* Setup the matrix of coefficients so that the coefficients in column m relate the
-           the unknown of interest.
-             Sign of determinante: Basically, each call of the solver of the LES will
-           (re-)produce the same value of the system determinante. Only the sign will be
-           toggled each time because each time we setup the LES we exchange one pair of
-           columns. We need to keep track of the sign inversion in order to become able to
-           store the determinante only once for all dependents. */
-        success = les_setupLES(pLES, nameOfUnknown);
-        isSignOfDetInv = !isSignOfDetInv;
+    /* The clock of the budget of wall-clock time is started. */
+    _isBudgetExceeded = false;
+    _elimStep.deadline = _budget.maxWallTime > 0? time(NULL) + _budget.maxWallTime: 0;
+
+    boolean isDetNull;
+    boolean success = solveAllUnknownsAtOnce( pSol->numeratorAry
+                                            , &pSol->pDeterminant
+                                            , pLES
+                                            , pTabOfVars
+                                            , pSol->pIsDependentAvailableAry
+                                            , &isDetNull
+                                            );
+    if(!success  &&  isDetNull)
+    {
+        LOG_DEBUG( _log
+                 , "The system determinant is null. The LES is solved again unknown by"
+                   " unknown"
+                 )
+        success = solveUnknownByUnknown( pSol->numeratorAry
+                                       , &pSol->pDeterminant
+                                       , pLES
+                                       , pTabOfVars
+                                       , pSol->pIsDependentAvailableAry
+                                       );
+    }
+#ifdef DEBUG
+    else if(success &&  pLES->noNumericConstants == 0)
+    {
+        /* Validate the results of the single run solver by comparison with the original
+           solver, which runs once per unknown. The original solver doesn't presolve the
+           LES. With devices of numeric value, it can overflow the numeric factors where
+           the other solver doesn't and it would report an error for a valid result; the
+           cross-check is skipped for such an LES. */
+        coe_coefMatrix_t numeratorAry = coe_createMatrix(noUnknowns, noKnowns);
+        coe_coef_t *pDeterminant = coe_coefAddendNull();
+        const boolean successCrossCheck = solveUnknownByUnknown
+                                                    ( numeratorAry
+                                                    , &pDeterminant
+                                                    , pLES
+                                                    , pTabOfVars
+                                                    , pSol->pIsDependentAvailableAry
+                                                    );
 
-        /* Run the symbolic solver, which makes an upper triangular matrix from the LES. It
-           fails if the system determinant is null. */
-        if(success)
+        assert(successCrossCheck  ||  _isBudgetExceeded);
+        if(successCrossCheck)
         {
-            success = solverLES( pLES->A, /* m */ noUnknowns, /* n */ noKnowns + noUnknowns);
-
-            /* Logging can be done even if the solver fails: We could recognize the linear
-               dependent equations in the reported last state of the elimination. */
-            if(log_checkLogLevel(_log, log_debug))
+            pDeterminant = coe_diff(pDeterminant, pSol->pDeterminant);
+            assert(coe_isCoefAddendNull(pDeterminant));
+            for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
             {
-                LOG_DEBUG( _log
-                         , "LES after%s elimination of %s:"
-                         , success? "": " aborted"
-                         , nameOfUnknown
-                         )
-                coe_logMatrix( log_debug
-                             , pLES->A
-                             , /* m */ noUnknowns
-                             , /* n */ noKnowns + noUnknowns
-                             , pLES->pTableOfVars
-                             );
+                unsigned int idxKnown;
+                for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+                {
+                    numeratorAry[idxUnknown][idxKnown] =
+                                        coe_diff( numeratorAry[idxUnknown][idxKnown]
+                                                , pSol->numeratorAry[idxUnknown][idxKnown]
+                                                );
+                    assert(coe_isCoefAddendNull(numeratorAry[idxUnknown][idxKnown]));
+                }
             }
         }
+        _isBudgetExceeded = false;
+        coe_freeCoef(pDeterminant);
+        coe_deleteMatrix(numeratorAry, noUnknowns, noKnowns);
+    }
+#endif
 
-        if(!success)
-        {
-            LOG_ERROR( _log
-                     , "The LES could not be solved. The circuit has an undefined behavior."
-                       " Most probable, you have an invalid interconnection of sources,"
-                       " current probes and/or op-amps in your circuit"
-                     )
-        }
+    if(!success  &&  !_isBudgetExceeded)
+    {
+        LOG_ERROR( _log
+                 , "The LES could not be solved. The circuit has an undefined behavior."
+                   " Most probable, you have an invalid interconnection of sources,"
+                   " current probes and/or op-amps in your circuit"
+                 )
+    }
 
-        /* Don't do further result evaluation and storage if there's no solution. */
-        if(!success)
-            break;
 
-        /* The system determinant is the denominator of all result terms. It is stored only
-           in the first cycle. (The debug compilation validates identity in subsequent
-           runs.) */
-        if(storeDet)
-        {
-            /* The ownership of the coefficient that holds the determinant is moved from
-               *pLES to the newly created solution object. The coefficient in *pLES is set
-               to the null object in order to inhibit later freeing of the moved
-               coefficient object. */
-            assert(coe_isCoefAddendNull(pSol->pDeterminant));
-            pSol->pDeterminant = pLES->A[noUnknowns-1][noUnknowns-1];
-            pLES->A[noUnknowns-1][noUnknowns-1] = coe_coefAddendNull();
-            storeDet = false;
-        }
-        else
-        {
-#ifdef DEBUG
-            /* Validate identity of the system determinant in each repeated solution of the
-               LES.
-                 Caution: The validation changes the coefficient matrix pLES->A in
-               comparison to the PRODUCTION compilation. */
+    /* The additional results are user defined voltages. */
+    if(success)
+        computeUserDefVoltages(pSol);
+
+    if(!success)
+    {
+        sol_deleteSolution(pSol);
+        pSol = NULL;
+    }
+
+    /* Return the new, completed object (or NULL). */
+    *ppSolution = pSol;
+    return success;
 
-            /* We have to consider that in each loop one pair of columns of the LES is
-               swapped, this leads to a sign inversion of the determinant. Here, we
-               compensate for this. */
-            if(isSignOfDetInv)
-                coe_mulConst(pLES->A[noUnknowns-1][noUnknowns-1], /* constant */ -1);
+} /* End of sol_createSolution */
 
-            pLES->A[noUnknowns-1][noUnknowns-1] = coe_diff( pLES->A[noUnknowns-1][noUnknowns-1]
-                                                          , pSol->pDeterminant
-                                                          );
-            assert(coe_isCoefAddendNull(pLES->A[noUnknowns-1][noUnknowns-1]));
-#endif
-        } /* End if(The very first unknown or any other one?) */
 
-        /* Store the terms of the result of this unknown in the solution object. One such
-           term exists for each known.
-             The ownership of the coefficients that hold the terms is moved from *pLES to
-           the newly created solution object. The coefficients in *pLES are set to null
-           objects in order to inhibit later freeing of the moved coefficient objects. */
-        unsigned int idxKnown;
-        const unsigned int idxUnknownInSol = pTabOfVars->unknownLookUpAry[idxUnknown].idxCol;
-        assert(strcmp(pTabOfVars->unknownLookUpAry[idxUnknown].name, nameOfUnknown) == 0);
-        for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
-        {
-            pSol->numeratorAry[idxUnknownInSol][idxKnown] =
-                                                    pLES->A[noUnknowns-1][noUnknowns+idxKnown];
-            pLES->A[noUnknowns-1][noUnknowns+idxKnown] = coe_coefAddendNull();
 
-            /* The LES had been set up with all terms on one side and the condition sum of
-               all is null. This means that the coefficients of the numerators need to be
-               sign inverted in the result.
-                 We have to consider also that in each loop one pair of columns of the LES is
-               swapped, which leads to a sign inversion of the determinant. We have stored
-               the determinant of the first loop as common denominator, so need to do a
-               sign inversion in every other cycle.
-                 Putting both together we need to do the inversion in the first and then in
-               every second cyle. */
-            if(!isSignOfDetInv)
-                coe_mulConst(pSol->numeratorAry[idxUnknownInSol][idxKnown], /* constant */ -1);
-        }
-        
-    } /* End for(All required unknowns of the LES) */
 
-    assert(!success || !storeDet);
+/**
+ * The solution of a LES is derived from the solution of another circuit with the same
+ * network, which had been computed before. This is an alternative to the computation of
+ * the solution with sol_createSolution if only the result definitions, the user-defined
+ * voltages, the plot information or the device values of a circuit have been changed.
+ * The numerators of the unknowns and the determinant are copied; only the user-defined
+ * voltages are computed. No elimination is done.\n
+ *   The solution can be derived only if the previous solution provides all unknowns, which
+ * are required by the user-defined results of the new circuit.
+ *   @return
+ * \a true if the solution could be derived. If the previous solution lacks a required
+ * unknown then the function returns \a false; this is no error and the solution needs to
+ * be computed. The reason is written to the application log on level INFO.
+ *   @param ppSolution
+ * The pointer to the new object is returned in * \a ppSolution. The object is the same
+ * as got from sol_createSolution and it is deleted with sol_deleteSolution. * \a
+ * ppSolution is NULL if the function returns \a false.
+ *   @param pLES
+ * The LES, which the solution belongs to, as got from les_createLES. Its table of
+ * variables is used for the solution object; the LES is not solved.
+ *   @param pPrevSolution
+ * The solution of the previous circuit. The caller needs to ensure that the networks of
+ * both circuits are identical, see pci_getHashOfNetwork. The object is not altered.
+ */
 
-    /* The additional results are user defined voltages. These voltages are differences of
-       node voltages, which can easily be the same as an already found unknown. The
-       difference of any pair of node voltages is defined in the same arithmetic space as
-       the unknowns so far, so we can compute and store the additional results just like
-       that. In particular, the denominator is the same and doesn't need any attention. */
-    unsigned int idxSolution, idxUserDefVoltage;
-    for( idxUserDefVoltage = 0, idxSolution = noUnknowns
-       ; success &&  idxUserDefVoltage < noUserDefVoltages
-       ; ++idxUserDefVoltage, ++idxSolution
-       )
-    {
-        const pci_voltageDef_t * const pVoltageDef =
-                        &pTabOfVars->pCircuitNetList->voltageDefAry[idxUserDefVoltage];
+boolean sol_createSolutionFromPrevious( const sol_solution_t * * const ppSolution
+                                      , les_linearEquationSystem_t * const pLES
+                                      , const sol_solution_t * const pPrevSolution
+                                      )
+{
+    unsigned int noKnowns, noUnknowns, noConstants;
+    les_getNoVariables(pLES, &noKnowns, &noUnknowns, &noConstants);
 
-        if(!pSol->pIsDependentAvailableAry[idxSolution])
+#ifdef DEBUG
+    /* Identical networks have tables of variables of same dimensions. */
+    const tbv_tableOfVariables_t * const pPrevTabOfVars = pPrevSolution->pTableOfVars;
+    assert(pPrevTabOfVars->noKnowns == noKnowns
+           &&  pPrevTabOfVars->noUnknowns == noUnknowns
+           &&  pPrevTabOfVars->noConstants == noConstants
+          );
+#endif
+
+    const unsigned int noDependents = noUnknowns
+                                      + pLES->pTableOfVars->pCircuitNetList->noVoltageDefs;
+
+    /* Create the solution object as the solver does. */
+    sol_solution_t *pSol = smalloc(sizeof(sol_solution_t), __FILE__, __LINE__);
+    pSol->noReferencesToThis = 1;
+#ifdef DEBUG
+    ++ _noRefsToObjects;
+#endif
+    pSol->pTableOfVars = tbv_cloneByShallowCopy(pLES->pTableOfVars);
+    pSol->numeratorAry = coe_createMatrix(noDependents, noKnowns);
+    pSol->pDeterminant = coe_coefAddendNull();
+    pSol->pIsDependentAvailableAry = getVectorOfReqDependents(pSol);
+
+    /* All unknowns, which are required now, need to have been computed before. */
+    const tbv_unknownVariable_t * const unknownAry = les_getTableOfUnknowns(pLES, NULL);
+    boolean success = true;
+    unsigned int idxUnknown;
+    for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
+    {
+        if(pSol->pIsDependentAvailableAry[idxUnknown]
+           &&  !pPrevSolution->pIsDependentAvailableAry[idxUnknown]
+          )
         {
             LOG_INFO( _log
-                    , "User defined voltage %s (%u) is not required for the final result(s)"
-                      " and hence not computed. Its value is set to null"
-                    , pVoltageDef->name
-                    , idxUserDefVoltage
+                    , "Unknown %s (%u) is required for the result(s) but it is not"
+                      " available from the previous solution. The LES needs to be solved"
+                      " again"
+                    , unknownAry[idxUnknown].name
+                    , idxUnknown
                     )
-            continue;
+            success = false;
+            break;
         }
-        
-        /* Find the index of the already stored solutions of those nodes' voltages, which
-           are defined to be plus and minus pole of the voltage of interest. Both of them
-           can be the ground node, in which case no solution is stored. This is indicated
-           by index UINT_MAX. */
-        const tbv_unknownVariable_t *pUnknown = tbv_getUnknownByNode
-                                                 ( pTabOfVars
-                                                 , /* idxNode */ pVoltageDef->idxNodePlus
-                                                 );
-        const unsigned int idxUnknownPlus = pUnknown != NULL? pUnknown->idxCol: UINT_MAX;
-
-        pUnknown = tbv_getUnknownByNode( pTabOfVars
-                                       , /* idxNode */ pVoltageDef->idxNodeMinus
-                                       );
-        const unsigned int idxUnknownMinus = pUnknown != NULL? pUnknown->idxCol: UINT_MAX;
+    }
 
-        /* Compute the voltage as difference of the numerators of all known-related terms. */
-        unsigned int idxKnown;
-        for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+    /* Copy the determinant and the numerators of all required unknowns. The solution of
+       the unknowns is independent of the result definitions. */
+    if(success)
+    {
+        pSol->pDeterminant = coe_cloneByDeepCopy(pPrevSolution->pDeterminant);
+        for(idxUnknown=0; idxUnknown<noUnknowns; ++idxUnknown)
         {
-            assert(pSol->pIsDependentAvailableAry[idxSolution]);
-            
-            /* The positive node potential is brought into the new result by deep copy. */
-            if(idxUnknownPlus != UINT_MAX)
-            {
-                assert(pSol->pIsDependentAvailableAry[idxUnknownPlus]);
-                pSol->numeratorAry[idxSolution][idxKnown] =
-                            coe_cloneByDeepCopy(pSol->numeratorAry[idxUnknownPlus][idxKnown]);
-            }
-            else
-            {
-                /* Plus pole of user voltage is ground, i.e. we set the first operand of
-                   the difference to null. */
-                pSol->numeratorAry[idxSolution][idxKnown] = coe_coefAddendNull();
-            }
-
-            /* The negative node potential is subtracted in place. */
-            if(idxUnknownMinus != UINT_MAX)
+            if(pSol->pIsDependentAvailableAry[idxUnknown])
             {
-                assert(pSol->pIsDependentAvailableAry[idxUnknownMinus]);
-                pSol->numeratorAry[idxSolution][idxKnown] =
-                                    coe_diff( pSol->numeratorAry[idxSolution][idxKnown]
-                                            , pSol->numeratorAry[idxUnknownMinus][idxKnown]
-                                            );
+                unsigned int idxKnown;
+                for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+                {
+                    const coe_coef_t * const pPrevNumerator =
+                                        pPrevSolution->numeratorAry[idxUnknown][idxKnown];
+                    pSol->numeratorAry[idxUnknown][idxKnown] =
+                                                    coe_cloneByDeepCopy(pPrevNumerator);
+                }
             }
             else
             {
-                /* Minus pole of user voltage is ground, we have to subtract null, which
-                   means doing nothing. */
+                LOG_INFO( _log
+                        , "Unknown %s (%u) is not required for the final result(s) and"
+                          " hence not computed. Its value is set to null"
+                        , unknownAry[idxUnknown].name
+                        , idxUnknown
+                        )
             }
         }
-    } /* End for(All user defined voltages are computed as node differential potentials) */
 
-    if(!success)
+        computeUserDefVoltages(pSol);
+        LOG_INFO(_log, "The solution of the LES is reused from the previous circuit")
+    }
+    else
     {
         sol_deleteSolution(pSol);
         pSol = NULL;
     }
 
-    /* Return the new, completed object (or NULL). */
     *ppSolution = pSol;
     return success;
 
-} /* End of sol_createSolution */
+} /* End of sol_createSolutionFromPrevious */
 
 
 
@@ -1123,6 +4207,371 @@ void sol_deleteSolution(const sol_solution_t * const pConstSolution)
 
 
 
+/**
+ * Store a solution in a cache file. A later run of the application can load the solution
+ * with sol_loadSolution instead of computing it again, if it processes the same circuit.\n
+ *   The file is first written under a temporary name and then renamed. A concurrent
+ * reader will never see an incomplete file.
+ *   @return
+ * \a true if the file could be written, \a false otherwise. A warning is written to the
+ * application log in the latter case; the solution itself is not affected by a failure.
+ *   @param pSolution
+ * The solution to store.
+ *   @param hashOfCircuit
+ * The hash code of the circuit the solution belongs to, see pci_getHashOfCircuit. It is
+ * stored in the file and validated on load.
+ *   @param fileName
+ * The name of the cache file. An existing file is overwritten.
+ *   @see boolean sol_loadSolution(const sol_solution_t ** const,
+ * les_linearEquationSystem_t * const, unsigned long long, const char * const)
+ */
+
+boolean sol_storeSolution( const sol_solution_t * const pSolution
+                         , unsigned long long hashOfCircuit
+                         , const char * const fileName
+                         )
+{
+    const tbv_tableOfVariables_t * const pTabOfVars = pSolution->pTableOfVars;
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    cacheFileHeader_t header =
+        { .magic = CACHE_FILE_MAGIC
+        , .version = CACHE_FILE_VERSION
+        , .sizeOfProductWord = sizeof(coe_productOfConstWord_t)
+        , .sizeOfNumericFactor = sizeof(coe_numericFactor_t)
+        , .hashOfCircuit = hashOfCircuit
+        , .noUnknowns = pTabOfVars->noUnknowns
+        , .noKnowns = pTabOfVars->noKnowns
+        , .noDependents = pTabOfVars->noUnknowns
+                          + pTabOfVars->pCircuitNetList->noVoltageDefs
+        , .noConstants = pTabOfVars->noConstants
+        , .noWordsOfProduct = noWords
+        , .noAddends = 0
+        };
+    header.noCoefs = 1 + header.noDependents*header.noKnowns;
+
+    /* Count the addends of all coefficients and the start index of each of them. */
+    unsigned long long idxFirstAddendAry[header.noCoefs+1];
+    unsigned int idxCoef;
+    for(idxCoef=0; idxCoef<header.noCoefs; ++idxCoef)
+    {
+        idxFirstAddendAry[idxCoef] = header.noAddends;
+        const coe_coef_t *pAddend = getCoefOfCacheFile(pSolution, idxCoef);
+        while(!coe_isCoefAddendNull(pAddend))
+        {
+            ++ header.noAddends;
+            pAddend = pAddend->pNext;
+        }
+    }
+    idxFirstAddendAry[header.noCoefs] = header.noAddends;
+
+    /* The file is written under a temporary name, which is unique among all processes and
+       among all parallel jobs of this process. */
+    char tmpFileName[strlen(fileName) + 64];
+    snprintf( tmpFileName
+            , sizeof(tmpFileName)
+            , "%s.%lu-%p.tmp"
+            , fileName
+            , (unsigned long)getpid()
+            , (const void*)pSolution
+            );
+    FILE * const hFile = fopen(tmpFileName, "wb");
+    if(hFile == NULL)
+    {
+        LOG_WARN(_log, "Can't open cache file %s for writing", tmpFileName)
+        return false;
+    }
+
+    /* The padding bytes of the sections. */
+    static const unsigned char padding[CACHE_FILE_ALIGNMENT] = {0};
+
+    boolean success = fwrite(&header, sizeof(header), 1, hFile) == 1;
+
+    const size_t sizeOfAvailability = alignToCacheFileSection(header.noDependents);
+    unsigned int idxDependent;
+    for(idxDependent=0; success && idxDependent<header.noDependents; ++idxDependent)
+    {
+        if(fputc(pSolution->pIsDependentAvailableAry[idxDependent]? 1: 0, hFile) == EOF)
+            success = false;
+    }
+    if(success)
+    {
+        const size_t noPaddingBytes = sizeOfAvailability - header.noDependents;
+        success = fwrite(padding, 1, noPaddingBytes, hFile) == noPaddingBytes;
+    }
+
+    if(success)
+    {
+        success = fwrite( idxFirstAddendAry
+                        , sizeof(idxFirstAddendAry[0])
+                        , header.noCoefs+1
+                        , hFile
+                        )
+                  == header.noCoefs+1;
+    }
+
+    for(idxCoef=0; success && idxCoef<header.noCoefs; ++idxCoef)
+    {
+        const coe_coef_t *pAddend = getCoefOfCacheFile(pSolution, idxCoef);
+        while(success && !coe_isCoefAddendNull(pAddend))
+        {
+            success = fwrite(&pAddend->factor, sizeof(pAddend->factor), 1, hFile) == 1;
+            pAddend = pAddend->pNext;
+        }
+    }
+    if(success)
+    {
+        const size_t sizeOfFactors = header.noAddends * sizeof(coe_numericFactor_t)
+                   , noPaddingBytes = alignToCacheFileSection(sizeOfFactors) - sizeOfFactors;
+        success = fwrite(padding, 1, noPaddingBytes, hFile) == noPaddingBytes;
+    }
+
+    for(idxCoef=0; success && idxCoef<header.noCoefs; ++idxCoef)
+    {
+        const coe_coef_t *pAddend = getCoefOfCacheFile(pSolution, idxCoef);
+        while(success && !coe_isCoefAddendNull(pAddend))
+        {
+            success = fwrite( pAddend->productOfConst
+                            , sizeof(coe_productOfConstWord_t)
+                            , noWords
+                            , hFile
+                            )
+                      == noWords;
+            pAddend = pAddend->pNext;
+        }
+    }
+
+    if(fclose(hFile) != 0)
+        success = false;
+
+    /* Replace an existing file with the new one. Some systems don't permit to rename a
+       file to the name of an existing one. */
+    if(success  &&  rename(tmpFileName, fileName) != 0)
+    {
+        remove(fileName);
+        success = rename(tmpFileName, fileName) == 0;
+    }
+
+    if(success)
+    {
+        /* Portable code: GCC on MinGW doesn't support the printf formatting character %llu
+           but requires %I64u. */
+#if defined(__WIN32) || defined(__WIN64)
+# define F64U    "%I64u"
+#else
+# define F64U    "%llu"
+#endif
+        LOG_DEBUG( _log
+                 , "Solution with %u coefficients and " F64U " addends stored in cache"
+                   " file %s"
+                 , header.noCoefs
+                 , header.noAddends
+                 , fileName
+                 )
+#undef F64U
+    }
+    else
+    {
+        remove(tmpFileName);
+        LOG_WARN(_log, "Can't write cache file %s", fileName)
+    }
+
+    return success;
+
+} /* End of sol_storeSolution */
+
+
+
+
+/**
+ * Load the solution of a LES from a cache file, which had been written by
+ * sol_storeSolution. This is an alternative to the computation of the solution with
+ * sol_createSolution.\n
+ *   The solution is accepted only if the file belongs to the same circuit and if it
+ * provides the same set of dependents, which the user-defined results of the circuit
+ * require.
+ *   @return
+ * \a true if the solution could be loaded. If the file doesn't exist or doesn't fit to
+ * the circuit then the function returns \a false; this is no error and the solution needs
+ * to be computed. The reason is written to the application log on level INFO or DEBUG.
+ *   @param ppSolution
+ * The pointer to the new object is returned in * \a ppSolution. The object is the same
+ * as got from sol_createSolution and it is deleted with sol_deleteSolution. * \a
+ * ppSolution is NULL if the function returns \a false.
+ *   @param pLES
+ * The LES, which the solution belongs to, as got from les_createLES. Its table of
+ * variables is used for the solution object; the LES is not solved.
+ *   @param hashOfCircuit
+ * The hash code of the circuit, see pci_getHashOfCircuit.
+ *   @param fileName
+ * The name of the cache file.
+ */
+
+boolean sol_loadSolution( const sol_solution_t * * const ppSolution
+                        , les_linearEquationSystem_t * const pLES
+                        , unsigned long long hashOfCircuit
+                        , const char * const fileName
+                        )
+{
+    *ppSolution = NULL;
+
+    cacheFileImage_t image;
+    if(!readCacheFile(&image, fileName))
+    {
+        LOG_DEBUG(_log, "Cache file %s is not available", fileName)
+        return false;
+    }
+
+    /* Retrieve the dimension of the LES. */
+    unsigned int noKnowns, noUnknowns, noConstants;
+    les_getNoVariables(pLES, &noKnowns, &noUnknowns, &noConstants);
+    const unsigned int noDependents = noUnknowns
+                                      + pLES->pTableOfVars->pCircuitNetList->noVoltageDefs
+                     , noCoefs = 1 + noDependents*noKnowns
+                     , noWords = coe_getNoWordsOfProduct();
+
+    /* Validate the header of the file. The header of a valid file tells the size of the
+       complete file; this size is double-checked prior to any access to the data. */
+    const unsigned char * const pData = image.pData;
+    const cacheFileHeader_t * const pHeader = image.pData;
+    boolean success = image.size >= sizeof(cacheFileHeader_t)
+                      &&  pHeader->magic == CACHE_FILE_MAGIC
+                      &&  pHeader->version == CACHE_FILE_VERSION
+                      &&  pHeader->sizeOfProductWord == sizeof(coe_productOfConstWord_t)
+                      &&  pHeader->sizeOfNumericFactor == sizeof(coe_numericFactor_t);
+    if(!success)
+        LOG_INFO(_log, "Cache file %s has an unknown format and is ignored", fileName)
+    else if(pHeader->hashOfCircuit != hashOfCircuit
+            ||  pHeader->noUnknowns != noUnknowns
+            ||  pHeader->noKnowns != noKnowns
+            ||  pHeader->noDependents != noDependents
+            ||  pHeader->noConstants != noConstants
+            ||  pHeader->noWordsOfProduct != noWords
+            ||  pHeader->noCoefs != noCoefs
+           )
+    {
+        LOG_INFO(_log, "Cache file %s belongs to another circuit and is ignored", fileName)
+        success = false;
+    }
+
+    const size_t offsAvailability = alignToCacheFileSection(sizeof(cacheFileHeader_t))
+               , offsIdxFirstAddend = offsAvailability
+                                      + alignToCacheFileSection(noDependents);
+    size_t offsFactors = 0, offsProducts = 0;
+    if(success)
+    {
+        const unsigned long long noAddends = pHeader->noAddends;
+        offsFactors = offsIdxFirstAddend + (noCoefs+1)*sizeof(unsigned long long);
+        offsProducts = offsFactors
+                       + alignToCacheFileSection(noAddends*sizeof(coe_numericFactor_t));
+        const size_t size = offsProducts
+                            + noAddends*noWords*sizeof(coe_productOfConstWord_t);
+        const unsigned long long * const idxFirstAddendAry =
+                                (const unsigned long long*)(pData + offsIdxFirstAddend);
+        success = image.size == size
+                  &&  idxFirstAddendAry[0] == 0
+                  &&  idxFirstAddendAry[noCoefs] == noAddends;
+        unsigned int idxCoef;
+        for(idxCoef=0; success && idxCoef<noCoefs; ++idxCoef)
+        {
+            if(idxFirstAddendAry[idxCoef+1] < idxFirstAddendAry[idxCoef])
+                success = false;
+        }
+        if(!success)
+            LOG_WARN(_log, "Cache file %s is corrupt and is ignored", fileName)
+    }
+
+    /* Create the solution object as the solver does. */
+    sol_solution_t *pSol = NULL;
+    if(success)
+    {
+        pSol = smalloc(sizeof(sol_solution_t), __FILE__, __LINE__);
+        pSol->noReferencesToThis = 1;
+#ifdef DEBUG
+        ++ _noRefsToObjects;
+#endif
+        pSol->pTableOfVars = tbv_cloneByShallowCopy(pLES->pTableOfVars);
+        pSol->numeratorAry = coe_createMatrix(noDependents, noKnowns);
+        pSol->pDeterminant = coe_coefAddendNull();
+        pSol->pIsDependentAvailableAry = getVectorOfReqDependents(pSol);
+
+        /* The stored solution is only useful if it has been computed for the same set of
+           required dependents. */
+        const unsigned char * const isAvailableAry = pData + offsAvailability;
+        unsigned int idxDependent;
+        for(idxDependent=0; success && idxDependent<noDependents; ++idxDependent)
+        {
+            if((isAvailableAry[idxDependent] != 0)
+               != (pSol->pIsDependentAvailableAry[idxDependent] != false)
+              )
+            {
+                success = false;
+            }
+        }
+        if(!success)
+        {
+            LOG_INFO( _log
+                    , "Cache file %s holds the solution for other results of the circuit"
+                      " and is ignored"
+                    , fileName
+                    )
+        }
+    }
+
+    /* Unpack the coefficients. A packed coefficient is set up to refer to the factors and
+       products in the file image, one coefficient after another. */
+    if(success)
+    {
+        const unsigned long long * const idxFirstAddendAry =
+                                (const unsigned long long*)(pData + offsIdxFirstAddend);
+        coe_numericFactor_t * const factorAry = (coe_numericFactor_t*)(pData + offsFactors);
+        coe_productOfConstWord_t * const productOfConstAry =
+                                        (coe_productOfConstWord_t*)(pData + offsProducts);
+        unsigned int idxCoef;
+        for(idxCoef=0; idxCoef<noCoefs; ++idxCoef)
+        {
+            const size_t idxFirstAddend = (size_t)idxFirstAddendAry[idxCoef];
+            const unsigned int noAddends = (unsigned int)(idxFirstAddendAry[idxCoef+1]
+                                                          - idxFirstAddend
+                                                         );
+            const coe_packedCoef_t packedCoef =
+                { .noAddends = noAddends
+                , .maxNoAddends = noAddends
+                , .noWordsOfProduct = noWords
+                , .productOfConstAry = &productOfConstAry[idxFirstAddend*noWords]
+                , .factorAry = &factorAry[idxFirstAddend]
+                };
+            coe_coef_t * const pCoef = coe_unpackCoef(&packedCoef);
+            if(idxCoef == 0)
+                pSol->pDeterminant = pCoef;
+            else
+            {
+                pSol->numeratorAry[(idxCoef-1) / noKnowns][(idxCoef-1) % noKnowns] =
+                                                                                pCoef;
+            }
+        }
+
+        LOG_INFO( _log
+                , "The solution of the LES is loaded from cache file %s"
+                , fileName
+                )
+    }
+
+    releaseCacheFile(&image);
+
+    if(!success)
+    {
+        sol_deleteSolution(pSol);
+        pSol = NULL;
+    }
+
+    *ppSolution = pSol;
+    return success;
+
+} /* End of sol_loadSolution */
+
+
+
+
 
 /**
  * Get the number of independents the solution depends on.
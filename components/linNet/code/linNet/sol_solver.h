@@ -39,6 +39,24 @@
  * Global type definitions
  */
 
+/** The limits of the resources, which the solver may consume for the solution of a single
+    LES. The elimination is aborted with an error report if any of the limits is exceeded.
+    A limit of null means that the resource is not limited. */
+typedef struct sol_resourceBudget_t
+{
+    /** The maximum number of addends of a coefficient of the LES. */
+    unsigned int maxNoAddendsOfCoef;
+
+    /** The maximum number of addends of coefficients, which the heap of a thread of the
+        solver may hold at a time. */
+    unsigned long maxNoAddendsOfHeap;
+
+    /** The maximum wall-clock time of the solution of a LES in seconds. */
+    unsigned int maxWallTime;
+
+} sol_resourceBudget_t;
+
+
 /** The solution object contains the complete symbolic solution of the LES. */
 typedef struct sol_solution_t
 {
@@ -76,7 +94,10 @@ typedef struct sol_solution_t
  */
 
 /** Initialize the module prior to first use of any of its methods or global data objects. */
-void sol_initModule(log_hLogger_t hGlobalLogger);
+void sol_initModule( log_hLogger_t hGlobalLogger
+                   , unsigned int noThreads
+                   , const sol_resourceBudget_t * const pBudget
+                   );
 
 /** Shutdown of module after use. Release of memory, closing files, etc. */
 void sol_shutdownModule(void);
@@ -86,6 +107,12 @@ boolean sol_createSolution( const sol_solution_t * * const ppSolution
                           , les_linearEquationSystem_t * const pLES
                           );
 
+/** Derive the solution of a LES from the solution of a circuit with the same network. */
+boolean sol_createSolutionFromPrevious( const sol_solution_t * * const ppSolution
+                                      , les_linearEquationSystem_t * const pLES
+                                      , const sol_solution_t * const pPrevSolution
+                                      );
+
 /** Get another reference to an existing object. */
 sol_solution_t *sol_cloneByReference(sol_solution_t * const pExistingObj);
 
@@ -95,6 +122,19 @@ const sol_solution_t *sol_cloneByConstReference(const sol_solution_t * const pEx
 /** Delete a solution object as got from sol_createSolution. */
 void sol_deleteSolution(const sol_solution_t * const pConstSolution);
 
+/** Store a solution in a cache file for reuse by a later run. */
+boolean sol_storeSolution( const sol_solution_t * const pSolution
+                         , unsigned long long hashOfCircuit
+                         , const char * const fileName
+                         );
+
+/** Load a solution from a cache file as an alternative to sol_createSolution. */
+boolean sol_loadSolution( const sol_solution_t * * const ppSolution
+                        , les_linearEquationSystem_t * const pLES
+                        , unsigned long long hashOfCircuit
+                        , const char * const fileName
+                        );
+
 /** Get the number of unknowns, i.e. of independent quantities, a solution object offers a
     solution for. */
 unsigned int sol_getNoIndependents(const sol_solution_t * const pSolution);
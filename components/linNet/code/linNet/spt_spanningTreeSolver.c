@@ -0,0 +1,1022 @@
+/**
+ * @file spt_spanningTreeSolver.c
+ *   A topological solver of the LES of a network, which consists of passive devices and
+ * independent current sources only. It computes the system determinant and all numerators
+ * of Cramer's rule by enumeration of the spanning trees of the network graph.\n
+ * Design considerations:\n
+ *   In such a network the unknowns are the node voltages and the LES is the nodal
+ * admittance matrix: Each device with admittance y between nodes a and b contributes -y to
+ * the diagonal elements of a and b and +y to the two off-diagonal elements. The matrix is
+ * the negated, reduced Laplacian matrix of the graph, whose vertices are the nodes and
+ * whose edges are the devices weighted by their admittance; all ground nodes of the
+ * network are merged into a single vertex, which has been removed. By the matrix tree
+ * theorem, the determinant of the reduced Laplacian is the sum of the products of edge
+ * weights of all spanning trees of the graph; by its all minors generalization, the
+ * cofactor of row r and column c is the sum over all spanning forests of two trees, which
+ * separate r and c from the ground vertex. A current source between the nodes p and q
+ * leads to the numerator of node v, which is the sum over all forests that separate p
+ * from q and v from ground, where the sign depends on whether v is found in the tree of p
+ * or q.\n
+ *   Other than the Gauss elimination, the enumeration doesn't produce any addends, which
+ * cancel out later: Each spanning tree is an addend of the determinant and each forest an
+ * addend of a numerator. Distinct trees have distinct products of constants, since each
+ * constant belongs to a single edge. The cost is therefore linear in the size of the
+ * result. The trees are enumerated by backtracking: Each edge is either part of the tree
+ * under construction or not; an edge that would close a cycle is skipped and an edge is
+ * only dropped if the remaining edges can still complete the tree. The forests, which
+ * separate p and q, are the spanning trees of the graph, in which p and q are merged.\n
+ *   The solver is applicable if the LES has exactly the described structure. This is
+ * figured out from the matrix itself, so that it doesn't depend on the way the LES has
+ * been set up. Voltage sources, current probes, op-amps, controlled sources and port
+ * models of subcircuits lead to other matrix elements; the LES is left to the Gauss
+ * elimination in these cases.
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   spt_initModule
+ *   spt_shutdownModule
+ *   spt_solverLES
+ * Local functions
+ *   addEdge
+ *   getTerminalsOfKnown
+ *   getSignOfPermutation
+ *   deleteGraph
+ *   createGraph
+ *   findRoot
+ *   isConnectable
+ *   addTree
+ *   enumerateTrees
+ *   runEnumeration
+ *   createCoefOfAccumulator
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <assert.h>
+
+#include "smalloc.h"
+#include "log_logger.h"
+#include "coe_coefficient.h"
+#include "coe_coefficient.inlineInterface.h"
+#include "spt_spanningTreeSolver.h"
+
+
+/*
+ * Defines
+ */
+
+/** The wall-clock time is checked every this number of enumerated trees. Must be a power
+    of two. */
+#define NO_TREES_PER_CHECK_OF_TIME  4096u
+
+
+/*
+ * Local type definitions
+ */
+
+/** The reasons for aborting an enumeration. */
+typedef enum { abortReason_none
+             , abortReason_noAddendsOfCoef
+             , abortReason_wallTime } abortReason_t;
+
+
+/** An edge of the graph of the network, i.e. a passive device. */
+typedef struct edge_t
+{
+    /** The connected two vertices. A vertex is identified by the row of the LES, which
+        holds the current balance of the node. The ground vertex has index m. */
+    unsigned int idxVertexA, idxVertexB;
+
+    /** The weight of the edge, the admittance of the device, as product of constants. */
+    coe_productOfConstWord_t productOfConst[COE_MAX_NO_WORDS_OF_PRODUCT];
+
+} edge_t;
+
+
+/** The graph of the network as read off the LES. */
+typedef struct graph_t
+{
+    /** The number of vertices: All rows of the LES and the merged ground nodes. */
+    unsigned int noVertices;
+
+    /** The number of edges. */
+    unsigned int noEdges;
+
+    /** The capacity of \a edgeAry. */
+    unsigned int maxNoEdges;
+
+    /** The edges as malloc allocated array. */
+    edge_t *edgeAry;
+
+    /** The number of knowns of the LES. */
+    unsigned int noKnowns;
+
+    /** The vertices, which a known current is flowing into and out of, respectively. Both
+        are the ground vertex if a known doesn't appear in the LES. */
+    unsigned int *idxVertexPlusAry, *idxVertexMinusAry;
+
+} graph_t;
+
+
+/** The state of an enumeration of spanning trees. */
+typedef struct enumeration_t
+{
+    /** The enumerated graph. */
+    const graph_t *pGraph;
+
+    /** The number of words of a product of constants. */
+    unsigned int noWords;
+
+    /** The union-find structure of the vertices: The parent of each vertex and the rank of
+        each root. The parent of a root is the root itself. The structure is operated
+        without path compression so that each union can be reverted. */
+    unsigned int *parentAry, *rankAry;
+
+    /** A workspace of the size of \a parentAry. */
+    unsigned int *parentTmpAry;
+
+    /** The edges of the tree under construction. */
+    unsigned int *idxEdgeOfTreeAry;
+
+    /** The number of edges of the tree under construction. */
+    unsigned int noEdgesOfTree;
+
+    /** The number of edges of a complete tree. */
+    unsigned int noEdgesOfCompleteTree;
+
+    /** The known, whose numerators are computed, or UINT_MAX if the determinant is
+        computed. */
+    unsigned int idxKnown;
+
+    /** The sign of all addends of the computed coefficients. */
+    coe_numericFactor_t factor;
+
+    /** The accumulator of the determinant. */
+    coe_accumulator_t *pAccDet;
+
+    /** The accumulators of the numerators of all vertices; NULL for those vertices, whose
+        unknown is not required. */
+    coe_accumulator_t **accNumAry;
+
+    /** The number of addends of the computed coefficients so far: Element m is the
+        determinant, the others are the numerators of the vertices. */
+    unsigned int *noAddendsAry;
+
+    /** The resource budget. */
+    unsigned int maxNoAddendsOfCoef;
+    time_t deadline;
+
+    /** The number of enumerated trees. */
+    unsigned long long noTrees;
+
+    /** The reason for aborting the enumeration or abortReason_none. */
+    abortReason_t abortReason;
+
+} enumeration_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** A global logger object is referenced from anywhere for writing progress messages. */
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Add an edge to the graph.
+ *   @return
+ * \a false if the weight of the edge shares a constant with another edge. The theory of
+ * this solver doesn't apply in this case.
+ *   @param pGraph
+ * The graph under construction.
+ *   @param usedConstAry
+ * The constants of all edges so far as a product of constants. The constants of the new
+ * edge are added.
+ *   @param idxVertexA
+ * The first connected vertex.
+ *   @param idxVertexB
+ * The second connected vertex.
+ *   @param productOfConst
+ * The weight of the edge.
+ */
+
+static boolean addEdge( graph_t * const pGraph
+                      , coe_productOfConstWord_t usedConstAry[]
+                      , unsigned int idxVertexA
+                      , unsigned int idxVertexB
+                      , const coe_productOfConstWord_t productOfConst[]
+                      )
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    unsigned int idxWord;
+    for(idxWord=0; idxWord<noWords; ++idxWord)
+    {
+        if((usedConstAry[idxWord] & productOfConst[idxWord]) != 0)
+            return false;
+        usedConstAry[idxWord] |= productOfConst[idxWord];
+    }
+
+    if(pGraph->noEdges >= pGraph->maxNoEdges)
+    {
+        pGraph->maxNoEdges = pGraph->maxNoEdges > 0? 2*pGraph->maxNoEdges: 16;
+        pGraph->edgeAry = srealloc( pGraph->edgeAry
+                                  , pGraph->maxNoEdges * sizeof(edge_t)
+                                  , __FILE__
+                                  , __LINE__
+                                  );
+    }
+    edge_t * const pEdge = &pGraph->edgeAry[pGraph->noEdges++];
+    pEdge->idxVertexA = idxVertexA;
+    pEdge->idxVertexB = idxVertexB;
+    memset(pEdge->productOfConst, 0, sizeof(pEdge->productOfConst));
+    coe_copyProductOfConst(pEdge->productOfConst, productOfConst, noWords);
+    return true;
+
+} /* End of addEdge */
+
+
+
+
+/**
+ * Find the vertices, which the current of a known source is flowing into and out of.
+ *   @return
+ * \a false if the column of the known doesn't describe a single current source.
+ *   @param pGraph
+ * The graph under construction. The terminals of the known are set.
+ *   @param A
+ * The LES.
+ *   @param m
+ * The number of rows and unknowns of the LES.
+ *   @param idxKnown
+ * The index of the known. Its column in the LES is m+idxKnown.
+ */
+
+static boolean getTerminalsOfKnown( graph_t * const pGraph
+                                  , const coe_coefMatrix_t A
+                                  , unsigned int m
+                                  , unsigned int idxKnown
+                                  )
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    unsigned int idxVertexPlus = m
+               , idxVertexMinus = m
+               , idxRow;
+    for(idxRow=0; idxRow<m; ++idxRow)
+    {
+        const coe_coef_t * const pCoef = A[idxRow][m+idxKnown];
+        if(coe_isCoefAddendNull(pCoef))
+            continue;
+        if(pCoef->pNext != NULL
+           ||  !coe_isProductOfNoConst(pCoef->productOfConst, noWords)
+          )
+        {
+            return false;
+        }
+
+        if(pCoef->factor == 1  &&  idxVertexPlus == m)
+            idxVertexPlus = idxRow;
+        else if(pCoef->factor == -1  &&  idxVertexMinus == m)
+            idxVertexMinus = idxRow;
+        else
+            return false;
+    }
+
+    pGraph->idxVertexPlusAry[idxKnown] = idxVertexPlus;
+    pGraph->idxVertexMinusAry[idxKnown] = idxVertexMinus;
+    return true;
+
+} /* End of getTerminalsOfKnown */
+
+
+
+
+/**
+ * Compute the sign of a permutation.
+ *   @return
+ * Get either 1 or -1.
+ *   @param permutationAry
+ * The permutation as map of 0..n-1 onto itself.
+ *   @param n
+ * The number of elements.
+ */
+
+static signed int getSignOfPermutation(const unsigned int permutationAry[], unsigned int n)
+{
+    /* Each cycle of length l contributes l-1 transpositions. */
+    boolean isVisitedAry[n];
+    memset(isVisitedAry, 0, sizeof(isVisitedAry));
+    signed int sign = 1;
+    unsigned int u;
+    for(u=0; u<n; ++u)
+    {
+        if(isVisitedAry[u])
+            continue;
+
+        unsigned int v = u
+                   , lenOfCycle = 0;
+        do
+        {
+            assert(v < n  &&  !isVisitedAry[v]);
+            isVisitedAry[v] = true;
+            v = permutationAry[v];
+            ++ lenOfCycle;
+        }
+        while(v != u);
+        if(lenOfCycle%2 == 0)
+            sign = -sign;
+    }
+    return sign;
+
+} /* End of getSignOfPermutation */
+
+
+
+
+/**
+ * Free the memory of a graph after use.
+ *   @param pGraph
+ * The graph as got from createGraph.
+ */
+
+static void deleteGraph(graph_t * const pGraph)
+{
+    free(pGraph->edgeAry);
+    free(pGraph->idxVertexPlusAry);
+    free(pGraph->idxVertexMinusAry);
+    pGraph->edgeAry = NULL;
+    pGraph->idxVertexPlusAry = NULL;
+    pGraph->idxVertexMinusAry = NULL;
+
+} /* End of deleteGraph */
+
+
+
+
+/**
+ * Read the graph of the network off the LES.
+ *   @return
+ * \a true if the LES is the nodal admittance matrix of a network of passive devices and
+ * independent current sources, \a false otherwise. No graph is returned in the latter
+ * case.
+ *   @param pGraph
+ * The graph is returned in * \a pGraph. Free it with deleteGraph after use.
+ *   @param A
+ * The LES.
+ *   @param m
+ * The number of rows and unknowns of the LES.
+ *   @param n
+ * The number of columns of the LES.
+ *   @param idxColOfRowAry
+ * The permutation, which maps the row holding the current balance of a node onto the
+ * column of the voltage of the same node.
+ */
+
+static boolean createGraph( graph_t * const pGraph
+                          , const coe_coefMatrix_t A
+                          , unsigned int m
+                          , unsigned int n
+                          , const unsigned int idxColOfRowAry[]
+                          )
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    assert(m >= 1  &&  n >= m);
+
+    pGraph->noVertices = m + 1;
+    pGraph->noEdges = 0;
+    pGraph->maxNoEdges = 0;
+    pGraph->edgeAry = NULL;
+    pGraph->noKnowns = n - m;
+    pGraph->idxVertexPlusAry = smalloc( (n-m+1) * sizeof(unsigned int)
+                                      , __FILE__
+                                      , __LINE__
+                                      );
+    pGraph->idxVertexMinusAry = smalloc( (n-m+1) * sizeof(unsigned int)
+                                       , __FILE__
+                                       , __LINE__
+                                       );
+
+    /* The diagonal elements, sign inverted, will be reduced by the weights of the edges
+       between the nodes. What remains are the edges to ground. */
+    coe_coef_t *diagAry[m];
+    unsigned int idxRow;
+    for(idxRow=0; idxRow<m; ++idxRow)
+    {
+        diagAry[idxRow] = coe_cloneByDeepCopy(A[idxRow][idxColOfRowAry[idxRow]]);
+        coe_mulConst(diagAry[idxRow], /* constant */ -1);
+    }
+
+    coe_productOfConstWord_t usedConstAry[COE_MAX_NO_WORDS_OF_PRODUCT] = {0};
+    boolean isApplicable = true;
+    for(idxRow=0; isApplicable && idxRow<m; ++idxRow)
+    {
+        unsigned int idxRowOther;
+        for(idxRowOther=idxRow+1; isApplicable && idxRowOther<m; ++idxRowOther)
+        {
+            /* The admittance matrix is symmetric. Each addend of an element off the
+               diagonal is a device between both nodes. */
+            const coe_coef_t *pCoef = A[idxRow][idxColOfRowAry[idxRowOther]];
+            if(!coe_isEqualCoef(pCoef, A[idxRowOther][idxColOfRowAry[idxRow]]))
+                isApplicable = false;
+            for(; isApplicable && pCoef!=NULL; pCoef=pCoef->pNext)
+            {
+                if(pCoef->factor != 1
+                   ||  coe_isProductOfNoConst(pCoef->productOfConst, noWords)
+                   ||  !addEdge( pGraph
+                               , usedConstAry
+                               , idxRow
+                               , idxRowOther
+                               , pCoef->productOfConst
+                               )
+                  )
+                {
+                    isApplicable = false;
+                }
+                else
+                {
+                    coe_productOfConst_t productOfConst = COE_PRODUCT_OF_NO_CONST;
+                    coe_copyProductOfConst( productOfConst.wordAry
+                                          , pCoef->productOfConst
+                                          , noWords
+                                          );
+                    coe_addAddend(&diagAry[idxRow], /* factor */ -1, productOfConst);
+                    coe_addAddend(&diagAry[idxRowOther], /* factor */ -1, productOfConst);
+                }
+            }
+        } /* End for(All elements right of the diagonal) */
+    } /* End for(All rows) */
+
+    /* What remains of the diagonal are the devices to ground. */
+    for(idxRow=0; isApplicable && idxRow<m; ++idxRow)
+    {
+        const coe_coef_t *pCoef;
+        for(pCoef=diagAry[idxRow]; isApplicable && pCoef!=NULL; pCoef=pCoef->pNext)
+        {
+            if(pCoef->factor != 1
+               ||  coe_isProductOfNoConst(pCoef->productOfConst, noWords)
+               ||  !addEdge( pGraph
+                           , usedConstAry
+                           , idxRow
+                           , /* idxVertexB */ m
+                           , pCoef->productOfConst
+                           )
+              )
+            {
+                isApplicable = false;
+            }
+        }
+    }
+    for(idxRow=0; idxRow<m; ++idxRow)
+        coe_freeCoef(diagAry[idxRow]);
+
+    unsigned int idxKnown;
+    for(idxKnown=0; isApplicable && idxKnown<n-m; ++idxKnown)
+        isApplicable = getTerminalsOfKnown(pGraph, A, m, idxKnown);
+
+    if(!isApplicable)
+        deleteGraph(pGraph);
+
+    return isApplicable;
+
+} /* End of createGraph */
+
+
+
+
+/**
+ * Find the root of the tree of a vertex in a union-find structure.
+ *   @return
+ * Get the vertex, which represents the tree.
+ *   @param parentAry
+ * The union-find structure.
+ *   @param idxVertex
+ * The vertex.
+ */
+
+static inline unsigned int findRoot(const unsigned int parentAry[], unsigned int idxVertex)
+{
+    while(parentAry[idxVertex] != idxVertex)
+        idxVertex = parentAry[idxVertex];
+    return idxVertex;
+
+} /* End of findRoot */
+
+
+
+
+/**
+ * Check if the tree under construction can still be completed with the remaining edges.
+ *   @return
+ * Get the Boolean answer.
+ *   @param pEnum
+ * The state of the enumeration.
+ *   @param idxEdgeFirst
+ * The first of the remaining edges.
+ */
+
+static boolean isConnectable(enumeration_t * const pEnum, unsigned int idxEdgeFirst)
+{
+    const graph_t * const pGraph = pEnum->pGraph;
+    unsigned int noUnions = pEnum->noEdgesOfCompleteTree - pEnum->noEdgesOfTree;
+    if(pGraph->noEdges - idxEdgeFirst < noUnions)
+        return false;
+
+    unsigned int * const parentAry = pEnum->parentTmpAry;
+    memcpy(parentAry, pEnum->parentAry, pGraph->noVertices*sizeof(unsigned int));
+
+    unsigned int idxEdge;
+    for(idxEdge=idxEdgeFirst; noUnions>0 && idxEdge<pGraph->noEdges; ++idxEdge)
+    {
+        const unsigned int rootA = findRoot(parentAry, pGraph->edgeAry[idxEdge].idxVertexA)
+                         , rootB = findRoot(parentAry, pGraph->edgeAry[idxEdge].idxVertexB);
+        if(rootA != rootB)
+        {
+            /* The workspace is discarded after use, any union will do. */
+            parentAry[rootB] = rootA;
+            -- noUnions;
+        }
+    }
+    return noUnions == 0;
+
+} /* End of isConnectable */
+
+
+
+
+/**
+ * Add the addends of a completed tree to the computed coefficients.
+ *   @param pEnum
+ * The state of the enumeration.
+ */
+
+static void addTree(enumeration_t * const pEnum)
+{
+    const graph_t * const pGraph = pEnum->pGraph;
+    const unsigned int noWords = pEnum->noWords
+                     , idxVertexGnd = pGraph->noVertices - 1;
+
+    /* The constants of the edges are disjoint, the product of the weights is the union of
+       their constants. */
+    coe_productOfConstWord_t productOfConst[COE_MAX_NO_WORDS_OF_PRODUCT] = {0};
+    unsigned int u, idxWord;
+    for(u=0; u<pEnum->noEdgesOfTree; ++u)
+    {
+        const edge_t * const pEdge = &pGraph->edgeAry[pEnum->idxEdgeOfTreeAry[u]];
+        for(idxWord=0; idxWord<noWords; ++idxWord)
+            productOfConst[idxWord] |= pEdge->productOfConst[idxWord];
+    }
+
+    if(pEnum->idxKnown == UINT_MAX)
+    {
+        coe_accumulateAddend(pEnum->pAccDet, pEnum->factor, productOfConst);
+        if(++pEnum->noAddendsAry[idxVertexGnd] > pEnum->maxNoAddendsOfCoef)
+            pEnum->abortReason = abortReason_noAddendsOfCoef;
+    }
+    else
+    {
+        /* The tree is a forest of two trees in the original graph. Figure out, which
+           vertices belong to the tree of the vertex, which the known current flows
+           into. */
+        unsigned int * const parentAry = pEnum->parentTmpAry;
+        for(u=0; u<pGraph->noVertices; ++u)
+            parentAry[u] = u;
+        for(u=0; u<pEnum->noEdgesOfTree; ++u)
+        {
+            const edge_t * const pEdge = &pGraph->edgeAry[pEnum->idxEdgeOfTreeAry[u]];
+            parentAry[findRoot(parentAry, pEdge->idxVertexB)] =
+                                                    findRoot(parentAry, pEdge->idxVertexA);
+        }
+        const unsigned int rootPlus =
+                        findRoot(parentAry, pGraph->idxVertexPlusAry[pEnum->idxKnown]);
+        const boolean isGndWithPlus = findRoot(parentAry, idxVertexGnd) == rootPlus;
+
+        /* A vertex in the tree of the inflow, which is separated from ground, has a
+           positive addend; a vertex in the other tree, if ground is in the tree of the
+           inflow, has a negative addend. */
+        for(u=0; u<idxVertexGnd; ++u)
+        {
+            if(pEnum->accNumAry[u] == NULL)
+                continue;
+            const boolean isWithPlus = findRoot(parentAry, u) == rootPlus;
+            if(isWithPlus != isGndWithPlus)
+            {
+                coe_accumulateAddend( pEnum->accNumAry[u]
+                                    , isWithPlus? pEnum->factor: -pEnum->factor
+                                    , productOfConst
+                                    );
+                if(++pEnum->noAddendsAry[u] > pEnum->maxNoAddendsOfCoef)
+                    pEnum->abortReason = abortReason_noAddendsOfCoef;
+            }
+        }
+    } /* End if(Determinant or numerator?) */
+
+    if((++pEnum->noTrees & (NO_TREES_PER_CHECK_OF_TIME-1)) == 0
+       &&  pEnum->deadline != 0
+       &&  time(NULL) > pEnum->deadline
+      )
+    {
+        pEnum->abortReason = abortReason_wallTime;
+    }
+} /* End of addTree */
+
+
+
+
+/**
+ * Enumerate all completions of the tree under construction by backtracking over the
+ * remaining edges.
+ *   @param pEnum
+ * The state of the enumeration.
+ *   @param idxEdge
+ * The next edge to decide on. All edges before have been either taken into the tree or
+ * rejected.
+ */
+
+static void enumerateTrees(enumeration_t * const pEnum, unsigned int idxEdge)
+{
+    if(pEnum->abortReason != abortReason_none)
+        return;
+    if(pEnum->noEdgesOfTree == pEnum->noEdgesOfCompleteTree)
+    {
+        addTree(pEnum);
+        return;
+    }
+    if(idxEdge >= pEnum->pGraph->noEdges)
+        return;
+
+    const edge_t * const pEdge = &pEnum->pGraph->edgeAry[idxEdge];
+    const unsigned int rootA = findRoot(pEnum->parentAry, pEdge->idxVertexA)
+                     , rootB = findRoot(pEnum->parentAry, pEdge->idxVertexB);
+    if(rootA == rootB)
+    {
+        /* The edge would close a cycle. */
+        enumerateTrees(pEnum, idxEdge+1);
+        return;
+    }
+
+    /* Take the edge into the tree. The union by rank is reverted afterwards. */
+    const unsigned int rootParent = pEnum->rankAry[rootA] >= pEnum->rankAry[rootB]
+                                    ? rootA
+                                    : rootB
+                     , rootChild = rootParent == rootA? rootB: rootA;
+    const boolean isRankIncremented = pEnum->rankAry[rootA] == pEnum->rankAry[rootB];
+    pEnum->parentAry[rootChild] = rootParent;
+    if(isRankIncremented)
+        ++ pEnum->rankAry[rootParent];
+    pEnum->idxEdgeOfTreeAry[pEnum->noEdgesOfTree++] = idxEdge;
+
+    enumerateTrees(pEnum, idxEdge+1);
+
+    -- pEnum->noEdgesOfTree;
+    if(isRankIncremented)
+        -- pEnum->rankAry[rootParent];
+    pEnum->parentAry[rootChild] = rootChild;
+
+    /* Reject the edge if the tree can still be completed without it. */
+    if(isConnectable(pEnum, idxEdge+1))
+        enumerateTrees(pEnum, idxEdge+1);
+
+} /* End of enumerateTrees */
+
+
+
+
+/**
+ * Enumerate all spanning trees of the graph or all spanning trees of the graph with two
+ * merged vertices.
+ *   @return
+ * \a false if the enumeration has been aborted because of the resource budget.
+ *   @param pEnum
+ * The state of the enumeration. Field \a idxKnown decides, which coefficients are
+ * computed. For a known, the vertices, which its current flows into and out of, are
+ * merged.
+ */
+
+static boolean runEnumeration(enumeration_t * const pEnum)
+{
+    const graph_t * const pGraph = pEnum->pGraph;
+    unsigned int u;
+    for(u=0; u<pGraph->noVertices; ++u)
+    {
+        pEnum->parentAry[u] = u;
+        pEnum->rankAry[u] = 0;
+        pEnum->noAddendsAry[u] = 0;
+    }
+    pEnum->noEdgesOfTree = 0;
+    pEnum->noEdgesOfCompleteTree = pGraph->noVertices - 1;
+    if(pEnum->idxKnown != UINT_MAX)
+    {
+        const unsigned int idxVertexPlus = pGraph->idxVertexPlusAry[pEnum->idxKnown]
+                         , idxVertexMinus = pGraph->idxVertexMinusAry[pEnum->idxKnown];
+        assert(idxVertexPlus != idxVertexMinus);
+        pEnum->parentAry[idxVertexMinus] = idxVertexPlus;
+        pEnum->rankAry[idxVertexPlus] = 1;
+        -- pEnum->noEdgesOfCompleteTree;
+    }
+
+    if(pEnum->noEdgesOfCompleteTree == 0  ||  isConnectable(pEnum, /* idxEdgeFirst */ 0))
+        enumerateTrees(pEnum, /* idxEdge */ 0);
+
+    return pEnum->abortReason == abortReason_none;
+
+} /* End of runEnumeration */
+
+
+
+
+/**
+ * Make a coefficient from the addends of an accumulator.
+ *   @return
+ * Get the new coefficient. It is null if the accumulator is empty.
+ *   @param pAcc
+ * The accumulator. It is empty after return.
+ */
+
+static coe_coef_t *createCoefOfAccumulator(coe_accumulator_t * const pAcc)
+{
+    const unsigned int noWords = coe_getNoWordsOfProduct();
+    coe_coef_t *pCoef = coe_coefAddendNull()
+             , **ppCoefEnd = &pCoef;
+
+    /* The accumulator returns the addends in the order of falling binary interpretation of
+       the product of constants, which is the order of the addends of a coefficient. */
+    coe_productOfConstWord_t productOfConst[COE_MAX_NO_WORDS_OF_PRODUCT];
+    coe_numericFactor_t factor;
+    while(coe_fetchMaxAddend(pAcc, productOfConst, &factor))
+    {
+        coe_coefAddend_t * const pAddend = coe_newCoefAddend();
+        pAddend->factor = factor;
+        coe_copyProductOfConst(pAddend->productOfConst, productOfConst, noWords);
+        *ppCoefEnd = pAddend;
+        ppCoefEnd = &pAddend->pNext;
+    }
+    *ppCoefEnd = NULL;
+    return pCoef;
+
+} /* End of createCoefOfAccumulator */
+
+
+
+
+/**
+ * Initialize the module at application startup.
+ *   @param hGlobalLogger
+ * This module will use the passed logger object for all reporting during application life
+ * time. It must be a real object, LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT is not permitted.
+ *   @remark
+ * Do not forget to call the counterpart at application end.
+ *   @remark
+ * This module depends on the module coe_coefficient. It needs to be initialized before
+ * and shut down after this module.
+ *   @see void spt_shutdownModule()
+ */
+
+void spt_initModule(log_hLogger_t hGlobalLogger)
+{
+    assert(hGlobalLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+    _log = log_cloneByReference(hGlobalLogger);
+
+} /* End of spt_initModule */
+
+
+
+
+/**
+ * Do all cleanup after use of the module, which is required to avoid memory leaks,
+ * orphaned handles, etc.
+ */
+
+void spt_shutdownModule()
+{
+    /* Discard reference to the logger object. */
+    log_deleteLogger(_log);
+    _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+
+} /* End of spt_shutdownModule */
+
+
+
+
+/**
+ * Solve the LES of a network of passive devices and independent current sources by
+ * enumeration of the spanning trees of the network graph. The function has the same
+ * result as the Gauss elimination of the solver: The system determinant is found in
+ * A[m-1][m-1] and the numerator of unknown \a i in row \a i of the columns of the knowns,
+ * where \a i is the column of the unknown. The numerators have the inverse sign, since the
+ * LES has all terms on one side.
+ *   @return
+ * \a true if the LES has been solved, \a false otherwise. The LES is not touched in the
+ * latter case.
+ *   @param pIsApplicable
+ * Whether the LES has the structure of a network of passive devices and current sources
+ * is returned in * \a pIsApplicable. If not then the function returns false without any
+ * further action or report.
+ *   @param pIsDetNull
+ * If the function returns false then * \a pIsDetNull tells whether the system determinant
+ * has been found to be null. No error has been reported in this case. If the solver has
+ * been applicable and the determinant is not null then the resource budget has been
+ * exceeded; this has been reported as an error.
+ *   @param A
+ * The LES as m*n matrix.
+ *   @param m
+ * The number of rows and unknowns of the LES.
+ *   @param n
+ * The number of columns of the LES. The columns m..n-1 belong to the knowns.
+ *   @param idxColOfRowAry
+ * The map of the rows onto the columns: The voltage of the node, whose current balance is
+ * held in row \a r, has column idxColOfRowAry[r].
+ *   @param isRowRequiredAry
+ * A Boolean vector telling for each column of an unknown, whether the numerators of this
+ * unknown need to be computed.
+ *   @param maxNoAddendsOfCoef
+ * The maximum number of addends of a computed coefficient or UINT_MAX.
+ *   @param deadline
+ * The solver is aborted if the wall-clock time exceeds this time. Null if there's no
+ * limit.
+ */
+
+boolean spt_solverLES( boolean * const pIsApplicable
+                     , boolean * const pIsDetNull
+                     , coe_coefMatrix_t A
+                     , unsigned int m
+                     , unsigned int n
+                     , const unsigned int idxColOfRowAry[]
+                     , const boolean isRowRequiredAry[]
+                     , unsigned int maxNoAddendsOfCoef
+                     , time_t deadline
+                     )
+{
+    *pIsDetNull = false;
+    graph_t graph;
+    *pIsApplicable = m >= 1  &&  createGraph(&graph, A, m, n, idxColOfRowAry);
+    if(!*pIsApplicable)
+        return false;
+
+    const unsigned int noKnowns = n - m
+                     , noVertices = graph.noVertices;
+    unsigned int parentAry[noVertices]
+               , rankAry[noVertices]
+               , parentTmpAry[noVertices]
+               , idxEdgeOfTreeAry[noVertices]
+               , noAddendsAry[noVertices];
+    coe_accumulator_t *accNumAry[m];
+    unsigned int u;
+    for(u=0; u<m; ++u)
+    {
+        accNumAry[u] = isRowRequiredAry[idxColOfRowAry[u]]? coe_createAccumulator(): NULL;
+        if(accNumAry[u] != NULL)
+            coe_resetAccumulator(accNumAry[u]);
+    }
+
+    /* The matrix is the negated, reduced Laplacian matrix with permuted columns. The
+       determinant is the sum of the weights of all trees with the sign of the negation
+       and the permutation. Each cofactor has one row less and therefore the inverse
+       sign. */
+    const signed int signOfPermutation = getSignOfPermutation(idxColOfRowAry, m);
+    enumeration_t enumeration = { .pGraph = &graph
+                                , .noWords = coe_getNoWordsOfProduct()
+                                , .parentAry = parentAry
+                                , .rankAry = rankAry
+                                , .parentTmpAry = parentTmpAry
+                                , .idxEdgeOfTreeAry = idxEdgeOfTreeAry
+                                , .noEdgesOfTree = 0
+                                , .noEdgesOfCompleteTree = 0
+                                , .idxKnown = UINT_MAX
+                                , .factor = (m%2 == 0? 1: -1) * signOfPermutation
+                                , .pAccDet = coe_createAccumulator()
+                                , .accNumAry = accNumAry
+                                , .noAddendsAry = noAddendsAry
+                                , .maxNoAddendsOfCoef = maxNoAddendsOfCoef
+                                , .deadline = deadline
+                                , .noTrees = 0
+                                , .abortReason = abortReason_none
+                                };
+    coe_resetAccumulator(enumeration.pAccDet);
+    boolean success = runEnumeration(&enumeration);
+    coe_coef_t *pDeterminant = coe_coefAddendNull();
+    if(success)
+    {
+        pDeterminant = createCoefOfAccumulator(enumeration.pAccDet);
+        if(coe_isCoefAddendNull(pDeterminant))
+        {
+            *pIsDetNull = true;
+            success = false;
+        }
+    }
+    const unsigned long long noTreesOfDet = enumeration.noTrees;
+
+    /* The numerators of all unknowns for one known after the other. */
+    coe_coefMatrix_t numeratorAry = success? coe_createMatrix(m, noKnowns): NULL;
+    enumeration.factor = -enumeration.factor;
+    unsigned int idxKnown;
+    for(idxKnown=0; success && idxKnown<noKnowns; ++idxKnown)
+    {
+        if(graph.idxVertexPlusAry[idxKnown] == graph.idxVertexMinusAry[idxKnown])
+            continue;
+
+        enumeration.idxKnown = idxKnown;
+        success = runEnumeration(&enumeration);
+        for(u=0; u<m; ++u)
+        {
+            if(accNumAry[u] != NULL)
+            {
+                if(success)
+                    numeratorAry[u][idxKnown] = createCoefOfAccumulator(accNumAry[u]);
+                coe_resetAccumulator(accNumAry[u]);
+            }
+        }
+    }
+
+    if(success)
+    {
+        LOG_DEBUG( _log
+                 , "The LES is solved by enumeration of spanning trees. The network has %u"
+                   " nodes and %u devices, the determinant has %llu and all numerators"
+                   " %llu addends"
+                 , noVertices
+                 , graph.noEdges
+                 , noTreesOfDet
+                 , enumeration.noTrees - noTreesOfDet
+                 )
+
+        /* The results replace the LES. The numerators of an unknown are put into the row,
+           whose index is the column of the unknown. */
+        for(u=0; u<m; ++u)
+        {
+            unsigned int idxCol;
+            for(idxCol=0; idxCol<n; ++idxCol)
+            {
+                coe_freeCoef(A[u][idxCol]);
+                A[u][idxCol] = coe_coefAddendNull();
+            }
+        }
+        for(u=0; u<m; ++u)
+        {
+            if(accNumAry[u] == NULL)
+                continue;
+            for(idxKnown=0; idxKnown<noKnowns; ++idxKnown)
+            {
+                A[idxColOfRowAry[u]][m+idxKnown] = numeratorAry[u][idxKnown];
+                numeratorAry[u][idxKnown] = coe_coefAddendNull();
+            }
+        }
+        A[m-1][m-1] = pDeterminant;
+        pDeterminant = coe_coefAddendNull();
+    }
+    else if(!*pIsDetNull)
+    {
+        LOG_ERROR( _log
+                 , "The enumeration of spanning trees of the network is aborted. %s The"
+                   " network has %u nodes and %u devices. The circuit is too complex for"
+                   " the resource budget of the solver"
+                 , enumeration.abortReason == abortReason_wallTime
+                   ? "The computation takes too much time."
+                   : "A coefficient has too many addends."
+                 , noVertices
+                 , graph.noEdges
+                 )
+    }
+
+    coe_deleteMatrix(numeratorAry, m, noKnowns);
+    coe_freeCoef(pDeterminant);
+    coe_deleteAccumulator(enumeration.pAccDet);
+    for(u=0; u<m; ++u)
+    {
+        if(accNumAry[u] != NULL)
+            coe_deleteAccumulator(accNumAry[u]);
+    }
+    deleteGraph(&graph);
+
+    return success;
+
+} /* End of spt_solverLES */
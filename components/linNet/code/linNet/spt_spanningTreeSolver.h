@@ -0,0 +1,72 @@
+#ifndef SPT_SPANNINGTREESOLVER_INCLUDED
+#define SPT_SPANNINGTREESOLVER_INCLUDED
+/**
+ * @file spt_spanningTreeSolver.h
+ * Definition of global interface of module spt_spanningTreeSolver.c
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <time.h>
+
+#include "types.h"
+#include "log_logger.h"
+#include "coe_coefficient.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize the module prior to first use of any of its methods or global data objects. */
+void spt_initModule(log_hLogger_t hGlobalLogger);
+
+/** Shutdown of module after use. Release of memory, closing files, etc. */
+void spt_shutdownModule(void);
+
+/** Solve the LES of a network of passive devices and current sources by enumeration of
+    its spanning trees. */
+boolean spt_solverLES( boolean * const pIsApplicable
+                     , boolean * const pIsDetNull
+                     , coe_coefMatrix_t A
+                     , unsigned int m
+                     , unsigned int n
+                     , const unsigned int idxColOfRowAry[]
+                     , const boolean isRowRequiredAry[]
+                     , unsigned int maxNoAddendsOfCoef
+                     , time_t deadline
+                     );
+
+#endif  /* SPT_SPANNINGTREESOLVER_INCLUDED */
@@ -34,6 +34,7 @@
  *   tbv_addUnknown
  *   tbv_addConstant
  *   tbv_sortConstants
+ *   tbv_getValueOfDevice
  *   tbv_exportAsMCode
  *   tbv_getKnownByDevice
  *   tbv_getUnknownByNode
@@ -43,6 +44,8 @@
  *   tbv_getReferencedDeviceByBitIndex
  *   tbv_setTargetUnknownForSolver
  * Local functions
+ *   hashName
+ *   enterName
  *   checkName
  *   cmpDeviceConstantNames
  */
@@ -63,7 +66,10 @@
 #include "qsort_c.h"
 #include "rat_rationalNumber.h"
 #include "pci_parserCircuit.h"
+#include "ost_outputStream.h"
 #include "msc_mScript.h"
+#include "coe_coefficient.h"
+#include "coe_coefficient.inlineInterface.h"
 #include "tbv_tableOfVariables.h"
 
 
@@ -87,11 +93,11 @@
  */
 
 /** A global logger object is referenced from anywhere for writing progress messages. */
-static log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
+static THREAD_LOCAL log_hLogger_t _log = LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT;
 
 #ifdef DEBUG
 /** A global counter of all refernces to any created objects. Used to detect memory leaks. */
-static unsigned int _noRefsToObjects = 0;
+static THREAD_LOCAL unsigned int _noRefsToObjects = 0;
 #endif
 
 
@@ -99,6 +105,55 @@ static unsigned int _noRefsToObjects = 0;
  * Function implementation
  */
 
+/**
+ * Compute the hash code of a name of a device, known or unknown. The FNV-1a hash algorithm
+ * of 32 Bit is applied.
+ *   @return
+ * Get the hash code.
+ *   @param name
+ * The hashed name.
+ */
+
+static unsigned int hashName(const char *name)
+{
+    unsigned int hash = 2166136261u;
+    while(*name != '\0')
+        hash = (hash ^ (unsigned char)*name++) * 16777619u;
+    return hash;
+
+} /* End of hashName */
+
+
+
+
+/**
+ * Enter a name into the hash table of all names of the table of variables.
+ *   @param pTable
+ * A pointer to the table of variables. The hash table has enough free slots for all
+ * devices, knowns and unknowns.
+ *   @param name
+ * The name of the object.
+ *   @param idxName
+ * The encoded index of the named object, see \a idxNameByHashAry.
+ */
+
+static void enterName( tbv_tableOfVariables_t * const pTable
+                     , const char * const name
+                     , unsigned int idxName
+                     )
+{
+    const unsigned int mask = pTable->noNameHashSlots - 1;
+    assert((pTable->noNameHashSlots & mask) == 0  &&  idxName != UINT_MAX);
+    unsigned int idxSlot = hashName(name) & mask;
+    while(pTable->idxNameByHashAry[idxSlot] != UINT_MAX)
+        idxSlot = (idxSlot+1) & mask;
+    pTable->idxNameByHashAry[idxSlot] = idxName;
+
+} /* End of enterName */
+
+
+
+
 /**
  * Double-check that the name of a known or unknown is not yet in use for another known,
  * unknown or constant. Report a problem in the application log.
@@ -121,61 +176,82 @@ static boolean checkName( tbv_tableOfVariables_t * const pTable
     assert(nameToCheck != NULL  &&  strlen(nameToCheck) != 0);
 
     boolean success = true;
-    const char *kindOfOtherObj;
-    unsigned int u;
-
-    for(u=0; u<pTable->noKnowns; ++u)
-    {
-        if(strcmp(pTable->knownLookUpAry[u].name, nameToCheck) == 0)
-        {
-            kindOfOtherObj = "a constant source";
-            success = false;
-        }
-    }
-    for(u=0; success && u<pTable->noUnknowns; ++u)
+    const char *kindOfOtherObj = NULL
+             , *kindOfClashingUnknown = NULL;
+    boolean isNameOfKnown = false
+          , isNameOfDevice = false;
+
+    /* All objects of the same name are found along the probing sequence of the hash code
+       of the name. For the feedback, a clash with a known has precedence over a clash with
+       an unknown and this has precedence over a clash with a device. */
+    const unsigned int noDevices = pTable->pCircuitNetList->noDevices
+                     , mask = pTable->noNameHashSlots - 1;
+    unsigned int idxSlot = hashName(nameToCheck) & mask
+               , idxName;
+    while((idxName=pTable->idxNameByHashAry[idxSlot]) != UINT_MAX)
     {
-        if(strcmp(pTable->unknownLookUpAry[u].name, nameToCheck) == 0)
+        if(idxName < noDevices)
         {
-            if(pTable->unknownLookUpAry[u].idxNode != PCI_NULL_NODE)
-                kindOfOtherObj = "a node's voltage potential";
-            else
+            const pci_device_t * const pDev = pTable->pCircuitNetList->pDeviceAry[idxName];
+
+            /* The names of constant sources are used as known quantities in the LES. The
+               device has thus the same name as the known. Consequently, constant sources
+               need to be taken out of consideration here.
+                 For unknown currents: If they belong to current probes then it's
+               permitted that the name of the probe is identical to the name of the
+               current.
+                 These exceptions make it worth a consideration, what the added value of
+               this check is; it's not a safe complete check for name ambiguities. For
+               example, what about two constant sources having the same name?
+                 Parser (r584): Constant voltage sources of same name are recognized by the
+               parser, same device names also. An op-amp can have the name of a
+               user-defined voltage without any warning, error message or recognizable
+               problem (nonetheless undesired).
+                 Do we need to invent a global name pool, beginning in the parser? */
+            if(strcmp(pDev->name, nameToCheck) == 0
+               && (!isKnown
+                   || (pDev->type != pci_devType_srcU  &&  pDev->type != pci_devType_srcI)
+                  )
+               && (isKnown  ||  pDev->type != pci_devType_currentProbe)
+              )
             {
-                assert(pTable->unknownLookUpAry[u].idxDevice != PCI_NULL_DEVICE);
-                kindOfOtherObj = "an internal unknown current";
+                isNameOfDevice = true;
             }
-            success = false;
         }
-    }
-    for(u=0; success && u<pTable->pCircuitNetList->noDevices; ++u)
-    {
-        /* The names of constant sources are used as known quantities in the LES. The
-           device has thus the same name as the known. Consequently, constant sources need
-           to be taken out of consideration here.
-             For unknown currents: If they belong to current probes then it's permitted
-           that the name of the probe is identical to the name of the current.
-             These exceptions make it worth a consideration, what the added value of this
-           check is; it's not a safe complete check for name ambiguities. For example, what
-           about two constant sources having the same name?
-             Parser (r584): Constant voltage sources of same name are recognized by the
-           parser, same device names also. An op-amp can have the name of a user-defined
-           voltage without any warning, error message or recognizable problem (nonetheless
-           undesired). 
-             Do we need to invent a global name pool, beginning in the parser? */
-        if(strcmp(pTable->pCircuitNetList->pDeviceAry[u]->name, nameToCheck) == 0
-           && (!isKnown
-               || (pTable->pCircuitNetList->pDeviceAry[u]->type != pci_devType_srcU
-                   &&  pTable->pCircuitNetList->pDeviceAry[u]->type != pci_devType_srcI
-                  )
-              )
-           && (isKnown
-               ||  pTable->pCircuitNetList->pDeviceAry[u]->type != pci_devType_currentProbe
-              )
-          )
+        else if(idxName < noDevices + pTable->maxNoKnowns)
         {
-            kindOfOtherObj = "a device";
-            success = false;
+            assert(idxName - noDevices < pTable->noKnowns);
+            if(strcmp(pTable->knownLookUpAry[idxName - noDevices].name, nameToCheck) == 0)
+                isNameOfKnown = true;
         }
-    }
+        else
+        {
+            const tbv_unknownVariable_t * const pUnknown =
+                    &pTable->unknownLookUpAry[idxName - noDevices - pTable->maxNoKnowns];
+            assert(pUnknown < &pTable->unknownLookUpAry[pTable->noUnknowns]);
+            if(strcmp(pUnknown->name, nameToCheck) == 0)
+            {
+                if(pUnknown->idxNode != PCI_NULL_NODE)
+                    kindOfClashingUnknown = "a node's voltage potential";
+                else
+                {
+                    assert(pUnknown->idxDevice != PCI_NULL_DEVICE);
+                    kindOfClashingUnknown = "an internal unknown current";
+                }
+            }
+        }
+
+        idxSlot = (idxSlot+1) & mask;
+
+    } /* End while(All names along the probing sequence) */
+
+    if(isNameOfKnown)
+        kindOfOtherObj = "a constant source";
+    else if(kindOfClashingUnknown != NULL)
+        kindOfOtherObj = kindOfClashingUnknown;
+    else if(isNameOfDevice)
+        kindOfOtherObj = "a device";
+    success = kindOfOtherObj == NULL;
     
     /* In general, s should be avoided as a name as it will appear in the final result as
        frequency variable. */
@@ -419,6 +495,22 @@ tbv_tableOfVariables_t *tbv_createTableOfVariables( unsigned int noKnowns
     for(u=0; u<pCircuitNetList->noDevices; ++u)
         pTab->devIdxToConstantIdxAry[u] = UINT_MAX;
 
+    /* The hash table of names is sized for a load factor of no more than one half, when
+       all knowns and unknowns have been added. The device names are entered at once. */
+    const unsigned int noNames = pCircuitNetList->noDevices + noKnowns + noUnknowns;
+    pTab->noNameHashSlots = 16;
+    while(pTab->noNameHashSlots < 2*noNames)
+        pTab->noNameHashSlots *= 2;
+    pTab->idxNameByHashAry = smalloc( sizeof(*pTab->idxNameByHashAry)
+                                      * pTab->noNameHashSlots
+                                    , __FILE__
+                                    , __LINE__
+                                    );
+    for(u=0; u<pTab->noNameHashSlots; ++u)
+        pTab->idxNameByHashAry[u] = UINT_MAX;
+    for(u=0; u<pCircuitNetList->noDevices; ++u)
+        enterName(pTab, pCircuitNetList->pDeviceAry[u]->name, /* idxName */ u);
+
     pTab->pCircuitNetList = pci_cloneByConstReference(pCircuitNetList);
 
 #ifdef DEBUG
@@ -543,6 +635,15 @@ tbv_tableOfVariables_t *tbv_cloneByShallowCopy
     for(i=0; i<noEntries; ++i)
         pCopy->devIdxToConstantIdxAry[i] = pExistingObj->devIdxToConstantIdxAry[i];
 
+    noEntries = pExistingObj->noNameHashSlots;
+    pCopy->noNameHashSlots = noEntries;
+    pCopy->idxNameByHashAry = smalloc( sizeof(*pCopy->idxNameByHashAry) * noEntries
+                                     , __FILE__
+                                     , __LINE__
+                                     );
+    for(i=0; i<noEntries; ++i)
+        pCopy->idxNameByHashAry[i] = pExistingObj->idxNameByHashAry[i];
+
     /* The anyway never changed object holding the parse result can be copied by reference. */
     pCopy->pCircuitNetList = pci_cloneByConstReference(pExistingObj->pCircuitNetList);
 
@@ -667,6 +768,7 @@ void tbv_deleteTableOfVariables(const tbv_tableOfVariables_t * const pConstTabOf
 
         free(pTabOfVars->constantIdxToDevIdxAry);
         free(pTabOfVars->devIdxToConstantIdxAry);
+        free(pTabOfVars->idxNameByHashAry);
 
         free(pTabOfVars);
     }
@@ -731,8 +833,7 @@ void tbv_logTableOfVariables(const tbv_tableOfVariables_t * const pTable)
     }
 
     LOG_DEBUG(_log, "%u constants:", pTable->noConstants);
-    coe_productOfConst_t constant = 0x01;
-    for(u=0; u<pTable->noConstants; ++u, constant<<=1)
+    for(u=0; u<pTable->noConstants; ++u)
     {
         const pci_device_t * const pDev = tbv_getDeviceByBitIndex(pTable, u);
 
@@ -745,13 +846,31 @@ void tbv_logTableOfVariables(const tbv_tableOfVariables_t * const pTable)
 #else
 # define F64X    "%llx"
 #endif
-        LOG_DEBUG( _log
-                 , "  %u) %s, %s, internal representation: 0x" F64X
-                 , u
-                 , pDev->name
-                 , pci_getNameOfDeviceType(pDev)
-                 , (long long unsigned)constant
-                 );
+        /* The internal representation is shown as the set bit of the word of the product
+           of constants, which holds the constant. */
+        const coe_productOfConstWord_t constant =
+                            (coe_productOfConstWord_t)0x01 << (u%COE_NO_CONST_PER_WORD);
+        if(u < COE_NO_CONST_PER_WORD)
+        {
+            LOG_DEBUG( _log
+                     , "  %u) %s, %s, internal representation: 0x" F64X
+                     , u
+                     , pDev->name
+                     , pci_getNameOfDeviceType(pDev)
+                     , (long long unsigned)constant
+                     );
+        }
+        else
+        {
+            LOG_DEBUG( _log
+                     , "  %u) %s, %s, internal representation: 0x" F64X " in word %u"
+                     , u
+                     , pDev->name
+                     , pci_getNameOfDeviceType(pDev)
+                     , (long long unsigned)constant
+                     , u/(unsigned)COE_NO_CONST_PER_WORD
+                     );
+        }
 #undef F64X
     }
 } /* End of tbv_logTableOfVariables */
@@ -804,6 +923,7 @@ boolean tbv_addKnown( tbv_tableOfVariables_t * const pTable
     {
         unsigned int idx = pTable->noKnowns++;
         pTable->knownLookUpAry[idx].name = stralloccpy(name);
+        enterName(pTable, name, pTable->pCircuitNetList->noDevices + idx);
 
         /* Use next index value for the column of the LES. */
         if(idx == 0)
@@ -902,6 +1022,10 @@ boolean tbv_addUnknown( tbv_tableOfVariables_t * const pTable
     {
         unsigned int idx = pTable->noUnknowns++;
         pTable->unknownLookUpAry[idx].name = stralloccpy(name);
+        enterName( pTable
+                 , name
+                 , pTable->pCircuitNetList->noDevices + pTable->maxNoKnowns + idx
+                 );
 
         assert(idxNode == PCI_NULL_NODE  ||  idxNode < pTable->pCircuitNetList->noNodes);
         pTable->unknownLookUpAry[idx].idxNode = idxNode;
@@ -1029,6 +1153,82 @@ void tbv_sortConstants(tbv_tableOfVariables_t * const pTable)
 
 
 
+/**
+ * Get the numeric value of a device constant for numeric evaluation of the results, like
+ * the Octave scripts or the built-in computation of frequency responses do. This is the
+ * value specified in the circuit file or a static default value if the circuit file
+ * doesn't specify one.
+ *   @return
+ * Get the value. It is not negative.
+ *   @param pDevice
+ * The device, which the constant belongs to. It must not be related to another device and
+ * it must have a constant, i.e. it must not be a constant source, an op-amp or a current
+ * probe.
+ *   @param pIsDefaultValue
+ * \a true is returned in * \a pIsDefaultValue if the circuit file doesn't specify the
+ * value and the default value is returned, \a false otherwise.
+ */
+
+double tbv_getValueOfDevice( const pci_device_t * const pDevice
+                           , boolean * const pIsDefaultValue
+                           )
+{
+    assert(pDevice->devRelation.idxDeviceRef == PCI_NULL_DEVICE);
+
+    double value = pDevice->numValue;
+    *pIsDefaultValue = value < 0.0;
+    if(*pIsDefaultValue)
+    {
+        /* No numeric value has been specified. We take a static default value. */
+        switch(pDevice->type)
+        {
+            /* The hardcoded default values are taken such that the typical
+               time constants RC, sqrt(LC) and L/R are all in the NF range, at
+               1ms. */
+            case pci_devType_resistor: value = 100.0; break;
+            case pci_devType_conductance: value = 1.0/100.0; break;
+            case pci_devType_inductivity: value = 1e-3; break;
+            case pci_devType_capacitor: value = 10e-6; break;
+
+            /** @todo Find reasonable default values for controlled voltage
+                sources. What are typical use cases? */
+            case pci_devType_srcUByU:
+            case pci_devType_srcUByI: value = 1.0; break;
+
+            /* The hard coded default value considers the typical use case of
+               modelling a unipolar transistor, which has a drain-source
+               current modulation of a few milliamperes for a gate-source
+               voltage modulation of a few volts. (A n-channel JFET requires a
+               negative sign, which needs to be considered by the definition of
+               the polarity of the control voltage of the source.) */
+            case pci_devType_srcIByU: value = 0.005; break;
+
+            /* The hard coded default value considers the typical use case of
+               modelling a bipolar transistor, which has a current
+               amplification of a few hundred. */
+            case pci_devType_srcIByI: value = 250.0; break;
+
+            /* No result relevant value needed for knowns. */
+            case pci_devType_srcI:
+            case pci_devType_srcU:
+
+            /* No value is defined for (ideal) op-amps. */
+            case pci_devType_opAmp:
+
+            /* No value is defined for current probes. */
+            case pci_devType_currentProbe:
+
+            default: assert(false);
+        }
+    }
+
+    return value;
+
+} /* End of tbv_getValueOfDevice */
+
+
+
+
 /**
  * Write the elements that are relevant to the executable Octave code into an M script. As
  * a matter of fact, these are only the values of the device constants. To have executable
@@ -1059,7 +1259,7 @@ void tbv_exportAsMCode( const tbv_tableOfVariables_t * const pTable
     const char * const nameOfParameterStruct = "deviceConstants";
 
     /* Write into the stream associated with the M script object. */
-    FILE *hMFile = msc_borrowStream(pMScript);
+    ost_outputStream_t * const pStream = msc_borrowStream(pMScript);
 
     const char *titleFmtStr;
     switch(context)
@@ -1080,12 +1280,12 @@ void tbv_exportAsMCode( const tbv_tableOfVariables_t * const pTable
                       " result %s.\n";
         break;
     }
-    fprintf(hMFile, titleFmtStr, indentStr, nameOfParameterStruct);
+    ost_printf(pStream, titleFmtStr, indentStr, nameOfParameterStruct);
 
     /* Result initialization is needed only in one context: Create an empty struct prior to
        separate assignments of members. */
     if(context == tbv_copyToParameterStruct)
-        fprintf(hMFile, "%s%s  \t= struct;\n", indentStr, nameOfParameterStruct);
+        ost_printf(pStream, "%s%s  \t= struct;\n", indentStr, nameOfParameterStruct);
 
     /* Write a simple assignment for each constant a numeric value is specified for. The
        inverse iteration through the table is used to get the common order of appearance of
@@ -1128,52 +1328,10 @@ void tbv_exportAsMCode( const tbv_tableOfVariables_t * const pTable
         {
         case tbv_assignDefaultValues:
         {
-            double value = pDev->numValue;
-            if(value < 0)
+            boolean isDefaultValue;
+            const double value = tbv_getValueOfDevice(pDev, &isDefaultValue);
+            if(isDefaultValue)
             {
-                /* No numeric value has been specified. We take a static default value. */
-                assert(pDev->devRelation.idxDeviceRef == PCI_NULL_DEVICE);
-                switch(pDev->type)
-                {
-                    /* The hardcoded default values are taken such that the typical
-                       time constants RC, sqrt(LC) and L/R are all in the NF range, at
-                       1ms. */
-                    case pci_devType_resistor: value = 100.0; break;
-                    case pci_devType_conductance: value = 1.0/100.0; break;
-                    case pci_devType_inductivity: value = 1e-3; break;
-                    case pci_devType_capacitor: value = 10e-6; break;
-
-                    /** @todo Find reasonable default values for controlled voltage
-                        sources. What are typical use cases? */
-                    case pci_devType_srcUByU:
-                    case pci_devType_srcUByI: value = 1.0; break;
-
-                    /* The hard coded default value considers the typical use case of
-                       modelling a unipolar transistor, which has a drain-source
-                       current modulation of a few milliamperes for a gate-source
-                       voltage modulation of a few volts. (A n-channel JFET requires a
-                       negative sign, which needs to be considered by the definition of
-                       the polarity of the control voltage of the source.) */
-                    case pci_devType_srcIByU: value = 0.005; break;
-
-                    /* The hard coded default value considers the typical use case of
-                       modelling a bipolar transistor, which has a current
-                       amplification of a few hundred. */
-                    case pci_devType_srcIByI: value = 250.0; break;
-
-                    /* No result relevant value needed for knowns. */
-                    case pci_devType_srcI:
-                    case pci_devType_srcU:
-
-                    /* No value is defined for (ideal) op-amps. */
-                    case pci_devType_opAmp:
-
-                    /* No value is defined for current probes. */
-                    case pci_devType_currentProbe:
-
-                    default: assert(false);
-                }
-
                 LOG_INFO( _log
                         , "Device constant %s is assigned the default value %g"
                         , pDev->name
@@ -1190,38 +1348,38 @@ void tbv_exportAsMCode( const tbv_tableOfVariables_t * const pTable
                           " Please check your circuit file"
                         , pDev->name
                         )
-                fprintf( hMFile
-                       , "%swarning('The device constant %s has the suspicious value"
-                         " null. Please check your circuit file')\n"
-                       , indentStr
-                       , pDev->name
-                       );
+                ost_printf( pStream
+                          , "%swarning('The device constant %s has the suspicious value"
+                            " null. Please check your circuit file')\n"
+                          , indentStr
+                          , pDev->name
+                          );
             }
-            fprintf(hMFile, "%s%s\t= %.6g;\n", indentStr, pDev->name, value);
+            ost_printf(pStream, "%s%s\t= %.6g;\n", indentStr, pDev->name, value);
         }
         break;
 
         case tbv_assignParameterStruct:
         {
-            fprintf( hMFile
-                   , "%s%s\t= %s.%s;\n"
-                   , indentStr
-                   , pDev->name
-                   , nameOfParameterStruct
-                   , pDev->name
-                   );
+            ost_printf( pStream
+                      , "%s%s\t= %s.%s;\n"
+                      , indentStr
+                      , pDev->name
+                      , nameOfParameterStruct
+                      , pDev->name
+                      );
         }
         break;
 
         case tbv_copyToParameterStruct:
         {
-            fprintf( hMFile
-                   , "%s%s.%s\t= %s;\n"
-                   , indentStr
-                   , nameOfParameterStruct
-                   , pDev->name
-                   , pDev->name
-                   );
+            ost_printf( pStream
+                      , "%s%s.%s\t= %s;\n"
+                      , indentStr
+                      , nameOfParameterStruct
+                      , pDev->name
+                      , pDev->name
+                      );
         }
         break;
 
@@ -1343,7 +1501,8 @@ const tbv_unknownVariable_t *tbv_getUnknownByDevice
  * index of the device the constant belongs to.
  *   @return
  * The internal representation of the constant is returned. It's a bit vector with a single
- * set bit; this bit represents the constant.
+ * set bit; this bit represents the constant. The bit vector may have more than one word;
+ * the set bit can be found in any of them.
  *   @param pTable
  * The reference to the filled table of symbolic objects is passed.
  *   @param idxDevice
@@ -1361,14 +1520,8 @@ coe_productOfConst_t tbv_getConstantByDevice( const tbv_tableOfVariables_t * con
            &&  pTable->devIdxToConstantIdxAry[idxDevice] < pTable->noConstants
           );
 
-    /* Dynamically shape the required bit pattern by repeated shift. */
-    coe_productOfConst_t constant = 0x01;
-    unsigned int idxBit;
-    for(idxBit=pTable->devIdxToConstantIdxAry[idxDevice]; idxBit>0; --idxBit)
-        constant <<= 1;
-
-    assert(constant != 0);
-    return constant;
+    /* The index of the constant is the index of the set bit. */
+    return coe_getProductOfSingleConst(pTable->devIdxToConstantIdxAry[idxDevice]);
 
 } /* End of tbv_getConstantByDevice */
 
@@ -1383,13 +1536,15 @@ coe_productOfConst_t tbv_getConstantByDevice( const tbv_tableOfVariables_t * con
  * The reference to the filled table of symbolic objects is passed.
  *   @param idxBit
  * A device is represented by a "productOfConst" where one and only one bit is set. The
- * index of the set bit is passed as key for the lookup operation.
+ * index of the set bit is passed as key for the lookup operation. The index is counted
+ * across all words of the product of constants.
  */
 
 const pci_device_t *tbv_getDeviceByBitIndex( const tbv_tableOfVariables_t * const pTable
                                            , unsigned int idxBit
                                            )
 {
+    assert(idxBit < pTable->noConstants  &&  idxBit < COE_MAX_NO_CONST);
     const unsigned int idxDev = pTable->constantIdxToDevIdxAry[idxBit];
     assert(idxDev < pTable->pCircuitNetList->noDevices);
     return pTable->pCircuitNetList->pDeviceAry[idxDev];
@@ -1518,7 +1673,8 @@ boolean tbv_getReferencedDeviceByBitIndex( const tbv_tableOfVariables_t * const
 
 /**
  * Select a specific unknown for result computation.\n
- *   Currently, the solver is not capable to find a solution for all unknowns at once. It
+ *   The original solver, which is still used as fallback and for cross-checking in the
+ * DEBUG compilation, is not capable to find a solution for all unknowns at once. It
  * returns a fully eliminated solution only for the very unknown, whose coefficients are
  * placed in the rightmost LHS column m of the LES. By simply exchanging two columns of the
  * (later) LES on user demand, we can achieve that any unknown is represented in column
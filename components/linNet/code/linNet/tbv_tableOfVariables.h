@@ -146,6 +146,17 @@ typedef struct tbv_tableOfVariables_t
     unsigned int *devIdxToConstantIdxAry;
 
 
+    /** The number of slots of the hash table \a idxNameByHashAry. A power of two. */
+    unsigned int noNameHashSlots;
+
+    /** A hash table with open addressing of the names of all devices, knowns and unknowns.
+        It speeds up the check of new knowns and unknowns for ambiguous names. A slot holds
+        the index of a device in the net list; indexes of knowns are offset by the number
+        of devices and indexes of unknowns are additionally offset by \a maxNoKnowns.
+        UINT_MAX marks an unused slot. */
+    unsigned int *idxNameByHashAry;
+
+
     /** The entries of the different tables refer to the net list representing the circuit,
         which holds details about nodes and interconnected devices. Here is a copy (by
         reference) to the related net list. */
@@ -220,6 +231,11 @@ void tbv_addConstant( tbv_tableOfVariables_t * const pTable, unsigned int idxDev
 /** Sort constants to get the common order R before L before C. */
 void tbv_sortConstants(tbv_tableOfVariables_t * const pTable);
 
+/** Get the numeric value of a device constant, either the specified or a default value. */
+double tbv_getValueOfDevice( const pci_device_t * const pDevice
+                           , boolean * const pIsDefaultValue
+                           );
+
 /** Write the elements that are relevant to the executable Octave code into an M script. */
 void tbv_exportAsMCode( const tbv_tableOfVariables_t * const pTable
                       , msc_mScript_t * const pMScript
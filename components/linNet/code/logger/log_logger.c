@@ -1,6 +1,11 @@
 /**
  * @file log_logger.c
- *   A simple logging class to write formatted status messages to stdout and into a file.
+ *   A simple logging class to write formatted status messages to stdout and into a file.\n
+ *   The messages are normally written by the calling thread. Optionally, the module
+ * operates asynchronously: Each thread formats its messages into its own ring buffer, which
+ * is lock-free for the thread, and a background writer thread takes the messages from all
+ * ring buffers and writes them into the log files and to the console. The order of the
+ * messages of a single thread is retained.
  *
  * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -20,6 +25,7 @@
 /* Module interface
  *   log_initModule
  *   log_shutdownModule
+ *   log_setAsynchronousMode
  *   log_createLogger
  *   log_cloneByReference
  *   log_deleteLogger
@@ -31,10 +37,18 @@
  *   log_getLengthOfLineHeader
  *   log_close
  *   log_getStreams
+ *   log_releaseStreams
  *   log_flush
  *   log_log
  *   log_logLine
  * Local functions
+ *   writeEntry
+ *   drainRingBuffers
+ *   writerThread
+ *   releaseRingBuffer
+ *   getRingBuffer
+ *   enqueueEntry
+ *   getTimeStamp
  *   logInternal
  */
 
@@ -42,12 +56,19 @@
  * Include files
  */
 
+/* The reentrant function ctime_r and clock_gettime are POSIX extensions of the C
+   library. */
+#ifdef __unix__
+# define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdarg.h>
 #include <string.h>
 #include <time.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "types.h"
 #include "smalloc.h"
@@ -60,11 +81,83 @@
  * Defines
  */
 
+/** The size of a ring buffer in units of entryHeader_t. Needs to be a power of two. An
+    entry, which requires more than half of the buffer, is written synchronously. */
+#define NO_UNITS_OF_RING_BUFFER     4096
+
+/** The number of units of entryHeader_t, which an entry of \a length characters occupies
+    in a ring buffer. */
+#define NO_UNITS_OF_ENTRY(length)                                                           \
+            (1 + ((length) + sizeof(entryHeader_t) - 1) / sizeof(entryHeader_t))
+
+/** The length of an entry, which marks the unused remainder of a ring buffer. */
+#define LENGTH_OF_WRAP_ENTRY        SIZE_MAX
+
+/** The writer thread looks for new entries with this period in ms. */
+#define WRITER_PERIOD_IN_MS         10
+
+/** The assumed size of a cache line in Byte. The read and write index of a ring buffer are
+    separated by this distance in order to avoid false sharing. */
+#define SIZE_OF_CACHE_LINE          64
+
+/** The size of the buffer on the stack, which a log entry is normally formatted in. */
+#define SIZE_OF_LINE_BUFFER         512
+
+/** The length of the time stamp of the long line header, "Mmm dd hh:mm:ss yyyy - ". */
+#define LENGTH_OF_TIME_STAMP        23
+
 
 /*
  * Local type definitions
  */
 
+/** The header of an entry of a ring buffer. The formatted text of the entry immediately
+    follows the header. */
+typedef struct entryHeader_t
+{
+    /** The logger, which writes the entry. */
+    log_logger_t *hLogger;
+
+    /** The number of characters of the entry or #LENGTH_OF_WRAP_ENTRY. */
+    size_t length;
+
+    /** The entry is written to the console also. The logger's flag is sampled when the
+        entry is created. */
+    boolean echoToConsole;
+
+} entryHeader_t;
+
+
+/** The ring buffer of a thread in asynchronous mode. It is filled by a single thread and
+    emptied by the writer thread or by any thread, which holds the mutex of the writer. No
+    lock is required for putting an entry into the buffer. */
+typedef struct ringBuffer_t
+{
+    /** All ring buffers are linked in a list, which is protected by the mutex of the
+        writer. */
+    struct ringBuffer_t *pNext;
+
+    /** The buffer is owned by a thread. A buffer is released when its thread terminates
+        and it is reused by the next new thread. */
+    boolean isOwned;
+
+    /** The number of units, which have been put into the buffer so far. Changed by the
+        owner only. The counter wraps around. It is published with release semantics and
+        read by other threads with acquire semantics, see __atomic_store_n. */
+    unsigned int idxWrite;
+
+    /** Fill bytes, which keep the indexes apart. */
+    char padding[SIZE_OF_CACHE_LINE];
+
+    /** The number of units, which have been taken from the buffer so far. Changed by the
+        holder of the mutex of the writer only. Accessed atomically like \a idxWrite. */
+    unsigned int idxRead;
+
+    /** The storage of the entries. */
+    entryHeader_t unitAry[NO_UNITS_OF_RING_BUFFER];
+
+} ringBuffer_t;
+
 
 /*
  * Local prototypes
@@ -75,8 +168,51 @@
  * Data definitions
  */
 
+/** The module operates in asynchronous mode. */
+static boolean _isAsynchronous = false;
+
+/** The mutex of the writer. It protects the list of ring buffers and it serializes all
+    threads, which take entries from the ring buffers. */
+static pthread_mutex_t _mutexWriter = PTHREAD_MUTEX_INITIALIZER;
+
+/** The writer thread waits for this condition; it is signalled on termination of the
+    writer or if a ring buffer becomes more than half full. */
+static pthread_cond_t _condWriter = PTHREAD_COND_INITIALIZER;
+
+/** The handle of the writer thread. */
+static pthread_t _writerThread;
+
+/** The writer thread is requested to terminate. */
+static boolean _terminateWriter = false;
+
+/** The list of all ring buffers. */
+static ringBuffer_t *_pRingBufferList = NULL;
+
+/** The key of the thread-specific data, which releases the ring buffer of a terminating
+    thread. */
+static pthread_key_t _keyRingBuffer;
+
+/** The key \a _keyRingBuffer has been created. */
+static boolean _isKeyRingBufferCreated = false;
+
+/** The ring buffer of the calling thread or NULL if it didn't log asynchronously yet. */
+static THREAD_LOCAL ringBuffer_t *_pOwnRingBuffer = NULL;
+
+/** The calling thread writes directly into the streams, see log_getStreams. Its entries
+    are written synchronously until it calls log_releaseStreams in order to keep them in
+    order with the direct output. */
+static THREAD_LOCAL boolean _isUsingStreams = false;
+
+/** The time, which the cached time stamp of the long line header has been formatted for. */
+static THREAD_LOCAL time_t _timeOfTimeStamp = (time_t)-1;
+
+/** The cached time stamp of the long line header. */
+static THREAD_LOCAL char _timeStamp[LENGTH_OF_TIME_STAMP+1];
+
 #ifdef DEBUG
-/** A global counter of all refernces to any created objects. Used to detect memory leaks. */
+/** A global counter of all refernces to any created objects. Used to detect memory leaks.
+      @remark The loggers of different threads are created and deleted concurrently. The
+    counter is shared by all of them and it is changed only by atomic operations. */
 static unsigned int _noRefsToObjects = 0;
 #endif
 
@@ -86,6 +222,164 @@ static unsigned int _noRefsToObjects = 0;
  */
 
 
+/**
+ * Write a formatted log entry into the log file and maybe to stdout also.
+ *   @return
+ * \a true if all output succeeded, \a false if a stdio function returned an error.
+ *   @param hObj
+ * The handle to the logger object, which the entry belongs to.
+ *   @param echoToConsole
+ * If \a true then the entry is written to stdout also.
+ *   @param text
+ * The formatted entry, including line header and a possible newline character. Doesn't
+ * need to be terminated by a null character.
+ *   @param length
+ * The number of characters of \a text.
+ */
+
+static boolean writeEntry( log_logger_t * const hObj
+                         , boolean echoToConsole
+                         , const char * const text
+                         , size_t length
+                         )
+{
+    boolean success = true;
+    if(echoToConsole  &&  fwrite(text, /* size */ 1, length, stdout) != length)
+        success = false;
+
+    hObj->lastFileSystemErr = 0;
+    if(hObj->pLogFile != NULL
+       &&  fwrite(text, /* size */ 1, length, hObj->pLogFile) != length
+      )
+    {
+        hObj->lastFileSystemErr = ferror(hObj->pLogFile);
+        success = false;
+    }
+
+    return success;
+
+} /* End of writeEntry */
+
+
+
+
+/**
+ * Take all pending entries from all ring buffers and write them. The calling thread needs
+ * to hold the mutex of the writer.
+ *   @return
+ * \a true if at least one entry has been written to stdout.
+ */
+
+static boolean drainRingBuffers(void)
+{
+    boolean echoed = false;
+    ringBuffer_t *pRing;
+    for(pRing=_pRingBufferList; pRing!=NULL; pRing=pRing->pNext)
+    {
+        /* Acquiring the index ensures that the entries are read only after their
+           index. The read index is changed only by us, the holder of the mutex. */
+        const unsigned int idxEnd = __atomic_load_n(&pRing->idxWrite, __ATOMIC_ACQUIRE);
+        unsigned int idxRead = __atomic_load_n(&pRing->idxRead, __ATOMIC_RELAXED);
+        while(idxRead != idxEnd)
+        {
+            const unsigned int idxUnit = idxRead % NO_UNITS_OF_RING_BUFFER;
+            const entryHeader_t * const pEntry = &pRing->unitAry[idxUnit];
+            if(pEntry->length == LENGTH_OF_WRAP_ENTRY)
+            {
+                /* The remainder of the buffer is unused; the next entry is at its begin. */
+                idxRead += NO_UNITS_OF_RING_BUFFER - idxUnit;
+            }
+            else
+            {
+                writeEntry( pEntry->hLogger
+                          , pEntry->echoToConsole
+                          , (const char*)(pEntry+1)
+                          , pEntry->length
+                          );
+                if(pEntry->echoToConsole)
+                    echoed = true;
+                idxRead += NO_UNITS_OF_ENTRY(pEntry->length);
+            }
+        }
+
+        /* Releasing the index ensures that the entries have been read before their
+           units are reused by the owner of the buffer. */
+        __atomic_store_n(&pRing->idxRead, idxRead, __ATOMIC_RELEASE);
+    }
+
+    return echoed;
+
+} /* End of drainRingBuffers */
+
+
+
+
+/**
+ * The main function of the writer thread in asynchronous mode. The thread periodically
+ * takes the pending entries from all ring buffers and writes them, until it is requested
+ * to terminate.
+ *   @return
+ * The function always returns NULL.
+ *   @param pArg
+ * Unused.
+ */
+
+static void *writerThread(void *pArg)
+{
+    (void)pArg;
+
+    pthread_mutex_lock(&_mutexWriter);
+    while(!_terminateWriter)
+    {
+        /* Console output is flushed in order to let the user see it without delay. The log
+           files are flushed only on demand, like in synchronous mode. */
+        if(drainRingBuffers())
+            fflush(stdout);
+
+        struct timespec tWakeUp;
+        clock_gettime(CLOCK_REALTIME, &tWakeUp);
+
+        /* The nanoseconds are added in unsigned arithmetics; the signed comparison of a
+           sum with a constant would be rewritten by the compiler under the assumption
+           that signed overflow doesn't occur. */
+        unsigned long tNs = (unsigned long)tWakeUp.tv_nsec
+                            + WRITER_PERIOD_IN_MS * 1000000ul;
+        if(tNs >= 1000000000ul)
+        {
+            tNs -= 1000000000ul;
+            ++ tWakeUp.tv_sec;
+        }
+        tWakeUp.tv_nsec = (long)tNs;
+        pthread_cond_timedwait(&_condWriter, &_mutexWriter, &tWakeUp);
+    }
+    pthread_mutex_unlock(&_mutexWriter);
+
+    return NULL;
+
+} /* End of writerThread */
+
+
+
+
+/**
+ * Release the ring buffer of a terminating thread. This is the destructor of the
+ * thread-specific data of key \a _keyRingBuffer. The pending entries of the buffer are
+ * still written and the buffer is reused by the next thread, which logs asynchronously.
+ *   @param pRingBuffer
+ * The ring buffer of the terminating thread.
+ */
+
+static void releaseRingBuffer(void *pRingBuffer)
+{
+    pthread_mutex_lock(&_mutexWriter);
+    ((ringBuffer_t*)pRingBuffer)->isOwned = false;
+    pthread_mutex_unlock(&_mutexWriter);
+
+} /* End of releaseRingBuffer */
+
+
+
+
 /**
  * Initialize the module at application startup.
  *   @remark
@@ -100,6 +394,9 @@ void log_initModule()
     _noRefsToObjects = 0;
 #endif
 
+    /* The module is initialized in synchronous mode. */
+    assert(!_isAsynchronous);
+
 #ifdef  DEBUG
     /* Check if patch of snprintf is either not required or properly installed. */
     char buf[3] = {[2] = '\0'};
@@ -118,6 +415,21 @@ void log_initModule()
 
 void log_shutdownModule()
 {
+    /* The writer thread writes all pending entries before it terminates. */
+    log_setAsynchronousMode(/* isAsynchronous */ false);
+    while(_pRingBufferList != NULL)
+    {
+        ringBuffer_t * const pRing = _pRingBufferList;
+        _pRingBufferList = pRing->pNext;
+        free(pRing);
+    }
+    _pOwnRingBuffer = NULL;
+    if(_isKeyRingBufferCreated)
+    {
+        pthread_key_delete(_keyRingBuffer);
+        _isKeyRingBufferCreated = false;
+    }
+
 #ifdef  DEBUG
     /* The DEBUG compilation looks for still allocated objects in order to detect memory
        leaks. */
@@ -136,6 +448,69 @@ void log_shutdownModule()
 
 
 
+/**
+ * Switch the module between synchronous and asynchronous mode. In synchronous mode, each
+ * log entry is written by the calling thread. In asynchronous mode, the calling thread
+ * only formats the entry and puts it into its own ring buffer; a background writer thread
+ * writes the entries into the log files and to the console. This decouples the threads,
+ * which log, from the speed of the output streams and from one another.\n
+ *   Entries of fatal errors, the calls of log_flush and log_getStreams and the closing of
+ * a logger wait for all pending entries to be written, so that the log is complete and
+ * correctly ordered if the application aborts or writes directly to the streams.
+ *   @return
+ * \a true if the mode has been set. \a false if the writer thread can't be started; the
+ * module stays in synchronous mode in this case.
+ *   @param isAsynchronous
+ * \a true to switch to asynchronous mode, \a false to switch back to synchronous mode.
+ * Switching back writes all pending entries.
+ *   @remark
+ * The mode must be changed only when no other thread uses any logger.
+ */
+
+boolean log_setAsynchronousMode(boolean isAsynchronous)
+{
+    if(isAsynchronous == _isAsynchronous)
+        return true;
+
+    if(isAsynchronous)
+    {
+        if(!_isKeyRingBufferCreated)
+        {
+            if(pthread_key_create(&_keyRingBuffer, releaseRingBuffer) != 0)
+                return false;
+            _isKeyRingBufferCreated = true;
+        }
+
+        _terminateWriter = false;
+        if(pthread_create(&_writerThread, /* attr */ NULL, writerThread, /* pArg */ NULL)
+           != 0
+          )
+        {
+            return false;
+        }
+        _isAsynchronous = true;
+    }
+    else
+    {
+        pthread_mutex_lock(&_mutexWriter);
+        _terminateWriter = true;
+        pthread_cond_signal(&_condWriter);
+        pthread_mutex_unlock(&_mutexWriter);
+        pthread_join(_writerThread, /* pRetVal */ NULL);
+
+        /* The writer may have terminated before it saw the latest entries. */
+        drainRingBuffers();
+        fflush(stdout);
+        _isAsynchronous = false;
+    }
+
+    return true;
+
+} /* End of log_setAsynchronousMode */
+
+
+
+
 /**
  * Create a file logger.
  *   @return
@@ -184,7 +559,7 @@ boolean log_createLogger( log_hLogger_t * const phNewLogger
         pNewLogger->pLogFile = NULL;
 
 #ifdef DEBUG
-    ++ _noRefsToObjects;
+    __sync_add_and_fetch(&_noRefsToObjects, 1);
 #endif
 
     *phNewLogger = pNewLogger;
@@ -218,7 +593,7 @@ log_hLogger_t log_cloneByReference(log_hLogger_t hObj)
         ++ hObj->noReferencesToThis;
 
 #ifdef DEBUG
-        ++ _noRefsToObjects;
+        __sync_add_and_fetch(&_noRefsToObjects, 1);
 #endif
     }
 
@@ -252,7 +627,7 @@ void log_deleteLogger(log_hLogger_t hObj)
     }
 
 #ifdef DEBUG
-    -- _noRefsToObjects;
+    __sync_sub_and_fetch(&_noRefsToObjects, 1);
 #endif
 } /* End of log_deleteLogger */
 
@@ -437,10 +812,19 @@ unsigned int log_getLengthOfLineHeader(log_logger_t * const hObj)
  * memory is done by the caller afterwards.)
  *   @param hObj
  * The handle to the logger object to operate on.
+ *   @remark
+ * In asynchronous mode, all pending entries are written before the file is closed.
  */
 
 boolean log_close(log_logger_t * const hObj)
 {
+    const boolean isAsynchronous = _isAsynchronous;
+    if(isAsynchronous)
+    {
+        pthread_mutex_lock(&_mutexWriter);
+        drainRingBuffers();
+    }
+
     if(hObj->pLogFile != NULL)
     {
         hObj->lastFileSystemErr = fclose(hObj->pLogFile);
@@ -449,6 +833,9 @@ boolean log_close(log_logger_t * const hObj)
     else
         hObj->lastFileSystemErr = 0;
 
+    if(isAsynchronous)
+        pthread_mutex_unlock(&_mutexWriter);
+
     return hObj->lastFileSystemErr == 0;
 
 } /* End of log_close */
@@ -461,7 +848,10 @@ boolean log_close(log_logger_t * const hObj)
  * reurns the handles of up to two streams: the opened log file and/or the console output.
  * The calling function may use the C stdio functions to write into these streams.\n
  *   The usage of the streams needs to be finished before the class' own output operations
- * are again used (see ).
+ * are again used (see ).\n
+ *   In asynchronous mode, all pending entries are written first. The subsequent entries of
+ * the calling thread are written synchronously, in order with the direct output, until
+ * the streams are released.
  *   @param hObj
  * The handle to the logger object to operate on.
  *   @param phConsole
@@ -474,6 +864,7 @@ boolean log_close(log_logger_t * const hObj)
  * char * const, ...)
  *   @see unsigned int log_logLine(log_logger_t * const, log_logLevel_t, const char *
  * const, ...)
+ *   @see void log_releaseStreams(log_logger_t * const)
  */
 
 void log_getStreams( log_logger_t * const hObj
@@ -482,6 +873,7 @@ void log_getStreams( log_logger_t * const hObj
                    )
 {
     log_flush(hObj);
+    _isUsingStreams = _isAsynchronous;
 
     if(phConsole != NULL)
     {
@@ -504,13 +896,38 @@ void log_getStreams( log_logger_t * const hObj
 
 
 /**
- * Flush contents of log file buffers.
+ * Finish the direct usage of the streams, which had been got from log_getStreams. The
+ * streams are flushed.
+ *   @param hObj
+ * The handle to the logger object to operate on.
+ */
+
+void log_releaseStreams(log_logger_t * const hObj)
+{
+    _isUsingStreams = false;
+    log_flush(hObj);
+
+} /* End of log_releaseStreams */
+
+
+
+
+/**
+ * Flush contents of log file buffers. In asynchronous mode, all pending entries are
+ * written first.
  *   @param hObj
  * The handle to the logger object to operate on.
  */
 
 void log_flush(log_logger_t * const hObj)
 {
+    if(_isAsynchronous)
+    {
+        pthread_mutex_lock(&_mutexWriter);
+        drainRingBuffers();
+        pthread_mutex_unlock(&_mutexWriter);
+    }
+
     if(hObj->echoToConsole)
         fflush(stdout);
     if(hObj->pLogFile != NULL)
@@ -524,15 +941,172 @@ void log_flush(log_logger_t * const hObj)
 
 
 
+/**
+ * Get the ring buffer of the calling thread. A buffer is assigned to the thread on first
+ * use, either a buffer released by a terminated thread or a new one.
+ *   @return
+ * The ring buffer of the calling thread.
+ */
+
+static ringBuffer_t *getRingBuffer(void)
+{
+    if(_pOwnRingBuffer == NULL)
+    {
+        pthread_mutex_lock(&_mutexWriter);
+        ringBuffer_t *pRing = _pRingBufferList;
+        while(pRing != NULL  &&  pRing->isOwned)
+            pRing = pRing->pNext;
+        if(pRing == NULL)
+        {
+            pRing = smalloc(sizeof(ringBuffer_t), __FILE__, __LINE__);
+            pRing->idxWrite = 0;
+            pRing->idxRead = 0;
+            pRing->pNext = _pRingBufferList;
+            _pRingBufferList = pRing;
+        }
+        pRing->isOwned = true;
+        pthread_mutex_unlock(&_mutexWriter);
+
+        pthread_setspecific(_keyRingBuffer, pRing);
+        _pOwnRingBuffer = pRing;
+    }
+
+    return _pOwnRingBuffer;
+
+} /* End of getRingBuffer */
+
+
+
+
+/**
+ * Put a formatted log entry into the ring buffer of the calling thread. If the buffer is
+ * full then the calling thread doesn't wait for the writer thread but writes the pending
+ * entries itself. An entry, which is too long for the buffer, and all entries of a thread,
+ * which currently writes directly into the streams, are written immediately.
+ *   @param hObj
+ * The handle to the logger object, which the entry belongs to.
+ *   @param text
+ * The formatted entry, including line header and a possible newline character.
+ *   @param length
+ * The number of characters of \a text.
+ */
+
+static void enqueueEntry(log_logger_t * const hObj, const char * const text, size_t length)
+{
+    ringBuffer_t * const pRing = getRingBuffer();
+
+    const unsigned int noUnits = NO_UNITS_OF_ENTRY(length);
+    if(noUnits > NO_UNITS_OF_RING_BUFFER/2  ||  _isUsingStreams)
+    {
+        /* The pending entries are written first in order to retain the order of entries. */
+        pthread_mutex_lock(&_mutexWriter);
+        drainRingBuffers();
+        writeEntry(hObj, hObj->echoToConsole, text, length);
+        pthread_mutex_unlock(&_mutexWriter);
+        return;
+    }
+
+    /* An entry is not wrapped around the end of the buffer; the remainder of the buffer
+       is skipped if the entry doesn't fit. */
+    /* The write index is changed only by us. Acquiring the read index ensures that the
+       released units are overwritten only after the writer has read them. */
+    unsigned int idxWrite = __atomic_load_n(&pRing->idxWrite, __ATOMIC_RELAXED)
+               , idxUnit = idxWrite % NO_UNITS_OF_RING_BUFFER
+               , noUnitsRequired = noUnits;
+    if(idxUnit + noUnits > NO_UNITS_OF_RING_BUFFER)
+        noUnitsRequired += NO_UNITS_OF_RING_BUFFER - idxUnit;
+    if(idxWrite - __atomic_load_n(&pRing->idxRead, __ATOMIC_ACQUIRE) + noUnitsRequired
+       > NO_UNITS_OF_RING_BUFFER
+      )
+    {
+        pthread_mutex_lock(&_mutexWriter);
+        drainRingBuffers();
+        pthread_mutex_unlock(&_mutexWriter);
+        assert(__atomic_load_n(&pRing->idxRead, __ATOMIC_RELAXED) == idxWrite);
+    }
+
+    if(idxUnit + noUnits > NO_UNITS_OF_RING_BUFFER)
+    {
+        pRing->unitAry[idxUnit].length = LENGTH_OF_WRAP_ENTRY;
+        idxWrite += NO_UNITS_OF_RING_BUFFER - idxUnit;
+        idxUnit = 0;
+    }
+    entryHeader_t * const pEntry = &pRing->unitAry[idxUnit];
+    pEntry->hLogger = hObj;
+    pEntry->length = length;
+    pEntry->echoToConsole = hObj->echoToConsole;
+    memcpy((char*)(pEntry+1), text, length);
+
+    /* Releasing the index ensures that the entry is complete before it is published. */
+    idxWrite += noUnits;
+    __atomic_store_n(&pRing->idxWrite, idxWrite, __ATOMIC_RELEASE);
+
+    /* Don't wait for the next period of the writer if the buffer is filling up. */
+    if(idxWrite - __atomic_load_n(&pRing->idxRead, __ATOMIC_RELAXED)
+       > NO_UNITS_OF_RING_BUFFER/2
+      )
+    {
+        pthread_cond_signal(&_condWriter);
+    }
+
+} /* End of enqueueEntry */
+
+
+
+
+/**
+ * Get the time stamp of the long line header. The formatting of the current time is
+ * costly and the time stamp has a resolution of a second; it is formatted only once a
+ * second and cached for all other entries of the same second.
+ *   @return
+ * The time stamp as a string of #LENGTH_OF_TIME_STAMP characters, e.g.
+ * "Oct 14 09:12:34 2026 - ". The returned string is owned by the calling thread and it is
+ * valid until the next call of this function.
+ */
+
+static const char *getTimeStamp(void)
+{
+    time_t t;
+    time(&t);
+    if(t != _timeOfTimeStamp)
+    {
+        /* Get current time as string of fixed length. ctime is not reentrant on all
+           systems. */
+#ifdef __unix__
+        char timeStrBuf[26];
+        const char * const timeStr = ctime_r(&t, timeStrBuf);
+#else
+        const char * const timeStr = ctime(&t);
+#endif
+
+        /* Copy the time string only partial, we don't need the line feed at the end.
+             +4: Omit day of week. -1: Overwrite the newline ctime had returned. */
+        assert(strlen(timeStr) == 25  &&  LENGTH_OF_TIME_STAMP == 25-4-1+3);
+        memcpy(_timeStamp, timeStr+4, 25-4-1);
+        strcpy(_timeStamp+25-4-1, " - ");
+        _timeOfTimeStamp = t;
+    }
+
+    return _timeStamp;
+
+} /* End of getTimeStamp */
+
+
+
+
 /**
  * Write some logging information to the log file and maybe to stdout also.
  *   @return
  * The number of written characters. If the stdio function return an error this number is
  * not available and this method returns null regardless of possibly written characters.
+ * In asynchronous mode, the number of characters of the entry is returned; errors of the
+ * writer thread are not reported.
  *   @param hObj
  * The handle to the logger object to operate on.
  *   @param logLevel
  * The log level (i.e. importance level) of this message.
+ *   @param appendNewline
+ * If \a true then a newline character is appended to the formatted message.
  *   @param formatString
  * A printf-style format string, which is followed by an argument list of appropriate,
  * variable length.
@@ -542,10 +1116,14 @@ void log_flush(log_logger_t * const hObj)
  * The log level is use only for reporting it does not control whether to write the logging
  * information or not. This is done by a the function call enclosing conditional phrase,
  * which is hidden in a macro.
+ *   @remark
+ * The entry is formatted only once into a buffer, which is then written into both
+ * streams. The argument list can be consumed only once.
  */
 
 static unsigned int logInternal( log_logger_t * const hObj
                                , log_logLevel_t logLevel
+                               , boolean appendNewline
                                , const char * const formatString
                                , va_list argptr
                                )
@@ -567,28 +1145,19 @@ static unsigned int logInternal( log_logger_t * const hObj
     , "FATAL"
     };
 
-#define MAX_SIZE_LINE_HDR 128
+    if(!hObj->echoToConsole  &&  hObj->pLogFile == NULL)
+        return 0;
+
+    /* The line header is limited to a length, which is much less than the buffer. */
+    char lineBuffer[SIZE_OF_LINE_BUFFER];
+    size_t lenHeader = 0;
     boolean printHeader = hObj->lineFormat != log_fmtRaw  &&  logLevel != log_continueLine;
-    char lineHeader[MAX_SIZE_LINE_HDR+1];
     if(printHeader)
     {
-        size_t idxWhere = 0;
-
         if(hObj->lineFormat == log_fmtLong)
         {
-            /* Get current time as string of fixed length. */
-            time_t t;
-            time(&t);
-            const char * const timeStr = ctime(&t);
-
-            /* Copy the time string only partial, we don't need the line feed at the end.
-                 +4: Omit day of week. */
-            assert(strlen(timeStr) == 25);
-            strcpy(lineHeader, timeStr+4);
-            /* -1: Overwrite the newline ctime had returned. */
-            idxWhere = 25-4-1;
-            strcpy(lineHeader+idxWhere, " - ");
-            idxWhere += 3;
+            memcpy(lineBuffer, getTimeStamp(), LENGTH_OF_TIME_STAMP);
+            lenHeader = LENGTH_OF_TIME_STAMP;
         }
 
         /* Convert the CPU time to milli seconds. Normally, it is stated in micro 
@@ -616,68 +1185,58 @@ static unsigned int logInternal( log_logger_t * const hObj
 #endif
         assert((int)logLevel >= 0 && (int)logLevel <= (int)log_noLogLevels);
         const char *unitClock = hObj->lineFormat == log_fmtLong? " ms": "";
-        snprintf( lineHeader + idxWhere
-                , sizeof(lineHeader) - idxWhere
+        snprintf( lineBuffer + lenHeader
+                , sizeof(lineBuffer) - lenHeader
                 , "%06" F_MAXU_T "%s - %6s - "
                 , cpuTimeInMs
                 , unitClock
                 , logLevelStringAry_[logLevel]
                 );
-    } /* End if(Do we need to print a line header?) */
-#undef MAX_SIZE_LINE_HDR
+        lenHeader += strlen(lineBuffer + lenHeader);
 
-    unsigned int noChars = 0;
-    boolean charsCounted = false;
+    } /* End if(Do we need to print a line header?) */
 
-    if(hObj->echoToConsole)
+    /* The message is formatted into the buffer on the stack. If it is too long then it is
+       formatted a second time into a heap allocated buffer of sufficient size. */
+    va_list argptrCopy;
+    va_copy(argptrCopy, argptr);
+    const signed int lenMsg = vsnprintf( lineBuffer + lenHeader
+                                       , sizeof(lineBuffer) - lenHeader
+                                       , formatString
+                                       , argptr
+                                       );
+    if(lenMsg < 0)
     {
-        if(printHeader)
-            fputs(lineHeader, stdout);
-        signed int retVFPrintf = vfprintf(stdout, formatString, argptr);
-
-        /* Count the printed characters. Make the distinction between true numbers and
-           (negative) error information. */
-        if(retVFPrintf >= 0)
-        {
-            noChars = (unsigned)retVFPrintf;
-            if(printHeader)
-                noChars += strlen(lineHeader);
-        }
-        else
-            noChars = 0;
+        va_end(argptrCopy);
+        return 0;
+    }
+    const size_t length = lenHeader + (size_t)lenMsg + (appendNewline? 1: 0);
+    char *text = lineBuffer;
+    if(length >= sizeof(lineBuffer))
+    {
+        text = smalloc(length+1, __FILE__, __LINE__);
+        memcpy(text, lineBuffer, lenHeader);
+        vsnprintf(text + lenHeader, (size_t)lenMsg + 1, formatString, argptrCopy);
+    }
+    va_end(argptrCopy);
 
-        charsCounted = true;
+    /* After actual text output write a line feed character. */
+    if(appendNewline)
+        text[length-1] = '\n';
 
-    } /* End if(Logging into stream stdout (console) is active?) */
+    unsigned int noChars = (unsigned)length;
+    if(_isAsynchronous)
+        enqueueEntry(hObj, text, length);
+    else if(!writeEntry(hObj, hObj->echoToConsole, text, length))
+        noChars = 0;
 
-    hObj->lastFileSystemErr = 0;
-    if(hObj->pLogFile != NULL)
-    {
-        /* Rather than using sprintf once and only the streaming twice, we let printf do
-           all the formating once again in order to circumvent to problematic buffer size
-           handling of sprintf. Speed is anyway not the most important thing when doing
-           formatted logging. */
-        if(printHeader &&  fputs(lineHeader, hObj->pLogFile) < 0)
-            hObj->lastFileSystemErr = ferror(hObj->pLogFile);
-        signed int retVFPrintf = vfprintf(hObj->pLogFile, formatString, argptr);
-        if(retVFPrintf < 0)
-            hObj->lastFileSystemErr = ferror(hObj->pLogFile);
+    if(text != lineBuffer)
+        free(text);
 
-        /* If we have console outpout the printed characters have already been counted. We
-           don't need to repeat this. */
-        if(!charsCounted)
-        {
-            /* Count the printed characters. Make the distinction between true numbers and
-               (negative) error information. */
-            if(retVFPrintf >= 0)
-            {
-                noChars = (unsigned)retVFPrintf;
-                if(printHeader)
-                    noChars += strlen(lineHeader);
-            }
-            /* else: noChars remains 0 */
-        }
-    } /* End if(Logging into file stream is active?) */
+    /* The application is likely to abort after a fatal error. The entries must not be
+       lost. */
+    if(logLevel == log_fatal)
+        log_flush(hObj);
 
     return noChars;
 
@@ -728,7 +1287,12 @@ unsigned int log_log( log_logger_t * const hObj
 
     assert(hObj != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
 
-    unsigned int noChars = logInternal(hObj, logLevel, formatString, argptr);
+    unsigned int noChars = logInternal( hObj
+                                      , logLevel
+                                      , /* appendNewline */ false
+                                      , formatString
+                                      , argptr
+                                      );
 
     va_end(argptr);
     return noChars;
@@ -779,17 +1343,12 @@ unsigned int log_logLine( log_logger_t * const hObj
 
     assert(hObj != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
 
-    unsigned int noChars = logInternal(hObj, logLevel, formatString, argptr);
-
-    /* After actual text output write a line feed character. */
-    if(hObj->echoToConsole)
-        fputc('\n', stdout);
-    if(hObj->pLogFile != NULL  &&  fputc('\n', hObj->pLogFile) == EOF)
-            hObj->lastFileSystemErr = ferror(hObj->pLogFile);
-
-    /* Count the added newline character. */
-    if(hObj->echoToConsole ||  hObj->pLogFile != NULL)
-        ++ noChars;
+    unsigned int noChars = logInternal( hObj
+                                      , logLevel
+                                      , /* appendNewline */ true
+                                      , formatString
+                                      , argptr
+                                      );
 
     va_end(argptr);
     return noChars;
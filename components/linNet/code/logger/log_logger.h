@@ -154,6 +154,9 @@ void log_initModule(void);
 /** Shutdown of module after use. Release of memory, closing files, etc. */
 void log_shutdownModule(void);
 
+/** Switch between synchronous output and output by a background writer thread. */
+boolean log_setAsynchronousMode(boolean isAsynchronous);
+
 /** Create a new logger. */
 boolean log_createLogger( log_hLogger_t * const phNewLogger
                         , const char * const fileName
@@ -213,6 +216,9 @@ boolean log_close(log_hLogger_t hObj);
 /** Request access to the output streams for for direct writing using the C stdio library
     functions. */
 void log_getStreams(log_logger_t * const hObj, FILE **phConsole, FILE **phLogFile);
+
+/** Finish the direct writing into the streams got from log_getStreams. */
+void log_releaseStreams(log_logger_t * const hObj);
                    
 /** Flush contents of log file buffers. */
 void log_flush(log_hLogger_t hObj);
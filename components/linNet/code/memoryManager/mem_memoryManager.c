@@ -48,11 +48,28 @@
  *   The memory manager allocates the memory, which it partitions and manages in linked
  * lists of data objects, in large chunks from the general purpose heap using malloc. A new
  * chunk is allocated whenever the free list is exhausted. These chunks are not freed again
- * unless you delete the complete memory manager.\n
+ * unless you delete the complete memory manager. The chunks begin at a cache line
+ * boundary. On Linux, large chunks are mapped from the system and backed by huge pages if
+ * possible.\n
+ *   A heap can be used like an arena: If a client knows that all of its data objects are
+ * no longer used then it can reset the heap at once, in constant time, rather than
+ * freeing all objects one by one. The chunks are kept and they are partitioned again on
+ * demand. The objects allocated after the reset are found in the order of memory
+ * addresses, which is much more cache friendly than the random order of a free list after
+ * long operation. A client, which knows the tail of a linked list of objects, can return
+ * the list in constant time, too.\n
+ *   All heaps of a thread can be enumerated for reporting purpose. A heap records the
+ * maximum number of data objects, which have been in use at a time. The record is
+ * updated whenever the free list is replenished; the cost is negligible.\n
  *   There's no error handling strategy. As long as the general purpose heap provides
  * memory the allocation of data objects or lists of such will never fail, but if there's
  * no system memory left, the error handling simply is the abortion of the application
- * after writing an error message to stderr.
+ * after writing an error message to stderr.\n
+ *   A heap object must not be used by several threads at a time. Multi-threaded clients
+ * can create a linked heap for each of their threads. The data objects of a heap and all
+ * heaps linked to it are interchangeable: An object allocated from one of these heaps may be
+ * freed into any other. A linked heap is eventually merged back into the heap it had been
+ * derived from.
  *
  * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -76,19 +93,44 @@
  *   mem_mallocList
  *   mem_free
  *   mem_freeList
+ *   mem_createLinkedHeap
+ *   mem_mergeLinkedHeap
+ *   mem_setSizeLimit
+ *   mem_isSizeLimitExceeded
+ *   mem_freeListWithTail
+ *   mem_isLinkedHeap
+ *   mem_resetHeap
+ *   mem_getNextHeap
+ *   mem_getStatistics
+ *   mem_resetHighWaterMark
  * Local functions
  *   debug_checkConsistency
- *   partitionHeadChunk
+ *   unregisterHeap
+ *   updateHighWaterMark
+ *   allocChunkMemory
+ *   freeChunkMemory
+ *   partitionChunk
  *   allocNewChunk
+ *   replenishFreeList
  */
 
 /*
  * Include files
  */
 
+/* The anonymous memory mapping and the advice for huge pages are extensions of the C
+   library. */
+#ifdef __linux__
+# define _DEFAULT_SOURCE
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <assert.h>
+#ifdef __linux__
+# include <sys/mman.h>
+#endif
 
 #include "types.h"
 #include "smalloc.h"
@@ -102,8 +144,27 @@
 
 /** The implemented algorithm handles all actual data elements by void*. Specify an
     alignment, which will be suitable for possible actual elements, which are going to be
-    stored in the allocated memory blocks. */
-#define COMMON_MACHINE_ALIGNMENT   4
+    stored in the allocated memory blocks. 8 Byte suit pointers, double and long long on
+    all supported machines. */
+#define COMMON_MACHINE_ALIGNMENT   8
+
+/** The size of a cache line in Byte. The chunks of memory begin at a cache line
+    boundary. */
+#define SIZE_OF_CACHE_LINE  64
+
+/** Large chunks of memory can be backed by huge pages. This is supported on Linux only.
+    The compilation can disable the use of huge pages by defining this macro to 0. */
+#ifndef MEM_USE_HUGE_PAGES
+# if defined(__linux__) && defined(MADV_HUGEPAGE)
+#  define MEM_USE_HUGE_PAGES 1
+# else
+#  define MEM_USE_HUGE_PAGES 0
+# endif
+#endif
+
+/** The size of a huge page in Byte. Chunks of at least this size are mapped from the
+    system as a multiple of huge pages. */
+#define SIZE_OF_HUGE_PAGE   (2ul*1024ul*1024ul)
 
 /** The data elements the heap is partitioned in basically have the size of the client's
     data objects, but they are enlarged so that sub-sequent elements will all be on an
@@ -128,9 +189,19 @@ typedef struct _memChunk_t
     /** All chunks form a NULL terminated linked list of chunks. */
     struct _memChunk_t *pNext;
     
-    /** The client available heap memory. */
+    /** The client available heap memory. It begins at a cache line boundary. */
     void *pHeapMem;
    
+    /** The size of the chunk in number of data objects. */
+    unsigned int noDataObjs;
+
+    /** The memory, which has been got from the system and which contains \a pHeapMem. */
+    void *pSysMem;
+
+    /** The size of \a pSysMem in Byte if it is a memory mapping, or null if it has been
+        got from malloc. */
+    size_t sizeOfMapping;
+
 } memChunk_t;
 
 
@@ -152,25 +223,64 @@ typedef struct mem_heap_t
     /* A pointer to the head of the free list. */
     void *pHeadOfFreeList;
     
+    /* The chunks are partitioned into data objects when they are allocated. After a reset
+       of the heap all of its chunks are partitioned again, but on demand. This is the next
+       chunk to partition or NULL if all chunks are in the free list. */
+    memChunk_t *pNextUnpartitionedChunk;
+
+    /* The number of data objects in the chunks, which still need to be partitioned. */
+    unsigned long noUnpartitionedObjs;
+    
     /* The size of a single data object in Byte. */
     size_t sizeOfObj;
     
     /* The size of the heap in number of data objects. */
     unsigned long sizeOfHeap;
     
-    /* The number of data objects still available in the free list. */
+    /* The number of data objects still available in the free list. The objects of not
+       yet partitioned chunks are not counted. */
     unsigned long noFreeObjs;
 
     /* The size of each but the initial memory chunk in number of managed data objects. */
     unsigned int sizeOfChunk;
+
+    /* A linked heap refers to the heap it'll be merged into. NULL for all other heaps. */
+    struct mem_heap_t *pMasterHeap;
+
+    /* The number of heaps, which are currently linked to this heap. */
+    unsigned int noLinkedHeaps;
+
+    /* The size of the heap in number of data objects, which the client doesn't want to be
+       exceeded, or null if there's no limit. */
+    unsigned long maxSizeOfHeap;
+
+    /* The heap has grown beyond \a maxSizeOfHeap since the limit had been set. */
+    boolean isSizeLimitExceeded;
     
+    /* The maximum number of data objects, which had been in use at a time since creation
+       of the heap or since the last call of mem_resetHighWaterMark. */
+    unsigned long maxNoUsedObjs;
+
+    /* All heaps of a thread form a NULL terminated linked list for reporting purpose. */
+    struct mem_heap_t *pNextHeap;
+
 } heap_t;
 
 
+/** Data objects can migrate between a heap and the heaps linked to it. The number of free
+    objects of such a heap can temporarily exceed the number of its own objects. The
+    counters are checked only if a heap is not related to other heaps. */
+#define IS_LINKED(pHeap) ((pHeap)->pMasterHeap != NULL  ||  (pHeap)->noLinkedHeaps > 0)
+
+
 /*
  * Data definitions
  */
  
+/** The head of the list of all heaps, which had been created by a thread and which still
+    exist. */
+static THREAD_LOCAL heap_t *_pHeadOfListOfHeaps = NULL;
+
  
 /*
  * Function implementation
@@ -205,17 +315,195 @@ static void debug_checkConsistency(heap_t *pHeap)
 
 
 
+/**
+ * Remove a heap from the list of all heaps of the thread. The heap is going to be deleted.
+ *   @param pHeap
+ * The pointer to the heap. It needs to be in the list.
+ */
+
+static void unregisterHeap(heap_t * const pHeap)
+{
+    heap_t **ppHeap = &_pHeadOfListOfHeaps;
+    while(*ppHeap != pHeap)
+    {
+        assert(*ppHeap != NULL);
+        ppHeap = &(*ppHeap)->pNextHeap;
+    }
+    *ppHeap = pHeap->pNextHeap;
+    pHeap->pNextHeap = NULL;
+
+} /* End of unregisterHeap */
+
+
+
+
+/**
+ * Update the record of the maximum number of data objects in use.
+ *   @param pHeap
+ * The pointer to the heap under progress.
+ *   @remark
+ * Data objects can migrate between linked heaps and the number of free objects of a heap
+ * can temporarily exceed the number of its own objects. The number of used objects is
+ * then considered null; the record of a linked heap is a rough estimate only.
+ */
+
+static void updateHighWaterMark(heap_t * const pHeap)
+{
+    const unsigned long noAvailableObjs = pHeap->noFreeObjs + pHeap->noUnpartitionedObjs;
+    if(noAvailableObjs < pHeap->sizeOfHeap)
+    {
+        const unsigned long noUsedObjs = pHeap->sizeOfHeap - noAvailableObjs;
+        if(noUsedObjs > pHeap->maxNoUsedObjs)
+            pHeap->maxNoUsedObjs = noUsedObjs;
+    }
+} /* End of updateHighWaterMark */
+
+
+
+
+/**
+ * Get the memory for a new chunk from the system. Large chunks are mapped from the system
+ * and backed by huge pages if possible; all others are allocated with malloc. The memory
+ * begins at a cache line boundary.
+ *   @param pChunk
+ * The chunk object. Its memory related fields are set.
+ *   @param sizeOfMem
+ * The size of the required memory in Byte. If it is a multiple of #SIZE_OF_HUGE_PAGE
+ * then the memory is backed by huge pages if possible.
+ */
+
+static void allocChunkMemory(memChunk_t * const pChunk, size_t sizeOfMem)
+{
+#if MEM_USE_HUGE_PAGES != 0
+    if(sizeOfMem >= SIZE_OF_HUGE_PAGE  &&  sizeOfMem % SIZE_OF_HUGE_PAGE == 0)
+    {
+        /* A huge page needs to begin at a huge page boundary, but the system maps memory
+           at a page boundary only. We map an additional huge page and return the unused
+           pages at both ends of the mapping. */
+        const size_t sizeOfMapping = sizeOfMem + SIZE_OF_HUGE_PAGE;
+        char * const pMem = mmap( /* addr */ NULL
+                                , sizeOfMapping
+                                , PROT_READ | PROT_WRITE
+                                , MAP_PRIVATE | MAP_ANONYMOUS
+                                , /* fd */ -1
+                                , /* offset */ 0
+                                );
+        if(pMem != MAP_FAILED)
+        {
+            char * const pAlignedMem = (char*)(((uintptr_t)pMem + SIZE_OF_HUGE_PAGE - 1)
+                                               & ~(uintptr_t)(SIZE_OF_HUGE_PAGE - 1)
+                                              );
+            const size_t sizeOfHead = (size_t)(pAlignedMem - pMem)
+                       , sizeOfTail = SIZE_OF_HUGE_PAGE - sizeOfHead;
+            if(sizeOfHead > 0)
+                munmap(pMem, sizeOfHead);
+            if(sizeOfTail > 0)
+                munmap(pAlignedMem + sizeOfMem, sizeOfTail);
+
+            /* The advice may be refused by the system, the memory is still usable. */
+            madvise(pAlignedMem, sizeOfMem, MADV_HUGEPAGE);
+
+            pChunk->pSysMem = pAlignedMem;
+            pChunk->pHeapMem = pAlignedMem;
+            pChunk->sizeOfMapping = sizeOfMem;
+            return;
+        }
+    }
+#endif
+
+    /* The memory from malloc is aligned to the next cache line boundary. */
+    char * const pMem = smalloc(sizeOfMem + SIZE_OF_CACHE_LINE - 1, __FILE__, __LINE__);
+    pChunk->pSysMem = pMem;
+    pChunk->pHeapMem = (void*)(((uintptr_t)pMem + SIZE_OF_CACHE_LINE - 1)
+                               & ~(uintptr_t)(SIZE_OF_CACHE_LINE - 1)
+                              );
+    pChunk->sizeOfMapping = 0;
+
+} /* End of allocChunkMemory */
+
+
+
+
+/**
+ * Return the memory of a chunk to the system.
+ *   @param pChunk
+ * The chunk object. Its memory must no longer be used after return.
+ */
+
+static void freeChunkMemory(memChunk_t * const pChunk)
+{
+#if MEM_USE_HUGE_PAGES != 0
+    if(pChunk->sizeOfMapping > 0)
+        munmap(pChunk->pSysMem, pChunk->sizeOfMapping);
+    else
+#endif
+        free(pChunk->pSysMem);
+
+    pChunk->pSysMem = NULL;
+    pChunk->pHeapMem = NULL;
+
+} /* End of freeChunkMemory */
+
+
+
+
+/**
+ * Partition a chunk of memory into data objects and put them in front of the free list of
+ * the heap.
+ *   @param pHeap
+ * The pointer to the heap under progress.
+ *   @param pChunk
+ * The chunk to partition. It belongs to the heap and none of its data objects is in use.
+ */
+
+static void partitionChunk(heap_t * const pHeap, memChunk_t * const pChunk)
+{
+    const unsigned int noDataObjs = pChunk->noDataObjs;
+    assert(noDataObjs >= 1);
+    char *pDataObj = pChunk->pHeapMem;
+    unsigned int u;
+    for(u=0; u<noDataObjs-1; ++u)
+    {
+        char *pAddrOfNextDataObj = pDataObj + pHeap->sizeOfObj;
+        *(void**)pDataObj = (void*)pAddrOfNextDataObj;
+        pDataObj = pAddrOfNextDataObj;
+    }
+    /* pDataObj points to the link pointer in the last data object. We write the current
+       head of the free list into this pointer - the chunk becomes the head of the fee
+       list. */
+    *(void**)pDataObj = pHeap->pHeadOfFreeList;
+    pHeap->pHeadOfFreeList = pChunk->pHeapMem;
+    pHeap->noFreeObjs += noDataObjs;
+
+} /* End of partitionChunk */
+
+
+
+
 /**
  * Allocate a new chunk to the (exhausted) heap and partition its for allocation request by
  * the heap's client.
  *   @param pHeap
  * The pointer to the heap under progress.
  *   @param noDataObjs
- * The size of the new chunk in number of data objects.
+ * The size of the new chunk in number of data objects. A chunk, which is backed by huge
+ * pages, is enlarged so that it fills the huge pages.
  */ 
 
 static void allocNewChunk(heap_t * const pHeap, unsigned int noDataObjs)
 {
+    /* Large chunks are rounded to whole huge pages. The additional data objects come at no
+       cost. */
+    size_t sizeOfMem = pHeap->sizeOfObj*noDataObjs;
+#if MEM_USE_HUGE_PAGES != 0
+    if(sizeOfMem >= SIZE_OF_HUGE_PAGE)
+    {
+        sizeOfMem = (sizeOfMem + SIZE_OF_HUGE_PAGE - 1) / SIZE_OF_HUGE_PAGE
+                    * SIZE_OF_HUGE_PAGE;
+        noDataObjs = (unsigned int)(sizeOfMem / pHeap->sizeOfObj);
+    }
+#endif
+
     if(pHeap->hLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT)
     {
         LOG_DEBUG( pHeap->hLogger
@@ -230,9 +518,12 @@ static void allocNewChunk(heap_t * const pHeap, unsigned int noDataObjs)
 
     /* Allocate the new memory chunk. */
     memChunk_t * const pNewChunk = smalloc(sizeof(memChunk_t), __FILE__, __LINE__);
-    pNewChunk->pHeapMem = smalloc(pHeap->sizeOfObj*noDataObjs, __FILE__, __LINE__);
+    allocChunkMemory(pNewChunk, sizeOfMem);
+    pNewChunk->noDataObjs = noDataObjs;
 
-    /* The new chunk becomes the new head of the list of chunks. */
+    /* The new chunk becomes the new head of the list of chunks. A new chunk is allocated
+       only if all chunks had been partitioned before, so all of them still are. */
+    assert(pHeap->pNextUnpartitionedChunk == NULL);
     pNewChunk->pNext = pHeap->pHeadOfChunkList;
     
     /* The initial chunk is both, the head and the tail of the initial list of chunks. At
@@ -244,31 +535,50 @@ static void allocNewChunk(heap_t * const pHeap, unsigned int noDataObjs)
     }
     pHeap->pHeadOfChunkList = pNewChunk;
     
-    /* Partition the new chunk. */ 
-    assert(noDataObjs >= 1);
-    char *pDataObj = pNewChunk->pHeapMem;
-    unsigned int u;
-    for(u=0; u<noDataObjs-1; ++u)
-    {
-        char *pAddrOfNextDataObj = pDataObj + pHeap->sizeOfObj;
-        *(void**)pDataObj = (void*)pAddrOfNextDataObj;
-        pDataObj = pAddrOfNextDataObj;
-    }
-    /* pDataObj points to the link pointer in the last data object. We write the current
-       head of the free list into this pointer - the new chunk becomes the head of the fee
-       list. */
-    *(void**)pDataObj = pHeap->pHeadOfFreeList;
-    pHeap->pHeadOfFreeList = pNewChunk->pHeapMem;
-    
-    /* Record new memory. */
+    /* Partition the new chunk and record the new memory. */ 
+    partitionChunk(pHeap, pNewChunk);
     pHeap->sizeOfHeap += noDataObjs;
-    pHeap->noFreeObjs += noDataObjs;
+
+    /* A chunk is allocated only if all objects are in use. The size of the heap is the
+       number of allocated data objects at this instance. */
+    if(pHeap->maxSizeOfHeap > 0  &&  pHeap->sizeOfHeap > pHeap->maxSizeOfHeap)
+        pHeap->isSizeLimitExceeded = true;
     
 } /* End of allocNewChunk */
 
 
 
 
+/**
+ * Put more data objects into the exhausted free list of a heap. The next chunk, which
+ * still needs partitioning after a reset of the heap, is reused or a new chunk is
+ * allocated.
+ *   @param pHeap
+ * The pointer to the heap under progress.
+ */
+
+static void replenishFreeList(heap_t * const pHeap)
+{
+    /* The free list is exhausted; this is the only instance, when the number of used data
+       objects can have reached a new maximum. */
+    updateHighWaterMark(pHeap);
+
+    memChunk_t * const pChunk = pHeap->pNextUnpartitionedChunk;
+    if(pChunk != NULL)
+    {
+        assert(pHeap->noUnpartitionedObjs >= pChunk->noDataObjs);
+        pHeap->pNextUnpartitionedChunk = pChunk->pNext;
+        pHeap->noUnpartitionedObjs -= pChunk->noDataObjs;
+        partitionChunk(pHeap, pChunk);
+    }
+    else
+        allocNewChunk(pHeap, pHeap->sizeOfChunk);
+
+} /* End of replenishFreeList */
+
+
+
+
 /*
  * Initialize a heap for (list) elements of a specific data type.
  *   @return
@@ -316,9 +626,24 @@ mem_hHeap_t mem_createHeap( log_hLogger_t hLogger
     pHeap->pHeadOfChunkList = NULL;
     pHeap->pTailOfChunkList = NULL;
     pHeap->pHeadOfFreeList = NULL;
+    pHeap->pNextUnpartitionedChunk = NULL;
+    pHeap->noUnpartitionedObjs = 0;
     pHeap->sizeOfHeap = 0;
     pHeap->noFreeObjs = 0;
+
+    /* The new heap is not linked to other heaps. */
+    pHeap->pMasterHeap = NULL;
+    pHeap->noLinkedHeaps = 0;
+
+    /* The size of the heap is not limited. */
+    pHeap->maxSizeOfHeap = 0;
+    pHeap->isSizeLimitExceeded = false;
     
+    /* Register the new heap for reporting. */
+    pHeap->maxNoUsedObjs = 0;
+    pHeap->pNextHeap = _pHeadOfListOfHeaps;
+    _pHeadOfListOfHeaps = pHeap;
+
     if(hLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT)
     {
         LOG_DEBUG( hLogger
@@ -360,7 +685,7 @@ mem_hHeap_t mem_createHeap( log_hLogger_t hLogger
 
 unsigned long mem_deleteHeap(heap_t *pHeap, boolean warnIfUnfreedMem)
 {
-    assert(pHeap != NULL);    
+    assert(pHeap != NULL  &&  !IS_LINKED(pHeap));    
     
 #ifdef DEBUG
     debug_checkConsistency(pHeap);
@@ -377,15 +702,16 @@ unsigned long mem_deleteHeap(heap_t *pHeap, boolean warnIfUnfreedMem)
                 ||  (pNextChunk == NULL  &&  pChunk == pHeap->pTailOfChunkList)
               );
               
-        free(pChunk->pHeapMem);
+        freeChunkMemory(pChunk);
         free(pChunk);
         ++ noChunks;
         pChunk = pNextChunk;
     }
     while(pChunk != NULL);
     
-    assert(pHeap->noFreeObjs <= pHeap->sizeOfHeap);
-    unsigned long noUnfreedObjs = pHeap->sizeOfHeap - pHeap->noFreeObjs;
+    assert(pHeap->noFreeObjs + pHeap->noUnpartitionedObjs <= pHeap->sizeOfHeap);
+    unsigned long noUnfreedObjs = pHeap->sizeOfHeap - pHeap->noFreeObjs
+                                  - pHeap->noUnpartitionedObjs;
     
     if(pHeap->hLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT)
     {
@@ -413,6 +739,7 @@ unsigned long mem_deleteHeap(heap_t *pHeap, boolean warnIfUnfreedMem)
 
     } /* if(Do we have to do reporting?) */
     
+    unregisterHeap(pHeap);
     free(pHeap);    
     
     return noUnfreedObjs;
@@ -434,7 +761,7 @@ void *mem_malloc(heap_t *pHeap)
 {
     
     if(pHeap->noFreeObjs < 1)
-        allocNewChunk(pHeap, pHeap->sizeOfChunk);
+        replenishFreeList(pHeap);
     
     assert(pHeap->noFreeObjs >= 1);
     -- pHeap->noFreeObjs;
@@ -474,7 +801,7 @@ void *mem_mallocList(heap_t *pHeap, unsigned int lenOfList)
     assert(lenOfList > 0);
     
     while(pHeap->noFreeObjs < lenOfList)
-        allocNewChunk(pHeap, pHeap->sizeOfChunk);
+        replenishFreeList(pHeap);
 
     pHeap->noFreeObjs -= lenOfList;
     
@@ -509,7 +836,11 @@ void *mem_mallocList(heap_t *pHeap, unsigned int lenOfList)
 
 void mem_free(heap_t *pHeap, void *pDataObj)
 {
-    assert(pDataObj != NULL  &&  pHeap->sizeOfHeap > pHeap->noFreeObjs);
+    assert(pDataObj != NULL
+           &&  (IS_LINKED(pHeap)
+                ||  pHeap->sizeOfHeap > pHeap->noFreeObjs + pHeap->noUnpartitionedObjs
+               )
+          );
     
     ++ pHeap->noFreeObjs;
     *(void**)pDataObj = pHeap->pHeadOfFreeList;
@@ -536,7 +867,11 @@ void mem_free(heap_t *pHeap, void *pDataObj)
 
 void mem_freeList(heap_t *pHeap, void *pHeadOfList)
 {
-    assert(pHeadOfList != NULL  &&  pHeap->sizeOfHeap > pHeap->noFreeObjs);
+    assert(pHeadOfList != NULL
+           &&  (IS_LINKED(pHeap)
+                ||  pHeap->sizeOfHeap > pHeap->noFreeObjs + pHeap->noUnpartitionedObjs
+               )
+          );
     
     /* We iterate along the returned list in order to determine its length and to find its
        tail element. This element is needed for concatenation of the returned list with the
@@ -546,7 +881,9 @@ void mem_freeList(heap_t *pHeap, void *pHeadOfList)
     while(*(void**)pNext != NULL)
     {
         ++ u;
-        assert(u + pHeap->noFreeObjs <= pHeap->sizeOfHeap);
+        assert(IS_LINKED(pHeap)
+               ||  u + pHeap->noFreeObjs + pHeap->noUnpartitionedObjs <= pHeap->sizeOfHeap
+              );
         pNext = *(void**)pNext;
     }
     
@@ -560,3 +897,367 @@ void mem_freeList(heap_t *pHeap, void *pHeadOfList)
 
 
 
+/**
+ * Create a heap, which is linked to an existing heap. The new heap manages data objects of
+ * the same size and the data objects of both heaps are interchangeable; an object allocated
+ * from one of them may be freed into the other one.\n
+ *   The use case are multi-threaded clients. A heap object must not be used by several
+ * threads at a time but each thread can use its own linked heap. Since all linked heaps
+ * of a common master heap exchange their objects, it doesn't matter which thread frees an
+ * object, which had been allocated by another one.\n
+ *   The linked heap needs to be merged back into the master heap using void
+ * mem_mergeLinkedHeap(heap_t *) after use. The check of the master heap for un-freed
+ * objects is meaningful only after all of its linked heaps have been merged.
+ *   @return
+ * The handle to the new heap is returned.
+ *   @param pMasterHeap
+ * The handle to the heap the new heap is linked to. The master heap itself must not be a
+ * linked heap.
+ *   @param name
+ * The name of the created heap. A linked heap doesn't do any logging; the name is for
+ * debugging purpose only.
+ *   @remark
+ * Creating and merging linked heaps modifies the master heap. These operations must not be
+ * done while another thread makes use of the master heap.
+ */
+
+mem_hHeap_t mem_createLinkedHeap(heap_t *pMasterHeap, const char *name)
+{
+    assert(pMasterHeap != NULL  &&  pMasterHeap->pMasterHeap == NULL);
+
+    /* A linked heap is an ordinary heap with the size of objects of its master. It doesn't
+       do any logging; the logger objects are not meant to be used by several threads. */
+    heap_t *pHeap = mem_createHeap( LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT
+                                  , name
+                                  , pMasterHeap->sizeOfObj
+                                  , /* initialHeapSize */ pMasterHeap->sizeOfChunk
+                                  , /* allocationBlockSize */ pMasterHeap->sizeOfChunk
+                                  );
+    assert(pHeap->sizeOfObj == pMasterHeap->sizeOfObj);
+    pHeap->pMasterHeap = pMasterHeap;
+    ++ pMasterHeap->noLinkedHeaps;
+
+    return pHeap;
+
+} /* End of mem_createLinkedHeap */
+
+
+
+
+/**
+ * Merge a linked heap back into its master heap. All memory chunks and all free objects of
+ * the linked heap are moved to the master heap and the linked heap is deleted. Data
+ * objects, which had been allocated from the linked heap, remain valid and can be freed
+ * into the master heap.
+ *   @param pHeap
+ * The handle to the linked heap as got from mem_createLinkedHeap. The handle is invalid
+ * after return.
+ */
+
+void mem_mergeLinkedHeap(heap_t *pHeap)
+{
+    heap_t * const pMasterHeap = pHeap->pMasterHeap;
+    assert(pMasterHeap != NULL  &&  pMasterHeap->noLinkedHeaps > 0
+           &&  pHeap->noLinkedHeaps == 0
+          );
+
+#ifdef DEBUG
+    debug_checkConsistency(pHeap);
+#endif
+
+    /* The chunks of the linked heap are put in front of the list of chunks of the master.
+       The tail of the master's list is not affected. A linked heap can't be reset; all of
+       its chunks are partitioned. This is a precondition of the master's list of
+       chunks, where the chunks, which still need partitioning, form the end of the
+       list. */
+    assert(pHeap->pNextUnpartitionedChunk == NULL  &&  pHeap->noUnpartitionedObjs == 0);
+    assert(pHeap->pHeadOfChunkList != NULL  &&  pMasterHeap->pHeadOfChunkList != NULL);
+    pHeap->pTailOfChunkList->pNext = pMasterHeap->pHeadOfChunkList;
+    pMasterHeap->pHeadOfChunkList = pHeap->pHeadOfChunkList;
+
+    /* The free list of the linked heap is put in front of the free list of the master. The
+       tail of the list needs to be found by iteration. */
+    if(pHeap->noFreeObjs > 0)
+    {
+        void *pTail = pHeap->pHeadOfFreeList;
+        while(*(void**)pTail != NULL)
+            pTail = *(void**)pTail;
+        *(void**)pTail = pMasterHeap->pHeadOfFreeList;
+        pMasterHeap->pHeadOfFreeList = pHeap->pHeadOfFreeList;
+    }
+
+    /* Data objects may have migrated between the heaps. Only the sums of the counters of
+       all related heaps are consistent. */
+    pMasterHeap->sizeOfHeap += pHeap->sizeOfHeap;
+    pMasterHeap->noFreeObjs += pHeap->noFreeObjs;
+    -- pMasterHeap->noLinkedHeaps;
+    if(!IS_LINKED(pMasterHeap))
+        updateHighWaterMark(pMasterHeap);
+
+    if(pMasterHeap->hLogger != LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT)
+    {
+        LOG_DEBUG( pMasterHeap->hLogger
+                 , "mem_mergeLinkedHeap: Merge heap %s into heap %s. Total heap size now:"
+                   " %lu Byte"
+                 , pHeap->name
+                 , pMasterHeap->name
+                 , pMasterHeap->sizeOfHeap * (unsigned long)pMasterHeap->sizeOfObj
+                 )
+    }
+
+    /* The linked heap object itself is no longer needed. It doesn't own a logger. */
+    assert(pHeap->hLogger == LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT);
+    unregisterHeap(pHeap);
+    free(pHeap);
+
+#ifdef DEBUG
+    debug_checkConsistency(pMasterHeap);
+#endif
+} /* End of mem_mergeLinkedHeap */
+
+
+
+
+/**
+ * Set a limit of the size of a heap. The memory manager has no error handling strategy
+ * and the allocation of data objects doesn't fail if the limit is exceeded. Instead, the
+ * event is recorded and the client can query it at suitable instances to abort its
+ * operation in a controlled way. The check is cheap: The heap size is compared to the
+ * limit when a new chunk of memory is allocated and the number of data objects in use is
+ * compared to the limit when the client queries the state.
+ *   @param pHeap
+ * The handle to the heap as got from mem_createHeap or mem_createLinkedHeap. The limit
+ * applies to the data objects allocated from this heap only, regardless of any linked
+ * heaps.
+ *   @param maxNoDataObjs
+ * The maximum number of allocated data objects or null if the size should not be limited.
+ *   @remark
+ * Setting the limit resets the record of an exceeded limit. A heap, which is already
+ * larger than the limit, is not reported before it grows again or before more data
+ * objects are in use than the limit permits.
+ */
+
+void mem_setSizeLimit(heap_t *pHeap, unsigned long maxNoDataObjs)
+{
+    pHeap->maxSizeOfHeap = maxNoDataObjs;
+    pHeap->isSizeLimitExceeded = false;
+
+} /* End of mem_setSizeLimit */
+
+
+
+
+/**
+ * Check if a heap has grown beyond the limit set by mem_setSizeLimit.
+ *   @return
+ * \a true if the heap had to allocate more data objects than permitted by the limit since
+ * the limit had been set or if more data objects are currently in use than permitted.
+ *   @param pHeap
+ * The handle to the heap.
+ *   @remark
+ * A chunk of memory can hold many more data objects than the limit permits, so that the
+ * size of the heap alone doesn't reveal a small limit. The number of data objects in use
+ * has only a rough meaning for linked heaps, see void mem_getStatistics
+ * (mem_heapStatistics_t * const, const heap_t *).
+ */
+
+boolean mem_isSizeLimitExceeded(const heap_t *pHeap)
+{
+    if(pHeap->isSizeLimitExceeded)
+        return true;
+    else if(pHeap->maxSizeOfHeap > 0)
+    {
+        const unsigned long noAvailableObjs = pHeap->noFreeObjs
+                                              + pHeap->noUnpartitionedObjs;
+        return noAvailableObjs < pHeap->sizeOfHeap
+               &&  pHeap->sizeOfHeap - noAvailableObjs > pHeap->maxSizeOfHeap;
+    }
+    else
+        return false;
+
+} /* End of mem_isSizeLimitExceeded */
+
+
+
+
+/**
+ * Return a linked list of no longer used data objects to the heap they were allocated on
+ * before. Other than mem_freeList, this function doesn't need to iterate along the list;
+ * the list is spliced into the free list in constant time. The client needs to know the
+ * tail and the length of the list.\n
+ *   The same constraints apply as for void mem_freeList(heap_t *, void *).
+ *   @param pHeap
+ * The handle to the heap the data objects belongs to.
+ *   @param pHeadOfList
+ * The pointer to the head of the list that is returned to the heap, i.e. the first one of
+ * the linked data objects.
+ *   @param pTailOfList
+ * The pointer to the last data object of the returned list. It may be identical with \a
+ * pHeadOfList. Its link pointer doesn't care.
+ *   @param lenOfList
+ * The number of linked data objects from \a pHeadOfList to \a pTailOfList, both
+ * included.
+ */
+
+void mem_freeListWithTail( heap_t *pHeap
+                         , void *pHeadOfList
+                         , void *pTailOfList
+                         , unsigned long lenOfList
+                         )
+{
+    assert(pHeadOfList != NULL  &&  pTailOfList != NULL  &&  lenOfList >= 1
+           &&  (IS_LINKED(pHeap)
+                ||  lenOfList + pHeap->noFreeObjs + pHeap->noUnpartitionedObjs
+                    <= pHeap->sizeOfHeap
+               )
+          );
+#ifdef DEBUG
+    /* Validate the information about the list in DEBUG compilation. */
+    unsigned long u;
+    void *pNext = pHeadOfList;
+    for(u=1; u<lenOfList; ++u)
+    {
+        assert(pNext != pTailOfList);
+        pNext = *(void**)pNext;
+        assert(pNext != NULL);
+    }
+    assert(pNext == pTailOfList);
+#endif
+
+    pHeap->noFreeObjs += lenOfList;
+    *(void**)pTailOfList = pHeap->pHeadOfFreeList;
+    pHeap->pHeadOfFreeList = pHeadOfList;
+
+} /* End of mem_freeListWithTail */
+
+
+
+
+/**
+ * Check if a heap is related to other heaps. This is the case for a linked heap and for a
+ * heap, which linked heaps are currently derived from. Data objects can migrate between
+ * related heaps.
+ *   @return
+ * Get the Boolean answer.
+ *   @param pHeap
+ * The handle to the heap.
+ */
+
+boolean mem_isLinkedHeap(const heap_t *pHeap)
+{
+    return IS_LINKED(pHeap);
+
+} /* End of mem_isLinkedHeap */
+
+
+
+
+/**
+ * Reset a heap, which is used as an arena. All data objects are returned to the heap at
+ * once; the operation takes constant time regardless of the number of data objects. All
+ * references to currently allocated data objects become invalid and must no longer be
+ * used.\n
+ *   The memory chunks of the heap are not released. They are partitioned again when the
+ * next data objects are allocated. Subsequent allocations yield the data objects in the
+ * order of memory addresses.
+ *   @return
+ * The number of data objects, which had still been allocated at the time of the reset,
+ * is returned. This is not an error; a client may use the reset to get rid of all of its
+ * data objects. Other clients may check their expectation that all objects had been freed
+ * already.
+ *   @param pHeap
+ * The handle to the heap as got from mem_createHeap. The heap must not be related to
+ * other heaps; neither a linked heap nor a heap, which other heaps are currently linked to
+ * can be reset, see boolean mem_isLinkedHeap(const heap_t *).
+ */
+
+unsigned long mem_resetHeap(heap_t *pHeap)
+{
+    assert(pHeap != NULL  &&  !IS_LINKED(pHeap)
+           &&  pHeap->noFreeObjs + pHeap->noUnpartitionedObjs <= pHeap->sizeOfHeap
+          );
+    const unsigned long noUnfreedObjs = pHeap->sizeOfHeap - pHeap->noFreeObjs
+                                        - pHeap->noUnpartitionedObjs;
+
+    updateHighWaterMark(pHeap);
+    pHeap->pHeadOfFreeList = NULL;
+    pHeap->noFreeObjs = 0;
+    pHeap->pNextUnpartitionedChunk = pHeap->pHeadOfChunkList;
+    pHeap->noUnpartitionedObjs = pHeap->sizeOfHeap;
+
+    return noUnfreedObjs;
+
+} /* End of mem_resetHeap */
+
+
+
+
+/**
+ * Enumerate all heaps, which had been created by the calling thread and which still
+ * exist. This includes the linked heaps.
+ *   @return
+ * The handle to the next heap or MEM_HANDLE_INVALID_HEAP if there are no more heaps.
+ *   @param hHeap
+ * The heap, which had been returned by the previous call. Pass MEM_HANDLE_INVALID_HEAP to
+ * get the first heap.
+ *   @remark
+ * No heap must be created or deleted while an enumeration is in progress.
+ */
+
+mem_hHeap_t mem_getNextHeap(const heap_t *pHeap)
+{
+    if(pHeap == NULL)
+        return _pHeadOfListOfHeaps;
+    else
+        return pHeap->pNextHeap;
+
+} /* End of mem_getNextHeap */
+
+
+
+
+/**
+ * Get the statistics of a heap.
+ *   @param pStatistics
+ * The statistics are returned in * \a pStatistics.
+ *   @param pHeap
+ * The handle to the heap.
+ *   @remark
+ * The counters of a heap, which is related to other heaps by linkage, only have a rough
+ * meaning: Data objects can migrate between these heaps. See boolean
+ * mem_isLinkedHeap(const heap_t *).
+ */
+
+void mem_getStatistics(mem_heapStatistics_t * const pStatistics, const heap_t *pHeap)
+{
+    const unsigned long noAvailableObjs = pHeap->noFreeObjs + pHeap->noUnpartitionedObjs;
+    pStatistics->name = pHeap->name;
+    pStatistics->sizeOfObj = pHeap->sizeOfObj;
+    pStatistics->sizeOfHeap = pHeap->sizeOfHeap;
+    pStatistics->noUsedObjs = noAvailableObjs < pHeap->sizeOfHeap
+                              ? pHeap->sizeOfHeap - noAvailableObjs
+                              : 0;
+    pStatistics->maxNoUsedObjs = pHeap->maxNoUsedObjs;
+    if(pStatistics->noUsedObjs > pStatistics->maxNoUsedObjs)
+        pStatistics->maxNoUsedObjs = pStatistics->noUsedObjs;
+    pStatistics->isLinked = IS_LINKED(pHeap);
+
+} /* End of mem_getStatistics */
+
+
+
+
+/**
+ * Reset the record of the maximum number of data objects in use to the current number
+ * of used objects. This is useful to get the high-water mark of a single phase of the
+ * client's operation.
+ *   @param pHeap
+ * The handle to the heap.
+ */
+
+void mem_resetHighWaterMark(heap_t *pHeap)
+{
+    pHeap->maxNoUsedObjs = 0;
+    updateHighWaterMark(pHeap);
+
+} /* End of mem_resetHighWaterMark */
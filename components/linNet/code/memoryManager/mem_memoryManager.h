@@ -57,6 +57,29 @@ struct mem_heap_t;
     memory. */
 typedef struct mem_heap_t *mem_hHeap_t; 
 
+/** The statistics of a heap for reporting purpose. */
+typedef struct mem_heapStatistics_t
+{
+    /** The name of the heap. */
+    const char *name;
+
+    /** The size of a single data object in Byte, including the alignment. */
+    size_t sizeOfObj;
+
+    /** The size of the heap in number of data objects. */
+    unsigned long sizeOfHeap;
+
+    /** The number of data objects currently in use. */
+    unsigned long noUsedObjs;
+
+    /** The maximum number of data objects, which had been in use at a time. */
+    unsigned long maxNoUsedObjs;
+
+    /** The heap is related to other heaps and its counters are rough estimates only. */
+    boolean isLinked;
+
+} mem_heapStatistics_t;
+
 
 /*
  * Global data declarations
@@ -90,4 +113,38 @@ void mem_freeList(mem_hHeap_t hHeap, void *pHeadElement);
 /** Destroy the heap, release all memory. */
 unsigned long mem_deleteHeap(mem_hHeap_t hHeap, boolean warnIfUnfreed);
 
+/** Create a heap, whose data objects are interchangeable with those of an existing heap. */
+mem_hHeap_t mem_createLinkedHeap(mem_hHeap_t hMasterHeap, const char *name);
+
+/** Merge a linked heap back into the heap it had been created from. */
+void mem_mergeLinkedHeap(mem_hHeap_t hLinkedHeap);
+
+/** Set the maximum size of a heap, which the client wants to be notified about. */
+void mem_setSizeLimit(mem_hHeap_t hHeap, unsigned long maxNoDataObjs);
+
+/** Check if a heap has grown beyond its size limit. */
+boolean mem_isSizeLimitExceeded(const struct mem_heap_t *hHeap);
+
+/** Free a linked list of elements, whose tail and length are known, in constant time. */
+void mem_freeListWithTail( mem_hHeap_t hHeap
+                         , void *pHeadElement
+                         , void *pTailElement
+                         , unsigned long lenOfList
+                         );
+
+/** Check if a heap is related to other heaps by linkage. */
+boolean mem_isLinkedHeap(const struct mem_heap_t *hHeap);
+
+/** Return all data objects to the heap at once. */
+unsigned long mem_resetHeap(mem_hHeap_t hHeap);
+
+/** Enumerate all heaps of the calling thread. */
+mem_hHeap_t mem_getNextHeap(const struct mem_heap_t *hHeap);
+
+/** Get the statistics of a heap. */
+void mem_getStatistics(mem_heapStatistics_t *pStatistics, const struct mem_heap_t *hHeap);
+
+/** Restart recording the maximum number of used data objects of a heap. */
+void mem_resetHighWaterMark(mem_hHeap_t hHeap);
+
 #endif  /* MEM_MEMORYMANAGER_INCLUDED */
@@ -0,0 +1,537 @@
+/**
+ * @file thp_threadPool.c
+ *   This module implements a simple pool of worker threads. The pool executes a set of
+ * independent tasks, which are identified by an index, in all of its threads at a time.
+ * The calling thread takes part in the execution and the call returns when all tasks are
+ * completed.\n
+ *   The tasks are distributed by work stealing. Each thread owns a queue, which initially
+ * holds an equal share of the contiguous range of tasks. A thread takes its tasks one by
+ * one from the beginning of its own queue. If the queue is exhausted then it steals the
+ * upper half from the queue of another thread. Tasks of similar index are thus mostly
+ * executed in the same thread, which is good for the locality of data, while tasks of very
+ * different duration don't let threads idle.\n
+ *   The threads are created once and wait for the next set of tasks in between. The pool
+ * is intended for rather short sets of tasks, which are frequently repeated, like the
+ * elimination steps of the solver.\n
+ *   The implementation builds on POSIX threads.
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   thp_createThreadPool
+ *   thp_deleteThreadPool
+ *   thp_getNoThreads
+ *   thp_runTasks
+ * Local functions
+ *   takeOwnTask
+ *   stealTasks
+ *   executeTasks
+ *   workerThread
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "types.h"
+#include "smalloc.h"
+#include "log_logger.h"
+#include "thp_threadPool.h"
+
+
+/*
+ * Defines
+ */
+
+/** The assumed size of a cache line in Byte. The queues of the threads are separated by
+    at least this distance in order to avoid false sharing. */
+#define SIZE_OF_CACHE_LINE  64
+
+
+/*
+ * Local type definitions
+ */
+
+/** The queue of tasks of a single thread. It is a contiguous range of task indexes. */
+typedef struct taskQueue_t
+{
+    /** The queue is accessed by its owner and by other threads, which steal tasks. */
+    pthread_mutex_t mutex;
+
+    /** The index of the next task the owner will execute. */
+    unsigned int idxBegin;
+
+    /** The index of the first task, which doesn't belong to the queue any more. The queue
+        is empty if \a idxBegin == \a idxEnd. */
+    unsigned int idxEnd;
+
+    /** Fill bytes, which keep the queues of different threads apart. */
+    char padding[SIZE_OF_CACHE_LINE];
+
+} taskQueue_t;
+
+
+/** The description of a worker thread. */
+typedef struct worker_t
+{
+    /** The pool the thread belongs to. */
+    struct thp_threadPool_t *pPool;
+
+    /** The index of the thread in the pool. */
+    unsigned int idxThread;
+
+    /** The POSIX handle of the thread. */
+    pthread_t thread;
+
+} worker_t;
+
+
+/** The definition of a thread pool object. */
+typedef struct thp_threadPool_t
+{
+    /** The logger, which is used in the calling thread only. */
+    log_hLogger_t hLogger;
+
+    /** The number of threads including the calling thread. */
+    unsigned int noThreads;
+
+    /** The worker threads. The calling thread has index null; element null of the array
+        is unused. */
+    worker_t *workerAry;
+
+    /** One task queue per thread, including the calling thread. */
+    taskQueue_t *queueAry;
+
+    /** A function, which is executed in each worker thread at its start. May be NULL. */
+    thp_fctThreadStartStop_t fctStartThread;
+
+    /** A function, which is executed in each worker thread at its end. May be NULL. */
+    thp_fctThreadStartStop_t fctStopThread;
+
+    /** The context data of \a fctStartThread and \a fctStopThread. */
+    void *pContextStartStop;
+
+    /** The mutex, which protects the rest of the data of the pool. */
+    pthread_mutex_t mutex;
+
+    /** The worker threads wait for this condition for the next set of tasks. */
+    pthread_cond_t condJobAvailable;
+
+    /** The calling thread waits for this condition for completion of all tasks. */
+    pthread_cond_t condJobDone;
+
+    /** The set of tasks is identified by a counter. The workers compare it with the
+        set they had executed last. */
+    unsigned long idxJob;
+
+    /** The number of worker threads, which have not yet completed the current set of
+        tasks. */
+    unsigned int noBusyWorkers;
+
+    /** The worker threads are requested to terminate. */
+    boolean terminate;
+
+    /** The task function of the current set of tasks. */
+    thp_fctTask_t fctTask;
+
+    /** The context data of \a fctTask. */
+    void *pContextTask;
+
+} threadPool_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Take the next task from the own queue.
+ *   @return
+ * \a true if a task could be taken, \a false if the queue is empty.
+ *   @param pQueue
+ * The queue of the calling thread.
+ *   @param pIdxTask
+ * The index of the taken task is returned in * \a pIdxTask.
+ */
+
+static boolean takeOwnTask(taskQueue_t * const pQueue, unsigned int * const pIdxTask)
+{
+    pthread_mutex_lock(&pQueue->mutex);
+    const boolean success = pQueue->idxBegin < pQueue->idxEnd;
+    if(success)
+        *pIdxTask = pQueue->idxBegin++;
+    pthread_mutex_unlock(&pQueue->mutex);
+
+    return success;
+
+} /* End of takeOwnTask */
+
+
+
+
+/**
+ * Steal tasks from another thread. The upper half of the first non empty queue of another
+ * thread is moved to the own, empty queue.
+ *   @return
+ * \a true if tasks could be stolen, \a false if the queues of all other threads are empty.
+ *   @param pPool
+ * The pool object.
+ *   @param idxThread
+ * The index of the calling thread.
+ *   @param pIdxTask
+ * The index of the first stolen task is returned in * \a pIdxTask. It is not put into the
+ * own queue; the caller needs to execute it immediately.
+ */
+
+static boolean stealTasks( threadPool_t * const pPool
+                         , unsigned int idxThread
+                         , unsigned int * const pIdxTask
+                         )
+{
+    unsigned int u;
+    for(u=1; u<pPool->noThreads; ++u)
+    {
+        taskQueue_t * const pVictim = &pPool->queueAry[(idxThread + u) % pPool->noThreads];
+
+        pthread_mutex_lock(&pVictim->mutex);
+        assert(pVictim->idxBegin <= pVictim->idxEnd);
+        const unsigned int noTasks = pVictim->idxEnd - pVictim->idxBegin;
+        if(noTasks > 0)
+        {
+            /* Steal the upper half, but at least one task. */
+            const unsigned int idxEndStolen = pVictim->idxEnd
+                             , idxBeginStolen = idxEndStolen - (noTasks+1)/2;
+            pVictim->idxEnd = idxBeginStolen;
+            pthread_mutex_unlock(&pVictim->mutex);
+
+            /* The remaining stolen tasks are put into the own queue, where other threads
+               can steal them again. */
+            taskQueue_t * const pOwnQueue = &pPool->queueAry[idxThread];
+            pthread_mutex_lock(&pOwnQueue->mutex);
+            assert(pOwnQueue->idxBegin == pOwnQueue->idxEnd);
+            pOwnQueue->idxBegin = idxBeginStolen + 1;
+            pOwnQueue->idxEnd = idxEndStolen;
+            pthread_mutex_unlock(&pOwnQueue->mutex);
+
+            *pIdxTask = idxBeginStolen;
+            return true;
+        }
+        pthread_mutex_unlock(&pVictim->mutex);
+    }
+
+    return false;
+
+} /* End of stealTasks */
+
+
+
+
+/**
+ * Execute tasks of the current set until no task is left in any queue.
+ *   @param pPool
+ * The pool object.
+ *   @param idxThread
+ * The index of the calling thread.
+ */
+
+static void executeTasks(threadPool_t * const pPool, unsigned int idxThread)
+{
+    taskQueue_t * const pOwnQueue = &pPool->queueAry[idxThread];
+    unsigned int idxTask;
+    while(takeOwnTask(pOwnQueue, &idxTask) ||  stealTasks(pPool, idxThread, &idxTask))
+        pPool->fctTask(pPool->pContextTask, idxTask, idxThread);
+
+} /* End of executeTasks */
+
+
+
+
+/**
+ * The main function of a worker thread. The thread waits for a new set of tasks, takes
+ * part in their execution and reports completion; until the pool is deleted.
+ *   @return
+ * The function always returns NULL.
+ *   @param pArg
+ * The worker_t object of the thread.
+ */
+
+static void *workerThread(void *pArg)
+{
+    const worker_t * const pWorker = (const worker_t*)pArg;
+    threadPool_t * const pPool = pWorker->pPool;
+    const unsigned int idxThread = pWorker->idxThread;
+
+    if(pPool->fctStartThread != NULL)
+        pPool->fctStartThread(pPool->pContextStartStop, idxThread);
+
+    unsigned long idxLastJob = 0;
+    pthread_mutex_lock(&pPool->mutex);
+    while(true)
+    {
+        while(!pPool->terminate &&  pPool->idxJob == idxLastJob)
+            pthread_cond_wait(&pPool->condJobAvailable, &pPool->mutex);
+        if(pPool->terminate)
+            break;
+
+        /* Take part in the execution of the new set of tasks. */
+        idxLastJob = pPool->idxJob;
+        pthread_mutex_unlock(&pPool->mutex);
+        executeTasks(pPool, idxThread);
+        pthread_mutex_lock(&pPool->mutex);
+
+        /* The last worker, which completes, notifies the calling thread. */
+        assert(pPool->noBusyWorkers > 0);
+        if(--pPool->noBusyWorkers == 0)
+            pthread_cond_signal(&pPool->condJobDone);
+    }
+    pthread_mutex_unlock(&pPool->mutex);
+
+    if(pPool->fctStopThread != NULL)
+        pPool->fctStopThread(pPool->pContextStartStop, idxThread);
+
+    return NULL;
+
+} /* End of workerThread */
+
+
+
+
+/**
+ * Create a pool of threads. The calling thread counts as one of them; \a noThreads-1
+ * worker threads are started.
+ *   @return
+ * The handle of the new pool. Use it to run tasks and to delete the pool after use.
+ *   @param hLogger
+ * If not LOG_HANDLE_TO_EMPTY_LOGGER_OBJECT, the passed logger is used to report about the
+ * pool. The logger is used only in the calling thread.
+ *   @param noThreads
+ * The number of threads in the range 1..#THP_MAX_NO_THREADS. If not all worker threads can
+ * be started then the pool is created with less threads and a warning is emitted.
+ *   @param fctStartThread
+ * A function, which is executed once in each worker thread before it executes the first
+ * task, or NULL. The function is not executed in the calling thread. Several worker
+ * threads may execute it at the same time.
+ *   @param fctStopThread
+ * A function, which is executed once in each worker thread when the pool is deleted, or
+ * NULL.
+ *   @param pContext
+ * The context data, which is passed to \a fctStartThread and \a fctStopThread.
+ */
+
+thp_hThreadPool_t thp_createThreadPool( log_hLogger_t hLogger
+                                      , unsigned int noThreads
+                                      , thp_fctThreadStartStop_t fctStartThread
+                                      , thp_fctThreadStartStop_t fctStopThread
+                                      , void *pContext
+                                      )
+{
+    assert(noThreads >= 1  &&  noThreads <= THP_MAX_NO_THREADS);
+
+    threadPool_t * const pPool = smalloc(sizeof(threadPool_t), __FILE__, __LINE__);
+    pPool->hLogger = log_cloneByReference(hLogger);
+    pPool->noThreads = noThreads;
+    pPool->workerAry = smalloc(noThreads*sizeof(worker_t), __FILE__, __LINE__);
+    pPool->queueAry = smalloc(noThreads*sizeof(taskQueue_t), __FILE__, __LINE__);
+    pPool->fctStartThread = fctStartThread;
+    pPool->fctStopThread = fctStopThread;
+    pPool->pContextStartStop = pContext;
+    pthread_mutex_init(&pPool->mutex, /* attr */ NULL);
+    pthread_cond_init(&pPool->condJobAvailable, /* attr */ NULL);
+    pthread_cond_init(&pPool->condJobDone, /* attr */ NULL);
+    pPool->idxJob = 0;
+    pPool->noBusyWorkers = 0;
+    pPool->terminate = false;
+    pPool->fctTask = NULL;
+    pPool->pContextTask = NULL;
+
+    unsigned int idxThread;
+    for(idxThread=0; idxThread<noThreads; ++idxThread)
+    {
+        taskQueue_t * const pQueue = &pPool->queueAry[idxThread];
+        pthread_mutex_init(&pQueue->mutex, /* attr */ NULL);
+        pQueue->idxBegin = 0;
+        pQueue->idxEnd = 0;
+    }
+
+    /* The calling thread is thread null. Start the others. */
+    for(idxThread=1; idxThread<noThreads; ++idxThread)
+    {
+        worker_t * const pWorker = &pPool->workerAry[idxThread];
+        pWorker->pPool = pPool;
+        pWorker->idxThread = idxThread;
+        if(pthread_create(&pWorker->thread, /* attr */ NULL, workerThread, pWorker) != 0)
+        {
+            LOG_WARN( hLogger
+                    , "thp_createThreadPool: Only %u out of %u threads could be started"
+                    , idxThread
+                    , noThreads
+                    )
+            break;
+        }
+    }
+
+    /* No task has been submitted yet, the worker threads don't read the number of threads
+       yet. */
+    pPool->noThreads = idxThread;
+
+    LOG_DEBUG(hLogger, "thp_createThreadPool: Thread pool with %u threads created", idxThread)
+
+    return pPool;
+
+} /* End of thp_createThreadPool */
+
+
+
+
+/**
+ * Delete a thread pool. All worker threads are terminated. The function must not be
+ * called while thp_runTasks is executing.
+ *   @param pPool
+ * The handle of the pool as got from thp_createThreadPool. The handle is invalid after
+ * return.
+ */
+
+void thp_deleteThreadPool(threadPool_t *pPool)
+{
+    if(pPool == THP_HANDLE_INVALID_THREAD_POOL)
+        return;
+
+    pthread_mutex_lock(&pPool->mutex);
+    assert(pPool->noBusyWorkers == 0);
+    pPool->terminate = true;
+    pthread_cond_broadcast(&pPool->condJobAvailable);
+    pthread_mutex_unlock(&pPool->mutex);
+
+    unsigned int idxThread;
+    for(idxThread=1; idxThread<pPool->noThreads; ++idxThread)
+        pthread_join(pPool->workerAry[idxThread].thread, /* pRetVal */ NULL);
+
+    for(idxThread=0; idxThread<pPool->noThreads; ++idxThread)
+        pthread_mutex_destroy(&pPool->queueAry[idxThread].mutex);
+    pthread_cond_destroy(&pPool->condJobDone);
+    pthread_cond_destroy(&pPool->condJobAvailable);
+    pthread_mutex_destroy(&pPool->mutex);
+
+    LOG_DEBUG( pPool->hLogger
+             , "thp_deleteThreadPool: Thread pool with %u threads deleted"
+             , pPool->noThreads
+             )
+    log_deleteLogger(pPool->hLogger);
+
+    free(pPool->queueAry);
+    free(pPool->workerAry);
+    free(pPool);
+
+} /* End of thp_deleteThreadPool */
+
+
+
+
+/**
+ * Get the number of threads of a pool.
+ *   @return
+ * The number of threads, including the calling thread. The number can be less than
+ * requested at creation time.
+ *   @param pPool
+ * The handle of the pool.
+ */
+
+unsigned int thp_getNoThreads(threadPool_t * const pPool)
+{
+    return pPool->noThreads;
+
+} /* End of thp_getNoThreads */
+
+
+
+
+/**
+ * Execute a set of independent tasks in all threads of the pool. The function returns
+ * after completion of all tasks.\n
+ *   The tasks must not depend on one other; they are executed in any order and in
+ * parallel. The calling thread takes part in the execution.
+ *   @param pPool
+ * The handle of the pool.
+ *   @param noTasks
+ * The number of tasks. The tasks are identified by the indexes 0..noTasks-1.
+ *   @param fctTask
+ * The function, which executes a task. It is called once per task.
+ *   @param pContext
+ * The context data, which is passed to each call of \a fctTask.
+ */
+
+void thp_runTasks( threadPool_t * const pPool
+                 , unsigned int noTasks
+                 , thp_fctTask_t fctTask
+                 , void *pContext
+                 )
+{
+    if(noTasks == 0)
+        return;
+
+    /* The tasks are initially distributed in equal portions. No worker thread is
+       currently accessing the queues. */
+    const unsigned int noThreads = pPool->noThreads;
+    unsigned int idxThread;
+    for(idxThread=0; idxThread<noThreads; ++idxThread)
+    {
+        taskQueue_t * const pQueue = &pPool->queueAry[idxThread];
+        assert(pQueue->idxBegin == pQueue->idxEnd);
+        pQueue->idxBegin = (unsigned int)((unsigned long long)noTasks*idxThread / noThreads);
+        pQueue->idxEnd = (unsigned int)((unsigned long long)noTasks*(idxThread+1) / noThreads);
+    }
+    pPool->fctTask = fctTask;
+    pPool->pContextTask = pContext;
+
+    if(noThreads == 1)
+    {
+        executeTasks(pPool, /* idxThread */ 0);
+        return;
+    }
+
+    /* Wake up the worker threads and take part in the execution. */
+    pthread_mutex_lock(&pPool->mutex);
+    assert(pPool->noBusyWorkers == 0);
+    pPool->noBusyWorkers = noThreads - 1;
+    ++ pPool->idxJob;
+    pthread_cond_broadcast(&pPool->condJobAvailable);
+    pthread_mutex_unlock(&pPool->mutex);
+
+    executeTasks(pPool, /* idxThread */ 0);
+
+    /* Wait for the completion of the tasks the other threads are still working on. */
+    pthread_mutex_lock(&pPool->mutex);
+    while(pPool->noBusyWorkers > 0)
+        pthread_cond_wait(&pPool->condJobDone, &pPool->mutex);
+    pthread_mutex_unlock(&pPool->mutex);
+
+} /* End of thp_runTasks */
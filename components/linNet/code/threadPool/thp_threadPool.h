@@ -0,0 +1,96 @@
+#ifndef THP_THREADPOOL_INCLUDED
+#define THP_THREADPOOL_INCLUDED
+/**
+ * @file thp_threadPool.h
+ * Definition of global interface of module thp_threadPool.c
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include "types.h"
+#include "log_logger.h"
+
+
+/*
+ * Defines
+ */
+
+/** The invalid thread pool handle. Should be used for initialization of any handle
+    variable. */
+#define THP_HANDLE_INVALID_THREAD_POOL NULL
+
+/** The maximum number of threads a pool can have. */
+#define THP_MAX_NO_THREADS  256
+
+
+/*
+ * Global type definitions
+ */
+
+/** A thread pool is implemented as an opaque type. */
+struct thp_threadPool_t;
+
+/** The clients of the thread pool use handles to pools. */
+typedef struct thp_threadPool_t *thp_hThreadPool_t;
+
+/** The type of a task function. A task is identified by its index and gets the index of
+    the thread it is executed in. The calling thread of thp_runTasks has index null, the
+    worker threads of the pool have the indexes 1..n-1. */
+typedef void (*thp_fctTask_t)( void *pContext
+                             , unsigned int idxTask
+                             , unsigned int idxThread
+                             );
+
+/** The type of a function, which is executed once in each worker thread at its start or
+    termination. */
+typedef void (*thp_fctThreadStartStop_t)(void *pContext, unsigned int idxThread);
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Create a pool of worker threads. */
+thp_hThreadPool_t thp_createThreadPool( log_hLogger_t hLogger
+                                      , unsigned int noThreads
+                                      , thp_fctThreadStartStop_t fctStartThread
+                                      , thp_fctThreadStartStop_t fctStopThread
+                                      , void *pContext
+                                      );
+
+/** Terminate all worker threads and delete the pool object. */
+void thp_deleteThreadPool(thp_hThreadPool_t hThreadPool);
+
+/** Get the number of threads of the pool, including the calling thread. */
+unsigned int thp_getNoThreads(thp_hThreadPool_t hThreadPool);
+
+/** Execute a number of independent tasks in all threads of the pool. */
+void thp_runTasks( thp_hThreadPool_t hThreadPool
+                 , unsigned int noTasks
+                 , thp_fctTask_t fctTask
+                 , void *pContext
+                 );
+
+#endif  /* THP_THREADPOOL_INCLUDED */
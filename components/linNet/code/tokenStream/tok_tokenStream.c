@@ -47,6 +47,7 @@
  */
 /* Module interface
  *   tok_createTokenStream
+ *   tok_createTokenStreamOnBuffer
  *   tok_deleteTokenStream
  *   tok_setBoolOption
  *   tok_getErrorMsg
@@ -61,6 +62,7 @@
  *   optionEscapeChar
  *   optionStringQuote
  *   isodigit
+ *   readInputFile
  *   readCharFromStream
  *   peekChar
  *   nextRawChar
@@ -77,14 +79,21 @@
  *   readComment
  *   createTokenDescriptorTable
  *   deleteTokenDescriptorTable
+ *   createTokenStreamObject
  */
 
 /*
  * Include files
  */
 
+/* The function fileno is a POSIX extension of the C library. */
+#ifdef __unix__
+# define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <errno.h>
 #include <string.h>
 #include <ctype.h>
@@ -115,6 +124,14 @@
 /** The end of line indicator. */
 #define EOL ((signed int)'\n')
 
+/** If the scanner opens the input file itself then it reads the entire contents at once
+    into a buffer. This is the minimum size of the buffer in Byte. It grows as needed. */
+#define MIN_SIZE_OF_INPUT_BUFFER    0x10000
+
+/** The size of the file is taken as initial size of the input buffer but not beyond this
+    maximum in Byte. The buffer still grows beyond this size if the file is larger. */
+#define MAX_INITIAL_SIZE_OF_INPUT_BUFFER    0x10000000
+
 
 /** Use a constant number as string literal, e.g. for static, compile time status messages. */
 #define NUM_LITERAL_TO_STR(num)  INTERNAL_TO_STR(num)
@@ -147,6 +164,19 @@ typedef struct syntaxOptions_t
 } syntaxOptions_t;
 
 
+/** A character sequence in the input, which is not zero terminated, e.g. an identifier
+    scanned in place in the input buffer. */
+typedef struct slice_t
+{
+    /** The first character of the sequence. */
+    const char *str;
+
+    /** The number of characters. */
+    size_t len;
+
+} slice_t;
+
+
 
 /** The token stream. */
 typedef struct tok_tokenStream_t
@@ -177,6 +207,19 @@ typedef struct tok_tokenStream_t
     /** The application defined character input function if in use, or NULL otherwise. */
     int (*fgetc)(tok_hCharInputStream_t);
 
+    /** If the scanner opened the input file itself then the entire file contents are held
+        in this buffer and the characters are taken from here rather than from the stdio
+        stream; the file is already closed. NULL if the input is read character by
+        character from \a hStream.\n
+          The buffer is malloc allocated. */
+    const char *inputBuf;
+
+    /** The end of the characters in \a inputBuf. */
+    const char *pEndOfInputBuf;
+
+    /** The next character to read from \a inputBuf. */
+    const char *pNextInputChar;
+
     /** The customer provided extension of the internal token table. The application my
         define particular character sequences and associate them with an integer number
         meaning the kind of token. */
@@ -401,8 +444,70 @@ static inline boolean iswhitespace(tok_hTokenStream_t hTStream, signed int c)
 
 
 /**
- * Read the next character from the actual stream, be it a stdio stream or an externally
- * implemented custom stream.
+ * Read the entire contents of an opened stdio stream into a newly allocated buffer.
+ *   @return
+ * True if the stream could be read until its end, false in case of a stream error. No
+ * buffer is returned in the latter case and errno tells the reason of the error.
+ *   @param pInputBuf
+ * The malloc allocated buffer is placed into * \a pInputBuf. The read characters are
+ * followed by a terminating zero byte, which doesn't count in * \a pNoChars.
+ *   @param pNoChars
+ * The number of read characters is placed into * \a pNoChars.
+ *   @param hFile
+ * The stream to read from. It needs to be connected to a regular file.
+ *   @param sizeOfFile
+ * The size of the file in Byte as reported by fstat.
+ */
+
+static boolean readInputFile( char * * const pInputBuf
+                            , size_t * const pNoChars
+                            , FILE * const hFile
+                            , off_t sizeOfFile
+                            )
+{
+    /* The size of the file is a good guess for the required size of the buffer. It's not
+       more than a guess: In text mode less characters can be read and the file could grow
+       while it is read. The guess is limited; a larger file lets the buffer grow.
+         +1: Only a read, which doesn't fill the buffer, proves having reached the end of
+       the stream. */
+    size_t maxNoChars = MIN_SIZE_OF_INPUT_BUFFER;
+    if(sizeOfFile > MAX_INITIAL_SIZE_OF_INPUT_BUFFER)
+        maxNoChars = MAX_INITIAL_SIZE_OF_INPUT_BUFFER;
+    else if(sizeOfFile >= MIN_SIZE_OF_INPUT_BUFFER)
+        maxNoChars = (size_t)sizeOfFile + 1;
+
+    /* +1: Add the terminating zero byte. */
+    char *inputBuf = smalloc(maxNoChars+1, __FILE__, __LINE__);
+    size_t noChars = 0;
+    while(true)
+    {
+        noChars += fread(inputBuf+noChars, sizeof(char), maxNoChars-noChars, hFile);
+        if(noChars < maxNoChars)
+            break;
+
+        maxNoChars *= 2;
+        inputBuf = srealloc(inputBuf, maxNoChars+1, __FILE__, __LINE__);
+    }
+
+    if(ferror(hFile) != 0)
+    {
+        free(inputBuf);
+        return false;
+    }
+
+    inputBuf[noChars] = '\000';
+    *pInputBuf = inputBuf;
+    *pNoChars = noChars;
+    return true;
+
+} /* End of readInputFile */
+
+
+
+
+/**
+ * Read the next character from the actual stream, be it the buffered contents of the
+ * input file, a stdio stream or an externally implemented custom stream.
  *   @return
  * Get the next character, which might be EOF to indicate the end of the parsing process.
  *   @param hTokenStream
@@ -412,7 +517,15 @@ static inline boolean iswhitespace(tok_hTokenStream_t hTStream, signed int c)
 static signed int readCharFromStream(tok_hTokenStream_t hTokenStream)
 {
     signed int c;
-    if(hTokenStream->fgetc == NULL)
+    if(hTokenStream->inputBuf != NULL)
+    {
+        /* Same as fgetc: A character is returned as unsigned char. */
+        if(hTokenStream->pNextInputChar < hTokenStream->pEndOfInputBuf)
+            c = (unsigned char)* hTokenStream->pNextInputChar++;
+        else
+            c = EOF;
+    }
+    else if(hTokenStream->fgetc == NULL)
     {
         assert(hTokenStream->hStream.hFile != NULL);
         c = fgetc(hTokenStream->hStream.hFile);
@@ -1070,15 +1183,17 @@ static signed int cmpTokenWithToken( const void /* (tok_tokenDescriptor_t) */ *p
 
 /**
  * Comparsion of a token in the token description table with a key. The key is the symbol
- * (a string) represented by the token. The comparison is needed to do a binary search for
- * a given token in the table of client defined symbols. See bsearch for more.
+ * represented by the token, given as a not zero terminated character sequence. The
+ * comparison is needed to do a binary search for a given token in the table of client
+ * defined symbols. See bsearch for more.
  *   @return
  * <0: The element pointed by \a pKey goes before the element pointed by \a pElem.\n
  *  0: The element pointed by \a pKey is equivalent to the element pointed by \a pElem.\n
  * >0: The element pointed by \a pKey goes after the element pointed by \a pElem.\n
  *   @param pKey
- * Points to the key to match with \a pElem. * \a pElem will probably have a field, which
- * is matched with the key value.
+ * Points to the key to match with \a pElem, an object of type slice_t. The character
+ * sequence must not contain a zero byte. * \a pElem will probably have a field, which is
+ * matched with the key value.
  *   @param pElem
  * The element to be compared with the key.
  *   @remark
@@ -1086,14 +1201,21 @@ static signed int cmpTokenWithToken( const void /* (tok_tokenDescriptor_t) */ *p
  * table of known keywords.
  */
 
-static signed int cmpTokenWithKey( const void /* (char) */ *pKey
+static signed int cmpTokenWithKey( const void /* (slice_t) */ *pKey
                                  , const void /* (tok_tokenDescriptor_t) */ *pElem
                                  )
 {
-   return strcmp((const char*)pKey, ((const tok_tokenDescriptor_t*)pElem)->symbol);
+    const slice_t * const pSlice = (const slice_t*)pKey;
+    const char * const symbol = ((const tok_tokenDescriptor_t*)pElem)->symbol;
 
-} /* End of cmpTokenWithKey */
+    /* The key is a prefix of the symbol if all its characters match but the symbol is
+       longer. */
+    signed int cmpRes = strncmp(pSlice->str, symbol, pSlice->len);
+    if(cmpRes == 0  &&  symbol[pSlice->len] != '\000')
+        cmpRes = -1;
+    return cmpRes;
 
+} /* End of cmpTokenWithKey */
 
 
 
@@ -1108,27 +1230,60 @@ static signed int cmpTokenWithKey( const void /* (char) */ *pKey
 
 static void readIdentifier(tok_hTokenStream_t hTStream, tok_token_t * const pToken)
 {
-    fio_hFifoChar_t fifo = hTStream->hFifoChar;
-    assert(fio_getNoElements(fifo) == 0);
-
-    signed int ch = currentChar(hTStream);
-    do
+    slice_t ident;
+    char *identCopy = NULL;
+
+    /* If the input is held in the buffer then the identifier is scanned in place. The
+       current character is the last one taken from the buffer as long as we didn't peek.
+       A backslash could begin a line concatenation, which is not handled by the in place
+       scan; we fall back to the character by character scan in this case. */
+    boolean scanInPlace = hTStream->inputBuf != NULL  &&  !hTStream->peeked;
+    const char *pEnd = hTStream->pNextInputChar;
+    if(scanInPlace)
     {
-        fio_writeChar(fifo, ch);
-        ch = nextChar(hTStream);
+        assert(pEnd > hTStream->inputBuf
+               &&  (unsigned char)pEnd[-1] == currentChar(hTStream)
+              );
+        const char * const pEndOfInputBuf = hTStream->pEndOfInputBuf;
+        while(pEnd < pEndOfInputBuf  &&  (isalnum((unsigned char)*pEnd) || *pEnd=='_'))
+            ++ pEnd;
+        scanInPlace = pEnd == pEndOfInputBuf  ||  *pEnd != '\\';
     }
-    while(isalnum(ch) || ch=='_');
+    if(scanInPlace)
+    {
+        ident.str = hTStream->pNextInputChar - 1;
+        ident.len = (size_t)(pEnd - ident.str);
 
-    char ident[fio_getNoElements(fifo)+1]
-       , *pCh = ident;
-    while(fio_getNoElements(fifo)>0)
-        * pCh++ = fio_readChar(fifo);
-    *pCh = '\000';
+        /* Skip the identifier and provide the character behind it. */
+        hTStream->pNextInputChar = pEnd;
+        nextChar(hTStream);
+    }
+    else
+    {
+        fio_hFifoChar_t fifo = hTStream->hFifoChar;
+        assert(fio_getNoElements(fifo) == 0);
+
+        signed int ch = currentChar(hTStream);
+        do
+        {
+            fio_writeChar(fifo, ch);
+            ch = nextChar(hTStream);
+        }
+        while(isalnum(ch) || ch=='_');
+
+        ident.len = fio_getNoElements(fifo);
+        identCopy = smalloc(ident.len+1, __FILE__, __LINE__);
+        char *pCh = identCopy;
+        while(fio_getNoElements(fifo)>0)
+            * pCh++ = fio_readChar(fifo);
+        *pCh = '\000';
+        ident.str = identCopy;
+    }
 
     /* Keywords are syntactically identical to identifiers but they have of course the
        higher priority in the token recognition. Search the static table of keywords for
        the just isolated identifier. */
-    const void *resSearch = BSEARCH( ident
+    const void *resSearch = BSEARCH( &ident
                                    , hTStream->tokenDescriptorTable.tokenDescriptorAry
                                    , hTStream->tokenDescriptorTable.noTokenDescriptions
                                    , sizeof(tok_tokenDescriptor_t)
@@ -1139,15 +1294,22 @@ static void readIdentifier(tok_hTokenStream_t hTStream, tok_token_t * const pTok
     if(resSearch == NULL)
     {
         /* We saw a true identifier, retuen a malloc allocated copy of the string to the
-           client. */
+           client. An identifier scanned in place is copied only now. */
         pToken->type = tok_tokenTypeIdentifier;
-        pToken->value.identifier = stralloccpy(ident);
+        if(identCopy == NULL)
+        {
+            identCopy = smalloc(ident.len+1, __FILE__, __LINE__);
+            memcpy(identCopy, ident.str, ident.len);
+            identCopy[ident.len] = '\000';
+        }
+        pToken->value.identifier = identCopy;
     }
     else
     {
         /* We saw a (client defined ) keyword; its representation as an integer is taken
            from the client provided definition table. */
         pToken->type = ((tok_tokenDescriptor_t*)resSearch)->type;
+        free(identCopy);
     }
 
 } /* End of readIdentifier */
@@ -1440,7 +1602,25 @@ static void readComment(tok_hTokenStream_t hTStream, const tok_token_t * const p
                    the middle of the comment end symbol then do not read a new
                    character from the input stream. */
                 if(isFirstChar)
+                {
+                    /* If the input is held in the buffer then all characters, which can't
+                       begin the comment end symbol, are skipped in place. Excluded are the
+                       EOL, which is counted, and the backslash, which could begin a line
+                       concatenation. */
+                    if(hTStream->inputBuf != NULL  &&  !hTStream->peeked)
+                    {
+                        const char *pCh = hTStream->pNextInputChar;
+                        const char * const pEndOfInputBuf = hTStream->pEndOfInputBuf;
+                        while(pCh < pEndOfInputBuf
+                              &&  *pCh != *pComEndSymbol  &&  *pCh != '\n'  &&  *pCh != '\\'
+                             )
+                        {
+                            ++ pCh;
+                        }
+                        hTStream->pNextInputChar = pCh;
+                    }
                     ch = nextChar(hTStream);
+                }
 
                 /* Leave inner loop only, continue the search. */
                 break;
@@ -1634,6 +1814,86 @@ static void deleteTokenDescriptorTable(tok_tokenStream_t * const pTokenStream)
 
 
 
+/**
+ * Allocate and initialize a token stream object once the input is available. This is the
+ * common part of the constructors tok_createTokenStream and
+ * tok_createTokenStreamOnBuffer.
+ *   @return
+ * Get the new object. It is positioned on the first character of the input.
+ *   @param fileName
+ * The name of the input for logging or NULL.
+ *   @param hStream
+ * The stdio or custom stream to read from. Not used if \a inputBuf is not NULL.
+ *   @param customFctGetChar
+ * The custom character input function or NULL.
+ *   @param inputBuf
+ * The complete input as a malloc allocated, null terminated buffer or NULL if the input
+ * is read character by character from \a hStream. The ownership of the buffer is
+ * passed to the new object.
+ *   @param noCharsInputBuf
+ * The number of characters in \a inputBuf, not counting the terminating null character.
+ *   @param pCustomTokenDefinition
+ * The client's symbol definitions, see tok_createTokenStream.
+ */
+
+static tok_tokenStream_t *createTokenStreamObject
+                    ( const char * const fileName
+                    , tok_hStream_t hStream
+                    , const tok_customFctGetChar customFctGetChar
+                    , char * const inputBuf
+                    , size_t noCharsInputBuf
+                    , const tok_tokenDescriptorTable_t * const pCustomTokenDefinition
+                    )
+{
+    tok_tokenStream_t * const pTokenStream = smalloc( sizeof(tok_tokenStream_t)
+                                                    , __FILE__
+                                                    , __LINE__
+                                                    );
+    if(fileName != NULL)
+        pTokenStream->fileName = stralloccpy(fileName);
+    else
+        pTokenStream->fileName = stralloccpy("");
+    pTokenStream->line = 1;
+    pTokenStream->error = false;
+    pTokenStream->errorMsg = stralloccpy("");
+    pTokenStream->hStream = hStream;
+    pTokenStream->fgetc = customFctGetChar;
+    pTokenStream->inputBuf = inputBuf;
+    if(inputBuf != NULL)
+        pTokenStream->pEndOfInputBuf = inputBuf + noCharsInputBuf;
+    else
+        pTokenStream->pEndOfInputBuf = NULL;
+    pTokenStream->pNextInputChar = inputBuf;
+
+    /* Make a deep copy of the client's symbol definitions into this new token stream
+       object. */
+    createTokenDescriptorTable(pTokenStream, pCustomTokenDefinition);
+
+    pTokenStream->options.eolIsWhiteSpaceOnly = false;
+    pTokenStream->options.binLiteral = false;
+    pTokenStream->options.suffixMultipliers = false;
+    pTokenStream->options.escapeChar = '\\';
+    pTokenStream->options.stringQuote = '\"';
+
+    pTokenStream->incLine = false;
+    pTokenStream->peeked = false;
+    pTokenStream->peekChar = EOF;
+    pTokenStream->currentChar = EOF;
+
+    /* The FIFO object is created with a block size that will most probably avoid all
+       dynamic allocation and freeing operations. */
+    pTokenStream->hFifoChar = fio_createFifoChar(/* blockSize */ 1000);
+
+    /* Provide first character. */
+    nextChar(pTokenStream);
+
+    return pTokenStream;
+
+} /* End of createTokenStreamObject */
+
+
+
+
 /**
  * A token stream object is created. It is associated with either a stdio stream or with
  * any kind of custom character stream. The created object can be used to parse the input
@@ -1652,7 +1912,9 @@ static void deleteTokenDescriptorTable(tok_tokenStream_t * const pTokenStream)
  *   @param fileName
  * The name of the file (or character stream), which is parsed. Mainly used for logging.
  * Only, if hFile is NULL then it really needs to be the name of (and path to) an existing
- * file. This file will then be opened for read access and be parsed.\n
+ * file. This file will then be opened for read access and be parsed. Its contents are
+ * read into memory at once, which is much faster than reading single characters from the
+ * stdio stream.\n
  *   If there's no reasonable name (e.g. in case of custom character input) then pass NULL
  * or the empty string.
  *   @param hStream
@@ -1701,10 +1963,53 @@ boolean tok_createTokenStream( tok_hTokenStream_t * const phTokenStream
     /* Most likely errors result from file open operations, therefore do this prior to
        allocating memory space for the object. */
     boolean doOpenFile = useStdio && hStream.hFile == NULL;
+    char *inputBuf = NULL;
+    size_t noCharsInputBuf = 0;
     if(doOpenFile)
     {
         hStream.hFile = fopen(fileName, "r");
-        if(hStream.hFile == NULL)
+        if(hStream.hFile != NULL)
+        {
+            /* Only a regular file is read at once. Anything else, e.g. a directory or a
+               device, is read character by character from the opened stdio stream like
+               a stream passed in by the caller; a failure is then reported as stream
+               error of the token stream. */
+            struct stat fileInfo;
+            if(fstat(fileno(hStream.hFile), &fileInfo) == 0  &&  S_ISREG(fileInfo.st_mode))
+            {
+                /* The file is closed; it's no longer needed after successfully reading
+                   it. */
+                boolean success = readInputFile( &inputBuf
+                                               , &noCharsInputBuf
+                                               , hStream.hFile
+                                               , fileInfo.st_size
+                                               );
+                const signed int errNo = errno;
+                fclose(hStream.hFile);
+                hStream.hFile = NULL;
+                if(!success)
+                {
+                    *phTokenStream = TOK_HANDLE_TO_INVALID_TOKEN_STREAM;
+#define ERR_MSG_FMT_STR "Can't read input file %s (errno: %d, %s)"
+                    const char *errStdio = strerror(errNo);
+                    const size_t lenErrMsg =  sizeof(ERR_MSG_FMT_STR)
+                                              + sizeof("-2147483648")
+                                              + strlen(fileName)
+                                              + strlen(errStdio);
+                    *pErrorString = smalloc(lenErrMsg, __FILE__, __LINE__);
+                    snprintf( *pErrorString
+                            , lenErrMsg
+                            , ERR_MSG_FMT_STR
+                            , fileName
+                            , errNo
+                            , errStdio
+                            );
+                    return false;
+#undef ERR_MSG_FMT_STR
+                }
+            }
+        }
+        else
         {
             *phTokenStream = TOK_HANDLE_TO_INVALID_TOKEN_STREAM;
             
@@ -1721,47 +2026,77 @@ boolean tok_createTokenStream( tok_hTokenStream_t * const phTokenStream
         }
     }
 
-    tok_tokenStream_t * const pTokenStream = smalloc( sizeof(tok_tokenStream_t)
-                                                    , __FILE__
-                                                    , __LINE__
-                                                    );
-    if(fileName != NULL)
-        pTokenStream->fileName = stralloccpy(fileName);
-    else
-        pTokenStream->fileName = stralloccpy("");
-    pTokenStream->line = 1;
-    pTokenStream->error = false;
-    pTokenStream->errorMsg = stralloccpy("");
-    pTokenStream->hStream = hStream;
-    pTokenStream->fgetc = customFctGetChar;
+    *phTokenStream = createTokenStreamObject( fileName
+                                            , hStream
+                                            , customFctGetChar
+                                            , inputBuf
+                                            , noCharsInputBuf
+                                            , pCustomTokenDefinition
+                                            );
+    *pErrorString = NULL;
+    return true;
 
-    /* Make a deep copy of the client's symbol definitions into this new token stream
-       object. */
-    createTokenDescriptorTable(pTokenStream, pCustomTokenDefinition);
+} /* End of tok_createTokenStream */
 
-    pTokenStream->options.eolIsWhiteSpaceOnly = false;
-    pTokenStream->options.binLiteral = false;
-    pTokenStream->options.suffixMultipliers = false;
-    pTokenStream->options.escapeChar = '\\';
-    pTokenStream->options.stringQuote = '\"';
 
-    pTokenStream->incLine = false;
-    pTokenStream->peeked = false;
-    pTokenStream->peekChar = EOF;
-    pTokenStream->currentChar = EOF;
 
-    /* The FIFO object is created with a block size that will most probably avoid all
-       dynamic allocation and freeing operations. */
-    pTokenStream->hFifoChar = fio_createFifoChar(/* blockSize */ 1000);
 
-    /* Provide first character. */
-    nextChar(pTokenStream);
+/**
+ * A token stream object is created, which reads its input from a character buffer in
+ * memory rather than from a file. This is meant for clients, which hold the parsed text
+ * already, e.g. an embedding application. Otherwise the object behaves exactly like one
+ * created by tok_createTokenStream.
+ *   @return
+ * True, if the object could be created. Since no I/O is involved the function currently
+ * always succeeds; the return value is kept for symmetry with tok_createTokenStream.
+ *   @param phTokenStream
+ * The handle to the created object is placed into \a phTokenStream.
+ *   @param pErrorString
+ * A pointer to a string variable owned by the caller. NULL is returned in * \a
+ * pErrorString if the function succeeds. See tok_createTokenStream for details.
+ *   @param name
+ * The name of the parsed input, which is used for logging only. Pass NULL or the empty
+ * string if there's no reasonable name.
+ *   @param buffer
+ * The characters to parse. The buffer doesn't need to be null terminated; null
+ * characters are not permitted in the input. The constructor makes a copy of the
+ * contents, the buffer can be discarded after return.
+ *   @param sizeOfBuffer
+ * The number of characters in \a buffer.
+ *   @param pCustomTokenDefinition
+ * The customer provided extension of the internal symbol definitions. See
+ * tok_createTokenStream for details.
+ */
 
-    *phTokenStream = pTokenStream;
+boolean tok_createTokenStreamOnBuffer
+                    ( tok_hTokenStream_t * const phTokenStream
+                    , char * * const pErrorString
+                    , const char * const name
+                    , const char * const buffer
+                    , size_t sizeOfBuffer
+                    , const tok_tokenDescriptorTable_t * const pCustomTokenDefinition
+                    )
+{
+    assert(buffer != NULL ||  sizeOfBuffer == 0);
+
+    /* The buffer is copied and null terminated like the buffer of an input file, see
+       readInputFile. */
+    char * const inputBuf = smalloc(sizeOfBuffer + 1, __FILE__, __LINE__);
+    if(sizeOfBuffer > 0)
+        memcpy(inputBuf, buffer, sizeOfBuffer);
+    inputBuf[sizeOfBuffer] = '\0';
+
+    *phTokenStream = createTokenStreamObject( name
+                                            , (tok_hStream_t){.hFile = NULL}
+                                            , /* customFctGetChar */ NULL
+                                            , inputBuf
+                                            , sizeOfBuffer
+                                            , pCustomTokenDefinition
+                                            );
     *pErrorString = NULL;
     return true;
 
-} /* End of tok_createTokenStream */
+} /* End of tok_createTokenStreamOnBuffer */
 
 
 
@@ -1782,6 +2117,7 @@ void tok_deleteTokenStream(tok_hTokenStream_t hTokenStream)
 
     if(hTokenStream->fgetc == NULL  &&  hTokenStream->hStream.hFile != NULL)
         fclose(hTokenStream->hStream.hFile);
+    free((char*)hTokenStream->inputBuf);
 
     assert(hTokenStream->hFifoChar != NULL
            &&  fio_getNoElements(hTokenStream->hFifoChar) == 0
@@ -349,6 +349,16 @@ boolean tok_createTokenStream( tok_hTokenStream_t * const phTokenStream
                              , const tok_tokenDescriptorTable_t * const pCustomTokenDefinition
                              );
 
+/** A token stream object is created, which reads from a character buffer in memory. */
+boolean tok_createTokenStreamOnBuffer
+                    ( tok_hTokenStream_t * const phTokenStream
+                    , char * * const pErrorString
+                    , const char * const name
+                    , const char * const buffer
+                    , size_t sizeOfBuffer
+                    , const tok_tokenDescriptorTable_t * const pCustomTokenDefinition
+                    );
+
 /** Delete a token stream object as created by tok_createTokenStream. */
 void tok_deleteTokenStream(tok_hTokenStream_t hTokenStream);
 
@@ -0,0 +1,175 @@
+#!/bin/sh
+#
+# bench.sh
+#   Benchmark of linNet. The circuits of the fixed corpus (see corpus.txt) are computed
+# repeatedly and the median of wall clock time, CPU time and the time spent in the
+# solver and in the frequency domain computations are reported together with the peak
+# resident set size. All figures are taken from the performance report (linNet -p). The
+# result can be compared against a stored baseline; a regression of run time or a change
+# of the number of addends computed by the solver makes the script fail.
+#
+# Usage:
+#   bench.sh <linNetExe> <workDir> <noRepetitions> <baselineFile> <tolerance> [save]
+#   linNetExe: The executable under test. Use a PRODUCTION build for meaningful results
+#   workDir: A folder for the generated circuits, logs, reports and the result. It is
+#            created if it doesn't exist
+#   noRepetitions: Every circuit is computed so many times; the median is reported
+#   baselineFile: The result of a former run. If the file doesn't exist then no
+#                 comparison is made
+#   tolerance: A circuit is reported slower if its median wall clock time exceeds the
+#              baseline by more than this factor, e.g. 1.2. Run times of less than 50 ms
+#              are not considered
+#   save: If given, the result of this run is stored as new baseline
+#
+# Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+#
+# This program is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+if [ $# -lt 5 ]; then
+    echo "usage: $0 <linNetExe> <workDir> <noRepetitions> <baselineFile> <tolerance>" \
+         "[save]" >&2
+    exit 2
+fi
+exe=$1
+workDir=$2
+noRepetitions=$3
+baselineFile=$4
+tolerance=$5
+save=$6
+
+benchDir=$(cd "$(dirname "$0")" && pwd)
+if [ ! -x "$exe" ]; then
+    echo "$0: linNet executable $exe not found" >&2
+    exit 2
+fi
+case $noRepetitions in
+    ''|*[!0-9]*|0) echo "$0: Bad number of repetitions $noRepetitions" >&2; exit 2;;
+esac
+mkdir -p "$workDir" || exit 2
+workDir=$(cd "$workDir" && pwd)
+result="$workDir/result.txt"
+: "${LINNET_HOME:=$(cd "$benchDir/../.." && pwd)}"
+export LINNET_HOME
+
+# Print the median of the numbers read from stdin, one per line.
+median()
+{
+    sort -g | awk '{ v[NR] = $1 }
+                   END { if(NR == 0) print "-"
+                         else if(NR % 2) print v[(NR+1)/2]
+                         else printf("%.6f\n", (v[NR/2] + v[NR/2+1]) / 2)
+                       }'
+}
+
+# Extract a field from a performance report. $1: report, $2: a key of the top level or
+# of the solver or the name of a phase, which stands for the wall time of that phase.
+# The extraction relies on the fixed layout of the report written by linNet.
+getField()
+{
+    awk -v key="$2" '
+        $0 ~ "^  \"" key "\": "  ||  $0 ~ "^    \"" key "\": " \
+            { sub(/^[^:]*: */, ""); sub(/,$/, ""); print; exit }
+        $0 ~ "^    {\"name\": \"" key "\"" \
+            { sub(/.*"wallTime": */, ""); sub(/,.*/, ""); print; exit }
+    ' "$1"
+}
+
+echo "# circuit noUnknowns noConstants noAddends wallTime cpuTime solveTime" \
+     "freqDomainTime maxRSS[kB]" > "$result"
+failed=0
+tr -d '\r' < "$benchDir/corpus.txt" | while read -r name source arg1 arg2; do
+    case $name in
+        ''|'#'*) continue;;
+    esac
+
+    circuit="$workDir/$name.cnl"
+    if [ "$source" = "gen" ]; then
+        awk -v type="$arg1" -v n="$arg2" -f "$benchDir/genCircuit.awk" > "$circuit" \
+            || exit 1
+    else
+        cp "$benchDir/$arg1" "$circuit" || exit 1
+    fi
+
+    rm -f "$workDir"/rep*/"$name.perf.json"
+    i=1
+    while [ $i -le "$noRepetitions" ]; do
+        mkdir -p "$workDir/rep$i"
+        if ! "$exe" -v WARN -s -c -l"$workDir/$name.log" -p"$workDir/rep$i" "$circuit" \
+                    > /dev/null; then
+            echo "$0: linNet failed on circuit $name, see $workDir/$name.log" >&2
+            exit 1
+        fi
+        i=$((i+1))
+    done
+
+    line=$name
+    for field in noUnknowns noConstants noAddendsCreated; do
+        line="$line $(getField "$workDir/rep1/$name.perf.json" $field)"
+    done
+    for field in wallTime cpuTime solve freqDomain maxResidentSetSize; do
+        value=$(for rep in "$workDir"/rep*/"$name".perf.json; do
+                    getField "$rep" $field
+                done | median)
+        line="$line $value"
+    done
+    echo "$line" >> "$result"
+    echo "$line"
+done || failed=1
+
+if [ $failed -ne 0 ]; then
+    exit 1
+fi
+
+rc=0
+if [ -f "$baselineFile" ]; then
+    echo "Comparison with baseline $baselineFile (tolerance $tolerance):"
+    awk -v tolerance="$tolerance" '
+        /^#/ { next }
+        FNR == NR { noAddends[$1] = $4; wallTime[$1] = $5; rss[$1] = $9; next }
+        {
+            if(!($1 in wallTime))
+            {
+                printf("  %-16s new circuit, not in baseline\n", $1)
+                next
+            }
+            state = "ok"
+            if($5 > tolerance*wallTime[$1]  &&  $5 - wallTime[$1] > 0.05)
+            {
+                state = "SLOWER"
+                ++ noRegressions
+            }
+            if($4 != noAddends[$1])
+            {
+                state = state ", CHANGED number of addends (" noAddends[$1] " -> " $4 ")"
+                ++ noRegressions
+            }
+            printf("  %-16s wall time %10.6f s (baseline %10.6f s, ratio %5.2f)," \
+                   " max RSS %8d kB (baseline %8d kB): %s\n",
+                   $1, $5, wallTime[$1], wallTime[$1] > 0? $5/wallTime[$1]: 1,
+                   $9, rss[$1], state)
+        }
+        END { exit noRegressions > 0 }
+    ' "$baselineFile" "$result" || rc=1
+    if [ $rc -ne 0 ]; then
+        echo "$0: Performance regression detected" >&2
+    fi
+else
+    echo "No baseline $baselineFile found, no comparison made"
+fi
+
+if [ "$save" = "save" ]; then
+    cp "$result" "$baselineFile" && echo "Result stored as new baseline $baselineFile"
+fi
+exit $rc
@@ -0,0 +1,150 @@
+#
+# genCircuit.awk
+#   Generator of scalable circuit netlists for the benchmark of linNet. A family of
+# circuits is chosen by name and its size by a number of stages. The generated netlist is
+# written to stdout. All circuits have the input voltage source Uin and the named output
+# voltage Uout and they define the transfer function G = Uout/Uin.
+#
+# Usage:
+#   awk -v type=<type> -v n=<noStages> -f genCircuit.awk > <name>.cnl
+# where <type> is one out of:
+#   rcLadder: n RC low-pass sections in series, each a series resistor and a capacitor to
+#             ground. n+1 unknowns, 2n constants
+#   lcLadder: A source resistor, n LC sections, each a series inductor and a capacitor to
+#             ground, and a load resistor. 2n constants plus the two resistors
+#   biquad:   n multiple-feedback op-amp low-pass biquads in series. Each stage has three
+#             resistors, two capacitors and an op-amp
+#   rGrid:    An n x n grid of resistors. The source feeds one corner, the opposite
+#             corner is grounded through another resistor and the output is taken at
+#             the center node. 2n(n-1)+1 constants
+#
+# Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+#
+# This program is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+# The name of node i of a ladder. The input node is node 0.
+function ladderNode(i)
+{
+    return i == 0? "in": "n" i
+}
+
+# The name of a node of the grid.
+function gridNode(row, col)
+{
+    return "g" row "_" col
+}
+
+function rcLadder(n,    i)
+{
+    for(i=1; i<=n; ++i)
+    {
+        printf("R R%d %s %s R%d = 1k\n", i, ladderNode(i-1), ladderNode(i), i)
+        printf("C C%d %s GND C%d = %dn\n", i, ladderNode(i), i, 10*i)
+    }
+    printf("DEF Uout %s GND\n", ladderNode(n))
+}
+
+function lcLadder(n,    i)
+{
+    printf("R Rs in %s Rs = 50\n", ladderNode(1))
+    for(i=1; i<=n; ++i)
+    {
+        printf("L L%d %s %s L%d = %du\n", i, ladderNode(i), ladderNode(i+1), i, 10*i)
+        printf("C C%d %s GND C%d = %dn\n", i, ladderNode(i+1), i, i)
+    }
+    printf("R Rl %s GND Rl = 50\n", ladderNode(n+1))
+    printf("DEF Uout %s GND\n", ladderNode(n+1))
+}
+
+# A multiple-feedback low-pass biquad per stage: R1 from the stage input to node a, R2
+# from a to the stage output, R3 from a to the inverting input b of the op-amp, C1 from b
+# to the output and C2 from a to ground.
+function biquad(n,    i, inNode, outNode)
+{
+    for(i=1; i<=n; ++i)
+    {
+        inNode = i == 1? "in": "q" (i-1)
+        outNode = "q" i
+        printf("R R1_%d %s a%d R1_%d = 2.86k\n", i, inNode, i, i)
+        printf("R R2_%d a%d %s R2_%d = 9k\n", i, i, outNode, i)
+        printf("R R3_%d a%d b%d R3_%d = 6.2k\n", i, i, i, i)
+        printf("C C1_%d b%d %s C1_%d = 1n\n", i, i, outNode, i)
+        printf("C C2_%d a%d GND C2_%d = 25n\n", i, i, i)
+        printf("OP OP%d b%d GND %s\n", i, i, outNode)
+    }
+    printf("DEF Uout q%d GND\n", n)
+}
+
+function rGrid(n,    row, col, idxR)
+{
+    idxR = 0
+    for(row=0; row<n; ++row)
+    {
+        for(col=0; col<n; ++col)
+        {
+            if(col+1 < n)
+            {
+                ++ idxR
+                printf("R R%d %s %s R%d = %d\n", idxR, gridNode(row, col),
+                       gridNode(row, col+1), idxR, 100*idxR)
+            }
+            if(row+1 < n)
+            {
+                ++ idxR
+                printf("R R%d %s %s R%d = %d\n", idxR, gridNode(row, col),
+                       gridNode(row+1, col), idxR, 100*idxR)
+            }
+        }
+    }
+    printf("DEF Uout %s GND\n", gridNode(int(n/2), int(n/2)))
+}
+
+BEGIN {
+    if(n !~ /^[0-9]+$/  ||  n < 1)
+    {
+        print "genCircuit.awk: Please specify the number of stages, n >= 1" > "/dev/stderr"
+        exit 1
+    }
+    if(type == "rGrid"  &&  n < 2)
+    {
+        print "genCircuit.awk: A grid needs at least 2 x 2 nodes" > "/dev/stderr"
+        exit 1
+    }
+
+    printf("/* Circuit %s with %d stages, generated by genCircuit.awk for the benchmark" \
+           " of linNet. */\n\n", type, n)
+    if(type == "rGrid")
+    {
+        printf("U Uin %s GND\n", gridNode(0, 0))
+        printf("R Rg %s GND Rg = 1k\n", gridNode(n-1, n-1))
+    }
+    else
+        printf("U Uin in GND\n")
+
+    if(type == "rcLadder")
+        rcLadder(n)
+    else if(type == "lcLadder")
+        lcLadder(n)
+    else if(type == "biquad")
+        biquad(n)
+    else if(type == "rGrid")
+        rGrid(n)
+    else
+    {
+        print "genCircuit.awk: Unknown type of circuit " type > "/dev/stderr"
+        exit 1
+    }
+    printf("PLOT G Uout Uin\n")
+}
@@ -0,0 +1,133 @@
+/**
+ * @file libClient.c
+ *   Minimal client of the static library of linNet.\n
+ * The program is built by makefile target lib. It includes nothing but the public header
+ * lib_library.h and it has its own main function; building it proves that the header
+ * compiles standalone and that the library can be linked without the main module of the
+ * linNet application. Running it computes an RC low pass and checks its transfer function
+ * at the corner frequency. It double-checks that a thread can't own a second context.
+ *
+ * Copyright (C) 2014 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   main
+ * Local functions
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "lib_library.h"
+
+
+/*
+ * Defines
+ */
+
+/** The circuit: An RC low pass with corner frequency 1000 rad/s. */
+#define NETLIST "U Uin in gnd\n"                                                           \
+                "R R in out R=1k\n"                                                         \
+                "C C out gnd C=1u\n"                                                        \
+                "DEF Uout out gnd\n"                                                        \
+                "PLOT G Uout Uin\n"
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Compute the RC low pass and check its transfer function at the corner frequency, where
+ * it is 1/(1+j).
+ *   @return
+ * Zero if the result is as expected, one otherwise.
+ */
+
+int main(void)
+{
+    lib_initModule();
+
+    const lib_options_t options = LIB_DEFAULT_OPTIONS;
+    lib_hContext_t hContext;
+    boolean success = lib_createContext(&hContext, &options);
+    if(success)
+    {
+        /* The library must refuse a second context of the same thread. */
+        lib_hContext_t hSecondContext;
+        success = !lib_createContext(&hSecondContext, &options)  &&  hSecondContext == NULL;
+
+        const lib_circuit_t *pCircuit;
+        if(success)
+        {
+            success = lib_computeCircuit( hContext
+                                        , &pCircuit
+                                        , "libClient"
+                                        , NETLIST
+                                        , strlen(NETLIST)
+                                        );
+        }
+        if(success)
+        {
+            unsigned int noDependents, noIndependents, noConstants;
+            lib_getDimensionsOfResult( hContext
+                                     , pCircuit
+                                     , /* idxResult */ 0
+                                     , &noDependents
+                                     , &noIndependents
+                                     , &noConstants
+                                     );
+            success = pCircuit->noResults == 1
+                      &&  noDependents == 1  &&  noIndependents == 1  &&  noConstants == 2;
+            if(success)
+            {
+                const double omega = 1000.0;
+                double re, im;
+                lib_evaluateResult( hContext
+                                  , pCircuit
+                                  , /* idxResult */ 0
+                                  , /* valueOfConstAry */ NULL
+                                  , /* noPoints */ 1
+                                  , &omega
+                                  , &re
+                                  , &im
+                                  );
+                printf( "libClient: G(j*%g) = %g%+g*i with %s, %s\n"
+                      , omega
+                      , re
+                      , im
+                      , lib_getNameOfConstant(hContext, pCircuit, 0, 0)
+                      , lib_getNameOfConstant(hContext, pCircuit, 0, 1)
+                      );
+                success = fabs(re - 0.5) < 1e-9  &&  fabs(im + 0.5) < 1e-9;
+            }
+
+            lib_deleteCircuit(hContext, pCircuit);
+        }
+        lib_deleteContext(hContext);
+    }
+
+    lib_shutdownModule();
+
+    if(!success)
+        fprintf(stderr, "libClient: The RC low pass is not computed as expected\n");
+    return success? 0: 1;
+
+} /* End of main */
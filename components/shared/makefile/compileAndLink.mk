@@ -61,6 +61,11 @@
 # for the setting of srcDirList below.
 #   A second list of files is found as cFileListExcl. These C/C++ files are excluded from
 # build.
+#   A third list of files is found as libFileListExcl. These C/C++ files are compiled but
+# they are not archived in the static library of the project, e.g. the file with the
+# application's main function.
+#   An optional single source file libClient is a client of the static library. It is not
+# part of the project's modules but built together with the library.
 
 
 # General settings for the makefile.
@@ -78,6 +83,10 @@ project ?= appName
 # The name of the executable file.
 projectExe := $(project)$(dotExe)
 
+# The name of the static library, which archives all modules of the project but those
+# listed in libFileListExcl.
+projectLib := lib$(project).a
+
 # Access help as default target or by several names. This target needs to be the first one
 # in this file.
 .PHONY: h help targets usage
@@ -86,7 +95,9 @@ h help targets usage:
 	$(info where <configuration> is one out of DEBUG (default) or PRODUCTION.)
 	$(info Available targets are:)
 	$(info   - build: Build the executable. Includes all others but help)
+	$(info   - lib: Build the static library $(projectLib) of all modules but $(libFileListExcl) and its client $(notdir $(libClient)))
 	$(info   - run: Build the executable and run it as configured in GNUmakefile)
+	$(info   - bench: Build the executable and run the benchmark as configured in GNUmakefile)
 	$(info   - compile: Compile all C(++) source files, but no linkage etc.)
 	$(info   - clean: Delete all application files generated by the build process)
 	$(info   - cleanDep: Delete all dependency files, e.g. after changes of #include statements)
@@ -169,6 +180,11 @@ objList := $(cFileList:.cpp=.o)
 objList := $(objList:.c=.o)
 objListWithPath := $(addprefix $(targetDir)obj/, $(objList))
 #$(info objListWithPath := $(objListWithPath))
+# The static library doesn't contain the files listed in libFileListExcl.
+libObjList := $(filter-out $(libFileListExcl), $(cFileList))
+libObjList := $(libObjList:.cpp=.o)
+libObjList := $(libObjList:.c=.o)
+libObjListWithPath := $(addprefix $(targetDir)obj/, $(libObjList))
 
 # Include the dependency files. Do this with a failure tolerant include operation - the
 # files are not available after a clean.
@@ -182,7 +198,7 @@ VPATH := $(srcDirList) $(targetDir)
 #   TODO You may need to add more include paths here.
 cFlags += $(cDefines) -Wall -Wextra -Wstrict-overflow=4 -Wmissing-declarations              \
           -fno-exceptions -ffunction-sections -fdata-sections -MMD                          \
-          -Wa,-a=$(patsubst %.o,%.lst,$@) -std=c99                                          \
+          -Wa,-a=$(patsubst %.o,%.lst,$@) -std=c99 -pthread                                 \
 		  $(foreach path,$(srcDirList) $(incDirList),-I$(path))                             \
           $(foreach def,$(defineList),-D$(def))
 ifeq ($(CONFIG),DEBUG)
@@ -260,7 +276,21 @@ $(targetDir)obj/listOfObjFiles.txt: $(objListWithPath) $(projectResourceFile)
 lFlags = -Wl,--print-map,--cref,--warn-common
 $(targetDir)$(projectExe): $(targetDir)obj/listOfObjFiles.txt
 	$(info Linking project. Ouput is redirected to $(targetDir)$(project).map)
-	$(gcc) $(lFlags) -o $@ @$< -lm > $(targetDir)$(project).map
+	$(gcc) $(lFlags) -o $@ @$< -lm -pthread > $(targetDir)$(project).map
+
+# Let the archiver create the static library. An embedding application links it with -lm
+# -pthread like the executable.
+$(targetDir)$(projectLib): $(libObjListWithPath)
+	$(info Creating static library $@)
+	-$(rm) -f $@
+	$(ar) rcs $@ $^
+
+# The optional client of the static library, see libClient, is compiled and linked with
+# the library in a single step. It doesn't produce dependency and listing files.
+libClientExe := $(if $(libClient),$(targetDir)$(basename $(notdir $(libClient)))$(dotExe))
+$(libClientExe): $(libClient) $(targetDir)$(projectLib)
+	$(info Building client $@ of static library $(projectLib))
+	$(gcc) $(filter-out -MMD -Wa%,$(cFlags)) -o $@ $^ -lm -pthread
 
 # Delete all dependency files ignoring (-) the return code from Windows.
 .PHONY: cleanDep
@@ -272,3 +302,4 @@ cleanDep:
 clean:
 	-$(rm) -f $(targetDir)obj/*
 	-$(rm) -f $(targetDir)$(project).*
+	-$(rm) -f $(targetDir)$(projectLib) $(libClientExe)
@@ -45,6 +45,7 @@ else
 endif
 
 # Now use the path search to get all absolute tool paths for later use.
+ar := $(call pathSearch,$(toolsSearchPath),ar$(dotExe))
 cat := $(call pathSearch,$(toolsSearchPath),cat$(dotExe))
 cp := $(call pathSearch,$(toolsSearchPath),cp$(dotExe))
 echo := $(call pathSearch,$(toolsSearchPath),echo$(dotExe))
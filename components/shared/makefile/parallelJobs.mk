@@ -40,7 +40,11 @@
 #   sharedMakefilePath: The path to the common makefile fragments like this one
 #   targetRunArgs: A list of arguments passed to the compiled target when yielding target
 # run
-export project srcDirList cFileListExcl incDirList defineList sharedMakefilePath targetRunArgs
+#   benchCmd: The command line, which runs the benchmark of the compiled target when
+# yielding target bench. Optional, the target is not available if not set
+#   libClient: The source file of a client of the static library, which is built together
+# with the library when yielding target lib. Optional
+export project srcDirList cFileListExcl libFileListExcl libClient incDirList defineList sharedMakefilePath targetRunArgs
 
 # Load the makefile, the targets of which are run in a safe parallel way.
 include $(sharedMakefilePath)compileAndLink.mk
@@ -62,6 +66,11 @@ mFlags = -f $(sharedMakefilePath)compileAndLink.mk -j $(jobs) --no-print-directo
 build: makeDir
 	$(MAKE) $(mFlags) $(targetDir)$(projectExe)
 
+# Build the static library of the project's modules for embedding applications.
+.PHONY: lib
+lib: makeDir
+	$(MAKE) $(mFlags) $(targetDir)$(projectLib) $(libClientExe)
+
 # Rebuild all.
 #   clean and makeDir do not interfere and maybe listed without explicit serialization.
 .PHONY: rebuild
@@ -80,3 +89,11 @@ run: makeDir
 	$(MAKE) $(mFlags) $(targetDir)$(projectExe)
 	cd $(targetRunDir) & pwd & $(call u2w,$(abspath $(targetDir)$(projectExe))) $(targetRunArgs)
 
+# Run the benchmark of the compiled software if it could be built. The benchmark should be
+# run with CONFIG=PRODUCTION.
+.PHONY: bench
+bench: makeDir
+	$(if $(benchCmd),,$(error No benchmark is configured for project $(project)))
+	$(MAKE) $(mFlags) $(targetDir)$(projectExe)
+	$(benchCmd)
+